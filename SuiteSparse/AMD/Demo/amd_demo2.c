@@ -12,7 +12,8 @@
  * to AMD.
  *
  * Identical to amd_demo.c, except that it operates on an input matrix that has
- * unsorted columns and duplicate entries.
+ * unsorted columns and duplicate entries.  The matrix is then ordered again
+ * with A+A' constructed in parallel (Control [AMD_NTHREADS] > 1).
  */
 
 #include "amd.h"
@@ -54,7 +55,8 @@ int main (void)
 	/* column 22: */
 	/* column 23: */    12, 11, 12, 23 } ;
 
-    int P [24], Pinv [24], i, j, k, jnew, p, inew, result ;
+    int P [24], Pinv [24], Pt [2][24], i, j, k, jnew, p, inew, result, t,
+	ok, same ;
     double Control [AMD_CONTROL], Info [AMD_INFO] ;
     char A [24][24] ;
 
@@ -204,5 +206,38 @@ int main (void)
 	printf ("\n") ;
     }
 
+    /* Order the matrix again, constructing A+A' in parallel with up to 2 and
+     * then up to 4 threads (Control [AMD_NTHREADS]).  The number of threads
+     * actually used depends on the computer, so it is not printed.  Both
+     * orderings must be valid permutations, and they must be the same.  They
+     * are also compared with the sequential ordering P found above (with the
+     * default Control [AMD_NTHREADS] of 1). */
+    printf ("\nOrder A again, constructing A+A' in parallel:\n") ;
+    for (t = 0 ; t < 2 ; t++)
+    {
+	Control [AMD_NTHREADS] = (t == 0) ? 2 : 4 ;
+	result = amd_order (n, Ap, Ai, Pt [t], Control, Info) ;
+	for (j = 0 ; j < n ; j++) Pinv [j] = -1 ;
+	ok = (result == AMD_OK_BUT_JUMBLED) && Info [AMD_AAT_THREADS] >= 1
+	    && Info [AMD_AAT_THREADS] <= Control [AMD_NTHREADS]
+	    && Info [AMD_MEMORY_AAT] > 0 ;
+	for (k = 0 ; ok && k < n ; k++)
+	{
+	    j = Pt [t][k] ;
+	    ok = (j >= 0 && j < n && Pinv [j] == -1) ;
+	    if (ok) Pinv [j] = k ;
+	    if (t == 1) ok = ok && (j == Pt [0][k]) ;
+	}
+	printf ("up to %g threads: %s\n", Control [AMD_NTHREADS],
+	    ok ? "ok" : "FAILED") ;
+	if (!ok) exit (1) ;
+    }
+    same = 1 ;
+    for (k = 0 ; k < n ; k++) same = same && (Pt [1][k] == P [k]) ;
+    printf ("Permutation vector (same as sequential: %s):\n",
+	same ? "yes" : "no") ;
+    for (k = 0 ; k < n ; k++) printf (" %2d", Pt [1][k]) ;
+    printf ("\n") ;
+
     return (0) ;
 }
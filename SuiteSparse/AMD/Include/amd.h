@@ -154,7 +154,19 @@ SuiteSparse_long amd_l_order    /* see above for description of arguments */
  *           it can lead to a slightly worse ordering, however.  To turn it off,
  *           set Control [AMD_AGGRESSIVE] to 0.
  *
- *       Control [2..4] are not used in the current version, but may be used in
+ *       Control [AMD_NTHREADS]: if greater than one, the pattern of A+A' is
+ *           counted and constructed in parallel, by up to this many OpenMP
+ *           threads, before the (sequential) ordering itself.  The column
+ *           chunks are sized by the number of entries in A, and each thread
+ *           counts its own contributions to each row of A', so this uses
+ *           Control [AMD_NTHREADS] * n extra integers of workspace.  The
+ *           ordering is the same for any value greater than one, but it can
+ *           differ slightly from the sequential one, since the adjacency lists
+ *           of A+A' are constructed in a different order.  The default is 1,
+ *           which uses the sequential method.  Without OpenMP, the parallel
+ *           method is still used (in a single thread) if this is > 1.
+ *
+ *       Control [3..4] are not used in the current version, but may be used in
  *           future versions.
  *
  * The Info array provides statistics about the ordering on output.  If it is
@@ -190,11 +202,12 @@ SuiteSparse_long amd_l_order    /* see above for description of arguments */
  *           removed from A prior to ordering.  These are placed last in the
  *           output order P.
  *
- *       Info [AMD_MEMORY]: the amount of memory used by AMD, in bytes.  In the
- *           current version, this is 1.2 * Info  [AMD_NZ_A_PLUS_AT] + 9*n
- *           times the size of an integer.  This is at most 2.4nz + 9n.  This
- *           excludes the size of the input arguments Ai, Ap, and P, which have
- *           a total size of nz + 2*n + 1 integers.
+ *       Info [AMD_MEMORY]: the peak amount of memory used by AMD, in bytes.
+ *           In the current version, this is 1.2 * Info  [AMD_NZ_A_PLUS_AT] +
+ *           9*n times the size of an integer, plus Info [AMD_MEMORY_AAT].
+ *           This is at most 2.4nz + 9n integers if A+A' is constructed
+ *           sequentially.  This excludes the size of the input arguments Ai,
+ *           Ap, and P, which have a total size of nz + 2*n + 1 integers.
  *
  *       Info [AMD_NCMPA]: the number of garbage collections performed.
  *
@@ -219,7 +232,23 @@ SuiteSparse_long amd_l_order    /* see above for description of arguments */
  *       Info [AMD_DMAX]:  the maximum number of nonzeros in any column of L,
  *           including the diagonal.
  *
- *       Info [14..19] are not used in the current version, but may be used in
+ *       Info [AMD_AAT_THREADS]: the number of threads used to construct A+A'.
+ *           This is zero if the sequential method was used.
+ *
+ *       Info [AMD_MEMORY_AAT]: the amount of memory, in bytes, used to
+ *           construct A+A' in parallel (the per-thread counts).  It is
+ *           included in the peak Info [AMD_MEMORY], which is reached while
+ *           A+A' is constructed.  It is freed before the matrix is ordered,
+ *           so the ordering itself uses Info [AMD_MEMORY] minus Info
+ *           [AMD_MEMORY_AAT] bytes.  This is zero if the sequential method
+ *           was used.
+ *
+ *       Info [AMD_MEMORY_ELBOW]: the amount of elbow room, in bytes, given
+ *           to AMD in addition to the pattern of A+A' itself.  Info
+ *           [AMD_MEMORY] minus Info [AMD_MEMORY_ELBOW] is the minimum memory
+ *           AMD could use.
+ *
+ *       Info [17..19] are not used in the current version, but may be used in
  *           future versions.
  */    
 
@@ -331,10 +360,12 @@ void amd_l_info     (double Info [ ]) ;
 /* contents of Control */
 #define AMD_DENSE 0            /* "dense" if degree > Control [0] * sqrt (n) */
 #define AMD_AGGRESSIVE 1    /* do aggressive absorption if Control [1] != 0 */
+#define AMD_NTHREADS 2       /* # threads used to construct A+A' */
 
 /* default Control settings */
 #define AMD_DEFAULT_DENSE 10.0          /* default "dense" degree 10*sqrt(n) */
 #define AMD_DEFAULT_AGGRESSIVE 1    /* do aggressive absorption by default */
+#define AMD_DEFAULT_NTHREADS 1      /* construct A+A' sequentially by default */
 
 /* contents of Info */
 #define AMD_STATUS 0           /* return value of amd_order and amd_l_order */
@@ -351,6 +382,9 @@ void amd_l_info     (double Info [ ]) ;
 #define AMD_NMULTSUBS_LDL 11 /* number of fl. point (*,-) pairs for LDL' */
 #define AMD_NMULTSUBS_LU 12  /* number of fl. point (*,-) pairs for LU */
 #define AMD_DMAX 13             /* max nz. in any column of L, incl. diagonal */
+#define AMD_AAT_THREADS 14      /* # threads used to construct A+A' */
+#define AMD_MEMORY_AAT 15       /* memory used to construct A+A' in parallel */
+#define AMD_MEMORY_ELBOW 16     /* elbow room given to AMD, in bytes */
 
 /* ------------------------------------------------------------------------- */
 /* return values of AMD */
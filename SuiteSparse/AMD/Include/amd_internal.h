@@ -167,6 +167,9 @@
 #define AMD_2 amd_l2
 #define AMD_valid amd_l_valid
 #define AMD_aat amd_l_aat
+#define AMD_paat amd_l_paat
+#define AMD_pfind amd_l_pfind
+#define AMD_1p amd_l1p
 #define AMD_postorder amd_l_postorder
 #define AMD_post_tree amd_l_post_tree
 #define AMD_dump amd_l_dump
@@ -188,6 +191,9 @@
 #define AMD_2 amd_2
 #define AMD_valid amd_valid
 #define AMD_aat amd_aat
+#define AMD_paat amd_paat
+#define AMD_pfind amd_pfind
+#define AMD_1p amd_1p
 #define AMD_postorder amd_postorder
 #define AMD_post_tree amd_post_tree
 #define AMD_dump amd_dump
@@ -225,6 +231,43 @@ GLOBAL void AMD_1
     double Info [ ]
 ) ;
 
+GLOBAL size_t AMD_paat
+(
+    Int n,
+    const Int Ap [ ],
+    const Int Ai [ ],
+    Int Len [ ],
+    Int nthreads,
+    Int Chunk [ ],
+    Int Cnt [ ],
+    double Info [ ]
+) ;
+
+GLOBAL Int AMD_pfind
+(
+    Int i,
+    Int j,
+    const Int Ap [ ],
+    const Int Ai [ ]
+) ;
+
+GLOBAL void AMD_1p
+(
+    Int n,
+    const Int Ap [ ],
+    const Int Ai [ ],
+    Int P [ ],
+    Int Pinv [ ],
+    Int Len [ ],
+    Int slen,
+    Int S [ ],
+    Int nthreads,
+    Int Chunk [ ],
+    Int Cnt [ ],
+    double Control [ ],
+    double Info [ ]
+) ;
+
 GLOBAL void AMD_postorder
 (
     Int nn,
@@ -0,0 +1,142 @@
+/* ========================================================================= */
+/* === AMD_1p ============================================================== */
+/* ========================================================================= */
+
+/* ------------------------------------------------------------------------- */
+/* AMD, Copyright (c) Timothy A. Davis,					     */
+/* Patrick R. Amestoy, and Iain S. Duff.  See ../README.txt for License.     */
+/* email: DrTimothyAldenDavis@gmail.com                                      */
+/* ------------------------------------------------------------------------- */
+
+/* AMD_1p: parallel version of AMD_1.  Construct A+A' for a sparse matrix A
+ * and perform the AMD ordering.
+ *
+ * The input matrix and the Len array are the same as for AMD_1, except that
+ * this routine must be preceded by a call to AMD_paat (not AMD_aat), which
+ * also computes the column chunks (Chunk) and the per-chunk row counts (Cnt)
+ * used here.  Cnt is overwritten with the insertion points of each chunk.
+ * Chunk and Cnt are freed once A+A' is constructed, so that the nthreads*n
+ * workspace is not held while AMD_2 orders the matrix.
+ *
+ * Column j of A+A' holds the off-diagonal entries of column j of A, in
+ * ascending order, followed by the unmatched entries of row j of A, also in
+ * ascending order.  This pattern does not depend on the number of threads,
+ * so neither does the ordering.  It is not the same pattern that AMD_1
+ * constructs, however, and thus the ordering may differ slightly from the
+ * sequential one (both are equally valid).
+ */
+
+#include "amd_internal.h"
+
+GLOBAL void AMD_1p
+(
+    Int n,		/* n > 0 */
+    const Int Ap [ ],	/* input of size n+1, not modified */
+    const Int Ai [ ],	/* input of size nz = Ap [n], not modified */
+    Int P [ ],		/* size n output permutation */
+    Int Pinv [ ],	/* size n output inverse permutation */
+    Int Len [ ],	/* size n input, undefined on output */
+    Int slen,		/* slen >= sum (Len [0..n-1]) + 7n,
+			 * ideally slen = 1.2 * sum (Len) + 8n */
+    Int S [ ],		/* size slen workspace */
+    Int nthreads,	/* number of chunks, as given to AMD_paat */
+    Int Chunk [ ],	/* size nthreads+1, from AMD_paat; freed on output */
+    Int Cnt [ ],	/* size nthreads*n, from AMD_paat; freed on output */
+    double Control [ ],	/* input array of size AMD_CONTROL */
+    double Info [ ]	/* output array of size AMD_INFO */
+)
+{
+    Int i, j, p, t, pfree, iwlen, pos, cnt, *Iw, *Pe, *Nv, *Head,
+	*Elen, *Degree, *s, *W ;
+
+    /* --------------------------------------------------------------------- */
+    /* construct the matrix for AMD_2 */
+    /* --------------------------------------------------------------------- */
+
+    ASSERT (n > 0) ;
+
+    iwlen = slen - 6*n ;
+    s = S ;
+    Pe = s ;	    s += n ;
+    Nv = s ;	    s += n ;
+    Head = s ;	    s += n ;
+    Elen = s ;	    s += n ;
+    Degree = s ;    s += n ;
+    W = s ;	    s += n ;
+    Iw = s ;	    s += iwlen ;
+
+    ASSERT (AMD_valid (n, n, Ap, Ai) == AMD_OK) ;
+
+    /* construct the pointers for A+A' */
+    pfree = 0 ;
+    for (j = 0 ; j < n ; j++)
+    {
+	Pe [j] = pfree ;
+	pfree += Len [j] ;
+    }
+    ASSERT (iwlen >= pfree + n) ;
+
+    /* Cnt [t*n+j] becomes the position in Iw where chunk t places its
+     * unmatched entries of row j of A.  Those go after the entries of
+     * column j of A itself, and after the entries of chunks 0 to t-1. */
+    #pragma omp parallel for num_threads(nthreads) schedule(static) \
+	private (t, pos, cnt)
+    for (j = 0 ; j < n ; j++)
+    {
+	pos = Pe [j] + (Ap [j+1] - Ap [j]) ;
+	if (AMD_pfind (j, j, Ap, Ai))
+	{
+	    /* the diagonal is not stored */
+	    pos-- ;
+	}
+	for (t = 0 ; t < nthreads ; t++)
+	{
+	    cnt = Cnt [((size_t) t) * n + j] ;
+	    Cnt [((size_t) t) * n + j] = pos ;
+	    pos += cnt ;
+	}
+	ASSERT (pos == Pe [j] + Len [j]) ;
+    }
+
+    /* fill in the pattern of A+A', one chunk of columns per thread */
+    #pragma omp parallel for num_threads(nthreads) schedule(static,1) \
+	private (i, j, p, pos)
+    for (t = 0 ; t < nthreads ; t++)
+    {
+	Int *Ct = Cnt + ((size_t) t) * n ;
+	for (j = Chunk [t] ; j < Chunk [t+1] ; j++)
+	{
+	    pos = Pe [j] ;
+	    for (p = Ap [j] ; p < Ap [j+1] ; p++)
+	    {
+		i = Ai [p] ;
+		if (i == j) continue ;
+		/* A (i,j) in column j of A+A' */
+		Iw [pos++] = i ;
+		if (!AMD_pfind (j, i, Ap, Ai))
+		{
+		    /* A (j,i) not present: A (i,j) in column i of A+A' */
+		    Iw [Ct [i]++] = j ;
+		}
+	    }
+	}
+    }
+
+#ifndef NDEBUG
+    for (j = 0 ; j < n ; j++)
+    {
+	ASSERT (Cnt [((size_t) (nthreads-1)) * n + j] == Pe [j] + Len [j]) ;
+    }
+#endif
+
+    /* the per-chunk workspace is no longer needed */
+    SuiteSparse_free (Chunk) ;
+    SuiteSparse_free (Cnt) ;
+
+    /* --------------------------------------------------------------------- */
+    /* order the matrix */
+    /* --------------------------------------------------------------------- */
+
+    AMD_2 (n, Pe, Iw, Len, iwlen, pfree,
+	Nv, Pinv, P, Head, Elen, Degree, W, Control, Info) ;
+}
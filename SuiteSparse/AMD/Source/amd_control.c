@@ -21,17 +21,19 @@ GLOBAL void AMD_control
 )
 {
     double alpha ;
-    Int aggressive ;
+    Int aggressive, nthreads ;
 
     if (Control != (double *) NULL)
     {
 	alpha = Control [AMD_DENSE] ;
 	aggressive = Control [AMD_AGGRESSIVE] != 0 ;
+	nthreads = Control [AMD_NTHREADS] ;
     }
     else
     {
 	alpha = AMD_DEFAULT_DENSE ;
 	aggressive = AMD_DEFAULT_AGGRESSIVE ;
+	nthreads = AMD_DEFAULT_NTHREADS ;
     }
 
     SUITESPARSE_PRINTF ((
@@ -60,5 +62,10 @@ GLOBAL void AMD_control
 	SUITESPARSE_PRINTF (("    aggressive absorption:  no\n")) ;
     }
 
+    if (nthreads > 1)
+    {
+	SUITESPARSE_PRINTF (("    threads to construct A+A': "ID"\n", nthreads)) ;
+    }
+
     SUITESPARSE_PRINTF (("    size of AMD integer: %d\n\n", sizeof (Int))) ;
 }
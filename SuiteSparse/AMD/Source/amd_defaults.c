@@ -33,5 +33,6 @@ GLOBAL void AMD_defaults
 	}
 	Control [AMD_DENSE] = AMD_DEFAULT_DENSE ;
 	Control [AMD_AGGRESSIVE] = AMD_DEFAULT_AGGRESSIVE ;
+	Control [AMD_NTHREADS] = AMD_DEFAULT_NTHREADS ;
     }
 }
@@ -79,6 +79,17 @@ GLOBAL void AMD_info
 	Info [AMD_MEMORY]) ;
     PRI ("    # of memory compactions:                            %.20g\n",
 	Info [AMD_NCMPA]) ;
+    PRI ("    elbow room, in bytes:                               %.20g\n",
+	Info [AMD_MEMORY_ELBOW]) ;
+    if (Info [AMD_AAT_THREADS] > 0)
+    {
+	PRI ("    # threads used to construct A+A':                   %.20g\n",
+	    Info [AMD_AAT_THREADS]) ;
+	PRI ("    memory used to construct A+A', in bytes:            %.20g\n",
+	    Info [AMD_MEMORY_AAT]) ;
+	PRI ("    memory used by the ordering itself, in bytes:       %.20g\n",
+	    Info [AMD_MEMORY] - Info [AMD_MEMORY_AAT]) ;
+    }
 
     /* statistics about the ordering quality */
     SUITESPARSE_PRINTF (("\n"
@@ -13,6 +13,9 @@
  */
 
 #include "amd_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /* ========================================================================= */
 /* === AMD_order =========================================================== */
@@ -28,9 +31,10 @@ GLOBAL Int AMD_order
     double Info [ ]
 )
 {
-    Int *Len, *S, nz, i, *Pinv, info, status, *Rp, *Ri, *Cp, *Ci, ok ;
+    Int *Len, *S, nz, i, *Pinv, info, status, *Rp, *Ri, *Cp, *Ci, ok,
+	nthreads, *Chunk, *Cnt ;
     size_t nzaat, slen ;
-    double mem = 0 ;
+    double mem = 0, memaat = 0 ;
 
 #ifndef NDEBUG
     AMD_debug_init ("amd") ;
@@ -138,7 +142,42 @@ GLOBAL Int AMD_order
     /* determine the symmetry and count off-diagonal nonzeros in A+A' */
     /* --------------------------------------------------------------------- */
 
-    nzaat = AMD_aat (n, Cp, Ci, Len, P, Info) ;
+    /* nthreads > 0 if A+A' is to be constructed in parallel (the ordering
+     * depends only on Control [AMD_NTHREADS] > 1, not on nthreads itself) */
+    nthreads = 0 ;
+    Chunk = NULL ;
+    Cnt = NULL ;
+    if (Control != (double *) NULL && Control [AMD_NTHREADS] > 1)
+    {
+	nthreads = (Int) MIN (Control [AMD_NTHREADS], (double) n) ;
+#ifdef _OPENMP
+	nthreads = MIN (nthreads, omp_get_max_threads ( )) ;
+#else
+	nthreads = 1 ;
+#endif
+	nthreads = MAX (nthreads, 1) ;
+	Chunk = SuiteSparse_malloc (nthreads+1, sizeof (Int)) ;
+	Cnt   = SuiteSparse_malloc (((size_t) nthreads) * n, sizeof (Int)) ;
+	memaat = (nthreads+1) + ((double) nthreads) * n ;
+	mem += memaat ;
+	if (!Chunk || !Cnt)
+	{
+	    /* :: out of memory :: */
+	    SuiteSparse_free (Chunk) ;
+	    SuiteSparse_free (Cnt) ;
+	    SuiteSparse_free (Rp) ;
+	    SuiteSparse_free (Ri) ;
+	    SuiteSparse_free (Len) ;
+	    SuiteSparse_free (Pinv) ;
+	    if (info) Info [AMD_STATUS] = AMD_OUT_OF_MEMORY ;
+	    return (AMD_OUT_OF_MEMORY) ;
+	}
+	nzaat = AMD_paat (n, Cp, Ci, Len, nthreads, Chunk, Cnt, Info) ;
+    }
+    else
+    {
+	nzaat = AMD_aat (n, Cp, Ci, Len, P, Info) ;
+    }
     AMD_DEBUG1 (("nzaat: %g\n", (double) nzaat)) ;
     ASSERT ((MAX (nz-n, 0) <= nzaat) && (nzaat <= 2 * (size_t) nz)) ;
 
@@ -166,6 +205,8 @@ GLOBAL Int AMD_order
     if (!S)
     {
 	/* :: out of memory :: (or problem too large) */
+	SuiteSparse_free (Chunk) ;
+	SuiteSparse_free (Cnt) ;
 	SuiteSparse_free (Rp) ;
 	SuiteSparse_free (Ri) ;
 	SuiteSparse_free (Len) ;
@@ -177,18 +218,34 @@ GLOBAL Int AMD_order
     {
 	/* memory usage, in bytes. */
 	Info [AMD_MEMORY] = mem * sizeof (Int) ;
+	Info [AMD_MEMORY_ELBOW] = (slen - nzaat - 6*n) * sizeof (Int) ;
+	Info [AMD_MEMORY_AAT] = memaat * sizeof (Int) ;
+	Info [AMD_AAT_THREADS] = nthreads ;
     }
 
     /* --------------------------------------------------------------------- */
     /* order the matrix */
     /* --------------------------------------------------------------------- */
 
-    AMD_1 (n, Cp, Ci, P, Pinv, Len, slen, S, Control, Info) ;
+    if (nthreads > 0)
+    {
+	/* Chunk and Cnt are freed by AMD_1p, before it calls AMD_2 */
+	AMD_1p (n, Cp, Ci, P, Pinv, Len, slen, S, nthreads, Chunk, Cnt,
+	    Control, Info) ;
+	Chunk = NULL ;
+	Cnt = NULL ;
+    }
+    else
+    {
+	AMD_1 (n, Cp, Ci, P, Pinv, Len, slen, S, Control, Info) ;
+    }
 
     /* --------------------------------------------------------------------- */
     /* free the workspace */
     /* --------------------------------------------------------------------- */
 
+    SuiteSparse_free (Chunk) ;
+    SuiteSparse_free (Cnt) ;
     SuiteSparse_free (Rp) ;
     SuiteSparse_free (Ri) ;
     SuiteSparse_free (Len) ;
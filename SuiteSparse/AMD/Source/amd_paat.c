@@ -0,0 +1,220 @@
+/* ========================================================================= */
+/* === AMD_paat ============================================================ */
+/* ========================================================================= */
+
+/* ------------------------------------------------------------------------- */
+/* AMD, Copyright (c) Timothy A. Davis,					     */
+/* Patrick R. Amestoy, and Iain S. Duff.  See ../README.txt for License.     */
+/* email: DrTimothyAldenDavis@gmail.com                                      */
+/* ------------------------------------------------------------------------- */
+
+/* AMD_paat:  parallel version of AMD_aat.  Computes the symmetry of the
+ * pattern of A, and counts the number of nonzeros in each column of A+A'
+ * (excluding the diagonal).  Like AMD_aat, it assumes the input matrix has
+ * sorted columns and no duplicates (AMD_valid (n, n, Ap, Ai) must be AMD_OK,
+ * but this condition is not checked).
+ *
+ * The columns of A are split into nthreads chunks with about the same number
+ * of entries each; Chunk [t] to Chunk [t+1]-1 are the columns of chunk t.
+ * An entry A(i,j) with i != j always appears in column j of A+A'.  It also
+ * appears in column i of A+A' if A(j,i) is not present.  This second kind of
+ * entry is counted in Cnt [t*n + i] by the thread owning column j, so that no
+ * two threads update the same counter.  The counts are summed into Len, and
+ * Cnt and Chunk are left for AMD_1p, which uses them to construct A+A' and
+ * then frees them.
+ *
+ * The mirror entry A(j,i) is found by a binary search of column i, so the
+ * time taken is O (nz log (nz/n)) work, but it is spread over all threads.
+ */
+
+#include "amd_internal.h"
+
+/* ========================================================================= */
+/* === AMD_pfind =========================================================== */
+/* ========================================================================= */
+
+/* Returns TRUE if row i appears in column j of A.  Column j must be sorted. */
+
+GLOBAL Int AMD_pfind
+(
+    Int i,
+    Int j,
+    const Int Ap [ ],
+    const Int Ai [ ]
+)
+{
+    Int lo, hi, mid ;
+    lo = Ap [j] ;
+    hi = Ap [j+1] - 1 ;
+    while (lo <= hi)
+    {
+	mid = lo + (hi - lo) / 2 ;
+	if (Ai [mid] < i)
+	{
+	    lo = mid + 1 ;
+	}
+	else if (Ai [mid] > i)
+	{
+	    hi = mid - 1 ;
+	}
+	else
+	{
+	    return (TRUE) ;
+	}
+    }
+    return (FALSE) ;
+}
+
+/* ========================================================================= */
+/* === AMD_paat ============================================================ */
+/* ========================================================================= */
+
+GLOBAL size_t AMD_paat	/* returns nz in A+A' */
+(
+    Int n,
+    const Int Ap [ ],
+    const Int Ai [ ],
+    Int Len [ ],	/* Len [j]: length of column j of A+A', excl diagonal*/
+    Int nthreads,	/* number of chunks (and threads) to use, >= 1 */
+    Int Chunk [ ],	/* output of size nthreads+1: column chunks */
+    Int Cnt [ ],	/* output of size nthreads*n: per-chunk row counts */
+    double Info [ ]
+)
+{
+    Int i, j, k, p, t, nz, nzdiag, nzboth, lo, hi, mid, target ;
+    double sym ;
+    size_t nzaat ;
+
+    if (Info != (double *) NULL)
+    {
+	/* clear the Info array, if it exists */
+	for (i = 0 ; i < AMD_INFO ; i++)
+	{
+	    Info [i] = EMPTY ;
+	}
+	Info [AMD_STATUS] = AMD_OK ;
+    }
+
+    nz = Ap [n] ;
+
+    /* --------------------------------------------------------------------- */
+    /* split the columns into chunks with about nz/nthreads entries each */
+    /* --------------------------------------------------------------------- */
+
+    Chunk [0] = 0 ;
+    for (t = 1 ; t < nthreads ; t++)
+    {
+	/* find the first column k with Ap [k] >= target */
+	target = (Int) (((double) nz * t) / nthreads) ;
+	lo = Chunk [t-1] ;
+	hi = n ;
+	while (lo < hi)
+	{
+	    mid = lo + (hi - lo) / 2 ;
+	    if (Ap [mid] < target)
+	    {
+		lo = mid + 1 ;
+	    }
+	    else
+	    {
+		hi = mid ;
+	    }
+	}
+	Chunk [t] = lo ;
+    }
+    Chunk [nthreads] = n ;
+
+    /* --------------------------------------------------------------------- */
+    /* count the entries of A+A' in each chunk */
+    /* --------------------------------------------------------------------- */
+
+    nzdiag = 0 ;
+    nzboth = 0 ;
+
+    #pragma omp parallel for num_threads(nthreads) schedule(static,1) \
+	private (i, j, p) reduction (+:nzdiag,nzboth)
+    for (t = 0 ; t < nthreads ; t++)
+    {
+	Int *Ct = Cnt + ((size_t) t) * n ;
+	for (i = 0 ; i < n ; i++)
+	{
+	    Ct [i] = 0 ;
+	}
+	for (j = Chunk [t] ; j < Chunk [t+1] ; j++)
+	{
+	    Len [j] = 0 ;
+	    for (p = Ap [j] ; p < Ap [j+1] ; p++)
+	    {
+		i = Ai [p] ;
+		if (i == j)
+		{
+		    /* skip the diagonal */
+		    nzdiag++ ;
+		    continue ;
+		}
+		/* A (i,j) is in column j of A+A' */
+		Len [j]++ ;
+		if (AMD_pfind (j, i, Ap, Ai))
+		{
+		    /* A (j,i) is also present; it is counted by column i */
+		    nzboth++ ;
+		}
+		else
+		{
+		    /* A (j,i) is not present, so A (i,j) adds j to column i */
+		    Ct [i]++ ;
+		}
+	    }
+	}
+    }
+
+    /* --------------------------------------------------------------------- */
+    /* sum up the per-chunk counts */
+    /* --------------------------------------------------------------------- */
+
+    nzaat = 0 ;
+
+    #pragma omp parallel for num_threads(nthreads) schedule(static) \
+	private (t) reduction (+:nzaat)
+    for (k = 0 ; k < n ; k++)
+    {
+	for (t = 0 ; t < nthreads ; t++)
+	{
+	    Len [k] += Cnt [((size_t) t) * n + k] ;
+	}
+	nzaat += Len [k] ;
+    }
+
+    /* --------------------------------------------------------------------- */
+    /* compute the symmetry of the nonzero pattern of A */
+    /* --------------------------------------------------------------------- */
+
+    /* nzboth counts each matched pair twice, once from each side, so this is
+     * the same as 2*nzboth/(nz-nzdiag) in AMD_aat */
+
+    if (nz == nzdiag)
+    {
+	sym = 1 ;
+    }
+    else
+    {
+	sym = ((double) nzboth) / ((double) (nz - nzdiag)) ;
+    }
+
+    AMD_DEBUG1 (("AMD nz in A+A', excluding diagonal (nzaat) = %g\n",
+	(double) nzaat)) ;
+    AMD_DEBUG1 (("   nzboth: "ID" nz: "ID" nzdiag: "ID" symmetry: %g\n",
+		nzboth, nz, nzdiag, sym)) ;
+
+    if (Info != (double *) NULL)
+    {
+	Info [AMD_STATUS] = AMD_OK ;
+	Info [AMD_N] = n ;
+	Info [AMD_NZ] = nz ;
+	Info [AMD_SYMMETRY] = sym ;	    /* symmetry of pattern of A */
+	Info [AMD_NZDIAG] = nzdiag ;	    /* nonzeros on diagonal of A */
+	Info [AMD_NZ_A_PLUS_AT] = nzaat ;   /* nonzeros in A+A' */
+    }
+
+    return (nzaat) ;
+}
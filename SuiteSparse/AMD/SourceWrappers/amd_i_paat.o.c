@@ -0,0 +1,2 @@
+#define DINT
+#include <../Source/amd_paat.c>
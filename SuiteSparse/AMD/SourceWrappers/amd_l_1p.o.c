@@ -0,0 +1,2 @@
+#define DLONG
+#include <../Source/amd_1p.c>
@@ -6,6 +6,8 @@
  * BTF_STRONGCOMP:  find a symmetric permutation P to put P*A*P' into block
  *      upper triangular form.
  * BTF_ORDER: do both of the above (btf_maxtrans then btf_strongcomp).
+ * BTF_PMAXTRANS, BTF_PSTRONGCOMP, BTF_PORDER: multithreaded versions of the
+ *      above.
  *
  * By Tim Davis.  Copyright (c) 2004-2007, University of Florida.
  * with support from Sandia National Laboratories.  All Rights Reserved.
@@ -219,6 +221,111 @@ SuiteSparse_long btf_l_order (SuiteSparse_long, SuiteSparse_long *,
     SuiteSparse_long *) ;
 
 
+/* ========================================================================== */
+/* === BTF_PMAXTRANS, BTF_PSTRONGCOMP, BTF_PORDER =========================== */
+/* ========================================================================== */
+
+/* Multithreaded versions of btf_maxtrans, btf_strongcomp, and btf_order, for
+ * very large matrices.  They take the same inputs and give the same kind of
+ * outputs, and can be used in their place (klu_analyze uses btf_porder if
+ * Common->nthreads > 1).  Instead of the Work array, they take the number of
+ * threads to use, and allocate their own workspace with SuiteSparse_malloc.
+ * They return -1 if they run out of memory.  btf_porder also takes the Work
+ * array of size 5n used by btf_order.
+ *
+ * btf_pmaxtrans searches for vertex-disjoint augmenting paths in parallel,
+ * then finishes the matching with a sequential search.  The size of the
+ * matching is the same as btf_maxtrans (unless the work limit is reached),
+ * but the matching itself differs, and depends on how the threads are
+ * scheduled.
+ *
+ * btf_pstrongcomp uses the forward-backward method with trimming.  It finds
+ * the same strongly connected components as btf_strongcomp, but the blocks
+ * can be in a different (equally valid) order.
+ *
+ * These functions require OpenMP 3.1 or later.  If BTF is compiled without
+ * OpenMP, or if nthreads <= 1, they call btf_maxtrans, btf_strongcomp, and
+ * btf_order, respectively.
+ */
+
+int btf_pmaxtrans   /* returns # of columns matched, or -1 if out of memory */
+(
+    /* --- input, not modified: --- */
+    int nrow,       /* A is nrow-by-ncol in compressed column form */
+    int ncol,
+    int Ap [ ],     /* size ncol+1 */
+    int Ai [ ],     /* size nz = Ap [ncol] */
+    double maxwork, /* maximum amount of work to do is maxwork*nnz(A); no limit
+                     * if <= 0 */
+
+    /* --- output, not defined on input --- */
+    double *work,   /* work = -1 if maxwork > 0 and the total work performed
+                     * reached the maximum of maxwork*nnz(A).
+                     * Otherwise, work = the total work performed. */
+    int Match [ ],  /* size nrow.  Match [i] = j if column j matched to row i */
+
+    /* --- input --- */
+    int nthreads    /* number of threads to use */
+) ;
+
+SuiteSparse_long btf_l_pmaxtrans (SuiteSparse_long, SuiteSparse_long,
+    SuiteSparse_long *, SuiteSparse_long *, double, double *,
+    SuiteSparse_long *, SuiteSparse_long) ;
+
+int btf_pstrongcomp /* return # of strongly connected components, or -1 if
+                     * out of memory */
+(
+    /* input, not modified: */
+    int n,          /* A is n-by-n in compressed column form */
+    int Ap [ ],     /* size n+1 */
+    int Ai [ ],     /* size nz = Ap [n] */
+
+    /* optional input, modified (if present) on output: */
+    int Q [ ],      /* size n, input column permutation */
+
+    /* output, not defined on input */
+    int P [ ],      /* size n.  P [k] = j if row and column j are kth row/col
+                     * in permuted matrix. */
+
+    int R [ ],      /* size n+1.  block b is in rows/cols R[b] ... R[b+1]-1 */
+
+    /* input */
+    int nthreads    /* number of threads to use */
+) ;
+
+SuiteSparse_long btf_l_pstrongcomp (SuiteSparse_long, SuiteSparse_long *,
+    SuiteSparse_long *, SuiteSparse_long *, SuiteSparse_long *,
+    SuiteSparse_long *, SuiteSparse_long) ;
+
+int btf_porder      /* returns number of blocks found, or -1 if out of memory */
+(
+    /* --- input, not modified: --- */
+    int n,          /* A is n-by-n in compressed column form */
+    int Ap [ ],     /* size n+1 */
+    int Ai [ ],     /* size nz = Ap [n] */
+    double maxwork, /* do at most maxwork*nnz(A) work in the maximum
+                     * transversal; no limit if <= 0 */
+
+    /* --- output, not defined on input --- */
+    double *work,   /* return value from btf_pmaxtrans */
+    int P [ ],      /* size n, row permutation */
+    int Q [ ],      /* size n, column permutation */
+    int R [ ],      /* size n+1.  block b is in rows/cols R[b] ... R[b+1]-1 */
+    int *nmatch,    /* # nonzeros on diagonal of P*A*Q */
+
+    /* --- input --- */
+    int nthreads,   /* number of threads to use */
+
+    /* --- workspace, not defined on input or output --- */
+    int Work [ ]    /* size 5n */
+) ;
+
+SuiteSparse_long btf_l_porder (SuiteSparse_long, SuiteSparse_long *,
+    SuiteSparse_long *, double , double *, SuiteSparse_long *,
+    SuiteSparse_long *, SuiteSparse_long *, SuiteSparse_long *,
+    SuiteSparse_long, SuiteSparse_long *) ;
+
+
 /* ========================================================================== */
 /* === BTF marking of singular columns ====================================== */
 /* ========================================================================== */
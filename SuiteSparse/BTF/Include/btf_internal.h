@@ -49,6 +49,7 @@
 #undef FALSE
 #undef PRINTF
 #undef MIN
+#undef MAX
 
 #ifndef NPRINT
 #define PRINTF(s) { printf s ; } ;
@@ -60,5 +61,13 @@
 #define FALSE 0
 #define EMPTY (-1)
 #define MIN(a,b) (((a) < (b)) ?  (a) : (b))
+#define MAX(a,b) (((a) > (b)) ?  (a) : (b))
+
+/* The parallel routines (btf_pmaxtrans and btf_pstrongcomp) require OpenMP
+ * 3.1 or later (for "omp atomic capture").  Otherwise they are sequential. */
+#if defined (_OPENMP) && (_OPENMP >= 201107)
+#include <omp.h>
+#define BTF_OPENMP
+#endif
 
 #endif
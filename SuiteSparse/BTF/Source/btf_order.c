@@ -29,50 +29,27 @@
 #include "btf.h"
 #include "btf_internal.h"
 
-/* This function only operates on square matrices (either structurally full-
- * rank, or structurally rank deficient). */
-
-Int BTF(order)      /* returns number of blocks found */
-(
-    /* input, not modified: */
-    Int n,          /* A is n-by-n in compressed column form */
-    Int Ap [ ],     /* size n+1 */
-    Int Ai [ ],     /* size nz = Ap [n] */
-    double maxwork, /* do at most maxwork*nnz(A) work in the maximum
-                     * transversal; no limit if <= 0 */
+/* ========================================================================== */
+/* === complete_match ======================================================= */
+/* ========================================================================== */
 
-    /* output, not defined on input */
-    double *work,   /* work performed in maxtrans, or -1 if limit reached */
-    Int P [ ],      /* size n, row permutation */
-    Int Q [ ],      /* size n, column permutation */
-    Int R [ ],      /* size n+1.  block b is in rows/cols R[b] ... R[b+1]-1 */
-    Int *nmatch,    /* # nonzeros on diagonal of P*A*Q */
+/* Since the matrix is square, ensure BTF_UNFLIP(Q[0..n-1]) is a permutation
+ * of the columns of A so that A has as many nonzeros on the diagonal as
+ * possible.  The unmatched columns are assigned to the unmatched rows, and
+ * flagged.  Work has size 2n. */
 
-    /* workspace, not defined on input or output */
-    Int Work [ ]    /* size 5n */
+static void complete_match
+(
+    Int n,
+    Int nmatch,
+    Int Q [ ],
+    Int Work [ ]
 )
 {
     Int *Flag ;
-    Int nblocks, i, j, nbadcol ;
-
-    /* ---------------------------------------------------------------------- */
-    /* compute the maximum matching */
-    /* ---------------------------------------------------------------------- */
+    Int i, j, nbadcol ;
 
-    /* if maxwork > 0, then a maximum matching might not be found */
-
-    *nmatch = BTF(maxtrans) (n, n, Ap, Ai, maxwork, work, Q, Work) ;
-
-    /* ---------------------------------------------------------------------- */
-    /* complete permutation if the matrix is structurally singular */
-    /* ---------------------------------------------------------------------- */
-
-    /* Since the matrix is square, ensure BTF_UNFLIP(Q[0..n-1]) is a
-     * permutation of the columns of A so that A has as many nonzeros on the
-     * diagonal as possible.
-     */
-
-    if (*nmatch < n)
+    if (nmatch < n)
     {
         /* get a size-n work array */
         Flag = Work + n ;
@@ -102,7 +79,7 @@ Int BTF(order)      /* returns number of blocks found */
                 Work [nbadcol++] = j ;
             }
         }
-        ASSERT (*nmatch + nbadcol == n) ;
+        ASSERT (nmatch + nbadcol == n) ;
 
         /* make an assignment for each unmatched row */
         for (i = 0 ; i < n ; i++)
@@ -116,6 +93,46 @@ Int BTF(order)      /* returns number of blocks found */
             }
         }
     }
+}
+
+/* This function only operates on square matrices (either structurally full-
+ * rank, or structurally rank deficient). */
+
+Int BTF(order)      /* returns number of blocks found */
+(
+    /* input, not modified: */
+    Int n,          /* A is n-by-n in compressed column form */
+    Int Ap [ ],     /* size n+1 */
+    Int Ai [ ],     /* size nz = Ap [n] */
+    double maxwork, /* do at most maxwork*nnz(A) work in the maximum
+                     * transversal; no limit if <= 0 */
+
+    /* output, not defined on input */
+    double *work,   /* work performed in maxtrans, or -1 if limit reached */
+    Int P [ ],      /* size n, row permutation */
+    Int Q [ ],      /* size n, column permutation */
+    Int R [ ],      /* size n+1.  block b is in rows/cols R[b] ... R[b+1]-1 */
+    Int *nmatch,    /* # nonzeros on diagonal of P*A*Q */
+
+    /* workspace, not defined on input or output */
+    Int Work [ ]    /* size 5n */
+)
+{
+    Int nblocks ;
+
+    /* ---------------------------------------------------------------------- */
+    /* compute the maximum matching */
+    /* ---------------------------------------------------------------------- */
+
+    /* if maxwork > 0, then a maximum matching might not be found */
+
+    *nmatch = BTF(maxtrans) (n, n, Ap, Ai, maxwork, work, Q, Work) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* complete permutation if the matrix is structurally singular */
+    /* ---------------------------------------------------------------------- */
+
+    complete_match (n, *nmatch, Q, Work) ;
 
     /* The permutation of a square matrix can be recovered as follows: Row i is
      * matched with column j, where j = BTF_UNFLIP (Q [i]) and where j
@@ -130,3 +147,49 @@ Int BTF(order)      /* returns number of blocks found */
     nblocks = BTF(strongcomp) (n, Ap, Ai, Q, P, R, Work) ;
     return (nblocks) ;
 }
+
+
+/* ========================================================================== */
+/* === BTF_PORDER =========================================================== */
+/* ========================================================================== */
+
+/* Same as BTF_ORDER, except that btf_pmaxtrans and btf_pstrongcomp are used,
+ * with nthreads threads.  Returns -1 if out of memory (in which case the
+ * caller can use BTF_ORDER instead).  The result can differ from BTF_ORDER,
+ * but it is an equally valid block triangular form, with the same number of
+ * nonzeros on the diagonal (unless the work limit is reached).  If A has full
+ * structural rank, the number of blocks is also the same.  Otherwise the
+ * blocks depend on which maximum matching is found, and the number of blocks
+ * can differ. */
+
+Int BTF(porder)     /* returns number of blocks found, -1 if out of memory */
+(
+    /* input, not modified: */
+    Int n,          /* A is n-by-n in compressed column form */
+    Int Ap [ ],     /* size n+1 */
+    Int Ai [ ],     /* size nz = Ap [n] */
+    double maxwork, /* do at most maxwork*nnz(A) work in the maximum
+                     * transversal; no limit if <= 0 */
+
+    /* output, not defined on input */
+    double *work,   /* work performed in maxtrans, or -1 if limit reached */
+    Int P [ ],      /* size n, row permutation */
+    Int Q [ ],      /* size n, column permutation */
+    Int R [ ],      /* size n+1.  block b is in rows/cols R[b] ... R[b+1]-1 */
+    Int *nmatch,    /* # nonzeros on diagonal of P*A*Q */
+
+    /* input */
+    Int nthreads,   /* number of threads to use */
+
+    /* workspace, not defined on input or output */
+    Int Work [ ]    /* size 5n */
+)
+{
+    *nmatch = BTF(pmaxtrans) (n, n, Ap, Ai, maxwork, work, Q, nthreads) ;
+    if (*nmatch < 0)
+    {
+        return (EMPTY) ;
+    }
+    complete_match (n, *nmatch, Q, Work) ;
+    return (BTF(pstrongcomp) (n, Ap, Ai, Q, P, R, nthreads)) ;
+}
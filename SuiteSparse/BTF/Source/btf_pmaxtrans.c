@@ -0,0 +1,365 @@
+/* ========================================================================== */
+/* === BTF_PMAXTRANS ======================================================== */
+/* ========================================================================== */
+
+/* Finds a column permutation that maximizes the number of entries on the
+ * diagonal of a sparse matrix, using multiple threads.  See btf.h for more
+ * information.
+ *
+ * The method is the same as BTF_MAXTRANS (a depth-first-search for augmenting
+ * paths, each one starting with a "cheap match"), except that the searches
+ * are done in phases.  In each phase, all unmatched columns are searched in
+ * parallel, and each thread claims the rows it visits.  A row can be claimed
+ * by only one search per phase, so the augmenting paths found in a phase are
+ * vertex-disjoint and can be applied at the same time, with no locking.  A
+ * search that runs into a row claimed by another thread just skips it, so it
+ * may fail even though an augmenting path exists.  Such columns are tried
+ * again in the next phase.  Once a phase makes too little progress, the
+ * remaining unmatched columns are searched one at a time, which guarantees a
+ * maximum matching (or a limited one if maxwork > 0), just as BTF_MAXTRANS.
+ *
+ * The row claims use "#pragma omp atomic capture", so OpenMP 3.1 or later is
+ * required to use more than one thread.  Otherwise (or if nthreads <= 1) this
+ * function simply calls BTF_MAXTRANS.
+ *
+ * The matching found depends on how the threads are scheduled, but its size
+ * does not (unless the work limit is reached).
+ *
+ * By Tim Davis.  Copyright (c) 2004-2007, University of Florida.
+ * with support from Sandia National Laboratories.  All Rights Reserved.
+ */
+
+#include "btf.h"
+#include "btf_internal.h"
+
+/* ========================================================================== */
+/* === claim ================================================================ */
+/* ========================================================================== */
+
+/* Claim row i for the current search (stamp), and return TRUE if successful.
+ * Returns FALSE if row i has already been claimed by any search with the same
+ * stamp (that is, by any search in this phase). */
+
+static Int claim
+(
+    Int i,
+    Int Visited [ ],
+    Int stamp
+)
+{
+    Int old ;
+#pragma omp atomic capture
+    { old = Visited [i] ; Visited [i] = stamp ; }
+    return (old != stamp) ;
+}
+
+/* ========================================================================== */
+/* === paugment ============================================================= */
+/* ========================================================================== */
+
+/* Search for an augmenting path starting at the unmatched column k, and
+ * augment the matching if one is found.  Returns TRUE if the matching was
+ * augmented, FALSE if no path was found, and EMPTY if the search gave up
+ * because of the work limit or the size of the stacks.  Only rows claimed by
+ * this search are modified in Match, and only columns matched to those rows
+ * (and k itself) are modified in Cheap, so searches can be done in parallel.
+ * Match [i] is read (with an atomic read) before row i is claimed only in the
+ * cheap match, to skip rows that are already matched.  Match [i] does not
+ * change once row i is claimed. */
+
+static Int paugment
+(
+    Int k,              /* the unmatched column to start at */
+    Int Ap [ ],         /* column pointers, size ncol+1 */
+    Int Ai [ ],         /* row indices, size nz = Ap [ncol] */
+    Int Match [ ],      /* size nrow,  Match [i] = j if col j matched to i */
+    Int Cheap [ ],      /* rows Ai [Ap [j] .. Cheap [j]-1] alread matched */
+    Int Visited [ ],    /* Visited [i] = stamp if row i claimed this phase */
+    Int stamp,          /* stamp for this search */
+    Int Istack [ ],     /* size maxdepth.  Row index stack. */
+    Int Jstack [ ],     /* size maxdepth.  Column index stack. */
+    Int Pstack [ ],     /* size maxdepth.  Position in adjacency list. */
+    Int maxdepth,       /* maximum length of an augmenting path */
+    double *work,       /* work performed by this search (incremented) */
+    double maxwork      /* maximum work allowed for this search (<= 0: none) */
+)
+{
+    Int found, head, j, j2, p, pend, pstart, i, m, quick ;
+
+    quick = (maxwork > 0) ;
+    found = FALSE ;
+    i = EMPTY ;
+    head = 0 ;
+    Jstack [0] = k ;
+    Pstack [0] = EMPTY ;
+
+    while (head >= 0)
+    {
+        j = Jstack [head] ;
+        pend = Ap [j+1] ;
+
+        if (Pstack [head] == EMPTY)
+        {
+            /* first visit of column j: try a cheap match */
+            for (p = Cheap [j] ; p < pend && !found ; p++)
+            {
+                i = Ai [p] ;
+#pragma omp atomic read
+                m = Match [i] ;
+                found = (m == EMPTY && claim (i, Visited, stamp)
+                    && Match [i] == EMPTY) ;
+            }
+            Cheap [j] = p ;
+            if (found)
+            {
+                Istack [head] = i ;
+                break ;
+            }
+            Pstack [head] = Ap [j] ;
+        }
+
+        if (quick && *work > maxwork)
+        {
+            /* too much work has been performed; abort the search */
+            return (EMPTY) ;
+        }
+
+        /* continue the depth-first-search at column j */
+        pstart = Pstack [head] ;
+        for (p = pstart ; p < pend ; p++)
+        {
+            i = Ai [p] ;
+            if (claim (i, Visited, stamp))
+            {
+                j2 = Match [i] ;
+                if (j2 == EMPTY)
+                {
+                    /* another search left this row unmatched; take it */
+                    found = TRUE ;
+                    Istack [head] = i ;
+                    break ;
+                }
+                if (head + 1 >= maxdepth)
+                {
+                    /* the path is too long for this search */
+                    return (EMPTY) ;
+                }
+                /* continue the search at column j2 */
+                Pstack [head] = p + 1 ;
+                Istack [head] = i ;
+                Jstack [++head] = j2 ;
+                Pstack [head] = EMPTY ;
+                break ;
+            }
+        }
+        *work += (p - pstart + 1) ;
+        if (found)
+        {
+            break ;
+        }
+        if (p == pend)
+        {
+            /* all of column j has been searched; backtrack */
+            head-- ;
+        }
+    }
+
+    if (found)
+    {
+        /* augment the matching along the path in the stack */
+        for (p = head ; p >= 0 ; p--)
+        {
+            j = Jstack [p] ;
+            i = Istack [p] ;
+#pragma omp atomic write
+            Match [i] = j ;
+        }
+    }
+    return (found) ;
+}
+
+/* ========================================================================== */
+/* === BTF_PMAXTRANS ======================================================== */
+/* ========================================================================== */
+
+Int BTF(pmaxtrans)  /* returns # of columns in the matching, -1 if out of
+                     * memory */
+(
+    /* --- input --- */
+    Int nrow,       /* A is nrow-by-ncol in compressed column form */
+    Int ncol,
+    Int Ap [ ],     /* size ncol+1 */
+    Int Ai [ ],     /* size nz = Ap [ncol] */
+    double maxwork, /* do at most maxwork*nnz(A) work; no limit if <= 0. */
+
+    /* --- output --- */
+    double *work,   /* work = -1 if maxwork > 0 and the total work performed
+                     * reached the maximum of maxwork*nnz(A)).
+                     * Otherwise, work = the total work performed. */
+    Int Match [ ],  /* size nrow.  Match [i] = j if column j matched to row i */
+
+    /* --- input --- */
+    Int nthreads    /* number of threads to use */
+)
+{
+    Int *Cheap, *Visited, *Unmatched, *Found, *Istack, *Jstack, *Pstack, *Work ;
+    Int i, j, k, nmatch, nunmatched, nfound, stamp, maxdepth, work_limit_reached,
+        t, result ;
+    double phase_work, limit ;
+    size_t wsize ;
+
+    /* ---------------------------------------------------------------------- */
+    /* use the sequential method if only one thread is available */
+    /* ---------------------------------------------------------------------- */
+
+#ifndef BTF_OPENMP
+    nthreads = 1 ;
+#endif
+    nthreads = MIN (nthreads, ncol) ;
+    *work = 0 ;
+
+    if (nthreads <= 1)
+    {
+        Work = (Int *) SuiteSparse_malloc (5 * (size_t) MAX (ncol,1),
+            sizeof (Int)) ;
+        if (Work == NULL)
+        {
+            return (EMPTY) ;
+        }
+        nmatch = BTF(maxtrans) (nrow, ncol, Ap, Ai, maxwork, work, Match,
+            Work) ;
+        SuiteSparse_free (Work) ;
+        return (nmatch) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* get workspace and initialize */
+    /* ---------------------------------------------------------------------- */
+
+    /* Each thread gets a stack of depth ncol/nthreads+1 in the parallel
+     * phases.  Longer paths are left for the final sequential phase, which
+     * uses the whole stack. */
+    maxdepth = ncol / nthreads + 1 ;
+    wsize = (size_t) nrow + 3 * (size_t) ncol + 3 * (size_t) maxdepth * nthreads ;
+    Work = (Int *) SuiteSparse_malloc (wsize, sizeof (Int)) ;
+    if (Work == NULL)
+    {
+        return (EMPTY) ;
+    }
+    Visited   = Work ;
+    Cheap     = Visited + nrow ;
+    Unmatched = Cheap + ncol ;
+    Found     = Unmatched + ncol ;
+    Istack    = Found + ncol ;
+    Jstack    = Istack + maxdepth * nthreads ;
+    Pstack    = Jstack + maxdepth * nthreads ;
+
+    for (i = 0 ; i < nrow ; i++)
+    {
+        Match [i] = EMPTY ;
+        Visited [i] = 0 ;
+    }
+    for (j = 0 ; j < ncol ; j++)
+    {
+        Cheap [j] = Ap [j] ;
+        Unmatched [j] = j ;
+    }
+
+    limit = (maxwork > 0) ? (maxwork * Ap [ncol]) : 0 ;
+    nunmatched = ncol ;
+    work_limit_reached = FALSE ;
+    stamp = 0 ;
+
+    /* ---------------------------------------------------------------------- */
+    /* parallel phases */
+    /* ---------------------------------------------------------------------- */
+
+    do
+    {
+        /* each search in a phase gets the same stamp */
+        stamp++ ;
+        phase_work = 0 ;
+        nfound = 0 ;
+
+#pragma omp parallel num_threads(nthreads) private (k, t, result) \
+    reduction (+:phase_work,nfound)
+        {
+            double mywork = 0, mymax ;
+#ifdef BTF_OPENMP
+            t = omp_get_thread_num ( ) ;
+#else
+            t = 0 ;
+#endif
+            /* each thread may use an equal share of the remaining work */
+            mymax = (limit > 0) ? MAX ((limit - *work) / nthreads, 1) : 0 ;
+#pragma omp for schedule(dynamic,64)
+            for (k = 0 ; k < nunmatched ; k++)
+            {
+                result = paugment (Unmatched [k], Ap, Ai, Match, Cheap,
+                    Visited, stamp, Istack + t*maxdepth, Jstack + t*maxdepth,
+                    Pstack + t*maxdepth, maxdepth, &mywork, mymax) ;
+                Found [k] = result ;
+                if (result == TRUE)
+                {
+                    nfound++ ;
+                }
+            }
+            phase_work += mywork ;
+        }
+        *work += phase_work ;
+
+        /* remove the newly matched columns from the list */
+        k = nunmatched ;
+        nunmatched = 0 ;
+        for (i = 0 ; i < k ; i++)
+        {
+            if (Found [i] != TRUE)
+            {
+                Unmatched [nunmatched++] = Unmatched [i] ;
+            }
+        }
+
+    } while (nfound >= nthreads && nunmatched > 0
+        && !(limit > 0 && *work > limit)) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* sequential phase */
+    /* ---------------------------------------------------------------------- */
+
+    /* Each column gets its own stamp, so no search is blocked by another, and
+     * the maximum matching is found (unless the work limit is reached). */
+
+    for (k = 0 ; k < nunmatched ; k++)
+    {
+        stamp++ ;
+        result = paugment (Unmatched [k], Ap, Ai, Match, Cheap, Visited,
+            stamp, Istack, Jstack, Pstack, ncol + 1, work, limit) ;
+        if (result == EMPTY)
+        {
+            work_limit_reached = TRUE ;
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* free workspace and return the result */
+    /* ---------------------------------------------------------------------- */
+
+    SuiteSparse_free (Work) ;
+
+    nmatch = 0 ;
+    for (i = 0 ; i < nrow ; i++)
+    {
+        if (Match [i] != EMPTY)
+        {
+            nmatch++ ;
+        }
+    }
+
+    if (work_limit_reached)
+    {
+        /* return -1 if the work limit of maxwork*nnz(A) was reached */
+        *work = EMPTY ;
+    }
+
+    return (nmatch) ;
+}
@@ -0,0 +1,861 @@
+/* ========================================================================== */
+/* === BTF_PSTRONGCOMP ====================================================== */
+/* ========================================================================== */
+
+/* Finds the strongly connected components of a graph, or equivalently, permutes
+ * the matrix into upper block triangular form, using multiple threads.  The
+ * inputs and outputs are the same as BTF_STRONGCOMP (see btf.h), except that
+ * the workspace is allocated here.  The blocks are not always in the same
+ * order as the ones found by BTF_STRONGCOMP (any topological order of the
+ * blocks is a valid block triangular form), but the result is the same for
+ * any nthreads > 1.  As in BTF_STRONGCOMP, the natural ordering is preserved
+ * within each block.
+ *
+ * The method is the forward-backward (FW-BW) method with trimming, from
+ * Fleischer, Hendrickson, and Pinar, "On identifying strongly connected
+ * components in parallel", 2000, and McLendon et al., "Finding strongly
+ * connected components in distributed graphs", J. Parallel Distrib. Comput.,
+ * vol. 65, 2005.  Edges of the graph go from node j to node i if A(i,j) is
+ * nonzero (where A is replaced by A*Q if Q is present).  A set of nodes is
+ * split as follows:
+ *
+ *  (1) trimming: a node with no out-going edges in the set is a component by
+ *      itself, and goes first.  A node with no in-coming edges in the set is
+ *      also a component by itself, and goes last.  This is repeated until no
+ *      such nodes remain.
+ *
+ *  (2) FW-BW: a pivot node v is selected.  The nodes reachable from v (FW) and
+ *      the nodes that reach v (BW) are found by two breadth-first-searches.
+ *      FW and BW intersect in the component containing v.  The set is then
+ *      split into FW\BW, the rest, FW and BW, and BW\FW, in that order.  No
+ *      strongly connected component spans two of these subsets, and the
+ *      three subsets other than the component of v can be split further, in
+ *      parallel.
+ *
+ * At the top level, the trimming and the searches are done with parallel
+ * loops (this handles the common case of one large component surrounded by
+ * many small ones).  The subsets are then split by independent OpenMP tasks.
+ * Sets smaller than a cutoff are not split further, but are finished with
+ * Tarjan's method (as in BTF_STRONGCOMP) restricted to the set.
+ *
+ * OpenMP 3.1 or later is required.  If it is not available, or if nthreads is
+ * 1, then BTF_STRONGCOMP is used instead.
+ *
+ * By Tim Davis.  Copyright (c) 2004-2007, University of Florida.
+ * with support from Sandia National Laboratories.  All Rights Reserved.
+ */
+
+#include "btf.h"
+#include "btf_internal.h"
+
+#define UNVISITED (-2)      /* Flag [j] = UNVISITED if node j not visited yet */
+#define UNASSIGNED (-1)     /* node j visited but not assigned to a block */
+#define DONE (-1)           /* Color [j] = DONE if j is in a completed block */
+
+/* ========================================================================== */
+/* === scc_info ============================================================= */
+/* ========================================================================== */
+
+/* Each set of nodes being split is held in Nodes [start ... start+len-1], in
+ * ascending order, and all of its nodes j have Color [j] == start.  Sets are
+ * disjoint, so all of the workspace arrays indexed by position (Tmp, Queue,
+ * Next) can be shared by concurrent tasks, each using only the positions of
+ * its own set.  The arrays indexed by node (Fw, Bw, Indeg, Outdeg) are only
+ * accessed for nodes in the set being split. */
+
+typedef struct
+{
+    Int n ;
+    Int *Ap, *Ai, *Q ;  /* node j -> rows of column j of A*Q */
+    Int *Tp, *Ti ;      /* node j <- Ti [Tp [j] ... Tp [j+1]-1] */
+    Int *Color ;        /* Color [j]: the set containing j, or DONE */
+    Int *Fw, *Bw ;      /* stamps for the forward and backward searches */
+    Int *Indeg, *Outdeg ;   /* degrees of each node in its set */
+    Int *Nodes ;        /* size n, the output permutation P */
+    Int *Block ;        /* Block [k] = 1 if a block starts at position k */
+    Int *Tmp, *Queue, *Next ;   /* workspace indexed by position */
+    Int stamp ;         /* last stamp used */
+    Int cutoff ;        /* sets of this size or less use Tarjan's method */
+
+} scc_info ;
+
+/* column of A that holds the out-going edges of node j */
+#define COL(W,j) (((W)->Q == (Int *) NULL) ? (j) : BTF_UNFLIP ((W)->Q [j]))
+
+/* ========================================================================== */
+/* === new_stamp ============================================================ */
+/* ========================================================================== */
+
+static Int new_stamp (scc_info *W)
+{
+    Int stamp ;
+#pragma omp atomic capture
+    stamp = ++(W->stamp) ;
+    return (stamp) ;
+}
+
+/* ========================================================================== */
+/* === trim ================================================================= */
+/* ========================================================================== */
+
+/* Remove all nodes of a set that have no in-coming or no out-going edges in
+ * the set, repeatedly.  Each removed node is a block of size 1.  Nodes with no
+ * out-going edges are placed at the front of the set, and nodes with no
+ * in-coming edges at the end.  The remaining nodes are placed in between, in
+ * ascending order, and get the new label *plo.  The degrees are computed with
+ * nthreads threads; the rest is sequential, and takes time proportional to
+ * the number of edges of the nodes removed. */
+
+static void trim
+(
+    scc_info *W,
+    Int start,          /* the set is Nodes [start ... start+len-1] */
+    Int len,
+    Int nthreads,
+    Int *plo,           /* the remaining set is Nodes [lo ... hi-1] */
+    Int *phi
+)
+{
+    Int *Ap = W->Ap, *Ai = W->Ai, *Tp = W->Tp, *Ti = W->Ti, *Color = W->Color,
+        *Indeg = W->Indeg, *Outdeg = W->Outdeg, *Nodes = W->Nodes,
+        *Tmp = W->Tmp, *Stack = W->Queue + start ;
+    Int label = start, k, j, i, p, jj, d, top, nfront, nback, lo ;
+
+    /* ---------------------------------------------------------------------- */
+    /* compute the in- and out-degree of each node in the set */
+    /* ---------------------------------------------------------------------- */
+
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1) \
+    schedule(dynamic,1024) private (j, jj, d, p, i)
+    for (k = start ; k < start + len ; k++)
+    {
+        j = Nodes [k] ;
+        jj = COL (W, j) ;
+        d = 0 ;
+        for (p = Ap [jj] ; p < Ap [jj+1] ; p++)
+        {
+            i = Ai [p] ;
+            if (i != j && Color [i] == label) d++ ;
+        }
+        Outdeg [j] = d ;
+        d = 0 ;
+        for (p = Tp [j] ; p < Tp [j+1] ; p++)
+        {
+            if (Color [Ti [p]] == label) d++ ;
+        }
+        Indeg [j] = d ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* remove nodes with zero in- or out-degree */
+    /* ---------------------------------------------------------------------- */
+
+    /* A node is removed as soon as one of its degrees becomes zero, so each
+     * node is pushed on the Stack at most once.  A node removed with zero
+     * out-degree (a sink) has all its out-going neighbors removed already, and
+     * these appear before it.  Likewise for sources, which are placed from the
+     * end backwards. */
+
+#define REMOVE_SINK(j)                          \
+    {                                           \
+        Color [j] = DONE ;                      \
+        Tmp [start + nfront++] = j ;            \
+        Stack [top++] = j ;                     \
+    }
+#define REMOVE_SOURCE(j)                        \
+    {                                           \
+        Color [j] = DONE ;                      \
+        Tmp [start + len - 1 - nback++] = j ;   \
+        Stack [top++] = j ;                     \
+    }
+
+    nfront = 0 ;
+    nback = 0 ;
+    top = 0 ;
+    for (k = start ; k < start + len ; k++)
+    {
+        j = Nodes [k] ;
+        if (Outdeg [j] == 0)
+        {
+            REMOVE_SINK (j) ;
+        }
+        else if (Indeg [j] == 0)
+        {
+            REMOVE_SOURCE (j) ;
+        }
+    }
+
+    while (top > 0)
+    {
+        j = Stack [--top] ;
+        if (Outdeg [j] == 0)
+        {
+            /* j was a sink: its in-coming neighbors lose an out-going edge */
+            for (p = Tp [j] ; p < Tp [j+1] ; p++)
+            {
+                i = Ti [p] ;
+                if (Color [i] == label && --Outdeg [i] == 0)
+                {
+                    REMOVE_SINK (i) ;
+                }
+            }
+        }
+        else
+        {
+            /* j was a source: its out-going neighbors lose an in-coming edge */
+            jj = COL (W, j) ;
+            for (p = Ap [jj] ; p < Ap [jj+1] ; p++)
+            {
+                i = Ai [p] ;
+                if (i != j && Color [i] == label && --Indeg [i] == 0)
+                {
+                    REMOVE_SOURCE (i) ;
+                }
+            }
+        }
+    }
+
+#undef REMOVE_SINK
+#undef REMOVE_SOURCE
+
+    /* ---------------------------------------------------------------------- */
+    /* place the remaining nodes in between, and relabel them */
+    /* ---------------------------------------------------------------------- */
+
+    lo = start + nfront ;
+    d = lo ;
+    for (k = start ; k < start + len ; k++)
+    {
+        j = Nodes [k] ;
+        if (Color [j] == label)
+        {
+            Color [j] = lo ;
+            Tmp [d++] = j ;
+        }
+    }
+    ASSERT (d == start + len - nback) ;
+    for (k = start ; k < start + len ; k++)
+    {
+        Nodes [k] = Tmp [k] ;
+    }
+    for (k = start ; k < lo ; k++)
+    {
+        W->Block [k] = 1 ;
+    }
+    for (k = d ; k < start + len ; k++)
+    {
+        W->Block [k] = 1 ;
+    }
+    *plo = lo ;
+    *phi = d ;
+}
+
+/* ========================================================================== */
+/* === bfs ================================================================== */
+/* ========================================================================== */
+
+/* Mark all nodes of the set reachable from the root (if forward is TRUE), or
+ * that can reach the root (if forward is FALSE), with Mark [j] = stamp.  With
+ * nthreads > 1, each level of the search is done in parallel, and the nodes
+ * are claimed with an atomic capture.  The set of nodes marked does not depend
+ * on the number of threads. */
+
+static void bfs
+(
+    scc_info *W,
+    Int root,
+    Int start,          /* the set starts at Nodes [start] */
+    Int forward,
+    Int stamp,
+    Int nthreads
+)
+{
+    Int *Ap = W->Ap, *Ai = W->Ai, *Tp = W->Tp, *Ti = W->Ti, *Color = W->Color,
+        *Mark = forward ? W->Fw : W->Bw, *Frontier = W->Queue + start,
+        *Next = W->Next + start, *Swap ;
+    Int label = start, head, tail, j, jj, i, p, pstart, pend, f, nf, nnext,
+        old, pos ;
+
+    Mark [root] = stamp ;
+    Frontier [0] = root ;
+
+    if (nthreads <= 1)
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* sequential breadth-first-search */
+        /* ------------------------------------------------------------------ */
+
+        head = 0 ;
+        tail = 1 ;
+        while (head < tail)
+        {
+            j = Frontier [head++] ;
+            jj = forward ? COL (W, j) : j ;
+            pstart = forward ? Ap [jj] : Tp [j] ;
+            pend   = forward ? Ap [jj+1] : Tp [j+1] ;
+            for (p = pstart ; p < pend ; p++)
+            {
+                i = forward ? Ai [p] : Ti [p] ;
+                if (Color [i] == label && Mark [i] != stamp)
+                {
+                    Mark [i] = stamp ;
+                    Frontier [tail++] = i ;
+                }
+            }
+        }
+
+    }
+    else
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* parallel level-synchronous breadth-first-search */
+        /* ------------------------------------------------------------------ */
+
+        nf = 1 ;
+        while (nf > 0)
+        {
+            nnext = 0 ;
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic,256) \
+    private (j, jj, pstart, pend, p, i, old, pos)
+            for (f = 0 ; f < nf ; f++)
+            {
+                j = Frontier [f] ;
+                jj = forward ? COL (W, j) : j ;
+                pstart = forward ? Ap [jj] : Tp [j] ;
+                pend   = forward ? Ap [jj+1] : Tp [j+1] ;
+                for (p = pstart ; p < pend ; p++)
+                {
+                    i = forward ? Ai [p] : Ti [p] ;
+                    if (Color [i] != label) continue ;
+#pragma omp atomic capture
+                    { old = Mark [i] ; Mark [i] = stamp ; }
+                    if (old != stamp)
+                    {
+                        /* node i claimed by this thread */
+#pragma omp atomic capture
+                        pos = nnext++ ;
+                        Next [pos] = i ;
+                    }
+                }
+            }
+            Swap = Frontier ;
+            Frontier = Next ;
+            Next = Swap ;
+            nf = nnext ;
+        }
+    }
+}
+
+/* ========================================================================== */
+/* === split ================================================================ */
+/* ========================================================================== */
+
+/* Split a set into up to three smaller sets, after removing all trivial
+ * components and the component of the pivot. */
+
+static void split
+(
+    scc_info *W,
+    Int start,          /* the set is Nodes [start ... start+len-1] */
+    Int len,
+    Int nthreads,
+    Int Sub_start [3],  /* the three subsets */
+    Int Sub_len [3]
+)
+{
+    Int *Nodes = W->Nodes, *Color = W->Color, *Fw = W->Fw, *Bw = W->Bw,
+        *Tmp = W->Tmp ;
+    Int lo, hi, k, j, pivot, fstamp, bstamp, infw, inbw, na, nb, nc, nd, pa,
+        pb, pc, pd ;
+
+    Sub_len [0] = 0 ;
+    Sub_len [1] = 0 ;
+    Sub_len [2] = 0 ;
+
+    /* ---------------------------------------------------------------------- */
+    /* trim the set */
+    /* ---------------------------------------------------------------------- */
+
+    trim (W, start, len, nthreads, &lo, &hi) ;
+    if (lo == hi)
+    {
+        return ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* find the nodes reachable from the pivot, and that reach the pivot */
+    /* ---------------------------------------------------------------------- */
+
+    /* the middle node is a good pivot for graphs that are long and thin */
+    pivot = Nodes [lo + (hi - lo) / 2] ;
+    fstamp = new_stamp (W) ;
+    bstamp = new_stamp (W) ;
+    bfs (W, pivot, lo, TRUE,  fstamp, nthreads) ;
+    bfs (W, pivot, lo, FALSE, bstamp, nthreads) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* split the set into FW\BW, the rest, FW and BW, and BW\FW */
+    /* ---------------------------------------------------------------------- */
+
+    na = 0 ;
+    nb = 0 ;
+    nc = 0 ;
+    nd = 0 ;
+    for (k = lo ; k < hi ; k++)
+    {
+        j = Nodes [k] ;
+        infw = (Fw [j] == fstamp) ;
+        inbw = (Bw [j] == bstamp) ;
+        if (infw && inbw) nc++ ;
+        else if (infw) na++ ;
+        else if (inbw) nd++ ;
+        else nb++ ;
+    }
+    pa = lo ;
+    pb = pa + na ;
+    pc = pb + nb ;
+    pd = pc + nc ;
+    for (k = lo ; k < hi ; k++)
+    {
+        j = Nodes [k] ;
+        infw = (Fw [j] == fstamp) ;
+        inbw = (Bw [j] == bstamp) ;
+        if (infw && inbw)
+        {
+            Color [j] = DONE ;
+            Tmp [pc++] = j ;
+        }
+        else if (infw)
+        {
+            /* Color [j] is already lo */
+            Tmp [pa++] = j ;
+        }
+        else if (inbw)
+        {
+            Color [j] = lo + na + nb + nc ;
+            Tmp [pd++] = j ;
+        }
+        else
+        {
+            Color [j] = lo + na ;
+            Tmp [pb++] = j ;
+        }
+    }
+    for (k = lo ; k < hi ; k++)
+    {
+        Nodes [k] = Tmp [k] ;
+    }
+    W->Block [lo + na + nb] = 1 ;
+
+    Sub_start [0] = lo ;                Sub_len [0] = na ;
+    Sub_start [1] = lo + na ;           Sub_len [1] = nb ;
+    Sub_start [2] = lo + na + nb + nc ; Sub_len [2] = nd ;
+}
+
+/* ========================================================================== */
+/* === tarjan =============================================================== */
+/* ========================================================================== */
+
+/* Find the strongly connected components of a set with Tarjan's method (the
+ * same as the non-recursive dfs in btf_strongcomp.c, except that edges that
+ * leave the set are ignored), and place them in the order they are found, with
+ * each component in ascending order. */
+
+static void tarjan
+(
+    scc_info *W,
+    Int start,          /* the set is Nodes [start ... start+len-1] */
+    Int len
+)
+{
+    Int *Ap = W->Ap, *Ai = W->Ai, *Color = W->Color, *Nodes = W->Nodes,
+        *Time = W->Fw, *Low = W->Bw, *Flag = W->Indeg,
+        *Cstack = W->Queue + start, *Jstack = W->Next + start,
+        *Pstack = W->Tmp + start, *Cnt = W->Next + start, *Tmp = W->Tmp ;
+    Int label = start, k, j, jj, i, p, pend, parent, chead, jhead, timestamp,
+        nblocks, b, s ;
+
+    /* ---------------------------------------------------------------------- */
+    /* find the components */
+    /* ---------------------------------------------------------------------- */
+
+    for (k = start ; k < start + len ; k++)
+    {
+        Flag [Nodes [k]] = UNVISITED ;
+    }
+    timestamp = 0 ;
+    nblocks = 0 ;
+
+    for (k = start ; k < start + len ; k++)
+    {
+        if (Flag [Nodes [k]] != UNVISITED) continue ;
+
+        chead = -1 ;
+        jhead = 0 ;
+        Jstack [0] = Nodes [k] ;
+
+        while (jhead >= 0)
+        {
+            j = Jstack [jhead] ;
+            jj = COL (W, j) ;
+            pend = Ap [jj+1] ;
+
+            if (Flag [j] == UNVISITED)
+            {
+                /* prework at node j */
+                Cstack [++chead] = j ;
+                timestamp++ ;
+                Time [j] = timestamp ;
+                Low [j] = timestamp ;
+                Flag [j] = UNASSIGNED ;
+                Pstack [jhead] = Ap [jj] ;
+            }
+
+            for (p = Pstack [jhead] ; p < pend ; p++)
+            {
+                i = Ai [p] ;
+                if (Color [i] != label) continue ;
+                if (Flag [i] == UNVISITED)
+                {
+                    Pstack [jhead] = p + 1 ;
+                    Jstack [++jhead] = i ;
+                    break ;
+                }
+                else if (Flag [i] == UNASSIGNED)
+                {
+                    Low [j] = MIN (Low [j], Time [i]) ;
+                }
+            }
+
+            if (p == pend)
+            {
+                /* postwork at node j */
+                jhead-- ;
+                if (Low [j] == Time [j])
+                {
+                    /* pop all nodes in this component from Cstack */
+                    do
+                    {
+                        i = Cstack [chead--] ;
+                        Flag [i] = nblocks ;
+                    }
+                    while (i != j) ;
+                    nblocks++ ;
+                }
+                if (jhead >= 0)
+                {
+                    parent = Jstack [jhead] ;
+                    Low [parent] = MIN (Low [parent], Low [j]) ;
+                }
+            }
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* place the components, preserving the natural order in each one */
+    /* ---------------------------------------------------------------------- */
+
+    for (b = 0 ; b < nblocks ; b++)
+    {
+        Cnt [b] = 0 ;
+    }
+    for (k = start ; k < start + len ; k++)
+    {
+        Cnt [Flag [Nodes [k]]]++ ;
+    }
+    s = start ;
+    for (b = 0 ; b < nblocks ; b++)
+    {
+        W->Block [s] = 1 ;
+        k = Cnt [b] ;
+        Cnt [b] = s ;
+        s += k ;
+    }
+    for (k = start ; k < start + len ; k++)
+    {
+        j = Nodes [k] ;
+        Tmp [Cnt [Flag [j]]++] = j ;
+        Color [j] = DONE ;
+    }
+    for (k = start ; k < start + len ; k++)
+    {
+        Nodes [k] = Tmp [k] ;
+    }
+}
+
+/* ========================================================================== */
+/* === scc_task ============================================================= */
+/* ========================================================================== */
+
+/* Find the components of a set, using one thread, and creating a new task for
+ * each subset but the largest one. */
+
+static void scc_task
+(
+    scc_info *W,
+    Int start,
+    Int len
+)
+{
+    Int Sub_start [3], Sub_len [3], s, big, s_start, s_len ;
+
+    while (len > 0)
+    {
+        if (len <= W->cutoff)
+        {
+            tarjan (W, start, len) ;
+            return ;
+        }
+        split (W, start, len, 1, Sub_start, Sub_len) ;
+        big = 0 ;
+        for (s = 1 ; s < 3 ; s++)
+        {
+            if (Sub_len [s] > Sub_len [big]) big = s ;
+        }
+        for (s = 0 ; s < 3 ; s++)
+        {
+            if (s == big || Sub_len [s] == 0) continue ;
+            s_start = Sub_start [s] ;
+            s_len = Sub_len [s] ;
+#pragma omp task firstprivate (s_start, s_len)
+            scc_task (W, s_start, s_len) ;
+        }
+        start = Sub_start [big] ;
+        len = Sub_len [big] ;
+    }
+}
+
+/* ========================================================================== */
+/* === BTF_PSTRONGCOMP ====================================================== */
+/* ========================================================================== */
+
+Int BTF(pstrongcomp)    /* return # of strongly connected components, or -1 if
+                         * out of memory */
+(
+    /* input, not modified: */
+    Int n,          /* A is n-by-n in compressed column form */
+    Int Ap [ ],     /* size n+1 */
+    Int Ai [ ],     /* size nz = Ap [n] */
+
+    /* optional input, modified (if present) on output: */
+    Int Q [ ],      /* size n, input column permutation (as BTF_STRONGCOMP) */
+
+    /* output, not defined on input: */
+    Int P [ ],      /* size n.  P [k] = j if row and column j are kth row/col
+                     * in permuted matrix. */
+    Int R [ ],      /* size n+1.  kth block is in rows/cols R[k] ... R[k+1]-1
+                     * of the permuted matrix. */
+
+    /* input: */
+    Int nthreads    /* number of threads to use */
+)
+{
+    scc_info Winfo, *W = &Winfo ;
+    Int *Work, *Tp, *Ti, *Seg ;
+    Int j, jj, i, k, p, s, nz, nblocks, big, top_start, top_len, Sub_start [3],
+        Sub_len [3] ;
+    size_t wsize ;
+
+    /* ---------------------------------------------------------------------- */
+    /* use the sequential method if only one thread is available */
+    /* ---------------------------------------------------------------------- */
+
+#ifndef BTF_OPENMP
+    nthreads = 1 ;
+#endif
+
+    if (n <= 0)
+    {
+        R [0] = 0 ;
+        return (0) ;
+    }
+
+    if (nthreads <= 1)
+    {
+        Work = (Int *) SuiteSparse_malloc (4 * (size_t) n, sizeof (Int)) ;
+        if (Work == NULL)
+        {
+            return (EMPTY) ;
+        }
+        nblocks = BTF(strongcomp) (n, Ap, Ai, Q, P, R, Work) ;
+        SuiteSparse_free (Work) ;
+        return (nblocks) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* get workspace */
+    /* ---------------------------------------------------------------------- */
+
+    nz = Ap [n] ;
+    wsize = 10 * (size_t) n + 1 + (size_t) nz ;
+    Work = (Int *) SuiteSparse_malloc (wsize, sizeof (Int)) ;
+    if (Work == NULL)
+    {
+        return (EMPTY) ;
+    }
+
+    W->n = n ;
+    W->Ap = Ap ;
+    W->Ai = Ai ;
+    W->Q = Q ;
+    W->Color  = Work ;
+    W->Fw     = Work + n ;
+    W->Bw     = Work + 2*n ;
+    W->Indeg  = Work + 3*n ;
+    W->Outdeg = Work + 4*n ;
+    W->Tmp    = Work + 5*n ;
+    W->Queue  = Work + 6*n ;
+    W->Next   = Work + 7*n ;
+    Seg       = Work + 8*n ;
+    Tp        = Work + 9*n ;        /* size n+1 */
+    Ti        = Work + 10*n + 1 ;   /* size nz */
+    W->Tp = Tp ;
+    W->Ti = Ti ;
+    W->Nodes = P ;
+    W->Block = R ;
+    W->stamp = 0 ;
+    W->cutoff = MAX (n / 64, 1024) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* initialize, and construct the in-coming edges of each node */
+    /* ---------------------------------------------------------------------- */
+
+#pragma omp parallel for num_threads(nthreads) schedule(static)
+    for (k = 0 ; k < n ; k++)
+    {
+        P [k] = k ;
+        R [k] = 0 ;
+        Seg [k] = 0 ;
+        W->Color [k] = 0 ;
+        W->Fw [k] = 0 ;
+        W->Bw [k] = 0 ;
+        Tp [k] = 0 ;
+    }
+    Tp [n] = 0 ;
+
+    /* count the in-coming edges of each node, in Tp [1..n] */
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic,1024) \
+    private (jj, p, i)
+    for (j = 0 ; j < n ; j++)
+    {
+        jj = COL (W, j) ;
+        for (p = Ap [jj] ; p < Ap [jj+1] ; p++)
+        {
+            i = Ai [p] ;
+            if (i != j)
+            {
+#pragma omp atomic
+                Tp [i+1]++ ;
+            }
+        }
+    }
+    for (i = 0 ; i < n ; i++)
+    {
+        Tp [i+1] += Tp [i] ;
+        W->Tmp [i] = Tp [i] ;
+    }
+
+    /* the order of each list depends on the threads, but nothing else does */
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic,1024) \
+    private (jj, p, i, k)
+    for (j = 0 ; j < n ; j++)
+    {
+        jj = COL (W, j) ;
+        for (p = Ap [jj] ; p < Ap [jj+1] ; p++)
+        {
+            i = Ai [p] ;
+            if (i != j)
+            {
+#pragma omp atomic capture
+                k = (W->Tmp [i])++ ;
+                Ti [k] = j ;
+            }
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* split the largest set with parallel loops */
+    /* ---------------------------------------------------------------------- */
+
+    /* Seg [start] = len for each set left for the tasks */
+    top_start = 0 ;
+    top_len = n ;
+    while (top_len > W->cutoff)
+    {
+        split (W, top_start, top_len, nthreads, Sub_start, Sub_len) ;
+        big = 0 ;
+        for (s = 1 ; s < 3 ; s++)
+        {
+            if (Sub_len [s] > Sub_len [big]) big = s ;
+        }
+        for (s = 0 ; s < 3 ; s++)
+        {
+            if (s != big && Sub_len [s] > 0)
+            {
+                Seg [Sub_start [s]] = Sub_len [s] ;
+            }
+        }
+        top_start = Sub_start [big] ;
+        top_len = Sub_len [big] ;
+    }
+    if (top_len > 0)
+    {
+        Seg [top_start] = top_len ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* split the remaining sets in parallel tasks */
+    /* ---------------------------------------------------------------------- */
+
+#pragma omp parallel num_threads(nthreads)
+    {
+#pragma omp single
+        {
+            for (k = 0 ; k < n ; k++)
+            {
+                if (Seg [k] > 0)
+                {
+#pragma omp task firstprivate (k)
+                    scc_task (W, k, Seg [k]) ;
+                }
+            }
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* construct the block boundary array, R */
+    /* ---------------------------------------------------------------------- */
+
+    /* R [k] = 1 if block starts at k; compact it in place */
+    nblocks = 0 ;
+    for (k = 0 ; k < n ; k++)
+    {
+        ASSERT (W->Color [P [k]] == DONE) ;
+        if (R [k])
+        {
+            R [nblocks++] = k ;
+        }
+    }
+    R [nblocks] = n ;
+
+    /* ---------------------------------------------------------------------- */
+    /* if Q is present on input, set Q = Q*P' */
+    /* ---------------------------------------------------------------------- */
+
+    if (Q != (Int *) NULL)
+    {
+        for (k = 0 ; k < n ; k++)
+        {
+            W->Tmp [k] = Q [P [k]] ;
+        }
+        for (k = 0 ; k < n ; k++)
+        {
+            Q [k] = W->Tmp [k] ;
+        }
+    }
+
+    SuiteSparse_free (Work) ;
+    return (nblocks) ;
+}
@@ -0,0 +1,2 @@
+#define DLONG
+#include <../Source/btf_pstrongcomp.c>
@@ -0,0 +1 @@
+#include <../Source/btf_pmaxtrans.c>
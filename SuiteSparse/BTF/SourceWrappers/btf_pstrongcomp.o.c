@@ -0,0 +1 @@
+#include <../Source/btf_pstrongcomp.c>
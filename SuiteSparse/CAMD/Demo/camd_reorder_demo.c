@@ -0,0 +1,197 @@
+/* ------------------------------------------------------------------------- */
+/* CAMD, Copyright (c) Timothy A. Davis, Yanqing Chen,			     */
+/* Patrick R. Amestoy, and Iain S. Duff.  See ../README.txt for License.     */
+/* email: DrTimothyAldenDavis@gmail.com                                      */
+/* ------------------------------------------------------------------------- */
+
+/* Demo of camd_reorder.  A 10-by-10 mesh is ordered with camd_order, with the
+ * nodes in the last column of the mesh constrained to come last.  The
+ * ordering is then updated with camd_reorder after the constraint sets change,
+ * after a few edges are added to the mesh, after too many nodes change, and
+ * with an invalid prior ordering.  Each result is checked. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "camd.h"
+
+#define GRID 10
+#define N (GRID*GRID)
+#define MAXNZ (5*N + 8)
+
+static int Ap [N+1], Ai [MAXNZ], C [N], C2 [N], Pold [N], P [N], Pinv [N],
+    Region [N] ;
+
+/* ------------------------------------------------------------------------- */
+/* create the mesh, with the extra edges (i,j) in E [0..2*ne-1] */
+/* ------------------------------------------------------------------------- */
+
+static int has_edge (int i, int j, int ne, const int E [ ])
+{
+    int k, x = i % GRID, y = i / GRID, x2 = j % GRID, y2 = j / GRID ;
+    if (i == j) return (1) ;
+    if ((x == x2 && abs (y - y2) == 1) || (y == y2 && abs (x - x2) == 1))
+    {
+	return (1) ;
+    }
+    for (k = 0 ; k < ne ; k++)
+    {
+	if ((E [2*k] == i && E [2*k+1] == j) || (E [2*k] == j && E [2*k+1] == i))
+	{
+	    return (1) ;
+	}
+    }
+    return (0) ;
+}
+
+static void mesh (int ne, const int E [ ])
+{
+    int i, j, nz = 0 ;
+    for (j = 0 ; j < N ; j++)
+    {
+	Ap [j] = nz ;
+	for (i = 0 ; i < N ; i++)
+	{
+	    if (has_edge (i, j, ne, E)) Ai [nz++] = i ;
+	}
+    }
+    Ap [N] = nz ;
+}
+
+/* ------------------------------------------------------------------------- */
+/* check that P is a permutation that respects the constraint sets */
+/* ------------------------------------------------------------------------- */
+
+static int check (const int *Perm, const int *Cset)
+{
+    int k ;
+    for (k = 0 ; k < N ; k++) Pinv [k] = -1 ;
+    for (k = 0 ; k < N ; k++)
+    {
+	if (Perm [k] < 0 || Perm [k] >= N || Pinv [Perm [k]] != -1) return (0) ;
+	Pinv [Perm [k]] = k ;
+	if (k > 0 && Cset [Perm [k-1]] > Cset [Perm [k]]) return (0) ;
+    }
+    return (1) ;
+}
+
+int main (void)
+{
+    double Control [CAMD_CONTROL], Info [CAMD_INFO] ;
+    int E [4], Changed [N], i, j, k, p, ok, result, nr ;
+
+    printf ("CAMD reorder demo, %d-by-%d mesh\n", GRID, GRID) ;
+    camd_defaults (Control) ;
+
+    /* --------------------------------------------------------------------- */
+    /* order the mesh, with the last column of the mesh constrained last */
+    /* --------------------------------------------------------------------- */
+
+    mesh (0, E) ;
+    for (i = 0 ; i < N ; i++) C [i] = (i % GRID == GRID-1) ;
+    result = camd_order (N, Ap, Ai, Pold, Control, Info, C) ;
+    printf ("camd_order: result %d nnz %d valid %d lnz %g\n", result,
+	Ap [N], check (Pold, C), Info [CAMD_LNZ]) ;
+
+    /* --------------------------------------------------------------------- */
+    /* only the constraint sets change: the last row of the mesh goes last */
+    /* --------------------------------------------------------------------- */
+
+    for (i = 0 ; i < N ; i++) C2 [i] = (i / GRID == GRID-1) ;
+    result = camd_reorder (N, Ap, Ai, P, Control, Info, C2, Pold, 0, NULL) ;
+    ok = check (P, C2) ;
+    /* within each set, the nodes must keep their relative order in Pold */
+    for (k = 0 ; k < N ; k++) Region [Pold [k]] = k ;
+    for (k = 1 ; k < N ; k++)
+    {
+	if (C2 [P [k-1]] == C2 [P [k]] && Region [P [k-1]] > Region [P [k]])
+	{
+	    ok = 0 ;
+	}
+    }
+    printf ("new sets:      result %d nreordered %g valid %d\n", result,
+	Info [CAMD_NREORDERED], ok) ;
+
+    /* --------------------------------------------------------------------- */
+    /* add two edges near a corner of the mesh */
+    /* --------------------------------------------------------------------- */
+
+    E [0] = 0 ; E [1] = GRID + 1 ;	    /* (0,0) to (1,1) */
+    E [2] = 1 ; E [3] = GRID ;		    /* (1,0) to (0,1) */
+    mesh (2, E) ;
+    Changed [0] = 0 ;
+    Changed [1] = 1 ;
+    Changed [2] = GRID ;
+    Changed [3] = GRID + 1 ;
+    result = camd_reorder (N, Ap, Ai, P, Control, Info, C, Pold, 4, Changed) ;
+    ok = check (P, C) ;
+    /* nodes outside the changed nodes and their neighbors do not move */
+    for (i = 0 ; i < N ; i++) Region [i] = 0 ;
+    nr = 0 ;
+    for (k = 0 ; k < 4 ; k++)
+    {
+	j = Changed [k] ;
+	for (p = Ap [j] ; p < Ap [j+1] ; p++)
+	{
+	    if (!Region [Ai [p]]) nr++ ;
+	    Region [Ai [p]] = 1 ;
+	}
+    }
+    for (k = 0 ; k < N ; k++)
+    {
+	if (!Region [Pold [k]] && P [k] != Pold [k]) ok = 0 ;
+    }
+    printf ("new edges:     result %d nreordered %g valid %d (region %d)\n",
+	result, Info [CAMD_NREORDERED], ok, nr) ;
+
+    /* the same update, with P and Pold the same array */
+    for (k = 0 ; k < N ; k++) P [k] = Pold [k] ;
+    result = camd_reorder (N, Ap, Ai, P, Control, Info, C, P, 4, Changed) ;
+    printf ("in place:      result %d nreordered %g valid %d\n", result,
+	Info [CAMD_NREORDERED], check (P, C)) ;
+
+    /* --------------------------------------------------------------------- */
+    /* too many changed nodes: the whole mesh is ordered again */
+    /* --------------------------------------------------------------------- */
+
+    for (k = 0 ; k < N/2 ; k++) Changed [k] = k ;
+    result = camd_reorder (N, Ap, Ai, P, Control, Info, C, Pold, N/2,
+	Changed) ;
+    printf ("many changes:  result %d nreordered %g valid %d\n", result,
+	Info [CAMD_NREORDERED], check (P, C)) ;
+
+    /* a larger limit allows the same update to be done locally */
+    Control [CAMD_REORDER_LIMIT] = 1 ;
+    result = camd_reorder (N, Ap, Ai, P, Control, Info, C, Pold, N/2,
+	Changed) ;
+    printf ("limit 1:       result %d nreordered %g valid %d\n", result,
+	Info [CAMD_NREORDERED], check (P, C)) ;
+    Control [CAMD_REORDER_LIMIT] = CAMD_DEFAULT_REORDER_LIMIT ;
+
+    /* --------------------------------------------------------------------- */
+    /* no prior ordering, or an invalid one */
+    /* --------------------------------------------------------------------- */
+
+    result = camd_reorder (N, Ap, Ai, P, Control, Info, C, NULL, 1, Changed) ;
+    printf ("no Pold:       result %d nreordered %g valid %d\n", result,
+	Info [CAMD_NREORDERED], check (P, C)) ;
+
+    for (k = 0 ; k < N ; k++) Region [k] = Pold [k] ;
+    Region [1] = Region [0] ;
+    result = camd_reorder (N, Ap, Ai, P, Control, Info, C, Region, 1, Changed);
+    printf ("invalid Pold:  result %d nreordered %g valid %d\n", result,
+	Info [CAMD_NREORDERED], check (P, C)) ;
+
+    /* --------------------------------------------------------------------- */
+    /* invalid list of changed nodes */
+    /* --------------------------------------------------------------------- */
+
+    Changed [0] = N ;
+    result = camd_reorder (N, Ap, Ai, P, Control, Info, C, Pold, 1, Changed) ;
+    printf ("bad Changed:   result %d status %g\n", result,
+	Info [CAMD_STATUS]) ;
+    result = camd_reorder (N, Ap, Ai, P, Control, Info, C, Pold, 1, NULL) ;
+    printf ("NULL Changed:  result %d status %g\n", result,
+	Info [CAMD_STATUS]) ;
+
+    return (0) ;
+}
@@ -143,7 +143,12 @@ SuiteSparse_long camd_l_order   /* see above for description of arguments */
  *          it can lead to a slightly worse ordering, however.  To turn it off,
  *          set Control [CAMD_AGGRESSIVE] to 0.
  *
- *      Control [2..4] are not used in the current version, but may be used in
+ *      Control [CAMD_REORDER_LIMIT]:  used by camd_reorder only.  The
+ *          changed part of the graph is re-ordered locally if it has at most
+ *          Control [CAMD_REORDER_LIMIT] * n nodes; otherwise the whole matrix
+ *          is ordered from scratch.  Default: 0.1.
+ *
+ *      Control [3..4] are not used in the current version, but may be used in
  *          future versions.
  *
  * The Info array provides statistics about the ordering on output.  If it is
@@ -208,10 +213,78 @@ SuiteSparse_long camd_l_order   /* see above for description of arguments */
  *      Info [CAMD_DMAX]:  the maximum number of nonzeros in any column of L,
  *          including the diagonal.
  *
- *      Info [14..19] are not used in the current version, but may be used in
+ *      Info [CAMD_NREORDERED]:  the number of nodes re-ordered by
+ *          camd_reorder.  Not computed by camd_order.
+ *
+ *      Info [15..19] are not used in the current version, but may be used in
  *          future versions.
  */    
 
+/* ------------------------------------------------------------------------- */
+/* camd_reorder:  update a prior ordering */
+/* ------------------------------------------------------------------------- */
+
+int camd_reorder            /* returns CAMD_OK, CAMD_OK_BUT_JUMBLED,
+                             * CAMD_INVALID, or CAMD_OUT_OF_MEMORY */
+(
+    int n,                  /* A is n-by-n.  n must be >= 0. */
+    const int Ap [ ],       /* column pointers for A, of size n+1 */
+    const int Ai [ ],       /* row indices of A, of size nz = Ap [n] */
+    int P [ ],              /* output permutation, of size n */
+    double Control [ ],     /* input Control settings, of size CAMD_CONTROL */
+    double Info [ ],        /* output Info statistics, of size CAMD_INFO */
+    const int C [ ],        /* Constraint set of A, of size n; can be NULL */
+    const int Pold [ ],     /* prior ordering of A, of size n; can be NULL */
+    int nchanged,           /* number of nodes whose pattern has changed */
+    const int Changed [ ]   /* list of changed nodes, of size nchanged */
+) ;
+
+SuiteSparse_long camd_l_reorder /* see above for description of arguments */
+(
+    SuiteSparse_long n,
+    const SuiteSparse_long Ap [ ],
+    const SuiteSparse_long Ai [ ],
+    SuiteSparse_long P [ ],
+    double Control [ ],
+    double Info [ ],
+    const SuiteSparse_long C [ ],
+    const SuiteSparse_long Pold [ ],
+    SuiteSparse_long nchanged,
+    const SuiteSparse_long Changed [ ]
+) ;
+
+/* camd_reorder updates a prior ordering Pold of A after the constraint sets
+ * C have changed, or after the pattern of a few rows and columns of A have
+ * changed (with n unchanged), such as after a small local refinement of a
+ * mesh.  The matrix A and the arguments n, Ap, Ai, P, Control, Info, and C
+ * are the same as for camd_order.  P and Pold may be the same array.
+ *
+ * Pold is the ordering of the matrix before the change, as returned by a
+ * prior call to camd_order or camd_reorder.  Changed [0..nchanged-1] lists
+ * the nodes i for which row or column i of A has changed, since the prior
+ * ordering.  Nodes whose only change is in their constraint set C [i] need
+ * not be listed.
+ *
+ * If nchanged is zero, P is Pold stably sorted by the new constraint sets.
+ * Otherwise, the changed nodes and their neighbors in the graph of A+A' are
+ * re-ordered with camd_order, and placed in the positions they had in Pold,
+ * before P is sorted by C.  Both take O(n+nz) time, plus the time to order
+ * the changed region.  If the region has more than Control
+ * [CAMD_REORDER_LIMIT] * n nodes (default 0.1), or if Pold is NULL or not a
+ * permutation, camd_reorder simply calls camd_order.
+ *
+ * On output, Info [CAMD_NREORDERED] is the number of nodes that were
+ * re-ordered (n if camd_order was used).  The other entries of Info are the
+ * same as for camd_order, except that Info [CAMD_SYMMETRY] through
+ * Info [CAMD_DMAX] are only computed if camd_order was used (they are -1
+ * otherwise).
+ *
+ * The ordering returned by camd_reorder satisfies the constraints, but its
+ * fill-in can be somewhat higher than that of a fresh ordering from
+ * camd_order.  If many updates are done in a row, an occasional call to
+ * camd_order is recommended.
+ */
+
 /* ------------------------------------------------------------------------- */
 /* direct interface to CAMD */
 /* ------------------------------------------------------------------------- */
@@ -342,10 +415,12 @@ void camd_l_info     (double Info [ ]) ;
 /* contents of Control */
 #define CAMD_DENSE 0        /* "dense" if degree > Control [0] * sqrt (n) */
 #define CAMD_AGGRESSIVE 1    /* do aggressive absorption if Control [1] != 0 */
+#define CAMD_REORDER_LIMIT 2 /* camd_reorder: max. fraction to re-order */
 
 /* default Control settings */
 #define CAMD_DEFAULT_DENSE 10.0     /* default "dense" degree 10*sqrt(n) */
 #define CAMD_DEFAULT_AGGRESSIVE 1    /* do aggressive absorption by default */
+#define CAMD_DEFAULT_REORDER_LIMIT 0.1  /* re-order up to 10% of the nodes */
 
 /* contents of Info */
 #define CAMD_STATUS 0       /* return value of camd_order and camd_l_order */
@@ -362,6 +437,7 @@ void camd_l_info     (double Info [ ]) ;
 #define CAMD_NMULTSUBS_LDL 11 /* number of fl. point (*,-) pairs for LDL' */
 #define CAMD_NMULTSUBS_LU 12  /* number of fl. point (*,-) pairs for LU */
 #define CAMD_DMAX 13         /* max nz. in any column of L, incl. diagonal */
+#define CAMD_NREORDERED 14   /* number of nodes re-ordered by camd_reorder */
 
 /* ------------------------------------------------------------------------- */
 /* return values of CAMD */
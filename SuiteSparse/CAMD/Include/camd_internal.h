@@ -161,6 +161,7 @@
 #define Int_MAX SuiteSparse_long_max
 
 #define CAMD_order camd_l_order
+#define CAMD_reorder camd_l_reorder
 #define CAMD_defaults camd_l_defaults
 #define CAMD_control camd_l_control
 #define CAMD_info camd_l_info
@@ -183,6 +184,7 @@
 #define Int_MAX INT_MAX
 
 #define CAMD_order camd_order
+#define CAMD_reorder camd_reorder
 #define CAMD_defaults camd_defaults
 #define CAMD_control camd_control
 #define CAMD_info camd_info
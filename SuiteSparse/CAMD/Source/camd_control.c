@@ -20,18 +20,20 @@ GLOBAL void CAMD_control
     double Control [ ]
 )
 {
-    double alpha ;
+    double alpha, limit ;
     Int aggressive ;
 
     if (Control != (double *) NULL)
     {
 	alpha = Control [CAMD_DENSE] ;
 	aggressive = Control [CAMD_AGGRESSIVE] != 0 ;
+	limit = Control [CAMD_REORDER_LIMIT] ;
     }
     else
     {
 	alpha = CAMD_DEFAULT_DENSE ;
 	aggressive = CAMD_DEFAULT_AGGRESSIVE ;
+	limit = CAMD_DEFAULT_REORDER_LIMIT ;
     }
 
     SUITESPARSE_PRINTF ((
@@ -60,5 +62,8 @@ GLOBAL void CAMD_control
 	SUITESPARSE_PRINTF (("    aggressive absorption:  no\n")) ;
     }
 
+    SUITESPARSE_PRINTF (("    camd_reorder local re-ordering limit: %g\n",
+	limit)) ;
+
     SUITESPARSE_PRINTF (("    size of CAMD integer: %d\n\n", sizeof (Int))) ;
 }
@@ -32,5 +32,6 @@ GLOBAL void CAMD_defaults
 	}
 	Control [CAMD_DENSE] = CAMD_DEFAULT_DENSE ;
 	Control [CAMD_AGGRESSIVE] = CAMD_DEFAULT_AGGRESSIVE ;
+	Control [CAMD_REORDER_LIMIT] = CAMD_DEFAULT_REORDER_LIMIT ;
     }
 }
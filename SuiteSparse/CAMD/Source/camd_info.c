@@ -79,6 +79,8 @@ GLOBAL void CAMD_info
 	Info [CAMD_MEMORY]) ;
     PRI ("    # of memory compactions:                            %.20g\n",
 	Info [CAMD_NCMPA]) ;
+    PRI ("    # nodes re-ordered by camd_reorder:                 %.20g\n",
+	Info [CAMD_NREORDERED]) ;
 
     /* statistics about the ordering quality */
     SUITESPARSE_PRINTF (("\n"
@@ -0,0 +1,387 @@
+/* ========================================================================= */
+/* === CAMD_reorder ======================================================== */
+/* ========================================================================= */
+
+/* ------------------------------------------------------------------------- */
+/* CAMD, Copyright (c) Timothy A. Davis, Yanqing Chen,			     */
+/* Patrick R. Amestoy, and Iain S. Duff.  See ../README.txt for License.     */
+/* email: DrTimothyAldenDavis@gmail.com                                      */
+/* ------------------------------------------------------------------------- */
+
+/* User-callable.  Updates a prior CAMD ordering Pold of a matrix after its
+ * constraint sets, or the pattern of a few of its rows and columns, have
+ * changed.  See camd.h for documentation.
+ *
+ * The state of the quotient graph is not kept by CAMD_order, so the old
+ * elimination cannot be resumed.  Instead, the ordering is repaired:
+ *
+ * (1) If no node has changed (nchanged == 0), Pold is stably sorted by the
+ *	new constraint sets C.  Within each set, the nodes keep their relative
+ *	order in Pold.
+ *
+ * (2) If only a few nodes have changed, the region R of the graph of A+A'
+ *	consisting of the changed nodes and their neighbors is re-ordered with
+ *	CAMD_order, subject to C.  The nodes of R take the places they had in
+ *	Pold, in their new order, and the result is then stably sorted by C as
+ *	in (1).
+ *
+ * (3) Otherwise (R is larger than Control [CAMD_REORDER_LIMIT] * n, or Pold
+ *	is not a valid permutation), the matrix is ordered from scratch with
+ *	CAMD_order.
+ *
+ * Cases (1) and (2) take O (n + nz) time, plus the time to order the region
+ * R, which is small.  Info [CAMD_NREORDERED] gives the number of nodes that
+ * were re-ordered: zero for (1), the size of R for (2), and n for (3).  The
+ * fill-in statistics (Info [CAMD_LNZ] and so on) are only computed for (3).
+ */
+
+#include "camd_internal.h"
+
+/* ========================================================================= */
+/* === camd_sort_by_set ==================================================== */
+/* ========================================================================= */
+
+/* Stable counting sort of the permutation P by the constraint sets C. */
+
+static void camd_sort_by_set
+(
+    Int n,
+    Int P [ ],		/* size n, sorted on output */
+    const Int C [ ],	/* size n, constraint sets in the range 0 to n-1 */
+    Int Head [ ],	/* workspace of size n+1 */
+    Int W [ ]		/* workspace of size n */
+)
+{
+    Int c, k, s, t ;
+    for (c = 0 ; c <= n ; c++)
+    {
+	Head [c] = 0 ;
+    }
+    for (k = 0 ; k < n ; k++)
+    {
+	Head [C [P [k]]]++ ;
+    }
+    s = 0 ;
+    for (c = 0 ; c < n ; c++)
+    {
+	t = Head [c] ;
+	Head [c] = s ;
+	s += t ;
+    }
+    for (k = 0 ; k < n ; k++)
+    {
+	W [Head [C [P [k]]]++] = P [k] ;
+    }
+    for (k = 0 ; k < n ; k++)
+    {
+	P [k] = W [k] ;
+    }
+}
+
+/* ========================================================================= */
+/* === CAMD_reorder ======================================================== */
+/* ========================================================================= */
+
+GLOBAL Int CAMD_reorder
+(
+    Int n,
+    const Int Ap [ ],
+    const Int Ai [ ],
+    Int P [ ],
+    double Control [ ],
+    double Info [ ],
+    const Int C [ ],
+    const Int Pold [ ],
+    Int nchanged,
+    const Int Changed [ ]
+)
+{
+    Int *Work, *Mark, *Wk, *Head, *Sp, *Si, *Sc, *Sperm, *Rlist, i, j, k, p,
+	c, nr, nzr, status, result, info, ok ;
+    double limit ;
+
+#ifndef NDEBUG
+    CAMD_debug_init ("camd_reorder") ;
+#endif
+
+    /* clear the Info array, if it exists */
+    info = Info != (double *) NULL ;
+    if (info)
+    {
+	for (i = 0 ; i < CAMD_INFO ; i++)
+	{
+	    Info [i] = EMPTY ;
+	}
+	Info [CAMD_N] = n ;
+	Info [CAMD_STATUS] = CAMD_OK ;
+    }
+
+    /* make sure inputs exist and n is >= 0 */
+    if (Ai == (Int *) NULL || Ap == (Int *) NULL || P == (Int *) NULL || n < 0
+	|| nchanged < 0 || (nchanged > 0 && Changed == (Int *) NULL))
+    {
+	if (info) Info [CAMD_STATUS] = CAMD_INVALID ;
+	return (CAMD_INVALID) ;	    /* arguments are invalid */
+    }
+
+    if (n == 0)
+    {
+	if (info) Info [CAMD_NREORDERED] = 0 ;
+	return (CAMD_OK) ;	    /* n is 0 so there's nothing to do */
+    }
+
+    if (info)
+    {
+	Info [CAMD_NZ] = Ap [n] ;
+    }
+    if (Ap [n] < 0 || !CAMD_cvalid (n, C))
+    {
+	if (info) Info [CAMD_STATUS] = CAMD_INVALID ;
+	return (CAMD_INVALID) ;
+    }
+    for (k = 0 ; k < nchanged ; k++)
+    {
+	if (Changed [k] < 0 || Changed [k] >= n)
+	{
+	    if (info) Info [CAMD_STATUS] = CAMD_INVALID ;
+	    return (CAMD_INVALID) ;
+	}
+    }
+
+    /* check the input matrix:	CAMD_OK, CAMD_INVALID, or CAMD_OK_BUT_JUMBLED */
+    status = CAMD_valid (n, n, Ap, Ai) ;
+    if (status == CAMD_INVALID)
+    {
+	if (info) Info [CAMD_STATUS] = CAMD_INVALID ;
+	return (CAMD_INVALID) ;	    /* matrix is invalid */
+    }
+
+    limit = (Control != (double *) NULL) ?
+	Control [CAMD_REORDER_LIMIT] : CAMD_DEFAULT_REORDER_LIMIT ;
+
+    /* --------------------------------------------------------------------- */
+    /* allocate workspace */
+    /* --------------------------------------------------------------------- */
+
+    Work = (Pold == (Int *) NULL) ? NULL :
+	SuiteSparse_malloc (3*n + 1, sizeof (Int)) ;
+    if (Work == (Int *) NULL)
+    {
+	/* no prior ordering, or out of memory: order from scratch */
+	result = CAMD_order (n, Ap, Ai, P, Control, Info, C) ;
+	if (info && result >= CAMD_OK) Info [CAMD_NREORDERED] = n ;
+	return (result) ;
+    }
+    Mark = Work ;	    /* size n */
+    Wk   = Work + n ;	    /* size n */
+    Head = Work + 2*n ;	    /* size n+1 */
+
+    /* --------------------------------------------------------------------- */
+    /* check Pold, and make a copy of it in Wk (P and Pold may be aliased) */
+    /* --------------------------------------------------------------------- */
+
+    ok = TRUE ;
+    for (i = 0 ; i < n ; i++)
+    {
+	Mark [i] = EMPTY ;
+    }
+    for (k = 0 ; ok && k < n ; k++)
+    {
+	i = Pold [k] ;
+	ok = (i >= 0 && i < n && Mark [i] == EMPTY) ;
+	if (ok)
+	{
+	    Mark [i] = k ;
+	    Wk [k] = i ;
+	}
+    }
+
+    /* --------------------------------------------------------------------- */
+    /* find the region R: the changed nodes and their neighbors in A+A' */
+    /* --------------------------------------------------------------------- */
+
+    nr = 0 ;
+    if (ok && nchanged > 0)
+    {
+	/* Mark [i] = 1 if i changed, 2 if i is a neighbor, 0 otherwise */
+	for (i = 0 ; i < n ; i++)
+	{
+	    Mark [i] = 0 ;
+	}
+	for (k = 0 ; k < nchanged ; k++)
+	{
+	    Mark [Changed [k]] = 1 ;
+	}
+	for (j = 0 ; j < n ; j++)
+	{
+	    for (p = Ap [j] ; p < Ap [j+1] ; p++)
+	    {
+		i = Ai [p] ;
+		if (Mark [j] == 1 && Mark [i] == 0)
+		{
+		    Mark [i] = 2 ;	/* A (i,j) with j changed */
+		}
+		else if (Mark [i] == 1 && Mark [j] == 0)
+		{
+		    Mark [j] = 2 ;	/* A (i,j) with i changed */
+		}
+	    }
+	}
+	for (i = 0 ; i < n ; i++)
+	{
+	    if (Mark [i] != 0) nr++ ;
+	}
+	ok = (nr <= limit * n) ;
+    }
+    CAMD_DEBUG1 (("camd_reorder: nchanged "ID" region "ID" ok "ID"\n",
+	nchanged, nr, ok)) ;
+
+    if (!ok)
+    {
+	/* too many changes, or Pold is invalid: order from scratch */
+	SuiteSparse_free (Work) ;
+	result = CAMD_order (n, Ap, Ai, P, Control, Info, C) ;
+	if (info && result >= CAMD_OK) Info [CAMD_NREORDERED] = n ;
+	return (result) ;
+    }
+
+    /* --------------------------------------------------------------------- */
+    /* re-order the region R */
+    /* --------------------------------------------------------------------- */
+
+    if (nr > 0)
+    {
+	/* Mark [i] becomes the index of i in R, in the order of Pold */
+	Rlist = Head ;
+	nr = 0 ;
+	for (k = 0 ; k < n ; k++)
+	{
+	    i = Wk [k] ;
+	    if (Mark [i] != 0)
+	    {
+		Rlist [nr] = i ;
+		Mark [i] = nr++ ;
+	    }
+	    else
+	    {
+		Mark [i] = EMPTY ;
+	    }
+	}
+
+	/* count the entries in A (R,R) */
+	nzr = 0 ;
+	for (k = 0 ; k < nr ; k++)
+	{
+	    j = Rlist [k] ;
+	    for (p = Ap [j] ; p < Ap [j+1] ; p++)
+	    {
+		if (Mark [Ai [p]] != EMPTY) nzr++ ;
+	    }
+	}
+
+	Sp    = SuiteSparse_malloc (nr+1, sizeof (Int)) ;
+	Si    = SuiteSparse_malloc (MAX (nzr,1), sizeof (Int)) ;
+	Sperm = SuiteSparse_malloc (nr, sizeof (Int)) ;
+	Sc    = (C == (Int *) NULL) ? NULL : SuiteSparse_malloc (nr, sizeof (Int));
+	if (!Sp || !Si || !Sperm || (C != (Int *) NULL && !Sc))
+	{
+	    /* :: out of memory :: */
+	    SuiteSparse_free (Sp) ;
+	    SuiteSparse_free (Si) ;
+	    SuiteSparse_free (Sperm) ;
+	    SuiteSparse_free (Sc) ;
+	    SuiteSparse_free (Work) ;
+	    if (info) Info [CAMD_STATUS] = CAMD_OUT_OF_MEMORY ;
+	    return (CAMD_OUT_OF_MEMORY) ;
+	}
+
+	/* construct S = A (R,R), with the rows and columns of R in the
+	 * order of Pold.  S is jumbled if A is. */
+	nzr = 0 ;
+	for (k = 0 ; k < nr ; k++)
+	{
+	    Sp [k] = nzr ;
+	    j = Rlist [k] ;
+	    for (p = Ap [j] ; p < Ap [j+1] ; p++)
+	    {
+		i = Mark [Ai [p]] ;
+		if (i != EMPTY) Si [nzr++] = i ;
+	    }
+	}
+	Sp [nr] = nzr ;
+
+	/* renumber the constraint sets of R to the range 0 to nr-1, keeping
+	 * their relative order */
+	if (Sc != (Int *) NULL)
+	{
+	    for (c = 0 ; c < n ; c++)
+	    {
+		Wk [c] = EMPTY ;
+	    }
+	    for (k = 0 ; k < nr ; k++)
+	    {
+		Wk [C [Rlist [k]]] = 0 ;
+	    }
+	    c = 0 ;
+	    for (i = 0 ; i < n ; i++)
+	    {
+		if (Wk [i] != EMPTY) Wk [i] = c++ ;
+	    }
+	    for (k = 0 ; k < nr ; k++)
+	    {
+		Sc [k] = Wk [C [Rlist [k]]] ;
+	    }
+	}
+
+	result = CAMD_order (nr, Sp, Si, Sperm, Control, (double *) NULL, Sc) ;
+
+	SuiteSparse_free (Sp) ;
+	SuiteSparse_free (Si) ;
+	SuiteSparse_free (Sc) ;
+	if (result < CAMD_OK)
+	{
+	    SuiteSparse_free (Sperm) ;
+	    SuiteSparse_free (Work) ;
+	    if (info) Info [CAMD_STATUS] = result ;
+	    return (result) ;
+	}
+
+	/* the nodes of R take the places they had in Pold, in their new
+	 * order.  Wk was overwritten, so get Pold back from Rlist and Mark. */
+	for (k = 0 ; k < nr ; k++)
+	{
+	    Sperm [k] = Rlist [Sperm [k]] ;
+	}
+	nr = 0 ;
+	for (k = 0 ; k < n ; k++)
+	{
+	    i = Pold [k] ;
+	    P [k] = (Mark [i] == EMPTY) ? i : Sperm [nr++] ;
+	}
+	SuiteSparse_free (Sperm) ;
+    }
+    else
+    {
+	for (k = 0 ; k < n ; k++)
+	{
+	    P [k] = Wk [k] ;
+	}
+    }
+
+    /* --------------------------------------------------------------------- */
+    /* sort the ordering by the new constraint sets */
+    /* --------------------------------------------------------------------- */
+
+    if (C != (Int *) NULL)
+    {
+	camd_sort_by_set (n, P, C, Head, Wk) ;
+    }
+
+    SuiteSparse_free (Work) ;
+    if (info)
+    {
+	Info [CAMD_STATUS] = status ;
+	Info [CAMD_NREORDERED] = nr ;
+    }
+    return (status) ;
+}
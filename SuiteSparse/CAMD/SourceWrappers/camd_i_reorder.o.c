@@ -0,0 +1,2 @@
+#define DINT
+#include <../Source/camd_reorder.c>
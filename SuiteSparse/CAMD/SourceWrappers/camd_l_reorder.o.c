@@ -0,0 +1,2 @@
+#define DLONG
+#include <../Source/camd_reorder.c>
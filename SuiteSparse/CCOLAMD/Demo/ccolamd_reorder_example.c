@@ -0,0 +1,196 @@
+/* ========================================================================== */
+/* === ccolamd_reorder example ============================================== */
+/* ========================================================================== */
+
+/* ----------------------------------------------------------------------------
+ * CCOLAMD Copyright (C), Univ. of Florida.  Authors: Timothy A. Davis,
+ * Sivasankaran Rajamanickam, and Stefan Larimore
+ * -------------------------------------------------------------------------- */
+
+/*
+ *  ccolamd_reorder example of use.  The columns of a 60-by-40 sparse matrix
+ *  are ordered with ccolamd, with the last 20 columns constrained to come
+ *  last.  The ordering is then updated with ccolamd_reorder after the
+ *  constraint sets change, after the pattern of one column changes, after
+ *  too many columns change, and with an invalid prior ordering.  Each result
+ *  is checked.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ccolamd.h"
+
+#define NROW 60
+#define NCOL 40
+#define MAXNZ (3*NROW + 8)
+#define ALEN 2000
+
+static int Ap [NCOL+1], Ai [MAXNZ], Awork [ALEN], cmember [NCOL],
+    cmember2 [NCOL], perm_old [NCOL+1], perm [NCOL+1], pinv [NCOL],
+    region [NROW] ;
+
+/* ------------------------------------------------------------------------- */
+/* create the matrix.  Row i has entries in columns i, 7i+3, and (for i < NCOL)
+ * i+1, modulo NCOL.  If extra >= 0, rows 0, 10, and 20 also have an entry in
+ * column extra. */
+/* ------------------------------------------------------------------------- */
+
+static int has_entry (int i, int j, int extra)
+{
+    return (j == i % NCOL || j == (7*i + 3) % NCOL
+	|| (i < NCOL && j == (i+1) % NCOL)
+	|| (j == extra && (i == 0 || i == 10 || i == 20))) ;
+}
+
+static void matrix (int extra)
+{
+    int i, j, nz = 0 ;
+    for (j = 0 ; j < NCOL ; j++)
+    {
+	Ap [j] = nz ;
+	for (i = 0 ; i < NROW ; i++)
+	{
+	    if (has_entry (i, j, extra)) Ai [nz++] = i ;
+	}
+    }
+    Ap [NCOL] = nz ;
+}
+
+/* ------------------------------------------------------------------------- */
+/* check that perm is a permutation that respects the constraint sets */
+/* ------------------------------------------------------------------------- */
+
+static int check (const int *p, const int *cset)
+{
+    int k ;
+    for (k = 0 ; k < NCOL ; k++) pinv [k] = -1 ;
+    for (k = 0 ; k < NCOL ; k++)
+    {
+	if (p [k] < 0 || p [k] >= NCOL || pinv [p [k]] != -1) return (0) ;
+	pinv [p [k]] = k ;
+	if (k > 0 && cset [p [k-1]] > cset [p [k]]) return (0) ;
+    }
+    return (1) ;
+}
+
+int main (void)
+{
+    int stats [CCOLAMD_STATS], changed [NCOL], bad [NCOL], i, j, k, pp, ok,
+	result, nr ;
+    double knobs [CCOLAMD_KNOBS] ;
+
+    printf ("ccolamd_reorder example, %d-by-%d matrix\n", NROW, NCOL) ;
+    ccolamd_set_defaults (knobs) ;
+
+    /* ====================================================================== */
+    /* order the matrix, with the last 20 columns constrained last */
+    /* ====================================================================== */
+
+    matrix (-1) ;
+    for (j = 0 ; j < NCOL ; j++) cmember [j] = (j >= NCOL/2) ;
+    for (pp = 0 ; pp < Ap [NCOL] ; pp++) Awork [pp] = Ai [pp] ;
+    for (j = 0 ; j <= NCOL ; j++) perm_old [j] = Ap [j] ;
+    result = ccolamd (NROW, NCOL, ALEN, Awork, perm_old, knobs, stats,
+	cmember) ;
+    printf ("ccolamd:       result %d nnz %d valid %d\n", result, Ap [NCOL],
+	check (perm_old, cmember)) ;
+
+    /* ====================================================================== */
+    /* only the constraint sets change: the odd columns go last */
+    /* ====================================================================== */
+
+    for (j = 0 ; j < NCOL ; j++) cmember2 [j] = j % 2 ;
+    result = ccolamd_reorder (NROW, NCOL, Ai, Ap, perm, knobs, stats,
+	&calloc, &free, cmember2, perm_old, 0, NULL) ;
+    ok = check (perm, cmember2) ;
+    /* within each set, the columns keep their relative order in perm_old */
+    for (k = 0 ; k < NCOL ; k++) bad [perm_old [k]] = k ;
+    for (k = 1 ; k < NCOL ; k++)
+    {
+	if (cmember2 [perm [k-1]] == cmember2 [perm [k]]
+	    && bad [perm [k-1]] > bad [perm [k]])
+	{
+	    ok = 0 ;
+	}
+    }
+    printf ("new sets:      result %d nreordered %d valid %d\n", result,
+	stats [CCOLAMD_NREORDERED], ok) ;
+
+    /* ====================================================================== */
+    /* the pattern of column 5 changes */
+    /* ====================================================================== */
+
+    matrix (5) ;
+    changed [0] = 5 ;
+    /* 15 columns share a row with column 5; allow up to half of them to be
+       re-ordered locally */
+    knobs [CCOLAMD_REORDER_LIMIT] = 0.5 ;
+    result = ccolamd_reorder (NROW, NCOL, Ai, Ap, perm, knobs, stats,
+	&calloc, &free, cmember, perm_old, 1, changed) ;
+    ok = check (perm, cmember) ;
+    /* the columns that do not share a row with column 5 do not move */
+    for (i = 0 ; i < NROW ; i++) region [i] = 0 ;
+    for (pp = Ap [5] ; pp < Ap [6] ; pp++) region [Ai [pp]] = 1 ;
+    nr = 0 ;
+    for (k = 0 ; k < NCOL ; k++)
+    {
+	j = perm_old [k] ;
+	bad [j] = 0 ;
+	for (pp = Ap [j] ; pp < Ap [j+1] ; pp++)
+	{
+	    if (region [Ai [pp]]) bad [j] = 1 ;
+	}
+	nr += bad [j] ;
+	if (!bad [j] && perm [k] != j) ok = 0 ;
+    }
+    printf ("new entries:   result %d nreordered %d valid %d (region %d)\n",
+	result, stats [CCOLAMD_NREORDERED], ok, nr) ;
+
+    /* the same update, with perm and perm_old the same array */
+    for (k = 0 ; k < NCOL ; k++) perm [k] = perm_old [k] ;
+    result = ccolamd_reorder (NROW, NCOL, Ai, Ap, perm, knobs, stats,
+	&calloc, &free, cmember, perm, 1, changed) ;
+    printf ("in place:      result %d nreordered %d valid %d\n", result,
+	stats [CCOLAMD_NREORDERED], check (perm, cmember)) ;
+
+    /* ====================================================================== */
+    /* too many changed columns: the whole matrix is ordered again */
+    /* ====================================================================== */
+
+    ccolamd_set_defaults (knobs) ;
+
+    for (k = 0 ; k < NCOL/2 ; k++) changed [k] = 2*k ;
+    result = ccolamd_reorder (NROW, NCOL, Ai, Ap, perm, knobs, stats,
+	&calloc, &free, cmember, perm_old, NCOL/2, changed) ;
+    printf ("many changes:  result %d nreordered %d valid %d\n", result,
+	stats [CCOLAMD_NREORDERED], check (perm, cmember)) ;
+
+    /* ====================================================================== */
+    /* no prior ordering, or an invalid one */
+    /* ====================================================================== */
+
+    result = ccolamd_reorder (NROW, NCOL, Ai, Ap, perm, knobs, stats,
+	&calloc, &free, cmember, NULL, 1, changed) ;
+    printf ("no perm_old:   result %d nreordered %d valid %d\n", result,
+	stats [CCOLAMD_NREORDERED], check (perm, cmember)) ;
+
+    for (k = 0 ; k < NCOL ; k++) bad [k] = perm_old [k] ;
+    bad [1] = bad [0] ;
+    result = ccolamd_reorder (NROW, NCOL, Ai, Ap, perm, knobs, stats,
+	&calloc, &free, cmember, bad, 1, changed) ;
+    printf ("bad perm_old:  result %d nreordered %d valid %d\n", result,
+	stats [CCOLAMD_NREORDERED], check (perm, cmember)) ;
+
+    /* ====================================================================== */
+    /* invalid list of changed columns */
+    /* ====================================================================== */
+
+    changed [0] = NCOL ;
+    result = ccolamd_reorder (NROW, NCOL, Ai, Ap, perm, knobs, stats,
+	&calloc, &free, cmember, perm_old, 1, changed) ;
+    printf ("bad changed:   result %d status %d info %d\n", result,
+	stats [CCOLAMD_STATUS], stats [CCOLAMD_INFO1]) ;
+    printf ("invalid_changed is %d\n", CCOLAMD_ERROR_invalid_changed) ;
+
+    return (0) ;
+}
@@ -53,10 +53,10 @@ extern "C" {
 /* === Knob and statistics definitions ====================================== */
 /* ========================================================================== */
 
-/* size of the knobs [ ] array.  Only knobs [0..3] are currently used. */
+/* size of the knobs [ ] array.  Only knobs [0..4] are currently used. */
 #define CCOLAMD_KNOBS 20
 
-/* number of output statistics.  Only stats [0..10] are currently used. */
+/* number of output statistics.  Only stats [0..11] are currently used. */
 #define CCOLAMD_STATS 20
 
 /* knobs [0] and stats [0]: dense row knob and output statistic. */
@@ -71,6 +71,9 @@ extern "C" {
 /* knobs [3]: LU or Cholesky factorization option */
 #define CCOLAMD_LU 3
 
+/* knobs [4]: ccolamd_reorder re-orders locally up to this fraction of n_col */
+#define CCOLAMD_REORDER_LIMIT 4
+
 /* stats [2]: memory defragmentation count output statistic */
 #define CCOLAMD_DEFRAG_COUNT 2
 
@@ -90,6 +93,8 @@ extern "C" {
 #define CCOLAMD_NEWLY_EMPTY_ROW 9
 /* stats [10]: number of cols with entries only in dense rows */
 #define CCOLAMD_NEWLY_EMPTY_COL 10
+/* stats [11]: number of columns re-ordered by ccolamd_reorder */
+#define CCOLAMD_NREORDERED 11
 
 /* error codes returned in stats [3]: */
 #define CCOLAMD_OK				(0)
@@ -105,6 +110,7 @@ extern "C" {
 #define CCOLAMD_ERROR_row_index_out_of_bounds	(-9)
 #define CCOLAMD_ERROR_out_of_memory		(-10)
 #define CCOLAMD_ERROR_invalid_cmember		(-11)
+#define CCOLAMD_ERROR_invalid_changed		(-12)
 #define CCOLAMD_ERROR_internal_error		(-999)
 
 /* ========================================================================== */
@@ -193,6 +199,43 @@ SuiteSparse_long csymamd_l      /* as csymamd, w/ SuiteSparse_long integers */
     SuiteSparse_long stype
 ) ;
 
+int ccolamd_reorder		/* return (1) if OK, (0) otherwise */
+(
+    int n_row,			/* number of rows in A */
+    int n_col,			/* number of columns in A */
+    int A [ ],			/* row indices of A, not modified */
+    int p [ ],			/* column pointers of A, not modified */
+    int perm [ ],		/* output permutation, size n_col+1 */
+    double knobs [CCOLAMD_KNOBS],/* parameters (uses defaults if NULL) */
+    int stats [CCOLAMD_STATS],	/* output statistics and error codes */
+    void * (*allocate) (size_t, size_t), /* pointer to calloc (ANSI C) or */
+				/* mxCalloc (for MATLAB mexFunction) */
+    void (*release) (void *),	/* pointer to free (ANSI C) or */
+    				/* mxFree (for MATLAB mexFunction) */
+    int cmember [ ],		/* Constraint set of A, of size n_col */
+    int perm_old [ ],		/* prior ordering of A, of size n_col */
+    int nchanged,		/* number of columns whose pattern changed */
+    int changed [ ]		/* list of changed columns, size nchanged */
+) ;
+
+SuiteSparse_long ccolamd_l_reorder  /* as ccolamd_reorder, w/ SuiteSparse_long
+                                     * integers */
+(
+    SuiteSparse_long n_row,
+    SuiteSparse_long n_col,
+    SuiteSparse_long A [ ],
+    SuiteSparse_long p [ ],
+    SuiteSparse_long perm [ ],
+    double knobs [CCOLAMD_KNOBS],
+    SuiteSparse_long stats [CCOLAMD_STATS],
+    void * (*allocate) (size_t, size_t),
+    void (*release) (void *),
+    SuiteSparse_long cmember [ ],
+    SuiteSparse_long perm_old [ ],
+    SuiteSparse_long nchanged,
+    SuiteSparse_long changed [ ]
+) ;
+
 void ccolamd_report
 (
     int stats [CCOLAMD_STATS]
@@ -170,6 +170,13 @@
  *		Default is FALSE.  CSYMAMD ignores this parameter; it always
  *		orders for Cholesky.
  *
+ *	    knobs [4]: local re-ordering limit
+ *
+ *		Used by ccolamd_reorder only.  The columns affected by a change
+ *		are re-ordered locally if there are at most
+ *		knobs [CCOLAMD_REORDER_LIMIT] * n_col of them.  Otherwise, the
+ *		whole matrix is ordered with ccolamd.  Default: 0.1.
+ *
  *  ----------------------------------------------------------------------------
  *  ccolamd:
  *  ----------------------------------------------------------------------------
@@ -530,6 +537,79 @@
  *		If stype == 0, then the nonzero pattern of A+A' is ordered.
  *
  *  ----------------------------------------------------------------------------
+ *  ccolamd_reorder:
+ *  ----------------------------------------------------------------------------
+ *
+ *	C syntax:
+ *
+ *	    #include "ccolamd.h"
+ *
+ *	    int ccolamd_reorder (int n_row, int n_col, int *A, int *p,
+ *		int *perm, double knobs [CCOLAMD_KNOBS],
+ *		int stats [CCOLAMD_STATS], void (*allocate) (size_t, size_t),
+ *		void (*release) (void *), int *cmember, int *perm_old,
+ *		int nchanged, int *changed) ;
+ *
+ *	    SuiteSparse_long ccolamd_l_reorder (SuiteSparse_long n_row,
+ *		SuiteSparse_long n_col, SuiteSparse_long *A,
+ *		SuiteSparse_long *p, SuiteSparse_long *perm,
+ *		double knobs [CCOLAMD_KNOBS],
+ *		SuiteSparse_long stats [CCOLAMD_STATS],
+ *		void (*allocate) (size_t, size_t), void (*release) (void *),
+ *		SuiteSparse_long *cmember, SuiteSparse_long *perm_old,
+ *		SuiteSparse_long nchanged, SuiteSparse_long *changed) ;
+ *
+ *	Purpose:
+ *
+ *	    Updates a prior column ordering perm_old of A, returned by ccolamd
+ *	    or ccolamd_reorder, after the constraint sets cmember have changed
+ *	    or the pattern of a few columns of A has changed (with n_row and
+ *	    n_col unchanged).  This is much faster than ordering A again.
+ *
+ *	    If nchanged is zero, perm is perm_old stably sorted by cmember.
+ *	    Otherwise, the changed columns and all columns that share a row
+ *	    with them are ordered with ccolamd, and placed in the positions
+ *	    they had in perm_old, before perm is sorted by cmember.  If more
+ *	    than knobs [CCOLAMD_REORDER_LIMIT] * n_col columns are affected,
+ *	    or if perm_old is NULL or not a permutation, then A is simply
+ *	    ordered with ccolamd.
+ *
+ *	    The ordering satisfies the constraints, but its fill-in can be
+ *	    somewhat higher than that of a fresh ordering from ccolamd.  If
+ *	    many updates are done in a row, an occasional call to ccolamd is
+ *	    recommended.
+ *
+ *	Returns:
+ *
+ *	    TRUE (1) if successful, FALSE (0) otherwise.
+ *
+ *	Arguments:
+ *
+ *	    n_row, n_col, knobs, and cmember:  same as ccolamd.
+ *
+ *	    A, p:  the matrix A, as for csymamd.  Since A is not modified, it
+ *		need not have any extra space.
+ *
+ *	    perm [n_col+1]:  output permutation, as for csymamd.  perm may
+ *		be the same array as perm_old.
+ *
+ *	    stats [CCOLAMD_STATS]:  as for ccolamd.  The statistics on dense
+ *		rows and columns and garbage collections are only computed if
+ *		the whole matrix is ordered.  stats [CCOLAMD_NREORDERED] is the
+ *		number of columns re-ordered (n_col if the whole matrix was
+ *		ordered).  If the list of changed columns is invalid, stats [3]
+ *		is CCOLAMD_ERROR_invalid_changed and stats [4] holds the
+ *		invalid entry (or nchanged).
+ *
+ *	    allocate, release:  same as csymamd.
+ *
+ *	    perm_old [n_col]:  the prior ordering of A.  May be NULL.
+ *
+ *	    nchanged, changed [nchanged]:  the list of columns of A whose
+ *		pattern has changed since perm_old was computed.  Columns whose
+ *		only change is in their constraint set need not be listed.
+ *
+ *  ----------------------------------------------------------------------------
  *  ccolamd_report:
  *  ----------------------------------------------------------------------------
  *
@@ -628,6 +708,7 @@
 #define CCOLAMD_post_tree ccolamd_l_post_tree
 #define CCOLAMD_fsize ccolamd_l_fsize
 #define CSYMAMD_MAIN csymamd_l
+#define CCOLAMD_reorder ccolamd_l_reorder
 #define CCOLAMD_report ccolamd_l_report
 #define CSYMAMD_report csymamd_l_report
 
@@ -646,6 +727,7 @@
 #define CCOLAMD_post_tree ccolamd_post_tree
 #define CCOLAMD_fsize ccolamd_fsize
 #define CSYMAMD_MAIN csymamd
+#define CCOLAMD_reorder ccolamd_reorder
 #define CCOLAMD_report ccolamd_report
 #define CSYMAMD_report csymamd_report
 
@@ -1134,6 +1216,7 @@ PUBLIC void CCOLAMD_set_defaults
     knobs [CCOLAMD_DENSE_COL] = 10 ;
     knobs [CCOLAMD_AGGRESSIVE] = TRUE ;	/* default: do aggressive absorption*/
     knobs [CCOLAMD_LU] = FALSE ;	/* default: order for Cholesky */
+    knobs [CCOLAMD_REORDER_LIMIT] = 0.1 ;  /* default: re-order up to 10% */
 }
 
 
@@ -1991,6 +2074,471 @@ PUBLIC void CSYMAMD_report
 }
 
 
+/* ========================================================================== */
+/* === ccolamd_reorder ====================================================== */
+/* ========================================================================== */
+
+/*
+ *  Updates a prior ccolamd ordering perm_old of A after the constraint sets,
+ *  or the pattern of a few columns of A, have changed.  The columns that
+ *  changed, and all columns that share a row with them, are re-ordered with
+ *  ccolamd and placed in the positions they held in perm_old.  The result is
+ *  then stably sorted by cmember.  If too many columns are affected, or if
+ *  perm_old is not a permutation, the matrix is ordered with ccolamd instead.
+ */
+
+PUBLIC Int CCOLAMD_reorder	/* return TRUE if OK, FALSE otherwise */
+(
+    /* === Parameters ======================================================= */
+
+    Int n_row,				/* number of rows in A */
+    Int n_col,				/* number of columns in A */
+    Int A [ ],				/* row indices of A, not modified */
+    Int p [ ],				/* column pointers of A, not modified */
+    Int perm [ ],			/* output permutation, size n_col+1 */
+    double knobs [CCOLAMD_KNOBS],	/* parameters (uses defaults if NULL) */
+    Int stats [CCOLAMD_STATS],		/* output statistics and error codes */
+    void * (*allocate) (size_t, size_t),/* pointer to calloc (ANSI C) or */
+					/* mxCalloc (for MATLAB mexFunction) */
+    void (*release) (void *),		/* pointer to free (ANSI C) or */
+    					/* mxFree (for MATLAB mexFunction) */
+    Int cmember [ ],			/* constraint set */
+    Int perm_old [ ],			/* prior ordering, size n_col */
+    Int nchanged,			/* number of changed columns */
+    Int changed [ ]			/* list of changed columns */
+)
+{
+    /* === Local variables ================================================== */
+
+    double default_knobs [CCOLAMD_KNOBS] ;
+    Int substats [CCOLAMD_STATS] ;
+
+    Int *Work ;			/* workspace of size n_row + 3*n_col + 1 */
+    Int *Rmark ;		/* Rmark [i]: row i of A in row Rmark [i] of M */
+    Int *Cmark ;		/* Cmark [j]: column j of A in column of M */
+    Int *Wk ;			/* copy of perm_old, then other uses */
+    Int *Head ;			/* list of columns of M, then other uses */
+    Int *M ;			/* row indices of M = A (:,region) */
+    Int *Mp ;			/* column pointers of M */
+    Int *Mc ;			/* constraint sets of M */
+    size_t Mlen ;		/* length of M */
+    Int nnz ;			/* number of entries in A */
+    Int mnz ;			/* number of entries in M */
+    Int mrow ;			/* number of rows of M */
+    Int nr ;			/* number of columns of M (size of region) */
+    Int i ;			/* row index of A */
+    Int j ;			/* column index of A */
+    Int k ;			/* index into perm, M, or changed */
+    Int c ;			/* constraint set */
+    Int s ;			/* cumulative set size */
+    Int t ;			/* set size */
+    Int pp ;			/* index into a column of A */
+    Int ok ;			/* TRUE if the local method can be used */
+    Int result ;		/* return value of ccolamd */
+
+#ifndef NDEBUG
+    ccolamd_get_debug ("ccolamd_reorder") ;
+#endif
+
+    /* === Check the input arguments ======================================== */
+
+    if (!stats)
+    {
+	DEBUG1 (("ccolamd_reorder: stats not present\n")) ;
+	return (FALSE) ;
+    }
+    for (i = 0 ; i < CCOLAMD_STATS ; i++)
+    {
+	stats [i] = 0 ;
+    }
+    stats [CCOLAMD_STATUS] = CCOLAMD_OK ;
+    stats [CCOLAMD_INFO1] = -1 ;
+    stats [CCOLAMD_INFO2] = -1 ;
+
+    if (!A)
+    {
+    	stats [CCOLAMD_STATUS] = CCOLAMD_ERROR_A_not_present ;
+	DEBUG1 (("ccolamd_reorder: A not present\n")) ;
+	return (FALSE) ;
+    }
+
+    if (!p || !perm)
+    {
+	stats [CCOLAMD_STATUS] = CCOLAMD_ERROR_p_not_present ;
+	DEBUG1 (("ccolamd_reorder: p not present\n")) ;
+    	return (FALSE) ;
+    }
+
+    if (n_row < 0)
+    {
+	stats [CCOLAMD_STATUS] = CCOLAMD_ERROR_nrow_negative ;
+	stats [CCOLAMD_INFO1] = n_row ;
+	DEBUG1 (("ccolamd_reorder: nrow negative "ID"\n", n_row)) ;
+    	return (FALSE) ;
+    }
+
+    if (n_col < 0)
+    {
+	stats [CCOLAMD_STATUS] = CCOLAMD_ERROR_ncol_negative ;
+	stats [CCOLAMD_INFO1] = n_col ;
+	DEBUG1 (("ccolamd_reorder: ncol negative "ID"\n", n_col)) ;
+    	return (FALSE) ;
+    }
+
+    nnz = p [n_col] ;
+    if (nnz < 0)
+    {
+	stats [CCOLAMD_STATUS] = CCOLAMD_ERROR_nnz_negative ;
+	stats [CCOLAMD_INFO1] = nnz ;
+	DEBUG1 (("ccolamd_reorder: number of entries negative "ID"\n", nnz)) ;
+	return (FALSE) ;
+    }
+
+    if (p [0] != 0)
+    {
+	stats [CCOLAMD_STATUS] = CCOLAMD_ERROR_p0_nonzero ;
+	stats [CCOLAMD_INFO1] = p [0] ;
+	DEBUG1 (("ccolamd_reorder: p[0] not zero "ID"\n", p [0])) ;
+	return (FALSE) ;
+    }
+
+    for (j = 0 ; j < n_col ; j++)
+    {
+	if (p [j+1] < p [j])
+	{
+	    stats [CCOLAMD_STATUS] = CCOLAMD_ERROR_col_length_negative ;
+	    stats [CCOLAMD_INFO1] = j ;
+	    stats [CCOLAMD_INFO2] = p [j+1] - p [j] ;
+	    DEBUG1 (("ccolamd_reorder: col "ID" length "ID" < 0\n",
+		j, p [j+1] - p [j])) ;
+	    return (FALSE) ;
+	}
+	for (pp = p [j] ; pp < p [j+1] ; pp++)
+	{
+	    i = A [pp] ;
+	    if (i < 0 || i >= n_row)
+	    {
+		stats [CCOLAMD_STATUS] = CCOLAMD_ERROR_row_index_out_of_bounds ;
+		stats [CCOLAMD_INFO1] = j ;
+		stats [CCOLAMD_INFO2] = i ;
+		stats [CCOLAMD_INFO3] = n_row ;
+		DEBUG1 (("ccolamd_reorder: row "ID" col "ID" out of bounds\n",
+		    i, j)) ;
+		return (FALSE) ;
+	    }
+	}
+    }
+
+    if (cmember)
+    {
+	for (j = 0 ; j < n_col ; j++)
+	{
+	    if (cmember [j] < 0 || cmember [j] >= n_col)
+	    {
+		stats [CCOLAMD_STATUS] = CCOLAMD_ERROR_invalid_cmember ;
+		DEBUG1 (("ccolamd_reorder: malformed cmember\n")) ;
+		return (FALSE) ;
+	    }
+	}
+    }
+
+    if (nchanged < 0 || (nchanged > 0 && !changed))
+    {
+	stats [CCOLAMD_STATUS] = CCOLAMD_ERROR_invalid_changed ;
+	stats [CCOLAMD_INFO1] = nchanged ;
+	DEBUG1 (("ccolamd_reorder: invalid list of changed columns\n")) ;
+	return (FALSE) ;
+    }
+    for (k = 0 ; k < nchanged ; k++)
+    {
+	if (changed [k] < 0 || changed [k] >= n_col)
+	{
+	    stats [CCOLAMD_STATUS] = CCOLAMD_ERROR_invalid_changed ;
+	    stats [CCOLAMD_INFO1] = changed [k] ;
+	    DEBUG1 (("ccolamd_reorder: invalid changed column\n")) ;
+	    return (FALSE) ;
+	}
+    }
+
+    /* === If no knobs, set default knobs =================================== */
+
+    if (!knobs)
+    {
+	CCOLAMD_set_defaults (default_knobs) ;
+	knobs = default_knobs ;
+    }
+
+    /* === Allocate workspace =============================================== */
+
+    Work = (Int *) ((*allocate) (n_row + 3 * (size_t) n_col + 1,
+	sizeof (Int))) ;
+    if (!Work)
+    {
+	stats [CCOLAMD_STATUS] = CCOLAMD_ERROR_out_of_memory ;
+	DEBUG1 (("ccolamd_reorder: allocate workspace failed\n")) ;
+	return (FALSE) ;
+    }
+    Rmark = Work ;
+    Cmark = Rmark + n_row ;
+    Wk = Cmark + n_col ;
+    Head = Wk + n_col ;
+
+    /* === Check perm_old, and copy it into Wk ============================== */
+
+    ok = (perm_old != (Int *) NULL) ;
+    for (j = 0 ; j < n_col ; j++)
+    {
+	Cmark [j] = EMPTY ;
+    }
+    for (k = 0 ; ok && k < n_col ; k++)
+    {
+	j = perm_old [k] ;
+	ok = (j >= 0 && j < n_col && Cmark [j] == EMPTY) ;
+	if (ok)
+	{
+	    Cmark [j] = k ;
+	    Wk [k] = j ;
+	}
+    }
+
+    /* === Find the region: changed columns and their neighbors ============= */
+
+    /* Cmark [j] = 1 if column j changed, 2 if it shares a row with a changed
+     * column, and 0 otherwise.  Rmark [i] is TRUE if row i is in a changed
+     * column. */
+
+    nr = 0 ;
+    if (ok && nchanged > 0)
+    {
+	for (j = 0 ; j < n_col ; j++)
+	{
+	    Cmark [j] = 0 ;
+	}
+	for (k = 0 ; k < nchanged ; k++)
+	{
+	    j = changed [k] ;
+	    Cmark [j] = 1 ;
+	    for (pp = p [j] ; pp < p [j+1] ; pp++)
+	    {
+		Rmark [A [pp]] = TRUE ;
+	    }
+	}
+	for (j = 0 ; j < n_col ; j++)
+	{
+	    for (pp = p [j] ; Cmark [j] == 0 && pp < p [j+1] ; pp++)
+	    {
+		if (Rmark [A [pp]])
+		{
+		    Cmark [j] = 2 ;
+		}
+	    }
+	    if (Cmark [j] != 0)
+	    {
+		nr++ ;
+	    }
+	}
+	ok = (nr <= knobs [CCOLAMD_REORDER_LIMIT] * n_col) ;
+    }
+    DEBUG1 (("ccolamd_reorder: nchanged "ID" region "ID" ok "ID"\n",
+	nchanged, nr, ok)) ;
+
+    if (!ok)
+    {
+	/* === Too many changes, or no prior ordering: use ccolamd ========== */
+
+	(*release) ((void *) Work) ;
+	Mlen = CCOLAMD_recommended (nnz, n_row, n_col) ;
+	M = (Int *) ((*allocate) (MAX (Mlen, 1), sizeof (Int))) ;
+	if (!M)
+	{
+	    stats [CCOLAMD_STATUS] = CCOLAMD_ERROR_out_of_memory ;
+	    DEBUG1 (("ccolamd_reorder: allocate M failed\n")) ;
+	    return (FALSE) ;
+	}
+	for (pp = 0 ; pp < nnz ; pp++)
+	{
+	    M [pp] = A [pp] ;
+	}
+	for (j = 0 ; j <= n_col ; j++)
+	{
+	    perm [j] = p [j] ;
+	}
+	result = CCOLAMD_MAIN (n_row, n_col, (Int) Mlen, M, perm, knobs, stats,
+	    cmember) ;
+	(*release) ((void *) M) ;
+	stats [CCOLAMD_NREORDERED] = n_col ;
+	return (result) ;
+    }
+
+    /* === Re-order the region ============================================== */
+
+    if (nr > 0)
+    {
+	/* Head [0..nr-1] lists the region in the order of perm_old, and
+	 * Cmark [j] becomes the position of column j in that list */
+	nr = 0 ;
+	for (k = 0 ; k < n_col ; k++)
+	{
+	    j = Wk [k] ;
+	    if (Cmark [j] != 0)
+	    {
+		Head [nr] = j ;
+		Cmark [j] = nr++ ;
+	    }
+	    else
+	    {
+		Cmark [j] = EMPTY ;
+	    }
+	}
+
+	/* number the rows of M = A (:,region), in ascending order so that M
+	 * is jumbled only if A is */
+	mnz = 0 ;
+	mrow = 0 ;
+	for (i = 0 ; i < n_row ; i++)
+	{
+	    Rmark [i] = EMPTY ;
+	}
+	for (k = 0 ; k < nr ; k++)
+	{
+	    j = Head [k] ;
+	    for (pp = p [j] ; pp < p [j+1] ; pp++)
+	    {
+		Rmark [A [pp]] = 0 ;
+	    }
+	    mnz += p [j+1] - p [j] ;
+	}
+	for (i = 0 ; i < n_row ; i++)
+	{
+	    if (Rmark [i] == 0)
+	    {
+		Rmark [i] = mrow++ ;
+	    }
+	}
+
+	Mlen = CCOLAMD_recommended (mnz, mrow, nr) ;
+	M  = (Int *) ((*allocate) (MAX (Mlen, 1), sizeof (Int))) ;
+	Mp = (Int *) ((*allocate) (nr+1, sizeof (Int))) ;
+	Mc = (Int *) ((*allocate) (nr+1, sizeof (Int))) ;
+	if (!M || !Mp || !Mc)
+	{
+	    stats [CCOLAMD_STATUS] = CCOLAMD_ERROR_out_of_memory ;
+	    if (M)  (*release) ((void *) M) ;
+	    if (Mp) (*release) ((void *) Mp) ;
+	    if (Mc) (*release) ((void *) Mc) ;
+	    (*release) ((void *) Work) ;
+	    DEBUG1 (("ccolamd_reorder: allocate M failed\n")) ;
+	    return (FALSE) ;
+	}
+
+	/* construct M, with its columns in the order of perm_old */
+	mnz = 0 ;
+	for (k = 0 ; k < nr ; k++)
+	{
+	    Mp [k] = mnz ;
+	    j = Head [k] ;
+	    for (pp = p [j] ; pp < p [j+1] ; pp++)
+	    {
+		M [mnz++] = Rmark [A [pp]] ;
+	    }
+	}
+	Mp [nr] = mnz ;
+
+	/* renumber the constraint sets of the region to the range 0 to nr-1,
+	 * keeping their relative order */
+	if (cmember)
+	{
+	    for (c = 0 ; c < n_col ; c++)
+	    {
+		Wk [c] = EMPTY ;
+	    }
+	    for (k = 0 ; k < nr ; k++)
+	    {
+		Wk [cmember [Head [k]]] = 0 ;
+	    }
+	    s = 0 ;
+	    for (c = 0 ; c < n_col ; c++)
+	    {
+		if (Wk [c] != EMPTY)
+		{
+		    Wk [c] = s++ ;
+		}
+	    }
+	    for (k = 0 ; k < nr ; k++)
+	    {
+		Mc [k] = Wk [cmember [Head [k]]] ;
+	    }
+	}
+
+	result = CCOLAMD_MAIN (mrow, nr, (Int) Mlen, M, Mp, knobs, substats,
+	    cmember ? Mc : (Int *) NULL) ;
+	(*release) ((void *) M) ;
+	(*release) ((void *) Mc) ;
+	if (!result)
+	{
+	    for (i = 0 ; i < CCOLAMD_STATS ; i++)
+	    {
+		stats [i] = substats [i] ;
+	    }
+	    (*release) ((void *) Mp) ;
+	    (*release) ((void *) Work) ;
+	    return (FALSE) ;
+	}
+	stats [CCOLAMD_STATUS] = substats [CCOLAMD_STATUS] ;
+
+	/* the region takes the places it had in perm_old, in its new order */
+	k = 0 ;
+	for (i = 0 ; i < n_col ; i++)
+	{
+	    j = perm_old [i] ;
+	    perm [i] = (Cmark [j] == EMPTY) ? j : Head [Mp [k++]] ;
+	}
+	(*release) ((void *) Mp) ;
+    }
+    else
+    {
+	for (k = 0 ; k < n_col ; k++)
+	{
+	    perm [k] = Wk [k] ;
+	}
+    }
+
+    /* === Sort the ordering by the new constraint sets ===================== */
+
+    if (cmember)
+    {
+	for (c = 0 ; c <= n_col ; c++)
+	{
+	    Head [c] = 0 ;
+	}
+	for (k = 0 ; k < n_col ; k++)
+	{
+	    Head [cmember [perm [k]]]++ ;
+	}
+	s = 0 ;
+	for (c = 0 ; c < n_col ; c++)
+	{
+	    t = Head [c] ;
+	    Head [c] = s ;
+	    s += t ;
+	}
+	for (k = 0 ; k < n_col ; k++)
+	{
+	    Wk [Head [cmember [perm [k]]]++] = perm [k] ;
+	}
+	for (k = 0 ; k < n_col ; k++)
+	{
+	    perm [k] = Wk [k] ;
+	}
+    }
+
+    (*release) ((void *) Work) ;
+    stats [CCOLAMD_NREORDERED] = nr ;
+    DEBUG1 (("ccolamd_reorder: done.\n")) ;
+    return (TRUE) ;
+}
+
+
 /* ========================================================================== */
 /* === NON-USER-CALLABLE ROUTINES: ========================================== */
 /* ========================================================================== */
@@ -3847,6 +4395,11 @@ PRIVATE void print_report
 
             SUITESPARSE_PRINTF(("cmember invalid\n")) ;
 	    break ;
+
+	case CCOLAMD_ERROR_invalid_changed:
+
+            SUITESPARSE_PRINTF(("list of changed columns invalid\n")) ;
+	    break ;
     }
 }
 
@@ -0,0 +1,175 @@
+/* ========================================================================== */
+/* === Check/cholmod_bin ==================================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * CHOLMOD/Check Module.  Copyright (C) 2026, the CHOLMOD contributors.
+ * http://www.suitesparse.com
+ * -------------------------------------------------------------------------- */
+
+/* Write a sparse matrix to a SuiteSparse_bin file, and use a matrix loaded
+ * from such a file as a cholmod_sparse matrix without copying it.  See
+ * SuiteSparse_config/SuiteSparse_bin.h for a description of the file.
+ *
+ * cholmod_write_bin	write a sparse matrix to a SuiteSparse_bin file.
+ *
+ * cholmod_bin_sparse	fill in a cholmod_sparse header whose arrays are those
+ *			of a matrix loaded by SuiteSparse_bin_load.  The file
+ *			must hold a compressed-column matrix whose indices have
+ *			the same size as Int (4 bytes for cholmod_bin_sparse,
+ *			8 for cholmod_l_bin_sparse).
+ *
+ * The matrix returned by cholmod_bin_sparse is a view of the loaded file: it
+ * must not be freed with cholmod_free_sparse, and it can be used only until
+ * SuiteSparse_bin_free is called.  CHOLMOD may modify it in place (by sorting
+ * it, for example); this modifies the mapped pages, not the file itself.
+ */
+
+#ifndef NCHECK
+
+#include "cholmod_config.h"
+#include "cholmod_internal.h"
+#include "cholmod_check.h"
+
+/* ========================================================================== */
+/* === cholmod_write_bin ==================================================== */
+/* ========================================================================== */
+
+/* Write a sparse matrix to a SuiteSparse_bin file.  An unpacked matrix is
+ * packed and sorted first.  Returns TRUE if successful, FALSE otherwise.
+ */
+
+int CHOLMOD(write_bin)
+(
+    /* ---- input ---- */
+    const char *filename,   /* file to write */
+    cholmod_sparse *A,	    /* matrix to write */
+    int checksum,	    /* if TRUE, include block checksums in the file */
+    /* --------------- */
+    cholmod_common *Common
+)
+{
+    cholmod_sparse *C = NULL, *T ;
+    int status, values ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    RETURN_IF_NULL_COMMON (FALSE) ;
+    RETURN_IF_NULL (filename, FALSE) ;
+    RETURN_IF_NULL (A, FALSE) ;
+    RETURN_IF_XTYPE_INVALID (A, CHOLMOD_PATTERN, CHOLMOD_ZOMPLEX, FALSE) ;
+    if (A->itype != ITYPE || A->dtype != DTYPE)
+    {
+	ERROR (CHOLMOD_INVALID, "integer or numerical type of A invalid") ;
+	return (FALSE) ;
+    }
+    Common->status = CHOLMOD_OK ;
+
+    /* ---------------------------------------------------------------------- */
+    /* pack the matrix, if needed */
+    /* ---------------------------------------------------------------------- */
+
+    if (!A->packed)
+    {
+	/* C = (A.')', which is packed and sorted.  cholmod_copy cannot be used
+	 * since it handles only real matrices. */
+	values = (A->xtype != CHOLMOD_PATTERN) ;
+	T = CHOLMOD(transpose) (A, values, Common) ;
+	C = CHOLMOD(transpose) (T, values, Common) ;
+	CHOLMOD(free_sparse) (&T, Common) ;
+	if (Common->status < CHOLMOD_OK)
+	{
+	    CHOLMOD(free_sparse) (&C, Common) ;
+	    return (FALSE) ;	    /* out of memory */
+	}
+	A = C ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* write the file */
+    /* ---------------------------------------------------------------------- */
+
+    /* SUITESPARSE_BIN_PATTERN, _REAL, _COMPLEX, and _ZOMPLEX are the same as
+     * CHOLMOD_PATTERN, _REAL, _COMPLEX, and _ZOMPLEX */
+    status = SuiteSparse_bin_write (filename, SUITESPARSE_BIN_CSC, A->nrow,
+	A->ncol, sizeof (Int), A->p, A->i, A->xtype, A->x, A->z, A->stype,
+	A->sorted, checksum) ;
+    CHOLMOD(free_sparse) (&C, Common) ;
+
+    if (status == SUITESPARSE_BIN_OUT_OF_MEMORY)
+    {
+	ERROR (CHOLMOD_OUT_OF_MEMORY, "out of memory") ;
+	return (FALSE) ;
+    }
+    else if (status != SUITESPARSE_BIN_OK)
+    {
+	ERROR (CHOLMOD_INVALID, "error writing file") ;
+	return (FALSE) ;
+    }
+    return (TRUE) ;
+}
+
+
+/* ========================================================================== */
+/* === cholmod_bin_sparse =================================================== */
+/* ========================================================================== */
+
+/* Returns A, or NULL if the loaded matrix cannot be used by CHOLMOD without
+ * converting it.
+ */
+
+cholmod_sparse *CHOLMOD(bin_sparse)
+(
+    /* ---- input ---- */
+    SuiteSparse_bin *B,	    /* matrix loaded by SuiteSparse_bin_load */
+    /* ---- output --- */
+    cholmod_sparse *A,	    /* a view of B, not to be freed */
+    /* --------------- */
+    cholmod_common *Common
+)
+{
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    RETURN_IF_NULL_COMMON (NULL) ;
+    RETURN_IF_NULL (B, NULL) ;
+    RETURN_IF_NULL (A, NULL) ;
+    Common->status = CHOLMOD_OK ;
+    if (B->p == NULL || B->orient != SUITESPARSE_BIN_CSC
+	|| B->isize != sizeof (Int))
+    {
+	ERROR (CHOLMOD_INVALID, "matrix must be compressed-column, with"
+	    " integers of the same size as Int") ;
+	return (NULL) ;
+    }
+    if (B->stype != 0 && B->nrow != B->ncol)
+    {
+	ERROR (CHOLMOD_INVALID, "symmetric matrix must be square") ;
+	return (NULL) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* fill in the header of A, using the arrays of B in place */
+    /* ---------------------------------------------------------------------- */
+
+    A->nrow = B->nrow ;
+    A->ncol = B->ncol ;
+    A->nzmax = B->nnz ;
+    A->p = B->p ;
+    A->i = B->i ;
+    A->nz = NULL ;
+    A->x = B->x ;
+    A->z = B->z ;
+    A->stype = B->stype ;
+    A->itype = ITYPE ;
+    A->xtype = B->xtype ;
+    A->dtype = DTYPE ;
+    A->sorted = B->sorted ;
+    A->packed = TRUE ;
+    return (A) ;
+}
+#endif
@@ -0,0 +1,714 @@
+/* ========================================================================== */
+/* === Check/cholmod_graph ================================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * CHOLMOD/Check Module.  Copyright (C) 2026, the CHOLMOD contributors.
+ * http://www.suitesparse.com
+ * -------------------------------------------------------------------------- */
+
+/* Read a graph in METIS or DIMACS10 format, and return it as a symmetric
+ * sparse matrix.  This is the file format read by the METIS programs and by
+ * MATLAB_Tools/dimacs10/metis_graph_read.m.  Lines starting with '%' are
+ * comments.  The first line of the file has the form:
+ *
+ *	n nz		# of vertices and # of edges
+ *	n nz fmt	fmt defaults to 0 if not present
+ *	n nz fmt ncon	ncon defaults to 0 if fmt is 0, 1, or 100, or 1 if fmt
+ *			is 10 or 11.
+ *
+ *	fmt:
+ *	    0:	no vertex or edge weights
+ *	    1:	no vertex weights, has edge weights
+ *	    10:	has vertex weights, no edge weights
+ *	    11:	has both vertex and edge weights
+ *	    100: no weights, and the graph may include self-edges and multiple
+ *		edges (a multigraph).  This is the DIMACS10 extension of the
+ *		METIS format.
+ *
+ *	ncon: the number of weights of each vertex.
+ *
+ * The next n lines hold the adjacency list of each vertex.  Line j has the
+ * form:
+ *
+ *	w1 w2 ... wncon v1 e1 v2 e2 ... vk ek
+ *
+ * where w1 to wncon are the weights of vertex j, and the vertex has k
+ * neighbors.  Vertex vt is adjacent to vertex j, and et is the weight of the
+ * edge (j,vt); the edge weights are present only if fmt is 1 or 11.  Vertices
+ * are numbered 1 to n.  A blank line is a vertex with no neighbors, and lines
+ * after the nth are ignored.  nz is not used, since each edge is listed twice,
+ * once for each of its two vertices.
+ *
+ * The n-by-n matrix A is returned with A(i,j) equal to the weight of the edge
+ * (i,j), or 1 if the graph has no edge weights.  If an edge appears more than
+ * once in the adjacency list of a vertex, its weights are summed, so that
+ * A(i,j) is the number of edges (i,j) of a multigraph.  A graph with duplicate
+ * edges or self-edges is returned with fmt = 100, as in metis_graph_read.m.
+ * The graph must be symmetric: A(i,j) must equal A(j,i).  Vertex weights must
+ * be integers >= 0, and edge weights must be > 0.
+ *
+ * The file is read into memory first, and then parsed, sorted, and checked
+ * for symmetry with up to Common->read_graph_nthreads OpenMP threads.  The
+ * result does not depend on the number of threads.
+ */
+
+#ifndef NCHECK
+
+#include "cholmod_internal.h"
+#include "cholmod_check.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* initial size of the buffer for the file */
+#define GRAPH_BUFSIZE (1 << 20)
+
+/* minimum number of bytes of the file for each thread */
+#define GRAPH_BYTES_PER_THREAD 65536
+
+/* adjacency lists given to each thread at a time */
+#define GRAPH_CHUNK 256
+
+/* white space within a line */
+#define GRAPH_BLANK(c) ((c) == ' ' || (c) == '\t' || (c) == '\r' || \
+    (c) == '\v' || (c) == '\f')
+
+/* ========================================================================== */
+/* === graph_nthreads ======================================================= */
+/* ========================================================================== */
+
+/* Returns the number of threads to use for a file of the given size. */
+
+static int graph_nthreads (double len, cholmod_common *Common)
+{
+    int nthreads = 1 ;
+#ifdef _OPENMP
+    nthreads = Common->read_graph_nthreads ;
+    if (nthreads <= 0)
+    {
+	nthreads = omp_get_max_threads ( ) ;
+    }
+    nthreads = MIN (nthreads, len / GRAPH_BYTES_PER_THREAD) ;
+    nthreads = MAX (nthreads, 1) ;
+#endif
+    return (nthreads) ;
+}
+
+/* ========================================================================== */
+/* === read_file ============================================================ */
+/* ========================================================================== */
+
+/* Read the rest of the file into a single buffer, terminated with '\0'.  The
+ * buffer is allocated with SuiteSparse_malloc, since the file can be larger
+ * than Int_max bytes, which is the limit of cholmod_malloc.  Returns NULL if
+ * out of memory.
+ */
+
+static char *read_file (FILE *f, size_t *len)
+{
+    char *buf, *buf2 ;
+    size_t size = GRAPH_BUFSIZE, k = 0 ;
+    int ok = TRUE ;
+    buf = SuiteSparse_malloc (size, sizeof (char)) ;
+    while (buf != NULL)
+    {
+	k += fread (buf + k, sizeof (char), size - k - 1, f) ;
+	if (k < size - 1)
+	{
+	    /* end of file */
+	    break ;
+	}
+	buf2 = SuiteSparse_realloc (2*size, size, sizeof (char), buf, &ok) ;
+	if (!ok)
+	{
+	    SuiteSparse_free (buf) ;
+	    return (NULL) ;
+	}
+	buf = buf2 ;
+	size = 2*size ;
+    }
+    if (buf != NULL)
+    {
+	buf [k] = '\0' ;
+	*len = k ;
+    }
+    return (buf) ;
+}
+
+/* ========================================================================== */
+/* === get_number =========================================================== */
+/* ========================================================================== */
+
+/* Parse the token starting at s, which is not a blank.  Plain integers, which
+ * are the most common tokens in a graph, are parsed here; anything else is
+ * parsed with strtod.  Returns a pointer to the first character after the
+ * token, or NULL if the token is not a number.
+ */
+
+static const char *get_number (const char *s, double *x)
+{
+    const char *t = s ;
+    char *u ;
+    double v = 0 ;
+    while (*t >= '0' && *t <= '9')
+    {
+	v = 10 * v + (*t++ - '0') ;
+    }
+    if (t > s && (*t == '\0' || *t == '\n' || GRAPH_BLANK (*t)))
+    {
+	*x = v ;
+	return (t) ;
+    }
+    v = strtod (s, &u) ;
+    if (u == s || !(*u == '\0' || *u == '\n' || GRAPH_BLANK (*u)))
+    {
+	return (NULL) ;
+    }
+    *x = v ;
+    return (u) ;
+}
+
+/* ========================================================================== */
+/* === count_tokens ========================================================= */
+/* ========================================================================== */
+
+/* Returns the number of tokens on the line starting at s. */
+
+static Int count_tokens (const char *s)
+{
+    Int ntokens = 0 ;
+    while (TRUE)
+    {
+	while (GRAPH_BLANK (*s)) s++ ;
+	if (*s == '\0' || *s == '\n') return (ntokens) ;
+	ntokens++ ;
+	while (!(*s == '\0' || *s == '\n' || GRAPH_BLANK (*s))) s++ ;
+    }
+}
+
+/* ========================================================================== */
+/* === sort_column ========================================================== */
+/* ========================================================================== */
+
+/* Sort Ai [0..n-1] in ascending order, with Ax (if not NULL) permuted in the
+ * same way.  Quicksort with a median-of-three pivot, and insertion sort for
+ * short lists.  Adjacency lists of high degree are common in graphs, so the
+ * recursion is on the shorter half, to keep the stack small.
+ */
+
+#define SWAP(a,b) { Int ti = Ai [a] ; Ai [a] = Ai [b] ; Ai [b] = ti ; \
+    if (Ax != NULL) { double tx = Ax [a] ; Ax [a] = Ax [b] ; Ax [b] = tx ; } }
+
+static void sort_column (Int *Ai, double *Ax, Int n)
+{
+    Int i, j, k, pivot ;
+    while (n > 16)
+    {
+	/* median of three: Ai [0] <= Ai [n/2] <= Ai [n-1] */
+	k = n / 2 ;
+	if (Ai [k] < Ai [0]) SWAP (k, 0) ;
+	if (Ai [n-1] < Ai [0]) SWAP (n-1, 0) ;
+	if (Ai [n-1] < Ai [k]) SWAP (n-1, k) ;
+	pivot = Ai [k] ;
+
+	/* partition into Ai [0..j] <= pivot and Ai [j+1..n-1] >= pivot */
+	i = -1 ;
+	j = n ;
+	while (TRUE)
+	{
+	    do i++ ; while (Ai [i] < pivot) ;
+	    do j-- ; while (Ai [j] > pivot) ;
+	    if (i >= j) break ;
+	    SWAP (i, j) ;
+	}
+
+	/* sort the shorter part, and iterate on the longer one */
+	if (j + 1 < n - j - 1)
+	{
+	    sort_column (Ai, Ax, j + 1) ;
+	    Ai += j + 1 ;
+	    if (Ax != NULL) Ax += j + 1 ;
+	    n -= j + 1 ;
+	}
+	else
+	{
+	    sort_column (Ai + j + 1, (Ax == NULL) ? NULL : Ax + j + 1,
+		n - j - 1) ;
+	    n = j + 1 ;
+	}
+    }
+
+    /* insertion sort */
+    for (k = 1 ; k < n ; k++)
+    {
+	for (i = k ; i > 0 && Ai [i] < Ai [i-1] ; i--)
+	{
+	    SWAP (i, i-1) ;
+	}
+    }
+}
+
+#undef SWAP
+
+/* ========================================================================== */
+/* === cholmod_read_graph =================================================== */
+/* ========================================================================== */
+
+/* Read a graph in METIS or DIMACS10 format.  Returns the graph as an n-by-n
+ * real matrix A with sorted columns.  If stype is zero, both the upper and
+ * lower triangular parts of A are returned, and A->stype is zero.  If stype
+ * is > 0, only the upper triangular part is returned (A->stype = 1), and if
+ * stype is < 0, only the lower triangular part is returned (A->stype = -1).
+ * If W is not NULL, the vertex weights are returned in *W, an n-by-ncon dense
+ * matrix (NULL if the graph has no vertex weights).  If fmt is not NULL, the
+ * format of the graph is returned in *fmt.  Returns NULL on error.
+ */
+
+cholmod_sparse *CHOLMOD(read_graph)
+(
+    /* ---- input ---- */
+    FILE *f,		/* file to read from, must already be open */
+    int stype,		/* 0: both parts of A, > 0: upper part, < 0: lower */
+    /* ---- output --- */
+    cholmod_dense **W,	/* vertex weights, n-by-ncon, or NULL if none */
+    int *fmt,		/* format of the graph: 0, 1, 10, 11, or 100 */
+    /* --------------- */
+    cholmod_common *Common
+)
+{
+    double x1 = 0, x2 = 0, x3 = 0, x4 = 0, nnz ;
+    double *Ax, *Wx ;
+    Int *Ap, *Ai, *Cnt ;
+    cholmod_sparse *A ;
+    cholmod_dense *Wd ;
+    char *buf, *s, *start, *end ;
+    size_t len, nlines, *Line, *Chunk ;
+    Int n, j, p, pnew, ncon, has_ew, gfmt, nchunks, c ;
+    Int nbad, nbadw, nbade, ndupl, nself, nunsym ;
+    int nthreads, nread ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    RETURN_IF_NULL_COMMON (NULL) ;
+    RETURN_IF_NULL (f, NULL) ;
+    Common->status = CHOLMOD_OK ;
+    if (W != NULL)
+    {
+	*W = NULL ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* read the whole file */
+    /* ---------------------------------------------------------------------- */
+
+    buf = read_file (f, &len) ;
+    if (buf == NULL)
+    {
+	ERROR (CHOLMOD_OUT_OF_MEMORY, "out of memory") ;
+	return (NULL) ;
+    }
+    end = buf + len ;
+    nthreads = graph_nthreads ((double) len, Common) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* skip leading comments and parse the format line */
+    /* ---------------------------------------------------------------------- */
+
+    s = buf ;
+    while (*s == '%')
+    {
+	while (*s != '\0' && *s != '\n') s++ ;
+	if (*s == '\n') s++ ;
+    }
+    start = s ;
+    while (*start != '\0' && *start != '\n') start++ ;
+    if (*start == '\n') *start++ = '\0' ;
+    /* n and nz are required; the header is checked before it is converted
+     * to Int, since a value too large for an Int cannot be cast */
+    nread = sscanf (s, "%lg %lg %lg %lg", &x1, &x2, &x3, &x4) ;
+    if (nread < 2 || !(x1 >= 0) || x1 != floor (x1) || !(x4 >= 0) ||
+	x4 != floor (x4) ||
+	!(x3 == 0 || x3 == 1 || x3 == 10 || x3 == 11 || x3 == 100))
+    {
+	SuiteSparse_free (buf) ;
+	ERROR (CHOLMOD_INVALID, "invalid graph header") ;
+	return (NULL) ;
+    }
+    if (x1 > Int_max || x4 > Int_max)
+    {
+	SuiteSparse_free (buf) ;
+	ERROR (CHOLMOD_TOO_LARGE, "problem too large") ;
+	return (NULL) ;
+    }
+    n = (Int) x1 ;
+    gfmt = (Int) x3 ;
+    ncon = (Int) x4 ;
+    if (gfmt == 10 || gfmt == 11)
+    {
+	ncon = MAX (ncon, 1) ;
+    }
+    has_ew = (gfmt == 1 || gfmt == 11) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* find the start of each adjacency list */
+    /* ---------------------------------------------------------------------- */
+
+    /* A line starts at the start of the data or after a newline, and is an
+     * adjacency list if it does not start with '%'.  The data is split into
+     * nchunks chunks.  Each chunk counts the lines that start in it, and
+     * then records where the first n of them start.  Line [j] is the start of
+     * the adjacency list of vertex j, or end if the file has fewer lines. */
+
+    nchunks = (nthreads == 1) ? 1 : (4 * nthreads) ;
+    Line = SuiteSparse_malloc (n, sizeof (size_t)) ;
+    Chunk = SuiteSparse_malloc (nchunks + 1, sizeof (size_t)) ;
+    if (Line == NULL || Chunk == NULL)
+    {
+	SuiteSparse_free (buf) ;
+	SuiteSparse_free (Line) ;
+	SuiteSparse_free (Chunk) ;
+	ERROR (CHOLMOD_OUT_OF_MEMORY, "out of memory") ;
+	return (NULL) ;
+    }
+
+    #pragma omp parallel for num_threads(nthreads) schedule(static,1) \
+	if (nthreads > 1)
+    for (c = 0 ; c < nchunks ; c++)
+    {
+	size_t k, lo, hi, count = 0 ;
+	lo = (start - buf) + (c * (size_t) (end - start)) / nchunks ;
+	hi = (start - buf) + ((c+1) * (size_t) (end - start)) / nchunks ;
+	for (k = lo ; k < hi ; k++)
+	{
+	    if ((buf + k == start || buf [k-1] == '\n') && buf [k] != '%')
+	    {
+		count++ ;
+	    }
+	}
+	Chunk [c] = count ;
+    }
+
+    nlines = 0 ;
+    for (c = 0 ; c < nchunks ; c++)
+    {
+	size_t count = Chunk [c] ;
+	Chunk [c] = nlines ;
+	nlines += count ;
+    }
+    Chunk [nchunks] = nlines ;
+
+    #pragma omp parallel for num_threads(nthreads) schedule(static,1) \
+	if (nthreads > 1)
+    for (c = 0 ; c < nchunks ; c++)
+    {
+	size_t k, lo, hi, line = Chunk [c] ;
+	lo = (start - buf) + (c * (size_t) (end - start)) / nchunks ;
+	hi = (start - buf) + ((c+1) * (size_t) (end - start)) / nchunks ;
+	for (k = lo ; k < hi && line < (size_t) n ; k++)
+	{
+	    if ((buf + k == start || buf [k-1] == '\n') && buf [k] != '%')
+	    {
+		Line [line++] = k ;
+	    }
+	}
+    }
+
+    for (j = MIN (nlines, (size_t) n) ; j < n ; j++)
+    {
+	/* missing adjacency lists are empty */
+	Line [j] = len ;
+    }
+    SuiteSparse_free (Chunk) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* count the edges of each vertex */
+    /* ---------------------------------------------------------------------- */
+
+    Cnt = CHOLMOD(malloc) (n+1, sizeof (Int), Common) ;
+    if (Common->status < CHOLMOD_OK)
+    {
+	SuiteSparse_free (buf) ;
+	SuiteSparse_free (Line) ;
+	return (NULL) ;	    /* out of memory */
+    }
+
+    nbad = 0 ;
+    #pragma omp parallel for num_threads(nthreads) \
+	schedule(dynamic,GRAPH_CHUNK) reduction(+:nbad) if (nthreads > 1)
+    for (j = 0 ; j < n ; j++)
+    {
+	Int t = count_tokens (buf + Line [j]) - ncon ;
+	if (t < 0 || (has_ew && t % 2 != 0))
+	{
+	    /* missing vertex weights, or an edge without a weight */
+	    nbad++ ;
+	    t = 0 ;
+	}
+	Cnt [j] = has_ew ? (t / 2) : t ;
+    }
+
+    nnz = 0 ;
+    for (j = 0 ; j < n ; j++)
+    {
+	nnz += Cnt [j] ;
+    }
+
+    if (nbad > 0)
+    {
+	ERROR (CHOLMOD_INVALID, "invalid adjacency list") ;
+    }
+    else if (nnz > Int_max)
+    {
+	ERROR (CHOLMOD_TOO_LARGE, "problem too large") ;
+    }
+    if (Common->status < CHOLMOD_OK)
+    {
+	SuiteSparse_free (buf) ;
+	SuiteSparse_free (Line) ;
+	CHOLMOD(free) (n+1, sizeof (Int), Cnt, Common) ;
+	return (NULL) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate the result */
+    /* ---------------------------------------------------------------------- */
+
+    A = CHOLMOD(allocate_sparse) (n, n, (Int) nnz, TRUE, TRUE, 0,
+	CHOLMOD_REAL, Common) ;
+    Wd = NULL ;
+    if (W != NULL && ncon > 0)
+    {
+	Wd = CHOLMOD(allocate_dense) (n, ncon, n, CHOLMOD_REAL, Common) ;
+    }
+    if (Common->status < CHOLMOD_OK)
+    {
+	SuiteSparse_free (buf) ;
+	SuiteSparse_free (Line) ;
+	CHOLMOD(free) (n+1, sizeof (Int), Cnt, Common) ;
+	CHOLMOD(free_sparse) (&A, Common) ;
+	CHOLMOD(free_dense) (&Wd, Common) ;
+	return (NULL) ;	    /* out of memory */
+    }
+    Ap = A->p ;
+    Ai = A->i ;
+    Ax = A->x ;
+    Wx = (Wd == NULL) ? NULL : Wd->x ;
+
+    p = 0 ;
+    for (j = 0 ; j < n ; j++)
+    {
+	Ap [j] = p ;
+	p += Cnt [j] ;
+    }
+    Ap [n] = p ;
+
+    /* ---------------------------------------------------------------------- */
+    /* parse each adjacency list */
+    /* ---------------------------------------------------------------------- */
+
+    nbadw = 0 ;
+    nbade = 0 ;
+    #pragma omp parallel for num_threads(nthreads) \
+	schedule(dynamic,GRAPH_CHUNK) reduction(+:nbad,nbadw,nbade) \
+	if (nthreads > 1)
+    for (j = 0 ; j < n ; j++)
+    {
+	const char *t = buf + Line [j] ;
+	double x ;
+	Int k, i, q ;
+
+	/* vertex weights, which must be integers >= 0 */
+	for (k = 0 ; k < ncon ; k++)
+	{
+	    while (GRAPH_BLANK (*t)) t++ ;
+	    t = get_number (t, &x) ;
+	    if (t == NULL || !(x >= 0) || x != floor (x))
+	    {
+		nbadw++ ;
+		t = NULL ;
+		break ;
+	    }
+	    if (Wx != NULL)
+	    {
+		Wx [j + k*n] = x ;
+	    }
+	}
+
+	/* edges, and their weights if present */
+	for (q = Ap [j] ; t != NULL && q < Ap [j+1] ; q++)
+	{
+	    while (GRAPH_BLANK (*t)) t++ ;
+	    t = get_number (t, &x) ;
+	    if (t == NULL || !(x >= 1 && x <= n) || x != floor (x))
+	    {
+		nbad++ ;
+		break ;
+	    }
+	    i = (Int) x ;
+	    Ai [q] = i - 1 ;
+	    if (has_ew)
+	    {
+		while (GRAPH_BLANK (*t)) t++ ;
+		t = get_number (t, &x) ;
+		if (t == NULL || !(x > 0))
+		{
+		    nbade++ ;
+		    break ;
+		}
+		Ax [q] = x ;
+	    }
+	}
+    }
+
+    SuiteSparse_free (buf) ;
+    SuiteSparse_free (Line) ;
+
+    if (nbad > 0)
+    {
+	ERROR (CHOLMOD_INVALID, "invalid vertex in adjacency list") ;
+    }
+    else if (nbadw > 0)
+    {
+	ERROR (CHOLMOD_INVALID, "vertex weights must be integers >= 0") ;
+    }
+    else if (nbade > 0)
+    {
+	ERROR (CHOLMOD_INVALID, "edge weights must be > 0") ;
+    }
+    if (Common->status < CHOLMOD_OK)
+    {
+	CHOLMOD(free) (n+1, sizeof (Int), Cnt, Common) ;
+	CHOLMOD(free_sparse) (&A, Common) ;
+	CHOLMOD(free_dense) (&Wd, Common) ;
+	return (NULL) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* sort each column and sum up duplicates */
+    /* ---------------------------------------------------------------------- */
+
+    /* Cnt [j] becomes the number of distinct entries in A(:,j), which are
+     * kept in Ai [Ap [j] ... Ap [j] + Cnt [j] - 1]. */
+
+    ndupl = 0 ;
+    nself = 0 ;
+    #pragma omp parallel for num_threads(nthreads) \
+	schedule(dynamic,GRAPH_CHUNK) reduction(+:ndupl,nself) \
+	if (nthreads > 1)
+    for (j = 0 ; j < n ; j++)
+    {
+	Int q, k, pstart = Ap [j], pend = Ap [j+1] ;
+	sort_column (Ai + pstart, has_ew ? (Ax + pstart) : NULL,
+	    pend - pstart) ;
+	k = pstart - 1 ;
+	for (q = pstart ; q < pend ; q++)
+	{
+	    double x = has_ew ? Ax [q] : 1 ;
+	    if (k >= pstart && Ai [k] == Ai [q])
+	    {
+		/* duplicate edge */
+		Ax [k] += x ;
+		ndupl++ ;
+	    }
+	    else
+	    {
+		Ai [++k] = Ai [q] ;
+		Ax [k] = x ;
+		if (Ai [k] == j) nself++ ;
+	    }
+	}
+	Cnt [j] = k - pstart + 1 ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* check the symmetry of A */
+    /* ---------------------------------------------------------------------- */
+
+    /* For each A(i,j), find A(j,i) in the sorted column i. */
+
+    nunsym = 0 ;
+    #pragma omp parallel for num_threads(nthreads) \
+	schedule(dynamic,GRAPH_CHUNK) reduction(+:nunsym) if (nthreads > 1)
+    for (j = 0 ; j < n ; j++)
+    {
+	Int q, i, lo, hi, mid ;
+	for (q = Ap [j] ; q < Ap [j] + Cnt [j] ; q++)
+	{
+	    i = Ai [q] ;
+	    lo = Ap [i] ;
+	    hi = Ap [i] + Cnt [i] - 1 ;
+	    while (lo < hi)
+	    {
+		mid = (lo + hi) / 2 ;
+		if (Ai [mid] < j) lo = mid + 1 ; else hi = mid ;
+	    }
+	    if (lo > hi || Ai [lo] != j || Ax [lo] != Ax [q])
+	    {
+		nunsym++ ;
+	    }
+	}
+    }
+
+    if (nunsym > 0)
+    {
+	CHOLMOD(free) (n+1, sizeof (Int), Cnt, Common) ;
+	CHOLMOD(free_sparse) (&A, Common) ;
+	CHOLMOD(free_dense) (&Wd, Common) ;
+	ERROR (CHOLMOD_INVALID, "graph must be symmetric") ;
+	return (NULL) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* remove the gaps left by duplicates, and the unwanted triangular part */
+    /* ---------------------------------------------------------------------- */
+
+    pnew = 0 ;
+    for (j = 0 ; j < n ; j++)
+    {
+	Int pstart = Ap [j] ;
+	Ap [j] = pnew ;
+	for (p = pstart ; p < pstart + Cnt [j] ; p++)
+	{
+	    Int i = Ai [p] ;
+	    if (stype == 0 || (stype > 0 && i <= j) || (stype < 0 && i >= j))
+	    {
+		Ai [pnew] = i ;
+		Ax [pnew] = Ax [p] ;
+		pnew++ ;
+	    }
+	}
+    }
+    Ap [n] = pnew ;
+    CHOLMOD(free) (n+1, sizeof (Int), Cnt, Common) ;
+
+    /* reduce A->nzmax; this cannot fail since the size of A is decreasing */
+    CHOLMOD(reallocate_sparse) (pnew, A, Common) ;
+
+    A->stype = SIGN (stype) ;
+    A->sorted = TRUE ;
+    A->packed = TRUE ;
+
+    /* ---------------------------------------------------------------------- */
+    /* return the result */
+    /* ---------------------------------------------------------------------- */
+
+    if (ndupl > 0 || nself > 0)
+    {
+	/* the graph is a multigraph */
+	gfmt = 100 ;
+    }
+    if (fmt != NULL)
+    {
+	*fmt = gfmt ;
+    }
+    if (W != NULL)
+    {
+	*W = Wd ;
+    }
+    ASSERT (CHOLMOD(dump_sparse) (A, "read_graph:A", Common) >= 0) ;
+    return (A) ;
+}
+#endif
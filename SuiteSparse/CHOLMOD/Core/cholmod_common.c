@@ -159,6 +159,7 @@ int CHOLMOD(start)
     Common->SPQR_small = 1e6 ;  /* target min task size for TBB */
     Common->SPQR_shrink = 1 ;   /* controls SPQR shrink realloc */
     Common->SPQR_nthreads = 0 ; /* 0: let TBB decide how many threads to use */
+    Common->SPQR_memory = 0 ;   /* do not reorder fronts to reduce memory */
 
     Common->SPQR_flopcount = 0 ;         /* flop count for SPQR */
     Common->SPQR_analyze_time = 0 ;      /* analysis time for SPQR */
@@ -274,6 +275,10 @@ int CHOLMOD(defaults)
     Common->prefer_zomplex = FALSE ;
     Common->prefer_upper = TRUE ;
     Common->prefer_binary = FALSE ;
+    Common->sparseinv_nthreads = 0 ;
+    Common->spgemm_nthreads = 0 ;
+    Common->read_graph_nthreads = 0 ;
+    Common->nd_nthreads = 1 ;
     Common->quick_return_if_not_posdef = FALSE ;
 
     /* METIS workarounds */
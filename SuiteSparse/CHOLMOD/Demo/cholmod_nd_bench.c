@@ -0,0 +1,134 @@
+/* ========================================================================== */
+/* === Demo/cholmod_nd_bench ================================================ */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * CHOLMOD/Demo Module.  Copyright (C) 2005-2013, Timothy A. Davis
+ * -------------------------------------------------------------------------- */
+
+/* Benchmark for the parallel nested dissection (cholmod_nested_dissection),
+ * on the graph of a k-by-k-by-k 3D mesh with a 7-point stencil.  The graph is
+ * ordered with one thread, and then with 2, 4, ... up to nthreads threads
+ * (Common->nd_nthreads).  Each ordering must be the same as the one found with
+ * one thread.
+ *
+ * Usage:  cholmod_nd_bench k nthreads
+ *
+ * k defaults to 60 and nthreads to 4.
+ */
+
+#include "cholmod.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define Long SuiteSparse_long
+
+/* the lower triangular part of the 7-point stencil on a k-by-k-by-k mesh */
+static cholmod_sparse *mesh3d (Long k, cholmod_common *cm)
+{
+    cholmod_sparse *A ;
+    Long *Ap, *Ai, n, i, j, l, p, node ;
+    n = k*k*k ;
+    A = cholmod_l_allocate_sparse (n, n, 4*n, 1, 1, -1, CHOLMOD_PATTERN,
+	cm) ;
+    if (A == NULL) return (NULL) ;
+    Ap = A->p ;
+    Ai = A->i ;
+    p = 0 ;
+    for (l = 0 ; l < k ; l++)
+    {
+	for (j = 0 ; j < k ; j++)
+	{
+	    for (i = 0 ; i < k ; i++)
+	    {
+		node = i + j*k + l*k*k ;
+		Ap [node] = p ;
+		Ai [p++] = node ;
+		if (i < k-1) Ai [p++] = node + 1 ;
+		if (j < k-1) Ai [p++] = node + k ;
+		if (l < k-1) Ai [p++] = node + k*k ;
+	    }
+	}
+    }
+    Ap [n] = p ;
+    return (A) ;
+}
+
+int main (int argc, char **argv)
+{
+    cholmod_common Common, *cm ;
+    cholmod_sparse *A ;
+    Long *Perm [2], *CParent [2], *Cmember [2], ncomp [2], k, n, j, t ;
+    double tt [2] ;
+    int nthreads, maxthreads, same, nfail = 0 ;
+
+    k = (argc > 1) ? atol (argv [1]) : 60 ;
+    maxthreads = (argc > 2) ? atoi (argv [2]) : 4 ;
+    k = (k < 2) ? 2 : k ;
+
+    cm = &Common ;
+    cholmod_l_start (cm) ;
+    A = mesh3d (k, cm) ;
+    if (A == NULL)
+    {
+	printf ("out of memory\n") ;
+	return (1) ;
+    }
+    n = A->nrow ;
+    printf ("3D mesh: %ld-by-%ld-by-%ld, n %ld nnz %ld\n", k, k, k, n,
+	cholmod_l_nnz (A, cm)) ;
+
+    for (t = 0 ; t < 2 ; t++)
+    {
+	Perm [t] = cholmod_l_malloc (n, sizeof (Long), cm) ;
+	CParent [t] = cholmod_l_malloc (n, sizeof (Long), cm) ;
+	Cmember [t] = cholmod_l_malloc (n, sizeof (Long), cm) ;
+    }
+    if (cm->status < CHOLMOD_OK)
+    {
+	printf ("out of memory\n") ;
+	return (1) ;
+    }
+
+    for (nthreads = 1 ; nthreads <= maxthreads ; nthreads *= 2)
+    {
+	t = (nthreads == 1) ? 0 : 1 ;
+	cm->nd_nthreads = nthreads ;
+	cm->memory_usage = cm->memory_inuse ;
+	tt [t] = SuiteSparse_time ( ) ;
+	ncomp [t] = cholmod_l_nested_dissection (A, NULL, 0, Perm [t],
+	    CParent [t], Cmember [t], cm) ;
+	tt [t] = SuiteSparse_time ( ) - tt [t] ;
+	same = (ncomp [t] == ncomp [0]) ;
+	for (j = 0 ; same && j < n ; j++)
+	{
+	    same = (Perm [t][j] == Perm [0][j] &&
+		    Cmember [t][j] == Cmember [0][j]) ;
+	}
+	for (j = 0 ; same && j < ncomp [0] ; j++)
+	{
+	    same = (CParent [t][j] == CParent [0][j]) ;
+	}
+	printf ("nthreads %2d: time %8.3f sec, speedup %5.2f, components %ld,"
+	    " peak memory %8.1f MB : %s\n", nthreads, tt [t], tt [0] / tt [t],
+	    ncomp [t], (double) cm->memory_usage / 1e6,
+	    (ncomp [t] > 0 && same) ? "OK" : "FAIL") ;
+	if (ncomp [t] <= 0 || !same) nfail++ ;
+    }
+
+    for (t = 0 ; t < 2 ; t++)
+    {
+	cholmod_l_free (n, sizeof (Long), Perm [t], cm) ;
+	cholmod_l_free (n, sizeof (Long), CParent [t], cm) ;
+	cholmod_l_free (n, sizeof (Long), Cmember [t], cm) ;
+    }
+    cholmod_l_free_sparse (&A, cm) ;
+    cholmod_l_finish (cm) ;
+    if (cm->malloc_count != 0 || cm->memory_inuse != 0)
+    {
+	printf ("memory leak: %ld objects, %ld bytes\n",
+	    (Long) cm->malloc_count, (Long) cm->memory_inuse) ;
+	nfail++ ;
+    }
+    return (nfail > 0) ;
+}
@@ -46,10 +46,18 @@
  * cholmod_read_dense	    read a dense matrix (any Matrix Market "array"
  *			    format, or a generic dense format).
  *
+ * cholmod_read_graph	    read a graph in METIS or DIMACS10 format, as a
+ *			    symmetric sparse matrix.
+ *
  * cholmod_write_sparse	    write a sparse matrix to a Matrix Market file.
  *
  * cholmod_write_dense	    write a dense matrix to a Matrix Market file.
  *
+ * cholmod_write_bin	    write a sparse matrix to a SuiteSparse_bin file.
+ *
+ * cholmod_bin_sparse	    use a matrix loaded by SuiteSparse_bin_load as a
+ *			    cholmod_sparse matrix, without copying it.
+ *
  * cholmod_print_common and cholmod_check_common are the only two routines that
  * you may call after calling cholmod_finish.
  *
@@ -64,6 +72,7 @@
 #define CHOLMOD_CHECK_H
 
 #include "cholmod_core.h"
+#include "SuiteSparse_bin.h"
 #include <stdio.h>
 
 /* -------------------------------------------------------------------------- */
@@ -421,4 +430,57 @@ int cholmod_write_dense
 
 int cholmod_l_write_dense (FILE *, cholmod_dense *, const char *,
     cholmod_common *) ;
+
+/* -------------------------------------------------------------------------- */
+/* cholmod_read_graph: read a graph in METIS or DIMACS10 format */
+/* -------------------------------------------------------------------------- */
+
+cholmod_sparse *cholmod_read_graph
+(
+    /* ---- input ---- */
+    FILE *f,		/* file to read from, must already be open */
+    int stype,		/* 0: both parts of A, > 0: upper part, < 0: lower */
+    /* ---- output --- */
+    cholmod_dense **W,	/* vertex weights, n-by-ncon, or NULL if none */
+    int *fmt,		/* format of the graph: 0, 1, 10, 11, or 100 */
+    /* --------------- */
+    cholmod_common *Common
+) ;
+
+cholmod_sparse *cholmod_l_read_graph (FILE *, int, cholmod_dense **, int *,
+    cholmod_common *) ;
+
+/* -------------------------------------------------------------------------- */
+/* cholmod_write_bin: write a sparse matrix to a SuiteSparse_bin file */
+/* -------------------------------------------------------------------------- */
+
+int cholmod_write_bin
+(
+    /* ---- input ---- */
+    const char *filename,   /* file to write */
+    cholmod_sparse *A,	    /* matrix to write */
+    int checksum,	    /* if TRUE, include block checksums in the file */
+    /* --------------- */
+    cholmod_common *Common
+) ;
+
+int cholmod_l_write_bin (const char *, cholmod_sparse *, int,
+    cholmod_common *) ;
+
+/* -------------------------------------------------------------------------- */
+/* cholmod_bin_sparse: a cholmod_sparse view of a loaded SuiteSparse_bin file */
+/* -------------------------------------------------------------------------- */
+
+cholmod_sparse *cholmod_bin_sparse
+(
+    /* ---- input ---- */
+    SuiteSparse_bin *B,	    /* matrix loaded by SuiteSparse_bin_load */
+    /* ---- output --- */
+    cholmod_sparse *A,	    /* a view of B, not to be freed */
+    /* --------------- */
+    cholmod_common *Common
+) ;
+
+cholmod_sparse *cholmod_l_bin_sparse (SuiteSparse_bin *, cholmod_sparse *,
+    cholmod_common *) ;
 #endif
@@ -918,7 +918,7 @@ typedef struct cholmod_common_struct
     double SPQR_grain ;      /* task size is >= max (total flops / grain) */
     double SPQR_small ;      /* task size is >= small */
     int SPQR_shrink ;        /* controls stack realloc method */
-    int SPQR_nthreads ;      /* number of TBB threads, 0 = auto */
+    int SPQR_nthreads ;      /* number of OpenMP threads, 0 = auto */
 
     /* ---------------------------------------------------------------------- */
     /* SuiteSparseQR statistics */
@@ -1019,6 +1019,52 @@ typedef struct cholmod_common_struct
     size_t cholmod_gpu_trsm_calls ;
     size_t cholmod_gpu_potrf_calls ;
 
+    /* ---------------------------------------------------------------------- */
+    /* SuiteSparseQR control parameters added at the end, to preserve the ABI */
+    /* ---------------------------------------------------------------------- */
+
+    int SPQR_memory ;        /* if TRUE, order the fronts to reduce the
+        peak size of the stack of the sequential factorization (Liu's
+        ordering).  If the task tree is used (SPQR_grain > 1), the tasks are
+        found in the new order, so the number of tasks can change and the
+        total size of all the stacks can grow.  Only the stack is affected;
+        SPQR_istat [8] and [9] report its bound and peak size, in entries,
+        not the total memory usage (which is memory_usage, in bytes).
+        Default: FALSE */
+
+    /* ---------------------------------------------------------------------- */
+    /* CHOLMOD control parameters added at the end, to preserve the ABI */
+    /* ---------------------------------------------------------------------- */
+
+    int nd_nthreads ;	/* If > 1, NESDIS bisects the subgraphs of
+			 * different branches of the separator tree at the same
+	* time, using up to nd_nthreads OpenMP threads.  If <= 0, the OpenMP
+	* default is used, except that graphs with fewer than 4096 nodes are
+	* ordered with one thread.  This applies to every NESDIS method in
+	* Common->method.  The ordering does not depend on nd_nthreads.  More
+	* threads are not always faster, and each thread needs its own
+	* workspace.  Ignored if CHOLMOD is not compiled with OpenMP.
+	* Default: 1 */
+
+    int sparseinv_nthreads ;	/* cholmod_super_sparseinv computes the
+				 * independent subtrees of the supernodal
+	* elimination tree in parallel, using up to this many OpenMP threads.
+	* If <= 0, the OpenMP default is used.  The result does not depend on
+	* the number of threads.  Ignored if CHOLMOD is not compiled with
+	* OpenMP.  Default: 0 */
+
+    int spgemm_nthreads ;	/* cholmod_spgemm splits the columns of C
+				 * among up to this many OpenMP threads.  If
+	* <= 0, the OpenMP default is used.  Fewer threads are used for small
+	* products.  The result does not depend on the number of threads.
+	* Ignored if CHOLMOD is not compiled with OpenMP.  Default: 0 */
+
+    int read_graph_nthreads ;	/* cholmod_read_graph parses and checks the
+				 * graph with up to this many OpenMP threads.
+	* If <= 0, the OpenMP default is used.  Fewer threads are used for small
+	* files.  The result does not depend on the number of threads.  Ignored
+	* if CHOLMOD is not compiled with OpenMP.  Default: 0 */
+
 } cholmod_common ;
 
 /* size_t BLAS statistcs in Common: */
@@ -18,6 +18,7 @@
  * cholmod_horzcat	    C = [A,B]
  * cholmod_scale	    A = diag(s)*A, A*diag(s), s*A or diag(s)*A*diag(s)
  * cholmod_sdmult	    Y = alpha*(A*X) + beta*Y or alpha*(A'*X) + beta*Y
+ * cholmod_spgemm	    C = A*B, in parallel, with a reusable symbolic phase
  * cholmod_ssmult	    C = A*B
  * cholmod_submatrix	    C = A (i,j), where i and j are arbitrary vectors
  * cholmod_vertcat	    C = [A ; B]
@@ -164,6 +165,59 @@ cholmod_sparse *cholmod_ssmult
 cholmod_sparse *cholmod_l_ssmult (cholmod_sparse *, cholmod_sparse *, int, int,
     int, cholmod_common *) ;
 
+/* -------------------------------------------------------------------------- */
+/* cholmod_spgemm:  C = A*B, in parallel */
+/* -------------------------------------------------------------------------- */
+
+/* cholmod_spgemm_symbolic computes the sorted pattern of C = A*B.  If values
+ * is TRUE and A and B are both real or both complex, space for the values of C
+ * is allocated, and cholmod_spgemm_numeric computes them.  The numeric phase
+ * can be repeated for new values of A and B with the same patterns.  The
+ * columns of C are split among up to Common->spgemm_nthreads OpenMP threads.
+ * C is returned unsymmetric, packed, and sorted.  A complex symmetric A or B
+ * is taken to be Hermitian.  Zomplex matrices are not supported.
+ */
+
+cholmod_sparse *cholmod_spgemm_symbolic
+(
+    /* ---- input ---- */
+    cholmod_sparse *A,	/* left matrix to multiply */
+    cholmod_sparse *B,	/* right matrix to multiply */
+    int values,		/* if TRUE, allocate space for the values of C */
+    /* --------------- */
+    cholmod_common *Common
+) ;
+
+cholmod_sparse *cholmod_l_spgemm_symbolic (cholmod_sparse *, cholmod_sparse *,
+    int, cholmod_common *) ;
+
+int cholmod_spgemm_numeric
+(
+    /* ---- input ---- */
+    cholmod_sparse *A,	/* left matrix to multiply */
+    cholmod_sparse *B,	/* right matrix to multiply */
+    /* ---- in/out --- */
+    cholmod_sparse *C,	/* C = A*B, pattern from cholmod_spgemm_symbolic */
+    /* --------------- */
+    cholmod_common *Common
+) ;
+
+int cholmod_l_spgemm_numeric (cholmod_sparse *, cholmod_sparse *,
+    cholmod_sparse *, cholmod_common *) ;
+
+cholmod_sparse *cholmod_spgemm
+(
+    /* ---- input ---- */
+    cholmod_sparse *A,	/* left matrix to multiply */
+    cholmod_sparse *B,	/* right matrix to multiply */
+    int values,		/* TRUE: do numerical values, FALSE: pattern only */
+    /* --------------- */
+    cholmod_common *Common
+) ;
+
+cholmod_sparse *cholmod_l_spgemm (cholmod_sparse *, cholmod_sparse *, int,
+    cholmod_common *) ;
+
 /* -------------------------------------------------------------------------- */
 /* cholmod_submatrix:  C = A (r,c), where i and j are arbitrary vectors */
 /* -------------------------------------------------------------------------- */
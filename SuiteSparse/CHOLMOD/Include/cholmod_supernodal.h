@@ -21,6 +21,7 @@
  * cholmod_super_numeric	supernodal numeric factorization
  * cholmod_super_lsolve		supernodal Lx=b solve
  * cholmod_super_ltsolve	supernodal L'x=b solve
+ * cholmod_super_sparseinv	sparse inverse subset, on the pattern of L
  *
  * Prototypes for the BLAS and LAPACK routines that CHOLMOD uses are listed
  * below, including how they are used in CHOLMOD.
@@ -28,10 +29,10 @@
  * BLAS routines:
  * --------------
  * dtrsv	solve Lx=b or L'x=b, L non-unit diagonal, x and b stride-1
- * dtrsm	solve LX=B or L'X=b, L non-unit diagonal
+ * dtrsm	solve LX=B, L'X=b, or XL=B, L non-unit diagonal
  * dgemv	y=y-A*x or y=y-A'*x (x and y stride-1)
  * dgemm	C=A*B', C=C-A*B, or C=C-A'*B
- * dsyrk	C=tril(A*A')
+ * dsyrk	C=tril(A*A') or C=tril(A'*A)
  *
  * LAPACK routines:
  * ----------------
@@ -166,4 +167,26 @@ int cholmod_super_ltsolve
 int cholmod_l_super_ltsolve (cholmod_factor *, cholmod_dense *, cholmod_dense *,
     cholmod_common *) ;
 
+/* -------------------------------------------------------------------------- */
+/* cholmod_super_sparseinv */
+/* -------------------------------------------------------------------------- */
+
+/* Computes the entries of inv(L*L') in the pattern of L, where L is from a
+ * supernodal numeric factorization (selected inversion).  Returns them as a
+ * symmetric sparse matrix with stype = -1.  The diagonal of inv(A) is on the
+ * diagonal of the result, permuted by L->Perm.  Independent subtrees of the
+ * supernodal elimination tree are done in parallel with OpenMP, using up to
+ * Common->sparseinv_nthreads threads. */
+
+cholmod_sparse *cholmod_super_sparseinv
+(
+    /* ---- input ---- */
+    cholmod_factor *L,	/* supernodal numeric factor, LL'=P*A*P' */
+    /* --------------- */
+    cholmod_common *Common
+) ;
+
+cholmod_sparse *cholmod_l_super_sparseinv (cholmod_factor *,
+    cholmod_common *) ;
+
 #endif
@@ -104,7 +104,8 @@ end
 
  %-------------------------------------------------------------------------------
 
-config_src = { '../../SuiteSparse_config/SuiteSparse_config' } ;
+config_src = { '../../SuiteSparse_config/SuiteSparse_config', ...
+    '../../SuiteSparse_config/SuiteSparse_bin' } ;
 
 ordering_src = { ...
     '../../AMD/Source/amd_1', ...
@@ -226,6 +227,8 @@ cholmod_src = {
     '../Check/cholmod_check', ...
     '../Check/cholmod_read', ...
     '../Check/cholmod_write', ...
+    '../Check/cholmod_bin', ...
+    '../Check/cholmod_graph', ...
     '../Cholesky/cholmod_amd', ...
     '../Cholesky/cholmod_analyze', ...
     '../Cholesky/cholmod_colamd', ...
@@ -244,6 +247,7 @@ cholmod_src = {
     '../MatrixOps/cholmod_scale', ...
     '../MatrixOps/cholmod_sdmult', ...
     '../MatrixOps/cholmod_ssmult', ...
+    '../MatrixOps/cholmod_spgemm', ...
     '../MatrixOps/cholmod_submatrix', ...
     '../MatrixOps/cholmod_vertcat', ...
     '../MatrixOps/cholmod_symmetry', ...
@@ -253,6 +257,7 @@ cholmod_src = {
     '../Supernodal/cholmod_super_numeric', ...
     '../Supernodal/cholmod_super_solve', ...
     '../Supernodal/cholmod_super_symbolic', ...
+    '../Supernodal/cholmod_super_sparseinv', ...
     '../Partition/cholmod_ccolamd', ...
     '../Partition/cholmod_csymamd', ...
     '../Partition/cholmod_camd', ...
@@ -0,0 +1,760 @@
+/* ========================================================================== */
+/* === MatrixOps/cholmod_spgemm ============================================= */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * CHOLMOD/MatrixOps Module.  Copyright (C) 2026, the CHOLMOD contributors.
+ * http://www.suitesparse.com
+ * -------------------------------------------------------------------------- */
+
+/* C = A*B, in two phases, with OpenMP parallelism.
+ *
+ * cholmod_spgemm_symbolic computes the pattern of C = A*B, with sorted
+ * columns.  cholmod_spgemm_numeric computes the numerical values of C,
+ * and can be called again for new values of A and B, as long as their
+ * patterns do not change.  cholmod_spgemm does both.
+ *
+ * This is Gustavson's method, as in cholmod_ssmult and MATLAB_Tools/SSMULT,
+ * but the columns of C are split among up to Common->spgemm_nthreads OpenMP
+ * threads.  Each column C(:,j) is computed with one of two accumulators,
+ * chosen by its flop count (the sum of nnz (A(:,t)) for each B(t,j)).  If
+ * the flop count is small compared with the number of rows of C, a small hash
+ * table is used, which fits in cache.  Otherwise a dense workspace of size
+ * A->nrow is used.  The result does not depend on the number of threads.
+ *
+ * A and B can be packed or unpacked, sorted or unsorted, and of any stype.
+ * If A or B are symmetric, an internal unsymmetric copy is made first (a
+ * complex symmetric matrix is taken to be Hermitian, as in the rest of
+ * CHOLMOD).  They can be pattern, real, or complex.  C is returned unsymmetric, packed and
+ * sorted.
+ *
+ * workspace: Iwork (max (A->nrow, A->ncol)) if A is symmetric, or
+ *	Iwork (max (B->nrow, B->ncol)) if B is symmetric.  For each thread,
+ *	O(A->nrow) workspace is allocated here.
+ */
+
+#ifndef NGPL
+#ifndef NMATRIXOPS
+
+#include "cholmod_internal.h"
+#include "cholmod_matrixops.h"
+#ifdef _OPENMP
+#include <omp.h>
+#define SPGEMM_TID omp_get_thread_num ( )
+#else
+#define SPGEMM_TID 0
+#endif
+
+/* columns of C given to each thread at a time */
+#define SPGEMM_CHUNK 64
+
+/* minimum number of flops for each thread */
+#define SPGEMM_FLOPS_PER_THREAD 65536
+
+/* use a hash accumulator for C(:,j) if its flop count is < nrow/16 */
+#define SPGEMM_RATIO 16
+#define SPGEMM_USE_HASH(flops,nrow) ((flops) * SPGEMM_RATIO < (nrow))
+
+/* the hash function, for a table of size hsize (a power of 2) */
+#define SPGEMM_HASH(i,hsize) (((i) * 257) & ((hsize) - 1))
+
+/* ========================================================================== */
+/* === spgemm_hsize ========================================================= */
+/* ========================================================================== */
+
+/* Returns the size of the hash table for a column with the given flop count:
+ * the smallest power of 2 that is at least 2*flops.  The table is thus at
+ * most half full. */
+
+static Int spgemm_hsize (Int flops)
+{
+    Int hsize = 2 ;
+    while (hsize < 2*flops)
+    {
+	hsize *= 2 ;
+    }
+    return (hsize) ;
+}
+
+/* ========================================================================== */
+/* === TEMPLATE ============================================================= */
+/* ========================================================================== */
+
+#define REAL
+#include "t_cholmod_spgemm.c"
+#define COMPLEX
+#include "t_cholmod_spgemm.c"
+
+/* ========================================================================== */
+/* === spgemm_compare ======================================================= */
+/* ========================================================================== */
+
+/* for sorting the row indices of a column of C */
+
+static int spgemm_compare (const void *p1, const void *p2)
+{
+    Int i1 = *((Int *) p1) ;
+    Int i2 = *((Int *) p2) ;
+    return ((i1 < i2) ? (-1) : ((i1 > i2) ? 1 : 0)) ;
+}
+
+/* ========================================================================== */
+/* === spgemm_flops ========================================================= */
+/* ========================================================================== */
+
+/* Flops [j] = the flop count of C(:,j), but at most nrow.  Returns the total
+ * flop count of C = A*B, and the size of the largest hash table needed. */
+
+static double spgemm_flops
+(
+    cholmod_sparse *A,
+    cholmod_sparse *B,
+    Int *Flops,		/* size B->ncol */
+    Int *hmax		/* size of largest hash table */
+)
+{
+    double total = 0 ;
+    Int *Ap, *Anz, *Bp, *Bnz, *Bi ;
+    Int nrow, ncol, j, t, f, fmax, pb, pbend, aknz ;
+    int apacked, bpacked ;
+
+    Ap  = A->p ;
+    Anz = A->nz ;
+    apacked = A->packed ;
+    Bp  = B->p ;
+    Bnz = B->nz ;
+    Bi  = B->i ;
+    bpacked = B->packed ;
+    nrow = A->nrow ;
+    ncol = B->ncol ;
+
+    fmax = 0 ;
+    for (j = 0 ; j < ncol ; j++)
+    {
+	f = 0 ;
+	pb = Bp [j] ;
+	pbend = (bpacked) ? (Bp [j+1]) : (pb + Bnz [j]) ;
+	for ( ; pb < pbend ; pb++)
+	{
+	    t = Bi [pb] ;
+	    aknz = (apacked) ? (Ap [t+1] - Ap [t]) : (Anz [t]) ;
+	    total += aknz ;
+	    f = MIN (f + aknz, nrow) ;
+	}
+	Flops [j] = f ;
+	if (SPGEMM_USE_HASH (f, nrow))
+	{
+	    fmax = MAX (fmax, f) ;
+	}
+    }
+    *hmax = spgemm_hsize (fmax) ;
+    return (total) ;
+}
+
+/* ========================================================================== */
+/* === spgemm_nthreads ====================================================== */
+/* ========================================================================== */
+
+/* Returns the number of threads to use for a product with the given flops. */
+
+static int spgemm_nthreads (double flops, Int ncol, cholmod_common *Common)
+{
+    int nthreads = 1 ;
+#ifdef _OPENMP
+    nthreads = Common->spgemm_nthreads ;
+    if (nthreads <= 0)
+    {
+	nthreads = omp_get_max_threads ( ) ;
+    }
+    nthreads = MIN (nthreads, flops / SPGEMM_FLOPS_PER_THREAD) ;
+    nthreads = MIN (nthreads, ncol) ;
+    nthreads = MAX (nthreads, 1) ;
+#endif
+    return (nthreads) ;
+}
+
+/* ========================================================================== */
+/* === spgemm_pattern ======================================================= */
+/* ========================================================================== */
+
+/* Finds the pattern of C(:,j), of size cnz, and returns cnz.  If Cj is not
+ * NULL, the pattern is also stored in Cj [0..cnz-1], in sorted order.  Mark
+ * has size nrow, and Mark [i] < stamp for all i on input; stamp must be
+ * different each time spgemm_pattern is called.  Hkey has size hmax. */
+
+static Int spgemm_pattern
+(
+    Int j,
+    cholmod_sparse *A,
+    cholmod_sparse *B,
+    Int flops,		/* flops for C(:,j), at most nrow */
+    Int stamp,
+    Int *Mark,
+    Int *Hkey,
+    Int *Cj		/* if not NULL, pattern of C(:,j) */
+)
+{
+    Int *Ap, *Anz, *Ai, *Bp, *Bnz, *Bi ;
+    Int nrow, i, t, pa, paend, pb, pbend, h, hsize, cnz ;
+    int apacked, bpacked, use_hash ;
+
+    Ap  = A->p ;
+    Anz = A->nz ;
+    Ai  = A->i ;
+    apacked = A->packed ;
+    Bp  = B->p ;
+    Bnz = B->nz ;
+    Bi  = B->i ;
+    bpacked = B->packed ;
+    nrow = A->nrow ;
+
+    use_hash = SPGEMM_USE_HASH (flops, nrow) ;
+    hsize = 0 ;
+    if (use_hash)
+    {
+	hsize = spgemm_hsize (flops) ;
+	for (h = 0 ; h < hsize ; h++)
+	{
+	    Hkey [h] = EMPTY ;
+	}
+    }
+
+    /* find the pattern of C(:,j) = A*B(:,j) */
+    cnz = 0 ;
+    pb = Bp [j] ;
+    pbend = (bpacked) ? (Bp [j+1]) : (pb + Bnz [j]) ;
+    for ( ; pb < pbend ; pb++)
+    {
+	t = Bi [pb] ;
+	pa = Ap [t] ;
+	paend = (apacked) ? (Ap [t+1]) : (pa + Anz [t]) ;
+	for ( ; pa < paend ; pa++)
+	{
+	    i = Ai [pa] ;
+	    if (use_hash)
+	    {
+		for (h = SPGEMM_HASH (i, hsize) ;
+		    Hkey [h] != i && Hkey [h] != EMPTY ;
+		    h = (h+1) & (hsize-1)) ;
+		if (Hkey [h] == i) continue ;
+		Hkey [h] = i ;
+	    }
+	    else
+	    {
+		if (Mark [i] == stamp) continue ;
+		Mark [i] = stamp ;
+	    }
+	    /* row i is a new entry in C(:,j) */
+	    if (Cj != NULL)
+	    {
+		Cj [cnz] = i ;
+	    }
+	    cnz++ ;
+	}
+    }
+
+    /* sort the pattern of C(:,j) */
+    if (Cj != NULL && cnz > 1)
+    {
+	if (!use_hash && cnz > nrow / SPGEMM_RATIO)
+	{
+	    /* C(:,j) has many entries; find them in order in Mark */
+	    cnz = 0 ;
+	    for (i = 0 ; i < nrow ; i++)
+	    {
+		if (Mark [i] == stamp)
+		{
+		    Cj [cnz++] = i ;
+		}
+	    }
+	}
+	else
+	{
+	    qsort (Cj, cnz, sizeof (Int), spgemm_compare) ;
+	}
+    }
+    return (cnz) ;
+}
+
+/* ========================================================================== */
+/* === spgemm_unsym ========================================================= */
+/* ========================================================================== */
+
+/* Returns an unsymmetric copy of A if A is symmetric, or NULL otherwise.  A
+ * complex symmetric A is Hermitian: each entry A(i,j) of its stored triangle
+ * is also placed in C(j,i), conjugated.  cholmod_copy does not handle complex
+ * values, so that case is done here. */
+
+static cholmod_sparse *spgemm_unsym
+(
+    cholmod_sparse *A,
+    int values,
+    cholmod_common *Common
+)
+{
+    double *Ax, *Cx ;
+    cholmod_sparse *C ;
+    Int *Ap, *Ai, *Anz, *Cp, *Ci, *Wj ;
+    Int n, i, j, p, pend, q, cnz, upper, lower ;
+    int apacked ;
+
+    if (A->stype == 0)
+    {
+	return (NULL) ;
+    }
+    if (!values || A->xtype != CHOLMOD_COMPLEX)
+    {
+	/* workspace: Iwork (max (A->nrow,A->ncol)) */
+	return (CHOLMOD(copy) (A, 0, values, Common)) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* get inputs and workspace */
+    /* ---------------------------------------------------------------------- */
+
+    n = A->nrow ;
+    Ap = A->p ;
+    Ai = A->i ;
+    Anz = A->nz ;
+    Ax = A->x ;
+    apacked = A->packed ;
+    upper = (A->stype > 0) ;
+    lower = (A->stype < 0) ;
+    CHOLMOD(allocate_work) (0, n, 0, Common) ;
+    if (Common->status < CHOLMOD_OK)
+    {
+	/* out of memory */
+	return (NULL) ;
+    }
+    Wj = Common->Iwork ;	/* size n (i/i/l) */
+    for (j = 0 ; j < n ; j++)
+    {
+	Wj [j] = 0 ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* count the entries in each column of C */
+    /* ---------------------------------------------------------------------- */
+
+    cnz = 0 ;
+    for (j = 0 ; j < n ; j++)
+    {
+	p = Ap [j] ;
+	pend = (apacked) ? (Ap [j+1]) : (p + Anz [j]) ;
+	for ( ; p < pend ; p++)
+	{
+	    i = Ai [p] ;
+	    if ((upper && i > j) || (lower && i < j)) continue ;
+	    Wj [j]++ ;
+	    cnz++ ;
+	    if (i != j)
+	    {
+		Wj [i]++ ;
+		cnz++ ;
+	    }
+	}
+    }
+
+    C = CHOLMOD(allocate_sparse) (n, n, cnz, FALSE, TRUE, 0, CHOLMOD_COMPLEX,
+	Common) ;
+    if (Common->status < CHOLMOD_OK)
+    {
+	/* out of memory */
+	return (NULL) ;
+    }
+    Cp = C->p ;
+    Ci = C->i ;
+    Cx = C->x ;
+
+    /* Cp = cumsum ([0 Wj]), and Wj = Cp [0..n-1] */
+    cnz = 0 ;
+    for (j = 0 ; j < n ; j++)
+    {
+	Cp [j] = cnz ;
+	cnz += Wj [j] ;
+	Wj [j] = Cp [j] ;
+    }
+    Cp [n] = cnz ;
+
+    /* ---------------------------------------------------------------------- */
+    /* C(i,j) = A(i,j), and C(j,i) = conj (A(i,j)) */
+    /* ---------------------------------------------------------------------- */
+
+    for (j = 0 ; j < n ; j++)
+    {
+	p = Ap [j] ;
+	pend = (apacked) ? (Ap [j+1]) : (p + Anz [j]) ;
+	for ( ; p < pend ; p++)
+	{
+	    i = Ai [p] ;
+	    if ((upper && i > j) || (lower && i < j)) continue ;
+	    q = Wj [j]++ ;
+	    Ci [q] = i ;
+	    Cx [2*q  ] = Ax [2*p  ] ;
+	    Cx [2*q+1] = Ax [2*p+1] ;
+	    if (i != j)
+	    {
+		q = Wj [i]++ ;
+		Ci [q] = j ;
+		Cx [2*q  ] =  Ax [2*p  ] ;
+		Cx [2*q+1] = -Ax [2*p+1] ;
+	    }
+	}
+    }
+    return (C) ;
+}
+
+/* ========================================================================== */
+/* === cholmod_spgemm_symbolic ============================================== */
+/* ========================================================================== */
+
+/* Computes the pattern of C = A*B.  If values is TRUE, and A and B are both
+ * real or both complex, then C has the same xtype as A, but its numerical
+ * values are not yet computed (use cholmod_spgemm_numeric).  Otherwise C is
+ * returned as a pattern-only matrix.  The pattern of C is the symbolic plan
+ * for computing A*B with cholmod_spgemm_numeric.
+ */
+
+cholmod_sparse *CHOLMOD(spgemm_symbolic)
+(
+    /* ---- input ---- */
+    cholmod_sparse *A,	/* left matrix to multiply */
+    cholmod_sparse *B,	/* right matrix to multiply */
+    int values,		/* if TRUE, allocate space for the values of C */
+    /* --------------- */
+    cholmod_common *Common
+)
+{
+    double flops ;
+    cholmod_sparse *C, *A2, *B2 ;
+    Int *Cp, *Ci, *Flops, *Iwork ;
+    Int nrow, ncol, j, cnz, hmax ;
+    size_t isize ;
+    int nthreads, xtype, ok = TRUE ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    RETURN_IF_NULL_COMMON (NULL) ;
+    RETURN_IF_NULL (A, NULL) ;
+    RETURN_IF_NULL (B, NULL) ;
+    RETURN_IF_XTYPE_INVALID (A, CHOLMOD_PATTERN, CHOLMOD_ZOMPLEX, NULL) ;
+    RETURN_IF_XTYPE_INVALID (B, CHOLMOD_PATTERN, CHOLMOD_ZOMPLEX, NULL) ;
+    if (A->ncol != B->nrow)
+    {
+	/* inner dimensions must agree */
+	ERROR (CHOLMOD_INVALID, "A and B inner dimensions must match") ;
+	return (NULL) ;
+    }
+    values = values &&
+	(A->xtype != CHOLMOD_PATTERN) && (B->xtype != CHOLMOD_PATTERN) ;
+    if (values && (A->xtype != B->xtype || A->xtype == CHOLMOD_ZOMPLEX))
+    {
+	ERROR (CHOLMOD_INVALID, "A and B must be both real or both complex") ;
+	return (NULL) ;
+    }
+    xtype = values ? A->xtype : CHOLMOD_PATTERN ;
+    Common->status = CHOLMOD_OK ;
+
+    /* ---------------------------------------------------------------------- */
+    /* convert A and B to unsymmetric, if necessary */
+    /* ---------------------------------------------------------------------- */
+
+    A2 = spgemm_unsym (A, FALSE, Common) ;
+    B2 = spgemm_unsym (B, FALSE, Common) ;
+    if (Common->status < CHOLMOD_OK)
+    {
+	/* out of memory */
+	CHOLMOD(free_sparse) (&A2, Common) ;
+	CHOLMOD(free_sparse) (&B2, Common) ;
+	return (NULL) ;
+    }
+    if (A2 != NULL) A = A2 ;
+    if (B2 != NULL) B = B2 ;
+
+    nrow = A->nrow ;
+    ncol = B->ncol ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate C->p and workspace */
+    /* ---------------------------------------------------------------------- */
+
+    Cp = CHOLMOD(malloc) (ncol+1, sizeof (Int), Common) ;
+    Flops = CHOLMOD(malloc) (ncol+1, sizeof (Int), Common) ;
+    if (Common->status < CHOLMOD_OK)
+    {
+	/* out of memory */
+	CHOLMOD(free) (ncol+1, sizeof (Int), Cp, Common) ;
+	CHOLMOD(free) (ncol+1, sizeof (Int), Flops, Common) ;
+	CHOLMOD(free_sparse) (&A2, Common) ;
+	CHOLMOD(free_sparse) (&B2, Common) ;
+	return (NULL) ;
+    }
+
+    flops = spgemm_flops (A, B, Flops, &hmax) ;
+    nthreads = spgemm_nthreads (flops, ncol, Common) ;
+
+    /* isize = nthreads * (nrow + hmax) for Mark and Hkey of each thread */
+    isize = CHOLMOD(mult_size_t) (nthreads,
+	CHOLMOD(add_size_t) (nrow, hmax, &ok), &ok) ;
+    if (!ok)
+    {
+	ERROR (CHOLMOD_TOO_LARGE, "problem too large") ;
+    }
+    Iwork = CHOLMOD(malloc) (isize, sizeof (Int), Common) ;
+    if (Common->status < CHOLMOD_OK)
+    {
+	/* out of memory */
+	CHOLMOD(free) (ncol+1, sizeof (Int), Cp, Common) ;
+	CHOLMOD(free) (ncol+1, sizeof (Int), Flops, Common) ;
+	CHOLMOD(free_sparse) (&A2, Common) ;
+	CHOLMOD(free_sparse) (&B2, Common) ;
+	return (NULL) ;
+    }
+    for (j = 0 ; j < (Int) isize ; j++)
+    {
+	Iwork [j] = EMPTY ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* count the entries in each column of C */
+    /* ---------------------------------------------------------------------- */
+
+    /* The stamp for the count phase of C(:,j) is 2*j, and 2*j+1 for the phase
+     * that finds its pattern, so Mark never needs to be cleared. */
+
+    #pragma omp parallel num_threads(nthreads) if (nthreads > 1)
+    {
+	int tid = SPGEMM_TID ;
+	Int *Mark = Iwork + ((size_t) tid) * (nrow + hmax) ;
+	Int *Hkey = Mark + nrow ;
+	Int jj ;
+	#pragma omp for schedule(dynamic, SPGEMM_CHUNK)
+	for (jj = 0 ; jj < ncol ; jj++)
+	{
+	    Cp [jj] = spgemm_pattern (jj, A, B, Flops [jj], 2*jj, Mark, Hkey,
+		NULL) ;
+	}
+    }
+
+    /* Cp = cumsum ([0 Cp]) */
+    cnz = 0 ;
+    for (j = 0 ; j < ncol ; j++)
+    {
+	Int t = Cp [j] ;
+	Cp [j] = cnz ;
+	cnz += t ;
+    }
+    Cp [ncol] = cnz ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate C and find its pattern */
+    /* ---------------------------------------------------------------------- */
+
+    C = CHOLMOD(allocate_sparse) (nrow, ncol, cnz, TRUE, TRUE, 0, xtype,
+	Common) ;
+    if (Common->status >= CHOLMOD_OK)
+    {
+	/* replace C->p with Cp */
+	CHOLMOD(free) (ncol+1, sizeof (Int), C->p, Common) ;
+	C->p = Cp ;
+	Cp = NULL ;
+	Ci = C->i ;
+
+	#pragma omp parallel num_threads(nthreads) if (nthreads > 1)
+	{
+	    int tid = SPGEMM_TID ;
+	    Int *Mark = Iwork + ((size_t) tid) * (nrow + hmax) ;
+	    Int *Hkey = Mark + nrow ;
+	    Int *CP = C->p ;
+	    Int jj ;
+	    #pragma omp for schedule(dynamic, SPGEMM_CHUNK)
+	    for (jj = 0 ; jj < ncol ; jj++)
+	    {
+		spgemm_pattern (jj, A, B, Flops [jj], 2*jj+1, Mark, Hkey,
+		    Ci + CP [jj]) ;
+	    }
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* free workspace and return the result */
+    /* ---------------------------------------------------------------------- */
+
+    CHOLMOD(free) (ncol+1, sizeof (Int), Cp, Common) ;
+    CHOLMOD(free) (ncol+1, sizeof (Int), Flops, Common) ;
+    CHOLMOD(free) (isize, sizeof (Int), Iwork, Common) ;
+    CHOLMOD(free_sparse) (&A2, Common) ;
+    CHOLMOD(free_sparse) (&B2, Common) ;
+    return (C) ;
+}
+
+
+/* ========================================================================== */
+/* === cholmod_spgemm_numeric =============================================== */
+/* ========================================================================== */
+
+/* Computes the numerical values of C = A*B.  C must have been returned by
+ * cholmod_spgemm_symbolic (A, B, TRUE, Common), for matrices A and B with the
+ * same xtype, dimensions and patterns as the A and B given here.  Only
+ * C->x is modified.
+ */
+
+int CHOLMOD(spgemm_numeric)
+(
+    /* ---- input ---- */
+    cholmod_sparse *A,	/* left matrix to multiply */
+    cholmod_sparse *B,	/* right matrix to multiply */
+    /* ---- in/out --- */
+    cholmod_sparse *C,	/* C = A*B, pattern from cholmod_spgemm_symbolic */
+    /* --------------- */
+    cholmod_common *Common
+)
+{
+    double flops ;
+    double *Xwork ;
+    cholmod_sparse *A2, *B2 ;
+    Int *Flops, *Hwork ;
+    Int nrow, ncol, hmax ;
+    size_t hsize, xsize ;
+    int nthreads, ok = TRUE ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    RETURN_IF_NULL_COMMON (FALSE) ;
+    RETURN_IF_NULL (A, FALSE) ;
+    RETURN_IF_NULL (B, FALSE) ;
+    RETURN_IF_NULL (C, FALSE) ;
+    RETURN_IF_XTYPE_INVALID (A, CHOLMOD_REAL, CHOLMOD_COMPLEX, FALSE) ;
+    RETURN_IF_XTYPE_INVALID (B, CHOLMOD_REAL, CHOLMOD_COMPLEX, FALSE) ;
+    RETURN_IF_XTYPE_INVALID (C, CHOLMOD_REAL, CHOLMOD_COMPLEX, FALSE) ;
+    if (A->xtype != B->xtype || A->xtype != C->xtype)
+    {
+	ERROR (CHOLMOD_INVALID, "A, B, and C must have the same xtype") ;
+	return (FALSE) ;
+    }
+    if (A->ncol != B->nrow || C->nrow != A->nrow || C->ncol != B->ncol
+	|| !(C->packed) || C->stype != 0)
+    {
+	ERROR (CHOLMOD_INVALID, "C invalid") ;
+	return (FALSE) ;
+    }
+    Common->status = CHOLMOD_OK ;
+
+    /* ---------------------------------------------------------------------- */
+    /* convert A and B to unsymmetric, if necessary */
+    /* ---------------------------------------------------------------------- */
+
+    A2 = spgemm_unsym (A, TRUE, Common) ;
+    B2 = spgemm_unsym (B, TRUE, Common) ;
+    if (Common->status < CHOLMOD_OK)
+    {
+	/* out of memory */
+	CHOLMOD(free_sparse) (&A2, Common) ;
+	CHOLMOD(free_sparse) (&B2, Common) ;
+	return (FALSE) ;
+    }
+    if (A2 != NULL) A = A2 ;
+    if (B2 != NULL) B = B2 ;
+
+    nrow = A->nrow ;
+    ncol = B->ncol ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate workspace */
+    /* ---------------------------------------------------------------------- */
+
+    Flops = CHOLMOD(malloc) (ncol+1, sizeof (Int), Common) ;
+    if (Common->status < CHOLMOD_OK)
+    {
+	/* out of memory */
+	CHOLMOD(free_sparse) (&A2, Common) ;
+	CHOLMOD(free_sparse) (&B2, Common) ;
+	return (FALSE) ;
+    }
+
+    flops = spgemm_flops (A, B, Flops, &hmax) ;
+    nthreads = spgemm_nthreads (flops, ncol, Common) ;
+
+    /* Hwork: Hkey and Hpos of size hmax, and Xwork: W of size nrow, for
+     * each thread */
+    hsize = CHOLMOD(mult_size_t) (nthreads, 2*hmax, &ok) ;
+    xsize = CHOLMOD(mult_size_t) (nthreads,
+	CHOLMOD(mult_size_t) (nrow, (A->xtype == CHOLMOD_COMPLEX) ? 2 : 1,
+	&ok), &ok) ;
+    xsize = MAX (xsize, 1) ;
+    if (!ok)
+    {
+	ERROR (CHOLMOD_TOO_LARGE, "problem too large") ;
+    }
+    Hwork = CHOLMOD(malloc) (hsize, sizeof (Int), Common) ;
+    Xwork = CHOLMOD(malloc) (xsize, sizeof (double), Common) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* compute the values of C */
+    /* ---------------------------------------------------------------------- */
+
+    if (Common->status >= CHOLMOD_OK)
+    {
+	switch (A->xtype)
+	{
+	    case CHOLMOD_REAL:
+		r_cholmod_spgemm_numeric (A, B, C, Flops, Hwork, Xwork, hmax,
+		    nthreads) ;
+		break ;
+
+	    case CHOLMOD_COMPLEX:
+		c_cholmod_spgemm_numeric (A, B, C, Flops, Hwork, Xwork, hmax,
+		    nthreads) ;
+		break ;
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* free workspace */
+    /* ---------------------------------------------------------------------- */
+
+    CHOLMOD(free) (ncol+1, sizeof (Int), Flops, Common) ;
+    CHOLMOD(free) (hsize, sizeof (Int), Hwork, Common) ;
+    CHOLMOD(free) (xsize, sizeof (double), Xwork, Common) ;
+    CHOLMOD(free_sparse) (&A2, Common) ;
+    CHOLMOD(free_sparse) (&B2, Common) ;
+    return (Common->status >= CHOLMOD_OK) ;
+}
+
+
+/* ========================================================================== */
+/* === cholmod_spgemm ======================================================= */
+/* ========================================================================== */
+
+/* C = A*B.  If values is FALSE, or if A or B are pattern-only, then only the
+ * pattern of C is computed. */
+
+cholmod_sparse *CHOLMOD(spgemm)
+(
+    /* ---- input ---- */
+    cholmod_sparse *A,	/* left matrix to multiply */
+    cholmod_sparse *B,	/* right matrix to multiply */
+    int values,		/* TRUE: do numerical values, FALSE: pattern only */
+    /* --------------- */
+    cholmod_common *Common
+)
+{
+    cholmod_sparse *C ;
+
+    C = CHOLMOD(spgemm_symbolic) (A, B, values, Common) ;
+    if (C != NULL && C->xtype != CHOLMOD_PATTERN)
+    {
+	if (!CHOLMOD(spgemm_numeric) (A, B, C, Common))
+	{
+	    /* out of memory */
+	    CHOLMOD(free_sparse) (&C, Common) ;
+	}
+    }
+    return (C) ;
+}
+#endif
+#endif
@@ -0,0 +1,155 @@
+/* ========================================================================== */
+/* === MatrixOps/t_cholmod_spgemm =========================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * CHOLMOD/MatrixOps Module.  Copyright (C) 2026, the CHOLMOD contributors.
+ * http://www.suitesparse.com
+ * -------------------------------------------------------------------------- */
+
+/* Template routine for the numeric phase of cholmod_spgemm.  Supports real or
+ * complex matrices. */
+
+#include "cholmod_template.h"
+
+/* Computes the numerical values of C = A*B, where the pattern of C has already
+ * been computed by cholmod_spgemm_symbolic.  The columns of C are split among
+ * the threads.  Each column uses either a dense accumulator W of size nrow,
+ * or, if it has few flops, a hash table that maps each row index of C(:,j) to
+ * its position in C.  Entries of A*B outside the pattern of C are ignored in
+ * the latter case.
+ */
+
+static void TEMPLATE (cholmod_spgemm_numeric)
+(
+    cholmod_sparse *A,	/* left matrix, unsymmetric */
+    cholmod_sparse *B,	/* right matrix, unsymmetric */
+    cholmod_sparse *C,	/* C = A*B, pattern computed on input */
+    Int *Flops,		/* size ncol, flops for each column, at most nrow */
+    Int *Hwork,		/* size nthreads*2*hmax */
+    double *Xwork,	/* size nthreads*nrow entries */
+    Int hmax,		/* size of the largest hash table */
+    int nthreads
+)
+{
+    double *Ax, *Bx, *Cx ;
+    Int *Ap, *Anz, *Ai, *Bp, *Bnz, *Bi, *Cp, *Ci ;
+    Int nrow, ncol ;
+    int apacked, bpacked ;
+
+    Ap  = A->p ;
+    Anz = A->nz ;
+    Ai  = A->i ;
+    Ax  = A->x ;
+    apacked = A->packed ;
+    Bp  = B->p ;
+    Bnz = B->nz ;
+    Bi  = B->i ;
+    Bx  = B->x ;
+    bpacked = B->packed ;
+    Cp  = C->p ;
+    Ci  = C->i ;
+    Cx  = C->x ;
+    nrow = C->nrow ;
+    ncol = C->ncol ;
+
+    #pragma omp parallel num_threads(nthreads) if (nthreads > 1)
+    {
+	double *W ;
+	Int *Hkey, *Hpos ;
+	Int j, i, t, p, pa, paend, pb, pbend, pc, pcend, h, hsize ;
+	int tid = SPGEMM_TID ;
+
+	W = Xwork + ((size_t) tid) * nrow * ENTRY_SIZE ;
+	Hkey = Hwork + ((size_t) tid) * 2 * hmax ;
+	Hpos = Hkey + hmax ;
+
+	#pragma omp for schedule(dynamic, SPGEMM_CHUNK)
+	for (j = 0 ; j < ncol ; j++)
+	{
+	    pc = Cp [j] ;
+	    pcend = Cp [j+1] ;
+	    pb = Bp [j] ;
+	    pbend = (bpacked) ? (Bp [j+1]) : (pb + Bnz [j]) ;
+
+	    if (SPGEMM_USE_HASH (Flops [j], nrow))
+	    {
+
+		/* ---------------------------------------------------------- */
+		/* C(:,j) with a hash accumulator */
+		/* ---------------------------------------------------------- */
+
+		/* place the row indices of C(:,j) in the hash table */
+		hsize = spgemm_hsize (Flops [j]) ;
+		ASSERT (hsize <= hmax) ;
+		for (h = 0 ; h < hsize ; h++)
+		{
+		    Hkey [h] = EMPTY ;
+		}
+		for (p = pc ; p < pcend ; p++)
+		{
+		    i = Ci [p] ;
+		    for (h = SPGEMM_HASH (i, hsize) ; Hkey [h] != EMPTY ;
+			h = (h+1) & (hsize-1)) ;
+		    Hkey [h] = i ;
+		    Hpos [h] = p ;
+		    CLEAR (Cx,-,p) ;
+		}
+
+		/* C(:,j) += A(:,t)*B(t,j) for each entry B(t,j) */
+		for ( ; pb < pbend ; pb++)
+		{
+		    t = Bi [pb] ;
+		    pa = Ap [t] ;
+		    paend = (apacked) ? (Ap [t+1]) : (pa + Anz [t]) ;
+		    for ( ; pa < paend ; pa++)
+		    {
+			i = Ai [pa] ;
+			for (h = SPGEMM_HASH (i, hsize) ;
+			    Hkey [h] != i && Hkey [h] != EMPTY ;
+			    h = (h+1) & (hsize-1)) ;
+			if (Hkey [h] == i)
+			{
+			    /* Cx [Hpos [h]] += Ax [pa] * Bx [pb] ; */
+			    MULTADD (Cx,-,Hpos [h], Ax,-,pa, Bx,-,pb) ;
+			}
+		    }
+		}
+
+	    }
+	    else
+	    {
+
+		/* ---------------------------------------------------------- */
+		/* C(:,j) with a dense accumulator */
+		/* ---------------------------------------------------------- */
+
+		for (p = pc ; p < pcend ; p++)
+		{
+		    CLEAR (W,-,Ci [p]) ;
+		}
+		for ( ; pb < pbend ; pb++)
+		{
+		    t = Bi [pb] ;
+		    pa = Ap [t] ;
+		    paend = (apacked) ? (Ap [t+1]) : (pa + Anz [t]) ;
+		    for ( ; pa < paend ; pa++)
+		    {
+			/* W [Ai [pa]] += Ax [pa] * Bx [pb] ; */
+			MULTADD (W,-,Ai [pa], Ax,-,pa, Bx,-,pb) ;
+		    }
+		}
+		for (p = pc ; p < pcend ; p++)
+		{
+		    /* Cx [p] = W [Ci [p]] ; */
+		    ASSIGN (Cx,-,p, W,-,Ci [p]) ;
+		}
+	    }
+	}
+    }
+}
+
+#undef PATTERN
+#undef REAL
+#undef COMPLEX
+#undef ZOMPLEX
@@ -31,6 +31,8 @@
  *	partition	compress and partition a graph
  *	clear_flag	clear Common->Flag, but do not modify negative entries
  *	find_components	find the connected components of a graph
+ *	nd_spawn	create tasks to bisect a set of subgraphs in parallel
+ *	nd_subgraph	bisect a subgraph, as an OpenMP task
  *
  * Supports any xtype (pattern, real, complex, or zomplex).
  */
@@ -40,6 +42,43 @@
 #include "cholmod_internal.h"
 #include "cholmod_partition.h"
 #include "cholmod_cholesky.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* by default, graphs with fewer nodes than this are ordered with one thread */
+#define ND_PARALLEL_MIN 4096
+
+/* ========================================================================== */
+/* === nd_bisector ========================================================== */
+/* ========================================================================== */
+
+/* Call cholmod_metis_bisector.  By default, METIS draws its random numbers
+ * from rand, whose state is shared by all threads, so the tasks of the
+ * parallel nested dissection (see nd_subgraph) call METIS one at a time.  If
+ * the METIS that comes with SuiteSparse is built with GKRAND (off by default)
+ * and thread-local storage, it keeps its random number generator and its
+ * memory core in thread-local storage, and the SuiteSparse CMake build then
+ * compiles CHOLMOD with -DCHOLMOD_METIS_THREADSAFE, so that the tasks can call
+ * METIS at the same time.  Each call to METIS reseeds the generator, so either
+ * way the partition does not depend on which task calls METIS first. */
+
+static SuiteSparse_long nd_bisector
+(
+    cholmod_sparse *C,
+    Int *Cnw,
+    Int *Cew,
+    Int *Part,
+    cholmod_common *Common
+)
+{
+    SuiteSparse_long csep ;
+#ifndef CHOLMOD_METIS_THREADSAFE
+    #pragma omp critical (cholmod_nesdis_metis)
+#endif
+    csep = CHOLMOD(metis_bisector) (C, Cnw, Cew, Part, Common) ;
+    return (csep) ;
+}
 
 /* ========================================================================== */
 /* === partition ============================================================ */
@@ -373,7 +412,7 @@ static SuiteSparse_long partition    /* size of separator or -1 if failure */
 	/* ------------------------------------------------------------------ */
 
 	/* FUTURE WORK: could call CHACO, SCOTCH, ... here too */
-	csep = CHOLMOD(metis_bisector) (C, Cnw, Cew, Part, Common) ;
+	csep = nd_bisector (C, Cnw, Cew, Part, Common) ;
 
     }
     else if (nodes_pruned == n-1)
@@ -486,7 +525,7 @@ static SuiteSparse_long partition    /* size of separator or -1 if failure */
 	/* ------------------------------------------------------------------ */
 
 	/* FUTURE WORK: could call CHACO, SCOTCH, ... here too */
-	csep = CHOLMOD(metis_bisector) (C, Cnw, Cew, Part, Common) ;
+	csep = nd_bisector (C, Cnw, Cew, Part, Common) ;
 
 	if (csep < 0)
 	{
@@ -680,6 +719,8 @@ static void find_components
     Int Cstack [ ],	    /* component stack for nested dissection */
     Int *top,		    /* Cstack [0..top] contains root nodes of the
 			     * the components currently in the stack */
+    Int Csize [ ],	    /* optional.  If present, Csize [k] is the number
+			     * of nodes in the component Cstack [k] */
 
     /* workspace, undefined on input and output: */
     Int Queue [ ],	    /* size n, for breadth-first search */
@@ -687,9 +728,10 @@ static void find_components
     cholmod_common *Common
 )
 {
-    Int n, mark, cj, j, sj, sn, p, i, snode, pstart, pdest, pend, nd_components,
+    Int mark, cj, j, sj, sn, p, i, snode, pstart, pdest, pend, nd_components,
 	part, first, save_mark ;
     Int *Bp, *Bi, *Flag ;
+    DEBUG (Int n) ;
 
     /* ---------------------------------------------------------------------- */
     /* get workspace */
@@ -708,7 +750,7 @@ static void find_components
 
     Bp = B->p ;
     Bi = B->i ;
-    n = B->nrow ;
+    DEBUG (n = B->nrow) ;
     ASSERT (cnode >= EMPTY && cnode < n) ;
     ASSERT (IMPLIES (cnode >= 0, Flag [cnode] < EMPTY)) ;
 
@@ -812,6 +854,10 @@ static void find_components
 		 * the separator tree. */
 		Cstack [++(*top)] =
 			(first || nd_components) ? FLIP (snode) : snode ;
+		if (Csize != NULL)
+		{
+		    Csize [*top] = sn ;
+		}
 		first = FALSE ;
 	    }
 	}
@@ -824,6 +870,424 @@ static void find_components
 }
 
 
+/* ========================================================================== */
+/* === nd_subgraph ========================================================== */
+/* ========================================================================== */
+
+/* When more than one thread is used, the subgraphs that nested dissection finds
+ * are bisected in parallel, each one by an OpenMP task.  Two subgraphs on the
+ * Cstack are never adjacent in B, since the separators that split them apart
+ * have already been ordered (and are thus dead).  A task can therefore work on
+ * its own subgraph C without locking: it modifies Flag, Imap, Bnz, Bnw,
+ * CParent, and the columns of B only for the nodes in C, and it only reads
+ * Flag for the dead nodes adjacent to C, which no other task modifies.  Each
+ * task uses its own copy of the cholmod_common object (for its own mark,
+ * memory usage statistics, and status) and its own workspace of size O(cn +
+ * nnz (C)), instead of the size-n workspace used by the sequential algorithm.
+ * The subgraph C, its partition, and how the nodes of C are compressed are the
+ * same as in the sequential algorithm, so the ordering does not depend on the
+ * number of threads.
+ *
+ * The memory usage statistics of each task are added to T when the task is
+ * done, and added to Common when all the tasks are done (see nd_tally).
+ *
+ * METIS must be thread-safe for the tasks to bisect their subgraphs at the
+ * same time.  Unless METIS is known to keep its random number generator in
+ * thread-local storage, the tasks call METIS one at a time (see nd_bisector).
+ */
+
+typedef struct
+{
+    cholmod_sparse *B ;	/* the graph to order; columns pruned by each task */
+    Int *Bnz ;		/* size n, # of entries in each column of B */
+    Int *Bnw ;		/* size n, node weights */
+    Int *CParent ;	/* size n, the separator tree */
+    Int *Imap ;		/* size n, Imap [j] = cj if node j is node cj of C */
+    Int nd_small ;	/* do not partition graphs smaller than this */
+    Int nd_compress ;	/* if TRUE, compress each subgraph */
+    double nd_oksep ;	/* discard separators larger than nd_oksep*cn */
+    cholmod_common *Common ;	/* copied by each task; not modified */
+    int status ;	/* CHOLMOD_OK, or the status of the first task to fail */
+
+    /* memory usage statistics of the tasks, relative to Common */
+    size_t malloc_count ;	/* sum of the changes in malloc_count */
+    size_t memory_inuse ;	/* sum of the changes in memory_inuse */
+    size_t memory_live ;	/* memory held by the tasks now running */
+    size_t memory_peak ;	/* estimate of the peak of memory_live */
+
+} nd_tasks ;
+
+/* A task adds the memory it holds while it partitions its subgraph (its
+ * workspace and the subgraph C) to T->memory_live.  When the task is done, its
+ * own peak plus the memory held by the other tasks then running is an estimate
+ * of the peak memory usage of all the tasks.  Memory allocated by one task can
+ * be freed by another (the Group arrays), so only the sums of the changes in
+ * malloc_count and memory_inuse are exact.  All changes are computed modulo
+ * 2^(8*sizeof(size_t)), so their sums are correct even if some are negative.
+ * Cm->memory_usage is reset to Cm->memory_inuse when the task starts. */
+
+static void nd_hold (cholmod_common *Cm, nd_tasks *T, size_t *held)
+{
+    *held = Cm->memory_inuse - T->Common->memory_inuse ;
+#pragma omp critical (cholmod_nesdis_status)
+    {
+	T->memory_live += *held ;
+    }
+}
+
+static void nd_tally (cholmod_common *Cm, nd_tasks *T, size_t held)
+{
+    cholmod_common *Common = T->Common ;
+#pragma omp critical (cholmod_nesdis_status)
+    {
+	T->memory_live -= held ;
+	T->memory_peak = MAX (T->memory_peak,
+	    T->memory_live + (Cm->memory_usage - Common->memory_inuse)) ;
+	T->malloc_count += Cm->malloc_count - Common->malloc_count ;
+	T->memory_inuse += Cm->memory_inuse - Common->memory_inuse ;
+    }
+}
+
+/* When all the tasks are done, add their memory usage statistics to Common */
+
+static void nd_merge (nd_tasks *T, cholmod_common *Common)
+{
+    Common->malloc_count += T->malloc_count ;
+    Common->memory_usage = MAX (Common->memory_usage,
+	Common->memory_inuse + T->memory_peak) ;
+    Common->memory_inuse += T->memory_inuse ;
+    Common->memory_usage = MAX (Common->memory_usage, Common->memory_inuse) ;
+}
+
+static void nd_subgraph (Int *Group, Int ng, Int cn, nd_tasks *T) ;
+
+/* Pop all groups of components from Stack [0..top], and create a task to
+ * bisect each one.  A group is a set of components with the same parent in
+ * the separator tree; it is treated as a single graph C, just as in the
+ * sequential algorithm.  The repnodes of a group are copied into a new
+ * array (which nd_subgraph frees), so Stack and Size can be reused as soon as
+ * this function returns.  Graphs smaller than nd_small are not worth a
+ * task of their own, and are ordered right away. */
+
+static void nd_spawn
+(
+    Int Stack [ ],	/* Stack [0..top] holds the repnodes of the groups */
+    Int Size [ ],	/* Size [k] = # of nodes in the component Stack [k] */
+    Int top,
+    nd_tasks *T,
+    cholmod_common *Common	/* for allocating the groups */
+)
+{
+    Int *Group ;
+    Int g, ng, cn, i ;
+
+    while (top >= 0)
+    {
+	/* find the size of the group at the top of the stack */
+	ng = 0 ;
+	cn = 0 ;
+	for (g = top ; g >= 0 ; g--)
+	{
+	    ng++ ;
+	    cn += Size [g] ;
+	    if (Stack [g] < 0) break ;
+	}
+	ASSERT (g >= 0) ;
+
+	Group = CHOLMOD(malloc) (ng, sizeof (Int), Common) ;
+	if (Common->status < CHOLMOD_OK)
+	{
+#pragma omp critical (cholmod_nesdis_status)
+	    {
+		if (T->status == CHOLMOD_OK) T->status = Common->status ;
+	    }
+	    return ;
+	}
+
+	/* the repnodes of the group, in the order they are popped */
+	for (g = 0 ; g < ng ; g++)
+	{
+	    i = Stack [top--] ;
+	    Group [g] = (i < 0) ? FLIP (i) : i ;
+	}
+
+	#pragma omp task firstprivate (Group, ng, cn, T) if (cn >= T->nd_small)
+	nd_subgraph (Group, ng, cn, T) ;
+    }
+}
+
+/* Bisect the graph C that consists of the group of components with repnodes
+ * Group [0..ng-1], and cn nodes in all, order its separator, and create tasks
+ * for the components that remain.  This is the body of the while loop in
+ * cholmod_nested_dissection.  The Group array is freed. */
+
+static void nd_subgraph
+(
+    Int *Group,		/* size ng, repnodes of the group, in popped order */
+    Int ng,
+    Int cn,		/* number of nodes in C */
+    nd_tasks *T
+)
+{
+    cholmod_common Cm ;
+    cholmod_sparse *B, *C = NULL ;
+    Int *Bp, *Bi, *Bnz, *Bnw, *CParent, *Imap, *Flag, *Work, *Map, *Hash, *Cnw,
+	*Part, *Cmap, *Queue, *Lstack, *Lsize, *Cp, *Ci, *Cew = NULL ;
+    unsigned Int hash ;
+    Int i, j, g, p, cj, ci, cnode, mark, pstart, pdest, pend, cnz, csize = 0,
+	total_weight, sepsize, parent, top ;
+    size_t held = 0 ;
+    int status ;
+
+    /* ---------------------------------------------------------------------- */
+    /* get a private copy of Common, and workspace */
+    /* ---------------------------------------------------------------------- */
+
+    Cm = *(T->Common) ;
+    Cm.status = CHOLMOD_OK ;
+    Cm.memory_usage = Cm.memory_inuse ;
+
+#pragma omp critical (cholmod_nesdis_status)
+    {
+	status = T->status ;
+    }
+    Work = (status == CHOLMOD_OK) ?
+	CHOLMOD(malloc) (cn, 8*sizeof (Int), &Cm) : NULL ;
+    if (Work == NULL)
+    {
+	/* out of memory, or another task has already failed */
+	CHOLMOD(free) (ng, sizeof (Int), Group, &Cm) ;
+	if (status == CHOLMOD_OK)
+	{
+#pragma omp critical (cholmod_nesdis_status)
+	    {
+		if (T->status == CHOLMOD_OK) T->status = Cm.status ;
+	    }
+	}
+	nd_tally (&Cm, T, 0) ;
+	return ;
+    }
+    Map    = Work ;		/* size cn */
+    Hash   = Work + cn ;	/* size cn */
+    Cnw    = Work + 2*cn ;	/* size cn */
+    Part   = Work + 3*cn ;	/* size cn */
+    Cmap   = Work + 4*cn ;	/* size cn */
+    Queue  = Work + 5*cn ;	/* size cn */
+    Lstack = Work + 6*cn ;	/* size cn */
+    Lsize  = Work + 7*cn ;	/* size cn */
+
+    B = T->B ;
+    Bp = B->p ;
+    Bi = B->i ;
+    Bnz = T->Bnz ;
+    Bnw = T->Bnw ;
+    CParent = T->CParent ;
+    Imap = T->Imap ;
+    Flag = Cm.Flag ;
+
+    /* ---------------------------------------------------------------------- */
+    /* find the nodes of C */
+    /* ---------------------------------------------------------------------- */
+
+    /* The nodes of C have Flag [j] == 0, from find_components.  Node j is
+     * placed in C when Flag [j] is set to mark. */
+    mark = 1 ;
+    Cm.mark = mark ;
+
+    for (g = 0 ; g < ng ; g++)
+    {
+	i = Group [g] ;
+	ASSERT (Flag [i] >= EMPTY && Flag [i] < mark) ;
+	Map [g] = i ;
+	Flag [i] = mark ;
+	Imap [i] = g ;
+    }
+    cnode = Group [ng-1] ;
+    CHOLMOD(free) (ng, sizeof (Int), Group, &Cm) ;
+
+    /* breadth-first search from the repnodes, pruning dead edges from B */
+    cnz = 0 ;
+    total_weight = 0 ;
+    for (cj = 0, g = ng ; cj < g ; cj++)
+    {
+	j = Map [cj] ;
+	total_weight += Bnw [j] ;
+	pstart = Bp [j] ;
+	pdest = pstart ;
+	pend = pstart + Bnz [j] ;
+	for (p = pstart ; p < pend ; p++)
+	{
+	    i = Bi [p] ;
+	    if (i != j && Flag [i] >= EMPTY)
+	    {
+		Bi [pdest++] = i ;
+		if (Flag [i] != mark)
+		{
+		    ASSERT (g < cn) ;
+		    Map [g] = i ;
+		    Flag [i] = mark ;
+		    Imap [i] = g ;
+		    g++ ;
+		}
+	    }
+	}
+	Bnz [j] = pdest - pstart ;
+	cnz += Bnz [j] ;
+    }
+    ASSERT (g == cn) ;
+
+    PRINT0 (("consider cn %d nd_small %d ", cn, T->nd_small)) ;
+    if (cn < T->nd_small)
+    {
+	/* place all nodes in the separator */
+	PRINT0 ((" too small\n")) ;
+	sepsize = total_weight ;
+    }
+    else
+    {
+
+	/* ------------------------------------------------------------------ */
+	/* create the subgraph C */
+	/* ------------------------------------------------------------------ */
+
+	PRINT0 ((" cut\n")) ;
+	csize = MAX (cn, cnz) ;
+	C = CHOLMOD(allocate_sparse) (cn, cn, csize, FALSE, TRUE, 0,
+		CHOLMOD_PATTERN, &Cm) ;
+	Cew = CHOLMOD(malloc) (csize, sizeof (Int), &Cm) ;
+	nd_hold (&Cm, T, &held) ;
+	if (Cm.status < CHOLMOD_OK)
+	{
+	    sepsize = EMPTY ;
+	}
+	else
+	{
+	    Cp = C->p ;
+	    Ci = C->i ;
+	    for (p = 0 ; p < csize ; p++)
+	    {
+		Cew [p] = 1 ;
+	    }
+	    cnz = 0 ;
+	    for (cj = 0 ; cj < cn ; cj++)
+	    {
+		j = Map [cj] ;
+		Cp [cj] = cnz ;
+		Cnw [cj] = Bnw [j] ;
+		pstart = Bp [j] ;
+		pend = pstart + Bnz [j] ;
+		hash = cj ;
+		for (p = pstart ; p < pend ; p++)
+		{
+		    ci = Imap [Bi [p]] ;
+		    ASSERT (ci >= 0 && ci < cn && ci != cj) ;
+		    Ci [cnz++] = ci ;
+		    hash += ci ;
+		}
+		hash %= csize ;
+		Hash [cj] = (Int) hash ;
+	    }
+	    Cp [cn] = cnz ;
+
+	    /* -------------------------------------------------------------- */
+	    /* compress and partition the graph C */
+	    /* -------------------------------------------------------------- */
+
+	    sepsize = partition (
+#ifndef NDEBUG
+		    csize,
+#endif
+		    T->nd_compress, Hash, C, Cnw, Cew, Cmap, Part, &Cm) ;
+	}
+
+	if (C != NULL)
+	{
+	    C->ncol = cn ;	/* restore size for memory usage statistics */
+	}
+	CHOLMOD(free_sparse) (&C, &Cm) ;
+	CHOLMOD(free) (csize, sizeof (Int), Cew, &Cm) ;
+
+	if (sepsize < 0)
+	{
+	    /* failed */
+	    CHOLMOD(free) (cn, 8*sizeof (Int), Work, &Cm) ;
+#pragma omp critical (cholmod_nesdis_status)
+	    {
+		if (T->status == CHOLMOD_OK)
+		{
+		    T->status = (Cm.status < CHOLMOD_OK) ? Cm.status :
+			CHOLMOD_OUT_OF_MEMORY ;
+		}
+	    }
+	    nd_tally (&Cm, T, held) ;
+	    return ;
+	}
+
+	/* ------------------------------------------------------------------ */
+	/* compress B based on how C was compressed */
+	/* ------------------------------------------------------------------ */
+
+	for (ci = 0 ; ci < cn ; ci++)
+	{
+	    if (Hash [ci] < EMPTY)
+	    {
+		/* node i = Map [ci] absorbed into node j = Map [cj] */
+		cj = FLIP (Hash [ci]) ;
+		i = Map [ci] ;
+		j = Map [cj] ;
+		Bnw [i] = 0 ;
+		Bnw [j] = Cnw [cj] ;
+		Flag [i] = FLIP (j) ;
+	    }
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* order the separator, and create tasks for the components of C */
+    /* ---------------------------------------------------------------------- */
+
+    if (sepsize == total_weight || sepsize == 0 ||
+	sepsize > T->nd_oksep * total_weight)
+    {
+	/* C becomes a leaf of the separator tree */
+	for (cj = 0 ; cj < cn ; cj++)
+	{
+	    Flag [Map [cj]] = FLIP (cnode) ;
+	}
+    }
+    else
+    {
+	/* order the separator, with a new repnode cnode */
+	parent = CParent [cnode] ;
+	CParent [cnode] = -2 ;
+	cnode = EMPTY ;
+	for (cj = 0 ; cj < cn ; cj++)
+	{
+	    if (Part [cj] == 2)
+	    {
+		j = Map [cj] ;
+		if (cnode == EMPTY)
+		{
+		    cnode = j ;
+		}
+		Flag [j] = FLIP (cnode) ;
+	    }
+	}
+	ASSERT (cnode != EMPTY && CParent [cnode] == -2) ;
+	CParent [cnode] = parent ;
+
+	/* find the components of C that remain, and bisect them */
+	top = EMPTY ;
+	find_components (B, Map, cn, cnode, Part, Bnz, CParent, Lstack, &top,
+		Lsize, Queue, &Cm) ;
+	nd_spawn (Lstack, Lsize, top, T, &Cm) ;
+    }
+
+    CHOLMOD(free) (cn, 8*sizeof (Int), Work, &Cm) ;
+    nd_tally (&Cm, T, held) ;
+}
+
+
 /* ========================================================================== */
 /* === cholmod_bisect ======================================================= */
 /* ========================================================================== */
@@ -1027,6 +1491,10 @@ SuiteSparse_long CHOLMOD(bisect)	/* returns # of nodes in separator */
  * This function also returns a postorderd separator tree (CParent), and a
  * mapping of nodes in the graph to nodes in the separator tree (Cmember).
  *
+ * If more than one thread is used (see Common->nd_nthreads), the subgraphs
+ * are bisected in parallel (see nd_subgraph above), but the final constrained minimum degree ordering of
+ * the whole graph is still done just once.
+ *
  * workspace: Flag (nrow), Head (nrow+1), Iwork (4*nrow + (ncol if unsymmetric))
  *	Allocates a temporary matrix B=A*A' or B=A,
  *	and O(nnz(A)) temporary memory space.
@@ -1054,13 +1522,15 @@ SuiteSparse_long CHOLMOD(nested_dissection)
     double prune_dense, nd_oksep ;
     Int *Bp, *Bi, *Bnz, *Cstack, *Imap, *Map, *Flag, *Head, *Next, *Bnw, *Iwork,
 	*Ipost, *NewParent, *Hash, *Cmap, *Cp, *Ci, *Cew, *Cnw, *Part, *Post,
-	*Work3n ;
+	*Work3n, *Csize ;
     unsigned Int hash ;
     Int n, bnz, top, i, j, k, cnode, cdense, p, cj, cn, ci, cnz, mark, c, uncol,
 	sepsize, parent, ncomponents, threshold, ndense, pstart, pdest, pend,
 	nd_compress, nd_camd, csize, jnext, nd_small, total_weight,
-	nchild, child = EMPTY ;
+	nchild, nthreads, child = EMPTY ;
     cholmod_sparse *B, *C ;
+    cholmod_common Cm ;
+    nd_tasks nd ;
     size_t s ;
     int ok = TRUE ;
     DEBUG (Int cnt) ;
@@ -1100,6 +1570,14 @@ SuiteSparse_long CHOLMOD(nested_dissection)
     nd_camd = Common->method [Common->current].nd_camd ;
     nd_small = Common->method [Common->current].nd_small ;
     nd_small = MAX (4, nd_small) ;
+    nthreads = 1 ;
+#ifdef _OPENMP
+    nthreads = Common->nd_nthreads ;
+    if (nthreads <= 0)
+    {
+	nthreads = (n < ND_PARALLEL_MIN) ? 1 : omp_get_max_threads ( ) ;
+    }
+#endif
 
     PRINT0 (("nd_components %d nd_small %d nd_oksep %g\n", 
 	Common->method [Common->current].nd_components,
@@ -1146,6 +1624,7 @@ SuiteSparse_long CHOLMOD(nested_dissection)
 
     Cstack = Perm ;		/* size n, use Perm as workspace for Cstack [ */
     Cmap = Cmember ;		/* size n, use Cmember as workspace [ */
+    Csize = Cmember ;		/* size n, Cmember also holds Csize if parallel */
 
     if (Common->status < CHOLMOD_OK)
     {
@@ -1255,10 +1734,18 @@ SuiteSparse_long CHOLMOD(nested_dissection)
 	return (1) ;
     }
 
-    /* Cp and Ci are workspace to construct the subgraphs to partition */
-    C = CHOLMOD(allocate_sparse) (n, n, csize, FALSE, TRUE, 0, CHOLMOD_PATTERN,
-	    Common) ;
-    Cew  = CHOLMOD(malloc) (csize, sizeof (Int), Common) ;
+    /* Cp and Ci are workspace to construct the subgraphs to partition.  They
+     * are not needed if each task constructs its own subgraph. */
+    C = NULL ;
+    Cp = NULL ;
+    Ci = NULL ;
+    Cew = NULL ;
+    if (nthreads <= 1)
+    {
+	C = CHOLMOD(allocate_sparse) (n, n, csize, FALSE, TRUE, 0,
+		CHOLMOD_PATTERN, Common) ;
+	Cew  = CHOLMOD(malloc) (csize, sizeof (Int), Common) ;
+    }
 
     if (Common->status < CHOLMOD_OK)
     {
@@ -1273,28 +1760,77 @@ SuiteSparse_long CHOLMOD(nested_dissection)
 	return (EMPTY) ;
     }
 
-    Cp = C->p ;
-    Ci = C->i ;
-
     /* create initial unit node and edge weights */
     for (j = 0 ; j < n ; j++)
     {
 	Bnw [j] = 1 ;
     }
-    for (p = 0 ; p < csize ; p++)
+    if (nthreads <= 1)
     {
-	Cew [p] = 1 ;
+	Cp = C->p ;
+	Ci = C->i ;
+	for (p = 0 ; p < csize ; p++)
+	{
+	    Cew [p] = 1 ;
+	}
     }
 
     /* push the initial connnected components of B onto the Cstack */
     top = EMPTY ;	/* Cstack is empty */
     /* workspace: Flag (nrow), Iwork (nrow); use Imap as workspace for Queue [*/
     find_components (B, NULL, n, cnode, NULL,
-	    Bnz, CParent, Cstack, &top, Imap, Common) ;
+	    Bnz, CParent, Cstack, &top, (nthreads > 1) ? Csize : NULL, Imap,
+	    Common) ;
     /* done using Imap as workspace for Queue ] */
 
     /* Nodes can now be of Type 0, 1, 2, or 4 (see definition below) */
 
+    /* ---------------------------------------------------------------------- */
+    /* bisect the components in parallel, if requested */
+    /* ---------------------------------------------------------------------- */
+
+    if (nthreads > 1)
+    {
+	nd.B = B ;
+	nd.Bnz = Bnz ;
+	nd.Bnw = Bnw ;
+	nd.CParent = CParent ;
+	nd.Imap = Imap ;
+	nd.nd_small = nd_small ;
+	nd.nd_compress = nd_compress ;
+	nd.nd_oksep = nd_oksep ;
+	nd.Common = Common ;
+	nd.status = CHOLMOD_OK ;
+	nd.malloc_count = 0 ;
+	nd.memory_inuse = 0 ;
+	nd.memory_live = 0 ;
+	nd.memory_peak = 0 ;
+	Cm = *Common ;
+	Cm.memory_usage = Cm.memory_inuse ;
+
+	/* each task bisects one subgraph and creates tasks for its parts;
+	 * all of them are done at the end of the parallel region */
+	#pragma omp parallel num_threads(nthreads)
+	#pragma omp single
+	nd_spawn (Cstack, Csize, top, &nd, &Cm) ;
+	top = EMPTY ;
+
+	/* the groups of the first tasks were allocated with Cm */
+	nd_tally (&Cm, &nd, 0) ;
+	nd_merge (&nd, Common) ;
+
+	if (nd.status < CHOLMOD_OK)
+	{
+	    /* failed */
+	    Common->status = nd.status ;
+	    CHOLMOD(free_sparse) (&B, Common) ;
+	    CHOLMOD(free) (3*n, sizeof (Int), Work3n, Common) ;
+	    Common->mark = EMPTY ;
+	    CHOLMOD_CLEAR_FLAG (Common) ;
+	    return (EMPTY) ;
+	}
+    }
+
     /* ---------------------------------------------------------------------- */
     /* while Cstack is not empty, do: */
     /* ---------------------------------------------------------------------- */
@@ -1605,7 +2141,7 @@ SuiteSparse_long CHOLMOD(nested_dissection)
 	     * them on the Cstack.  Use Imap as workspace for Queue. [ */
 	    /* workspace: Flag (nrow) */
 	    find_components (B, Map, cn, cnode, Part, Bnz,
-		    CParent, Cstack, &top, Imap, Common) ;
+		    CParent, Cstack, &top, NULL, Imap, Common) ;
 	    /* done using Imap as workspace for Queue ] */
 	}
 	/* contents of Map [0..cn-1] no longer needed ] */
@@ -1688,7 +2224,10 @@ SuiteSparse_long CHOLMOD(nested_dissection)
     /* free workspace */
     /* ---------------------------------------------------------------------- */
 
-    C->ncol = n ;   /* restore size for memory usage statistics */
+    if (C != NULL)
+    {
+	C->ncol = n ;   /* restore size for memory usage statistics */
+    }
     CHOLMOD(free_sparse) (&C, Common) ;
     CHOLMOD(free_sparse) (&B, Common) ;
     CHOLMOD(free) (csize, sizeof (Int), Cew, Common) ;
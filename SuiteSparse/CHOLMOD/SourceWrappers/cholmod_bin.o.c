@@ -0,0 +1 @@
+#include <../Check/cholmod_bin.c>
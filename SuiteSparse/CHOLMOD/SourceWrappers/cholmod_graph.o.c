@@ -0,0 +1 @@
+#include <../Check/cholmod_graph.c>
@@ -0,0 +1,2 @@
+#define DLONG
+#include <../Check/cholmod_bin.c>
@@ -0,0 +1,2 @@
+#define DLONG
+#include <../MatrixOps/cholmod_spgemm.c>
@@ -0,0 +1,2 @@
+#define DLONG
+#include <../Supernodal/cholmod_super_sparseinv.c>
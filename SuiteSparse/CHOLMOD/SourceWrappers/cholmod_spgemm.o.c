@@ -0,0 +1 @@
+#include <../MatrixOps/cholmod_spgemm.c>
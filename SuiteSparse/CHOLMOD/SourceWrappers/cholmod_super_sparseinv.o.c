@@ -0,0 +1 @@
+#include <../Supernodal/cholmod_super_sparseinv.c>
@@ -0,0 +1,337 @@
+/* ========================================================================== */
+/* === Supernodal/cholmod_super_sparseinv =================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * CHOLMOD/Supernodal Module.  Copyright (C) 2026, the CHOLMOD contributors.
+ * http://www.suitesparse.com
+ * -------------------------------------------------------------------------- */
+
+/* Sparse inverse subset (selected inversion) of a supernodal factorization.
+ * Given LL' = P*A*P', this routine computes the entries of Z = inv(P*A*P')
+ * that lie in the pattern of L, using Takahashi's equations.  In particular,
+ * diag (inv (A)) is Z(k,k) for the row and column Perm [k] of A.
+ *
+ * Each supernode is done with dense matrix operations (BLAS dtrsm, dsyrk, and
+ * dgemm), in the reverse order of the supernodal factorization (the root of
+ * the supernodal elimination tree first).  With OpenMP, independent subtrees
+ * of the tree are done in parallel.  The total work is about twice the work
+ * of the supernodal numeric factorization.  The MATLAB_Tools/sparseinv
+ * package does the same thing, but with scalar gather/scatter operations on
+ * a simplicial factor.
+ */
+
+#ifndef NGPL
+#ifndef NSUPERNODAL
+
+#include "cholmod_internal.h"
+#include "cholmod_supernodal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#define SPARSEINV_TID omp_get_thread_num ( )
+#else
+#define SPARSEINV_TID 0
+#endif
+
+/* a subtree with at least this much work (roughly, the flop count) is
+ * done as its own OpenMP task */
+#define SPARSEINV_TASK_WORK 1e5
+
+/* the factor L, the output Z, and the workspace shared by all the tasks */
+typedef struct sparseinv_info_struct
+{
+    cholmod_factor *L ;	    /* supernodal numeric factor */
+    Int *Zp ;		    /* column pointers of Z */
+    double *Zx ;	    /* numerical values of Z */
+    Int *SuperMap ;	    /* size n, SuperMap [j] = s if column j is in s */
+    Int *Head ;		    /* size nsuper+1, first child of each supernode,
+			     * Head [nsuper] is the first root */
+    Int *Next ;		    /* size nsuper, next sibling of each supernode */
+    double *Work ;	    /* size nsuper, work in the subtree rooted at s */
+    Int *Map ;		    /* size nthreads*n */
+    Int *Stack ;	    /* size nthreads*nsuper */
+    double *Xwork ;	    /* size nthreads*wsize entries */
+    size_t wsize ;	    /* size of the dense workspace of each thread */
+    Int nsuper ;	    /* number of supernodes */
+    cholmod_common *Common ;
+} sparseinv_info ;
+
+/* ========================================================================== */
+/* === TEMPLATE ============================================================= */
+/* ========================================================================== */
+
+#define REAL
+#include "t_cholmod_super_sparseinv.c"
+#define COMPLEX
+#include "t_cholmod_super_sparseinv.c"
+
+/* ========================================================================== */
+/* === cholmod_super_sparseinv ============================================== */
+/* ========================================================================== */
+
+/* Returns Z, an n-by-n symmetric (Hermitian if complex) sparse matrix with
+ * Z->stype = -1.  Its lower triangular part has the same pattern as L
+ * (including the explicit zeros in the supernodes), and holds the
+ * corresponding entries of inv(L*L').  Z has the xtype of L (real or
+ * complex), and its columns are sorted.  L is not modified.  If L->minor < n
+ * (the matrix was not positive definite), an error is returned.
+ *
+ * Up to Common->sparseinv_nthreads OpenMP threads are used (or the OpenMP
+ * default if <= 0).  The result does not depend on the number of threads.
+ *
+ * workspace: none in Common.  O(n + nsuper) integers, plus O((r+c)^2) entries
+ *	for each thread, where r = L->maxesize and c is the largest number of
+ *	columns in any supernode, are allocated here.
+ */
+
+cholmod_sparse *CHOLMOD(super_sparseinv)
+(
+    /* ---- input ---- */
+    cholmod_factor *L,	/* supernodal numeric factor, LL'=P*A*P' */
+    /* --------------- */
+    cholmod_common *Common
+)
+{
+    sparseinv_info info, *S = &info ;
+    cholmod_sparse *Z ;
+    double *Work ;
+    Int *Lpi, *Ls, *Super, *Zp, *Zi, *SuperMap, *Head, *Next, *Iwork ;
+    Int n, nsuper, s, k1, k2, nscol, nsrow, nsrow2, psi, maxcol, maxrow2, j,
+	p, pp, parent, znz ;
+    size_t wsize, xsize, isize ;
+    int nthreads, ok = TRUE ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    RETURN_IF_NULL_COMMON (NULL) ;
+    RETURN_IF_NULL (L, NULL) ;
+    RETURN_IF_XTYPE_INVALID (L, CHOLMOD_REAL, CHOLMOD_COMPLEX, NULL) ;
+    if (!(L->is_ll) || !(L->is_super))
+    {
+	ERROR (CHOLMOD_INVALID, "L not supernodal") ;
+	return (NULL) ;
+    }
+    if (L->minor < L->n)
+    {
+	ERROR (CHOLMOD_INVALID, "L not positive definite") ;
+	return (NULL) ;
+    }
+    Common->status = CHOLMOD_OK ;
+    Common->blas_ok = TRUE ;
+
+    /* ---------------------------------------------------------------------- */
+    /* get inputs */
+    /* ---------------------------------------------------------------------- */
+
+    n = L->n ;
+    nsuper = L->nsuper ;
+    Lpi = L->pi ;
+    Ls = L->s ;
+    Super = L->super ;
+
+    /* ---------------------------------------------------------------------- */
+    /* find the size of Z and of the largest supernode */
+    /* ---------------------------------------------------------------------- */
+
+    znz = 0 ;
+    maxcol = 0 ;
+    maxrow2 = 0 ;
+    for (s = 0 ; s < nsuper ; s++)
+    {
+	nscol = Super [s+1] - Super [s] ;
+	nsrow = Lpi [s+1] - Lpi [s] ;
+	znz += nscol * nsrow - (nscol * (nscol-1)) / 2 ;
+	maxcol = MAX (maxcol, nscol) ;
+	maxrow2 = MAX (maxrow2, nsrow - nscol) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* determine the number of threads */
+    /* ---------------------------------------------------------------------- */
+
+    nthreads = 1 ;
+#ifdef _OPENMP
+    nthreads = Common->sparseinv_nthreads ;
+    if (nthreads <= 0)
+    {
+	nthreads = omp_get_max_threads ( ) ;
+    }
+#endif
+    nthreads = MAX (1, MIN (nthreads, nsuper)) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate workspace and the result */
+    /* ---------------------------------------------------------------------- */
+
+    /* wsize = maxrow2^2 + 2*maxrow2*maxcol + 2*maxcol^2, for Z22, U, Z21, T,
+     * and Z11 */
+    wsize = CHOLMOD(mult_size_t) (maxrow2, maxrow2, &ok) ;
+    wsize = CHOLMOD(add_size_t) (wsize,
+	CHOLMOD(mult_size_t) (maxrow2, 2*maxcol, &ok), &ok) ;
+    wsize = CHOLMOD(add_size_t) (wsize,
+	CHOLMOD(mult_size_t) (maxcol, 2*maxcol, &ok), &ok) ;
+    xsize = CHOLMOD(mult_size_t) (wsize, nthreads, &ok) ;
+    xsize = CHOLMOD(mult_size_t) (xsize,
+	(L->xtype == CHOLMOD_COMPLEX) ? 2 : 1, &ok) ;
+
+    /* isize = n + (nsuper+1) + nsuper + nthreads*(n+nsuper) */
+    isize = CHOLMOD(add_size_t) (n, 2*nsuper+1, &ok) ;
+    isize = CHOLMOD(add_size_t) (isize,
+	CHOLMOD(mult_size_t) (n+nsuper, nthreads, &ok), &ok) ;
+    if (!ok)
+    {
+	ERROR (CHOLMOD_TOO_LARGE, "problem too large") ;
+	return (NULL) ;
+    }
+
+    Z = CHOLMOD(allocate_sparse) (n, n, znz, TRUE, TRUE, -1, L->xtype, Common) ;
+    Iwork = CHOLMOD(malloc) (isize, sizeof (Int), Common) ;
+    Work = CHOLMOD(malloc) (nsuper, sizeof (double), Common) ;
+    S->Xwork = CHOLMOD(malloc) (MAX (xsize, 1), sizeof (double), Common) ;
+    if (Common->status < CHOLMOD_OK)
+    {
+	/* out of memory */
+	CHOLMOD(free_sparse) (&Z, Common) ;
+	CHOLMOD(free) (isize, sizeof (Int), Iwork, Common) ;
+	CHOLMOD(free) (nsuper, sizeof (double), Work, Common) ;
+	CHOLMOD(free) (MAX (xsize, 1), sizeof (double), S->Xwork, Common) ;
+	return (NULL) ;
+    }
+
+    SuperMap = Iwork ;			/* size n */
+    Head = SuperMap + n ;		/* size nsuper+1 */
+    Next = Head + nsuper + 1 ;		/* size nsuper */
+    S->Map = Next + nsuper ;		/* size nthreads*n */
+    S->Stack = S->Map + ((size_t) nthreads) * n ;   /* size nthreads*nsuper */
+
+    /* ---------------------------------------------------------------------- */
+    /* construct the pattern of Z, the same as the pattern of L */
+    /* ---------------------------------------------------------------------- */
+
+    Zp = Z->p ;
+    Zi = Z->i ;
+    p = 0 ;
+    for (s = 0 ; s < nsuper ; s++)
+    {
+	k1 = Super [s] ;
+	k2 = Super [s+1] ;
+	psi = Lpi [s] ;
+	for (j = k1 ; j < k2 ; j++)
+	{
+	    SuperMap [j] = s ;
+	    Zp [j] = p ;
+	    for (pp = psi + (j - k1) ; pp < Lpi [s+1] ; pp++)
+	    {
+		Zi [p++] = Ls [pp] ;
+	    }
+	}
+    }
+    Zp [n] = p ;
+    ASSERT (p == znz) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* construct the supernodal elimination tree, and the work in each subtree*/
+    /* ---------------------------------------------------------------------- */
+
+    /* The parent of a supernode is the supernode that holds the first row of
+     * L2.  Each child is placed in the list of its parent, in order of
+     * decreasing supernode index.  The roots are in the list Head [nsuper]. */
+
+    for (s = 0 ; s <= nsuper ; s++)
+    {
+	Head [s] = EMPTY ;
+    }
+    for (s = 0 ; s < nsuper ; s++)
+    {
+	nscol = Super [s+1] - Super [s] ;
+	nsrow = Lpi [s+1] - Lpi [s] ;
+	nsrow2 = nsrow - nscol ;
+	parent = (nsrow2 > 0) ? SuperMap [Ls [Lpi [s] + nscol]] : nsuper ;
+	ASSERT (parent > s) ;
+	Next [s] = Head [parent] ;
+	Head [parent] = s ;
+    }
+    for (s = 0 ; s < nsuper ; s++)
+    {
+	Work [s] = 0 ;
+    }
+    for (s = 0 ; s < nsuper ; s++)
+    {
+	nscol = Super [s+1] - Super [s] ;
+	nsrow = Lpi [s+1] - Lpi [s] ;
+	Work [s] += ((double) nscol) * nsrow * nsrow ;
+	if (nsrow > nscol)
+	{
+	    /* the parent is done after all of its children */
+	    Work [SuperMap [Ls [Lpi [s] + nscol]]] += Work [s] ;
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* compute the numerical values of Z */
+    /* ---------------------------------------------------------------------- */
+
+    S->L = L ;
+    S->Zp = Zp ;
+    S->Zx = Z->x ;
+    S->SuperMap = SuperMap ;
+    S->Head = Head ;
+    S->Next = Next ;
+    S->Work = Work ;
+    S->wsize = wsize ;
+    S->nsuper = nsuper ;
+    S->Common = Common ;
+
+    if (nthreads == 1)
+    {
+	/* the parent of each supernode s is greater than s */
+	for (s = nsuper-1 ; s >= 0 ; s--)
+	{
+	    if (L->xtype == CHOLMOD_REAL)
+	    {
+		r_cholmod_sparseinv_super (s, S, 0) ;
+	    }
+	    else
+	    {
+		c_cholmod_sparseinv_super (s, S, 0) ;
+	    }
+	}
+    }
+    else
+    {
+	/* each large subtree is an OpenMP task; all of them are done at the
+	 * end of the parallel region */
+	#pragma omp parallel num_threads(nthreads)
+	#pragma omp single
+	{
+	    if (L->xtype == CHOLMOD_REAL)
+	    {
+		r_cholmod_sparseinv_children (Head [nsuper], S) ;
+	    }
+	    else
+	    {
+		c_cholmod_sparseinv_children (Head [nsuper], S) ;
+	    }
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* free workspace and return the result */
+    /* ---------------------------------------------------------------------- */
+
+    CHOLMOD(free) (isize, sizeof (Int), Iwork, Common) ;
+    CHOLMOD(free) (nsuper, sizeof (double), Work, Common) ;
+    CHOLMOD(free) (MAX (xsize, 1), sizeof (double), S->Xwork, Common) ;
+
+    if (CHECK_BLAS_INT && !Common->blas_ok)
+    {
+	ERROR (CHOLMOD_TOO_LARGE, "problem too large for the BLAS") ;
+	CHOLMOD(free_sparse) (&Z, Common) ;
+	return (NULL) ;
+    }
+    return (Z) ;
+}
+#endif
+#endif
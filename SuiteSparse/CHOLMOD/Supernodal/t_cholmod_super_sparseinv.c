@@ -0,0 +1,328 @@
+/* ========================================================================== */
+/* === Supernodal/t_cholmod_super_sparseinv ================================= */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * CHOLMOD/Supernodal Module.  Copyright (C) 2026, the CHOLMOD contributors.
+ * http://www.suitesparse.com
+ * -------------------------------------------------------------------------- */
+
+/* Template routine for cholmod_super_sparseinv.  Supports real or complex L. */
+
+#include "cholmod_template.h"
+
+/* ========================================================================== */
+/* === cholmod_sparseinv_super ============================================== */
+/* ========================================================================== */
+
+/* Compute the columns k1:k2-1 of Z for the supernode s, where all of its
+ * ancestors have already been done.  L1 is the nscol-by-nscol lower
+ * triangular diagonal block of the supernode, and L2 is the nsrow2-by-nscol
+ * block below it, with row indices I2.  With U = L2*inv(L1), the Takahashi
+ * equations for a supernode are:
+ *
+ *	Z21 = -Z22*U
+ *	Z11 = inv(L1)'*inv(L1) - U'*Z21
+ *
+ * where Z22 = Z(I2,I2) is already known, and is gathered into a dense matrix.
+ * I2 is a clique in the graph of L+L', so Z22 lies in the pattern of L.
+ */
+
+static void TEMPLATE (cholmod_sparseinv_super)
+(
+    Int s,		    /* supernode to compute */
+    sparseinv_info *S,	    /* the factor L, Z, and workspace */
+    int tid		    /* thread id, for workspace */
+)
+{
+    double one [2], zero [2], minus_one [2] ;
+    double *Lx, *Zx, *Z22, *U, *Z21, *T, *Z11 ;
+    Int *Lpi, *Lpx, *Ls, *Super, *SuperMap, *Zp, *Map ;
+    Int k1, k2, psi, psend, psx, nsrow, nscol, nsrow2, ps2, i, j, ii, jj, p,
+	t, last, pz, c, r ;
+    cholmod_factor *L ;
+    cholmod_common *Common ;
+
+    /* ---------------------------------------------------------------------- */
+    /* get inputs */
+    /* ---------------------------------------------------------------------- */
+
+    L = S->L ;
+    Common = S->Common ;
+    Lpi = L->pi ;
+    Lpx = L->px ;
+    Ls = L->s ;
+    Super = L->super ;
+    Lx = L->x ;
+    SuperMap = S->SuperMap ;
+    Zp = S->Zp ;
+    Zx = S->Zx ;
+    one [0] = 1.0 ;
+    one [1] = 0 ;
+    zero [0] = 0 ;
+    zero [1] = 0 ;
+    minus_one [0] = -1.0 ;
+    minus_one [1] = 0 ;
+
+    k1 = Super [s] ;
+    k2 = Super [s+1] ;
+    psi = Lpi [s] ;
+    psend = Lpi [s+1] ;
+    psx = Lpx [s] ;
+    nsrow = psend - psi ;
+    nscol = k2 - k1 ;
+    nsrow2 = nsrow - nscol ;
+    ps2 = psi + nscol ;
+
+    /* workspace of this thread, of size S->wsize entries */
+    Map = S->Map + ((size_t) tid) * L->n ;
+    Z22 = S->Xwork + ((size_t) tid) * S->wsize * ENTRY_SIZE ;
+    U   = Z22 + ENTRY_SIZE * nsrow2 * nsrow2 ;	/* nsrow2-by-nscol */
+    Z21 = U   + ENTRY_SIZE * nsrow2 * nscol ;	/* nsrow2-by-nscol */
+    T   = Z21 + ENTRY_SIZE * nsrow2 * nscol ;	/* nscol-by-nscol */
+    Z11 = T   + ENTRY_SIZE * nscol * nscol ;	/* nscol-by-nscol */
+
+    /* ---------------------------------------------------------------------- */
+    /* Z11 = inv(L1)'*inv(L1) */
+    /* ---------------------------------------------------------------------- */
+
+    for (j = 0 ; j < nscol ; j++)
+    {
+	for (i = 0 ; i < nscol ; i++)
+	{
+	    CLEAR (T,-,i+j*nscol) ;
+	}
+	T [ENTRY_SIZE * (j+j*nscol)] = 1 ;
+    }
+
+#ifdef REAL
+
+    /* T = L1\I */
+    BLAS_dtrsm ("L", "L", "N", "N",
+	nscol, nscol,		    /* M, N:	T is nscol-by-nscol */
+	one,			    /* ALPHA:	1 */
+	Lx + ENTRY_SIZE*psx, nsrow, /* A, LDA:	L1 */
+	T, nscol) ;		    /* B, LDB:	T */
+
+    /* Z11 = tril (T'*T) */
+    BLAS_dsyrk ("L", "T",
+	nscol, nscol,		    /* N, K:	Z11 is nscol-by-nscol */
+	one,			    /* ALPHA:	1 */
+	T, nscol,		    /* A, LDA:	T */
+	zero,			    /* BETA:	0 */
+	Z11, nscol) ;		    /* C, LDC:	Z11 */
+
+#else
+
+    /* T = L1\I */
+    BLAS_ztrsm ("L", "L", "N", "N",
+	nscol, nscol,		    /* M, N:	T is nscol-by-nscol */
+	one,			    /* ALPHA:	1 */
+	Lx + ENTRY_SIZE*psx, nsrow, /* A, LDA:	L1 */
+	T, nscol) ;		    /* B, LDB:	T */
+
+    /* Z11 = tril (T'*T) */
+    BLAS_zherk ("L", "C",
+	nscol, nscol,		    /* N, K:	Z11 is nscol-by-nscol */
+	one,			    /* ALPHA:	1 */
+	T, nscol,		    /* A, LDA:	T */
+	zero,			    /* BETA:	0 */
+	Z11, nscol) ;		    /* C, LDC:	Z11 */
+
+#endif
+
+    if (nsrow2 > 0)
+    {
+
+	/* ------------------------------------------------------------------ */
+	/* U = L2*inv(L1) */
+	/* ------------------------------------------------------------------ */
+
+	for (j = 0 ; j < nscol ; j++)
+	{
+	    for (i = 0 ; i < nsrow2 ; i++)
+	    {
+		/* U [i+j*nsrow2] = Lx [psx + nscol + i + j*nsrow] ; */
+		ASSIGN (U,-,i+j*nsrow2, Lx,-,psx+nscol+i+j*nsrow) ;
+	    }
+	}
+
+#ifdef REAL
+	BLAS_dtrsm ("R", "L", "N", "N",
+	    nsrow2, nscol,		/* M, N:    U is nsrow2-by-nscol */
+	    one,			/* ALPHA:   1 */
+	    Lx + ENTRY_SIZE*psx, nsrow,	/* A, LDA:  L1 */
+	    U, nsrow2) ;		/* B, LDB:  U */
+#else
+	BLAS_ztrsm ("R", "L", "N", "N",
+	    nsrow2, nscol,		/* M, N:    U is nsrow2-by-nscol */
+	    one,			/* ALPHA:   1 */
+	    Lx + ENTRY_SIZE*psx, nsrow,	/* A, LDA:  L1 */
+	    U, nsrow2) ;		/* B, LDB:  U */
+#endif
+
+	/* ------------------------------------------------------------------ */
+	/* gather Z22 = Z (I2,I2) from the ancestors of s */
+	/* ------------------------------------------------------------------ */
+
+	/* The columns of I2 that lie in a single supernode t are contiguous
+	 * in I2, since I2 is sorted, so Map is constructed once for each t.
+	 * Z(i,j), for a row i in supernode t with Map [i] = r and the column
+	 * j = Super [t] + c, is held in Zx [Zp [j] + r - c]. */
+
+	last = EMPTY ;
+	for (jj = 0 ; jj < nsrow2 ; jj++)
+	{
+	    j = Ls [ps2 + jj] ;
+	    t = SuperMap [j] ;
+	    ASSERT (t > s) ;
+	    if (t != last)
+	    {
+		for (p = Lpi [t] ; p < Lpi [t+1] ; p++)
+		{
+		    Map [Ls [p]] = p - Lpi [t] ;
+		}
+		last = t ;
+	    }
+	    c = j - Super [t] ;
+	    pz = Zp [j] - c ;
+	    for (ii = jj ; ii < nsrow2 ; ii++)
+	    {
+		i = Ls [ps2 + ii] ;
+		r = Map [i] ;
+		ASSERT (r >= c && r < Lpi [t+1] - Lpi [t]) ;
+		ASSERT (Ls [Lpi [t] + r] == i) ;
+		/* Z22 [ii+jj*nsrow2] = Zx [pz + r] ; */
+		ASSIGN (Z22,-,ii+jj*nsrow2, Zx,-,pz+r) ;
+		/* Z22 [jj+ii*nsrow2] = conj (Zx [pz + r]) ; */
+		ASSIGN_CONJ (Z22,-,jj+ii*nsrow2, Zx,-,pz+r) ;
+	    }
+	}
+
+	/* ------------------------------------------------------------------ */
+	/* Z21 = -Z22*U and Z11 = Z11 - U'*Z21 */
+	/* ------------------------------------------------------------------ */
+
+#ifdef REAL
+
+	BLAS_dgemm ("N", "N",
+	    nsrow2, nscol, nsrow2,	/* M, N, K */
+	    minus_one,			/* ALPHA:   -1 */
+	    Z22, nsrow2,		/* A, LDA:  Z22 */
+	    U, nsrow2,			/* B, LDB:  U */
+	    zero,			/* BETA:    0 */
+	    Z21, nsrow2) ;		/* C, LDC:  Z21 */
+
+	BLAS_dgemm ("T", "N",
+	    nscol, nscol, nsrow2,	/* M, N, K */
+	    minus_one,			/* ALPHA:   -1 */
+	    U, nsrow2,			/* A, LDA:  U */
+	    Z21, nsrow2,		/* B, LDB:  Z21 */
+	    one,			/* BETA:    1 */
+	    Z11, nscol) ;		/* C, LDC:  Z11 */
+
+#else
+
+	BLAS_zgemm ("N", "N",
+	    nsrow2, nscol, nsrow2,	/* M, N, K */
+	    minus_one,			/* ALPHA:   -1 */
+	    Z22, nsrow2,		/* A, LDA:  Z22 */
+	    U, nsrow2,			/* B, LDB:  U */
+	    zero,			/* BETA:    0 */
+	    Z21, nsrow2) ;		/* C, LDC:  Z21 */
+
+	BLAS_zgemm ("C", "N",
+	    nscol, nscol, nsrow2,	/* M, N, K */
+	    minus_one,			/* ALPHA:   -1 */
+	    U, nsrow2,			/* A, LDA:  U */
+	    Z21, nsrow2,		/* B, LDB:  Z21 */
+	    one,			/* BETA:    1 */
+	    Z11, nscol) ;		/* C, LDC:  Z11 */
+
+#endif
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* scatter Z11 and Z21 into the columns k1:k2-1 of Z */
+    /* ---------------------------------------------------------------------- */
+
+    for (c = 0 ; c < nscol ; c++)
+    {
+	pz = Zp [k1 + c] - c ;
+	for (r = c ; r < nscol ; r++)
+	{
+	    /* Zx [pz + r] = Z11 [r+c*nscol] ; */
+	    ASSIGN (Zx,-,pz+r, Z11,-,r+c*nscol) ;
+	}
+	for (r = 0 ; r < nsrow2 ; r++)
+	{
+	    /* Zx [pz + nscol + r] = Z21 [r+c*nsrow2] ; */
+	    ASSIGN (Zx,-,pz+nscol+r, Z21,-,r+c*nsrow2) ;
+	}
+    }
+}
+
+
+/* ========================================================================== */
+/* === cholmod_sparseinv_children =========================================== */
+/* ========================================================================== */
+
+/* Compute the subtrees rooted at the list of supernodes first, Next [first],
+ * ..., whose parent has already been done.  A large subtree becomes an OpenMP
+ * task, which computes its root and then the subtrees of its children.  The
+ * small subtrees are done by this task, with an explicit stack, parents before
+ * their children.  No task is created while the workspace of a thread is in
+ * use, so the tasks can share the workspace of each thread.
+ */
+
+static void TEMPLATE (cholmod_sparseinv_children)
+(
+    Int first,		    /* first supernode in the list */
+    sparseinv_info *S	    /* the factor L, Z, and workspace */
+)
+{
+    Int c, d, e, top, *Head, *Next, *Stack ;
+    int tid ;
+
+    Head = S->Head ;
+    Next = S->Next ;
+
+    /* create a task for each large subtree */
+    for (c = first ; c != EMPTY ; c = Next [c])
+    {
+	if (S->Work [c] >= SPARSEINV_TASK_WORK)
+	{
+	    #pragma omp task firstprivate (c)
+	    {
+		TEMPLATE (cholmod_sparseinv_super) (c, S, SPARSEINV_TID) ;
+		TEMPLATE (cholmod_sparseinv_children) (Head [c], S) ;
+	    }
+	}
+    }
+
+    /* do each small subtree */
+    tid = SPARSEINV_TID ;
+    Stack = S->Stack + ((size_t) tid) * S->nsuper ;
+    for (c = first ; c != EMPTY ; c = Next [c])
+    {
+	if (S->Work [c] < SPARSEINV_TASK_WORK)
+	{
+	    Stack [0] = c ;
+	    top = 1 ;
+	    while (top > 0)
+	    {
+		d = Stack [--top] ;
+		TEMPLATE (cholmod_sparseinv_super) (d, S, tid) ;
+		for (e = Head [d] ; e != EMPTY ; e = Next [e])
+		{
+		    Stack [top++] = e ;
+		}
+	    }
+	}
+    }
+}
+
+#undef PATTERN
+#undef REAL
+#undef COMPLEX
+#undef ZOMPLEX
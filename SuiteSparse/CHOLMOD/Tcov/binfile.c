@@ -0,0 +1,327 @@
+/* ========================================================================== */
+/* === Tcov/binfile ========================================================= */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * CHOLMOD/Tcov Module.  Copyright (C) 2026, the CHOLMOD contributors.
+ * http://www.suitesparse.com
+ * -------------------------------------------------------------------------- */
+
+/* Test cholmod_write_bin, SuiteSparse_bin_load, SuiteSparse_bin_verify, and
+ * cholmod_bin_sparse.  A is written with and without block checksums, loaded,
+ * and compared with the original.  The file is then corrupted in several ways,
+ * which must be detected.  Returns zero if all tests pass.
+ */
+
+#include "cm.h"
+#include <stdint.h>
+#include <string.h>
+
+
+/* ========================================================================== */
+/* === bin_same ============================================================= */
+/* ========================================================================== */
+
+/* Returns TRUE if A and C are the same matrix (A may be unpacked). */
+
+static int bin_same (cholmod_sparse *A, cholmod_sparse *C)
+{
+    cholmod_dense *X, *Y ;
+    double *Xx, *Yx ;
+    Int k, len, ok ;
+
+    if (A->nrow != C->nrow || A->ncol != C->ncol || A->stype != C->stype
+	|| A->xtype != C->xtype)
+    {
+	return (FALSE) ;
+    }
+    X = CHOLMOD(sparse_to_dense) (A, cm) ;
+    Y = CHOLMOD(sparse_to_dense) (C, cm) ;
+    ok = (X != NULL && Y != NULL) ;
+    if (ok)
+    {
+	Xx = X->x ;
+	Yx = Y->x ;
+	len = X->nrow * X->ncol * ((X->xtype == CHOLMOD_COMPLEX) ? 2 : 1) ;
+	for (k = 0 ; ok && k < len ; k++)
+	{
+	    ok = (Xx [k] == Yx [k]) ;
+	}
+	if (ok && X->xtype == CHOLMOD_ZOMPLEX)
+	{
+	    for (k = 0 ; ok && k < (Int) (X->nrow * X->ncol) ; k++)
+	    {
+		ok = (((double *) X->z) [k] == ((double *) Y->z) [k]) ;
+	    }
+	}
+    }
+    CHOLMOD(free_dense) (&X, cm) ;
+    CHOLMOD(free_dense) (&Y, cm) ;
+    return (ok) ;
+}
+
+
+/* ========================================================================== */
+/* === bin_flip ============================================================= */
+/* ========================================================================== */
+
+/* Flip the low bit of the byte at the given offset of a file. */
+
+static void bin_flip (const char *filename, long offset)
+{
+    FILE *f ;
+    int c ;
+    f = fopen (filename, "r+b") ;
+    OK (f != NULL) ;
+    OK (fseek (f, offset, SEEK_SET) == 0) ;
+    c = getc (f) ;
+    OK (c != EOF) ;
+    OK (fseek (f, offset, SEEK_SET) == 0) ;
+    OK (putc (c ^ 1, f) != EOF) ;
+    OK (fclose (f) == 0) ;
+}
+
+
+/* ========================================================================== */
+/* === bin_hostile ========================================================== */
+/* ========================================================================== */
+
+/* Overwrite the dimensions and the first two array offsets in the header of a
+ * file, and recompute its header checksum, so that only the sizes implied by
+ * the header are wrong.  The layout and checksum are those of SuiteSparse_bin.c:
+ * nrow, ncol, and nnz at bytes 16, 24, and 32, the array offsets at byte 64,
+ * and the header checksum at byte 112 of the 128-byte header. */
+
+static void bin_hostile (const char *filename, int64_t nrow, int64_t ncol,
+    int64_t nnz, long p_offset, long i_offset)
+{
+    uint64_t offset0 = (uint64_t) p_offset, offset1 = (uint64_t) i_offset ;
+    FILE *f ;
+    unsigned char h [128] ;
+    uint64_t a = 1, b = 0, w ;
+    int k ;
+
+    f = fopen (filename, "r+b") ;
+    OK (f != NULL) ;
+    OK (fread (h, 1, 128, f) == 128) ;
+    memcpy (h + 16, &nrow, 8) ;
+    memcpy (h + 24, &ncol, 8) ;
+    memcpy (h + 32, &nnz, 8) ;
+    memcpy (h + 64, &offset0, 8) ;
+    memcpy (h + 72, &offset1, 8) ;
+    memset (h + 112, 0, 8) ;
+    for (k = 0 ; k < 128 ; k += 8)
+    {
+	memcpy (&w, h + k, 8) ;
+	a += w ;
+	b += a ;
+    }
+    w = a ^ (b << 32) ^ (b >> 32) ;
+    memcpy (h + 112, &w, 8) ;
+    OK (fseek (f, 0, SEEK_SET) == 0) ;
+    OK (fwrite (h, 1, 128, f) == 128) ;
+    OK (fclose (f) == 0) ;
+}
+
+
+/* ========================================================================== */
+/* === binfile ============================================================== */
+/* ========================================================================== */
+
+double binfile (cholmod_sparse *A)
+{
+    SuiteSparse_bin B ;
+    cholmod_sparse Aview, *C, *E ;
+    FILE *f ;
+    char buf [100] ;
+    long offset, ioffset ;
+    int64_t P64 [2], I64 [1], big ;
+    Int checksum, xtype, nnz, p, Zp [2] ;
+    void (*save) (int, const char *, int, const char *) ;
+
+    if (A == NULL)
+    {
+	ERROR (CHOLMOD_INVALID, "cm: no A for binfile") ;
+	return (1) ;
+    }
+    if (A->nrow > NSMALL || A->ncol > NSMALL)
+    {
+	return (0) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* write, load, and compare, with and without checksums */
+    /* ---------------------------------------------------------------------- */
+
+    for (checksum = 0 ; checksum <= 1 ; checksum++)
+    {
+	OK (CHOLMOD(write_bin) ("temp.ssb", A, checksum, cm)) ;
+	OK (SuiteSparse_bin_load ("temp.ssb", TRUE, &B) == SUITESPARSE_BIN_OK);
+	OK (B.checksum == checksum && B.isize == sizeof (Int)) ;
+	OK (B.i != NULL && (B.x != NULL) == (A->xtype != CHOLMOD_PATTERN)) ;
+	C = CHOLMOD(bin_sparse) (&B, &Aview, cm) ;
+	OKP (C) ;
+	OK (CHOLMOD(check_sparse) (C, cm)) ;
+	OK (bin_same (A, C)) ;
+	OK (SuiteSparse_bin_verify (&B) == SUITESPARSE_BIN_OK) ;
+	SuiteSparse_bin_free (&B) ;
+	OK (B.base == NULL && B.p == NULL) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* corrupt the file */
+    /* ---------------------------------------------------------------------- */
+
+    /* temp.ssb now holds A, with checksums */
+    OK (SuiteSparse_bin_load ("temp.ssb", FALSE, &B) == SUITESPARSE_BIN_OK) ;
+    nnz = B.nnz ;
+    offset = (nnz > 0) ? ((long) ((char *) B.i - (char *) B.base)) : 0 ;
+    SuiteSparse_bin_free (&B) ;
+
+    if (nnz > 0)
+    {
+	/* a flipped bit in the row indices: the load succeeds, since only the
+	   header and the first and last column pointers are checked, but the
+	   checksum does not match */
+	bin_flip ("temp.ssb", offset) ;
+	OK (SuiteSparse_bin_load ("temp.ssb", FALSE, &B) == SUITESPARSE_BIN_OK);
+	OK (SuiteSparse_bin_verify (&B) == SUITESPARSE_BIN_CHECKSUM) ;
+	SuiteSparse_bin_free (&B) ;
+	OK (SuiteSparse_bin_load ("temp.ssb", TRUE, &B) ==
+	    SUITESPARSE_BIN_CHECKSUM) ;
+	OK (B.base == NULL && B.p == NULL) ;
+	bin_flip ("temp.ssb", offset) ;
+	OK (SuiteSparse_bin_load ("temp.ssb", TRUE, &B) == SUITESPARSE_BIN_OK);
+	SuiteSparse_bin_free (&B) ;
+
+	/* without checksums, a row index out of range is still found.  The
+	   most significant byte of the first row index is changed. */
+	OK (CHOLMOD(write_bin) ("temp.ssb", A, FALSE, cm)) ;
+	p = 1 ;
+	bin_flip ("temp.ssb", offset +
+	    ((*((char *) &p) == 1) ? ((long) sizeof (Int) - 1) : 0)) ;
+	OK (SuiteSparse_bin_load ("temp.ssb", TRUE, &B) ==
+	    SUITESPARSE_BIN_INVALID) ;
+	OK (CHOLMOD(write_bin) ("temp.ssb", A, TRUE, cm)) ;
+    }
+
+    /* a flipped bit in the header */
+    bin_flip ("temp.ssb", 20) ;
+    OK (SuiteSparse_bin_load ("temp.ssb", FALSE, &B) ==
+	SUITESPARSE_BIN_INVALID) ;
+    OK (B.base == NULL) ;
+    OK (SuiteSparse_bin_verify (&B) == SUITESPARSE_BIN_ARG_ERROR) ;
+    bin_flip ("temp.ssb", 20) ;
+
+    /* a truncated file: the first 100 bytes of temp.ssb */
+    f = fopen ("temp.ssb", "rb") ;
+    OK (f != NULL) ;
+    OK (fread (buf, 1, 100, f) == 100) ;
+    OK (fclose (f) == 0) ;
+    f = fopen ("temp_short.ssb", "wb") ;
+    OK (f != NULL) ;
+    OK (fwrite (buf, 1, 100, f) == 100) ;
+    OK (fclose (f) == 0) ;
+    OK (SuiteSparse_bin_load ("temp_short.ssb", FALSE, &B) ==
+	SUITESPARSE_BIN_INVALID) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* a matrix with no entries */
+    /* ---------------------------------------------------------------------- */
+
+    for (xtype = CHOLMOD_PATTERN ; xtype <= CHOLMOD_ZOMPLEX ; xtype++)
+    {
+	E = CHOLMOD(spzeros) (3, 4, 0, xtype, cm) ;
+	OK (CHOLMOD(write_bin) ("temp.ssb", E, TRUE, cm)) ;
+	OK (SuiteSparse_bin_load ("temp.ssb", TRUE, &B) == SUITESPARSE_BIN_OK);
+	OK (B.nnz == 0 && B.i != NULL) ;
+	OK ((B.x != NULL) == (xtype != CHOLMOD_PATTERN)) ;
+	OK ((B.z != NULL) == (xtype == CHOLMOD_ZOMPLEX)) ;
+	C = CHOLMOD(bin_sparse) (&B, &Aview, cm) ;
+	OKP (C) ;
+	OK (CHOLMOD(check_sparse) (C, cm)) ;
+	OK (bin_same (E, C)) ;
+	SuiteSparse_bin_free (&B) ;
+	CHOLMOD(free_sparse) (&E, cm) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* error tests */
+    /* ---------------------------------------------------------------------- */
+
+    save = cm->error_handler ;
+    cm->error_handler = NULL ;
+
+    OK (SuiteSparse_bin_load (NULL, FALSE, &B) == SUITESPARSE_BIN_ARG_ERROR) ;
+    OK (SuiteSparse_bin_load ("temp.ssb", FALSE, NULL) ==
+	SUITESPARSE_BIN_ARG_ERROR) ;
+    OK (SuiteSparse_bin_load ("no_such_file.ssb", FALSE, &B) ==
+	SUITESPARSE_BIN_FILE_IOERROR) ;
+    OK (SuiteSparse_bin_verify (NULL) == SUITESPARSE_BIN_ARG_ERROR) ;
+    OK (!CHOLMOD(write_bin) ("gunk/gunk.ssb", A, TRUE, cm)) ;
+    OK (!CHOLMOD(write_bin) (NULL, A, TRUE, cm)) ;
+    OK (!CHOLMOD(write_bin) ("temp.ssb", NULL, TRUE, cm)) ;
+    OK (!CHOLMOD(write_bin) ("temp.ssb", A, TRUE, NULL)) ;
+
+    /* a file with the other integer size, or in compressed-row form, cannot
+       be used by cholmod_bin_sparse */
+    Zp [0] = 0 ;                /* 8 bytes of zeros, for either integer size */
+    Zp [1] = 0 ;
+    OK (SuiteSparse_bin_write ("temp.ssb", SUITESPARSE_BIN_CSC, 0, 0,
+	(sizeof (Int) == 4) ? 8 : 4, Zp, NULL, SUITESPARSE_BIN_PATTERN, NULL,
+	NULL, 0, TRUE, FALSE) == SUITESPARSE_BIN_OK) ;
+    OK (SuiteSparse_bin_load ("temp.ssb", TRUE, &B) == SUITESPARSE_BIN_OK) ;
+    NOP (CHOLMOD(bin_sparse) (&B, &Aview, cm)) ;
+    OK (cm->status == CHOLMOD_INVALID) ;
+    SuiteSparse_bin_free (&B) ;
+    OK (SuiteSparse_bin_write ("temp.ssb", SUITESPARSE_BIN_CSR, 0, 0,
+	sizeof (Int), Zp, NULL, SUITESPARSE_BIN_PATTERN, NULL, NULL, 0, TRUE,
+	FALSE) == SUITESPARSE_BIN_OK) ;
+    OK (SuiteSparse_bin_load ("temp.ssb", TRUE, &B) == SUITESPARSE_BIN_OK) ;
+    NOP (CHOLMOD(bin_sparse) (&B, &Aview, cm)) ;
+    NOP (CHOLMOD(bin_sparse) (NULL, &Aview, cm)) ;
+    NOP (CHOLMOD(bin_sparse) (&B, NULL, cm)) ;
+    SuiteSparse_bin_free (&B) ;
+    OK (SuiteSparse_bin_write ("temp.ssb", SUITESPARSE_BIN_CSC, 0, 0,
+	sizeof (Int), NULL, NULL, SUITESPARSE_BIN_PATTERN, NULL, NULL, 0, TRUE,
+	FALSE) == SUITESPARSE_BIN_ARG_ERROR) ;
+
+    OK (SuiteSparse_bin_write ("temp.ssb", SUITESPARSE_BIN_CSC, 0, 0,
+	sizeof (Int), Zp, NULL, SUITESPARSE_BIN_REAL, NULL, NULL, 0, TRUE,
+	FALSE) == SUITESPARSE_BIN_ARG_ERROR) ;
+
+    /* hostile headers, with correct header checksums.  With 8-byte indices,
+       an nnz of 2^61+1 gives an Ai of 8 bytes, which fits in the file of a
+       1-by-1 matrix with one entry, and an ncol of 2^61-1 gives an Ap of
+       zero bytes. */
+    P64 [0] = 0 ;
+    P64 [1] = 1 ;
+    I64 [0] = 0 ;
+    OK (SuiteSparse_bin_write ("temp.ssb", SUITESPARSE_BIN_CSC, 1, 1, 8, P64,
+	I64, SUITESPARSE_BIN_PATTERN, NULL, NULL, 0, TRUE, FALSE) ==
+	SUITESPARSE_BIN_OK) ;
+    OK (SuiteSparse_bin_load ("temp.ssb", FALSE, &B) == SUITESPARSE_BIN_OK) ;
+    offset = (long) ((char *) B.p - (char *) B.base) ;
+    ioffset = (long) ((char *) B.i - (char *) B.base) ;
+    SuiteSparse_bin_free (&B) ;
+    big = (((int64_t) 1) << 61) + 1 ;
+    bin_hostile ("temp.ssb", 1, 1, big, offset, ioffset) ;
+    f = fopen ("temp.ssb", "r+b") ;
+    OK (f != NULL) ;
+    OK (fseek (f, offset + 8, SEEK_SET) == 0) ;
+    OK (fwrite (&big, 8, 1, f) == 1) ;      /* Ap [1] = nnz */
+    OK (fclose (f) == 0) ;
+    OK (SuiteSparse_bin_load ("temp.ssb", FALSE, &B) ==
+	SUITESPARSE_BIN_INVALID) ;
+    OK (B.base == NULL) ;
+
+    OK (SuiteSparse_bin_write ("temp.ssb", SUITESPARSE_BIN_CSC, 1, 1, 8, P64,
+	I64, SUITESPARSE_BIN_PATTERN, NULL, NULL, 0, TRUE, FALSE) ==
+	SUITESPARSE_BIN_OK) ;
+    bin_hostile ("temp.ssb", 1, big - 2, 0, 0, 0) ;
+    OK (SuiteSparse_bin_load ("temp.ssb", FALSE, &B) ==
+	SUITESPARSE_BIN_INVALID) ;
+
+    cm->error_handler = save ;
+    return (0) ;
+}
@@ -1270,6 +1270,34 @@ double do_matrix (cholmod_sparse *A)
 	    err = aug (A) ;			/* no random number use */
 	    MAXERR (maxerr, err, 1) ;
 
+	    /* -------------------------------------------------------------- */
+	    /* sparse inverse subset of a supernodal factorization */
+	    /* -------------------------------------------------------------- */
+
+	    err = sparseinv (A) ;		/* no random number use */
+	    MAXERR (maxerr, err, 1) ;
+
+	    /* -------------------------------------------------------------- */
+	    /* sparse matrix multiply */
+	    /* -------------------------------------------------------------- */
+
+	    err = spgemm (A) ;			/* no random number use */
+	    MAXERR (maxerr, err, 1) ;
+
+	    /* -------------------------------------------------------------- */
+	    /* write and load a SuiteSparse_bin file */
+	    /* -------------------------------------------------------------- */
+
+	    err = binfile (A) ;			/* no random number use */
+	    MAXERR (maxerr, err, 1) ;
+
+	    /* -------------------------------------------------------------- */
+	    /* write and read a graph in METIS format */
+	    /* -------------------------------------------------------------- */
+
+	    err = graph (A) ;			/* no random number use */
+	    MAXERR (maxerr, err, 1) ;
+
 	    /* -------------------------------------------------------------- */
 	    /* solve using different methods */
 	    /* -------------------------------------------------------------- */
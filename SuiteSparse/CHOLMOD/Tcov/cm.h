@@ -125,6 +125,10 @@ cholmod_dense *xtrue (Int nrow, Int ncol, Int d, Int xtype) ;
 double resid (cholmod_sparse *A, cholmod_dense *X, cholmod_dense *B) ;
 double solve (cholmod_sparse *A) ;
 double aug (cholmod_sparse *A) ;
+double sparseinv (cholmod_sparse *A) ;
+double spgemm (cholmod_sparse *A) ;
+double binfile (cholmod_sparse *A) ;
+double graph (cholmod_sparse *A) ;
 double do_matrix (cholmod_sparse *A) ;
 cholmod_dense *rhs (cholmod_sparse *A, Int nrhs, Int d) ;
 void prune_row (cholmod_sparse *A, Int k) ;
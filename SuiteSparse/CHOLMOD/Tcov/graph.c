@@ -0,0 +1,514 @@
+/* ========================================================================== */
+/* === Tcov/graph =========================================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * CHOLMOD/Tcov Module.  Copyright (C) 2026, the CHOLMOD contributors.
+ * http://www.suitesparse.com
+ * -------------------------------------------------------------------------- */
+
+/* Test cholmod_read_graph.  The graph of A (A+A' if A is square, or A*A'
+ * otherwise) is written in each METIS format (fmt 0, 1, 10, 11, and 100),
+ * with comments and CRLF line endings, read back, and compared with the
+ * original.  A few small graphs are read from text, including invalid ones,
+ * and a large grid is read with one and with four threads, which must give
+ * the same result.  Returns zero if all tests pass.
+ */
+
+#include "cm.h"
+
+/* the weight of edge (i,j), and weight k of vertex j */
+#define GRAPH_EW(i,j) (0.5 * (1 + ((i) + (j)) % 3))
+#define GRAPH_VW(j,k) ((double) (((j) + 3*(k)) % 5))
+
+
+/* ========================================================================== */
+/* === graph_text =========================================================== */
+/* ========================================================================== */
+
+/* Write a string to a file, and read it as a graph. */
+
+static cholmod_sparse *graph_text (const char *text, int stype,
+    cholmod_dense **W, int *fmt)
+{
+    cholmod_sparse *G ;
+    FILE *f ;
+    f = fopen ("temp.graph", "wb") ;
+    OK (f != NULL) ;
+    OK (fputs (text, f) >= 0) ;
+    OK (fclose (f) == 0) ;
+    f = fopen ("temp.graph", "rb") ;
+    OK (f != NULL) ;
+    G = CHOLMOD(read_graph) (f, stype, W, fmt, cm) ;
+    OK (fclose (f) == 0) ;
+    return (G) ;
+}
+
+
+/* ========================================================================== */
+/* === graph_same =========================================================== */
+/* ========================================================================== */
+
+/* Returns TRUE if G is a valid graph with the given stype, and is equal to
+ * the n-by-n dense matrix E.  If G is symmetric, only its upper or lower
+ * triangular part is stored. */
+
+static int graph_same (cholmod_sparse *G, double *E, Int n, int stype)
+{
+    cholmod_dense *X ;
+    double *Xx ;
+    Int *Gp, *Gi, j, p, k, ok ;
+
+    if (G == NULL || G->nrow != n || G->ncol != n || G->xtype != CHOLMOD_REAL
+	|| G->stype != ((stype > 0) ? 1 : ((stype < 0) ? -1 : 0))
+	|| !G->sorted || !G->packed || !CHOLMOD(check_sparse) (G, cm))
+    {
+	return (FALSE) ;
+    }
+    Gp = G->p ;
+    Gi = G->i ;
+    for (j = 0 ; j < n ; j++)
+    {
+	for (p = Gp [j] ; p < Gp [j+1] ; p++)
+	{
+	    if ((stype > 0 && Gi [p] > j) || (stype < 0 && Gi [p] < j))
+	    {
+		return (FALSE) ;
+	    }
+	}
+    }
+    X = CHOLMOD(sparse_to_dense) (G, cm) ;
+    ok = (X != NULL) ;
+    if (ok)
+    {
+	Xx = X->x ;
+	for (k = 0 ; ok && k < n*n ; k++)
+	{
+	    ok = (Xx [k] == E [k]) ;
+	}
+    }
+    CHOLMOD(free_dense) (&X, cm) ;
+    return (ok) ;
+}
+
+
+/* ========================================================================== */
+/* === graph_write ========================================================== */
+/* ========================================================================== */
+
+/* Write the graph of S in METIS format.  S must have both its upper and lower
+ * triangular parts.  The diagonal of S is ignored, unless fmt is 100, in which
+ * case each self-edge is written once and every other edge twice.  A comment
+ * is written before the header and between some of the adjacency lists. */
+
+static void graph_write (const char *filename, cholmod_sparse *S, int fmt,
+    int crlf)
+{
+    FILE *f ;
+    const char *eol = crlf ? "\r\n" : "\n" ;
+    Int *Sp, *Si, *Snz, n, i, j, p, pend, nz, packed ;
+
+    f = fopen (filename, "wb") ;
+    OK (f != NULL) ;
+    n = S->ncol ;
+    Sp = S->p ;
+    Si = S->i ;
+    Snz = S->nz ;
+    packed = S->packed ;
+
+    nz = 0 ;
+    for (j = 0 ; j < n ; j++)
+    {
+	pend = packed ? (Sp [j+1]) : (Sp [j] + Snz [j]) ;
+	for (p = Sp [j] ; p < pend ; p++)
+	{
+	    if (Si [p] != j) nz++ ;
+	}
+    }
+
+    fprintf (f, "%% graph of a test matrix, fmt %d%s", fmt, eol) ;
+    switch (fmt)
+    {
+	case 0:  fprintf (f, ID" "ID"%s", n, nz/2, eol) ; break ;
+	case 11: fprintf (f, ID" "ID" 11 2%s", n, nz/2, eol) ; break ;
+	default: fprintf (f, ID" "ID" %d%s", n, nz/2, fmt, eol) ; break ;
+    }
+
+    for (j = 0 ; j < n ; j++)
+    {
+	if (j % 4 == 1)
+	{
+	    fprintf (f, "%% vertex "ID"%s", j+1, eol) ;
+	}
+	if (fmt == 10 || fmt == 11)
+	{
+	    fprintf (f, "%g", GRAPH_VW (j,0)) ;
+	}
+	if (fmt == 11)
+	{
+	    fprintf (f, " %g", GRAPH_VW (j,1)) ;
+	}
+	pend = packed ? (Sp [j+1]) : (Sp [j] + Snz [j]) ;
+	for (p = Sp [j] ; p < pend ; p++)
+	{
+	    i = Si [p] ;
+	    if (i == j)
+	    {
+		if (fmt == 100) fprintf (f, " "ID, i+1) ;
+		continue ;
+	    }
+	    fprintf (f, " "ID, i+1) ;
+	    if (fmt == 1 || fmt == 11)
+	    {
+		fprintf (f, " %g", GRAPH_EW (i,j)) ;
+	    }
+	    if (fmt == 100)
+	    {
+		fprintf (f, "\t"ID, i+1) ;
+	    }
+	}
+	fprintf (f, "%s", eol) ;
+    }
+    OK (fclose (f) == 0) ;
+}
+
+
+/* ========================================================================== */
+/* === graph ================================================================ */
+/* ========================================================================== */
+
+double graph (cholmod_sparse *A)
+{
+    double E [9], *Ex, *Wx ;
+    cholmod_sparse *AT, *S, *G, *G4 ;
+    cholmod_dense *Wd ;
+    FILE *f ;
+    Int *Sp, *Si, *Snz, *Gp, *Gi, n, i, j, k, p, pend, nedges, nself, t,
+	nt, ncon ;
+    int fmt, gfmt, stype, crlf, save ;
+    void (*save2) (int, const char *, int, const char *) ;
+
+    if (A == NULL)
+    {
+	ERROR (CHOLMOD_INVALID, "cm: no A for graph") ;
+	return (1) ;
+    }
+    if (A->nrow > NSMALL || A->ncol > NSMALL)
+    {
+	return (0) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* S = the pattern of A+A' or A*A', with both parts stored */
+    /* ---------------------------------------------------------------------- */
+
+    if (A->nrow != A->ncol)
+    {
+	S = CHOLMOD(aat) (A, NULL, 0, 0, cm) ;
+    }
+    else if (A->stype != 0)
+    {
+	S = CHOLMOD(copy) (A, 0, 0, cm) ;
+    }
+    else
+    {
+	AT = CHOLMOD(transpose) (A, 0, cm) ;
+	S = CHOLMOD(add) (A, AT, one, one, FALSE, TRUE, cm) ;
+	CHOLMOD(free_sparse) (&AT, cm) ;
+    }
+    if (S == NULL)
+    {
+	return (0) ;
+    }
+    n = S->ncol ;
+    Sp = S->p ;
+    Si = S->i ;
+    Snz = S->nz ;
+    Ex = CHOLMOD(malloc) (n*n, sizeof (double), cm) ;
+    if (Ex == NULL)
+    {
+	CHOLMOD(free_sparse) (&S, cm) ;
+	return (0) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* write and read the graph of S in each format */
+    /* ---------------------------------------------------------------------- */
+
+    for (fmt = 0 ; fmt <= 100 ; fmt = (fmt == 1) ? 10 : ((fmt == 11) ? 100 :
+	(fmt + 1)))
+    {
+	/* Ex = the expected result */
+	nedges = 0 ;
+	nself = 0 ;
+	for (k = 0 ; k < n*n ; k++)
+	{
+	    Ex [k] = 0 ;
+	}
+	for (j = 0 ; j < n ; j++)
+	{
+	    pend = (S->packed) ? (Sp [j+1]) : (Sp [j] + Snz [j]) ;
+	    for (p = Sp [j] ; p < pend ; p++)
+	    {
+		i = Si [p] ;
+		if (i == j)
+		{
+		    if (fmt == 100)
+		    {
+			Ex [j+j*n] = 1 ;
+			nself++ ;
+		    }
+		}
+		else
+		{
+		    Ex [i+j*n] = (fmt == 1 || fmt == 11) ? GRAPH_EW (i,j) :
+			((fmt == 100) ? 2 : 1) ;
+		    nedges++ ;
+		}
+	    }
+	}
+	ncon = (fmt == 10) ? 1 : ((fmt == 11) ? 2 : 0) ;
+
+	for (crlf = 0 ; crlf <= 1 ; crlf++)
+	{
+	    graph_write ("temp.graph", S, fmt, crlf) ;
+	    for (stype = -1 ; stype <= 1 ; stype++)
+	    {
+		f = fopen ("temp.graph", "rb") ;
+		OK (f != NULL) ;
+		gfmt = -1 ;
+		G = CHOLMOD(read_graph) (f, stype, &Wd, &gfmt, cm) ;
+		OK (fclose (f) == 0) ;
+		OK (graph_same (G, Ex, n, stype)) ;
+		OK (gfmt == fmt) ;
+		if (ncon == 0)
+		{
+		    NOP (Wd) ;
+		}
+		else
+		{
+		    OKP (Wd) ;
+		    OK (Wd->nrow == n && Wd->ncol == ncon) ;
+		    Wx = Wd->x ;
+		    for (k = 0 ; k < ncon ; k++)
+		    {
+			for (j = 0 ; j < n ; j++)
+			{
+			    OK (Wx [j+k*Wd->d] == GRAPH_VW (j,k)) ;
+			}
+		    }
+		}
+		CHOLMOD(free_sparse) (&G, cm) ;
+		CHOLMOD(free_dense) (&Wd, cm) ;
+	    }
+	}
+
+	/* W and fmt are optional */
+	f = fopen ("temp.graph", "rb") ;
+	OK (f != NULL) ;
+	G = CHOLMOD(read_graph) (f, 0, NULL, NULL, cm) ;
+	OK (fclose (f) == 0) ;
+	OK (graph_same (G, Ex, n, 0)) ;
+	CHOLMOD(free_sparse) (&G, cm) ;
+    }
+    printf ("graph: n "ID" edges "ID" self-edges "ID"\n", n, nedges/2, nself) ;
+
+    CHOLMOD(free) (n*n, sizeof (double), Ex, cm) ;
+    CHOLMOD(free_sparse) (&S, cm) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* small graphs */
+    /* ---------------------------------------------------------------------- */
+
+    /* a path 1-2-3, with comments, CRLF line endings, and no fmt */
+    for (k = 0 ; k < 9 ; k++) E [k] = 0 ;
+    E [1] = E [3] = E [5] = E [7] = 1 ;
+    G = graph_text ("%comment\r\n% another\r\n3 2\r\n2\r\n1 3\r\n%\r\n2\r\n",
+	0, &Wd, &gfmt) ;
+    OK (graph_same (G, E, 3, 0) && gfmt == 0) ;
+    NOP (Wd) ;
+    CHOLMOD(free_sparse) (&G, cm) ;
+
+    /* the same path, with no final newline and with lines after the nth */
+    G = graph_text ("3 2 0 0\n2\n1  3\n2\n3 2 1\n", 1, NULL, &gfmt) ;
+    OK (graph_same (G, E, 3, 1) && gfmt == 0) ;
+    CHOLMOD(free_sparse) (&G, cm) ;
+    G = graph_text ("3 2\n2\n1 3\n2", -1, NULL, &gfmt) ;
+    OK (graph_same (G, E, 3, -1) && gfmt == 0) ;
+    CHOLMOD(free_sparse) (&G, cm) ;
+
+    /* missing adjacency lists are empty */
+    for (k = 0 ; k < 9 ; k++) E [k] = 0 ;
+    G = graph_text ("3 0\n", 0, NULL, &gfmt) ;
+    OK (graph_same (G, E, 3, 0) && gfmt == 0) ;
+    CHOLMOD(free_sparse) (&G, cm) ;
+
+    /* a duplicate edge and a self-edge: a multigraph */
+    E [0] = 1 ;
+    E [1] = E [2] = 2 ;
+    E [3] = 0 ;
+    G = graph_text ("2 1\n2 1 2\n1 1\n", 0, NULL, &gfmt) ;
+    OK (graph_same (G, E, 2, 0) && gfmt == 100) ;
+    CHOLMOD(free_sparse) (&G, cm) ;
+
+    /* weights of duplicate edges are summed */
+    E [0] = 0 ;
+    E [1] = E [2] = 3.5 ;
+    E [3] = 0 ;
+    G = graph_text ("2 1 1\n2 1.5 2 2e0\n1 3.5\n", 0, NULL, &gfmt) ;
+    OK (graph_same (G, E, 2, 0) && gfmt == 100) ;
+    CHOLMOD(free_sparse) (&G, cm) ;
+
+    /* an empty graph */
+    G = graph_text ("0 0\n", 0, NULL, &gfmt) ;
+    OK (graph_same (G, E, 0, 0) && gfmt == 0) ;
+    CHOLMOD(free_sparse) (&G, cm) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* a large grid, read with one and with four threads */
+    /* ---------------------------------------------------------------------- */
+
+    /* The file is large enough to be split among several threads, and its
+     * comments fall in different chunks of the file. */
+
+    t = 150 ;
+    f = fopen ("temp.graph", "wb") ;
+    OK (f != NULL) ;
+    fprintf (f, ID" "ID" 1\n", t*t, 2*t*(t-1)) ;
+    for (j = 0 ; j < t*t ; j++)
+    {
+	if (j % 1000 == 999)
+	{
+	    fprintf (f, "%% vertex "ID"\n", j+1) ;
+	}
+	if (j >= t)	    fprintf (f, " "ID" %g", j+1-t, GRAPH_EW (j-t,j)) ;
+	if (j % t > 0)	    fprintf (f, " "ID" %g", j, GRAPH_EW (j-1,j)) ;
+	if (j % t < t-1)    fprintf (f, " "ID" %g", j+2, GRAPH_EW (j+1,j)) ;
+	if (j < t*(t-1))    fprintf (f, " "ID" %g", j+1+t, GRAPH_EW (j+t,j)) ;
+	fprintf (f, "\n") ;
+    }
+    OK (fclose (f) == 0) ;
+
+    save = cm->read_graph_nthreads ;
+    cm->read_graph_nthreads = 1 ;
+    f = fopen ("temp.graph", "rb") ;
+    OK (f != NULL) ;
+    G = CHOLMOD(read_graph) (f, 0, NULL, &gfmt, cm) ;
+    OK (fclose (f) == 0) ;
+    cm->read_graph_nthreads = 4 ;
+    f = fopen ("temp.graph", "rb") ;
+    OK (f != NULL) ;
+    G4 = CHOLMOD(read_graph) (f, 0, NULL, &gfmt, cm) ;
+    OK (fclose (f) == 0) ;
+    cm->read_graph_nthreads = save ;
+
+    if (G != NULL && G4 != NULL)
+    {
+	OK (gfmt == 1) ;
+	OK (CHOLMOD(check_sparse) (G, cm)) ;
+	Gp = G->p ;
+	Gi = G->i ;
+	nt = Gp [t*t] ;
+	OK (nt == 4*t*(t-1)) ;
+	OK (nt == ((Int *) (G4->p)) [t*t]) ;
+	for (j = 0 ; j <= t*t ; j++)
+	{
+	    OK (Gp [j] == ((Int *) (G4->p)) [j]) ;
+	}
+	for (p = 0 ; p < nt ; p++)
+	{
+	    OK (Gi [p] == ((Int *) (G4->i)) [p]) ;
+	    OK (((double *) (G->x)) [p] == ((double *) (G4->x)) [p]) ;
+	}
+	for (j = 0 ; j < t*t ; j++)
+	{
+	    for (p = Gp [j] ; p < Gp [j+1] ; p++)
+	    {
+		OK (((double *) (G->x)) [p] == GRAPH_EW (Gi [p], j)) ;
+	    }
+	}
+    }
+    CHOLMOD(free_sparse) (&G, cm) ;
+    CHOLMOD(free_sparse) (&G4, cm) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* error tests */
+    /* ---------------------------------------------------------------------- */
+
+    save2 = cm->error_handler ;
+    cm->error_handler = NULL ;
+
+    /* invalid headers */
+    NOP (graph_text ("", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_INVALID) ;
+    NOP (graph_text ("% only a comment\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_INVALID) ;
+    NOP (graph_text ("3\n2\n1 3\n2\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_INVALID) ;
+    NOP (graph_text ("three 2\n2\n1 3\n2\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_INVALID) ;
+    NOP (graph_text ("-3 2\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_INVALID) ;
+    NOP (graph_text ("2.5 2\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_INVALID) ;
+    NOP (graph_text ("nan 2\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_INVALID) ;
+    NOP (graph_text ("3 2 2\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_INVALID) ;
+    NOP (graph_text ("3 2 10 -1\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_INVALID) ;
+
+    /* n or ncon too large for an Int */
+    NOP (graph_text ("1e30 2\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_TOO_LARGE) ;
+    NOP (graph_text ("18446744073709551616 2\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_TOO_LARGE) ;
+    NOP (graph_text ("inf 2\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_TOO_LARGE) ;
+    NOP (graph_text ("3 2 10 1e30\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_TOO_LARGE) ;
+
+    /* unsymmetric graphs */
+    NOP (graph_text ("3 2\n2\n3\n2\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_INVALID) ;
+    NOP (graph_text ("2 1 1\n2 1\n1 2\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_INVALID) ;
+    NOP (graph_text ("2 1\n2 2\n1\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_INVALID) ;
+
+    /* invalid vertices */
+    NOP (graph_text ("2 1\n3\n1\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_INVALID) ;
+    NOP (graph_text ("2 1\n0\n1\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_INVALID) ;
+    NOP (graph_text ("2 1\n-1\n1\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_INVALID) ;
+    NOP (graph_text ("2 1\n1.5\n1\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_INVALID) ;
+    NOP (graph_text ("2 1\n2x\n1\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_INVALID) ;
+
+    /* invalid vertex and edge weights */
+    NOP (graph_text ("2 1 1\n2\n1\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_INVALID) ;
+    NOP (graph_text ("2 1 1\n2 0\n1 0\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_INVALID) ;
+    NOP (graph_text ("2 1 1\n2 w\n1 w\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_INVALID) ;
+    NOP (graph_text ("2 1 10\n-1 2\n1 1\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_INVALID) ;
+    NOP (graph_text ("2 1 10\n0.5 2\n1 1\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_INVALID) ;
+    NOP (graph_text ("2 1 10\n\n1 1\n", 0, NULL, NULL)) ;
+    OK (cm->status == CHOLMOD_INVALID) ;
+
+    /* NULL inputs */
+    f = fopen ("temp.graph", "rb") ;
+    OK (f != NULL) ;
+    NOP (CHOLMOD(read_graph) (f, 0, NULL, NULL, NULL)) ;
+    OK (fclose (f) == 0) ;
+    NOP (CHOLMOD(read_graph) (NULL, 0, NULL, NULL, cm)) ;
+
+    cm->error_handler = save2 ;
+    return (0) ;
+}
@@ -0,0 +1,233 @@
+/* ========================================================================== */
+/* === Tcov/sparseinv ======================================================= */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * CHOLMOD/Tcov Module.  Copyright (C) 2026, the CHOLMOD contributors.
+ * http://www.suitesparse.com
+ * -------------------------------------------------------------------------- */
+
+/* Test cholmod_super_sparseinv.  A diagonally dominant matrix S with the
+ * pattern of A*A'+I (Hermitian if A is complex) is factorized with a
+ * supernodal LL', and the sparse inverse subset Z is compared with the same
+ * entries of inv(S), found by solving S*X=I.  Z(i,j) is inv(S)(Perm [i], Perm [j]).  Z is also computed with one
+ * and with four threads, which must give the same result.  Returns the
+ * relative error.
+ */
+
+#include "cm.h"
+
+
+/* ========================================================================== */
+/* === sparseinv ============================================================ */
+/* ========================================================================== */
+
+double sparseinv (cholmod_sparse *A)
+{
+    double err, maxerr = 0, xnorm = 0, zr, zi, xr, xi, s ;
+    cholmod_sparse *A1, *C, *I, *S, *Z, *Z4 ;
+    cholmod_dense *B, *X ;
+    cholmod_factor *L, *L2 ;
+    double *Zx, *Z4x, *Xx, *Sx, *W ;
+    Int *Zp, *Zi, *Sp, *Si, *Perm ;
+    Int n, i, j, p, k, xtype, cplx, save, save2, save3 ;
+    void (*save4) (int, const char *, int, const char *) ;
+
+    if (A == NULL)
+    {
+	ERROR (CHOLMOD_INVALID, "cm: no A for sparseinv") ;
+	return (1) ;
+    }
+
+    n = A->nrow ;
+    if (A->xtype == CHOLMOD_PATTERN || n == 0 || n > NSMALL)
+    {
+	return (0) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* S = A*A'+I, real, with only the lower triangular part stored */
+    /* ---------------------------------------------------------------------- */
+
+    A1 = CHOLMOD(copy_sparse) (A, cm) ;
+    CHOLMOD(sparse_xtype) (CHOLMOD_REAL, A1, cm) ;
+    if (A1 != NULL && A1->stype != 0)
+    {
+	C = CHOLMOD(copy) (A1, 0, 1, cm) ;
+	CHOLMOD(free_sparse) (&A1, cm) ;
+	A1 = C ;
+    }
+    C = CHOLMOD(aat) (A1, NULL, 0, 1, cm) ;
+    I = CHOLMOD(speye) (n, n, CHOLMOD_REAL, cm) ;
+    S = CHOLMOD(add) (C, I, one, one, TRUE, TRUE, cm) ;
+    CHOLMOD(free_sparse) (&A1, cm) ;
+    CHOLMOD(free_sparse) (&C, cm) ;
+    CHOLMOD(free_sparse) (&I, cm) ;
+    C = CHOLMOD(copy) (S, -1, 1, cm) ;
+    CHOLMOD(free_sparse) (&S, cm) ;
+    S = C ;
+
+    /* ---------------------------------------------------------------------- */
+    /* make S Hermitian if A is complex, and diagonally dominant */
+    /* ---------------------------------------------------------------------- */
+
+    cplx = (A->xtype != CHOLMOD_REAL) ;
+    xtype = cplx ? CHOLMOD_COMPLEX : CHOLMOD_REAL ;
+    CHOLMOD(sparse_xtype) (xtype, S, cm) ;
+    W = CHOLMOD(calloc) (n, sizeof (double), cm) ;
+    if (S != NULL && W != NULL)
+    {
+	Sp = S->p ;
+	Si = S->i ;
+	Sx = S->x ;
+	for (j = 0 ; j < n ; j++)
+	{
+	    for (p = Sp [j] ; p < Sp [j+1] ; p++)
+	    {
+		i = Si [p] ;
+		if (i > j)
+		{
+		    if (cplx) Sx [2*p+1] = Sx [2*p] / 2 ;
+		    s = cplx ? hypot (Sx [2*p], Sx [2*p+1]) : fabs (Sx [p]) ;
+		    W [i] += s ;
+		    W [j] += s ;
+		}
+	    }
+	}
+	for (j = 0 ; j < n ; j++)
+	{
+	    for (p = Sp [j] ; p < Sp [j+1] ; p++)
+	    {
+		if (Si [p] == j)
+		{
+		    Sx [cplx ? 2*p : p] = 1 + W [j] ;
+		}
+	    }
+	}
+    }
+    CHOLMOD(free) (n, sizeof (double), W, cm) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* supernodal LL' factorization */
+    /* ---------------------------------------------------------------------- */
+
+    save = cm->supernodal ;
+    save2 = cm->final_asis ;
+    save3 = cm->sparseinv_nthreads ;
+    cm->supernodal = CHOLMOD_SUPERNODAL ;
+    cm->final_asis = TRUE ;
+
+    L = CHOLMOD(analyze) (S, cm) ;
+    CHOLMOD(factorize) (S, L, cm) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* Z = sparse inverse subset, with one and with four threads */
+    /* ---------------------------------------------------------------------- */
+
+    cm->sparseinv_nthreads = 1 ;
+    Z = CHOLMOD(super_sparseinv) (L, cm) ;
+    cm->sparseinv_nthreads = 4 ;
+    Z4 = CHOLMOD(super_sparseinv) (L, cm) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* X = inv(S) */
+    /* ---------------------------------------------------------------------- */
+
+    B = CHOLMOD(eye) (n, n, xtype, cm) ;
+    X = CHOLMOD(solve) (CHOLMOD_A, L, B, cm) ;
+    CHOLMOD(free_dense) (&B, cm) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* compare Z with inv(S) and with Z4 */
+    /* ---------------------------------------------------------------------- */
+
+    if (Z != NULL && Z4 != NULL && X != NULL && L->minor == n)
+    {
+	OK (Z->nrow == n && Z->ncol == n && Z->stype == -1) ;
+	OK (Z->xtype == L->xtype && Z4->xtype == L->xtype) ;
+	OK (CHOLMOD(print_sparse) (Z, "Z = sparseinv (L)", cm)) ;
+	Zp = Z->p ;
+	Zi = Z->i ;
+	Zx = Z->x ;
+	Z4x = Z4->x ;
+	Xx = X->x ;
+	Perm = L->Perm ;
+	OK (Zp [n] == ((Int *) (Z4->p)) [n]) ;
+
+	for (k = 0 ; k < n*n ; k++)
+	{
+	    xnorm = MAX (xnorm, cplx ? hypot (Xx [2*k], Xx [2*k+1]) :
+		fabs (Xx [k])) ;
+	}
+
+	err = 0 ;
+	for (j = 0 ; j < n ; j++)
+	{
+	    for (p = Zp [j] ; p < Zp [j+1] ; p++)
+	    {
+		i = Zi [p] ;
+		OK (i >= j && i < n) ;
+		OK (i == ((Int *) (Z4->i)) [p]) ;
+		k = Perm [i] + Perm [j] * n ;
+		if (cplx)
+		{
+		    zr = Zx [2*p] ;
+		    zi = Zx [2*p+1] ;
+		    xr = Xx [2*k] ;
+		    xi = Xx [2*k+1] ;
+		    err = MAX (err, hypot (zr - xr, zi - xi)) ;
+		    OK (zr == Z4x [2*p] && zi == Z4x [2*p+1]) ;
+		}
+		else
+		{
+		    err = MAX (err, fabs (Zx [p] - Xx [k])) ;
+		    OK (Zx [p] == Z4x [p]) ;
+		}
+	    }
+	}
+	printf ("sparseinv err %g xnorm %g nnz(Z) "ID"\n", err, xnorm, Zp [n]) ;
+	MAXERR (maxerr, err, xnorm) ;
+    }
+
+    CHOLMOD(free_dense) (&X, cm) ;
+    CHOLMOD(free_sparse) (&Z, cm) ;
+    CHOLMOD(free_sparse) (&Z4, cm) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* error tests */
+    /* ---------------------------------------------------------------------- */
+
+    save4 = cm->error_handler ;
+    cm->error_handler = NULL ;
+
+    Z = CHOLMOD(super_sparseinv) (NULL, cm) ;
+    NOP (Z) ;
+    Z = CHOLMOD(super_sparseinv) (L, NULL) ;
+    NOP (Z) ;
+
+    if (L != NULL)
+    {
+	/* simplicial L */
+	L2 = CHOLMOD(copy_factor) (L, cm) ;
+	CHOLMOD(change_factor) (L->xtype, TRUE, FALSE, TRUE, TRUE, L2, cm) ;
+	Z = CHOLMOD(super_sparseinv) (L2, cm) ;
+	NOP (Z) ;
+	CHOLMOD(free_factor) (&L2, cm) ;
+
+	/* L not positive definite */
+	L->minor = n-1 ;
+	Z = CHOLMOD(super_sparseinv) (L, cm) ;
+	NOP (Z) ;
+	OK (cm->status == CHOLMOD_INVALID) ;
+	L->minor = n ;
+    }
+
+    cm->error_handler = save4 ;
+    cm->supernodal = save ;
+    cm->final_asis = save2 ;
+    cm->sparseinv_nthreads = save3 ;
+
+    CHOLMOD(free_factor) (&L, cm) ;
+    CHOLMOD(free_sparse) (&S, cm) ;
+    return (maxerr) ;
+}
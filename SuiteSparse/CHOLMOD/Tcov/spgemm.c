@@ -0,0 +1,281 @@
+/* ========================================================================== */
+/* === Tcov/spgemm ========================================================== */
+/* ========================================================================== */
+
+/* -----------------------------------------------------------------------------
+ * CHOLMOD/Tcov Module.  Copyright (C) 2026, the CHOLMOD contributors.
+ * http://www.suitesparse.com
+ * -------------------------------------------------------------------------- */
+
+/* Test cholmod_spgemm.  C = A*A' (or A*A if A is symmetric) is computed with
+ * one and with four threads, and compared with a dense reference product.
+ * A complex symmetric A is Hermitian.  The numeric phase is then repeated
+ * for new values of A, and the error cases are checked.  Returns the
+ * relative error.
+ */
+
+#include "cm.h"
+
+
+/* ========================================================================== */
+/* === spgemm_err =========================================================== */
+/* ========================================================================== */
+
+/* Returns norm (C-D,inf), where C is sparse and D is dense. */
+
+static double spgemm_err (cholmod_sparse *C, cholmod_dense *D)
+{
+    double err = 0 ;
+    cholmod_dense *X ;
+    double *Xx, *Dx ;
+    Int k, len ;
+
+    X = CHOLMOD(sparse_to_dense) (C, cm) ;
+    if (X == NULL || D == NULL)
+    {
+	CHOLMOD(free_dense) (&X, cm) ;
+	return (0) ;
+    }
+    OK (X->nrow == D->nrow && X->ncol == D->ncol && X->xtype == D->xtype) ;
+    Xx = X->x ;
+    Dx = D->x ;
+    len = D->nrow * D->ncol ;
+    if (D->xtype == CHOLMOD_COMPLEX)
+    {
+	for (k = 0 ; k < len ; k++)
+	{
+	    err = MAX (err, hypot (Xx [2*k] - Dx [2*k], Xx [2*k+1] - Dx [2*k+1]));
+	}
+    }
+    else
+    {
+	for (k = 0 ; k < len ; k++)
+	{
+	    err = MAX (err, fabs (Xx [k] - Dx [k])) ;
+	}
+    }
+    CHOLMOD(free_dense) (&X, cm) ;
+    return (err) ;
+}
+
+
+/* ========================================================================== */
+/* === spgemm ================================================================ */
+/* ========================================================================== */
+
+double spgemm (cholmod_sparse *A)
+{
+    double err, maxerr = 0, cnorm = 0, s ;
+    cholmod_sparse *A1, *B, *C, *C4, *P, *Breal ;
+    cholmod_dense *Ad, *Bd, *D ;
+    double *Ax, *Adx, *Bdx, *Dx, *Cx, *C4x ;
+    Int *Ap, *Ai, *Anz ;
+    Int m, n, k, i, j, t, p, pend, cplx, save, cnz ;
+    void (*save2) (int, const char *, int, const char *) ;
+
+    if (A == NULL)
+    {
+	ERROR (CHOLMOD_INVALID, "cm: no A for spgemm") ;
+	return (1) ;
+    }
+
+    if (A->xtype == CHOLMOD_PATTERN || A->nrow > NSMALL || A->ncol > NSMALL)
+    {
+	return (0) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* A1 = A, complex if A is zomplex, with a real diagonal if Hermitian */
+    /* ---------------------------------------------------------------------- */
+
+    A1 = CHOLMOD(copy_sparse) (A, cm) ;
+    if (A1 == NULL)
+    {
+	return (0) ;
+    }
+    cplx = (A1->xtype != CHOLMOD_REAL) ;
+    CHOLMOD(sparse_xtype) (cplx ? CHOLMOD_COMPLEX : CHOLMOD_REAL, A1, cm) ;
+    Ap = A1->p ;
+    Ai = A1->i ;
+    Anz = A1->nz ;
+    Ax = A1->x ;
+    if (cplx && A1->stype != 0)
+    {
+	for (j = 0 ; j < (Int) A1->ncol ; j++)
+	{
+	    p = Ap [j] ;
+	    pend = (A1->packed) ? (Ap [j+1]) : (p + Anz [j]) ;
+	    for ( ; p < pend ; p++)
+	    {
+		if (Ai [p] == j) Ax [2*p+1] = 0 ;
+	    }
+	}
+    }
+
+    /* B = A1 if A1 is symmetric, or A1' otherwise */
+    B = (A1->stype != 0) ? CHOLMOD(copy_sparse) (A1, cm) :
+	CHOLMOD(transpose) (A1, 2, cm) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* D = A1*B, dense */
+    /* ---------------------------------------------------------------------- */
+
+    m = A1->nrow ;
+    n = (B == NULL) ? 0 : B->ncol ;
+    Ad = CHOLMOD(sparse_to_dense) (A1, cm) ;
+    Bd = CHOLMOD(sparse_to_dense) (B, cm) ;
+    D = CHOLMOD(zeros) (m, n, A1->xtype, cm) ;
+    if (Ad != NULL && Bd != NULL && D != NULL)
+    {
+	Adx = Ad->x ;
+	Bdx = Bd->x ;
+	Dx = D->x ;
+	for (j = 0 ; j < n ; j++)
+	{
+	    for (t = 0 ; t < (Int) A1->ncol ; t++)
+	    {
+		for (i = 0 ; i < m ; i++)
+		{
+		    if (cplx)
+		    {
+			Dx [2*(i+j*m)  ] +=
+			    Adx [2*(i+t*m)  ] * Bdx [2*(t+j*A1->ncol)  ]
+			  - Adx [2*(i+t*m)+1] * Bdx [2*(t+j*A1->ncol)+1] ;
+			Dx [2*(i+j*m)+1] +=
+			    Adx [2*(i+t*m)+1] * Bdx [2*(t+j*A1->ncol)  ]
+			  + Adx [2*(i+t*m)  ] * Bdx [2*(t+j*A1->ncol)+1] ;
+		    }
+		    else
+		    {
+			Dx [i+j*m] += Adx [i+t*m] * Bdx [t+j*A1->ncol] ;
+		    }
+		}
+	    }
+	}
+	for (k = 0 ; k < m*n ; k++)
+	{
+	    s = cplx ? hypot (Dx [2*k], Dx [2*k+1]) : fabs (Dx [k]) ;
+	    cnorm = MAX (cnorm, s) ;
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* C = A1*B with one and with four threads */
+    /* ---------------------------------------------------------------------- */
+
+    save = cm->spgemm_nthreads ;
+    cm->spgemm_nthreads = 1 ;
+    C = CHOLMOD(spgemm) (A1, B, TRUE, cm) ;
+    cm->spgemm_nthreads = 4 ;
+    C4 = CHOLMOD(spgemm) (A1, B, TRUE, cm) ;
+
+    if (C != NULL && C4 != NULL)
+    {
+	OK (CHOLMOD(check_sparse) (C, cm)) ;
+	OK (C->sorted && C->packed && C->stype == 0) ;
+	OK (C->xtype == A1->xtype) ;
+	err = spgemm_err (C, D) ;
+	printf ("spgemm err %g cnorm %g\n", err, cnorm) ;
+	MAXERR (maxerr, err, cnorm) ;
+
+	/* the result does not depend on the number of threads */
+	cnz = ((Int *) (C->p)) [n] ;
+	OK (cnz == ((Int *) (C4->p)) [n]) ;
+	Cx = C->x ;
+	C4x = C4->x ;
+	for (p = 0 ; p < cnz ; p++)
+	{
+	    OK (((Int *) (C->i)) [p] == ((Int *) (C4->i)) [p]) ;
+	}
+	for (p = 0 ; p < (cplx ? 2*cnz : cnz) ; p++)
+	{
+	    OK (Cx [p] == C4x [p]) ;
+	}
+
+	/* pattern only */
+	P = CHOLMOD(spgemm) (A1, B, FALSE, cm) ;
+	if (P != NULL)
+	{
+	    OK (P->xtype == CHOLMOD_PATTERN) ;
+	    OK (((Int *) (P->p)) [n] == cnz) ;
+	    for (p = 0 ; p < cnz ; p++)
+	    {
+		OK (((Int *) (C->i)) [p] == ((Int *) (P->i)) [p]) ;
+	    }
+	}
+	CHOLMOD(free_sparse) (&P, cm) ;
+
+	/* new values of A1, same pattern: C4 = (2*A1)*B */
+	Ax = A1->x ;
+	for (j = 0 ; j < (Int) A1->ncol ; j++)
+	{
+	    p = Ap [j] ;
+	    pend = (A1->packed) ? (Ap [j+1]) : (p + Anz [j]) ;
+	    for ( ; p < pend ; p++)
+	    {
+		if (cplx)
+		{
+		    Ax [2*p] *= 2 ;
+		    Ax [2*p+1] *= 2 ;
+		}
+		else
+		{
+		    Ax [p] *= 2 ;
+		}
+	    }
+	}
+	OK (CHOLMOD(spgemm_numeric) (A1, B, C4, cm)) ;
+	if (D != NULL)
+	{
+	    Dx = D->x ;
+	    for (k = 0 ; k < (cplx ? 2*m*n : m*n) ; k++)
+	    {
+		Dx [k] *= 2 ;
+	    }
+	}
+	err = spgemm_err (C4, D) ;
+	MAXERR (maxerr, err, 2*cnorm) ;
+
+	/* ------------------------------------------------------------------ */
+	/* error tests */
+	/* ------------------------------------------------------------------ */
+
+	save2 = cm->error_handler ;
+	cm->error_handler = NULL ;
+
+	P = CHOLMOD(spgemm) (NULL, B, TRUE, cm) ;
+	NOP (P) ;
+	P = CHOLMOD(spgemm) (A1, B, TRUE, NULL) ;
+	NOP (P) ;
+	if (A1->nrow != A1->ncol)
+	{
+	    P = CHOLMOD(spgemm) (A1, A1, TRUE, cm) ;
+	    NOP (P) ;
+	    OK (cm->status == CHOLMOD_INVALID) ;
+	}
+	OK (!CHOLMOD(spgemm_numeric) (A1, B, NULL, cm)) ;
+	OK (!CHOLMOD(spgemm_numeric) (B, A1, C, cm) || m == n) ;
+	if (cplx)
+	{
+	    /* A1 and B must have the same xtype */
+	    Breal = CHOLMOD(copy_sparse) (B, cm) ;
+	    CHOLMOD(sparse_xtype) (CHOLMOD_REAL, Breal, cm) ;
+	    P = CHOLMOD(spgemm) (A1, Breal, TRUE, cm) ;
+	    NOP (P) ;
+	    OK (!CHOLMOD(spgemm_numeric) (A1, Breal, C, cm)) ;
+	    CHOLMOD(free_sparse) (&Breal, cm) ;
+	}
+
+	cm->error_handler = save2 ;
+    }
+
+    cm->spgemm_nthreads = save ;
+    CHOLMOD(free_sparse) (&C, cm) ;
+    CHOLMOD(free_sparse) (&C4, cm) ;
+    CHOLMOD(free_dense) (&Ad, cm) ;
+    CHOLMOD(free_dense) (&Bd, cm) ;
+    CHOLMOD(free_dense) (&D, cm) ;
+    CHOLMOD(free_sparse) (&B, cm) ;
+    CHOLMOD(free_sparse) (&A1, cm) ;
+    return (maxerr) ;
+}
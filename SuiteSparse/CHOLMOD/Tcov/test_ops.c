@@ -839,9 +839,11 @@ double test_ops (cholmod_sparse *A)
 #ifndef NPARTITION
     if (A != NULL && A->nrow == A->ncol)
     {
-	SuiteSparse_long nc, nc_new ;
+	SuiteSparse_long nc, nc_new, nc4 ;
 	Int cnz, csep, save2 ;
-	Int *Cnw, *Cew, *Cmember, *CParent, *Perm ;
+	Int *Cnw, *Cew, *Cmember, *CParent, *Perm, *Cmember4, *CParent4, *Perm4 ;
+	int save3 ;
+	size_t save4, save5 ;
 	double save1 ;
 
 	/* try CHOLMOD's interface to METIS_ComputeVertexSeparator */
@@ -912,6 +914,40 @@ double test_ops (cholmod_sparse *A)
 	    OK (CHOLMOD(check_perm) (Perm, n, n, cm)) ;
 	}
 
+	/* bisect the subgraphs in parallel; the result must be the same */
+	Cmember4 = CHOLMOD(malloc) (nrow, sizeof (Int), cm) ;
+	CParent4 = CHOLMOD(malloc) (nrow, sizeof (Int), cm) ;
+	Perm4 = CHOLMOD(malloc) (nrow, sizeof (Int), cm) ;
+	if (nc > 0 && n > 0 && Cmember4 != NULL && CParent4 != NULL &&
+	    Perm4 != NULL)
+	{
+	    save3 = cm->nd_nthreads ;
+	    save4 = cm->malloc_count ;
+	    save5 = cm->memory_inuse ;
+	    cm->nd_nthreads = 4 ;
+	    nc4 = CHOLMOD(nested_dissection) (A, NULL, 0, Perm4, CParent4,
+		Cmember4, cm) ;
+	    cm->nd_nthreads = save3 ;
+	    if (nc4 > 0)
+	    {
+		/* the statistics of the tasks are merged back into cm */
+		OK (cm->malloc_count == save4 && cm->memory_inuse == save5) ;
+		OK (cm->memory_usage >= cm->memory_inuse) ;
+		OK (nc4 == nc) ;
+		for (j = 0 ; j < n ; j++)
+		{
+		    OK (Perm4 [j] == Perm [j] && Cmember4 [j] == Cmember [j]) ;
+		}
+		for (j = 0 ; j < nc ; j++)
+		{
+		    OK (CParent4 [j] == CParent [j]) ;
+		}
+	    }
+	}
+	CHOLMOD(free) (nrow, sizeof (Int), Cmember4, cm) ;
+	CHOLMOD(free) (nrow, sizeof (Int), CParent4, cm) ;
+	CHOLMOD(free) (nrow, sizeof (Int), Perm4, cm) ;
+
 	CHOLMOD(free_work) (cm) ;
 
 	/* collapse the septree */
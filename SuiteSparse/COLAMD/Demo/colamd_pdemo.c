@@ -0,0 +1,278 @@
+/* ========================================================================== */
+/* === colamd and symamd parallel setup demo ================================ */
+/* ========================================================================== */
+
+/* COLAMD / SYMAMD parallel setup demo
+
+    Orders a tall and thin 4000-by-120 matrix with colamd, using one thread
+    and the Alen from colamd_recommended, then four threads with the same
+    Alen, then four threads with the smaller Alen from
+    colamd_compact_recommended.  The column ordering does not depend on the
+    number of threads or on Alen, so all three must be identical.  colamd
+    then orders the 5-point mesh on a 40-by-40 grid with one and four
+    threads, using the smallest Alen that it accepts, which forces it to do
+    garbage collection; the two orderings must again be identical.  symamd is
+    then used to order the same mesh, with one and four threads.  The output
+    does not depend on whether OpenMP is available.
+*/
+
+/* ========================================================================== */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "colamd.h"
+
+#define NROW 4000
+#define NCOL 120
+#define NDENSE 3
+#define GRID 40
+#define NGRID (GRID*GRID)
+
+/* simple linear congruential generator, so the output is portable */
+static unsigned int seed = 1 ;
+static int irand (int n)
+{
+    seed = seed * 1103515245 + 12345 ;
+    return ((int) ((seed / 65536) % 32768) % n) ;
+}
+
+/* construct the column form of the NROW-by-NCOL test matrix.  Each row has
+   three distinct entries, except for NDENSE dense rows at the bottom. */
+static int *make_colamd (int *Ap, int *nnz)
+{
+    int *Ti, *Tj, *Ai, *W, i, j, k, c [3], nz ;
+    nz = 3 * (NROW - NDENSE) + NDENSE * NCOL ;
+    Ti = (int *) malloc (nz * sizeof (int)) ;
+    Tj = (int *) malloc (nz * sizeof (int)) ;
+    W  = (int *) calloc (NCOL + 1, sizeof (int)) ;
+    if (!Ti || !Tj || !W) exit (1) ;
+    k = 0 ;
+    for (i = 0 ; i < NROW - NDENSE ; i++)
+    {
+	c [0] = i % NCOL ;
+	do { c [1] = irand (NCOL) ; } while (c [1] == c [0]) ;
+	do { c [2] = irand (NCOL) ; } while (c [2] == c [0] || c [2] == c [1]);
+	for (j = 0 ; j < 3 ; j++)
+	{
+	    Ti [k] = i ;
+	    Tj [k] = c [j] ;
+	    k++ ;
+	}
+    }
+    for ( ; i < NROW ; i++)
+    {
+	for (j = 0 ; j < NCOL ; j++)
+	{
+	    Ti [k] = i ;
+	    Tj [k] = j ;
+	    k++ ;
+	}
+    }
+    /* the triplets are in row order, so each column is sorted */
+    for (k = 0 ; k < nz ; k++) W [Tj [k]]++ ;
+    Ap [0] = 0 ;
+    for (j = 0 ; j < NCOL ; j++)
+    {
+	Ap [j+1] = Ap [j] + W [j] ;
+	W [j] = Ap [j] ;
+    }
+    Ai = (int *) malloc (colamd_recommended (nz, NROW, NCOL) * sizeof (int)) ;
+    if (!Ai) exit (1) ;
+    for (k = 0 ; k < nz ; k++) Ai [W [Tj [k]]++] = Ti [k] ;
+    free (Ti) ;
+    free (Tj) ;
+    free (W) ;
+    *nnz = nz ;
+    return (Ai) ;
+}
+
+/* order the test matrix with colamd and return the column ordering */
+static int *order_colamd (int nthreads, int compact)
+{
+    double knobs [COLAMD_KNOBS] ;
+    int stats [COLAMD_STATS] ;
+    int *A, *p, nnz, ok ;
+    size_t alen ;
+    p = (int *) malloc ((NCOL+1) * sizeof (int)) ;
+    if (!p) exit (1) ;
+    seed = 1 ;
+    A = make_colamd (p, &nnz) ;
+    alen = compact ? colamd_compact_recommended (nnz, NROW, NCOL)
+		   : colamd_recommended (nnz, NROW, NCOL) ;
+    colamd_set_defaults (knobs) ;
+    knobs [COLAMD_NTHREADS] = nthreads ;
+    ok = colamd (NROW, NCOL, (int) alen, A, p, knobs, stats) ;
+    if (!ok)
+    {
+	colamd_report (stats) ;
+	printf ("colamd error!\n") ;
+	exit (1) ;
+    }
+    printf ("colamd: threads %d, Alen %s, dense rows %d, dense cols %d,"
+	" garbage collections %d\n", nthreads,
+	compact ? "compact    " : "recommended",
+	stats [COLAMD_DENSE_ROW], stats [COLAMD_DENSE_COL],
+	stats [COLAMD_DEFRAG_COUNT]) ;
+    free (A) ;
+    return (p) ;
+}
+
+/* order the 5-point mesh with colamd, with the smallest Alen that colamd
+   accepts, and return the column ordering */
+static int *order_colamd_mesh (int nthreads)
+{
+    double knobs [COLAMD_KNOBS] ;
+    int stats [COLAMD_STATS] ;
+    int *A, *p, i, j, col, nz, ok ;
+    size_t alen ;
+    /* no elbow room beyond the n_col that colamd requires */
+    nz = 5*NGRID - 4*GRID ;
+    alen = colamd_compact_recommended (nz, NGRID, NGRID) ;
+    alen -= (8*NGRID < nz/5) ? 8*NGRID : nz/5 ;
+    A = (int *) malloc (alen * sizeof (int)) ;
+    p = (int *) malloc ((NGRID+1) * sizeof (int)) ;
+    if (!A || !p) exit (1) ;
+    /* the full mesh, with sorted columns */
+    nz = 0 ;
+    for (j = 0 ; j < GRID ; j++)
+    {
+	for (i = 0 ; i < GRID ; i++)
+	{
+	    col = i + j*GRID ;
+	    p [col] = nz ;
+	    if (j > 0) A [nz++] = col - GRID ;
+	    if (i > 0) A [nz++] = col - 1 ;
+	    A [nz++] = col ;
+	    if (i < GRID-1) A [nz++] = col + 1 ;
+	    if (j < GRID-1) A [nz++] = col + GRID ;
+	}
+    }
+    p [NGRID] = nz ;
+    colamd_set_defaults (knobs) ;
+    knobs [COLAMD_NTHREADS] = nthreads ;
+    ok = colamd (NGRID, NGRID, (int) alen, A, p, knobs, stats) ;
+    if (!ok)
+    {
+	colamd_report (stats) ;
+	printf ("colamd error!\n") ;
+	exit (1) ;
+    }
+    printf ("colamd: threads %d, mesh, Alen %d, garbage collections %d\n",
+	nthreads, (int) alen, stats [COLAMD_DEFRAG_COUNT]) ;
+    free (A) ;
+    return (p) ;
+}
+
+/* order the 5-point mesh with symamd and return the ordering */
+static int *order_symamd (int nthreads)
+{
+    double knobs [COLAMD_KNOBS] ;
+    int stats [COLAMD_STATS] ;
+    int *Bp, *Bi, *perm, i, j, k, col, nz, ok ;
+    Bp = (int *) malloc ((NGRID+1) * sizeof (int)) ;
+    Bi = (int *) malloc (2 * NGRID * sizeof (int)) ;
+    perm = (int *) malloc ((NGRID+1) * sizeof (int)) ;
+    if (!Bp || !Bi || !perm) exit (1) ;
+    /* strictly lower triangular part of the mesh, with sorted columns */
+    nz = 0 ;
+    for (j = 0 ; j < GRID ; j++)
+    {
+	for (i = 0 ; i < GRID ; i++)
+	{
+	    col = i + j*GRID ;
+	    Bp [col] = nz ;
+	    if (i < GRID-1) Bi [nz++] = col + 1 ;
+	    if (j < GRID-1) Bi [nz++] = col + GRID ;
+	}
+    }
+    Bp [NGRID] = nz ;
+    colamd_set_defaults (knobs) ;
+    knobs [COLAMD_NTHREADS] = nthreads ;
+    ok = symamd (NGRID, Bi, Bp, perm, knobs, stats, &calloc, &free) ;
+    if (!ok)
+    {
+	symamd_report (stats) ;
+	printf ("symamd error!\n") ;
+	exit (1) ;
+    }
+    printf ("symamd: threads %d, nnz %d\n", nthreads, nz) ;
+    for (k = 0 ; k < NGRID ; k++)
+    {
+	if (perm [k] < 0 || perm [k] >= NGRID)
+	{
+	    printf ("symamd: invalid ordering!\n") ;
+	    exit (1) ;
+	}
+    }
+    free (Bp) ;
+    free (Bi) ;
+    return (perm) ;
+}
+
+static int same (int *p1, int *p2, int n)
+{
+    int k ;
+    for (k = 0 ; k < n ; k++) if (p1 [k] != p2 [k]) return (0) ;
+    return (1) ;
+}
+
+int main (void)
+{
+    int *p1, *p4, *pc, *g1, *g4, *s1, *s4, nnz, *A, Ap [NCOL+1] ;
+
+    /* ====================================================================== */
+    /* colamd_recommended and colamd_compact_recommended */
+    /* ====================================================================== */
+
+    seed = 1 ;
+    A = make_colamd (Ap, &nnz) ;
+    free (A) ;
+    printf ("colamd %d-by-%d matrix with %d entries\n", NROW, NCOL, nnz) ;
+    printf ("colamd_recommended:         %d\n",
+	(int) colamd_recommended (nnz, NROW, NCOL)) ;
+    printf ("colamd_compact_recommended: %d\n",
+	(int) colamd_compact_recommended (nnz, NROW, NCOL)) ;
+    printf ("colamd_compact_recommended of 5-by-4 example: %d\n",
+	(int) colamd_compact_recommended (11, 5, 4)) ;
+    printf ("colamd_compact_recommended with nnz < 0: %d\n",
+	(int) colamd_compact_recommended (-1, 5, 4)) ;
+
+    /* ====================================================================== */
+    /* colamd with 1 and 4 threads, and with the compact Alen */
+    /* ====================================================================== */
+
+    p1 = order_colamd (1, 0) ;
+    p4 = order_colamd (4, 0) ;
+    pc = order_colamd (4, 1) ;
+    printf ("colamd ordering, 4 threads same as 1:            %s\n",
+	same (p1, p4, NCOL) ? "yes" : "no") ;
+    printf ("colamd ordering, compact Alen same as recommended: %s\n",
+	same (p1, pc, NCOL) ? "yes" : "no") ;
+
+    /* ====================================================================== */
+    /* colamd with garbage collection, with 1 and 4 threads */
+    /* ====================================================================== */
+
+    g1 = order_colamd_mesh (1) ;
+    g4 = order_colamd_mesh (4) ;
+    printf ("colamd mesh ordering, 4 threads same as 1: %s\n",
+	same (g1, g4, NGRID) ? "yes" : "no") ;
+
+    /* ====================================================================== */
+    /* symamd with 1 and 4 threads */
+    /* ====================================================================== */
+
+    s1 = order_symamd (1) ;
+    s4 = order_symamd (4) ;
+    printf ("symamd ordering, 4 threads same as 1: %s\n",
+	same (s1, s4, NGRID) ? "yes" : "no") ;
+
+    free (p1) ;
+    free (p4) ;
+    free (pc) ;
+    free (g1) ;
+    free (g4) ;
+    free (s1) ;
+    free (s4) ;
+    exit (0) ;
+}
@@ -81,7 +81,7 @@ extern "C" {
 /* === Knob and statistics definitions ====================================== */
 /* ========================================================================== */
 
-/* size of the knobs [ ] array.  Only knobs [0..1] are currently used. */
+/* size of the knobs [ ] array.  Only knobs [0..3] are currently used. */
 #define COLAMD_KNOBS 20
 
 /* number of output statistics.  Only stats [0..6] are currently used. */
@@ -96,6 +96,9 @@ extern "C" {
 /* knobs [2]: aggressive absorption */
 #define COLAMD_AGGRESSIVE 2
 
+/* knobs [3]: number of threads to use (1 by default) */
+#define COLAMD_NTHREADS 3
+
 /* stats [2]: memory defragmentation count output statistic */
 #define COLAMD_DEFRAG_COUNT 2
 
@@ -145,6 +148,22 @@ size_t colamd_l_recommended	/* returns recommended value of Alen, */
     SuiteSparse_long n_col      /* number of columns in A */
 ) ;
 
+size_t colamd_compact_recommended   /* returns a smaller value of Alen, */
+				/* or 0 if input arguments are erroneous */
+(
+    int nnz,			/* nonzeros in A */
+    int n_row,			/* number of rows in A */
+    int n_col			/* number of columns in A */
+) ;
+
+size_t colamd_l_compact_recommended /* returns a smaller value of Alen, */
+				/* or 0 if input arguments are erroneous */
+(
+    SuiteSparse_long nnz,       /* nonzeros in A */
+    SuiteSparse_long n_row,     /* number of rows in A */
+    SuiteSparse_long n_col      /* number of columns in A */
+) ;
+
 void colamd_set_defaults	/* sets default parameters */
 (				/* knobs argument is modified on output */
     double knobs [COLAMD_KNOBS]	/* parameter settings for colamd */
@@ -113,6 +113,29 @@
 
 	    int n_col ;		Number of columns in the matrix A.
 
+    ----------------------------------------------------------------------------
+    colamd_compact_recommended:
+    ----------------------------------------------------------------------------
+
+	C syntax:
+
+	    #include "colamd.h"
+	    size_t colamd_compact_recommended (int nnz, int n_row, int n_col) ;
+	    size_t colamd_l_compact_recommended (SuiteSparse_long nnz,
+                SuiteSparse_long n_row, SuiteSparse_long n_col) ;
+
+	Purpose:
+
+	    Same as colamd_recommended, except that the elbow room is limited
+	    by the number of columns instead of the number of nonzeros.  Each
+	    new pivot row has at most n_col entries, so for a tall and thin
+	    matrix (n_row >> n_col) the nnz/5 elbow room of colamd_recommended
+	    is mostly unused; this returns 2*nnz + n_col + COLAMD_C (n_col) +
+	    COLAMD_R (n_row) plus min (nnz/5, 8*n_col).  For square matrices
+	    the two values are nearly the same.  A smaller Alen can lead to
+	    more garbage collections (see stats [COLAMD_DEFRAG_COUNT]), but it
+	    does not change the ordering.
+
     ----------------------------------------------------------------------------
     colamd_set_defaults:
     ----------------------------------------------------------------------------
@@ -163,6 +186,15 @@
 	        knobs [COLAMD_AGGRESSIVE] controls whether or not to do
 	        aggressive absorption during the ordering.  Default is TRUE.
 
+	    knobs [3]: number of threads
+
+		If knobs [COLAMD_NTHREADS] > 1 and colamd is compiled with
+		OpenMP, up to this many threads are used to construct the row
+		form of A, to compute the initial row and column degrees, to
+		remove dense rows and columns, and to compact A during garbage
+		collection.  The ordering itself is sequential, and the result
+		is identical to the sequential result.  Default is 1.
+
 
     ----------------------------------------------------------------------------
     colamd:
@@ -649,6 +681,10 @@
 #include <stdio.h>
 #endif
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #ifndef NULL
 #define NULL ((void *) 0)
 #endif
@@ -664,6 +700,7 @@
 #define Int_MAX SuiteSparse_long_max
 
 #define COLAMD_recommended colamd_l_recommended
+#define COLAMD_compact_recommended colamd_l_compact_recommended
 #define COLAMD_set_defaults colamd_l_set_defaults
 #define COLAMD_MAIN colamd_l
 #define SYMAMD_MAIN symamd_l
@@ -677,6 +714,7 @@
 #define Int_MAX INT_MAX
 
 #define COLAMD_recommended colamd_recommended
+#define COLAMD_compact_recommended colamd_compact_recommended
 #define COLAMD_set_defaults colamd_set_defaults
 #define COLAMD_MAIN colamd
 #define SYMAMD_MAIN symamd
@@ -809,6 +847,11 @@ typedef struct Colamd_Row_struct
 /* === Prototypes of PRIVATE routines ======================================= */
 /* ========================================================================== */
 
+PRIVATE Int get_nthreads
+(
+    double knobs [COLAMD_KNOBS]
+) ;
+
 PRIVATE Int init_rows_cols
 (
     Int n_row,
@@ -817,7 +860,19 @@ PRIVATE Int init_rows_cols
     Colamd_Col Col [],
     Int A [],
     Int p [],
-    Int stats [COLAMD_STATS]
+    Int stats [COLAMD_STATS],
+    Int nthreads
+) ;
+
+PRIVATE Int init_rows_cols_parallel
+(
+    Int n_row,
+    Int n_col,
+    Colamd_Row Row [],
+    Colamd_Col Col [],
+    Int A [],
+    Int p [],
+    Int nthreads
 ) ;
 
 PRIVATE void init_scoring
@@ -831,7 +886,8 @@ PRIVATE void init_scoring
     double knobs [COLAMD_KNOBS],
     Int *p_n_row2,
     Int *p_n_col2,
-    Int *p_max_deg
+    Int *p_max_deg,
+    Int nthreads
 ) ;
 
 PRIVATE Int find_ordering
@@ -846,7 +902,8 @@ PRIVATE Int find_ordering
     Int n_col2,
     Int max_deg,
     Int pfree,
-    Int aggressive
+    Int aggressive,
+    Int nthreads
 ) ;
 
 PRIVATE void order_children
@@ -878,7 +935,8 @@ PRIVATE Int garbage_collection
     Colamd_Row Row [],
     Colamd_Col Col [],
     Int A [],
-    Int *pfree
+    Int *pfree,
+    Int nthreads
 ) ;
 
 PRIVATE Int clear_mark
@@ -1056,6 +1114,44 @@ PUBLIC size_t COLAMD_recommended	/* returns recommended value of Alen. */
 }
 
 
+/* ========================================================================== */
+/* === colamd_compact_recommended =========================================== */
+/* ========================================================================== */
+
+/*
+    Same as colamd_recommended, except that the nnz/5 elbow room is limited to
+    8*n_col.  A pivot row never has more than n_col entries, so this is still
+    enough room for several pivot rows between garbage collections.
+*/
+
+PUBLIC size_t COLAMD_compact_recommended   /* returns recommended Alen */
+(
+    /* === Parameters ======================================================= */
+
+    Int nnz,			/* number of nonzeros in A */
+    Int n_row,			/* number of rows in A */
+    Int n_col			/* number of columns in A */
+)
+{
+    size_t s, c, r, e ;
+    int ok = TRUE ;
+    if (nnz < 0 || n_row < 0 || n_col < 0)
+    {
+	return (0) ;
+    }
+    s = t_mult (nnz, 2, &ok) ;	    /* 2*nnz */
+    c = COLAMD_C (n_col, &ok) ;	    /* size of column structures */
+    r = COLAMD_R (n_row, &ok) ;	    /* size of row structures */
+    e = t_mult (n_col, 8, &ok) ;    /* at most 8 full pivot rows */
+    s = t_add (s, c, &ok) ;
+    s = t_add (s, r, &ok) ;
+    s = t_add (s, n_col, &ok) ;	    /* elbow room */
+    s = t_add (s, MIN (e, (size_t) (nnz/5)), &ok) ;  /* elbow room */
+    ok = ok && (s < Int_MAX) ;
+    return (ok ? s : 0) ;
+}
+
+
 /* ========================================================================== */
 /* === colamd_set_defaults ================================================== */
 /* ========================================================================== */
@@ -1079,7 +1175,10 @@ PUBLIC size_t COLAMD_recommended	/* returns recommended value of Alen. */
 
 	knobs [2]	if nonzero, do aggresive absorption
 
-	knobs [3..19]	unused, but future versions might use this
+	knobs [3]	number of threads for the initialization and garbage
+			collection (only if > 1 and compiled with OpenMP)
+
+	knobs [4..19]	unused, but future versions might use this
 
 */
 
@@ -1105,6 +1204,7 @@ PUBLIC void COLAMD_set_defaults
     knobs [COLAMD_DENSE_ROW] = 10 ;
     knobs [COLAMD_DENSE_COL] = 10 ;
     knobs [COLAMD_AGGRESSIVE] = TRUE ;	/* default: do aggressive absorption*/
+    knobs [COLAMD_NTHREADS] = 1 ;	/* default: sequential */
 }
 
 
@@ -1460,6 +1560,7 @@ PUBLIC Int COLAMD_MAIN		/* returns TRUE if successful, FALSE otherwise*/
     Int max_deg ;		/* maximum row degree */
     double default_knobs [COLAMD_KNOBS] ;	/* default knobs array */
     Int aggressive ;		/* do aggressive absorption */
+    Int nthreads ;		/* number of threads to use */
     int ok ;
 
 #ifndef NDEBUG
@@ -1537,6 +1638,7 @@ PUBLIC Int COLAMD_MAIN		/* returns TRUE if successful, FALSE otherwise*/
     }
 
     aggressive = (knobs [COLAMD_AGGRESSIVE] != FALSE) ;
+    nthreads = get_nthreads (knobs) ;
 
     /* === Allocate the Row and Col arrays from array A ===================== */
 
@@ -1566,7 +1668,7 @@ PUBLIC Int COLAMD_MAIN		/* returns TRUE if successful, FALSE otherwise*/
 
     /* === Construct the row and column data structures ===================== */
 
-    if (!init_rows_cols (n_row, n_col, Row, Col, A, p, stats))
+    if (!init_rows_cols (n_row, n_col, Row, Col, A, p, stats, nthreads))
     {
 	/* input matrix is invalid */
 	DEBUG0 (("colamd: Matrix invalid\n")) ;
@@ -1576,12 +1678,12 @@ PUBLIC Int COLAMD_MAIN		/* returns TRUE if successful, FALSE otherwise*/
     /* === Initialize scores, kill dense rows/columns ======================= */
 
     init_scoring (n_row, n_col, Row, Col, A, p, knobs,
-	&n_row2, &n_col2, &max_deg) ;
+	&n_row2, &n_col2, &max_deg, nthreads) ;
 
     /* === Order the supercolumns =========================================== */
 
     ngarbage = find_ordering (n_row, n_col, Alen, Row, Col, A, p,
-	n_col2, max_deg, 2*nnz, aggressive) ;
+	n_col2, max_deg, 2*nnz, aggressive, nthreads) ;
 
     /* === Order the non-principal columns ================================== */
 
@@ -1631,6 +1733,33 @@ PUBLIC void SYMAMD_report
 /* There are no user-callable routines beyond this point in the file */
 
 
+/* ========================================================================== */
+/* === get_nthreads ========================================================= */
+/* ========================================================================== */
+
+/*
+    Returns the number of threads to use, from knobs [COLAMD_NTHREADS].
+    Always 1 if colamd is not compiled with OpenMP.  Not user-callable.
+*/
+
+PRIVATE Int get_nthreads
+(
+    double knobs [COLAMD_KNOBS]
+)
+{
+    Int nthreads = 1 ;
+#ifdef _OPENMP
+    if (knobs [COLAMD_NTHREADS] > 1)
+    {
+	nthreads = (Int) MIN (knobs [COLAMD_NTHREADS],
+	    (double) omp_get_max_threads ( )) ;
+	nthreads = MAX (nthreads, 1) ;
+    }
+#endif
+    return (nthreads) ;
+}
+
+
 /* ========================================================================== */
 /* === init_rows_cols ======================================================= */
 /* ========================================================================== */
@@ -1654,7 +1783,8 @@ PRIVATE Int init_rows_cols	/* returns TRUE if OK, or FALSE otherwise */
     Colamd_Col Col [],		/* of size n_col+1 */
     Int A [],			/* row indices of A, of size Alen */
     Int p [],			/* pointers to columns in A, of size n_col+1 */
-    Int stats [COLAMD_STATS]	/* colamd statistics */ 
+    Int stats [COLAMD_STATS],	/* colamd statistics */ 
+    Int nthreads		/* number of threads to use */
 )
 {
     /* === Local variables ================================================== */
@@ -1667,6 +1797,15 @@ PRIVATE Int init_rows_cols	/* returns TRUE if OK, or FALSE otherwise */
     Int *rp_end ;		/* a pointer to the end of a row */
     Int last_row ;		/* previous row */
 
+    /* === Try the parallel method first ==================================== */
+
+    if (nthreads > 1 &&
+	init_rows_cols_parallel (n_row, n_col, Row, Col, A, p, nthreads))
+    {
+	stats [COLAMD_INFO3] = 0 ;	/* no duplicate or unsorted entries */
+	return (TRUE) ;
+    }
+
     /* === Initialize columns, and check column pointers ==================== */
 
     for (col = 0 ; col < n_col ; col++)
@@ -1872,6 +2011,170 @@ PRIVATE Int init_rows_cols	/* returns TRUE if OK, or FALSE otherwise */
 }
 
 
+/* ========================================================================== */
+/* === init_rows_cols_parallel ============================================== */
+/* ========================================================================== */
+
+/*
+    Parallel version of init_rows_cols, for a valid matrix whose columns are
+    sorted and have no duplicates.  Each thread owns a contiguous range of
+    rows and scans all the columns for the entries in its range (found by a
+    binary search, since the columns are sorted).  The row form is thus
+    created in exactly the same order as by the sequential method, and no
+    workspace is needed other than A itself.  Returns FALSE if the matrix is
+    invalid or jumbled, in which case init_rows_cols starts over and reports
+    the problem.  Not user-callable.
+*/
+
+PRIVATE Int init_rows_cols_parallel	/* returns TRUE if done */
+(
+    /* === Parameters ======================================================= */
+
+    Int n_row,			/* number of rows of A */
+    Int n_col,			/* number of columns of A */
+    Colamd_Row Row [],		/* of size n_row+1 */
+    Colamd_Col Col [],		/* of size n_col+1 */
+    Int A [],			/* row indices of A, of size Alen */
+    Int p [],			/* pointers to columns in A, of size n_col+1 */
+    Int nthreads		/* number of threads to use */
+)
+{
+    /* === Local variables ================================================== */
+
+    Int col ;			/* a column index */
+    Int row ;			/* a row index */
+    Int pp ;			/* index into A */
+    Int lo, hi, mid ;		/* for binary search */
+    Int t ;			/* thread index */
+    Int r1, r2 ;		/* rows r1 to r2-1 are owned by a thread */
+    Int last_row ;		/* previous row */
+    Int nbad ;			/* number of invalid or jumbled columns */
+
+    /* === Check column pointers ============================================ */
+
+    nbad = 0 ;
+#pragma omp parallel for num_threads(nthreads) schedule(static) \
+    reduction(+:nbad)
+    for (col = 0 ; col < n_col ; col++)
+    {
+	if (p [col+1] < p [col])
+	{
+	    nbad++ ;
+	}
+    }
+    if (nbad > 0)
+    {
+	return (FALSE) ;
+    }
+
+    /* === Initialize columns, and check row indices ======================== */
+
+#pragma omp parallel for num_threads(nthreads) schedule(static) \
+    private (pp, row, last_row) reduction(+:nbad)
+    for (col = 0 ; col < n_col ; col++)
+    {
+	Col [col].start = p [col] ;
+	Col [col].length = p [col+1] - p [col] ;
+	Col [col].shared1.thickness = 1 ;
+	Col [col].shared2.score = 0 ;
+	Col [col].shared3.prev = EMPTY ;
+	Col [col].shared4.degree_next = EMPTY ;
+	last_row = -1 ;
+	for (pp = p [col] ; pp < p [col+1] ; pp++)
+	{
+	    row = A [pp] ;
+	    if (row <= last_row || row >= n_row)
+	    {
+		/* out of range, unsorted, or duplicate */
+		nbad++ ;
+		break ;
+	    }
+	    last_row = row ;
+	}
+    }
+    if (nbad > 0)
+    {
+	return (FALSE) ;
+    }
+
+    /* === Compute row degrees ============================================== */
+
+#pragma omp parallel for num_threads(nthreads) schedule(static,1) \
+    private (col, row, pp, lo, hi, mid, r1, r2)
+    for (t = 0 ; t < nthreads ; t++)
+    {
+	r1 = (Int) (((double) n_row * t) / nthreads) ;
+	r2 = (Int) (((double) n_row * (t+1)) / nthreads) ;
+	for (row = r1 ; row < r2 ; row++)
+	{
+	    Row [row].length = 0 ;
+	}
+	for (col = 0 ; col < n_col ; col++)
+	{
+	    /* find the first entry in column col with row index >= r1 */
+	    lo = p [col] ;
+	    hi = p [col+1] ;
+	    while (lo < hi)
+	    {
+		mid = lo + (hi - lo) / 2 ;
+		if (A [mid] < r1) lo = mid + 1 ; else hi = mid ;
+	    }
+	    for (pp = lo ; pp < p [col+1] && A [pp] < r2 ; pp++)
+	    {
+		Row [A [pp]].length++ ;
+	    }
+	}
+    }
+
+    /* === Compute row pointers ============================================= */
+
+    Row [0].start = p [n_col] ;
+    Row [0].shared1.p = Row [0].start ;
+    Row [0].shared2.mark = -1 ;
+    for (row = 1 ; row < n_row ; row++)
+    {
+	Row [row].start = Row [row-1].start + Row [row-1].length ;
+	Row [row].shared1.p = Row [row].start ;
+	Row [row].shared2.mark = -1 ;
+    }
+
+    /* === Create row form ================================================== */
+
+#pragma omp parallel for num_threads(nthreads) schedule(static,1) \
+    private (col, row, pp, lo, hi, mid, r1, r2)
+    for (t = 0 ; t < nthreads ; t++)
+    {
+	r1 = (Int) (((double) n_row * t) / nthreads) ;
+	r2 = (Int) (((double) n_row * (t+1)) / nthreads) ;
+	for (col = 0 ; col < n_col ; col++)
+	{
+	    lo = p [col] ;
+	    hi = p [col+1] ;
+	    while (lo < hi)
+	    {
+		mid = lo + (hi - lo) / 2 ;
+		if (A [mid] < r1) lo = mid + 1 ; else hi = mid ;
+	    }
+	    for (pp = lo ; pp < p [col+1] && A [pp] < r2 ; pp++)
+	    {
+		A [(Row [A [pp]].shared1.p)++] = col ;
+	    }
+	}
+    }
+
+    /* === Clear the row marks and set row degrees ========================== */
+
+#pragma omp parallel for num_threads(nthreads) schedule(static)
+    for (row = 0 ; row < n_row ; row++)
+    {
+	Row [row].shared2.mark = 0 ;
+	Row [row].shared1.degree = Row [row].length ;
+    }
+
+    return (TRUE) ;
+}
+
+
 /* ========================================================================== */
 /* === init_scoring ========================================================= */
 /* ========================================================================== */
@@ -1894,7 +2197,8 @@ PRIVATE void init_scoring
     double knobs [COLAMD_KNOBS],/* parameters */
     Int *p_n_row2,		/* number of non-dense, non-empty rows */
     Int *p_n_col2,		/* number of non-dense, non-empty columns */
-    Int *p_max_deg		/* maximum row degree */
+    Int *p_max_deg,		/* maximum row degree */
+    Int nthreads		/* number of threads to use */
 )
 {
     /* === Local variables ================================================== */
@@ -1914,6 +2218,8 @@ PRIVATE void init_scoring
     Int min_score ;		/* smallest column score */
     Int max_deg ;		/* maximum row degree */
     Int next_col ;		/* Used to add to degree list.*/
+    Int k ;			/* index into a column */
+    Int nkilled ;		/* number of rows killed */
 
 #ifndef NDEBUG
     Int debug_count ;		/* debug only. */
@@ -1978,12 +2284,13 @@ PRIVATE void init_scoring
 	{
 	    /* this is a dense column, kill and order it last */
 	    Col [c].shared2.order = --n_col2 ;
-	    /* decrement the row degrees */
+	    /* decrement the row degrees (no duplicates, so no races) */
 	    cp = &A [Col [c].start] ;
-	    cp_end = cp + Col [c].length ;
-	    while (cp < cp_end)
+#pragma omp parallel for num_threads(nthreads) schedule(static) \
+	    if (nthreads > 1 && deg > 4096)
+	    for (k = 0 ; k < deg ; k++)
 	    {
-		Row [*cp++].shared1.degree-- ;
+		Row [cp [k]].shared1.degree-- ;
 	    }
 	    KILL_PRINCIPAL_COL (c) ;
 	}
@@ -1992,22 +2299,33 @@ PRIVATE void init_scoring
 
     /* === Kill dense and empty rows ======================================== */
 
-    for (r = 0 ; r < n_row ; r++)
+    nkilled = 0 ;
+#pragma omp parallel num_threads(nthreads) if (nthreads > 1) private (r, deg)
     {
-	deg = Row [r].shared1.degree ;
-	ASSERT (deg >= 0 && deg <= n_col) ;
-	if (deg > dense_row_count || deg == 0)
+	Int my_max_deg = 0 ;
+#pragma omp for schedule(static) reduction(+:nkilled)
+	for (r = 0 ; r < n_row ; r++)
 	{
-	    /* kill a dense or empty row */
-	    KILL_ROW (r) ;
-	    --n_row2 ;
+	    deg = Row [r].shared1.degree ;
+	    ASSERT (deg >= 0 && deg <= n_col) ;
+	    if (deg > dense_row_count || deg == 0)
+	    {
+		/* kill a dense or empty row */
+		KILL_ROW (r) ;
+		nkilled++ ;
+	    }
+	    else
+	    {
+		/* keep track of max degree of remaining rows */
+		my_max_deg = MAX (my_max_deg, deg) ;
+	    }
 	}
-	else
+#pragma omp critical (colamd_max_deg)
 	{
-	    /* keep track of max degree of remaining rows */
-	    max_deg = MAX (max_deg, deg) ;
+	    max_deg = MAX (max_deg, my_max_deg) ;
 	}
     }
+    n_row2 -= nkilled ;
     DEBUG1 (("colamd: Dense and null rows killed: %d\n", n_row - n_row2)) ;
 
     /* === Compute initial column scores ==================================== */
@@ -2018,6 +2336,8 @@ PRIVATE void init_scoring
     /* pruned in the code below. */
 
     /* now find the initial matlab score for each column */
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1) \
+    schedule(static) private (score, cp, new_cp, cp_end, row, col_length)
     for (c = n_col-1 ; c >= 0 ; c--)
     {
 	/* skip dead column */
@@ -2047,7 +2367,17 @@ PRIVATE void init_scoring
 	}
 	/* determine pruned column length */
 	col_length = (Int) (new_cp - &A [Col [c].start]) ;
-	if (col_length == 0)
+	/* set column length and set score (a newly-made null column is */
+	/* killed below, in order) */
+	ASSERT (score >= 0) ;
+	ASSERT (score <= n_col) ;
+	Col [c].length = col_length ;
+	Col [c].shared2.score = score ;
+    }
+
+    for (c = n_col-1 ; c >= 0 ; c--)
+    {
+	if (COL_IS_ALIVE (c) && Col [c].length == 0)
 	{
 	    /* a newly-made null column (all rows in this col are "dense" */
 	    /* and have already been killed) */
@@ -2055,14 +2385,6 @@ PRIVATE void init_scoring
 	    Col [c].shared2.order = --n_col2 ;
 	    KILL_PRINCIPAL_COL (c) ;
 	}
-	else
-	{
-	    /* set column length and set score */
-	    ASSERT (score >= 0) ;
-	    ASSERT (score <= n_col) ;
-	    Col [c].length = col_length ;
-	    Col [c].shared2.score = score ;
-	}
     }
     DEBUG1 (("colamd: Dense, null, and newly-null columns killed: %d\n",
     	n_col-n_col2)) ;
@@ -2170,7 +2492,8 @@ PRIVATE Int find_ordering	/* return the number of garbage collections */
     Int n_col2,			/* Remaining columns to order */
     Int max_deg,		/* Maximum row degree */
     Int pfree,			/* index of first free slot (2*nnz on entry) */
-    Int aggressive
+    Int aggressive,
+    Int nthreads		/* number of threads for garbage collection */
 )
 {
     /* === Local variables ================================================== */
@@ -2287,7 +2610,8 @@ PRIVATE Int find_ordering	/* return the number of garbage collections */
 	needed_memory = MIN (pivot_col_score, n_col - k) ;
 	if (pfree + needed_memory >= Alen)
 	{
-	    pfree = garbage_collection (n_row, n_col, Row, Col, A, &A [pfree]) ;
+	    pfree = garbage_collection (n_row, n_col, Row, Col, A, &A [pfree],
+		nthreads) ;
 	    ngarbage++ ;
 	    /* after garbage collection we will have enough */
 	    ASSERT (pfree + needed_memory < Alen) ;
@@ -2988,17 +3312,20 @@ PRIVATE Int garbage_collection  /* returns the new value of pfree */
     Colamd_Row Row [],		/* row info */
     Colamd_Col Col [],		/* column info */
     Int A [],			/* A [0 ... Alen-1] holds the matrix */
-    Int *pfree			/* &A [0] ... pfree is in use */
+    Int *pfree,			/* &A [0] ... pfree is in use */
+    Int nthreads		/* number of threads to use */
 )
 {
     /* === Local variables ================================================== */
 
     Int *psrc ;			/* source pointer */
     Int *pdest ;		/* destination pointer */
+    Int *pstart ;		/* start of a row or column */
     Int j ;			/* counter */
     Int r ;			/* a row index */
     Int c ;			/* a column index */
     Int length ;		/* length of a row or column */
+    Int compacted ;		/* TRUE if rows and columns are compacted */
 
 #ifndef NDEBUG
     Int debug_rows ;
@@ -3007,6 +3334,58 @@ PRIVATE Int garbage_collection  /* returns the new value of pfree */
     debug_rows = 0 ;
 #endif /* NDEBUG */
 
+    /* === Compact the rows and columns in place, in parallel =============== */
+
+    /* Removing the dead entries is what takes the time (the Row and Col
+     * status lookups are scattered), and each row and column can be done
+     * independently in its own part of A.  Moving them together (below) must
+     * be done in order, but it then only copies entries. */
+
+    compacted = (nthreads > 1) ;
+    if (compacted)
+    {
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic,1024) \
+	private (pstart, pdest, length, j, r)
+	for (c = 0 ; c < n_col ; c++)
+	{
+	    if (COL_IS_ALIVE (c))
+	    {
+		pstart = &A [Col [c].start] ;
+		pdest = pstart ;
+		length = Col [c].length ;
+		for (j = 0 ; j < length ; j++)
+		{
+		    r = pstart [j] ;
+		    if (ROW_IS_ALIVE (r))
+		    {
+			*pdest++ = r ;
+		    }
+		}
+		Col [c].length = (Int) (pdest - pstart) ;
+	    }
+	}
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic,1024) \
+	private (pstart, pdest, length, j, c)
+	for (r = 0 ; r < n_row ; r++)
+	{
+	    if (ROW_IS_ALIVE (r) && Row [r].length > 0)
+	    {
+		pstart = &A [Row [r].start] ;
+		pdest = pstart ;
+		length = Row [r].length ;
+		for (j = 0 ; j < length ; j++)
+		{
+		    c = pstart [j] ;
+		    if (COL_IS_ALIVE (c))
+		    {
+			*pdest++ = c ;
+		    }
+		}
+		Row [r].length = (Int) (pdest - pstart) ;
+	    }
+	}
+    }
+
     /* === Defragment the columns =========================================== */
 
     pdest = &A[0] ;
@@ -3023,7 +3402,7 @@ PRIVATE Int garbage_collection  /* returns the new value of pfree */
 	    for (j = 0 ; j < length ; j++)
 	    {
 		r = *psrc++ ;
-		if (ROW_IS_ALIVE (r))
+		if (compacted || ROW_IS_ALIVE (r))
 		{
 		    *pdest++ = r ;
 		}
@@ -3034,6 +3413,13 @@ PRIVATE Int garbage_collection  /* returns the new value of pfree */
 
     /* === Prepare to defragment the rows =================================== */
 
+#ifndef NDEBUG
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1) \
+    schedule(static) private (psrc) reduction(+:debug_rows)
+#else
+#pragma omp parallel for num_threads(nthreads) if (nthreads > 1) \
+    schedule(static) private (psrc)
+#endif /* NDEBUG */
     for (r = 0 ; r < n_row ; r++)
     {
 	if (ROW_IS_DEAD (r) || (Row [r].length == 0))
@@ -3081,7 +3467,7 @@ PRIVATE Int garbage_collection  /* returns the new value of pfree */
 	    for (j = 0 ; j < length ; j++)
 	    {
 		c = *psrc++ ;
-		if (COL_IS_ALIVE (c))
+		if (compacted || COL_IS_ALIVE (c))
 		{
 		    *pdest++ = c ;
 		}
@@ -61,6 +61,87 @@ static void print_resid (int ok, cs_ci *A, cs_complex_t *x, cs_complex_t *b, cs_
         (cs_ci_norm (A) * norm (x,n) + norm (b,m)))) ;
 }
 
+/* true if A and B are identical; also true if either is NULL (out of memory) */
+static int same (cs_ci *A, cs_ci *B)
+{
+    int j, p, n ;
+    if (!A || !B) return (1) ;
+    n = A->n ;
+    if (A->m != B->m || n != B->n || A->nz != -1 || B->nz != -1) return (0) ;
+    for (j = 0 ; j <= n ; j++) if (A->p [j] != B->p [j]) return (0) ;
+    for (p = 0 ; p < A->p [n] ; p++)
+    {
+        if (A->i [p] != B->i [p]) return (0) ;
+        if (A->x && B->x && A->x [p] != B->x [p]) return (0) ;
+    }
+    return (1) ;
+}
+
+/* check the parallel kernels, which must give exactly the serial results */
+static void print_parallel (cs_ci *A)
+{
+    cs_ci *AT, *C, *T, *P1, *P2 ;
+    cs_complex_t *x, *y1, *y2 ;
+    int i, j, p, m, n, ok = 1, nthreads ;
+    m = A->m ; n = A->n ;
+    AT = cs_ci_transpose (A, 1) ;                 /* AT = A' */
+    C = cs_ci_multiply (A, AT) ;                  /* C = A*A' */
+    T = cs_ci_spalloc (m, n, A->p [n] + 1, 1, 1) ;  /* T = A, in reverse order, */
+    for (j = n-1 ; j >= 0 ; j--)                /* with a duplicate entry */
+    {
+        for (p = A->p [j+1]-1 ; p >= A->p [j] ; p--)
+        {
+            cs_ci_entry (T, A->i [p], j, A->x [p]) ;
+        }
+    }
+    if (A->p [n] > 0) cs_ci_entry (T, A->i [0], 0, 1) ;
+    x = cs_ci_malloc (n, sizeof (cs_complex_t)) ;
+    y1 = cs_ci_malloc (m, sizeof (cs_complex_t)) ;
+    y2 = cs_ci_malloc (m, sizeof (cs_complex_t)) ;
+    for (nthreads = 1 ; nthreads <= 4 ; nthreads += 3)
+    {
+        P1 = cs_ci_ptranspose (A, 1, nthreads) ;
+        ok = ok && same (AT, P1) ;
+        cs_ci_spfree (P1) ;
+        P1 = cs_ci_pmultiply (A, AT, nthreads) ;
+        ok = ok && same (C, P1) ;
+        cs_ci_spfree (P1) ;
+        P1 = cs_ci_add (C, C, 1, 2) ;
+        P2 = cs_ci_padd (C, C, 1, 2, nthreads) ;
+        ok = ok && same (P1, P2) ;
+        cs_ci_spfree (P1) ;
+        cs_ci_spfree (P2) ;
+        if (m == n)
+        {
+            P1 = cs_ci_add (A, AT, 1, -1) ;
+            P2 = cs_ci_padd (A, AT, 1, -1, nthreads) ;
+            ok = ok && same (P1, P2) ;
+            cs_ci_spfree (P1) ;
+            cs_ci_spfree (P2) ;
+        }
+        P1 = cs_ci_compress (T) ;
+        P2 = cs_ci_pcompress (T, nthreads) ;
+        ok = ok && same (P1, P2) ;
+        cs_ci_spfree (P1) ;
+        cs_ci_spfree (P2) ;
+        if (x && y1 && y2)
+        {
+            for (j = 0 ; j < n ; j++) x [j] = 1 + ((double) j) / n ;
+            for (i = 0 ; i < m ; i++) y1 [i] = y2 [i] = ((double) i) / m ;
+            cs_ci_gaxpy (A, x, y1) ;
+            cs_ci_pgaxpy (A, x, y2, nthreads) ;
+            for (i = 0 ; i < m ; i++) ok = ok && (y1 [i] == y2 [i]) ;
+        }
+    }
+    printf ("parallel: %s\n", ok ? "ok" : "FAILED") ;
+    cs_ci_spfree (AT) ;
+    cs_ci_spfree (C) ;
+    cs_ci_spfree (T) ;
+    cs_ci_free (x) ;
+    cs_ci_free (y1) ;
+    cs_ci_free (y2) ;
+}
+
 static double tic (void) { return (clock () / (double) CLOCKS_PER_SEC) ; }
 static double toc (double t) { double s = tic () ; return (CS_MAX (0, s-t)) ; }
 
@@ -143,6 +224,7 @@ int demo2 (problem *Prob)
     printf ("blocks: %g singletons: %g structural rank: %g\n",
         (double) nb, (double) ns, (double) sprank) ;
     cs_ci_dfree (D) ;
+    print_parallel (C) ;                           /* test the parallel kernels */
     for (order = 0 ; order <= 3 ; order += 3)   /* natural and amd(A'*A) */
     {
         if (!order && m > 1000) continue ;
@@ -50,6 +50,7 @@ extern "C" {
 #define CXSPARSE
 
 #include "SuiteSparse_config.h"
+#include "SuiteSparse_bin.h"
 #define cs_long_t       SuiteSparse_long
 #define cs_long_t_id    SuiteSparse_long_id
 #define cs_long_t_max   SuiteSparse_long_max
@@ -81,9 +82,16 @@ cs_di *cs_di_multiply (const cs_di *A, const cs_di *B) ;
 int cs_di_qrsol (int order, const cs_di *A, double *b) ;
 cs_di *cs_di_transpose (const cs_di *A, int values) ;
 cs_di *cs_di_compress (const cs_di *T) ;
+cs_di *cs_di_padd (const cs_di *A, const cs_di *B, double alpha, double beta,
+    int nthreads) ;
+int cs_di_pgaxpy (const cs_di *A, const double *x, double *y, int nthreads) ;
+cs_di *cs_di_pmultiply (const cs_di *A, const cs_di *B, int nthreads) ;
+cs_di *cs_di_ptranspose (const cs_di *A, int values, int nthreads) ;
+cs_di *cs_di_pcompress (const cs_di *T, int nthreads) ;
 double cs_di_norm (const cs_di *A) ;
 int cs_di_print (const cs_di *A, int brief) ;
 cs_di *cs_di_load (FILE *f) ;
+cs_di *cs_di_bin (const SuiteSparse_bin *B, cs_di *A) ;
 
 /* utilities */
 void *cs_di_calloc (int n, size_t size) ;
@@ -106,6 +114,8 @@ typedef struct cs_di_symbolic  /* symbolic Cholesky, LU, or QR analysis */
     int m2 ;        /* # of rows for QR, after adding fictitious rows */
     double lnz ;    /* # entries in L for LU or Cholesky; in V for QR */
     double unz ;    /* # entries in U for LU; in R for QR */
+    int *super ;    /* supernodes of L for Cholesky, size nsuper+1 */
+    int nsuper ;    /* # of supernodes */
 } cs_dis ;
 
 typedef struct cs_di_numeric   /* numeric Cholesky, LU, or QR factorization */
@@ -179,6 +189,9 @@ int cs_di_spsolve (cs_di *L, const cs_di *B, int k, int *xi, double *x,
     const int *pinv, int lo) ;
 int cs_di_ereach (const cs_di *A, int k, const int *parent, int *s, int *w) ;
 int *cs_di_randperm (int n, int seed) ;
+int cs_di_pthreads (int nthreads, double work) ;
+int cs_di_pslice (const double *Wp, int n, int ntasks, int *Slice) ;
+int *cs_di_super (const int *parent, const int *cp, int n, int *nsuper) ;
 
 /* utilities */
 cs_did *cs_di_dalloc (int m, int n) ;
@@ -215,9 +228,17 @@ cs_dl *cs_dl_multiply (const cs_dl *A, const cs_dl *B) ;
 cs_long_t cs_dl_qrsol (cs_long_t order, const cs_dl *A, double *b) ;
 cs_dl *cs_dl_transpose (const cs_dl *A, cs_long_t values) ;
 cs_dl *cs_dl_compress (const cs_dl *T) ;
+cs_dl *cs_dl_padd (const cs_dl *A, const cs_dl *B, double alpha, double beta,
+    cs_long_t nthreads) ;
+cs_long_t cs_dl_pgaxpy (const cs_dl *A, const double *x, double *y,
+    cs_long_t nthreads) ;
+cs_dl *cs_dl_pmultiply (const cs_dl *A, const cs_dl *B, cs_long_t nthreads) ;
+cs_dl *cs_dl_ptranspose (const cs_dl *A, cs_long_t values, cs_long_t nthreads) ;
+cs_dl *cs_dl_pcompress (const cs_dl *T, cs_long_t nthreads) ;
 double cs_dl_norm (const cs_dl *A) ;
 cs_long_t cs_dl_print (const cs_dl *A, cs_long_t brief) ;
 cs_dl *cs_dl_load (FILE *f) ;
+cs_dl *cs_dl_bin (const SuiteSparse_bin *B, cs_dl *A) ;
 
 /* utilities */
 void *cs_dl_calloc (cs_long_t n, size_t size) ;
@@ -241,6 +262,8 @@ typedef struct cs_dl_symbolic  /* symbolic Cholesky, LU, or QR analysis */
     cs_long_t m2 ;        /* # of rows for QR, after adding fictitious rows */
     double lnz ;        /* # entries in L for LU or Cholesky; in V for QR */
     double unz ;        /* # entries in U for LU; in R for QR */
+    cs_long_t *super ;    /* supernodes of L for Cholesky, size nsuper+1 */
+    cs_long_t nsuper ;    /* # of supernodes */
 } cs_dls ;
 
 typedef struct cs_dl_numeric   /* numeric Cholesky, LU, or QR factorization */
@@ -317,6 +340,11 @@ cs_long_t cs_dl_spsolve (cs_dl *L, const cs_dl *B, cs_long_t k, cs_long_t *xi,
 cs_long_t cs_dl_ereach (const cs_dl *A, cs_long_t k, const cs_long_t *parent,
     cs_long_t *s, cs_long_t *w) ;
 cs_long_t *cs_dl_randperm (cs_long_t n, cs_long_t seed) ;
+cs_long_t cs_dl_pthreads (cs_long_t nthreads, double work) ;
+cs_long_t cs_dl_pslice (const double *Wp, cs_long_t n, cs_long_t ntasks,
+    cs_long_t *Slice) ;
+cs_long_t *cs_dl_super (const cs_long_t *parent, const cs_long_t *cp,
+    cs_long_t n, cs_long_t *nsuper) ;
 
 /* utilities */
 cs_dld *cs_dl_dalloc (cs_long_t m, cs_long_t n) ;
@@ -356,9 +384,17 @@ cs_ci *cs_ci_multiply (const cs_ci *A, const cs_ci *B) ;
 int cs_ci_qrsol (int order, const cs_ci *A, cs_complex_t *b) ;
 cs_ci *cs_ci_transpose (const cs_ci *A, int values) ;
 cs_ci *cs_ci_compress (const cs_ci *T) ;
+cs_ci *cs_ci_padd (const cs_ci *A, const cs_ci *B, cs_complex_t alpha,
+    cs_complex_t beta, int nthreads) ;
+int cs_ci_pgaxpy (const cs_ci *A, const cs_complex_t *x, cs_complex_t *y,
+    int nthreads) ;
+cs_ci *cs_ci_pmultiply (const cs_ci *A, const cs_ci *B, int nthreads) ;
+cs_ci *cs_ci_ptranspose (const cs_ci *A, int values, int nthreads) ;
+cs_ci *cs_ci_pcompress (const cs_ci *T, int nthreads) ;
 double cs_ci_norm (const cs_ci *A) ;
 int cs_ci_print (const cs_ci *A, int brief) ;
 cs_ci *cs_ci_load (FILE *f) ;
+cs_ci *cs_ci_bin (const SuiteSparse_bin *B, cs_ci *A) ;
 
 /* utilities */
 void *cs_ci_calloc (int n, size_t size) ;
@@ -381,6 +417,8 @@ typedef struct cs_ci_symbolic  /* symbolic Cholesky, LU, or QR analysis */
     int m2 ;        /* # of rows for QR, after adding fictitious rows */
     double lnz ;    /* # entries in L for LU or Cholesky; in V for QR */
     double unz ;    /* # entries in U for LU; in R for QR */
+    int *super ;    /* supernodes of L for Cholesky, size nsuper+1 */
+    int nsuper ;    /* # of supernodes */
 } cs_cis ;
 
 typedef struct cs_ci_numeric   /* numeric Cholesky, LU, or QR factorization */
@@ -454,6 +492,9 @@ int cs_ci_spsolve (cs_ci *L, const cs_ci *B, int k, int *xi,
     cs_complex_t *x, const int *pinv, int lo) ;
 int cs_ci_ereach (const cs_ci *A, int k, const int *parent, int *s, int *w) ;
 int *cs_ci_randperm (int n, int seed) ;
+int cs_ci_pthreads (int nthreads, double work) ;
+int cs_ci_pslice (const double *Wp, int n, int ntasks, int *Slice) ;
+int *cs_ci_super (const int *parent, const int *cp, int n, int *nsuper) ;
 
 /* utilities */
 cs_cid *cs_ci_dalloc (int m, int n) ;
@@ -492,9 +533,17 @@ cs_cl *cs_cl_multiply (const cs_cl *A, const cs_cl *B) ;
 cs_long_t cs_cl_qrsol (cs_long_t order, const cs_cl *A, cs_complex_t *b) ;
 cs_cl *cs_cl_transpose (const cs_cl *A, cs_long_t values) ;
 cs_cl *cs_cl_compress (const cs_cl *T) ;
+cs_cl *cs_cl_padd (const cs_cl *A, const cs_cl *B, cs_complex_t alpha,
+    cs_complex_t beta, cs_long_t nthreads) ;
+cs_long_t cs_cl_pgaxpy (const cs_cl *A, const cs_complex_t *x,
+    cs_complex_t *y, cs_long_t nthreads) ;
+cs_cl *cs_cl_pmultiply (const cs_cl *A, const cs_cl *B, cs_long_t nthreads) ;
+cs_cl *cs_cl_ptranspose (const cs_cl *A, cs_long_t values, cs_long_t nthreads) ;
+cs_cl *cs_cl_pcompress (const cs_cl *T, cs_long_t nthreads) ;
 double cs_cl_norm (const cs_cl *A) ;
 cs_long_t cs_cl_print (const cs_cl *A, cs_long_t brief) ;
 cs_cl *cs_cl_load (FILE *f) ;
+cs_cl *cs_cl_bin (const SuiteSparse_bin *B, cs_cl *A) ;
 
 /* utilities */
 void *cs_cl_calloc (cs_long_t n, size_t size) ;
@@ -518,6 +567,8 @@ typedef struct cs_cl_symbolic  /* symbolic Cholesky, LU, or QR analysis */
     cs_long_t m2 ;        /* # of rows for QR, after adding fictitious rows */
     double lnz ;        /* # entries in L for LU or Cholesky; in V for QR */
     double unz ;        /* # entries in U for LU; in R for QR */
+    cs_long_t *super ;    /* supernodes of L for Cholesky, size nsuper+1 */
+    cs_long_t nsuper ;    /* # of supernodes */
 } cs_cls ;
 
 typedef struct cs_cl_numeric   /* numeric Cholesky, LU, or QR factorization */
@@ -596,6 +647,11 @@ cs_long_t cs_cl_spsolve (cs_cl *L, const cs_cl *B, cs_long_t k, cs_long_t *xi,
 cs_long_t cs_cl_ereach (const cs_cl *A, cs_long_t k, const cs_long_t *parent,
     cs_long_t *s, cs_long_t *w) ;
 cs_long_t *cs_cl_randperm (cs_long_t n, cs_long_t seed) ;
+cs_long_t cs_cl_pthreads (cs_long_t nthreads, double work) ;
+cs_long_t cs_cl_pslice (const double *Wp, cs_long_t n, cs_long_t ntasks,
+    cs_long_t *Slice) ;
+cs_long_t *cs_cl_super (const cs_long_t *parent, const cs_long_t *cp,
+    cs_long_t n, cs_long_t *nsuper) ;
 
 /* utilities */
 cs_cld *cs_cl_dalloc (cs_long_t m, cs_long_t n) ;
@@ -671,9 +727,15 @@ cs_cld *cs_cl_ddone (cs_cld *D, cs_cl *C, void *w, cs_long_t ok) ;
 #define cs_qrsol CS_NAME (_qrsol)
 #define cs_transpose CS_NAME (_transpose)
 #define cs_compress CS_NAME (_compress)
+#define cs_padd CS_NAME (_padd)
+#define cs_pgaxpy CS_NAME (_pgaxpy)
+#define cs_pmultiply CS_NAME (_pmultiply)
+#define cs_ptranspose CS_NAME (_ptranspose)
+#define cs_pcompress CS_NAME (_pcompress)
 #define cs_norm CS_NAME (_norm)
 #define cs_print CS_NAME (_print)
 #define cs_load CS_NAME (_load)
+#define cs_bin CS_NAME (_bin)
 
 /* utilities */
 #define cs_calloc CS_NAME (_calloc)
@@ -733,6 +795,9 @@ cs_cld *cs_cl_ddone (cs_cld *D, cs_cl *C, void *w, cs_long_t ok) ;
 #define cs_ereach CS_NAME (_ereach)
 #define cs_randperm CS_NAME (_randperm)
 #define cs_leaf CS_NAME (_leaf)
+#define cs_pthreads CS_NAME (_pthreads)
+#define cs_pslice CS_NAME (_pslice)
+#define cs_super CS_NAME (_super)
 
 /* utilities */
 #define cs_dalloc CS_NAME (_dalloc)
@@ -0,0 +1,26 @@
+#include "cs.h"
+/* use a compressed-column matrix loaded by SuiteSparse_bin_load as a cs matrix,
+ * without copying it.  A is a header supplied by the caller; it holds the
+ * arrays of B and must not be freed with cs_spfree. */
+cs *cs_bin (const SuiteSparse_bin *B, cs *A)
+{
+#ifdef CS_COMPLEX
+    int xtype = SUITESPARSE_BIN_COMPLEX ;
+#else
+    int xtype = SUITESPARSE_BIN_REAL ;
+#endif
+    if (!B || !A || !B->p) return (NULL) ;              /* check inputs */
+    if (B->orient != SUITESPARSE_BIN_CSC || B->isize != sizeof (CS_INT) ||
+        (B->xtype != SUITESPARSE_BIN_PATTERN && B->xtype != xtype))
+    {
+        return (NULL) ;                                 /* cannot use B as-is */
+    }
+    A->nzmax = B->nnz ;
+    A->m = B->nrow ;
+    A->n = B->ncol ;
+    A->p = B->p ;
+    A->i = B->i ;
+    A->x = (CS_ENTRY *) B->x ;                          /* NULL if pattern */
+    A->nz = -1 ;                                        /* compressed-column */
+    return (A) ;
+}
@@ -1,4 +1,149 @@
 #include "cs.h"
+/* y = L(K:K+m-1,f:l)*w for the supernode f:l of L; column t of the supernode
+ * holds rows t:l of the diagonal block followed by the rows below it */
+static void cs_super_gemv (CS_ENTRY *y, const CS_ENTRY *Lx, const CS_INT *Lp,
+    CS_INT f, CS_INT l, CS_INT K, CS_INT m, const CS_ENTRY *w)
+{
+    CS_INT q, t ;
+    const CS_ENTRY *x0, *x1, *x2, *x3 ;
+    for (q = 0 ; q < m ; q++) y [q] = 0 ;
+    for (t = f ; t + 3 <= l ; t += 4)       /* four columns at a time */
+    {
+        x0 = Lx + Lp [t  ] - t     + K ;    /* x0 = L(K:K+m-1,t) */
+        x1 = Lx + Lp [t+1] - (t+1) + K ;
+        x2 = Lx + Lp [t+2] - (t+2) + K ;
+        x3 = Lx + Lp [t+3] - (t+3) + K ;
+        for (q = 0 ; q < m ; q++)
+        {
+            y [q] += x0 [q] * w [t-f] + x1 [q] * w [t+1-f]
+                   + x2 [q] * w [t+2-f] + x3 [q] * w [t+3-f] ;
+        }
+    }
+    for ( ; t <= l ; t++)
+    {
+        x0 = Lx + Lp [t] - t + K ;
+        for (q = 0 ; q < m ; q++) y [q] += x0 [q] * w [t-f] ;
+    }
+}
+/* left-looking supernodal L = chol (A, [pinv parent cp super]) */
+static csn *cs_chol_super (const cs *A, const css *S)
+{
+    CS_ENTRY *Lx, *Cx, *W, *Y, *Lc ;
+    double d ;
+    CS_INT top, i, j, p, p2, q, k, n, f, l, t, fd, ld, nr, nrd, s, dd, dnext,
+        nsuper, *Li, *Lp, *cp, *pinv, *c, *w, *parent, *super, *Cp, *Ci, *R,
+        *Map, *SuperMap, *Head, *Next, *Lpos ;
+    cs *L, *C, *E ;
+    csn *N ;
+    n = A->n ; nsuper = S->nsuper ;
+    N = cs_calloc (1, sizeof (csn)) ;       /* allocate result */
+    w = cs_malloc (3*n + 3*nsuper, sizeof (CS_INT)) ; /* CS_INT workspace */
+    W = cs_malloc (2*n, sizeof (CS_ENTRY)) ;    /* get CS_ENTRY workspace */
+    cp = S->cp ; pinv = S->pinv ; parent = S->parent ; super = S->super ;
+    C = pinv ? cs_symperm (A, pinv, 1) : ((cs *) A) ;
+    E = pinv ? C : NULL ;           /* E is alias for A, or a copy E=A(p,p) */
+    if (!N || !w || !W || !C) return (cs_ndone (N, E, w, W, 0)) ;
+    c = w ; Map = w + n ; SuperMap = w + 2*n ; Head = w + 3*n ;
+    Next = Head + nsuper ; Lpos = Next + nsuper ; Y = W + n ;
+    Cp = C->p ; Ci = C->i ; Cx = C->x ;
+    N->L = L = cs_spalloc (n, n, cp [n], 1, 0) ;    /* allocate result */
+    if (!L) return (cs_ndone (N, E, w, W, 0)) ;
+    Lp = L->p ; Li = L->i ; Lx = L->x ;
+    /* --- Pattern of L, and L = triu(C)' ----------------------------------- */
+    for (k = 0 ; k < n ; k++) Lp [k] = c [k] = cp [k] ;
+    Lp [n] = cp [n] ;
+    for (k = 0 ; k < n ; k++)
+    {
+        top = cs_ereach (C, k, parent, SuperMap, c) ;   /* pattern of L(k,:) */
+        for ( ; top < n ; top++)
+        {
+            p = c [SuperMap [top]]++ ;
+            Li [p] = k ;                /* L(k,i) is in column i */
+            Lx [p] = 0 ;
+        }
+        p = c [k]++ ;
+        Li [p] = k ;                    /* L(k,k) is first in column k */
+        Lx [p] = 0 ;
+        for (p = Cp [k] ; p < Cp [k+1] ; p++)   /* L(k,i) = C(i,k)' */
+        {
+            i = Ci [p] ;
+            if (i < k) Lx [c [i]-1] = CS_CONJ (Cx [p]) ;
+            else if (i == k) Lx [Lp [k]] = Cx [p] ;
+        }
+        if (CS_IMAG (Lx [Lp [k]]) != 0) return (cs_ndone (N, E, w, W, 0)) ;
+    }
+    /* --- Numerical factorization, one supernode at a time ----------------- */
+    for (s = 0 ; s < nsuper ; s++)
+    {
+        Head [s] = -1 ;
+        for (j = super [s] ; j < super [s+1] ; j++) SuperMap [j] = s ;
+    }
+    for (s = 0 ; s < nsuper ; s++)
+    {
+        f = super [s] ; l = super [s+1] - 1 ;
+        R = Li + Lp [l] + 1 ;           /* R = rows of L(:,f:l) below l */
+        nr = Lp [l+1] - Lp [l] - 1 ;
+        for (i = f ; i <= l ; i++) Map [i] = i - f ;
+        for (q = 0 ; q < nr ; q++) Map [R [q]] = l - f + 1 + q ;
+        /* --- Update with each descendant d that updates L(:,f:l) ---------- */
+        for (dd = Head [s] ; dd != -1 ; dd = dnext)
+        {
+            dnext = Next [dd] ;
+            fd = super [dd] ; ld = super [dd+1] - 1 ;
+            nrd = Lp [ld+1] - Lp [ld] - 1 ;
+            p = Lpos [dd] ;             /* L(Rd [p:p2-1],fd:ld) updates s */
+            for (p2 = p ; p2 < nrd && Li [Lp [ld] + 1 + p2] <= l ; p2++) ;
+            for ( ; p < p2 ; p++)
+            {
+                j = Li [Lp [ld] + 1 + p] ;
+                for (t = fd ; t <= ld ; t++)   /* W = L(j,fd:ld)' */
+                {
+                    W [t-fd] = CS_CONJ (Lx [Lp [t] - t + ld + 1 + p]) ;
+                }
+                cs_super_gemv (Y, Lx, Lp, fd, ld, ld + 1 + p, nrd - p, W) ;
+                Lc = Lx + Lp [j] - j + f ;
+                for (q = 0 ; q < nrd - p ; q++)     /* L(:,j) -= Y */
+                {
+                    Lc [Map [Li [Lp [ld] + 1 + p + q]]] -= Y [q] ;
+                }
+            }
+            if (p2 < nrd)               /* d next updates a later supernode */
+            {
+                Lpos [dd] = p2 ;
+                k = SuperMap [Li [Lp [ld] + 1 + p2]] ;
+                Next [dd] = Head [k] ;
+                Head [k] = dd ;
+            }
+        }
+        /* --- Dense Cholesky of the supernode ------------------------------ */
+        for (j = f ; j <= l ; j++)
+        {
+            k = Lp [j+1] - Lp [j] ;
+            if (j > f)
+            {
+                for (t = f ; t < j ; t++)       /* W = L(j,f:j-1)' */
+                {
+                    W [t-f] = CS_CONJ (Lx [Lp [t] - t + j]) ;
+                }
+                cs_super_gemv (Y, Lx, Lp, f, j-1, j, k, W) ;
+                for (q = 0 ; q < k ; q++) Lx [Lp [j] + q] -= Y [q] ;
+            }
+            d = CS_REAL (Lx [Lp [j]]) ;     /* d = L(j,j)^2 */
+            if (d <= 0) return (cs_ndone (N, E, w, W, 0)) ; /* not pos def */
+            d = sqrt (d) ;
+            Lx [Lp [j]] = d ;
+            for (q = 1 ; q < k ; q++) Lx [Lp [j] + q] /= d ;
+        }
+        if (nr > 0)                     /* s next updates supernode of R [0] */
+        {
+            Lpos [s] = 0 ;
+            k = SuperMap [R [0]] ;
+            Next [s] = Head [k] ;
+            Head [k] = s ;
+        }
+    }
+    return (cs_ndone (N, E, w, W, 1)) ; /* success: free E,w,W; return N */
+}
 /* L = chol (A, [pinv parent cp]), pinv is optional */
 csn *cs_chol (const cs *A, const css *S)
 {
@@ -8,6 +153,7 @@ csn *cs_chol (const cs *A, const css *S)
     csn *N ;
     if (!CS_CSC (A) || !S || !S->cp || !S->parent) return (NULL) ;
     n = A->n ;
+    if (S->super && 2*S->nsuper <= n) return (cs_chol_super (A, S)) ;
     N = cs_calloc (1, sizeof (csn)) ;       /* allocate result */
     c = cs_malloc (2*n, sizeof (CS_INT)) ;     /* get CS_INT workspace */
     x = cs_malloc (n, sizeof (CS_ENTRY)) ;    /* get CS_ENTRY workspace */
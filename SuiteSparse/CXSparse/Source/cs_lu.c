@@ -1,81 +1,157 @@
 #include "cs.h"
-/* [L,U,pinv]=lu(A, [q lnz unz]). lnz and unz can be guess */
+#define CS_PANEL 8      /* # of columns factorized together in a panel */
+/* [L,U,pinv]=lu(A, [q lnz unz]). lnz and unz can be guess.  The columns of
+ * A(:,q) are factorized in panels of CS_PANEL columns.  The updates from the
+ * columns of L to the left of a panel are applied to the whole panel at once
+ * (one depth-first search and one pass over each column of L), and then each
+ * column of the panel is finished, pivoted and scaled in turn.  The updates
+ * and the pivot search follow the order of the whole panel, so pivots that
+ * tie or differ only by roundoff may be chosen differently than by a
+ * column-at-a-time factorization. */
 csn *cs_lu (const cs *A, const css *S, double tol)
 {
     cs *L, *U ;
     csn *N ;
-    CS_ENTRY pivot, *Lx, *Ux, *x ;
+    CS_ENTRY pivot, lij, xj, *Lx, *Ux, *Ax, *X ;
     double a, t ;
-    CS_INT *Lp, *Li, *Up, *Ui, *pinv, *xi, *q, n, ipiv, k, top, p, i, col, lnz,unz;
+    CS_INT *Lp, *Li, *Up, *Ui, *Ap, *Ai, *pinv, *xi, *mask, *q, n, ipiv, k, k0,
+        w, c, bits, top, p, pl, i, j, J, col, lnz, unz ;
     if (!CS_CSC (A) || !S) return (NULL) ;          /* check inputs */
-    n = A->n ;
+    n = A->n ; Ap = A->p ; Ai = A->i ; Ax = A->x ;
     q = S->q ; lnz = S->lnz ; unz = S->unz ;
-    x = cs_malloc (n, sizeof (CS_ENTRY)) ;            /* get CS_ENTRY workspace */
-    xi = cs_malloc (2*n, sizeof (CS_INT)) ;            /* get CS_INT workspace */
+    X = cs_malloc (n*CS_PANEL, sizeof (CS_ENTRY)) ; /* CS_ENTRY workspace */
+    xi = cs_malloc (3*n, sizeof (CS_INT)) ;            /* get CS_INT workspace */
     N = cs_calloc (1, sizeof (csn)) ;               /* allocate result */
-    if (!x || !xi || !N) return (cs_ndone (N, NULL, xi, x, 0)) ;
+    if (!X || !xi || !N) return (cs_ndone (N, NULL, xi, X, 0)) ;
     N->L = L = cs_spalloc (n, n, lnz, 1, 0) ;       /* allocate result L */
     N->U = U = cs_spalloc (n, n, unz, 1, 0) ;       /* allocate result U */
     N->pinv = pinv = cs_malloc (n, sizeof (CS_INT)) ;  /* allocate result pinv */
-    if (!L || !U || !pinv) return (cs_ndone (N, NULL, xi, x, 0)) ;
-    Lp = L->p ; Up = U->p ;
-    for (i = 0 ; i < n ; i++) x [i] = 0 ;           /* clear workspace */
+    if (!L || !U || !pinv) return (cs_ndone (N, NULL, xi, X, 0)) ;
+    Lp = L->p ; Up = U->p ; mask = xi + 2*n ;
+    for (i = 0 ; i < n*CS_PANEL ; i++) X [i] = 0 ;  /* clear workspace */
+    for (i = 0 ; i < n ; i++) mask [i] = 0 ;
     for (i = 0 ; i < n ; i++) pinv [i] = -1 ;       /* no rows pivotal yet */
     for (k = 0 ; k <= n ; k++) Lp [k] = 0 ;         /* no cols of L yet */
     lnz = unz = 0 ;
-    for (k = 0 ; k < n ; k++)       /* compute L(:,k) and U(:,k) */
+    for (k0 = 0 ; k0 < n ; k0 += CS_PANEL)  /* compute L and U (:,k0:k0+w-1) */
     {
-        /* --- Triangular solve --------------------------------------------- */
-        Lp [k] = lnz ;              /* L(:,k) starts here */
-        Up [k] = unz ;              /* U(:,k) starts here */
-        if ((lnz + n > L->nzmax && !cs_sprealloc (L, 2*L->nzmax + n)) ||
-            (unz + n > U->nzmax && !cs_sprealloc (U, 2*U->nzmax + n)))
+        w = CS_MIN (CS_PANEL, n - k0) ;
+        Lp [k0] = lnz ;
+        /* --- Pattern of the panel in the graph of L(:,0:k0-1) ------------- */
+        /* X(i,c) is stored in X [i*CS_PANEL+c]; bit c of mask [i] is set if
+         * X(i,c) is nonzero, and xi [top..n-1] is the union of the patterns */
+        top = n ;
+        for (c = 0 ; c < w ; c++)
         {
-            return (cs_ndone (N, NULL, xi, x, 0)) ;
+            col = q ? (q [k0+c]) : k0+c ;
+            for (p = Ap [col] ; p < Ap [col+1] ; p++)
+            {
+                i = Ai [p] ;
+                if (!CS_MARKED (Lp, i))     /* start a dfs at unmarked node i */
+                {
+                    top = cs_dfs (i, L, top, xi, xi+n, pinv) ;
+                }
+                mask [i] |= ((CS_INT) 1) << c ;
+                X [i*CS_PANEL+c] = Ax [p] ;     /* X(:,c) = A(:,col) */
+            }
         }
-        Li = L->i ; Lx = L->x ; Ui = U->i ; Ux = U->x ;
-        col = q ? (q [k]) : k ;
-        top = cs_spsolve (L, A, col, xi, x, pinv, 1) ;  /* x = L\A(:,col) */
-        /* --- Find pivot --------------------------------------------------- */
-        ipiv = -1 ;
-        a = -1 ;
+        for (p = top ; p < n ; p++) CS_MARK (Lp, xi [p]) ;  /* restore L */
+        /* --- Update the panel with L(:,0:k0-1) ---------------------------- */
+        Li = L->i ; Lx = L->x ;
         for (p = top ; p < n ; p++)
         {
-            i = xi [p] ;            /* x(i) is nonzero */
-            if (pinv [i] < 0)       /* row i is not yet pivotal */
+            j = xi [p] ;
+            J = pinv [j] ;          /* j maps to column J of L */
+            if (J < 0) continue ;   /* column J is not yet computed */
+            bits = mask [j] ;
+            for (pl = Lp [J] + 1 ; pl < Lp [J+1] ; pl++)
             {
-                if ((t = CS_ABS (x [i])) > a)
+                i = Li [pl] ;
+                lij = Lx [pl] ;
+                mask [i] |= bits ;
+                for (c = 0 ; c < w ; c++)   /* X(i,c) -= L(i,J) * X(j,c) */
                 {
-                    a = t ;         /* largest pivot candidate so far */
-                    ipiv = i ;
+                    if (bits & (((CS_INT) 1) << c))
+                    {
+                        X [i*CS_PANEL+c] -= lij * X [j*CS_PANEL+c] ;
+                    }
                 }
             }
-            else                    /* x(i) is the entry U(pinv[i],k) */
-            {
-                Ui [unz] = pinv [i] ;
-                Ux [unz++] = x [i] ;
-            }
         }
-        if (ipiv == -1 || a <= 0) return (cs_ndone (N, NULL, xi, x, 0)) ;
-        /* tol=1 for  partial pivoting; tol<1 gives preference to diagonal */
-        if (pinv [col] < 0 && CS_ABS (x [col]) >= a*tol) ipiv = col ;
-        /* --- Divide by pivot ---------------------------------------------- */
-        pivot = x [ipiv] ;          /* the chosen pivot */
-        Ui [unz] = k ;              /* last entry in U(:,k) is U(k,k) */
-        Ux [unz++] = pivot ;
-        pinv [ipiv] = k ;           /* ipiv is the kth pivot row */
-        Li [lnz] = ipiv ;           /* first entry in L(:,k) is L(k,k) = 1 */
-        Lx [lnz++] = 1 ;
-        for (p = top ; p < n ; p++) /* L(k+1:n,k) = x / pivot */
+        /* --- Finish each column of the panel ------------------------------ */
+        for (c = 0 ; c < w ; c++)
         {
-            i = xi [p] ;
-            if (pinv [i] < 0)       /* x(i) is an entry in L(:,k) */
+            k = k0 + c ;
+            bits = ((CS_INT) 1) << c ;
+            Lp [k] = lnz ;              /* L(:,k) starts here */
+            Up [k] = unz ;              /* U(:,k) starts here */
+            if ((lnz + n > L->nzmax && !cs_sprealloc (L, 2*L->nzmax + n)) ||
+                (unz + n > U->nzmax && !cs_sprealloc (U, 2*U->nzmax + n)))
+            {
+                return (cs_ndone (N, NULL, xi, X, 0)) ;
+            }
+            Li = L->i ; Lx = L->x ; Ui = U->i ; Ux = U->x ;
+            col = q ? (q [k]) : k ;
+            for (J = k0 ; J < k ; J++)  /* update with L(:,k0:k-1) */
+            {
+                j = Li [Lp [J]] ;       /* L(:,J) has pivot row j */
+                if (!(mask [j] & bits)) continue ;
+                xj = X [j*CS_PANEL+c] ;
+                for (pl = Lp [J] + 1 ; pl < Lp [J+1] ; pl++)
+                {
+                    i = Li [pl] ;
+                    mask [i] |= bits ;
+                    X [i*CS_PANEL+c] -= Lx [pl] * xj ;
+                }
+            }
+            /* --- Find pivot ----------------------------------------------- */
+            ipiv = -1 ;
+            a = -1 ;
+            for (p = top ; p < n ; p++)
             {
-                Li [lnz] = i ;      /* save unpermuted row in L */
-                Lx [lnz++] = x [i] / pivot ;    /* scale pivot column */
+                i = xi [p] ;
+                if (!(mask [i] & bits)) continue ;  /* X(i,c) is zero */
+                if (pinv [i] < 0)       /* row i is not yet pivotal */
+                {
+                    if ((t = CS_ABS (X [i*CS_PANEL+c])) > a)
+                    {
+                        a = t ;         /* largest pivot candidate so far */
+                        ipiv = i ;
+                    }
+                }
+                else                    /* X(i,c) is the entry U(pinv[i],k) */
+                {
+                    Ui [unz] = pinv [i] ;
+                    Ux [unz++] = X [i*CS_PANEL+c] ;
+                }
+            }
+            if (ipiv == -1 || a <= 0) return (cs_ndone (N, NULL, xi, X, 0)) ;
+            /* tol=1 for partial pivoting; tol<1 gives preference to diagonal */
+            if (pinv [col] < 0 && CS_ABS (X [col*CS_PANEL+c]) >= a*tol)
+            {
+                ipiv = col ;
+            }
+            /* --- Divide by pivot ------------------------------------------ */
+            pivot = X [ipiv*CS_PANEL+c] ;   /* the chosen pivot */
+            Ui [unz] = k ;              /* last entry in U(:,k) is U(k,k) */
+            Ux [unz++] = pivot ;
+            pinv [ipiv] = k ;           /* ipiv is the kth pivot row */
+            Li [lnz] = ipiv ;           /* first entry in L(:,k) is L(k,k)=1 */
+            Lx [lnz++] = 1 ;
+            for (p = top ; p < n ; p++) /* L(k+1:n,k) = X(:,c) / pivot */
+            {
+                i = xi [p] ;
+                if (!(mask [i] & bits)) continue ;
+                if (pinv [i] < 0)       /* X(i,c) is an entry in L(:,k) */
+                {
+                    Li [lnz] = i ;      /* save unpermuted row in L */
+                    Lx [lnz++] = X [i*CS_PANEL+c] / pivot ;
+                }
+                X [i*CS_PANEL+c] = 0 ;  /* X(:,c) = 0 for the next panel */
             }
-            x [i] = 0 ;             /* x [0..n-1] = 0 for next k */
+            Lp [k+1] = lnz ;            /* L(:,k) ends here */
         }
+        for (p = top ; p < n ; p++) mask [xi [p]] = 0 ;
     }
     /* --- Finalize L and U ------------------------------------------------- */
     Lp [n] = lnz ;
@@ -84,5 +160,5 @@ csn *cs_lu (const cs *A, const css *S, double tol)
     for (p = 0 ; p < lnz ; p++) Li [p] = pinv [Li [p]] ;
     cs_sprealloc (L, 0) ;           /* remove extra space from L and U */
     cs_sprealloc (U, 0) ;
-    return (cs_ndone (N, NULL, xi, x, 1)) ;     /* success */
+    return (cs_ndone (N, NULL, xi, X, 1)) ;     /* success */
 }
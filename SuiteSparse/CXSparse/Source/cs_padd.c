@@ -0,0 +1,72 @@
+#include "cs.h"
+/* C = alpha*A + beta*B, in parallel.  Same result as cs_add */
+cs *cs_padd (const cs *A, const cs *B, CS_ENTRY alpha, CS_ENTRY beta,
+    CS_INT nthreads)
+{
+    CS_INT p, j, i, t, nz, m, n, ntasks, values, *Cp, *Ci, *Ap, *Ai, *Bp, *Bi,
+        *W, *w, *Slice, *Cnz ;
+    CS_ENTRY *X, *x, *Bx, *Cx ;
+    double *Wp ;
+    cs *C ;
+    if (!CS_CSC (A) || !CS_CSC (B)) return (NULL) ;         /* check inputs */
+    if (A->m != B->m || A->n != B->n) return (NULL) ;
+    m = A->m ; Ap = A->p ; Ai = A->i ;
+    n = B->n ; Bp = B->p ; Bi = B->i ; Bx = B->x ;
+    ntasks = cs_pthreads (nthreads, (double) Ap [n] + (double) Bp [n]) ;
+    if (ntasks == 1) return (cs_add (A, B, alpha, beta)) ;
+    values = (A->x != NULL) && (Bx != NULL) ;
+    W = cs_calloc (ntasks * m, sizeof (CS_INT)) ;            /* get workspace */
+    X = values ? cs_malloc (ntasks * m, sizeof (CS_ENTRY)) : NULL ;
+    Slice = cs_malloc (ntasks+1, sizeof (CS_INT)) ;
+    Cnz = cs_malloc (n, sizeof (CS_INT)) ;
+    Wp = cs_malloc (n+1, sizeof (double)) ;
+    C = cs_spalloc (m, n, Ap [n] + Bp [n], values, 0) ;     /* allocate result*/
+    if (!W || (values && !X) || !Slice || !Cnz || !Wp || !C)
+    {
+        cs_free (Slice) ; cs_free (Cnz) ; cs_free (Wp) ;
+        return (cs_done (C, W, X, 0)) ;                     /* out of memory */
+    }
+    for (j = 0 ; j <= n ; j++) Wp [j] = (double) Ap [j] + (double) Bp [j] ;
+    cs_pslice (Wp, n, ntasks, Slice) ;  /* task t does C(:,Slice[t]...) */
+    cs_free (Wp) ;
+    /* count the entries in each column of C */
+    #pragma omp parallel for num_threads(ntasks) private(w,j,p,i,nz)
+    for (t = 0 ; t < ntasks ; t++)
+    {
+        w = W + t*m ;
+        for (j = Slice [t] ; j < Slice [t+1] ; j++)
+        {
+            nz = 0 ;
+            for (p = Ap [j] ; p < Ap [j+1] ; p++)
+            {
+                i = Ai [p] ;
+                if (w [i] < j+1) { w [i] = j+1 ; nz++ ; }
+            }
+            for (p = Bp [j] ; p < Bp [j+1] ; p++)
+            {
+                i = Bi [p] ;
+                if (w [i] < j+1) { w [i] = j+1 ; nz++ ; }
+            }
+            Cnz [j] = nz ;
+        }
+    }
+    Cp = C->p ; Ci = C->i ; Cx = C->x ;
+    cs_cumsum (Cp, Cnz, n) ;                            /* column pointers */
+    /* compute C(:,j), in the same way as cs_add */
+    #pragma omp parallel for num_threads(ntasks) private(w,x,j,p,nz)
+    for (t = 0 ; t < ntasks ; t++)
+    {
+        w = W + t*m ;
+        x = values ? (X + t*m) : NULL ;
+        for (j = 0 ; j < m ; j++) w [j] = 0 ;
+        for (j = Slice [t] ; j < Slice [t+1] ; j++)
+        {
+            nz = cs_scatter (A, j, alpha, w, x, j+1, C, Cp [j]) ;
+            nz = cs_scatter (B, j, beta, w, x, j+1, C, nz) ;
+            if (values) for (p = Cp [j] ; p < nz ; p++) Cx [p] = x [Ci [p]] ;
+        }
+    }
+    cs_sprealloc (C, 0) ;               /* remove extra space from C */
+    cs_free (Slice) ; cs_free (Cnz) ;
+    return (cs_done (C, W, X, 1)) ;     /* success; free workspace, return C */
+}
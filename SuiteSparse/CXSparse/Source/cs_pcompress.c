@@ -0,0 +1,58 @@
+#include "cs.h"
+/* C = compressed-column form of a triplet matrix T, in parallel.  Same result
+ * as cs_compress */
+cs *cs_pcompress (const cs *T, CS_INT nthreads)
+{
+    CS_INT m, n, nz, p, k, c, j, t, ntasks, *Cp, *Ci, *W, *w, *Ti, *Tj ;
+    CS_ENTRY *Cx, *Tx ;
+    cs *C ;
+    if (!CS_TRIPLET (T)) return (NULL) ;                /* check inputs */
+    m = T->m ; n = T->n ; Ti = T->i ; Tj = T->p ; Tx = T->x ; nz = T->nz ;
+    ntasks = cs_pthreads (nthreads, (double) nz) ;
+    if (ntasks == 1) return (cs_compress (T)) ;
+    C = cs_spalloc (m, n, nz, Tx != NULL, 0) ;          /* allocate result */
+    W = cs_calloc ((ntasks+1) * n, sizeof (CS_INT)) ;      /* get workspace */
+    if (!C || !W) return (cs_done (C, W, NULL, 0)) ;    /* out of memory */
+    Cp = C->p ; Ci = C->i ; Cx = C->x ;
+    /* column counts of each task, where task t does entries
+     * (t*nz)/ntasks to ((t+1)*nz)/ntasks-1 of T */
+    #pragma omp parallel for num_threads(ntasks) private(w,k)
+    for (t = 0 ; t < ntasks ; t++)
+    {
+        w = W + t*n ;
+        for (k = (CS_INT) (((double) nz * t) / ntasks) ;
+             k < (CS_INT) (((double) nz * (t+1)) / ntasks) ; k++)
+        {
+            w [Tj [k]]++ ;
+        }
+    }
+    #pragma omp parallel for num_threads(ntasks) private(t,c)
+    for (j = 0 ; j < n ; j++)
+    {
+        for (c = 0, t = 0 ; t < ntasks ; t++) c += W [t*n+j] ;
+        W [ntasks*n+j] = c ;
+    }
+    cs_cumsum (Cp, W + ntasks*n, n) ;                   /* column pointers */
+    #pragma omp parallel for num_threads(ntasks) private(t,c,p)
+    for (j = 0 ; j < n ; j++)
+    {
+        for (p = Cp [j], t = 0 ; t < ntasks ; t++)
+        {
+            c = W [t*n+j] ;
+            W [t*n+j] = p ;
+            p += c ;
+        }
+    }
+    #pragma omp parallel for num_threads(ntasks) private(w,k,p)
+    for (t = 0 ; t < ntasks ; t++)
+    {
+        w = W + t*n ;
+        for (k = (CS_INT) (((double) nz * t) / ntasks) ;
+             k < (CS_INT) (((double) nz * (t+1)) / ntasks) ; k++)
+        {
+            Ci [p = w [Tj [k]]++] = Ti [k] ;    /* A(i,j) is the pth entry in C */
+            if (Cx) Cx [p] = Tx [k] ;
+        }
+    }
+    return (cs_done (C, W, NULL, 1)) ;      /* success; free W and return C */
+}
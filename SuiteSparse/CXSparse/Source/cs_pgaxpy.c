@@ -0,0 +1,46 @@
+#include "cs.h"
+/* y = A*x+y, in parallel.  Each task does a block of rows of y, so the result
+ * is the same as cs_gaxpy.  This requires sorted columns of A (checked here);
+ * otherwise cs_gaxpy is used. */
+CS_INT cs_pgaxpy (const cs *A, const CS_ENTRY *x, CS_ENTRY *y, CS_INT nthreads)
+{
+    CS_INT p, j, m, n, t, ntasks, sorted, i1, i2, lo, hi, mid, *Ap, *Ai ;
+    CS_ENTRY *Ax ;
+    if (!CS_CSC (A) || !x || !y) return (0) ;       /* check inputs */
+    m = A->m ; n = A->n ; Ap = A->p ; Ai = A->i ; Ax = A->x ;
+    ntasks = CS_MIN (cs_pthreads (nthreads, (double) Ap [n]), m) ;
+    if (ntasks <= 1) return (cs_gaxpy (A, x, y)) ;
+    sorted = 1 ;
+    #pragma omp parallel for num_threads(ntasks) private(p) \
+        reduction(&&:sorted)
+    for (j = 0 ; j < n ; j++)
+    {
+        for (p = Ap [j] + 1 ; p < Ap [j+1] ; p++)
+        {
+            if (Ai [p-1] > Ai [p]) sorted = 0 ;
+        }
+    }
+    if (!sorted) return (cs_gaxpy (A, x, y)) ;
+    /* task t does rows (t*m)/ntasks to ((t+1)*m)/ntasks-1 of y */
+    #pragma omp parallel for num_threads(ntasks) \
+        private(i1,i2,j,p,lo,hi,mid)
+    for (t = 0 ; t < ntasks ; t++)
+    {
+        i1 = (CS_INT) (((double) m * t) / ntasks) ;
+        i2 = (CS_INT) (((double) m * (t+1)) / ntasks) ;
+        for (j = 0 ; j < n ; j++)
+        {
+            lo = Ap [j] ; hi = Ap [j+1] ;
+            while (lo < hi)         /* find the first row i >= i1 in A(:,j) */
+            {
+                mid = lo + (hi - lo) / 2 ;
+                if (Ai [mid] < i1) lo = mid + 1 ; else hi = mid ;
+            }
+            for (p = lo ; p < Ap [j+1] && Ai [p] < i2 ; p++)
+            {
+                y [Ai [p]] += Ax [p] * x [j] ;
+            }
+        }
+    }
+    return (1) ;
+}
@@ -0,0 +1,96 @@
+#include "cs.h"
+/* C = A*B, in parallel.  Same result as cs_multiply */
+cs *cs_pmultiply (const cs *A, const cs *B, CS_INT nthreads)
+{
+    CS_INT p, pa, j, k, t, nz, m, n, ntasks, values, *Cp, *Ci, *Ap, *Ai, *Bp,
+        *Bi, *W, *w, *Slice, *Cnz ;
+    CS_ENTRY *X, *x, *Bx, *Cx ;
+    double *Wp, cnz ;
+    cs *C ;
+    if (!CS_CSC (A) || !CS_CSC (B)) return (NULL) ;      /* check inputs */
+    if (A->n != B->m) return (NULL) ;
+    m = A->m ; Ap = A->p ; Ai = A->i ;
+    n = B->n ; Bp = B->p ; Bi = B->i ; Bx = B->x ;
+    /* Wp [j+1] - Wp [j] is the work for C(:,j) */
+    Wp = cs_malloc (n+1, sizeof (double)) ;
+    if (!Wp) return (NULL) ;                            /* out of memory */
+    ntasks = cs_pthreads (nthreads, (double) Bp [n]) ;
+    #pragma omp parallel for num_threads(ntasks) private(p,cnz)
+    for (j = 0 ; j < n ; j++)
+    {
+        for (cnz = 0, p = Bp [j] ; p < Bp [j+1] ; p++)
+        {
+            cnz += Ap [Bi [p]+1] - Ap [Bi [p]] + 1 ;
+        }
+        Wp [j+1] = cnz ;
+    }
+    for (Wp [0] = 0, j = 0 ; j < n ; j++) Wp [j+1] += Wp [j] ;
+    ntasks = cs_pthreads (nthreads, Wp [n]) ;
+    if (ntasks == 1)
+    {
+        cs_free (Wp) ;
+        return (cs_multiply (A, B)) ;
+    }
+    values = (A->x != NULL) && (Bx != NULL) ;
+    W = cs_calloc (ntasks * m, sizeof (CS_INT)) ;         /* get workspace */
+    X = values ? cs_malloc (ntasks * m, sizeof (CS_ENTRY)) : NULL ;
+    Slice = cs_malloc (ntasks+1, sizeof (CS_INT)) ;
+    Cnz = cs_malloc (n, sizeof (CS_INT)) ;
+    if (!W || (values && !X) || !Slice || !Cnz)
+    {
+        cs_free (Wp) ; cs_free (Slice) ; cs_free (Cnz) ;
+        return (cs_done (NULL, W, X, 0)) ;              /* out of memory */
+    }
+    cs_pslice (Wp, n, ntasks, Slice) ;  /* task t does C(:,Slice[t]...) */
+    cs_free (Wp) ;
+    /* count the entries in each column of C */
+    #pragma omp parallel for num_threads(ntasks) private(w,j,p,pa,k,nz)
+    for (t = 0 ; t < ntasks ; t++)
+    {
+        w = W + t*m ;
+        for (j = Slice [t] ; j < Slice [t+1] ; j++)
+        {
+            for (nz = 0, p = Bp [j] ; p < Bp [j+1] ; p++)
+            {
+                for (pa = Ap [Bi [p]] ; pa < Ap [Bi [p]+1] ; pa++)
+                {
+                    k = Ai [pa] ;
+                    if (w [k] < j+1)
+                    {
+                        w [k] = j+1 ;   /* A(k,Bi[p]) creates C(k,j) */
+                        nz++ ;
+                    }
+                }
+            }
+            Cnz [j] = nz ;
+        }
+    }
+    for (cnz = 0, j = 0 ; j < n ; j++) cnz += Cnz [j] ;
+    C = (cnz > CS_INT_MAX) ? NULL :
+        cs_spalloc (m, n, (CS_INT) cnz, values, 0) ;  /* allocate result */
+    if (!C)
+    {
+        cs_free (Slice) ; cs_free (Cnz) ;
+        return (cs_done (NULL, W, X, 0)) ;              /* out of memory */
+    }
+    Cp = C->p ; Ci = C->i ; Cx = C->x ;
+    cs_cumsum (Cp, Cnz, n) ;                            /* column pointers */
+    /* compute C(:,j), in the same way as cs_multiply */
+    #pragma omp parallel for num_threads(ntasks) private(w,x,j,p,nz)
+    for (t = 0 ; t < ntasks ; t++)
+    {
+        w = W + t*m ;
+        x = values ? (X + t*m) : NULL ;
+        for (j = 0 ; j < m ; j++) w [j] = 0 ;
+        for (j = Slice [t] ; j < Slice [t+1] ; j++)
+        {
+            for (nz = Cp [j], p = Bp [j] ; p < Bp [j+1] ; p++)
+            {
+                nz = cs_scatter (A, Bi [p], Bx ? Bx [p] : 1, w, x, j+1, C, nz) ;
+            }
+            if (values) for (p = Cp [j] ; p < nz ; p++) Cx [p] = x [Ci [p]] ;
+        }
+    }
+    cs_free (Slice) ; cs_free (Cnz) ;
+    return (cs_done (C, W, X, 1)) ;     /* success; free workspace, return C */
+}
@@ -0,0 +1,41 @@
+#include "cs.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#define CS_PCHUNK 65536     /* minimum work per thread for the parallel kernels */
+
+/* number of threads to use for work flops; nthreads <= 0 means the default */
+CS_INT cs_pthreads (CS_INT nthreads, double work)
+{
+#ifdef _OPENMP
+    if (nthreads <= 0) nthreads = omp_get_max_threads ( ) ;
+    if (work / CS_PCHUNK < nthreads) nthreads = (CS_INT) (work / CS_PCHUNK) ;
+    return (CS_MAX (nthreads, 1)) ;
+#else
+    return (1) ;                    /* no parallelism without OpenMP */
+#endif
+}
+
+/* Slice [0..ntasks] splits 0..n-1 into ntasks ranges of about equal work,
+ * where Wp [0..n] is the cumulative work: task t does Slice [t] to
+ * Slice [t+1]-1 */
+CS_INT cs_pslice (const double *Wp, CS_INT n, CS_INT ntasks, CS_INT *Slice)
+{
+    CS_INT t, lo, hi, mid ;
+    double target ;
+    if (!Wp || !Slice || ntasks < 1) return (0) ;   /* check inputs */
+    Slice [0] = 0 ;
+    for (t = 1 ; t < ntasks ; t++)
+    {
+        target = Wp [0] + ((Wp [n] - Wp [0]) * t) / ntasks ;
+        lo = Slice [t-1] ; hi = n ;
+        while (lo < hi)             /* find the first j with Wp [j] >= target */
+        {
+            mid = lo + (hi - lo) / 2 ;
+            if (Wp [mid] < target) lo = mid + 1 ; else hi = mid ;
+        }
+        Slice [t] = lo ;
+    }
+    Slice [ntasks] = n ;
+    return (1) ;
+}
@@ -0,0 +1,71 @@
+#include "cs.h"
+/* C = A', in parallel.  Same result as cs_transpose */
+cs *cs_ptranspose (const cs *A, CS_INT values, CS_INT nthreads)
+{
+    CS_INT p, q, c, i, j, t, m, n, ntasks, *Cp, *Ci, *Ap, *Ai, *W, *Slice,
+        *w ;
+    CS_ENTRY *Cx, *Ax ;
+    double *Wp ;
+    cs *C ;
+    if (!CS_CSC (A)) return (NULL) ;    /* check inputs */
+    m = A->m ; n = A->n ; Ap = A->p ; Ai = A->i ; Ax = A->x ;
+    ntasks = cs_pthreads (nthreads, (double) Ap [n]) ;
+    if (ntasks == 1) return (cs_transpose (A, values)) ;
+    C = cs_spalloc (n, m, Ap [n], values && Ax, 0) ;       /* allocate result */
+    W = cs_calloc ((ntasks+1) * m, sizeof (CS_INT)) ;         /* get workspace */
+    Slice = cs_malloc (ntasks+1, sizeof (CS_INT)) ;
+    Wp = cs_malloc (n+1, sizeof (double)) ;
+    if (!C || !W || !Slice || !Wp)
+    {
+        cs_free (Slice) ; cs_free (Wp) ;
+        return (cs_done (C, W, NULL, 0)) ;                 /* out of memory */
+    }
+    Cp = C->p ; Ci = C->i ; Cx = C->x ;
+    for (j = 0 ; j <= n ; j++) Wp [j] = Ap [j] ;
+    cs_pslice (Wp, n, ntasks, Slice) ;      /* task t does A(:,Slice[t]...) */
+    cs_free (Wp) ;
+    /* row counts of each task, in W [t*m ... t*m+m-1] */
+    #pragma omp parallel for num_threads(ntasks) private(w,j,p)
+    for (t = 0 ; t < ntasks ; t++)
+    {
+        w = W + t*m ;
+        for (j = Slice [t] ; j < Slice [t+1] ; j++)
+        {
+            for (p = Ap [j] ; p < Ap [j+1] ; p++) w [Ai [p]]++ ;
+        }
+    }
+    /* total row counts, in W [ntasks*m ...] */
+    #pragma omp parallel for num_threads(ntasks) private(t,c)
+    for (i = 0 ; i < m ; i++)
+    {
+        for (c = 0, t = 0 ; t < ntasks ; t++) c += W [t*m+i] ;
+        W [ntasks*m+i] = c ;
+    }
+    cs_cumsum (Cp, W + ntasks*m, m) ;                      /* row pointers */
+    /* task t places its part of row i of A at W [t*m+i] onwards */
+    #pragma omp parallel for num_threads(ntasks) private(t,c,q)
+    for (i = 0 ; i < m ; i++)
+    {
+        for (q = Cp [i], t = 0 ; t < ntasks ; t++)
+        {
+            c = W [t*m+i] ;
+            W [t*m+i] = q ;
+            q += c ;
+        }
+    }
+    #pragma omp parallel for num_threads(ntasks) private(w,j,p,q)
+    for (t = 0 ; t < ntasks ; t++)
+    {
+        w = W + t*m ;
+        for (j = Slice [t] ; j < Slice [t+1] ; j++)
+        {
+            for (p = Ap [j] ; p < Ap [j+1] ; p++)
+            {
+                Ci [q = w [Ai [p]]++] = j ; /* place A(i,j) as entry C(j,i) */
+                if (Cx) Cx [q] = (values > 0) ? CS_CONJ (Ax [p]) : Ax [p] ;
+            }
+        }
+    }
+    cs_free (Slice) ;
+    return (cs_done (C, W, NULL, 1)) ;  /* success; free W and return C */
+}
@@ -22,5 +22,9 @@ css *cs_schol (CS_INT order, const cs *A)
     S->cp = cs_malloc (n+1, sizeof (CS_INT)) ; /* allocate result S->cp */
     S->unz = S->lnz = cs_cumsum (S->cp, c, n) ; /* find column pointers for L */
     cs_free (c) ;
-    return ((S->lnz >= 0) ? S : cs_sfree (S)) ;
+    if (S->lnz >= 0)                        /* find supernodes */
+    {
+        S->super = cs_super (S->parent, S->cp, n, &(S->nsuper)) ;
+    }
+    return ((S->lnz >= 0 && S->super) ? S : cs_sfree (S)) ;
 }
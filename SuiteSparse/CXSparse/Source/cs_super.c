@@ -0,0 +1,28 @@
+#include "cs.h"
+/* find the fundamental supernodes of L, given its etree and column pointers.
+ * Supernode k is L(:,super[k]:super[k+1]-1) */
+CS_INT *cs_super (const CS_INT *parent, const CS_INT *cp, CS_INT n,
+    CS_INT *nsuper)
+{
+    CS_INT j, ns = 0, *super, *nchild ;
+    if (!parent || !cp || !nsuper) return (NULL) ;     /* check inputs */
+    super = cs_malloc (n+1, sizeof (CS_INT)) ;          /* allocate result */
+    nchild = cs_calloc (n, sizeof (CS_INT)) ;           /* get workspace */
+    if (!super || !nchild)
+    {
+        cs_free (nchild) ;
+        return (cs_free (super)) ;                      /* out of memory */
+    }
+    for (j = 0 ; j < n ; j++) if (parent [j] != -1) nchild [parent [j]]++ ;
+    for (j = 0 ; j < n ; j++)
+    {
+        /* j starts a new supernode unless it is the only child of j-1 and
+         * L(:,j-1) is L(:,j) with one more row */
+        if (j == 0 || parent [j-1] != j || nchild [j] != 1 ||
+            cp [j] - cp [j-1] != cp [j+1] - cp [j] + 1) super [ns++] = j ;
+    }
+    super [ns] = n ;
+    *nsuper = ns ;
+    cs_free (nchild) ;
+    return (super) ;
+}
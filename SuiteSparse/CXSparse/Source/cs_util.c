@@ -59,6 +59,7 @@ css *cs_sfree (css *S)
     cs_free (S->parent) ;
     cs_free (S->cp) ;
     cs_free (S->leftmost) ;
+    cs_free (S->super) ;
     return ((css *) cs_free (S)) ;  /* free the css struct and return NULL */
 }
 
@@ -0,0 +1,4 @@
+#ifndef NCOMPLEX
+#define CS_COMPLEX
+#include <../Source/cs_bin.c>
+#endif // NCOMPLEX
@@ -0,0 +1 @@
+#include <../Source/cs_bin.c>
@@ -0,0 +1,5 @@
+#ifndef NCOMPLEX
+#define CS_LONG 
+#define CS_COMPLEX
+#include <../Source/cs_padd.c>
+#endif // NCOMPLEX
@@ -0,0 +1 @@
+#include <../Source/cs_padd.c>
@@ -0,0 +1 @@
+#include <../Source/cs_pcompress.c>
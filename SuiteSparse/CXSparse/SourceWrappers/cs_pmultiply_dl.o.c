@@ -0,0 +1,2 @@
+#define CS_LONG
+#include <../Source/cs_pmultiply.c>
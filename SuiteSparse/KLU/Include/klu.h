@@ -204,6 +204,14 @@ typedef struct klu_common_struct
     size_t memusage ;   /* current memory usage, in bytes */
     size_t mempeak ;    /* peak memory usage, in bytes */
 
+    /* ---------------------------------------------------------------------- */
+    /* parameters added after the statistics, to preserve the ABI */
+    /* ---------------------------------------------------------------------- */
+
+    int nthreads ;      /* number of threads to use in klu_analyze for the
+        * BTF pre-ordering (btf_porder and btf_pstrongcomp).  Default: 1, which
+        * uses btf_order and btf_strongcomp. */
+
 } klu_common ;
 
 typedef struct klu_l_common_struct /* 64-bit version (otherwise same as above)*/
@@ -220,6 +228,7 @@ typedef struct klu_l_common_struct /* 64-bit version (otherwise same as above)*/
         singular_col, noffdiag ;
     double flops, rcond, condest, rgrowth, work ;
     size_t memusage, mempeak ;
+    SuiteSparse_long nthreads ;
 
 } klu_l_common ;
 
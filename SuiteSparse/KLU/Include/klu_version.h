@@ -159,6 +159,8 @@
 
 #define BTF_order btf_l_order
 #define BTF_strongcomp btf_l_strongcomp
+#define BTF_porder btf_l_porder
+#define BTF_pstrongcomp btf_l_pstrongcomp
 
 #define AMD_order amd_l_order
 #define COLAMD colamd_l
@@ -183,6 +185,8 @@
 
 #define BTF_order btf_order
 #define BTF_strongcomp btf_strongcomp
+#define BTF_porder btf_porder
+#define BTF_pstrongcomp btf_pstrongcomp
 
 #define AMD_order amd_order
 #define COLAMD colamd
@@ -348,8 +348,19 @@ static KLU_symbolic *order_and_analyze  /* returns NULL if error, or a valid
             return (NULL) ;
         }
 
-        nblocks = BTF_order (n, Ap, Ai, Common->maxwork, &work, Pbtf, Qbtf, R,
-                &(Symbolic->structural_rank), Work) ;
+        nblocks = EMPTY ;
+        if (Common->nthreads > 1)
+        {
+            /* multithreaded BTF; returns EMPTY if out of memory */
+            nblocks = BTF_porder (n, Ap, Ai, Common->maxwork, &work, Pbtf,
+                Qbtf, R, &(Symbolic->structural_rank), Common->nthreads,
+                Work) ;
+        }
+        if (nblocks < 0)
+        {
+            nblocks = BTF_order (n, Ap, Ai, Common->maxwork, &work, Pbtf,
+                Qbtf, R, &(Symbolic->structural_rank), Work) ;
+        }
         Common->structural_rank = Symbolic->structural_rank ;
         Common->work += work ;
 
@@ -251,7 +251,16 @@ KLU_symbolic *KLU_analyze_given     /* returns NULL if error, or a valid
         /* ------------------------------------------------------------------ */
 
         /* modifies Q, and determines P and R */
-        nblocks = BTF_strongcomp (n, Ap, Bi, Q, P, R, Work) ;
+        nblocks = EMPTY ;
+        if (Common->nthreads > 1)
+        {
+            /* returns EMPTY if out of memory */
+            nblocks = BTF_pstrongcomp (n, Ap, Bi, Q, P, R, Common->nthreads) ;
+        }
+        if (nblocks < 0)
+        {
+            nblocks = BTF_strongcomp (n, Ap, Bi, Q, P, R, Work) ;
+        }
 
         /* ------------------------------------------------------------------ */
         /* P = P * Puser */
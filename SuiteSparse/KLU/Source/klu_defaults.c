@@ -30,6 +30,7 @@ Int KLU_defaults
                                  * 0: none, but check for errors,
                                  * 1: sum, 2: max */
     Common->halt_if_singular = TRUE ;   /* quick halt if matrix is singular */
+    Common->nthreads = 1 ;      /* number of threads for btf_porder */
 
     /* user ordering function and optional argument */
     Common->user_order = NULL ;
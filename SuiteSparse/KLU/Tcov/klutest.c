@@ -401,10 +401,11 @@ static double do_1_solve (cholmod_sparse *A, cholmod_dense *B,
     Int i, j, nrhs2, isreal, n, nrhs, transpose, step, k, save, tries ;
 
     printf ("\ndo_1_solve: btf "ID" maxwork %g scale "ID" ordering "ID" user: "
-        ID" P,Q: %d halt: "ID"\n",
+        ID" P,Q: %d halt: "ID" threads: "ID"\n",
         Common->btf, Common->maxwork, Common->scale, Common->ordering,
         Common->user_data ?  (*((Int *) Common->user_data)) : -1,
-        (Puser != NULL || Quser != NULL), Common->halt_if_singular) ;
+        (Puser != NULL || Quser != NULL), Common->halt_if_singular,
+        Common->nthreads) ;
     fflush (stdout) ;
     fflush (stderr) ;
 
@@ -768,6 +769,79 @@ static double do_1_solve (cholmod_sparse *A, cholmod_dense *B,
 /* === do_solves ============================================================ */
 /* ========================================================================== */
 
+/* ========================================================================== */
+/* === test_btf ============================================================= */
+/* ========================================================================== */
+
+/* Check that P*A*Q is upper block triangular, with blocks given by R */
+
+static void check_btf (Int n, Int *Ap, Int *Ai, Int *P, Int *Q, Int *R,
+    Int nblocks, Int *Pinv, Int *Block)
+{
+    Int i, j, k, b, p ;
+    OK (R [0] == 0 && R [nblocks] == n) ;
+    for (k = 0 ; k < n ; k++) Pinv [k] = -1 ;
+    for (k = 0 ; k < n ; k++)
+    {
+        OK (P [k] >= 0 && P [k] < n && Pinv [P [k]] == -1) ;
+        Pinv [P [k]] = k ;
+    }
+    for (b = 0 ; b < nblocks ; b++)
+    {
+        OK (R [b] < R [b+1]) ;
+        for (k = R [b] ; k < R [b+1] ; k++) Block [k] = b ;
+    }
+    for (k = 0 ; k < n ; k++) Pinv [k] = -1 - Pinv [k] ;
+    for (k = 0 ; k < n ; k++)
+    {
+        j = BTF_UNFLIP (Q [k]) ;
+        OK (j >= 0 && j < n) ;
+        for (p = Ap [j] ; p < Ap [j+1] ; p++)
+        {
+            i = -1 - Pinv [Ai [p]] ;
+            OK (Block [i] <= Block [k]) ;
+        }
+    }
+}
+
+/* Compare btf_porder with btf_order.  Both must find a maximum matching of the
+ * same size.  If A has full structural rank, the block triangular form is
+ * unique up to the order of the blocks, so the number of blocks must match. */
+
+static void test_btf (Int n, Int *Ap, Int *Ai)
+{
+    Int *P, *Q, *R, *Work, *Pinv, *Block, nblocks, pblocks, nmatch, pmatch,
+        nthreads ;
+    double work ;
+    P = malloc (n * sizeof (Int)) ;
+    Q = malloc (n * sizeof (Int)) ;
+    R = malloc ((n+1) * sizeof (Int)) ;
+    Work = malloc (5*n * sizeof (Int)) ;
+    Pinv = malloc (n * sizeof (Int)) ;
+    Block = malloc (n * sizeof (Int)) ;
+    OK (P && Q && R && Work && Pinv && Block) ;
+
+    nblocks = BTF_order (n, Ap, Ai, 0, &work, P, Q, R, &nmatch, Work) ;
+    check_btf (n, Ap, Ai, P, Q, R, nblocks, Pinv, Block) ;
+    for (nthreads = 1 ; nthreads <= 4 ; nthreads++)
+    {
+        pblocks = BTF_porder (n, Ap, Ai, 0, &work, P, Q, R, &pmatch,
+            nthreads, Work) ;
+        printf ("btf: n "ID" nmatch "ID" "ID" nblocks "ID" "ID" threads "ID
+            "\n", n, nmatch, pmatch, nblocks, pblocks, nthreads) ;
+        OK (pblocks > 0 && pmatch == nmatch) ;
+        if (nmatch == n) OK (pblocks == nblocks) ;
+        check_btf (n, Ap, Ai, P, Q, R, pblocks, Pinv, Block) ;
+    }
+
+    free (P) ;
+    free (Q) ;
+    free (R) ;
+    free (Work) ;
+    free (Pinv) ;
+    free (Block) ;
+}
+
 /* test KLU with many options */
 
 static double do_solves (cholmod_sparse *A, cholmod_dense *B, cholmod_dense *X,
@@ -828,7 +902,36 @@ static double do_solves (cholmod_sparse *A, cholmod_dense *B, cholmod_dense *X,
         }
     }
 
+    /* ---------------------------------------------------------------------- */
+    /* test the multithreaded BTF pre-ordering (btf_porder, btf_pstrongcomp) */
+    /* ---------------------------------------------------------------------- */
+
+    Common->user_order = NULL ;
+    Common->btf = TRUE ;
+    Common->scale = 2 ;
+    Common->halt_if_singular = FALSE ;
+    for (Common->nthreads = 2 ; Common->nthreads <= 4 ; Common->nthreads += 2)
+    {
+        for (Common->maxwork = 0 ; Common->maxwork <= 0.001 ;
+             Common->maxwork += 0.001)
+        {
+            for (Common->ordering = 0 ; Common->ordering <= 2 ;
+                 Common->ordering++)
+            {
+                err = do_1_solve (A, B, X, NULL, NULL, Common, ch, isnan) ;
+                maxerr = MAX (maxerr, err) ;
+            }
+            /* klu_analyze_given uses btf_pstrongcomp */
+            if (n < 200)
+            {
+                err = do_1_solve (A, B, X, Puser, Quser, Common, ch, isnan) ;
+                maxerr = MAX (maxerr, err) ;
+            }
+        }
+    }
+
     /* restore defaults */
+    Common->nthreads = 1 ;
     Common->btf = TRUE ;
     Common->maxwork = 0 ;
     Common->ordering = 0 ;
@@ -942,6 +1045,7 @@ int main (void)
     /* test KLU */
     /* ---------------------------------------------------------------------- */
 
+    test_btf (n, Ap, Ai) ;
     test_memory_handler ( ) ;
     maxerr = do_solves (A, B, X, Puser, Quser, &Common, &ch, &isnan) ;
 
@@ -25,8 +25,11 @@
  *
  * Once the matrix is read in, it is checked to see if it is valid.  Some
  * matrices are invalid by design, to test the error-checking routines.  If
- * valid, the matrix factorized twice (A and P*A*P').  A linear
- * system Ax=b is set up and solved, and the residual computed.
+ * valid, the matrix factorized twice (A and P*A*P').  Each factorization is
+ * also done by the supernodal LDL_super_numeric, with 1 and 4 threads, and
+ * compared with the result of LDL_numeric, as is the result of LDL_refactor.
+ * A linear system Ax=b is set up and solved, and the residual computed.
+ * LDL_msolve is checked against the single right-hand-side solve.
  * If any system is not solved accurately, this test will fail.
  *
  * This program can also be compiled as a MATLAB mexFunction, with the command
@@ -49,6 +52,7 @@
 
 #define NMATRICES 30	    /* number of test matrices in Matrix/ directory */
 #define LEN 200		    /* string length */
+#define NRHS 5		    /* number of right-hand-sides for LDL_msolve */
 
 #ifdef USE_AMD		    /* get AMD include file, if using AMD */
 #include "amd.h"
@@ -113,10 +117,12 @@ int main (void)
 #ifdef USE_AMD
     double Info [AMD_INFO] ;
 #endif
-    double r, rnorm, flops, maxrnorm = 0. ;
-    double *Ax, *Lx, *B, *D, *X, *Y ;
+    double r, rnorm, flops, maxrnorm = 0., err, xnorm ;
+    double *Ax, *Lx, *B, *D, *X, *Y, *Lx2, *D2, *Xwork, *Ax2, *Bm, *Xm, *W ;
     LDL_int matrix, *Ai, *Ap, *Li, *Lp, *P, *Pinv, *Perm, *PermInv, n, i, j, p,
-	nz, *Flag, *Pattern, *Lnz, *Parent, trial, lnz, d, jumbled, ok ;
+	nz, *Flag, *Pattern, *Lnz, *Parent, trial, lnz, d, jumbled, ok, *Li2,
+	*Lnz2, *Super, *Iwork, nsuper, nthreads, d2, *Rp, *Ri, *Rpos, *Amap,
+	k ;
     FILE *f ;
     char s [LEN], filename [LEN] ;
 
@@ -260,6 +266,17 @@ int main (void)
 	ALLOC_MEMORY (D, double, n) ;
 	ALLOC_MEMORY (B, double, n) ;
 	ALLOC_MEMORY (X, double, n) ;
+	ALLOC_MEMORY (D2, double, n) ;
+	ALLOC_MEMORY (Lnz2, LDL_int, n) ;
+	ALLOC_MEMORY (Super, LDL_int, n+1) ;
+	ALLOC_MEMORY (Iwork, LDL_int, LDL_SUPER_IWORK (n,4)) ;
+	ALLOC_MEMORY (Xwork, double, LDL_SUPER_XWORK (n,4)) ;
+	ALLOC_MEMORY (Rp, LDL_int, n+1) ;
+	ALLOC_MEMORY (Amap, LDL_int, nz) ;
+	ALLOC_MEMORY (Ax2, double, nz) ;
+	ALLOC_MEMORY (Bm, double, n*NRHS) ;
+	ALLOC_MEMORY (Xm, double, n*NRHS) ;
+	ALLOC_MEMORY (W, double, n*LDL_MSOLVE_BLOCK) ;
 
 	/* ------------------------------------------------------------------ */
 	/* factorize twice, with and without permutation */
@@ -310,6 +327,92 @@ int main (void)
 	    d = LDL_numeric (n, Ap, Ai, Ax, Lp, Parent, Lnz, Li, Lx, D,
 		Y, Flag, Pattern, Perm, PermInv) ;
 
+	    /* -------------------------------------------------------------- */
+	    /* supernodal factorization, with 1 and 4 threads */
+	    /* -------------------------------------------------------------- */
+
+	    /* LDL_super_numeric must compute the same L and D as LDL_numeric,
+	     * up to roundoff.  If D(k,k) is zero, both must fail. */
+	    ALLOC_MEMORY (Li2, LDL_int, lnz) ;
+	    ALLOC_MEMORY (Lx2, double, lnz) ;
+	    nsuper = LDL_super_symbolic (n, Ap, Ai, Lp, Parent, Lnz2, Li2,
+		Super, Flag, Perm, PermInv) ;
+	    for (nthreads = 1 ; nthreads <= 4 ; nthreads += 3)
+	    {
+		d2 = LDL_super_numeric (n, Ap, Ai, Ax, Lp, Parent, Li2, Lx2, D2,
+		    nsuper, Super, nthreads, Iwork, Xwork, Perm, PermInv) ;
+		if ((d2 == n) != (d == n))
+		{
+		    printf (PROGRAM ": supernodal factorization failed\n") ;
+		    EXIT_ERROR ;
+		}
+		if (d != n) continue ;
+		err = 0 ;
+		xnorm = 0 ;
+		for (j = 0 ; j < n ; j++)
+		{
+		    if (Lnz2 [j] != Lnz [j]) err = 1 ;
+		    r = D [j] - D2 [j] ;
+		    err = (r > err) ? r : ((-r > err) ? -r : err) ;
+		    r = D [j] ;
+		    xnorm = (r > xnorm) ? r : ((-r > xnorm) ? -r : xnorm) ;
+		}
+		for (p = 0 ; p < lnz ; p++)
+		{
+		    if (Li2 [p] != Li [p]) err = 1 ;
+		    r = Lx [p] - Lx2 [p] ;
+		    err = (r > err) ? r : ((-r > err) ? -r : err) ;
+		    r = Lx [p] ;
+		    xnorm = (r > xnorm) ? r : ((-r > xnorm) ? -r : xnorm) ;
+		}
+		if (err > 1e-12 * xnorm)
+		{
+		    printf (PROGRAM ": supernodal factorization differs: %g\n",
+			err) ;
+		    EXIT_ERROR ;
+		}
+	    }
+	    printf ("Supernodes: "LDL_ID"\n", nsuper) ;
+
+	    /* -------------------------------------------------------------- */
+	    /* refactorization of A and 2*A with the same plan */
+	    /* -------------------------------------------------------------- */
+
+	    /* LDL_refactor must compute exactly the same L and D as
+	     * LDL_numeric.  For 2*A, L is the same and D is doubled. */
+	    ALLOC_MEMORY (Ri, LDL_int, lnz) ;
+	    ALLOC_MEMORY (Rpos, LDL_int, lnz) ;
+	    LDL_refactor_plan (n, Ap, Ai, Lp, Parent, Lnz2, Li2, Rp, Ri, Rpos,
+		Amap, Pattern, Flag, Perm, PermInv) ;
+	    for (p = 0 ; p < nz ; p++)
+	    {
+		Ax2 [p] = 2 * Ax [p] ;
+	    }
+	    for (k = 1 ; k <= 2 ; k++)
+	    {
+		d2 = LDL_refactor (n, Ap, (k == 1) ? Ax : Ax2, Lp, Li2, Lx2, D2,
+		    Y, Rp, Ri, Rpos, Amap, Perm) ;
+		ok = (d2 == d) ;
+		for (j = 0 ; j < n ; j++)
+		{
+		    ok = ok && (d < n || Lnz2 [j] == Lnz [j]) ;
+		    ok = ok && (j >= d || D2 [j] == k * D [j]) ;
+		}
+		for (p = 0 ; d == n && p < lnz ; p++)
+		{
+		    ok = ok && (Li2 [p] == Li [p]) && (Lx2 [p] == Lx [p]) ;
+		}
+		if (!ok)
+		{
+		    printf (PROGRAM ": refactorization differs\n") ;
+		    EXIT_ERROR ;
+		}
+	    }
+	    FREE_MEMORY (Ri, LDL_int) ;
+	    FREE_MEMORY (Rpos, LDL_int) ;
+	    FREE_MEMORY (Li2, LDL_int) ;
+	    FREE_MEMORY (Lx2, double) ;
+
 	    /* -------------------------------------------------------------- */
 	    /* solve, or report singular case */
 	    /* -------------------------------------------------------------- */
@@ -370,6 +473,55 @@ int main (void)
 		}
 		maxrnorm = (rnorm > maxrnorm) ? (rnorm) : (maxrnorm) ;
 		printf ("relative maxnorm of residual: %g\n", rnorm) ;
+
+		/* solve AX=B for NRHS right-hand-sides, B(:,k) = b+k.  Each
+		 * column of X must be exactly the same as a single solve. */
+		for (k = 0 ; k < NRHS ; k++)
+		{
+		    for (i = 0 ; i < n ; i++)
+		    {
+			Bm [i+k*n] = B [i] + k ;
+		    }
+		}
+		LDL_msolve (n, NRHS, Xm, Bm, Lp, Li, Lx, D, W, Perm) ;
+		ok = 1 ;
+		for (k = 0 ; k < NRHS ; k++)
+		{
+		    if (Perm)
+		    {
+			LDL_perm (n, Y, Bm + k*n, Perm) ;
+		    }
+		    else
+		    {
+			for (i = 0 ; i < n ; i++) Y [i] = Bm [i+k*n] ;
+		    }
+		    LDL_lsolve (n, Y, Lp, Li, Lx) ;
+		    LDL_dsolve (n, Y, D) ;
+		    LDL_ltsolve (n, Y, Lp, Li, Lx) ;
+		    if (Perm)
+		    {
+			LDL_permt (n, X, Y, Perm) ;
+		    }
+		    else
+		    {
+			for (i = 0 ; i < n ; i++) X [i] = Y [i] ;
+		    }
+		    for (i = 0 ; i < n ; i++)
+		    {
+			ok = ok && (Xm [i+k*n] == X [i]) ;
+		    }
+		}
+		/* again, with X and B the same array */
+		LDL_msolve (n, NRHS, Bm, Bm, Lp, Li, Lx, D, W, Perm) ;
+		for (i = 0 ; i < n*NRHS ; i++)
+		{
+		    ok = ok && (Bm [i] == Xm [i]) ;
+		}
+		if (!ok)
+		{
+		    printf (PROGRAM ": multiple right-hand-sides differ\n") ;
+		    EXIT_ERROR ;
+		}
 	    }
 
 	    /* -------------------------------------------------------------- */
@@ -396,6 +548,17 @@ int main (void)
 	FREE_MEMORY (D, double) ;
 	FREE_MEMORY (B, double) ;
 	FREE_MEMORY (X, double) ;
+	FREE_MEMORY (D2, double) ;
+	FREE_MEMORY (Lnz2, LDL_int) ;
+	FREE_MEMORY (Super, LDL_int) ;
+	FREE_MEMORY (Iwork, LDL_int) ;
+	FREE_MEMORY (Xwork, double) ;
+	FREE_MEMORY (Rp, LDL_int) ;
+	FREE_MEMORY (Amap, LDL_int) ;
+	FREE_MEMORY (Ax2, double) ;
+	FREE_MEMORY (Bm, double) ;
+	FREE_MEMORY (Xm, double) ;
+	FREE_MEMORY (W, double) ;
     }
 
     printf ("\nLargest residual during all tests: %g\n", maxrnorm) ;
@@ -21,6 +21,11 @@
 #define LDL_permt ldl_l_permt
 #define LDL_valid_perm ldl_l_valid_perm
 #define LDL_valid_matrix ldl_l_valid_matrix
+#define LDL_super_symbolic ldl_l_super_symbolic
+#define LDL_super_numeric ldl_l_super_numeric
+#define LDL_refactor_plan ldl_l_refactor_plan
+#define LDL_refactor ldl_l_refactor
+#define LDL_msolve ldl_l_msolve
 
 #else
 #define LDL_int int
@@ -35,9 +40,22 @@
 #define LDL_permt ldl_permt
 #define LDL_valid_perm ldl_valid_perm
 #define LDL_valid_matrix ldl_valid_matrix
+#define LDL_super_symbolic ldl_super_symbolic
+#define LDL_super_numeric ldl_super_numeric
+#define LDL_refactor_plan ldl_refactor_plan
+#define LDL_refactor ldl_refactor
+#define LDL_msolve ldl_msolve
 
 #endif
 
+/* number of right-hand-sides solved at a time by ldl_msolve */
+#define LDL_MSOLVE_BLOCK 4
+
+/* workspace sizes for ldl_super_numeric */
+#define LDL_SUPER_NTHREADS(nthreads) (((nthreads) > 1) ? (nthreads) : 1)
+#define LDL_SUPER_IWORK(n,nthreads) ((7+2*LDL_SUPER_NTHREADS(nthreads))*(n)+1)
+#define LDL_SUPER_XWORK(n,nthreads) ((1+2*LDL_SUPER_NTHREADS(nthreads))*(n)+1)
+
 /* ========================================================================== */
 /* === int version ========================================================== */
 /* ========================================================================== */
@@ -64,6 +82,27 @@ void ldl_permt (int n, double X [ ], double B [ ], int P [ ]) ;
 int ldl_valid_perm (int n, int P [ ], int Flag [ ]) ;
 int ldl_valid_matrix ( int n, int Ap [ ], int Ai [ ]) ;
 
+void ldl_refactor_plan (int n, int Ap [ ], int Ai [ ], int Lp [ ],
+    int Parent [ ], int Lnz [ ], int Li [ ], int Rp [ ], int Ri [ ],
+    int Rpos [ ], int Amap [ ], int Pattern [ ], int Flag [ ], int P [ ],
+    int Pinv [ ]) ;
+
+int ldl_refactor (int n, int Ap [ ], double Ax [ ], int Lp [ ], int Li [ ],
+    double Lx [ ], double D [ ], double Y [ ], int Rp [ ], int Ri [ ],
+    int Rpos [ ], int Amap [ ], int P [ ]) ;
+
+void ldl_msolve (int n, int nrhs, double X [ ], double B [ ], int Lp [ ],
+    int Li [ ], double Lx [ ], double D [ ], double W [ ], int P [ ]) ;
+
+int ldl_super_symbolic (int n, int Ap [ ], int Ai [ ], int Lp [ ],
+    int Parent [ ], int Lnz [ ], int Li [ ], int Super [ ], int Flag [ ],
+    int P [ ], int Pinv [ ]) ;
+
+int ldl_super_numeric (int n, int Ap [ ], int Ai [ ], double Ax [ ],
+    int Lp [ ], int Parent [ ], int Li [ ], double Lx [ ], double D [ ],
+    int nsuper, int Super [ ], int nthreads, int Iwork [ ], double Xwork [ ],
+    int P [ ], int Pinv [ ]) ;
+
 /* ========================================================================== */
 /* === long version ========================================================= */
 /* ========================================================================== */
@@ -99,6 +138,39 @@ SuiteSparse_long ldl_l_valid_perm (SuiteSparse_long n, SuiteSparse_long P [ ],
 SuiteSparse_long ldl_l_valid_matrix ( SuiteSparse_long n,
     SuiteSparse_long Ap [ ], SuiteSparse_long Ai [ ]) ;
 
+void ldl_l_refactor_plan (SuiteSparse_long n, SuiteSparse_long Ap [ ],
+    SuiteSparse_long Ai [ ], SuiteSparse_long Lp [ ],
+    SuiteSparse_long Parent [ ], SuiteSparse_long Lnz [ ],
+    SuiteSparse_long Li [ ], SuiteSparse_long Rp [ ], SuiteSparse_long Ri [ ],
+    SuiteSparse_long Rpos [ ], SuiteSparse_long Amap [ ],
+    SuiteSparse_long Pattern [ ], SuiteSparse_long Flag [ ],
+    SuiteSparse_long P [ ], SuiteSparse_long Pinv [ ]) ;
+
+SuiteSparse_long ldl_l_refactor (SuiteSparse_long n, SuiteSparse_long Ap [ ],
+    double Ax [ ], SuiteSparse_long Lp [ ], SuiteSparse_long Li [ ],
+    double Lx [ ], double D [ ], double Y [ ], SuiteSparse_long Rp [ ],
+    SuiteSparse_long Ri [ ], SuiteSparse_long Rpos [ ],
+    SuiteSparse_long Amap [ ], SuiteSparse_long P [ ]) ;
+
+void ldl_l_msolve (SuiteSparse_long n, SuiteSparse_long nrhs, double X [ ],
+    double B [ ], SuiteSparse_long Lp [ ], SuiteSparse_long Li [ ],
+    double Lx [ ], double D [ ], double W [ ], SuiteSparse_long P [ ]) ;
+
+SuiteSparse_long ldl_l_super_symbolic (SuiteSparse_long n,
+    SuiteSparse_long Ap [ ], SuiteSparse_long Ai [ ], SuiteSparse_long Lp [ ],
+    SuiteSparse_long Parent [ ], SuiteSparse_long Lnz [ ],
+    SuiteSparse_long Li [ ], SuiteSparse_long Super [ ],
+    SuiteSparse_long Flag [ ], SuiteSparse_long P [ ],
+    SuiteSparse_long Pinv [ ]) ;
+
+SuiteSparse_long ldl_l_super_numeric (SuiteSparse_long n,
+    SuiteSparse_long Ap [ ], SuiteSparse_long Ai [ ], double Ax [ ],
+    SuiteSparse_long Lp [ ], SuiteSparse_long Parent [ ],
+    SuiteSparse_long Li [ ], double Lx [ ], double D [ ],
+    SuiteSparse_long nsuper, SuiteSparse_long Super [ ],
+    SuiteSparse_long nthreads, SuiteSparse_long Iwork [ ], double Xwork [ ],
+    SuiteSparse_long P [ ], SuiteSparse_long Pinv [ ]) ;
+
 /* ========================================================================== */
 /* === LDL version ========================================================== */
 /* ========================================================================== */
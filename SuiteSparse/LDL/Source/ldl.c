@@ -72,6 +72,15 @@
  *	ldl_ltsolve: Solves L'x=b for a dense vector b.
  *	ldl_perm:    Computes x=Pb for a dense vector b.
  *	ldl_permt:   Computes x=P'b for a dense vector b.
+ *	ldl_refactor_plan:  Given the pattern of A, the Lp and Parent arrays,
+ *	    and P and Pinv if applicable, computes the pattern of L and the
+ *	    index arrays required by ldl_refactor.
+ *	ldl_refactor:  Given the numerical values of A and the output of
+ *	    ldl_refactor_plan, computes the numerical values of L and D,
+ *	    without repeating the integer work of ldl_numeric.  For use when
+ *	    many matrices with the same pattern are factorized.
+ *	ldl_msolve:  Solves Ax=b for a dense n-by-nrhs matrix b, given the
+ *	    factorization of A or PAP'.
  *	ldl_valid_perm:  checks the validity of a permutation vector
  *	ldl_valid_matrix:  checks the validity of the sparse matrix A
  *
@@ -319,6 +328,149 @@ LDL_int LDL_numeric	/* returns n if successful, k if D (k,k) is zero */
 }
 
 
+/* ========================================================================== */
+/* === ldl_refactor_plan ==================================================== */
+/* ========================================================================== */
+
+/* Given the pattern of A and its symbolic analysis (Lp and Parent, and
+ * optionally P and Pinv), compute the pattern Li of L and a plan for
+ * ldl_refactor.  This does all of the integer work of ldl_numeric, so that
+ * ldl_refactor can factorize any number of matrices with the same pattern as
+ * A using only the floating-point work.
+ *
+ * The pattern of the kth row of L, in the same topological order used by
+ * ldl_numeric, is Ri [Rp [k] ... Rp [k+1]-1], and Rpos [t] is the position in
+ * Li and Lx of the entry L (k,Ri [t]).  Amap [p] is the row index of the entry
+ * Ai [p] in PAP', or -1 if that entry is in the strictly lower triangular part
+ * of PAP' and thus ignored.  Two workspaces of size n (Pattern and Flag) are
+ * required.  Lnz is also used as workspace; on output it holds the column
+ * counts of L, as computed by ldl_symbolic.
+ */
+
+void LDL_refactor_plan
+(
+    LDL_int n,		/* A and L are n-by-n, where n >= 0 */
+    LDL_int Ap [ ],	/* input of size n+1, not modified */
+    LDL_int Ai [ ],	/* input of size nz=Ap[n], not modified */
+    LDL_int Lp [ ],	/* input of size n+1, not modified */
+    LDL_int Parent [ ],	/* input of size n, not modified */
+    LDL_int Lnz [ ],	/* output of size n, not defn. on input */
+    LDL_int Li [ ],	/* output of size lnz=Lp[n], not defined on input */
+    LDL_int Rp [ ],	/* output of size n+1, not defined on input */
+    LDL_int Ri [ ],	/* output of size lnz=Lp[n], not defined on input */
+    LDL_int Rpos [ ],	/* output of size lnz=Lp[n], not defined on input */
+    LDL_int Amap [ ],	/* output of size nz=Ap[n], not defined on input */
+    LDL_int Pattern [ ],/* workspace of size n, not defn. on input or output */
+    LDL_int Flag [ ],	/* workspace of size n, not defn. on input or output */
+    LDL_int P [ ],	/* optional input of size n */
+    LDL_int Pinv [ ]	/* optional input of size n */
+)
+{
+    LDL_int i, k, p, kk, p2, len, top, t ;
+    t = 0 ;
+    for (k = 0 ; k < n ; k++)
+    {
+	/* compute nonzero Pattern of kth row of L, in topological order */
+	Rp [k] = t ;
+	top = n ;		    /* stack for pattern is empty */
+	Flag [k] = k ;		    /* mark node k as visited */
+	Lnz [k] = 0 ;		    /* count of nonzeros in column k of L */
+	kk = (P) ? (P [k]) : (k) ;  /* kth original, or permuted, column */
+	p2 = Ap [kk+1] ;
+	for (p = Ap [kk] ; p < p2 ; p++)
+	{
+	    i = (Pinv) ? (Pinv [Ai [p]]) : (Ai [p]) ;	/* get A(i,k) */
+	    Amap [p] = (i <= k) ? i : -1 ;
+	    if (i <= k)
+	    {
+		for (len = 0 ; Flag [i] != k ; i = Parent [i])
+		{
+		    Pattern [len++] = i ;   /* L(k,i) is nonzero */
+		    Flag [i] = k ;	    /* mark i as visited */
+		}
+		while (len > 0) Pattern [--top] = Pattern [--len] ;
+	    }
+	}
+	/* record where each entry of the kth row of L goes */
+	for ( ; top < n ; top++)
+	{
+	    i = Pattern [top] ;
+	    p = Lp [i] + Lnz [i]++ ;
+	    Li [p] = k ;	    /* L(k,i) is the next entry in column i */
+	    Ri [t] = i ;
+	    Rpos [t++] = p ;
+	}
+    }
+    Rp [n] = t ;
+}
+
+
+/* ========================================================================== */
+/* === ldl_refactor ========================================================= */
+/* ========================================================================== */
+
+/* Given a sparse matrix A with the same pattern as the one given to
+ * ldl_refactor_plan, and the outputs of ldl_refactor_plan, compute the numeric
+ * LDL' factorization of A or PAP'.  The result is identical to that of
+ * ldl_numeric, but no integer work other than reading the plan is done.  One
+ * workspace of size n is required (Y).  Pinv is not needed; the plan already
+ * holds the permuted row indices of A in Amap.
+ */
+
+LDL_int LDL_refactor	/* returns n if successful, k if D (k,k) is zero */
+(
+    LDL_int n,		/* A and L are n-by-n, where n >= 0 */
+    LDL_int Ap [ ],	/* input of size n+1, not modified */
+    double Ax [ ],	/* input of size nz=Ap[n], not modified */
+    LDL_int Lp [ ],	/* input of size n+1, not modified */
+    LDL_int Li [ ],	/* input of size lnz=Lp[n], not modified */
+    double Lx [ ],	/* output of size lnz=Lp[n], not defined on input */
+    double D [ ],	/* output of size n, not defined on input */
+    double Y [ ],	/* workspace of size n, not defn. on input or output */
+    LDL_int Rp [ ],	/* input of size n+1, not modified */
+    LDL_int Ri [ ],	/* input of size lnz=Lp[n], not modified */
+    LDL_int Rpos [ ],	/* input of size lnz=Lp[n], not modified */
+    LDL_int Amap [ ],	/* input of size nz=Ap[n], not modified */
+    LDL_int P [ ]	/* optional input of size n */
+)
+{
+    double yi, l_ki ;
+    LDL_int i, k, p, kk, p2, t, t2 ;
+    for (k = 0 ; k < n ; k++)
+    {
+	/* scatter A(0:k,k) into Y */
+	Y [k] = 0.0 ;		    /* Y(0:k) is now all zero */
+	kk = (P) ? (P [k]) : (k) ;  /* kth original, or permuted, column */
+	p2 = Ap [kk+1] ;
+	for (p = Ap [kk] ; p < p2 ; p++)
+	{
+	    i = Amap [p] ;
+	    if (i >= 0) Y [i] += Ax [p] ;   /* sum duplicates */
+	}
+	/* compute numerical values kth row of L (a sparse triangular solve) */
+	D [k] = Y [k] ;		    /* get D(k,k) and clear Y(k) */
+	Y [k] = 0.0 ;
+	t2 = Rp [k+1] ;
+	for (t = Rp [k] ; t < t2 ; t++)
+	{
+	    i = Ri [t] ;	    /* L(k,i) is nonzero */
+	    yi = Y [i] ;	    /* get and clear Y(i) */
+	    Y [i] = 0.0 ;
+	    p2 = Rpos [t] ;	    /* L(k,i) is held in Lx [p2] */
+	    for (p = Lp [i] ; p < p2 ; p++)
+	    {
+		Y [Li [p]] -= Lx [p] * yi ;
+	    }
+	    l_ki = yi / D [i] ;	    /* the nonzero entry L(k,i) */
+	    D [k] -= l_ki * yi ;
+	    Lx [p2] = l_ki ;
+	}
+	if (D [k] == 0.0) return (k) ;	    /* failure, D(k,k) is zero */
+    }
+    return (n) ;	/* success, diagonal of D is all nonzero */
+}
+
+
 /* ========================================================================== */
 /* === ldl_lsolve:  solve Lx=b ============================================== */
 /* ========================================================================== */
@@ -428,6 +580,90 @@ void LDL_permt
 }
 
 
+/* ========================================================================== */
+/* === ldl_msolve: solve Ax=b for multiple right-hand-sides =============== */
+/* ========================================================================== */
+
+/* Solves AX=B, given the factorization LDL' = A (if P is NULL) or LDL' = PAP'
+ * (if P is present), for an n-by-nrhs dense matrix B held in column form with
+ * leading dimension n.  B and X may be the same array.  The right-hand-sides
+ * are solved LDL_MSOLVE_BLOCK at a time: each block is permuted into the
+ * workspace W, held row by row, so that each entry of L is read once for the
+ * whole block in the forward and backward solves.  The results are
+ * identical to ldl_perm, ldl_lsolve, ldl_dsolve, ldl_ltsolve, and ldl_permt
+ * applied to each column of B.  W is a workspace of size n*LDL_MSOLVE_BLOCK.
+ */
+
+void LDL_msolve
+(
+    LDL_int n,		/* L is n-by-n, where n >= 0 */
+    LDL_int nrhs,	/* number of right-hand-sides, nrhs >= 0 */
+    double X [ ],	/* output of size n*nrhs */
+    double B [ ],	/* input of size n*nrhs */
+    LDL_int Lp [ ],	/* input of size n+1, not modified */
+    LDL_int Li [ ],	/* input of size lnz=Lp[n], not modified */
+    double Lx [ ],	/* input of size lnz=Lp[n], not modified */
+    double D [ ],	/* input of size n, not modified */
+    double W [ ],	/* workspace of size n*LDL_MSOLVE_BLOCK */
+    LDL_int P [ ]	/* optional input of size n */
+)
+{
+    double lx, *Wj, *Wi ;
+    LDL_int j, p, p2, r, k, nb ;
+    for (k = 0 ; k < nrhs ; k += LDL_MSOLVE_BLOCK)
+    {
+	/* W = P*B (:,k:k+nb-1), with row j held in W [j*nb ... j*nb+nb-1] */
+	nb = nrhs - k ;
+	if (nb > LDL_MSOLVE_BLOCK) nb = LDL_MSOLVE_BLOCK ;
+	for (r = 0 ; r < nb ; r++)
+	{
+	    for (j = 0 ; j < n ; j++)
+	    {
+		W [j*nb+r] = B [(k+r)*n + ((P) ? (P [j]) : (j))] ;
+	    }
+	}
+	/* solve LW=W */
+	for (j = 0 ; j < n ; j++)
+	{
+	    Wj = W + j*nb ;
+	    p2 = Lp [j+1] ;
+	    for (p = Lp [j] ; p < p2 ; p++)
+	    {
+		lx = Lx [p] ;
+		Wi = W + Li [p]*nb ;
+		for (r = 0 ; r < nb ; r++) Wi [r] -= lx * Wj [r] ;
+	    }
+	}
+	/* solve DW=W */
+	for (j = 0 ; j < n ; j++)
+	{
+	    Wj = W + j*nb ;
+	    for (r = 0 ; r < nb ; r++) Wj [r] /= D [j] ;
+	}
+	/* solve L'W=W */
+	for (j = n-1 ; j >= 0 ; j--)
+	{
+	    Wj = W + j*nb ;
+	    p2 = Lp [j+1] ;
+	    for (p = Lp [j] ; p < p2 ; p++)
+	    {
+		lx = Lx [p] ;
+		Wi = W + Li [p]*nb ;
+		for (r = 0 ; r < nb ; r++) Wj [r] -= lx * Wi [r] ;
+	    }
+	}
+	/* X (:,k:k+nb-1) = P'*W */
+	for (r = 0 ; r < nb ; r++)
+	{
+	    for (j = 0 ; j < n ; j++)
+	    {
+		X [(k+r)*n + ((P) ? (P [j]) : (j))] = W [j*nb+r] ;
+	    }
+	}
+    }
+}
+
+
 /* ========================================================================== */
 /* === ldl_valid_perm: check if a permutation vector is valid =============== */
 /* ========================================================================== */
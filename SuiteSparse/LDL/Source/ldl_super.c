@@ -0,0 +1,594 @@
+/* ========================================================================== */
+/* === ldl_super.c: blocked sparse LDL' factorization ======================= */
+/* ========================================================================== */
+
+/* A blocked (supernodal) alternative to ldl_numeric.  It computes exactly the
+ * same L and D data structure as ldl_numeric, so the factorization can be
+ * used with ldl_lsolve, ldl_dsolve, and ldl_ltsolve.  Like the rest of LDL, it
+ * allocates no memory and depends on nothing but SuiteSparse_config.h.
+ *
+ * A fundamental supernode is a set of consecutive columns f to l of L, where
+ * each column j < l has a single child j-1 (except for f), its parent is j+1,
+ * and the pattern of L (j+1:n-1,j) is the pattern of L (j+1:n-1,j+1) plus
+ * row j+1.  The columns of a supernode thus form a dense lower trapezoid,
+ * which is held in the usual compressed-column form of L.  Entry p of the
+ * rows below column t of a supernode is at Lx [Lp [t] - t + K + p], for a
+ * constant K that does not depend on t.  The numerical work can then be done
+ * with small dense matrix-vector products (ldl_super_gemv) instead of one
+ * scalar at a time.
+ *
+ * --------------------
+ * C-callable routines:
+ * --------------------
+ *
+ *	ldl_super_symbolic:  Given the pattern of A and the Lp and Parent arrays
+ *	    from ldl_symbolic, computes the pattern Li of L and finds the
+ *	    fundamental supernodes.
+ *	ldl_super_numeric:  Given the pattern and numerical values of A, and the
+ *	    output of ldl_symbolic and ldl_super_symbolic, computes the
+ *	    numerical values of L and D, using a left-looking supernodal method.
+ *	    Independent subtrees of the supernodal elimination tree are
+ *	    factorized in parallel if compiled with OpenMP.
+ *
+ * Copyright (c) 2006 by Timothy A Davis, http://www.suitesparse.com.
+ * All Rights Reserved.  Refer to the README file for the License.
+ */
+
+#include "ldl.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define LDL_EMPTY (-1)
+#define LDL_TOP (-1)		/* Owner [s] for supernodes not in a subtree task */
+
+/* ========================================================================== */
+/* === ldl_super_symbolic =================================================== */
+/* ========================================================================== */
+
+/* Computes the pattern of L, in the Li array, and the fundamental supernodes.
+ * The input arrays Lp and Parent, and Pinv if P is present, must be the ones
+ * computed by ldl_symbolic.  The row indices in each column of L are sorted.
+ * Supernode s consists of columns Super [s] to Super [s+1]-1 of L.  The number
+ * of supernodes, nsuper, is returned.  Super [nsuper] is equal to n.
+ *
+ * One workspace vector (Flag) of size n is required.
+ */
+
+LDL_int LDL_super_symbolic	/* returns the number of supernodes */
+(
+    LDL_int n,		/* A and L are n-by-n, where n >= 0 */
+    LDL_int Ap [ ],	/* input of size n+1, not modified */
+    LDL_int Ai [ ],	/* input of size nz=Ap[n], not modified */
+    LDL_int Lp [ ],	/* input of size n+1, not modified */
+    LDL_int Parent [ ],	/* input of size n, not modified */
+    LDL_int Lnz [ ],	/* output of size n, not defined on input */
+    LDL_int Li [ ],	/* output of size lnz=Lp[n], not defined on input */
+    LDL_int Super [ ],	/* output of size n+1, not defined on input */
+    LDL_int Flag [ ],	/* workspace of size n, not defn. on input or output */
+    LDL_int P [ ],	/* optional input of size n */
+    LDL_int Pinv [ ]	/* optional input of size n */
+)
+{
+    LDL_int i, j, k, p, kk, p2, nsuper ;
+
+    /* find the pattern of L, one row at a time (as in ldl_numeric) */
+    for (k = 0 ; k < n ; k++)
+    {
+	Flag [k] = k ;		    /* mark node k as visited */
+	Lnz [k] = 0 ;		    /* count of nonzeros in column k of L */
+	kk = (P) ? (P [k]) : (k) ;  /* kth original, or permuted, column */
+	p2 = Ap [kk+1] ;
+	for (p = Ap [kk] ; p < p2 ; p++)
+	{
+	    i = (Pinv) ? (Pinv [Ai [p]]) : (Ai [p]) ;	/* get A(i,k) */
+	    if (i < k)
+	    {
+		for ( ; Flag [i] != k ; i = Parent [i])
+		{
+		    Li [Lp [i] + Lnz [i]++] = k ;   /* L(k,i) is nonzero */
+		    Flag [i] = k ;		    /* mark i as visited */
+		}
+	    }
+	}
+    }
+
+    /* count the children of each node */
+    for (j = 0 ; j < n ; j++)
+    {
+	Flag [j] = 0 ;
+    }
+    for (j = 0 ; j < n ; j++)
+    {
+	if (Parent [j] != LDL_EMPTY) Flag [Parent [j]]++ ;
+    }
+
+    /* find the fundamental supernodes */
+    nsuper = 0 ;
+    for (j = 0 ; j < n ; j++)
+    {
+	if (j == 0 || Parent [j-1] != j || Lnz [j-1] != Lnz [j] + 1
+	    || Flag [j] != 1)
+	{
+	    Super [nsuper++] = j ;  /* column j starts a new supernode */
+	}
+    }
+    Super [nsuper] = n ;
+    return (nsuper) ;
+}
+
+
+/* ========================================================================== */
+/* === ldl_super_gemv ======================================================= */
+/* ========================================================================== */
+
+/* Y [q] = sum (W [t-t1] * Lx [Lp [t] - t + K + q]) for t = t1 to t2-1 and for
+ * q = 0 to nq-1.  That is, Y = L (rows,t1:t2-1) * W, for a set of rows that is
+ * held contiguously in each of the columns t1 to t2-1 of a supernode.
+ */
+
+static void ldl_super_gemv
+(
+    LDL_int nq,		/* number of rows */
+    LDL_int t1,		/* first column */
+    LDL_int t2,		/* last column + 1 */
+    LDL_int K,		/* offset of the rows in each column */
+    LDL_int Lp [ ],
+    double Lx [ ],
+    double W [ ],	/* input of size t2-t1 */
+    double Y [ ]	/* output of size nq */
+)
+{
+    double w0, w1, w2, w3, *x0, *x1, *x2, *x3 ;
+    LDL_int q, t ;
+    for (q = 0 ; q < nq ; q++)
+    {
+	Y [q] = 0 ;
+    }
+    for (t = t1 ; t + 3 < t2 ; t += 4)
+    {
+	/* four columns at a time */
+	w0 = W [t-t1  ] ; x0 = Lx + Lp [t  ] - (t  ) + K ;
+	w1 = W [t-t1+1] ; x1 = Lx + Lp [t+1] - (t+1) + K ;
+	w2 = W [t-t1+2] ; x2 = Lx + Lp [t+2] - (t+2) + K ;
+	w3 = W [t-t1+3] ; x3 = Lx + Lp [t+3] - (t+3) + K ;
+	for (q = 0 ; q < nq ; q++)
+	{
+	    Y [q] += w0 * x0 [q] + w1 * x1 [q] + w2 * x2 [q] + w3 * x3 [q] ;
+	}
+    }
+    for ( ; t < t2 ; t++)
+    {
+	w0 = W [t-t1] ; x0 = Lx + Lp [t] - t + K ;
+	for (q = 0 ; q < nq ; q++)
+	{
+	    Y [q] += w0 * x0 [q] ;
+	}
+    }
+}
+
+
+/* ========================================================================== */
+/* === ldl_super_factor ===================================================== */
+/* ========================================================================== */
+
+/* Factorizes supernode s, after all of its descendants have been factorized.
+ * Head [s] is the list of descendants d that update s, linked by Next, where
+ * Lpos [d] is the position of the first row of d in s.  Once d has updated s,
+ * it is moved to the list of the next supernode it updates, if that supernode
+ * is in the same subtree task (Owner).  Returns -1 if successful, or k if D
+ * (k,k) is zero.
+ */
+
+static LDL_int ldl_super_factor
+(
+    LDL_int s,
+    LDL_int Lp [ ],
+    LDL_int Li [ ],
+    double Lx [ ],
+    double D [ ],
+    LDL_int Super [ ],
+    LDL_int SuperMap [ ],
+    LDL_int Head [ ],
+    LDL_int Next [ ],
+    LDL_int Lpos [ ],
+    LDL_int Owner [ ],
+    LDL_int Map [ ],	/* workspace of size n */
+    double W [ ],	/* workspace of size n */
+    double Y [ ]	/* workspace of size n */
+)
+{
+    double *Lc ;
+    LDL_int *Rs, *Rd ;
+    LDL_int f, l, nr, nrd, d, dnext, fd, ld, p, pos, pend, c, t, q, i, a ;
+
+    /* supernode s is columns f to l, with rows f:l and Rs [0:nr-1] */
+    f = Super [s] ;
+    l = Super [s+1] - 1 ;
+    Rs = Li + Lp [l] ;
+    nr = Lp [l+1] - Lp [l] ;
+    for (q = 0 ; q < nr ; q++)
+    {
+	Map [Rs [q]] = (l - f + 1) + q ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* apply the updates from each descendant d */
+    /* ---------------------------------------------------------------------- */
+
+    for (d = Head [s] ; d != LDL_EMPTY ; d = dnext)
+    {
+	dnext = Next [d] ;
+	fd = Super [d] ;
+	ld = Super [d+1] - 1 ;
+	Rd = Li + Lp [ld] ;
+	nrd = Lp [ld+1] - Lp [ld] ;
+	pos = Lpos [d] ;
+	for (pend = pos ; pend < nrd && Rd [pend] <= l ; pend++) ;
+
+	/* L(Rd [pos:nrd-1],fd:ld) is held at Lx [Lp [t] - t + ld + pos ...] */
+	for (p = pos ; p < pend ; p++)
+	{
+	    /* column c of s is updated by d */
+	    c = Rd [p] ;
+	    for (t = fd ; t <= ld ; t++)
+	    {
+		W [t-fd] = D [t] * Lx [Lp [t] - t + ld + p] ;   /* D(t)*L(c,t) */
+	    }
+	    ldl_super_gemv (nrd - p, fd, ld+1, ld + p, Lp, Lx, W, Y) ;
+	    D [c] -= Y [0] ;
+	    for (q = 1 ; q < nrd - p ; q++)
+	    {
+		/* L(i,c) -= Y [q], where row i is at Map [i] in supernode s */
+		i = Rd [p+q] ;
+		a = (i <= l) ? (i - f) : Map [i] ;
+		Lx [Lp [c] + a - (c - f) - 1] -= Y [q] ;
+	    }
+	}
+
+	/* move d to the list of the next supernode it updates */
+	Lpos [d] = pend ;
+	if (pend < nrd)
+	{
+	    a = SuperMap [Rd [pend]] ;
+	    if (Owner [a] == Owner [s])
+	    {
+		Next [d] = Head [a] ;
+		Head [a] = d ;
+	    }
+	}
+    }
+    Head [s] = LDL_EMPTY ;
+
+    /* ---------------------------------------------------------------------- */
+    /* factorize the dense trapezoid L (f:n-1,f:l) */
+    /* ---------------------------------------------------------------------- */
+
+    for (c = f ; c <= l ; c++)
+    {
+	/* rows c:l and Rs of column c, L(c,t) for t = f:c-1 */
+	for (t = f ; t < c ; t++)
+	{
+	    W [t-f] = D [t] * Lx [Lp [t] - t + c - 1] ;
+	}
+	ldl_super_gemv (l - c + 1 + nr, f, c, c - 1, Lp, Lx, W, Y) ;
+	D [c] -= Y [0] ;
+	if (D [c] == 0.0) return (c) ;	    /* failure, D(c,c) is zero */
+	Lc = Lx + Lp [c] ;
+	for (q = 1 ; q <= l - c + nr ; q++)
+	{
+	    Lc [q-1] = (Lc [q-1] - Y [q]) / D [c] ;
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* place s in the list of the first supernode it updates */
+    /* ---------------------------------------------------------------------- */
+
+    Lpos [s] = 0 ;
+    if (nr > 0)
+    {
+	a = SuperMap [Rs [0]] ;
+	if (Owner [a] == Owner [s])
+	{
+	    Next [s] = Head [a] ;
+	    Head [a] = s ;
+	}
+    }
+    return (LDL_EMPTY) ;
+}
+
+
+/* ========================================================================== */
+/* === ldl_super_numeric ==================================================== */
+/* ========================================================================== */
+
+/* Given a sparse matrix A (the arguments n, Ap, Ai, and Ax), its symbolic
+ * analysis from ldl_symbolic (Lp and Parent, and optionally P and Pinv), and
+ * the pattern Li and supernodes from ldl_super_symbolic, compute the numeric
+ * LDL' factorization of A or PAP'.  The outputs are Lx and D.
+ *
+ * If nthreads > 1 and LDL is compiled with OpenMP, the supernodal elimination
+ * tree is split into independent subtrees of about equal work, which are
+ * factorized in parallel; the supernodes above them are then factorized in
+ * order.  The result can differ from the sequential one only by roundoff.
+ *
+ * The workspace Iwork has size LDL_SUPER_IWORK (n,nthreads) and Xwork has
+ * size LDL_SUPER_XWORK (n,nthreads).
+ */
+
+LDL_int LDL_super_numeric	/* returns n if successful, k if D (k,k) is zero */
+(
+    LDL_int n,		/* A and L are n-by-n, where n >= 0 */
+    LDL_int Ap [ ],	/* input of size n+1, not modified */
+    LDL_int Ai [ ],	/* input of size nz=Ap[n], not modified */
+    double Ax [ ],	/* input of size nz=Ap[n], not modified */
+    LDL_int Lp [ ],	/* input of size n+1, not modified */
+    LDL_int Parent [ ],	/* input of size n, not modified */
+    LDL_int Li [ ],	/* input of size lnz=Lp[n], not modified */
+    double Lx [ ],	/* output of size lnz=Lp[n], not defined on input */
+    double D [ ],	/* output of size n, not defined on input */
+    LDL_int nsuper,	/* number of supernodes */
+    LDL_int Super [ ],	/* input of size nsuper+1, not modified */
+    LDL_int nthreads,	/* number of threads to use */
+    LDL_int Iwork [ ],	/* workspace of size LDL_SUPER_IWORK (n,nthreads) */
+    double Xwork [ ],	/* workspace of size LDL_SUPER_XWORK (n,nthreads) */
+    LDL_int P [ ],	/* optional input of size n */
+    LDL_int Pinv [ ]	/* optional input of size n */
+)
+{
+    double *Work, total, nrows ;
+    LDL_int *SuperMap, *Head, *Next, *Lpos, *Owner, *SParent, *Tasks, *Iw ;
+    LDL_int s, j, k, p, kk, p2, i, lo, hi, mid, ntasks, tail, a, result ;
+
+    if (nthreads < 1) nthreads = 1 ;
+#ifndef _OPENMP
+    nthreads = 1 ;
+#endif
+
+    /* ---------------------------------------------------------------------- */
+    /* get workspace */
+    /* ---------------------------------------------------------------------- */
+
+    SuperMap = Iwork ;		    /* size n */
+    Head     = Iwork + n ;	    /* size n (only nsuper are used) */
+    Next     = Head + n ;	    /* size n, likewise for the rest */
+    Lpos     = Next + n ;
+    Owner    = Lpos + n ;
+    SParent  = Owner + n ;
+    Tasks    = SParent + n ;
+    Iw       = Tasks + n ;	    /* size nthreads*(n+nsuper) */
+    Work     = Xwork ;		    /* size nsuper */
+
+    /* ---------------------------------------------------------------------- */
+    /* supernodal elimination tree */
+    /* ---------------------------------------------------------------------- */
+
+    for (s = 0 ; s < nsuper ; s++)
+    {
+	for (j = Super [s] ; j < Super [s+1] ; j++)
+	{
+	    SuperMap [j] = s ;
+	}
+    }
+    for (s = 0 ; s < nsuper ; s++)
+    {
+	j = Parent [Super [s+1] - 1] ;
+	SParent [s] = (j == LDL_EMPTY) ? LDL_EMPTY : SuperMap [j] ;
+	Head [s] = LDL_EMPTY ;
+	Owner [s] = LDL_TOP ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* L = tril (PAP'), D = diag (PAP') */
+    /* ---------------------------------------------------------------------- */
+
+    #pragma omp parallel for num_threads(nthreads) schedule(static) \
+	private(p) if (nthreads > 1)
+    for (k = 0 ; k < n ; k++)
+    {
+	D [k] = 0.0 ;
+	for (p = Lp [k] ; p < Lp [k+1] ; p++)
+	{
+	    Lx [p] = 0.0 ;
+	}
+    }
+
+    /* A(i,k) for i < k is L(k,i), found by binary search in column i of L */
+    #pragma omp parallel for num_threads(nthreads) schedule(static) \
+	private(kk, p, p2, i, lo, hi, mid) if (nthreads > 1)
+    for (k = 0 ; k < n ; k++)
+    {
+	kk = (P) ? (P [k]) : (k) ;  /* kth original, or permuted, column */
+	p2 = Ap [kk+1] ;
+	for (p = Ap [kk] ; p < p2 ; p++)
+	{
+	    i = (Pinv) ? (Pinv [Ai [p]]) : (Ai [p]) ;	/* get A(i,k) */
+	    if (i < k)
+	    {
+		lo = Lp [i] ;
+		hi = Lp [i+1] - 1 ;
+		while (lo < hi)
+		{
+		    mid = (lo + hi) / 2 ;
+		    if (Li [mid] < k) lo = mid + 1 ; else hi = mid ;
+		}
+		Lx [lo] += Ax [p] ;	/* sum duplicates */
+	    }
+	    else if (i == k)
+	    {
+		D [k] += Ax [p] ;
+	    }
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* split the tree into independent subtrees, for the threads */
+    /* ---------------------------------------------------------------------- */
+
+    ntasks = 0 ;
+    if (nthreads > 1)
+    {
+	/* Work [s] = flops in the subtree rooted at s, roughly */
+	total = 0 ;
+	for (s = 0 ; s < nsuper ; s++)
+	{
+	    j = Super [s+1] - 1 ;
+	    nrows = (double) (Lp [j+1] - Lp [j] + Super [s+1] - Super [s]) ;
+	    Work [s] = (Super [s+1] - Super [s]) * nrows * nrows ;
+	}
+	for (s = 0 ; s < nsuper ; s++)
+	{
+	    total += Work [s] ;
+	}
+	for (s = 0 ; s < nsuper ; s++)
+	{
+	    if (SParent [s] != LDL_EMPTY) Work [SParent [s]] += Work [s] ;
+	}
+
+	/* Tasks [0..tail-1] is a queue of candidate subtrees, starting with
+	 * the roots.  A subtree with too much work is not a task; its root
+	 * stays at the top and its children become candidates.  The child
+	 * lists are kept in Next and Lpos, which are cleared afterwards. */
+	for (s = 0 ; s < nsuper ; s++)
+	{
+	    Next [s] = LDL_EMPTY ;		/* first child of s */
+	    Lpos [s] = LDL_EMPTY ;		/* next sibling of s */
+	}
+	tail = 0 ;
+	for (s = nsuper-1 ; s >= 0 ; s--)
+	{
+	    a = SParent [s] ;
+	    if (a == LDL_EMPTY)
+	    {
+		Tasks [tail++] = s ;
+	    }
+	    else
+	    {
+		Lpos [s] = Next [a] ;
+		Next [a] = s ;
+	    }
+	}
+	for (k = 0 ; k < tail ; k++)
+	{
+	    s = Tasks [k] ;
+	    if (Work [s] > total / (4 * nthreads) && Next [s] != LDL_EMPTY)
+	    {
+		/* s stays at the top; its children are candidates */
+		for (a = Next [s] ; a != LDL_EMPTY ; a = Lpos [a])
+		{
+		    Tasks [tail++] = a ;
+		}
+	    }
+	    else
+	    {
+		/* the subtree rooted at s is a task */
+		Tasks [ntasks] = s ;
+		Owner [s] = ntasks++ ;
+	    }
+	}
+
+	/* each supernode not at the top belongs to the task of its parent */
+	for (s = nsuper-1 ; s >= 0 ; s--)
+	{
+	    a = SParent [s] ;
+	    if (Owner [s] == LDL_TOP && a != LDL_EMPTY && Owner [a] != LDL_TOP)
+	    {
+		Owner [s] = Owner [a] ;
+	    }
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* factorize the subtrees in parallel */
+    /* ---------------------------------------------------------------------- */
+
+    result = n ;
+    if (ntasks > 0)
+    {
+	/* Next [s] and Lpos [s] give the children of s, and Tasks [0..ntasks-1]
+	 * are the subtree roots.  Each task factorizes its subtree in postorder,
+	 * with its own Stack, Map, W, and Y.  The child list of s is no longer
+	 * needed once s is factorized, so Next and Lpos can then be used for the
+	 * descendant lists. */
+	#pragma omp parallel num_threads(nthreads)
+	{
+	    LDL_int tid, task, top, s2, c, bad, *Map, *Stack ;
+	    double *W, *Y ;
+#ifdef _OPENMP
+	    tid = omp_get_thread_num ( ) ;
+#else
+	    tid = 0 ;
+#endif
+	    Map   = Iw + tid * (n + nsuper) ;
+	    Stack = Map + n ;
+	    W = Xwork + nsuper + tid * 2 * n ;
+	    Y = W + n ;
+
+	    #pragma omp for schedule(dynamic,1)
+	    for (task = 0 ; task < ntasks ; task++)
+	    {
+		/* iterative postorder: Stack [0..top] is the current path */
+		bad = LDL_EMPTY ;
+		top = 0 ;
+		Stack [0] = Tasks [task] ;
+		while (top >= 0)
+		{
+		    s2 = Stack [top] ;
+		    c = Next [s2] ;
+		    if (c != LDL_EMPTY)
+		    {
+			/* descend to the next child of s2 */
+			Next [s2] = Lpos [c] ;
+			Stack [++top] = c ;
+		    }
+		    else
+		    {
+			/* all children of s2 are factorized */
+			top-- ;
+			if (bad == LDL_EMPTY)
+			{
+			    bad = ldl_super_factor (s2, Lp, Li, Lx, D, Super,
+				SuperMap, Head, Next, Lpos, Owner, Map, W, Y) ;
+			}
+		    }
+		}
+		if (bad != LDL_EMPTY)
+		{
+		    #pragma omp critical (ldl_super_result)
+		    {
+			if (bad < result) result = bad ;
+		    }
+		}
+	    }
+	}
+	if (result < n) return (result) ;
+
+	/* move each finished descendant to the list of its next supernode */
+	for (s = 0 ; s < nsuper ; s++)
+	{
+	    j = Super [s+1] - 1 ;
+	    if (Owner [s] != LDL_TOP && Lpos [s] < Lp [j+1] - Lp [j])
+	    {
+		a = SuperMap [Li [Lp [j] + Lpos [s]]] ;
+		Next [s] = Head [a] ;
+		Head [a] = s ;
+	    }
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* factorize the supernodes at the top, in order */
+    /* ---------------------------------------------------------------------- */
+
+    for (s = 0 ; s < nsuper ; s++)
+    {
+	if (Owner [s] == LDL_TOP)
+	{
+	    k = ldl_super_factor (s, Lp, Li, Lx, D, Super, SuperMap, Head, Next,
+		Lpos, Owner, Iw, Xwork + nsuper, Xwork + nsuper + n) ;
+	    if (k != LDL_EMPTY) return (k) ;	/* failure, D(k,k) is zero */
+	}
+    }
+    return (n) ;	/* success, diagonal of D is all nonzero */
+}
@@ -0,0 +1 @@
+#include <../Source/ldl_super.c>
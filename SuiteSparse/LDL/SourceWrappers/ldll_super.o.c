@@ -0,0 +1,2 @@
+#define LDL_LONG
+#include <../Source/ldl_super.c>
@@ -10,8 +10,9 @@
 // sfmult_AN_XN_YT_3	y = (A*x)'  where x is n-by-3, and y is 3-by-m (ldy = 4)
 // sfmult_AN_XN_YT_4	y = (A*x)'  where x is n-by-4, and y is 4-by-m
 
-#include "sfmult.h"
+#include "sfmult_csc.h"
 
+SFMULT_DISPATCH
 void sfmult_AN_XN_YT_2	// y = (A*x)'	x is n-by-2, and y is 2-by-m
 (
     // --- outputs, not initialized on input
@@ -73,6 +74,7 @@ void sfmult_AN_XN_YT_2	// y = (A*x)'	x is n-by-2, and y is 2-by-m
 //=== sfmult_AN_XN_YT_3 ========================================================
 //==============================================================================
 
+SFMULT_DISPATCH
 void sfmult_AN_XN_YT_3	// y = (A*x)'	x is n-by-3, and y is 3-by-m (ldy = 4)
 (
     // --- outputs, not initialized on input
@@ -139,6 +141,7 @@ void sfmult_AN_XN_YT_3	// y = (A*x)'	x is n-by-3, and y is 3-by-m (ldy = 4)
 //=== sfmult_AN_XN_YT_4 ========================================================
 //==============================================================================
 
+SFMULT_DISPATCH
 void sfmult_AN_XN_YT_4	// y = (A*x)'	x is n-by-4, and y is 4-by-m
 (
     // --- outputs, not initialized on input
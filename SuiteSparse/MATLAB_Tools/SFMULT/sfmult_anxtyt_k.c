@@ -10,12 +10,13 @@
 // sfmult_AN_XT_YT_3  y = (A*x')'  where x is 3-by-n, and y is 3-by-m (ldy = 4)
 // sfmult_AN_XT_YT_4  y = (A*x')'  where x is 4-by-n, and y is 4-by-m
 
-#include "sfmult.h"
+#include "sfmult_csc.h"
 
 //==============================================================================
 //=== sfmult_AN_XT_YT_2 ========================================================
 //==============================================================================
 
+SFMULT_DISPATCH
 void sfmult_AN_XT_YT_2	// y = (A*x')'	x is 2-by-n, and y is 2-by-m
 (
     // --- outputs, not initialized on input
@@ -78,6 +79,7 @@ void sfmult_AN_XT_YT_2	// y = (A*x')'	x is 2-by-n, and y is 2-by-m
 //=== sfmult_AN_XT_YT_3 ========================================================
 //==============================================================================
 
+SFMULT_DISPATCH
 void sfmult_AN_XT_YT_3	// y = (A*x')'	x is 3-by-n, and y is 3-by-m (ldy = 4)
 (
     // --- outputs, not initialized on input
@@ -145,6 +147,7 @@ void sfmult_AN_XT_YT_3	// y = (A*x')'	x is 3-by-n, and y is 3-by-m (ldy = 4)
 //=== sfmult_AN_XT_YT_4 ========================================================
 //==============================================================================
 
+SFMULT_DISPATCH
 void sfmult_AN_XT_YT_4 // y = (A*x')'	x is 4-by-n, and y is 4-by-m
 (
     // --- outputs, not initialized on input
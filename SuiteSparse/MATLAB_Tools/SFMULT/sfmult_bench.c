@@ -0,0 +1,137 @@
+//==============================================================================
+// sfmult_bench: compare sfmult_csc with cholmod_l_sdmult
+//==============================================================================
+
+// Usage:
+//
+//	sfmult_bench [nthreads] < matrix.mtx
+//
+// Reads a real sparse matrix A in Matrix Market format from stdin, and times
+// y = A*x and y = A'*x for x with 1, 2, 4, 8, and 16 columns, using
+// cholmod_l_sdmult and sfmult_csc.  sfmult_csc uses nthreads threads (default:
+// the OpenMP default).  A symmetric matrix is first converted to unsymmetric
+// form, since sfmult_csc does not exploit symmetry.  Returns 1 if sfmult_csc
+// fails or its result differs from cholmod_l_sdmult by more than 1e-8
+// (relative).  See sfmult_test.c for a test of all variants of sfmult_csc.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "cholmod.h"
+#include "sfmult_csc.h"
+
+#ifndef MAX
+#define MAX(a,b) (((a) > (b)) ? (a) : (b))
+#endif
+
+// run each method for at least this many seconds
+#define MIN_TIME 0.2
+
+int main (int argc, char **argv)
+{
+    cholmod_common Common, *cm ;
+    cholmod_sparse *A, *A2 ;
+    cholmod_dense *X, *Y ;
+    double one [2] = {1,0}, zero [2] = {0,0} ;
+    double *Yx, t, t_cholmod, t_sfmult, err, *Y2 ;
+    Int m, n, k, i, ntrials, trial ;
+    int nthreads, at, ok, nfail = 0 ;
+
+    //--------------------------------------------------------------------------
+    // read the matrix
+    //--------------------------------------------------------------------------
+
+    nthreads = (argc > 1) ? atoi (argv [1]) : 0 ;
+    cm = &Common ;
+    cholmod_l_start (cm) ;
+    A = cholmod_l_read_sparse (stdin, cm) ;
+    if (A == NULL || A->xtype != CHOLMOD_REAL)
+    {
+	fprintf (stderr, "sfmult_bench: a real sparse matrix is required\n") ;
+	cholmod_l_free_sparse (&A, cm) ;
+	cholmod_l_finish (cm) ;
+	return (1) ;
+    }
+    if (A->stype != 0)
+    {
+	A2 = cholmod_l_copy (A, 0, 1, cm) ;
+	cholmod_l_free_sparse (&A, cm) ;
+	A = A2 ;
+    }
+    m = A->nrow ;
+    n = A->ncol ;
+    printf ("A: %ld-by-%ld with %ld entries, sfmult_csc nthreads: %d\n",
+	(long) m, (long) n, (long) cholmod_l_nnz (A, cm), nthreads) ;
+    printf ("    op   k  cholmod_sdmult    sfmult_csc   speedup  "
+	"rel. diff\n") ;
+
+    //--------------------------------------------------------------------------
+    // time y = A*x and y = A'*x
+    //--------------------------------------------------------------------------
+
+    for (at = 0 ; at <= 1 ; at++)
+    {
+	for (k = 1 ; k <= 16 ; k *= 2)
+	{
+	    X = cholmod_l_allocate_dense (at ? m : n, k, at ? m : n,
+		CHOLMOD_REAL, cm) ;
+	    Y = cholmod_l_zeros (at ? n : m, k, CHOLMOD_REAL, cm) ;
+	    Y2 = (Y == NULL) ? NULL :
+		malloc (MAX (Y->nzmax, 1) * sizeof (double)) ;
+	    if (X == NULL || Y == NULL || Y2 == NULL)
+	    {
+		fprintf (stderr, "sfmult_bench: out of memory\n") ;
+		cholmod_l_free_dense (&X, cm) ;
+		cholmod_l_free_dense (&Y, cm) ;
+		free (Y2) ;
+		break ;
+	    }
+	    for (i = 0 ; i < (Int) X->nzmax ; i++)
+	    {
+		((double *) X->x) [i] = ((double) rand ( )) / RAND_MAX ;
+	    }
+
+	    // time cholmod_l_sdmult
+	    ntrials = 0 ;
+	    t = SuiteSparse_time ( ) ;
+	    do
+	    {
+		cholmod_l_sdmult (A, at, one, zero, X, Y, cm) ;
+		ntrials++ ;
+	    }
+	    while (SuiteSparse_time ( ) - t < MIN_TIME) ;
+	    t_cholmod = (SuiteSparse_time ( ) - t) / ntrials ;
+
+	    // time sfmult_csc with the same number of trials
+	    ok = 1 ;
+	    t = SuiteSparse_time ( ) ;
+	    for (trial = 0 ; trial < ntrials ; trial++)
+	    {
+		ok = ok && sfmult_csc (Y2, A->p, A->i, A->x, m, n, X->x, k,
+		    at, 0, 0, nthreads) ;
+	    }
+	    t_sfmult = (SuiteSparse_time ( ) - t) / ntrials ;
+
+	    // compare the results
+	    Yx = Y->x ;
+	    err = 0 ;
+	    for (i = 0 ; i < (Int) Y->nzmax ; i++)
+	    {
+		err = MAX (err, fabs (Yx [i] - Y2 [i]) / MAX (fabs (Yx [i]), 1));
+	    }
+	    ok = ok && (err <= 1e-8) ;
+	    if (!ok) nfail++ ;
+	    printf ("%6s %3ld  %14.6f  %12.6f  %8.2f  %9.2e%s\n",
+		at ? "A'*x" : "A*x", (long) k, t_cholmod, t_sfmult,
+		t_cholmod / MAX (t_sfmult, 1e-12), err, ok ? "" : " (failed)") ;
+
+	    cholmod_l_free_dense (&X, cm) ;
+	    cholmod_l_free_dense (&Y, cm) ;
+	    free (Y2) ;
+	}
+    }
+
+    cholmod_l_free_sparse (&A, cm) ;
+    cholmod_l_finish (cm) ;
+    return (nfail > 0) ;
+}
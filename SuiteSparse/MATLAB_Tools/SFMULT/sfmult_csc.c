@@ -0,0 +1,375 @@
+//==============================================================================
+// y = A*x and variants, A is sparse, x is full, without MATLAB
+//==============================================================================
+
+// y = ytrans (atrans (A) * xtrans (x)) where xtrans(x) is x or x.' and likewise
+// for A and y.  Only real matrices are supported.  A is m-by-n in compressed-
+// column form, with sorted or unsorted columns.  Let k be the number of
+// columns of xtrans(x).  Then:
+//
+//  at xt yt
+//  0  0  0	y = A*x	    x is n-by-k, y is m-by-k
+//  0  0  1	y = (A*x)'  x is n-by-k, y is k-by-m
+//  0  1  0	y = A*x'    x is k-by-n, y is m-by-k
+//  0  1  1	y = (A*x')' x is k-by-n, y is k-by-m
+//  1  0  0	y = A'*x    x is m-by-k, y is n-by-k
+//  1  0  1	y = (A'*x)' x is m-by-k, y is k-by-n
+//  1  1  0	y = A'*x'   x is k-by-m, y is n-by-k
+//  1  1  1	y = (A'*x')' x is k-by-m, y is k-by-n
+//
+// The columns of xtrans(x) are split into blocks of up to 4, each of which is
+// done with one of the sfmult_*_[1234] kernels.  The blocks are independent,
+// and are split among the OpenMP threads, each with its own workspace.  For
+// y = A'*x where x is a single vector, the columns of A (the entries of y) are
+// split among the threads instead.  The result does not depend on the number
+// of threads.
+
+#include <stdlib.h>
+#include <stdint.h>
+#include "sfmult_csc.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifndef MAX
+#define MAX(a,b) (((a) > (b)) ? (a) : (b))
+#define MIN(a,b) (((a) < (b)) ? (a) : (b))
+#endif
+
+// minimum number of flops for each thread
+#define SFMULT_FLOPS_PER_THREAD 65536
+
+
+//==============================================================================
+//=== sfmult_csc_block =========================================================
+//==============================================================================
+
+// y (:,b:b+c-1) = atrans (A) * xtrans (x) (:,b:b+c-1), or its transpose, for
+// one block of 1 to 4 columns of xtrans (x)
+
+static void sfmult_csc_block
+(
+    // --- output, not initialized on input:
+    double *Yx,
+
+    // --- inputs, not modified:
+    const Int *Ap,
+    const Int *Ai,
+    const double *Ax,
+    Int m,
+    Int n,
+    const double *Xx,
+    Int k,
+    int at,
+    int xt,
+    int yt,
+    Int b,		// first column of the block
+    Int c,		// number of columns in the block (1 to 4)
+
+    // --- workspace, not defined on input or output:
+    double *Wx		// size 4*m
+)
+{
+    const double *Xb ;
+    Int i, t, ld ;
+
+    ld = (c == 1) ? 1 : ((c == 2) ? 2 : 4) ;
+
+    if (!at)
+    {
+
+	//----------------------------------------------------------------------
+	// W = (A * xtrans (x) (:,b:b+c-1))', c-by-m with leading dimension ld
+	//----------------------------------------------------------------------
+
+	double *W = (c == 1 && !yt) ? (Yx + b*m) : Wx ;
+	if (!xt)
+	{
+	    // x is n-by-k
+	    Xb = Xx + b*n ;
+	    switch (c)
+	    {
+		case 1: sfmult_AN_x_1 (W, NULL, Ap, Ai, Ax, NULL, m, n,
+			    Xb, NULL, 0, 0, 0) ; break ;
+		case 2: sfmult_AN_XN_YT_2 (W, NULL, Ap, Ai, Ax, NULL, m, n,
+			    Xb, NULL, 0, 0, 0) ; break ;
+		case 3: sfmult_AN_XN_YT_3 (W, NULL, Ap, Ai, Ax, NULL, m, n,
+			    Xb, NULL, 0, 0, 0) ; break ;
+		case 4: sfmult_AN_XN_YT_4 (W, NULL, Ap, Ai, Ax, NULL, m, n,
+			    Xb, NULL, 0, 0, 0) ; break ;
+	    }
+	}
+	else
+	{
+	    // x is k-by-n
+	    Xb = Xx + b ;
+	    switch (c)
+	    {
+		case 1: sfmult_AN_xk_1 (W, NULL, Ap, Ai, Ax, NULL, m, n,
+			    Xb, NULL, 0, 0, 0, k) ; break ;
+		case 2: sfmult_AN_XT_YT_2 (W, NULL, Ap, Ai, Ax, NULL, m, n,
+			    Xb, NULL, 0, 0, 0, k) ; break ;
+		case 3: sfmult_AN_XT_YT_3 (W, NULL, Ap, Ai, Ax, NULL, m, n,
+			    Xb, NULL, 0, 0, 0, k) ; break ;
+		case 4: sfmult_AN_XT_YT_4 (W, NULL, Ap, Ai, Ax, NULL, m, n,
+			    Xb, NULL, 0, 0, 0, k) ; break ;
+	    }
+	}
+
+	//----------------------------------------------------------------------
+	// copy W into y
+	//----------------------------------------------------------------------
+
+	if (W != Wx)
+	{
+	    // y (:,b) already computed in place
+	}
+	else if (yt)
+	{
+	    // y (b:b+c-1,:) = W, where y is k-by-m
+	    for (i = 0 ; i < m ; i++)
+	    {
+		for (t = 0 ; t < c ; t++)
+		{
+		    Yx [b+t + i*k] = Wx [ld*i + t] ;
+		}
+	    }
+	}
+	else
+	{
+	    // y (:,b:b+c-1) = W', where y is m-by-k
+	    for (t = 0 ; t < c ; t++)
+	    {
+		for (i = 0 ; i < m ; i++)
+		{
+		    Yx [i + (b+t)*m] = Wx [ld*i + t] ;
+		}
+	    }
+	}
+
+    }
+    else
+    {
+
+	//----------------------------------------------------------------------
+	// W = xtrans (x) (:,b:b+c-1)', c-by-m with leading dimension ld
+	//----------------------------------------------------------------------
+
+	if (c == 1 && !xt)
+	{
+	    // x (:,b) is already a contiguous vector
+	    Xb = Xx + b*m ;
+	}
+	else if (!xt)
+	{
+	    // x is m-by-k
+	    for (t = 0 ; t < c ; t++)
+	    {
+		for (i = 0 ; i < m ; i++)
+		{
+		    Wx [ld*i + t] = Xx [i + (b+t)*m] ;
+		}
+	    }
+	    Xb = Wx ;
+	}
+	else
+	{
+	    // x is k-by-m
+	    for (i = 0 ; i < m ; i++)
+	    {
+		for (t = 0 ; t < c ; t++)
+		{
+		    Wx [ld*i + t] = Xx [b+t + i*k] ;
+		}
+	    }
+	    Xb = Wx ;
+	}
+
+	//----------------------------------------------------------------------
+	// y (:,b:b+c-1) = A'*W', or its transpose
+	//----------------------------------------------------------------------
+
+	if (yt)
+	{
+	    // y is k-by-n
+	    switch (c)
+	    {
+		case 1: sfmult_AT_xk_1 (Yx + b, NULL, Ap, Ai, Ax, NULL, m, n,
+			    Xb, NULL, 0, 0, 0, k) ; break ;
+		case 2: sfmult_AT_XT_YT_2 (Yx + b, NULL, Ap, Ai, Ax, NULL, m, n,
+			    Xb, NULL, 0, 0, 0, k) ; break ;
+		case 3: sfmult_AT_XT_YT_3 (Yx + b, NULL, Ap, Ai, Ax, NULL, m, n,
+			    Xb, NULL, 0, 0, 0, k) ; break ;
+		case 4: sfmult_AT_XT_YT_4 (Yx + b, NULL, Ap, Ai, Ax, NULL, m, n,
+			    Xb, NULL, 0, 0, 0, k) ; break ;
+	    }
+	}
+	else
+	{
+	    // y is n-by-k
+	    switch (c)
+	    {
+		case 1: sfmult_AT_x_1 (Yx + b*n, NULL, Ap, Ai, Ax, NULL, m, n,
+			    Xb, NULL, 0, 0, 0) ; break ;
+		case 2: sfmult_AT_XT_YN_2 (Yx + b*n, NULL, Ap, Ai, Ax, NULL, m, n,
+			    Xb, NULL, 0, 0, 0) ; break ;
+		case 3: sfmult_AT_XT_YN_3 (Yx + b*n, NULL, Ap, Ai, Ax, NULL, m, n,
+			    Xb, NULL, 0, 0, 0) ; break ;
+		case 4: sfmult_AT_XT_YN_4 (Yx + b*n, NULL, Ap, Ai, Ax, NULL, m, n,
+			    Xb, NULL, 0, 0, 0) ; break ;
+	    }
+	}
+    }
+}
+
+
+//==============================================================================
+//=== sfmult_csc_split =========================================================
+//==============================================================================
+
+// Returns the first column j of A with Ap [j] >= nz, so that the columns of A
+// can be split into ranges with about the same number of entries.
+
+static Int sfmult_csc_split (const Int *Ap, Int n, double nz)
+{
+    Int lo = 0, hi = n, mid ;
+    while (lo < hi)
+    {
+	mid = lo + (hi - lo) / 2 ;
+	if (Ap [mid] < nz)
+	{
+	    lo = mid + 1 ;
+	}
+	else
+	{
+	    hi = mid ;
+	}
+    }
+    return (lo) ;
+}
+
+
+//==============================================================================
+//=== sfmult_csc ===============================================================
+//==============================================================================
+
+int sfmult_csc		// y = A*x or variants; returns 1 if OK, 0 on error
+(
+    double *Yx,
+    const Int *Ap,
+    const Int *Ai,
+    const double *Ax,
+    Int m,
+    Int n,
+    const double *Xx,
+    Int k,
+    int at,
+    int xt,
+    int yt,
+    int nthreads
+)
+{
+    double *Wx, flops ;
+    Int nblocks, wsize, anz ;
+
+    //--------------------------------------------------------------------------
+    // check inputs
+    //--------------------------------------------------------------------------
+
+    if (Yx == NULL || Ap == NULL || Ai == NULL || Ax == NULL || Xx == NULL
+	|| m < 0 || n < 0 || k < 0)
+    {
+	return (0) ;
+    }
+
+    //--------------------------------------------------------------------------
+    // determine the number of threads to use
+    //--------------------------------------------------------------------------
+
+    anz = Ap [n] ;
+    flops = ((double) anz) * k ;
+#ifdef _OPENMP
+    if (nthreads <= 0)
+    {
+	nthreads = omp_get_max_threads ( ) ;
+    }
+    nthreads = MIN (nthreads, flops / SFMULT_FLOPS_PER_THREAD) ;
+    nthreads = MAX (nthreads, 1) ;
+#else
+    nthreads = 1 ;
+#endif
+
+    //--------------------------------------------------------------------------
+    // y = A'*x where x is a vector: split the columns of A
+    //--------------------------------------------------------------------------
+
+    if (at && k == 1)
+    {
+	#pragma omp parallel num_threads(nthreads) if (nthreads > 1)
+	{
+	    Int tid, nth, j1, j2 ;
+#ifdef _OPENMP
+	    tid = omp_get_thread_num ( ) ;
+	    nth = omp_get_num_threads ( ) ;
+#else
+	    tid = 0 ;
+	    nth = 1 ;
+#endif
+	    j1 = sfmult_csc_split (Ap, n, ((double) anz) * tid / nth) ;
+	    j2 = (tid == nth-1) ? n :
+		sfmult_csc_split (Ap, n, ((double) anz) * (tid+1) / nth) ;
+	    // y (j1:j2-1) = A (:,j1:j2-1)' * x
+	    sfmult_AT_x_1 (Yx + j1, NULL, Ap + j1, Ai, Ax, NULL, m, j2 - j1,
+		Xx, NULL, 0, 0, 0) ;
+	}
+	return (1) ;
+    }
+
+    //--------------------------------------------------------------------------
+    // allocate workspace
+    //--------------------------------------------------------------------------
+
+    nblocks = (k + 3) / 4 ;
+    nthreads = MIN (nthreads, MAX (nblocks, 1)) ;
+    wsize = 4*m + 1 ;
+    if (((double) wsize) * nthreads * sizeof (double) >= (double) SIZE_MAX)
+    {
+	// problem too large
+	return (0) ;
+    }
+    Wx = malloc (((size_t) wsize) * nthreads * sizeof (double)) ;
+    if (Wx == NULL)
+    {
+	// out of memory
+	return (0) ;
+    }
+
+    //--------------------------------------------------------------------------
+    // y = op(op(A)*op(x)), in blocks of up to 4 columns of op(x)
+    //--------------------------------------------------------------------------
+
+    #pragma omp parallel num_threads(nthreads) if (nthreads > 1)
+    {
+	double *W ;
+	Int block, b ;
+#ifdef _OPENMP
+	W = Wx + ((size_t) wsize) * omp_get_thread_num ( ) ;
+#else
+	W = Wx ;
+#endif
+	#pragma omp for schedule(dynamic, 1)
+	for (block = 0 ; block < nblocks ; block++)
+	{
+	    b = 4*block ;
+	    sfmult_csc_block (Yx, Ap, Ai, Ax, m, n, Xx, k, at, xt, yt,
+		b, MIN (4, k-b), W) ;
+	}
+    }
+
+    //--------------------------------------------------------------------------
+    // free workspace and return result
+    //--------------------------------------------------------------------------
+
+    free (Wx) ;
+    return (1) ;
+}
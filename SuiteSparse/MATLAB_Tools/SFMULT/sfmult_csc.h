@@ -0,0 +1,432 @@
+// =============================================================================
+// === sfmult_csc.h ============================================================
+// =============================================================================
+
+// Sparse-times-full kernels of SFMULT, for use without MATLAB.  A is a sparse
+// matrix in compressed-column form (Ap, Ai, Ax), and x and y are full
+// matrices stored by column.  Only real matrices are supported (the complex
+// cases of the kernels are not yet written; Az, Xz, Yz, ac, xc, and yc are
+// ignored).
+
+#ifndef _SFMULT_CSC_H
+#define _SFMULT_CSC_H
+
+#include <stddef.h>
+
+// The mexFunction defines Int as mwSignedIndex before including this file.
+#ifndef Int
+#define Int ptrdiff_t
+#endif
+
+// The column-blocked kernels are compiled for several instruction sets, and
+// the best one for the host is selected at run time.  Compile with -DNSIMD
+// to disable this.
+#if !defined (NSIMD) && defined (__GNUC__) && !defined (__clang__) \
+    && (__GNUC__ >= 6) && defined (__x86_64__) && defined (__linux__)
+#define SFMULT_DISPATCH \
+    __attribute__ ((target_clones ("avx512f", "avx2", "default")))
+#else
+#define SFMULT_DISPATCH
+#endif
+
+// -----------------------------------------------------------------------------
+// y = A*x and variants, without MATLAB
+// -----------------------------------------------------------------------------
+
+int sfmult_csc		// y = A*x or variants; returns 1 if OK, 0 on error
+(
+    // --- output, not initialized on input:
+    double *Yx,		// see below for its size
+
+    // --- inputs, not modified:
+    const Int *Ap,	// size n+1 column pointers, Ap [0] = 0
+    const Int *Ai,	// size nz = Ap[n] row indices
+    const double *Ax,	// size nz values
+    Int m,		// A is m-by-n
+    Int n,
+    const double *Xx,	// x, see below for its size
+    Int k,		// number of columns of op(x)
+    int at,		// if true: trans(A)  if false: A
+    int xt,		// if true: trans(x)  if false: x
+    int yt,		// if true: trans(y)  if false: y
+    int nthreads	// number of OpenMP threads to use (<= 0: default)
+) ;
+
+// -----------------------------------------------------------------------------
+// kernels in sfmult_anxnyt_k.c
+// -----------------------------------------------------------------------------
+
+void sfmult_AN_XN_YT_2	// y = (A*x)'  where x is n-by-2, and y is 2-by-m
+(
+    // --- outputs, not initialized on input:
+    double *Yx,		// 2-by-m
+    double *Yz,		// 2-by-m if Y is complex
+
+    // --- inputs, not modified:
+    const Int *Ap,	// size n+1 column pointers
+    const Int *Ai,	// size nz = Ap[n] row indices
+    const double *Ax,	// size nz values
+    const double *Az,	// size nz imaginary values if A is complex
+    Int m,		// A is m-by-n
+    Int n,
+    const double *Xx,	// n-by-2
+    const double *Xz,	// n-by-2 if X complex
+    int ac,		// true: use conj(A), otherwise use A
+    int xc,		// true: use conj(X), otherwise use X
+    int yc		// true: compute conj(Y), otherwise compute Y
+) ;
+
+void sfmult_AN_XN_YT_3	// y = (A*x)'	x is n-by-3, and y is 3-by-m (ldy = 4)
+(
+    // --- outputs, not initialized on input:
+    double *Yx,		// 3-by-m
+    double *Yz,		// 3-by-m if Y is complex
+
+    // --- inputs, not modified:
+    const Int *Ap,	// size n+1 column pointers
+    const Int *Ai,	// size nz = Ap[n] row indices
+    const double *Ax,	// size nz values
+    const double *Az,	// size nz imaginary values if A is complex
+    Int m,		// A is m-by-n
+    Int n,
+    const double *Xx,	// n-by-3
+    const double *Xz,	// n-by-3 if X complex
+    int ac,		// true: use conj(A), otherwise use A
+    int xc,		// true: use conj(X), otherwise use X
+    int yc		// true: compute conj(Y), otherwise compute Y
+) ;
+
+void sfmult_AN_XN_YT_4	// y = (A*x)'	x is n-by-4, and y is 4-by-m
+(
+    // --- outputs, not initialized on input:
+    double *Yx,		// 4-by-m
+    double *Yz,		// 4-by-m if Y is complex
+
+    // --- inputs, not modified:
+    const Int *Ap,	// size n+1 column pointers
+    const Int *Ai,	// size nz = Ap[n] row indices
+    const double *Ax,	// size nz values
+    const double *Az,	// size nz imaginary values if A is complex
+    Int m,		// A is m-by-n
+    Int n,
+    const double *Xx,	// n-by-4
+    const double *Xz,	// n-by-4 if X complex
+    int ac,		// true: use conj(A), otherwise use A
+    int xc,		// true: use conj(X), otherwise use X
+    int yc		// true: compute conj(Y), otherwise compute Y
+) ;
+
+// -----------------------------------------------------------------------------
+// kernels in sfmult_anxtyt_k.c
+// -----------------------------------------------------------------------------
+
+void sfmult_AN_XT_YT_2	// y = (A*x')'	x is 2-by-n, and y is 2-by-m
+(
+    // --- outputs, not initialized on input:
+    double *Yx,		// 2-by-m
+    double *Yz,		// 2-by-m if Y is complex
+
+    // --- inputs, not modified:
+    const Int *Ap,	// size n+1 column pointers
+    const Int *Ai,	// size nz = Ap[n] row indices
+    const double *Ax,	// size nz values
+    const double *Az,	// size nz imaginary values if A is complex
+    Int m,		// A is m-by-n
+    Int n,
+    const double *Xx,	// 2-by-n with leading dimension k
+    const double *Xz,	// 2-by-n with leading dimension k if X complex
+    int ac,		// true: use conj(A), otherwise use A
+    int xc,		// true: use conj(X), otherwise use X
+    int yc		// true: compute conj(Y), otherwise compute Y
+    , Int k		// leading dimension of X
+) ;
+
+void sfmult_AN_XT_YT_3	// y = (A*x')'	x is 3-by-n, and y is 3-by-m (ldy = 4)
+(
+    // --- outputs, not initialized on input:
+    double *Yx,		// 3-by-m
+    double *Yz,		// 3-by-m if Y is complex
+
+    // --- inputs, not modified:
+    const Int *Ap,	// size n+1 column pointers
+    const Int *Ai,	// size nz = Ap[n] row indices
+    const double *Ax,	// size nz values
+    const double *Az,	// size nz imaginary values if A is complex
+    Int m,		// A is m-by-n
+    Int n,
+    const double *Xx,	// 3-by-n with leading dimension k
+    const double *Xz,	// 3-by-n with leading dimension k if X complex
+    int ac,		// true: use conj(A), otherwise use A
+    int xc,		// true: use conj(X), otherwise use X
+    int yc		// true: compute conj(Y), otherwise compute Y
+    , Int k		// leading dimension of X
+) ;
+
+void sfmult_AN_XT_YT_4 // y = (A*x')'	x is 4-by-n, and y is 4-by-m
+(
+    // --- outputs, not initialized on input:
+    double *Yx,		// 4-by-m
+    double *Yz,		// 4-by-m if Y is complex
+
+    // --- inputs, not modified:
+    const Int *Ap,	// size n+1 column pointers
+    const Int *Ai,	// size nz = Ap[n] row indices
+    const double *Ax,	// size nz values
+    const double *Az,	// size nz imaginary values if A is complex
+    Int m,		// A is m-by-n
+    Int n,
+    const double *Xx,	// 4-by-n with leading dimension k
+    const double *Xz,	// 4-by-n with leading dimension k if X complex
+    int ac,		// true: use conj(A), otherwise use A
+    int xc,		// true: use conj(X), otherwise use X
+    int yc		// true: compute conj(Y), otherwise compute Y
+    , Int k		// leading dimension of X
+) ;
+
+// -----------------------------------------------------------------------------
+// kernels in sfmult_atxtyn_k.c
+// -----------------------------------------------------------------------------
+
+void sfmult_AT_XT_YN_2	// y = A'*x'	x is 2-by-m, and y is n-by-2
+(
+    // --- outputs, not initialized on input:
+    double *Yx,		// n-by-2
+    double *Yz,		// n-by-2 if Y is complex
+
+    // --- inputs, not modified:
+    const Int *Ap,	// size n+1 column pointers
+    const Int *Ai,	// size nz = Ap[n] row indices
+    const double *Ax,	// size nz values
+    const double *Az,	// size nz imaginary values if A is complex
+    Int m,		// A is m-by-n
+    Int n,
+    const double *Xx,	// 2-by-m
+    const double *Xz,	// 2-by-m if X complex
+    int ac,		// true: use conj(A), otherwise use A
+    int xc,		// true: use conj(X), otherwise use X
+    int yc		// true: compute conj(Y), otherwise compute Y
+) ;
+
+void sfmult_AT_XT_YN_3	// y = A'*x'	x is 3-by-m, and y is n-by-3 (ldx = 4)
+(
+    // --- outputs, not initialized on input:
+    double *Yx,		// n-by-3
+    double *Yz,		// n-by-3 if Y is complex
+
+    // --- inputs, not modified:
+    const Int *Ap,	// size n+1 column pointers
+    const Int *Ai,	// size nz = Ap[n] row indices
+    const double *Ax,	// size nz values
+    const double *Az,	// size nz imaginary values if A is complex
+    Int m,		// A is m-by-n
+    Int n,
+    const double *Xx,	// 3-by-m
+    const double *Xz,	// 3-by-m if X complex
+    int ac,		// true: use conj(A), otherwise use A
+    int xc,		// true: use conj(X), otherwise use X
+    int yc		// true: compute conj(Y), otherwise compute Y
+) ;
+
+void sfmult_AT_XT_YN_4	// y = A'*x'	x is 4-by-m, and y is n-by-4
+(
+    // --- outputs, not initialized on input:
+    double *Yx,		// n-by-4
+    double *Yz,		// n-by-4 if Y is complex
+
+    // --- inputs, not modified:
+    const Int *Ap,	// size n+1 column pointers
+    const Int *Ai,	// size nz = Ap[n] row indices
+    const double *Ax,	// size nz values
+    const double *Az,	// size nz imaginary values if A is complex
+    Int m,		// A is m-by-n
+    Int n,
+    const double *Xx,	// 4-by-m
+    const double *Xz,	// 4-by-m if X complex
+    int ac,		// true: use conj(A), otherwise use A
+    int xc,		// true: use conj(X), otherwise use X
+    int yc		// true: compute conj(Y), otherwise compute Y
+) ;
+
+// -----------------------------------------------------------------------------
+// kernels in sfmult_atxtyt_k.c
+// -----------------------------------------------------------------------------
+
+void sfmult_AT_XT_YT_2	// y = (A'*x')'	x is 2-by-m, and y is 2-by-n
+(
+    // --- outputs, not initialized on input:
+    double *Yx,		// 2-by-n with leading dimension k
+    double *Yz,		// 2-by-n with leading dimension k if Y is complex
+
+    // --- inputs, not modified:
+    const Int *Ap,	// size n+1 column pointers
+    const Int *Ai,	// size nz = Ap[n] row indices
+    const double *Ax,	// size nz values
+    const double *Az,	// size nz imaginary values if A is complex
+    Int m,		// A is m-by-n
+    Int n,
+    const double *Xx,	// 2-by-m
+    const double *Xz,	// 2-by-m if X complex
+    int ac,		// true: use conj(A), otherwise use A
+    int xc,		// true: use conj(X), otherwise use X
+    int yc		// true: compute conj(Y), otherwise compute Y
+    , Int k		// leading dimension of Y
+) ;
+
+void sfmult_AT_XT_YT_3	// y = (A'*x')'	x is 3-by-m, and y is 3-by-n (ldx = 4)
+(
+    // --- outputs, not initialized on input:
+    double *Yx,		// 3-by-n with leading dimension k
+    double *Yz,		// 3-by-n with leading dimension k if Y is complex
+
+    // --- inputs, not modified:
+    const Int *Ap,	// size n+1 column pointers
+    const Int *Ai,	// size nz = Ap[n] row indices
+    const double *Ax,	// size nz values
+    const double *Az,	// size nz imaginary values if A is complex
+    Int m,		// A is m-by-n
+    Int n,
+    const double *Xx,	// 3-by-m
+    const double *Xz,	// 3-by-m if X complex
+    int ac,		// true: use conj(A), otherwise use A
+    int xc,		// true: use conj(X), otherwise use X
+    int yc		// true: compute conj(Y), otherwise compute Y
+    , Int k		// leading dimension of Y
+) ;
+
+void sfmult_AT_XT_YT_4	// y = (A'*x')'	x is 4-by-m, and y is 4-by-n
+(
+    // --- outputs, not initialized on input:
+    double *Yx,		// 4-by-n with leading dimension k
+    double *Yz,		// 4-by-n with leading dimension k if Y is complex
+
+    // --- inputs, not modified:
+    const Int *Ap,	// size n+1 column pointers
+    const Int *Ai,	// size nz = Ap[n] row indices
+    const double *Ax,	// size nz values
+    const double *Az,	// size nz imaginary values if A is complex
+    Int m,		// A is m-by-n
+    Int n,
+    const double *Xx,	// 4-by-m
+    const double *Xz,	// 4-by-m if X complex
+    int ac,		// true: use conj(A), otherwise use A
+    int xc,		// true: use conj(X), otherwise use X
+    int yc		// true: compute conj(Y), otherwise compute Y
+    , Int k		// leading dimension of Y
+) ;
+
+// -----------------------------------------------------------------------------
+// kernel in sfmult_xA
+// -----------------------------------------------------------------------------
+
+void sfmult_xA		// y = (A'*x')' = x*A, x is k-by-m, and y is k-by-n
+(
+    // --- outputs, not initialized on input:
+    double *Yx,		// k-by-n
+    double *Yz,		// k-by-n if Y is complex
+
+    // --- inputs, not modified:
+    const Int *Ap,	// size n+1 column pointers
+    const Int *Ai,	// size nz = Ap[n] row indices
+    const double *Ax,	// size nz values
+    const double *Az,	// size nz imaginary values if A is complex
+    Int m,		// A is m-by-n
+    Int n,
+    const double *Xx,	// k-by-m
+    const double *Xz,	// k-by-m if X complex
+    int ac,		// true: use conj(A), otherwise use A
+    int xc,		// true: use conj(X), otherwise use X
+    int yc		// true: compute conj(Y), otherwise compute Y
+    , Int k
+) ;
+
+// -----------------------------------------------------------------------------
+// vector kernels in sfmult_vector_1.c
+// -----------------------------------------------------------------------------
+
+void sfmult_AN_x_1	// y = A*x	x is n-by-1 unit stride, y is m-by-1
+(
+    // --- outputs, not initialized on input:
+    double *Yx,		// m-by-1
+    double *Yz,		// m-by-1 if Y is complex
+
+    // --- inputs, not modified:
+    const Int *Ap,	// size n+1 column pointers
+    const Int *Ai,	// size nz = Ap[n] row indices
+    const double *Ax,	// size nz values
+    const double *Az,	// size nz imaginary values if A is complex
+    Int m,		// A is m-by-n
+    Int n,
+    const double *Xx,	// n-by-1
+    const double *Xz,	// n-by-1 if X complex
+    int ac,		// true: use conj(A), otherwise use A
+    int xc,		// true: use conj(X), otherwise use X
+    int yc		// true: compute conj(Y), otherwise compute Y
+) ;
+
+void sfmult_AT_x_1	// y = A'*x	x is m-by-1, y is n-by-1
+(
+    // --- outputs, not initialized on input:
+    double *Yx,		// n-by-1
+    double *Yz,		// n-by-1 if Y is complex
+
+    // --- inputs, not modified:
+    const Int *Ap,	// size n+1 column pointers
+    const Int *Ai,	// size nz = Ap[n] row indices
+    const double *Ax,	// size nz values
+    const double *Az,	// size nz imaginary values if A is complex
+    Int m,		// A is m-by-n
+    Int n,
+    const double *Xx,	// m-by-1
+    const double *Xz,	// m-by-1 if X complex
+    int ac,		// true: use conj(A), otherwise use A
+    int xc,		// true: use conj(X), otherwise use X
+    int yc		// true: compute conj(Y), otherwise compute Y
+) ;
+
+// -----------------------------------------------------------------------------
+// vector kernels in sfmult_vector_k.c
+// -----------------------------------------------------------------------------
+
+void sfmult_AN_xk_1	// y = A*x	x is n-by-1 non-unit stride, y is m-by-1
+(
+    // --- outputs, not initialized on input:
+    double *Yx,		// m-by-1
+    double *Yz,		// m-by-1 if Y is complex
+
+    // --- inputs, not modified:
+    const Int *Ap,	// size n+1 column pointers
+    const Int *Ai,	// size nz = Ap[n] row indices
+    const double *Ax,	// size nz values
+    const double *Az,	// size nz imaginary values if A is complex
+    Int m,		// A is m-by-n
+    Int n,
+    const double *Xx,	// n-by-1
+    const double *Xz,	// n-by-1 if X complex
+    int ac,		// true: use conj(A), otherwise use A
+    int xc,		// true: use conj(X), otherwise use X
+    int yc		// true: compute conj(Y), otherwise compute Y
+    , Int k		// stride of x
+) ;
+
+void sfmult_AT_xk_1	// y = A'*x	x is m-by-1, y is n-by-1 non-unit stride
+(
+    // --- outputs, not initialized on input:
+    double *Yx,		// n-by-1
+    double *Yz,		// n-by-1 if Y is complex
+
+    // --- inputs, not modified:
+    const Int *Ap,	// size n+1 column pointers
+    const Int *Ai,	// size nz = Ap[n] row indices
+    const double *Ax,	// size nz values
+    const double *Az,	// size nz imaginary values if A is complex
+    Int m,		// A is m-by-n
+    Int n,
+    const double *Xx,	// m-by-1
+    const double *Xz,	// m-by-1 if X complex
+    int ac,		// true: use conj(A), otherwise use A
+    int xc,		// true: use conj(X), otherwise use X
+    int yc		// true: compute conj(Y), otherwise compute Y
+    , Int k		// stride of y
+) ;
+
+#endif
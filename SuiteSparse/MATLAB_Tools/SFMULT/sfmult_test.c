@@ -0,0 +1,235 @@
+//==============================================================================
+// sfmult_test: test sfmult_csc against a simple reference product
+//==============================================================================
+
+// Usage:
+//
+//	sfmult_test
+//
+// Computes y = ytrans (atrans (A) * xtrans (x)) with sfmult_csc for all eight
+// combinations of (at, xt, yt), for k = 0 to 17 columns of xtrans (x), and
+// with 1, 2, 3, 4, and 8 threads.  Each result is compared with a reference
+// product computed one entry of A at a time.  The results with more than one
+// thread must be identical to the result with one thread.  Two matrices are
+// used: a small one with unsorted columns and empty rows and columns, and a
+// larger one, for which the work is split among the threads.  Returns 0 if all
+// tests pass, or 1 if any test fails.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "sfmult_csc.h"
+
+#ifndef MAX
+#define MAX(a,b) (((a) > (b)) ? (a) : (b))
+#endif
+
+#define KMAX 17
+#define TOL 1e-12
+
+//==============================================================================
+// random numbers
+//==============================================================================
+
+static unsigned long seed = 1 ;
+
+static double xrand (void)	    // uniform in [-1,1]
+{
+    seed = seed * 1103515245 + 12345 ;
+    return (((double) ((seed / 65536) % 32768)) / 16383.5 - 1) ;
+}
+
+static Int irand (Int n)	    // uniform in 0 to n-1
+{
+    seed = seed * 1103515245 + 12345 ;
+    return ((Int) ((seed / 65536) % 32768) % n) ;
+}
+
+//==============================================================================
+// random_matrix: a random m-by-n sparse matrix with about d entries per column
+//==============================================================================
+
+// Columns j with j%7 == 3 and rows i with i%5 == 1 are empty.  The row indices
+// in each column are distinct, but in random order.
+
+static int random_matrix (Int m, Int n, Int d, Int **Ap_handle,
+    Int **Ai_handle, double **Ax_handle)
+{
+    Int *Ap, *Ai, *Mark, i, j, p, t ;
+    double *Ax ;
+    Ap = malloc ((n+1) * sizeof (Int)) ;
+    Ai = malloc (MAX (n*d, 1) * sizeof (Int)) ;
+    Ax = malloc (MAX (n*d, 1) * sizeof (double)) ;
+    Mark = malloc (MAX (m, 1) * sizeof (Int)) ;
+    if (Ap == NULL || Ai == NULL || Ax == NULL || Mark == NULL)
+    {
+	free (Ap) ;
+	free (Ai) ;
+	free (Ax) ;
+	free (Mark) ;
+	return (0) ;
+    }
+    for (i = 0 ; i < m ; i++) Mark [i] = -1 ;
+    p = 0 ;
+    for (j = 0 ; j < n ; j++)
+    {
+	Ap [j] = p ;
+	for (t = 0 ; j % 7 != 3 && t < d ; t++)
+	{
+	    i = irand (m) ;
+	    if (i % 5 == 1 || Mark [i] == j) continue ;
+	    Mark [i] = j ;
+	    Ai [p] = i ;
+	    Ax [p] = xrand ( ) ;
+	    p++ ;
+	}
+    }
+    Ap [n] = p ;
+    free (Mark) ;
+    *Ap_handle = Ap ;
+    *Ai_handle = Ai ;
+    *Ax_handle = Ax ;
+    return (1) ;
+}
+
+//==============================================================================
+// reference: y = ytrans (atrans (A) * xtrans (x)), one entry of A at a time
+//==============================================================================
+
+static void reference (double *Y, const Int *Ap, const Int *Ai,
+    const double *Ax, Int m, Int n, const double *X, Int k, int at, int xt,
+    int yt)
+{
+    Int i, j, p, c, xrow, yrow, ynrow ;
+    double a ;
+    ynrow = at ? n : m ;
+    for (p = 0 ; p < ynrow * k ; p++) Y [p] = 0 ;
+    for (j = 0 ; j < n ; j++)
+    {
+	for (p = Ap [j] ; p < Ap [j+1] ; p++)
+	{
+	    i = Ai [p] ;
+	    a = Ax [p] ;
+	    // A(i,j) is entry (xrow,yrow) of atrans (A)
+	    yrow = at ? j : i ;
+	    xrow = at ? i : j ;
+	    for (c = 0 ; c < k ; c++)
+	    {
+		double x = xt ? X [c + xrow*k] : X [xrow + c*(at ? m : n)] ;
+		if (yt)
+		{
+		    Y [c + yrow*k] += a * x ;
+		}
+		else
+		{
+		    Y [yrow + c*ynrow] += a * x ;
+		}
+	    }
+	}
+    }
+}
+
+//==============================================================================
+// test_matrix: test all variants of y = A*x for one matrix A
+//==============================================================================
+
+static int test_matrix (Int m, Int n, Int d)
+{
+    Int *Ap, *Ai, k, p, ysize, mn ;
+    double *Ax, *X, *Y, *Y1, *Yref, err, ymax ;
+    int at, xt, yt, t, nfail = 0, ok ;
+    int nthreads [5] = { 1, 2, 3, 4, 8 } ;
+
+    if (!random_matrix (m, n, d, &Ap, &Ai, &Ax))
+    {
+	printf ("out of memory\n") ;
+	return (1) ;
+    }
+    mn = MAX (m, n) ;
+    X = malloc (MAX (mn * KMAX, 1) * sizeof (double)) ;
+    Y = malloc (MAX (mn * KMAX, 1) * sizeof (double)) ;
+    Y1 = malloc (MAX (mn * KMAX, 1) * sizeof (double)) ;
+    Yref = malloc (MAX (mn * KMAX, 1) * sizeof (double)) ;
+    if (X == NULL || Y == NULL || Y1 == NULL || Yref == NULL)
+    {
+	printf ("out of memory\n") ;
+	nfail++ ;
+    }
+    for (p = 0 ; nfail == 0 && p < mn * KMAX ; p++) X [p] = xrand ( ) ;
+
+    printf ("A: %ld-by-%ld with %ld entries\n", (long) m, (long) n,
+	(long) Ap [n]) ;
+    for (at = 0 ; nfail == 0 && at <= 1 ; at++)
+    {
+	for (xt = 0 ; xt <= 1 ; xt++)
+	{
+	    for (yt = 0 ; yt <= 1 ; yt++)
+	    {
+		err = 0 ;
+		for (k = 0 ; k <= KMAX ; k++)
+		{
+		    ysize = (at ? n : m) * k ;
+		    reference (Yref, Ap, Ai, Ax, m, n, X, k, at, xt, yt) ;
+		    ymax = 1 ;
+		    for (p = 0 ; p < ysize ; p++)
+		    {
+			ymax = MAX (ymax, fabs (Yref [p])) ;
+		    }
+		    for (t = 0 ; t < 5 ; t++)
+		    {
+			// y is set to NaN, so entries not computed are caught
+			for (p = 0 ; p < ysize ; p++) Y [p] = NAN ;
+			ok = sfmult_csc (Y, Ap, Ai, Ax, m, n, X, k, at, xt, yt,
+			    nthreads [t]) ;
+			for (p = 0 ; ok && p < ysize ; p++)
+			{
+			    double e = fabs (Y [p] - Yref [p]) / ymax ;
+			    ok = (e <= TOL) ;
+			    err = MAX (err, e) ;
+			}
+			if (t == 0)
+			{
+			    for (p = 0 ; p < ysize ; p++) Y1 [p] = Y [p] ;
+			}
+			for (p = 0 ; ok && p < ysize ; p++)
+			{
+			    ok = (Y [p] == Y1 [p]) ;
+			}
+			if (!ok)
+			{
+			    printf ("at %d xt %d yt %d k %ld nthreads %d: "
+				"FAILED\n", at, xt, yt, (long) k, nthreads [t]);
+			    nfail++ ;
+			}
+		    }
+		}
+		printf ("at %d xt %d yt %d, k = 0 to %d, nthreads 1 to 8: "
+		    "max rel. error %8.2e : %s\n", at, xt, yt, KMAX, err,
+		    (nfail == 0) ? "OK" : "FAILED") ;
+	    }
+	}
+    }
+
+    free (Ap) ;
+    free (Ai) ;
+    free (Ax) ;
+    free (X) ;
+    free (Y) ;
+    free (Y1) ;
+    free (Yref) ;
+    return (nfail) ;
+}
+
+//==============================================================================
+// sfmult_test main program
+//==============================================================================
+
+int main (void)
+{
+    int nfail = 0 ;
+    nfail += test_matrix (37, 29, 6) ;
+    nfail += test_matrix (3000, 2000, 80) ;
+    printf ("sfmult_test: %s\n", (nfail == 0) ? "all tests passed" :
+	"FAILED") ;
+    return (nfail > 0) ;
+}
@@ -7,7 +7,7 @@
 // sfmult_AN_x_1    y = A*x	x is n-by-1, y is m-by-1
 // sfmult_AT_x_1    y = A'*x	x is m-by-1, y is n-by-1
 
-#include "sfmult.h"
+#include "sfmult_csc.h"
 
 //==============================================================================
 //=== sfmult_AN_x_1 ============================================================
@@ -82,7 +82,7 @@ void sfmult_AT_x_1	// y = A'*x	x is m-by-1 unit stride, y is n-by-1
     double *Yz,		// n-by-1 if Y is complex (TO DO)
 
     // --- inputs, not modified
-    const Int *Ap,	// size n+1 column pointers
+    const Int *Ap,	// size n+1 column pointers (Ap [0] may be > 0)
     const Int *Ai,	// size nz = Ap[n] row indices
     const double *Ax,	// size nz values
     const double *Az,	// size nz imaginary values if A is complex (TO DO)
@@ -98,7 +98,7 @@ void sfmult_AT_x_1	// y = A'*x	x is m-by-1 unit stride, y is n-by-1
     double y ;
     Int p, pend, j ;
 
-    p = 0 ;
+    p = Ap [0] ;
     for (j = 0 ; j < n ; j++)
     {
 	pend = Ap [j+1] ;
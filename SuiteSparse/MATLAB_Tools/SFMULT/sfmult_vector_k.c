@@ -7,7 +7,7 @@
 // sfmult_AN_xk_1   y = A*x	x is n-by-1, y is m-by-1 (x non-unit stride)
 // sfmult_AT_xk_1   y = A'*x	x is m-by-1, y is n-by-1 (y non-unit stride)
 
-#include "sfmult.h"
+#include "sfmult_csc.h"
 
 //==============================================================================
 //=== sfmult_AN_xk_1 ===========================================================
@@ -83,7 +83,7 @@ void sfmult_AT_xk_1	// y = A'*x	x is m-by-1, y is n-by-1 non-unit stride
     double *Yz,		// n-by-1 if Y is complex (TO DO)
 
     // --- inputs, not modified
-    const Int *Ap,	// size n+1 column pointers
+    const Int *Ap,	// size n+1 column pointers (Ap [0] may be > 0)
     const Int *Ai,	// size nz = Ap[n] row indices
     const double *Ax,	// size nz values
     const double *Az,	// size nz imaginary values if A is complex (TO DO)
@@ -100,7 +100,7 @@ void sfmult_AT_xk_1	// y = A'*x	x is m-by-1, y is n-by-1 non-unit stride
     double y ;
     Int p, pend, j ;
 
-    p = 0 ;
+    p = Ap [0] ;
     for (j = 0 ; j < n ; j++)
     {
 	pend = Ap [j+1] ;
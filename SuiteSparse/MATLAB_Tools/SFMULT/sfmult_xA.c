@@ -6,7 +6,7 @@
 // columns.  It is used only when A is very sparse and X is large since it can
 // be very slow otherwise.
 
-#include "sfmult.h"
+#include "sfmult_csc.h"
 
 void sfmult_xA		// y = (A'*x')' = x*A,	x is k-by-m, and y is k-by-n
 (
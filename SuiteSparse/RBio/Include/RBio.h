@@ -101,6 +101,7 @@ extern "C" {
 /*
     RBread:         read a Rutherford/Boeing matrix from a file
     RBwrite:        write a matrix to a file in R/B format
+    RBwrite_stream: write a matrix to a file, one column at a time
 
     RBkind:         determine the matrix type (RUA, RSA, etc)
     RBreadraw:      read the raw contents of a R/B file
@@ -240,6 +241,32 @@ SuiteSparse_long RBwrite (char *filename, char *title, char *key,
     SuiteSparse_long *Zi, SuiteSparse_long mkind_in, char mtype [4]) ;
 
 
+/* RBwrite_stream obtains the matrix from get_column (j, Ci, Cx, Cz, user),
+   which writes the sorted row indices of column j into Ci and its values into
+   Cx (and Cz, if complex), and returns the number of entries in the column,
+   or -1 on error.  Each column is requested three times.  Ci, Cx, and Cz have
+   size nrow.  The matrix type (RUA, RSA, CHA, PRA, etc) is given on input. */
+
+int RBwrite_stream_i    /* 0:OK, < 0: error, > 0: warning */
+(
+    /* input */
+    char *filename, /* filename to write to (stdout if NULL) */
+    char *title,    /* title (72 char max), may be NULL */
+    char *key,      /* key (8 char max), may be NULL */
+    char *mtype,    /* matrix type: RUA, RSA, PRA, CHA, IUA, etc */
+    int nrow,       /* A is nrow-by-ncol */
+    int ncol,
+    int (*get_column) (int j, int *Ci, double *Cx, double *Cz, void *user),
+    void *user      /* passed to get_column, not otherwise used */
+) ;
+
+SuiteSparse_long RBwrite_stream (char *filename, char *title, char *key,
+    char *mtype, SuiteSparse_long nrow, SuiteSparse_long ncol,
+    SuiteSparse_long (*get_column) (SuiteSparse_long j, SuiteSparse_long *Ci,
+        double *Cx, double *Cz, void *user),
+    void *user) ;
+
+
 void RBget_entry_i
 (
     int mkind,          /* R: 0, P: 1, C: 2, I: 3 */
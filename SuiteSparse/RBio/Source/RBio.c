@@ -16,6 +16,19 @@
 
 #include "RBio.h"
 
+/* The memory-mapped parser requires mmap; compile with -DNMMAP to disable it */
+#if !defined (NMMAP) && (defined (__unix__) || defined (__APPLE__))
+#define RBIO_MMAP
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #ifdef INT
 /* int version */
 #define Int int
@@ -39,6 +52,20 @@
 #define PUBLIC
 
 #define SLEN 4096
+#define RBIO_CHUNK (1 << 22)    /* parse at least 4MB per task */
+#define RBIO_NOMAP (-1000)      /* the mapped file must be read with stdio */
+#define ISSEP(c) ((c) == ' ' || (c) == '\n' || (c) == '\r')
+
+/* a Rutherford/Boeing file mapped into memory */
+typedef struct
+{
+    char *x ;           /* contents of the file */
+    size_t size ;       /* size of the file, in bytes */
+    size_t sec [4] ;    /* section k is x [sec [k] ... sec [k+1]-1]: column
+                           pointers (k=0), row indices (1), and values (2) */
+    int nthreads ;      /* number of threads to use */
+} RBmap ;
+
 #define FREE_WORK   { SuiteSparse_free (w) ; \
                       SuiteSparse_free (cp) ; }
 
@@ -54,6 +81,11 @@
                       SuiteSparse_free (Ai) ; \
                       SuiteSparse_free (Ax) ; }
 
+#define FREE_STREAM { SuiteSparse_free (Ci) ; \
+                      SuiteSparse_free (Cx) ; \
+                      SuiteSparse_free (Cz) ; \
+                      SuiteSparse_free (cp) ; }
+
 
 /* ========================================================================== */
 /* === internal prototypes ================================================== */
@@ -164,6 +196,7 @@ PRIVATE Int RB(read2)     /* 0: OK, < 0: error, > 0: warning */
 (
     /* input */
     FILE *file,         /* must be already open for reading */
+    RBmap *map,         /* if not NULL, read from the mapped file instead */
     Int nrow,           /* A is nrow-by-ncol */
     Int ncol,
     Int nnz,            /* number of entries in A, from the header */
@@ -187,6 +220,63 @@ PRIVATE Int RB(read2)     /* 0: OK, < 0: error, > 0: warning */
     Int slen
 ) ;
 
+PRIVATE Int RB(ptoken)    /* TRUE if token is a number, FALSE otherwise */
+(
+    const char *t,      /* token to parse, not null-terminated */
+    size_t len,         /* length of the token */
+    double *x           /* value of the token */
+) ;
+
+PRIVATE Int RB(pcount)    /* return number of tokens in x [0..len-1] */
+(
+    const char *x,
+    size_t len
+) ;
+
+PRIVATE Int RB(pparse)    /* TRUE if OK, FALSE otherwise */
+(
+    const char *x,      /* chunk to parse, x [0..len-1] */
+    size_t len,
+    Int t,              /* index of the first token of the chunk */
+    Int n,              /* tokens n and higher are ignored */
+    Int kind,           /* 0: integers, 1: reals, 2: split-complex */
+    Int offset,         /* offset to subtract from each integer */
+    Int *A,             /* integers, if kind is 0 */
+    double *Ax,         /* reals, or real parts if kind is 2 */
+    double *Az          /* imaginary parts, if kind is 2 */
+) ;
+
+PRIVATE Int RB(pread)     /* TRUE if OK, FALSE otherwise */
+(
+    RBmap *map,         /* the mapped file */
+    Int section,        /* 0: column pointers, 1: row indices, 2: values */
+    Int n,              /* number of tokens to read */
+    Int kind,           /* 0: integers, 1: reals, 2: split-complex */
+    Int offset,         /* offset to subtract from each integer */
+    Int *A,             /* size n, if kind is 0 */
+    double *Ax,         /* size n if kind is 1, n/2 if kind is 2 */
+    double *Az          /* size n/2 if kind is 2 */
+) ;
+
+#ifdef RBIO_MMAP
+PRIVATE Int RB(plines)    /* TRUE if OK, FALSE if the file is too short */
+(
+    RBmap *map,         /* on input, map->sec [0] is the start of the data */
+    Int ncards [3]      /* number of lines in each section */
+) ;
+
+PRIVATE Int RB(mapfile)   /* TRUE if the file is mapped, FALSE otherwise */
+(
+    char *filename,     /* file to map, with a valid header */
+    RBmap *map
+) ;
+
+PRIVATE void RB(unmapfile)
+(
+    RBmap *map
+) ;
+#endif
+
 PRIVATE Int RB(zcount)    /* return number of explicit zeros in A */
 (
     Int nnz,            /* number of entries to check */
@@ -459,6 +549,7 @@ PRIVATE Int RB(read2)   /* 0: OK, < 0: error, > 0: warning */
 (
     /* input */
     FILE *file,         /* must be already open for reading */
+    RBmap *map,         /* if not NULL, read from the mapped file instead */
     Int nrow,           /* A is nrow-by-ncol */
     Int ncol,
     Int nnz,            /* number of entries in A, from the header */
@@ -483,7 +574,7 @@ PRIVATE Int RB(read2)   /* 0: OK, < 0: error, > 0: warning */
 )
 {
     double xr = 0, xz = 0 ;
-    Int p, i, j, k, ilast, alen, llen, psrc, pdst ;
+    Int p, i, j, k, ilast, alen, llen, psrc, pdst, ok ;
 
     /* ---------------------------------------------------------------------- */
     /* skip past the header, if reading from a file */
@@ -498,9 +589,11 @@ PRIVATE Int RB(read2)   /* 0: OK, < 0: error, > 0: warning */
     /* read the column pointers and check them */
     /* ---------------------------------------------------------------------- */
 
-    if (!RB(iread) (file, ncol+1, 1, Ap, s, slen))
+    if (map ? !RB(pread) (map, 0, ncol+1, 0, 1, Ap, NULL, NULL)
+            : !RB(iread) (file, ncol+1, 1, Ap, s, slen))
     {
-        return (RBIO_CP_IOERROR) ;      /* I/O error reading column pointers */
+        /* I/O error reading column pointers */
+        return (map ? RBIO_NOMAP : RBIO_CP_IOERROR) ;
     }
     if (Ap [0] != 0 || Ap [ncol] != nnz)
     {
@@ -518,9 +611,11 @@ PRIVATE Int RB(read2)   /* 0: OK, < 0: error, > 0: warning */
     /* read the row indices and check them */
     /* ---------------------------------------------------------------------- */
 
-    if (!RB(iread) (file, nnz, 1, Ai, s, slen))
+    if (map ? !RB(pread) (map, 1, nnz, 0, 1, Ai, NULL, NULL)
+            : !RB(iread) (file, nnz, 1, Ai, s, slen))
     {
-        return (RBIO_ROW_IOERROR) ;       /* I/O error reading row indices */
+        /* I/O error reading row indices */
+        return (map ? RBIO_NOMAP : RBIO_ROW_IOERROR) ;
     }
 
     for (i = 0 ; i < nrow ; i++)
@@ -555,9 +650,29 @@ PRIVATE Int RB(read2)   /* 0: OK, < 0: error, > 0: warning */
     /* read the values */
     /* ---------------------------------------------------------------------- */
 
-    if (!RB(xread) (file, nnz, mkind, Ax, Az, s, slen))
+    if (map == NULL)
     {
-        return (RBIO_VALUE_IOERROR) ;     /* I/O error reading values */
+        ok = RB(xread) (file, nnz, mkind, Ax, Az, s, slen) ;
+    }
+    else if (mkind == 1)
+    {
+        /* pattern-only: the values are not read */
+        for (p = 0 ; p < nnz ; p++)
+        {
+            RB(put_entry) (mkind, Ax, Az, p, 1, 0) ;
+        }
+        ok = TRUE ;
+    }
+    else
+    {
+        /* real, integer, or complex (2 values per entry) */
+        ok = RB(pread) (map, 2, ((mkind == 2 || mkind == 4) ? 2 : 1) * nnz,
+            (mkind == 2) ? 2 : 1, 0, NULL, Ax, Az) ;
+    }
+    if (!ok)
+    {
+        /* I/O error reading values */
+        return (map ? RBIO_NOMAP : RBIO_VALUE_IOERROR) ;
     }
 
     /* ---------------------------------------------------------------------- */
@@ -1308,6 +1423,447 @@ PRIVATE Int RB(xread)     /* TRUE if OK, FALSE otherwise */
 }
 
 
+/* ========================================================================== */
+/* === memory-mapped parallel parser ======================================== */
+/* ========================================================================== */
+
+/* On POSIX systems, RBread and RBreadraw map the file into memory and parse
+   its column pointers, row indices, and numerical values in parallel.  The
+   three sections are located with the card counts on the second line of the
+   header, and each section is split into chunks of whole lines.  The tokens
+   in each chunk are counted, and then all the chunks are parsed concurrently
+   directly into their final positions.
+
+   The result is the same as the sequential parser (RBiread and RBxread).  If
+   the file does not follow its card counts exactly, or if a token in the
+   data cannot be parsed, the memory-mapped parser gives up and the file is
+   read again with the sequential parser.
+*/
+
+/* -------------------------------------------------------------------------- */
+/* RBptoken: parse a single token */
+/* -------------------------------------------------------------------------- */
+
+PRIVATE Int RB(ptoken)    /* TRUE if token is a number, FALSE otherwise */
+(
+    /* input */
+    const char *t,      /* token to parse, not null-terminated */
+    size_t len,         /* length of the token */
+
+    /* output */
+    double *x           /* value of the token */
+)
+{
+    char s [64], *end ;
+    double v = 0 ;
+    size_t k ;
+
+    /* fast path: an integer with at most 15 digits is parsed exactly */
+    k = (t [0] == '-' || t [0] == '+') ? 1 : 0 ;
+    if (k < len && len - k <= 15)
+    {
+        for ( ; k < len && t [k] >= '0' && t [k] <= '9' ; k++)
+        {
+            v = 10 * v + (t [k] - '0') ;
+        }
+        if (k == len)
+        {
+            *x = (t [0] == '-') ? (-v) : v ;
+            return (TRUE) ;
+        }
+    }
+
+    /* any other token is parsed in the same way as sscanf with "%lg" */
+    if (len >= sizeof (s)) return (FALSE) ;
+    memcpy (s, t, len) ;
+    s [len] = '\0' ;
+    *x = strtod (s, &end) ;
+    return (end != s) ;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* RBpcount: count the tokens in a chunk */
+/* -------------------------------------------------------------------------- */
+
+PRIVATE Int RB(pcount)    /* return number of tokens in x [0..len-1] */
+(
+    const char *x,
+    size_t len
+)
+{
+    Int n = 0, in = FALSE ;
+    size_t k ;
+    for (k = 0 ; k < len ; k++)
+    {
+        if (ISSEP (x [k]))
+        {
+            in = FALSE ;
+        }
+        else if (!in)
+        {
+            in = TRUE ;
+            n++ ;
+        }
+    }
+    return (n) ;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* RBpparse: parse the tokens in a chunk */
+/* -------------------------------------------------------------------------- */
+
+PRIVATE Int RB(pparse)    /* TRUE if OK, FALSE otherwise */
+(
+    /* input */
+    const char *x,      /* chunk to parse, x [0..len-1] */
+    size_t len,
+    Int t,              /* index of the first token of the chunk */
+    Int n,              /* tokens n and higher are ignored */
+    Int kind,           /* 0: integers, 1: reals, 2: split-complex */
+    Int offset,         /* offset to subtract from each integer */
+
+    /* output */
+    Int *A,             /* integers, if kind is 0 */
+    double *Ax,         /* reals, or real parts if kind is 2 */
+    double *Az          /* imaginary parts, if kind is 2 */
+)
+{
+    double v ;
+    size_t k = 0, start ;
+    Int i ;
+
+    while (t < n)
+    {
+        /* find the next token */
+        while (k < len && ISSEP (x [k])) k++ ;
+        if (k >= len) break ;
+        start = k ;
+        while (k < len && !ISSEP (x [k])) k++ ;
+
+        /* parse it and store it as the tth token of the section */
+        if (!RB(ptoken) (x + start, k - start, &v)) return (FALSE) ;
+        if (kind == 0)
+        {
+            /* same integer overflow check as RBitoken */
+            i = (Int) v ;
+            if ((double) (i+1) != (v+1)) return (FALSE) ;
+            A [t] = i - offset ;
+        }
+        else if (kind == 1)
+        {
+            Ax [t] = v ;
+        }
+        else if (t % 2 == 0)
+        {
+            Ax [t/2] = v ;
+        }
+        else
+        {
+            Az [t/2] = v ;
+        }
+        t++ ;
+    }
+    return (TRUE) ;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* RBpread: read n tokens from a section of a mapped file, in parallel */
+/* -------------------------------------------------------------------------- */
+
+PRIVATE Int RB(pread)     /* TRUE if OK, FALSE otherwise */
+(
+    /* input */
+    RBmap *map,         /* the mapped file */
+    Int section,        /* 0: column pointers, 1: row indices, 2: values */
+    Int n,              /* number of tokens to read */
+    Int kind,           /* 0: integers, 1: reals, 2: split-complex */
+    Int offset,         /* offset to subtract from each integer */
+
+    /* output */
+    Int *A,             /* size n, if kind is 0 */
+    double *Ax,         /* size n if kind is 1, n/2 if kind is 2 */
+    double *Az          /* size n/2 if kind is 2 */
+)
+{
+    const char *x ;
+    size_t len, last, p, *Start ;
+    Int k, ntasks, nlast, total, *Count, ok = TRUE ;
+
+    x = map->x + map->sec [section] ;
+    len = map->sec [section+1] - map->sec [section] ;
+    if (n <= 0 || len == 0) return (FALSE) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* split the section into chunks of whole lines */
+    /* ---------------------------------------------------------------------- */
+
+    ntasks = (Int) MIN (len / RBIO_CHUNK + 1, 8 * (size_t) map->nthreads) ;
+    Start = (size_t *) SuiteSparse_malloc (ntasks+1, sizeof (size_t)) ;
+    Count = (Int *) SuiteSparse_malloc (ntasks+1, sizeof (Int)) ;
+    if (Start == NULL || Count == NULL)
+    {
+        SuiteSparse_free (Start) ;
+        SuiteSparse_free (Count) ;
+        return (FALSE) ;
+    }
+    Start [0] = 0 ;
+    for (k = 1 ; k < ntasks ; k++)
+    {
+        p = MAX (Start [k-1], (len / ntasks) * k) ;
+        while (p > 0 && p < len && x [p-1] != '\n') p++ ;
+        Start [k] = p ;
+    }
+    Start [ntasks] = len ;
+
+    /* ---------------------------------------------------------------------- */
+    /* count the tokens in each chunk */
+    /* ---------------------------------------------------------------------- */
+
+    #pragma omp parallel for num_threads(map->nthreads) schedule(dynamic,1)
+    for (k = 0 ; k < ntasks ; k++)
+    {
+        Count [k] = RB(pcount) (x + Start [k], Start [k+1] - Start [k]) ;
+    }
+    total = 0 ;
+    for (k = 0 ; k < ntasks ; k++)
+    {
+        p = Count [k] ;
+        Count [k] = total ;     /* Count [k] is now the first token of chunk k*/
+        total += p ;
+    }
+
+    /* the nth token must be on the last line of the section, which is where
+       the sequential parser would stop */
+    last = len ;
+    if (x [last-1] == '\n') last-- ;
+    while (last > 0 && x [last-1] != '\n') last-- ;
+    nlast = RB(pcount) (x + last, len - last) ;
+    ok = (total >= n && total - nlast < n) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* parse all the chunks */
+    /* ---------------------------------------------------------------------- */
+
+    if (ok)
+    {
+        #pragma omp parallel for num_threads(map->nthreads) \
+            schedule(dynamic,1) reduction(&&:ok)
+        for (k = 0 ; k < ntasks ; k++)
+        {
+            ok = ok && RB(pparse) (x + Start [k], Start [k+1] - Start [k],
+                Count [k], n, kind, offset, A, Ax, Az) ;
+        }
+    }
+
+    SuiteSparse_free (Start) ;
+    SuiteSparse_free (Count) ;
+    return (ok) ;
+}
+
+
+#ifdef RBIO_MMAP
+
+/* -------------------------------------------------------------------------- */
+/* RBplines: find the start of the sections of a mapped file */
+/* -------------------------------------------------------------------------- */
+
+PRIVATE Int RB(plines)    /* TRUE if OK, FALSE if the file is too short */
+(
+    /* input/output */
+    RBmap *map,         /* on input, map->sec [0] is the start of the data */
+
+    /* input */
+    Int ncards [3]      /* number of lines in each section */
+)
+{
+    const char *x, *q, *qend ;
+    size_t len, p, *Start ;
+    Int k, s, n, ntasks, line, target, *Lines, ok = TRUE ;
+
+    x = map->x + map->sec [0] ;
+    len = map->size - map->sec [0] ;
+
+    /* ---------------------------------------------------------------------- */
+    /* count the lines in each chunk of the data, in parallel */
+    /* ---------------------------------------------------------------------- */
+
+    ntasks = (Int) MIN (len / RBIO_CHUNK + 1, 8 * (size_t) map->nthreads) ;
+    Start = (size_t *) SuiteSparse_malloc (ntasks+1, sizeof (size_t)) ;
+    Lines = (Int *) SuiteSparse_malloc (ntasks+1, sizeof (Int)) ;
+    if (Start == NULL || Lines == NULL)
+    {
+        SuiteSparse_free (Start) ;
+        SuiteSparse_free (Lines) ;
+        return (FALSE) ;
+    }
+    for (k = 0 ; k <= ntasks ; k++)
+    {
+        Start [k] = (k == ntasks) ? len : ((len / ntasks) * k) ;
+    }
+
+    #pragma omp parallel for num_threads(map->nthreads) schedule(dynamic,1) \
+        private(q,qend)
+    for (k = 0 ; k < ntasks ; k++)
+    {
+        Lines [k] = 0 ;
+        qend = x + Start [k+1] ;
+        for (q = x + Start [k] ; q < qend &&
+            (q = memchr (q, '\n', qend - q)) != NULL ; q++)
+        {
+            Lines [k]++ ;
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* find the first byte after the last line of each section */
+    /* ---------------------------------------------------------------------- */
+
+    k = 0 ;
+    line = 0 ;                  /* # of lines in chunks 0 to k-1 */
+    target = 0 ;
+    for (s = 1 ; ok && s <= 3 ; s++)
+    {
+        if (ncards [s-1] <= 0)
+        {
+            /* empty section */
+            map->sec [s] = map->sec [s-1] ;
+            continue ;
+        }
+        target += ncards [s-1] ;
+        while (k < ntasks && line + Lines [k] < target)
+        {
+            line += Lines [k++] ;
+        }
+        if (k == ntasks)
+        {
+            /* an unterminated last line of the file ends the last section */
+            ok = (target == line + 1 && len > 0 && x [len-1] != '\n') ;
+            map->sec [s] = map->size ;
+        }
+        else
+        {
+            /* the section ends in chunk k, after its (target-line)th line */
+            for (p = Start [k], n = line ; n < target ; p++)
+            {
+                if (x [p] == '\n') n++ ;
+            }
+            map->sec [s] = map->sec [0] + p ;
+        }
+    }
+
+    SuiteSparse_free (Start) ;
+    SuiteSparse_free (Lines) ;
+    return (ok) ;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* RBmapfile: map a Rutherford/Boeing file into memory */
+/* -------------------------------------------------------------------------- */
+
+PRIVATE Int RB(mapfile)   /* TRUE if the file is mapped, FALSE otherwise */
+(
+    /* input */
+    char *filename,     /* file to map, with a valid header */
+
+    /* output */
+    RBmap *map
+)
+{
+    struct stat st ;
+    void *x0 ;
+    const char *x ;
+    double v = 0 ;
+    size_t p, len, start ;
+    Int k, ncards [4], ok = TRUE ;
+    int fd ;
+
+    /* ---------------------------------------------------------------------- */
+    /* map the file, if it is a regular file */
+    /* ---------------------------------------------------------------------- */
+
+    map->x = NULL ;
+    fd = open (filename, O_RDONLY) ;
+    if (fd < 0) return (FALSE) ;
+    if (fstat (fd, &st) != 0 || !S_ISREG (st.st_mode) || st.st_size <= 0)
+    {
+        close (fd) ;
+        return (FALSE) ;
+    }
+    map->size = (size_t) st.st_size ;
+    x0 = mmap (NULL, map->size, PROT_READ, MAP_PRIVATE, fd, 0) ;
+    close (fd) ;
+    if (x0 == MAP_FAILED) return (FALSE) ;
+    map->x = (char *) x0 ;
+#ifdef _OPENMP
+    map->nthreads = omp_get_max_threads ( ) ;
+#else
+    map->nthreads = 1 ;
+#endif
+    x = map->x ;
+    len = map->size ;
+
+    /* ---------------------------------------------------------------------- */
+    /* get totcrd, ptrcrd, indcrd, and valcrd from the 2nd header line */
+    /* ---------------------------------------------------------------------- */
+
+    for (p = 0 ; p < len && x [p] != '\n' ; p++) ;
+    p++ ;
+    for (k = 0 ; ok && k < 4 ; k++)
+    {
+        while (p < len && x [p] == ' ') p++ ;
+        start = p ;
+        while (p < len && !ISSEP (x [p])) p++ ;
+        ok = (p > start) && RB(ptoken) (x + start, p - start, &v) ;
+        ncards [k] = (Int) v ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* skip the rest of the header, as RBskipheader does */
+    /* ---------------------------------------------------------------------- */
+
+    for (k = 0 ; k < 3 ; k++)
+    {
+        while (p < len && x [p] != '\n') p++ ;
+        p++ ;
+    }
+    if (p < len && (x [p] == 'F' || x [p] == 'f' || x [p] == 'M' ||
+        x [p] == 'm'))
+    {
+        while (p < len && x [p] != '\n') p++ ;
+        p++ ;
+    }
+    map->sec [0] = p ;
+
+    /* ---------------------------------------------------------------------- */
+    /* find the three sections */
+    /* ---------------------------------------------------------------------- */
+
+    ok = ok && (p < len) && RB(plines) (map, ncards + 1) ;
+    if (!ok) RB(unmapfile) (map) ;
+    return (ok) ;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* RBunmapfile: unmap a file mapped by RBmapfile */
+/* -------------------------------------------------------------------------- */
+
+PRIVATE void RB(unmapfile)
+(
+    RBmap *map
+)
+{
+    if (map->x != NULL) munmap (map->x, map->size) ;
+    map->x = NULL ;
+}
+
+#endif
+
+
 /* -------------------------------------------------------------------------- */
 /* RBread: read a Rutherford/Boeing matrix from a file */
 /* -------------------------------------------------------------------------- */
@@ -1373,6 +1929,9 @@ PUBLIC Int RB(read)              /* 0: OK, < 0: error, > 0: warning */
     Int *w, *cp, *Ap, *Ai, *Zp, *Zi ;
     double *Ax, *Az ;
     FILE *file = NULL ;     /* read from stdin if NULL */
+#ifdef RBIO_MMAP
+    RBmap map ;
+#endif
     int ok ;
     char s [SLEN+1], ptrfmt [21], indfmt [21], valfmt [21] ;
 
@@ -1495,20 +2054,36 @@ PUBLIC Int RB(read)              /* 0: OK, < 0: error, > 0: warning */
     /* read the matrix */
     /* ---------------------------------------------------------------------- */
 
-    if (filename)
+    status = RBIO_NOMAP ;
+
+#ifdef RBIO_MMAP
+    if (filename && RB(mapfile) (filename, &map))
     {
-        file = fopen (filename, "r") ;
-        if (file == NULL)
+        /* parse the mapped file in parallel */
+        status = RB(read2) (NULL, &map, *nrow, *ncol, nnz, *mkind, *skind,
+            build_upper, Ap, Ai, Ax, Az, w, cp, s, SLEN) ;
+        RB(unmapfile) (&map) ;
+    }
+#endif
+
+    if (status == RBIO_NOMAP)
+    {
+        /* read the file with stdio */
+        if (filename)
         {
-            FREE_ALL ;
-            return (RBIO_FILE_IOERROR) ;      /* cannot reopen file */
+            file = fopen (filename, "r") ;
+            if (file == NULL)
+            {
+                FREE_ALL ;
+                return (RBIO_FILE_IOERROR) ;      /* cannot reopen file */
+            }
         }
-    }
 
-    status = RB(read2) (file, *nrow, *ncol, nnz, *mkind, *skind, build_upper,
-        Ap, Ai, Ax, Az, w, cp, s, SLEN) ;
+        status = RB(read2) (file, NULL, *nrow, *ncol, nnz, *mkind, *skind,
+            build_upper, Ap, Ai, Ax, Az, w, cp, s, SLEN) ;
 
-    if (filename) fclose (file) ;
+        if (filename) fclose (file) ;
+    }
 
     if (status != 0)
     {
@@ -1596,6 +2171,9 @@ PUBLIC Int RB(readraw)           /* 0: OK, < 0: error, > 0: warning */
     Int *Ap, *Ai ;
     double *Ax ;
     Int status ;
+#ifdef RBIO_MMAP
+    RBmap map ;
+#endif
     int ok ;
     char s [SLEN+1], ptrfmt [21], indfmt [21], valfmt [21] ;
 
@@ -1670,6 +2248,25 @@ PUBLIC Int RB(readraw)           /* 0: OK, < 0: error, > 0: warning */
     /* read the matrix */
     /* ---------------------------------------------------------------------- */
 
+#ifdef RBIO_MMAP
+    if (filename && RB(mapfile) (filename, &map))
+    {
+        /* parse the mapped file in parallel */
+        ok = RB(pread) (&map, 0, (*ncol)+1, 0, 1, Ap, NULL, NULL)
+          && RB(pread) (&map, 1, *nnz, 0, 1, Ai, NULL, NULL)
+          && (*mkind == 1 || RB(pread) (&map, 2, *xsize, 1, 0, NULL, Ax, NULL));
+        RB(unmapfile) (&map) ;
+        if (ok)
+        {
+            *p_Ap = Ap ;
+            *p_Ai = Ai ;
+            *p_Ax = Ax ;
+            return (RBIO_OK) ;
+        }
+        /* otherwise, read the file again with stdio */
+    }
+#endif
+
     if (filename)
     {
         file = fopen (filename, "r") ;
@@ -2019,6 +2616,315 @@ PUBLIC Int RB(write)         /* 0:OK, < 0: error, > 0: warning */
 }
 
 
+/* -------------------------------------------------------------------------- */
+/* RBwrite_stream: write a matrix one column at a time */
+/* -------------------------------------------------------------------------- */
+
+/* The matrix is never held in memory.  Instead, get_column (j, Ci, Cx, Cz,
+   user) is called to obtain column j, and returns the number of entries in
+   that column (or a negative value if an error occurs).  The row indices Ci
+   must be in ascending order and must not contain duplicates.  Cx holds the
+   real part and Cz the imaginary part (complex matrices only); Cx and Cz are
+   not used for a pattern-only matrix.  Each column is requested three times:
+   once to count the entries, once to write the row indices, and once to write
+   the numerical values.  The column must be the same each time.  For a
+   symmetric, Hermitian, or skew-symmetric matrix, entries in the strictly
+   upper triangular part are ignored.  Only O(nrow+ncol) workspace is used.
+
+   Unlike RBwrite, the matrix type (RUA, CSA, PRA, etc) is given on input,
+   since it cannot be determined without holding the whole matrix.
+*/
+
+PUBLIC Int RB(write_stream)  /* 0:OK, < 0: error, > 0: warning */
+(
+    /* input */
+    char *filename, /* filename to write to (stdout if NULL) */
+    char *title,    /* title (72 char max), may be NULL */
+    char *key,      /* key (8 char max), may be NULL */
+    char *mtype,    /* matrix type: RUA, RSA, PRA, CHA, IUA, etc */
+    Int nrow,       /* A is nrow-by-ncol */
+    Int ncol,
+    Int (*get_column) (Int j, Int *Ci, double *Cx, double *Cz, void *user),
+    void *user      /* passed to get_column, not otherwise used */
+)
+{
+    double xmin, xmax ;
+    double *Cx, *Cz ;
+    Int *Ci, *cp ;
+    FILE *file = NULL ;     /* write to stdout if NULL */
+    Int mkind, skind, nnz2, vals, valn, indn, ptrn, valcrd, indcrd, ptrcrd,
+        totcrd, fmt, nbuf, i, j, k, ilast, cnz, task, nelnz = 0 ;
+    int ok ;
+    char indfmt [21], indcfm [21], valfmt [21], valcfm [21], ptrfmt [21],
+        ptrcfm [21], mtype2 [4] ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    if (!mtype || !get_column)
+    {
+        /* one or more required arguments are missing (NULL) */
+        return (RBIO_ARG_ERROR) ;
+    }
+
+    switch (tolower (mtype [0]))
+    {
+        case 'r': mkind = 0 ; break ;       /* real */
+        case 'p': mkind = 1 ; break ;       /* pattern */
+        case 'c': mkind = 2 ; break ;       /* complex (split) */
+        case 'i': mkind = 3 ; break ;       /* integer */
+        default:  return (RBIO_TYPE_INVALID) ;
+    }
+    switch (tolower (mtype [1]))
+    {
+        case 'r': skind = -1 ; break ;      /* rectangular */
+        case 'u': skind =  0 ; break ;      /* unsymmetric */
+        case 's': skind =  1 ; break ;      /* symmetric */
+        case 'h': skind =  2 ; break ;      /* Hermitian */
+        case 'z': skind =  3 ; break ;      /* skew symmetric */
+        default:  return (RBIO_TYPE_INVALID) ;
+    }
+    if (tolower (mtype [2]) != 'a')
+    {
+        /* finite-element matrices cannot be written */
+        return (RBIO_TYPE_INVALID) ;
+    }
+    if (nrow < 0 || ncol < 0 || (skind >= 0 && nrow != ncol))
+    {
+        return (RBIO_DIM_INVALID) ;
+    }
+    mtype2 [0] = tolower (mtype [0]) ;
+    mtype2 [1] = tolower (mtype [1]) ;
+    mtype2 [2] = 'a' ;
+    mtype2 [3] = '\0' ;
+
+    /* ---------------------------------------------------------------------- */
+    /* clear the format strings */
+    /* ---------------------------------------------------------------------- */
+
+    RB(fill) (valfmt, 20, ' ') ;
+    RB(fill) (valcfm, 20, ' ') ;
+    RB(fill) (indfmt, 20, ' ') ;
+    RB(fill) (indcfm, 20, ' ') ;
+    RB(fill) (ptrfmt, 20, ' ') ;
+    RB(fill) (ptrcfm, 20, ' ') ;
+    indn = 0 ;
+    valn = 0 ;
+    ptrn = 0 ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate workspace */
+    /* ---------------------------------------------------------------------- */
+
+    Ci = SuiteSparse_malloc (nrow + 1, sizeof (Int)) ;
+    Cx = SuiteSparse_malloc (nrow + 1, sizeof (double)) ;
+    Cz = SuiteSparse_malloc (nrow + 1, sizeof (double)) ;
+    cp = SuiteSparse_malloc (ncol + 1, sizeof (Int)) ;
+    if (Ci == NULL || Cx == NULL || Cz == NULL || cp == NULL)
+    {
+        FREE_STREAM ;
+        return (RBIO_OUT_OF_MEMORY) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* count the entries and find the format for the numerical values */
+    /* ---------------------------------------------------------------------- */
+
+    fmt = 0 ;
+    xmin = 0 ;
+    xmax = 0 ;
+    cp [0] = 0 ;
+    for (j = 0 ; j < ncol ; j++)
+    {
+        cnz = get_column (j, Ci, Cx, Cz, user) ;
+        if (cnz < 0 || cnz > nrow)
+        {
+            /* the column could not be obtained */
+            FREE_STREAM ;
+            return (RBIO_ARG_ERROR) ;
+        }
+        nnz2 = 0 ;
+        ilast = -1 ;
+        for (k = 0 ; k < cnz ; k++)
+        {
+            i = Ci [k] ;
+            if (i < 0 || i >= nrow)
+            {
+                FREE_STREAM ;
+                return (RBIO_ROW_INVALID) ;
+            }
+            if (i <= ilast)
+            {
+                FREE_STREAM ;
+                return ((i == ilast) ? RBIO_DUPLICATE : RBIO_JUMBLED) ;
+            }
+            ilast = i ;
+            if (skind > 0 && i < j) continue ;
+            if (mkind == 3)
+            {
+                xmin = (nnz2 + cp [j] == 0) ? Cx [k] : MIN (xmin, Cx [k]) ;
+                xmax = (nnz2 + cp [j] == 0) ? Cx [k] : MAX (xmax, Cx [k]) ;
+            }
+            /* keep the entries of the lower triangular part in place */
+            if (mkind != 1) Cx [nnz2] = Cx [k] ;
+            if (mkind == 2) Cz [nnz2] = Cz [k] ;
+            nnz2++ ;
+        }
+        if (mkind == 0 || mkind == 2)
+        {
+            /* widen the format as needed for the real part of A(:,j) */
+            fmt = RB(format) (nnz2, Cx, FALSE, 0, 0, fmt, valfmt, valcfm,
+                &valn) ;
+        }
+        if (mkind == 2)
+        {
+            /* likewise for the imaginary part */
+            fmt = RB(format) (nnz2, Cz, FALSE, 0, 0, fmt, valfmt, valcfm,
+                &valn) ;
+        }
+        cp [j+1] = cp [j] + nnz2 ;
+    }
+    nnz2 = cp [ncol] ;
+    if (nnz2 <= 0)
+    {
+        FREE_STREAM ;
+        return (RBIO_DIM_INVALID) ;   /* matrix has no entries to print */
+    }
+
+    if (mkind == 3)
+    {
+        /* A is integer: the format depends only on the range of values */
+        RB(format) (0, NULL, TRUE, xmin, xmax, 0, valfmt, valcfm, &valn) ;
+    }
+
+    /* determine pointer format.  ncol+1 integers, in range 1 to nnz2+1 */
+    RB(iformat) (1, nnz2+1, ptrfmt, ptrcfm, &ptrn) ;
+    ptrcrd = RB(cards) (ncol+1, ptrn) ;
+
+    /* determine row index format.  nnz2 integers, in range 1 to nrow */
+    RB(iformat) (1, nrow, indfmt, indcfm, &indn) ;
+    indcrd = RB(cards) (nnz2, indn) ;
+
+    /* determine how many lines for the numerical values */
+    vals = (mkind == 1) ? 0 : ((mkind == 2) ? 2 : 1) ;
+    valcrd = RB(cards) (vals*nnz2, valn) ;
+    totcrd = ptrcrd + indcrd + valcrd ;
+
+    /* ---------------------------------------------------------------------- */
+    /* open the file */
+    /* ---------------------------------------------------------------------- */
+
+    if (filename)
+    {
+        file = fopen (filename, "w") ;
+        if (file == NULL)
+        {
+            FREE_STREAM ;
+            return (RBIO_FILE_IOERROR) ;      /* cannot open file */
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* write the header */
+    /* ---------------------------------------------------------------------- */
+
+    ok = fprintf (file ? file : stdout, "%-71.71s|%-8.8s\n",
+        title ? title : "", key ? key : "") > 0;
+    ok = ok && fprintf (file ? file : stdout,
+        "%14" IDD "%14" IDD "%14" IDD "%14" IDD "\n",
+        totcrd, ptrcrd, indcrd, valcrd) > 0 ;
+    ok = ok && fprintf (file ? file : stdout,
+        "%3s           %14" IDD "%14" IDD "%14" IDD "%14" IDD "\n",
+        mtype2, nrow, ncol, nnz2, nelnz) > 0 ;
+    ok = ok && fprintf (file ? file : stdout, "%.16s%.16s%.20s\n",
+        ptrfmt, indfmt, valfmt) > 0 ;
+    if (!ok)
+    {
+        /* file I/O error */
+        FREE_STREAM ;
+        if (filename) fclose (file) ;
+        return (RBIO_HEADER_IOERROR) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* write the column pointers (convert to 1-based) */
+    /* ---------------------------------------------------------------------- */
+
+    nbuf = 0 ;
+    for (j = 0 ; ok && j <= ncol ; j++)
+    {
+        ok = RB(iprint) (file, ptrcfm, 1+ cp [j], ptrn, &nbuf) ;
+    }
+    ok = ok && fprintf (file ? file : stdout, "\n") > 0 ;
+    if (!ok)
+    {
+        /* file I/O error */
+        FREE_STREAM ;
+        if (filename) fclose (file) ;
+        return (RBIO_CP_IOERROR) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* write the row indices (task 2) and the numerical values (task 3) */
+    /* ---------------------------------------------------------------------- */
+
+    for (task = 2 ; ok && task <= ((mkind == 1) ? 2 : 3) ; task++)
+    {
+        nbuf = 0 ;
+        for (j = 0 ; ok && j < ncol ; j++)
+        {
+            cnz = get_column (j, Ci, Cx, Cz, user) ;
+            nnz2 = 0 ;
+            for (k = 0 ; ok && k < cnz && k < nrow ; k++)
+            {
+                i = Ci [k] ;
+                if (skind > 0 && i < j) continue ;
+                nnz2++ ;
+                if (task == 2)
+                {
+                    /* printing the row indices (convert to 1-based) */
+                    ok = RB(iprint) (file, indcfm, 1+ i, indn, &nbuf) ;
+                }
+                else
+                {
+                    /* printing the numerical values */
+                    ok = RB(xprint) (file, valcfm, Cx [k], valn, mkind, &nbuf);
+                    if (ok && mkind == 2)
+                    {
+                        ok = RB(xprint) (file, valcfm, Cz [k], valn, mkind,
+                            &nbuf) ;
+                    }
+                }
+            }
+            if (nnz2 != cp [j+1] - cp [j])
+            {
+                /* get_column returned a different column than before */
+                FREE_STREAM ;
+                if (filename) fclose (file) ;
+                return (RBIO_ARG_ERROR) ;
+            }
+        }
+        ok = ok && fprintf (file ? file : stdout, "\n") > 0 ;
+        if (!ok)
+        {
+            /* file I/O error */
+            FREE_STREAM ;
+            if (filename) fclose (file) ;
+            return ((task == 2) ? RBIO_ROW_IOERROR : RBIO_VALUE_IOERROR) ;
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* free workspace and close the file */
+    /* ---------------------------------------------------------------------- */
+
+    FREE_STREAM ;
+    if (filename) fclose (file) ;
+    return (RBIO_OK) ;
+}
+
+
 /* -------------------------------------------------------------------------- */
 /* RBkind: determine the type of a sparse matrix */
 /* -------------------------------------------------------------------------- */
@@ -2402,7 +3308,8 @@ PRIVATE Int RB(format)  /* return format to use (index in F_, C_format) */
         /* find the required precision for a real or complex matrix */
         /* ------------------------------------------------------------------ */
 
-        fmt = 0 ;
+        /* start with the initial format, which is never narrowed */
+        fmt = MAX (fmt, 0) ;
         for (i = 0 ; i < nnz ; i++)
         {
 
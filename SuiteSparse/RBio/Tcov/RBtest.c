@@ -11,6 +11,133 @@
 
 #define SLEN 4096
 
+/* -------------------------------------------------------------------------- */
+/* same: return 1 if two arrays are identical, 0 otherwise */
+/* -------------------------------------------------------------------------- */
+
+static int same (void *a, void *b, Long n, size_t size)
+{
+    if (n <= 0) return (1) ;
+    if (a == NULL || b == NULL) return (a == b) ;
+    return (memcmp (a, b, n * size) == 0) ;
+}
+
+/* -------------------------------------------------------------------------- */
+/* same_file: return 1 if two files are identical, 0 otherwise */
+/* -------------------------------------------------------------------------- */
+
+static int same_file (char *filename1, char *filename2)
+{
+    FILE *f1, *f2 ;
+    int c1, c2 ;
+    f1 = fopen (filename1, "r") ;
+    f2 = fopen (filename2, "r") ;
+    if (f1 == NULL || f2 == NULL)
+    {
+        if (f1) fclose (f1) ;
+        if (f2) fclose (f2) ;
+        return (0) ;
+    }
+    do
+    {
+        c1 = getc (f1) ;
+        c2 = getc (f2) ;
+    }
+    while (c1 == c2 && c1 != EOF) ;
+    fclose (f1) ;
+    fclose (f2) ;
+    return (c1 == c2) ;
+}
+
+/* -------------------------------------------------------------------------- */
+/* read_both: read a file with the memory-mapped and the stdio parsers */
+/* -------------------------------------------------------------------------- */
+
+/* RBread (filename, ...) maps the file, and falls back to stdio if the mapped
+   parser fails.  RBread (NULL, ...) reads stdin with stdio only.  Both must
+   give the same status and the same matrix.  Returns 1 if OK, 0 otherwise. */
+
+static int read_both (char *filename)
+{
+    double *Ax, *Az, *Ax2, *Az2 ;
+    Long nrow, ncol, mkind, skind, asize, znz, *Ap, *Ai, *Zp, *Zi, status,
+        nrow2, ncol2, mkind2, skind2, asize2, znz2, *Ap2, *Ai2, *Zp2, *Zi2,
+        status2, nz ;
+    int ok ;
+    char title [73], key [9], mtype [4], title2 [73], key2 [9], mtype2 [4] ;
+
+    status = RBread (filename, 1, 2, title, key, mtype,
+        &nrow, &ncol, &mkind, &skind, &asize, &znz,
+        &Ap, &Ai, &Ax, &Az, &Zp, &Zi) ;
+
+    if (freopen (filename, "r", stdin) == NULL) return (0) ;
+    status2 = RBread (NULL, 1, 2, title2, key2, mtype2,
+        &nrow2, &ncol2, &mkind2, &skind2, &asize2, &znz2,
+        &Ap2, &Ai2, &Ax2, &Az2, &Zp2, &Zi2) ;
+
+    ok = (status == status2) ;
+    if (ok && status == RBIO_OK)
+    {
+        ok = (nrow == nrow2 && ncol == ncol2 && mkind == mkind2 &&
+            skind == skind2 && asize == asize2 && znz == znz2 &&
+            strcmp (title, title2) == 0 && strcmp (key, key2) == 0 &&
+            strcmp (mtype, mtype2) == 0) ;
+        nz = ok ? Ap [ncol] : 0 ;
+        ok = ok && same (Ap, Ap2, ncol+1, sizeof (Long))
+                && same (Ai, Ai2, nz, sizeof (Long))
+                && same (Ax, Ax2, (mkind == 1) ? 0 : nz, sizeof (double))
+                && same (Az, Az2, (mkind == 2) ? nz : 0, sizeof (double))
+                && same (Zp, Zp2, ncol+1, sizeof (Long))
+                && same (Zi, Zi2, Zp [ncol], sizeof (Long)) ;
+    }
+
+    SuiteSparse_free (Ap) ;
+    SuiteSparse_free (Ai) ;
+    SuiteSparse_free (Ax) ;
+    SuiteSparse_free (Az) ;
+    SuiteSparse_free (Zp) ;
+    SuiteSparse_free (Zi) ;
+    SuiteSparse_free (Ap2) ;
+    SuiteSparse_free (Ai2) ;
+    SuiteSparse_free (Ax2) ;
+    SuiteSparse_free (Az2) ;
+    SuiteSparse_free (Zp2) ;
+    SuiteSparse_free (Zi2) ;
+    return (ok) ;
+}
+
+/* -------------------------------------------------------------------------- */
+/* get_column: return a column of a sparse matrix, for RBwrite_stream */
+/* -------------------------------------------------------------------------- */
+
+typedef struct
+{
+    Long *Ap, *Ai ;         /* the matrix, in compressed-column form */
+    double *Ax, *Az ;
+    Long error ;            /* 0: none, else the kind of error to make */
+    Long ncalls ;           /* number of calls to get_column so far */
+}
+column_source ;
+
+static Long get_column (Long j, Long *Ci, double *Cx, double *Cz, void *user)
+{
+    column_source *A = (column_source *) user ;
+    Long p, k = 0 ;
+    A->ncalls++ ;
+    if (A->error == 1) return (-1) ;        /* column cannot be obtained */
+    for (p = A->Ap [j] ; p < A->Ap [j+1] ; p++, k++)
+    {
+        Ci [k] = A->Ai [p] ;
+        if (A->Ax) Cx [k] = A->Ax [p] ;
+        if (A->Az) Cz [k] = A->Az [p] ;
+    }
+    if (k >= 2 && A->error == 2) Ci [0] = Ci [1] ;      /* duplicate */
+    if (k >= 2 && A->error == 3) Ci [0] = Ci [1] + 1 ;  /* jumbled */
+    if (k >= 1 && A->error == 4) Ci [k-1] = -1 ;         /* out of range */
+    if (k >= 1 && A->error == 5 && A->ncalls > 1) k-- ; /* column changes */
+    return (k) ;
+}
+
 int main (int argc, char **argv)
 {
     double xr, xz, xmin, xmax ;
@@ -20,6 +147,14 @@ int main (int argc, char **argv)
         xsize, nelnz, nnz, kk, anz ;
     int ok ;
     char title [73], key [9], mtype [4], mtype2 [4], *filename, s [100], *As ;
+    double *Bx, *Bz ;
+    Long *Bp, *Bi, n, bnz ;
+    column_source src ;
+    FILE *f ;
+    char *files [ ] = { "matrices/m4.rb", "matrices/s4.rb", "matrices/m4b.rb",
+        "../RBio/private/bcsstk01.rb", "../RBio/private/farm.rb",
+        "../RBio/private/lap_25.pse", "../RBio/private/lap_25.rb",
+        "../RBio/private/west0479.rb", "../RBio/private/west0479.rua", NULL } ;
 
     /* initialize the memory allocation functions */
     SuiteSparse_start ( ) ;
@@ -279,6 +414,279 @@ int main (int argc, char **argv)
     }
     SuiteSparse_free (As) ;
 
+    SuiteSparse_free (Ap) ;
+    SuiteSparse_free (Ai) ;
+    SuiteSparse_free (Ax) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* memory-mapped reader: compare with the stdio reader */
+    /* ---------------------------------------------------------------------- */
+
+    for (kk = 0 ; files [kk] != NULL ; kk++)
+    {
+        if (!read_both (files [kk]))
+        {
+            printf ("RBtest failure (23) %s\n", files [kk]) ;
+            return (1) ;
+        }
+    }
+    for (kk = 1 ; kk <= 15 ; kk++)
+    {
+        /* the mapped parser falls back to stdio, with the same status */
+        sprintf (s, "mangled/" ID ".rb", kk) ;
+        if (!read_both (s))
+        {
+            printf ("RBtest failure (24) %s\n", s) ;
+            return (1) ;
+        }
+    }
+
+    /* wrong card counts: the mapped parser falls back to stdio */
+    f = fopen ("temp_cards.rb", "w") ;
+    if (f == NULL)
+    {
+        printf ("RBtest failure (25)\n") ;
+        return (1) ;
+    }
+    fprintf (f, "%-72s%-8s\n", "m4 with wrong card counts", "cards") ;
+    fprintf (f, "             4             2             1             1\n"
+        "iua                        4             4            16             0\n"
+        "(26I3)          (40I2)          (26I3)              \n"
+        "  1  5  9 13 17\n"
+        " 1 2 3 4 1 2 3 4 1 2 3 4 1 2 3 4\n"
+        "  0  5  9  4  2 11  7 14  3 10  6 15 13  8 12  1\n") ;
+    fclose (f) ;
+    status = RBread ("temp_cards.rb", 0, 0, title, key, mtype,
+        &nrow, &ncol, &mkind, &skind, &asize, &znz,
+        &Ap, &Ai, &Ax, NULL, NULL, NULL) ;
+    ok = (status == RBIO_OK && nrow == 4 && ncol == 4 && Ap [4] == 16 &&
+        Ax [1] == 5 && Ax [15] == 1) ;
+    SuiteSparse_free (Ap) ;
+    SuiteSparse_free (Ai) ;
+    SuiteSparse_free (Ax) ;
+    if (!ok || !read_both ("temp_cards.rb"))
+    {
+        printf ("RBtest failure (26) "ID"\n", status) ;
+        return (1) ;
+    }
+
+    /* a bad token: both parsers fail */
+    f = fopen ("temp_token.rb", "w") ;
+    if (f == NULL)
+    {
+        printf ("RBtest failure (27)\n") ;
+        return (1) ;
+    }
+    fprintf (f, "%-72s%-8s\n", "m4 with a bad value", "token") ;
+    fprintf (f, "             3             1             1             1\n"
+        "iua                        4             4            16             0\n"
+        "(26I3)          (40I2)          (26I3)              \n"
+        "  1  5  9 13 17\n"
+        " 1 2 3 4 1 2 3 4 1 2 3 4 1 2 3 4\n"
+        "  0  5  9  4  2 11  7 14  3 10  6 15 13  8 12 x1\n") ;
+    fclose (f) ;
+    status = RBread ("temp_token.rb", 0, 0, title, key, mtype,
+        &nrow, &ncol, &mkind, &skind, &asize, &znz,
+        &Ap, &Ai, &Ax, NULL, NULL, NULL) ;
+    if (status != RBIO_VALUE_IOERROR || !read_both ("temp_token.rb"))
+    {
+        printf ("RBtest failure (28) "ID"\n", status) ;
+        return (1) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* RBwrite_stream: compare with RBwrite */
+    /* ---------------------------------------------------------------------- */
+
+    src.Az = NULL ;
+    src.error = 0 ;
+    for (kk = 0 ; files [kk] != NULL ; kk++)
+    {
+        status = RBread (files [kk], 1, 0, title, key, mtype,
+            &nrow, &ncol, &mkind, &skind, &asize, &znz,
+            &Ap, &Ai, &Ax, &Az, NULL, NULL) ;
+        if (status != RBIO_OK) continue ;       /* lap_25.pse */
+        status = RBwrite ("temp_w.rb", title, key, nrow, ncol, Ap, Ai, Ax,
+            Az, NULL, NULL, mkind, mtype2) ;
+        src.Ap = Ap ;
+        src.Ai = Ai ;
+        src.Ax = Ax ;
+        src.Az = Az ;
+        if (status != RBIO_OK || RBwrite_stream ("temp_s.rb", title, key,
+            mtype2, nrow, ncol, get_column, &src) != RBIO_OK ||
+            !same_file ("temp_w.rb", "temp_s.rb"))
+        {
+            printf ("RBtest failure (29) %s "ID"\n", files [kk], status) ;
+            return (1) ;
+        }
+        SuiteSparse_free (Ap) ;
+        SuiteSparse_free (Ai) ;
+        SuiteSparse_free (Ax) ;
+        SuiteSparse_free (Az) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* large matrix: several chunks for the mapped reader */
+    /* ---------------------------------------------------------------------- */
+
+    /* B = tridiagonal, with values that need the widest format */
+    n = 100000 ;
+    Bp = (Long *) SuiteSparse_malloc (n+1, sizeof (Long)) ;
+    Bi = (Long *) SuiteSparse_malloc (3*n, sizeof (Long)) ;
+    Bx = (double *) SuiteSparse_malloc (3*n, sizeof (double)) ;
+    if (Bp == NULL || Bi == NULL || Bx == NULL)
+    {
+        printf ("RBtest failure (30)\n") ;
+        return (1) ;
+    }
+    bnz = 0 ;
+    for (j = 0 ; j < n ; j++)
+    {
+        Bp [j] = bnz ;
+        for (i = (j > 0) ? (j-1) : 0 ; i <= j+1 && i < n ; i++)
+        {
+            Bi [bnz] = i ;
+            Bx [bnz++] = 1. / (double) (i + 2*j + 3) ;
+        }
+    }
+    Bp [n] = bnz ;
+    src.Ap = Bp ;
+    src.Ai = Bi ;
+    src.Ax = Bx ;
+    src.Az = NULL ;
+    status = RBwrite_stream ("temp_big.rb", "tridiagonal", "big", "rua", n, n,
+        get_column, &src) ;
+    if (status != RBIO_OK || !read_both ("temp_big.rb"))
+    {
+        printf ("RBtest failure (31) "ID"\n", status) ;
+        return (1) ;
+    }
+    status = RBread ("temp_big.rb", 0, 0, title, key, mtype,
+        &nrow, &ncol, &mkind, &skind, &asize, &znz,
+        &Ap, &Ai, &Ax, NULL, NULL, NULL) ;
+    ok = (status == RBIO_OK && nrow == n && ncol == n &&
+        same (Ap, Bp, n+1, sizeof (Long)) &&
+        same (Ai, Bi, bnz, sizeof (Long)) &&
+        same (Ax, Bx, bnz, sizeof (double))) ;
+    SuiteSparse_free (Ap) ;
+    SuiteSparse_free (Ai) ;
+    SuiteSparse_free (Ax) ;
+    if (!ok || RBwrite ("temp_w.rb", "tridiagonal", "big", n, n, Bp, Bi, Bx,
+        NULL, NULL, NULL, 0, mtype2) != RBIO_OK ||
+        !same_file ("temp_w.rb", "temp_big.rb"))
+    {
+        printf ("RBtest failure (32) "ID"\n", status) ;
+        return (1) ;
+    }
+    SuiteSparse_free (Bp) ;
+    SuiteSparse_free (Bi) ;
+    SuiteSparse_free (Bx) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* RBformat: the imaginary part cannot narrow the format of the real part */
+    /* ---------------------------------------------------------------------- */
+
+    status = RBread ("matrices/m4.rb", 0, 0, title, key, mtype,
+        &nrow, &ncol, &mkind, &skind, &asize, &znz,
+        &Ap, &Ai, &Bx, NULL, NULL, NULL) ;
+    Ax = (double *) SuiteSparse_malloc (16, sizeof (double)) ;
+    Az = (double *) SuiteSparse_malloc (16, sizeof (double)) ;
+    if (status != RBIO_OK || Ax == NULL || Az == NULL)
+    {
+        printf ("RBtest failure (33) "ID"\n", status) ;
+        return (1) ;
+    }
+    for (p = 0 ; p < 16 ; p++)
+    {
+        Ax [p] = 1. / (double) (p + 3) ;    /* needs the widest format */
+        Az [p] = Bx [p] ;                   /* small integers */
+    }
+    SuiteSparse_free (Bx) ;
+    src.Ap = Ap ;
+    src.Ai = Ai ;
+    src.Ax = Ax ;
+    src.Az = Az ;
+    for (kk = 0 ; kk < 2 ; kk++)
+    {
+        status = (kk == 0) ?
+            RBwrite ("temp_c.rb", "complex", "cplx", 4, 4, Ap, Ai, Ax, Az,
+                NULL, NULL, 2, mtype2) :
+            RBwrite_stream ("temp_c.rb", "complex", "cplx", mtype2, 4, 4,
+                get_column, &src) ;
+        if (status != RBIO_OK)
+        {
+            printf ("RBtest failure (34) "ID" "ID"\n", status, kk) ;
+            return (1) ;
+        }
+        status = RBread ("temp_c.rb", 0, 0, title, key, mtype,
+            &nrow, &ncol, &mkind, &skind, &asize, &znz,
+            &Zp, &Zi, &Bx, &Bz, NULL, NULL) ;
+        ok = (status == RBIO_OK && mkind == 2 && same (Zp, Ap, 5, sizeof (Long))
+            && same (Zi, Ai, 16, sizeof (Long))
+            && same (Bx, Ax, 16, sizeof (double))
+            && same (Bz, Az, 16, sizeof (double))) ;
+        SuiteSparse_free (Zp) ;
+        SuiteSparse_free (Zi) ;
+        SuiteSparse_free (Bx) ;
+        SuiteSparse_free (Bz) ;
+        if (!ok)
+        {
+            printf ("RBtest failure (35) "ID" "ID"\n", status, kk) ;
+            return (1) ;
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* RBwrite_stream: error handling */
+    /* ---------------------------------------------------------------------- */
+
+    ok = 1 ;
+    ok = ok && RBwrite_stream ("temp.rb", NULL, NULL, NULL, 4, 4,
+        get_column, &src) == RBIO_ARG_ERROR ;
+    ok = ok && RBwrite_stream ("temp.rb", NULL, NULL, "cua", 4, 4,
+        NULL, &src) == RBIO_ARG_ERROR ;
+    ok = ok && RBwrite_stream ("temp.rb", NULL, NULL, "xua", 4, 4,
+        get_column, &src) == RBIO_TYPE_INVALID ;
+    ok = ok && RBwrite_stream ("temp.rb", NULL, NULL, "cxa", 4, 4,
+        get_column, &src) == RBIO_TYPE_INVALID ;
+    ok = ok && RBwrite_stream ("temp.rb", NULL, NULL, "cue", 4, 4,
+        get_column, &src) == RBIO_TYPE_INVALID ;
+    ok = ok && RBwrite_stream ("temp.rb", NULL, NULL, "csa", 4, 3,
+        get_column, &src) == RBIO_DIM_INVALID ;
+    ok = ok && RBwrite_stream ("gunk/gunk.rb", NULL, NULL, "cua", 4, 4,
+        get_column, &src) == RBIO_FILE_IOERROR ;
+    ok = ok && RBwrite_stream ("temp.rb", NULL, NULL, "cra", 3, 4,
+        get_column, &src) == RBIO_ARG_ERROR ;
+    src.error = 1 ;
+    ok = ok && RBwrite_stream ("temp.rb", NULL, NULL, "cua", 4, 4,
+        get_column, &src) == RBIO_ARG_ERROR ;
+    src.error = 2 ;
+    ok = ok && RBwrite_stream ("temp.rb", NULL, NULL, "cua", 4, 4,
+        get_column, &src) == RBIO_DUPLICATE ;
+    src.error = 3 ;
+    ok = ok && RBwrite_stream ("temp.rb", NULL, NULL, "cua", 4, 4,
+        get_column, &src) == RBIO_JUMBLED ;
+    src.error = 4 ;
+    ok = ok && RBwrite_stream ("temp.rb", NULL, NULL, "cua", 4, 4,
+        get_column, &src) == RBIO_ROW_INVALID ;
+    src.error = 5 ;
+    src.ncalls = 0 ;
+    ok = ok && RBwrite_stream ("temp.rb", NULL, NULL, "cua", 4, 4,
+        get_column, &src) == RBIO_ARG_ERROR ;
+    src.error = 0 ;
+    for (j = 0 ; j <= 4 ; j++) Ap [j] = 0 ;
+    ok = ok && RBwrite_stream ("temp.rb", NULL, NULL, "cua", 4, 4,
+        get_column, &src) == RBIO_DIM_INVALID ;
+    if (!ok)
+    {
+        printf ("RBtest failure (36)\n") ;
+        return (1) ;
+    }
+    SuiteSparse_free (Ap) ;
+    SuiteSparse_free (Ai) ;
+    SuiteSparse_free (Ax) ;
+    SuiteSparse_free (Az) ;
+
     printf ("RBtest OK\n") ;
     SuiteSparse_finish ( ) ;
     return (0) ;
@@ -0,0 +1,189 @@
+// =============================================================================
+// === qrbatch_bench.cpp =======================================================
+// =============================================================================
+
+// Benchmark for SuiteSparseQR_batch, on a batch of least-squares problems that
+// all have the nonzero pattern of the input matrix A, with random values.
+// The batch is solved with a loop of calls to SuiteSparseQR, and then with
+// SuiteSparseQR_batch with and without same_pattern, with one thread and with
+// nthreads threads.  For each, the run time, the number of calls to malloc
+// per problem, and the difference from the solutions of the loop are printed.
+//
+// Usage:  qrbatch_bench nbatch nrhs nthreads < Matrix_in_MatrixMarket_format
+//
+// nbatch defaults to 1000, nrhs to 1, and nthreads to 4.
+
+#include "SuiteSparseQR.hpp"
+#include <stdlib.h>
+#include <math.h>
+
+#define Long SuiteSparse_long
+
+// =============================================================================
+// counting_malloc:  malloc, counting the number of calls
+// =============================================================================
+
+static Long nmalloc = 0 ;
+static void *(*system_malloc) (size_t) ;
+
+static void *counting_malloc (size_t size)
+{
+    #pragma omp atomic
+    nmalloc++ ;
+    return (system_malloc (size)) ;
+}
+
+// =============================================================================
+// next_random:  uniform in [-1,1]
+// =============================================================================
+
+static double next_random (unsigned long *seed)
+{
+    *seed = *seed * 1103515245 + 12345 ;
+    return (((double) ((*seed / 65536) % 32768)) / 16383.5 - 1) ;
+}
+
+// =============================================================================
+// qrbatch_bench main program
+// =============================================================================
+
+int main (int argc, char **argv)
+{
+    cholmod_common Common, *cc ;
+    cholmod_sparse *A0, **A ;
+    cholmod_dense **B, **X, **X0 ;
+    int mtype, nfail = 0 ;
+    unsigned long seed = 42 ;
+
+    Long nbatch = (argc > 1) ? atol (argv [1]) : 1000 ;
+    Long nrhs = (argc > 2) ? atol (argv [2]) : 1 ;
+    int nthreads = (argc > 3) ? atoi (argv [3]) : 4 ;
+    nbatch = (nbatch < 1) ? 1 : nbatch ;
+    nrhs = (nrhs < 1) ? 1 : nrhs ;
+
+    // start CHOLMOD
+    cc = &Common ;
+    cholmod_l_start (cc) ;
+
+    // load A0; only its pattern is used
+    A0 = (cholmod_sparse *) cholmod_l_read_matrix (stdin, 1, &mtype, cc) ;
+    if (A0 == NULL || A0->stype != 0)
+    {
+        printf ("qrbatch_bench: A must be an unsymmetric sparse matrix\n") ;
+        cholmod_l_free_sparse (&A0, cc) ;
+        cholmod_l_finish (cc) ;
+        return (0) ;
+    }
+    Long m = A0->nrow, n = A0->ncol, anz = cholmod_l_nnz (A0, cc) ;
+    printf ("qrbatch_bench: m %ld n %ld nnz %ld nbatch %ld nrhs %ld"
+        " nthreads %d\n", m, n, anz, nbatch, nrhs, nthreads) ;
+
+    // A [k] has the pattern of A0, and random values; B [k] is random
+    A  = (cholmod_sparse **) cholmod_l_malloc (nbatch,
+        sizeof (cholmod_sparse *), cc) ;
+    B  = (cholmod_dense **) cholmod_l_malloc (nbatch, sizeof (cholmod_dense *),
+        cc) ;
+    X  = (cholmod_dense **) cholmod_l_malloc (nbatch, sizeof (cholmod_dense *),
+        cc) ;
+    X0 = (cholmod_dense **) cholmod_l_malloc (nbatch, sizeof (cholmod_dense *),
+        cc) ;
+    if (cc->status < CHOLMOD_OK)
+    {
+        printf ("qrbatch_bench: out of memory\n") ;
+        return (1) ;
+    }
+    for (Long k = 0 ; k < nbatch ; k++)
+    {
+        A [k] = cholmod_l_allocate_sparse (m, n, anz, 1, 1, 0,
+            CHOLMOD_REAL, cc) ;
+        B [k] = cholmod_l_allocate_dense (m, nrhs, m, CHOLMOD_REAL, cc) ;
+        if (cc->status < CHOLMOD_OK)
+        {
+            printf ("qrbatch_bench: out of memory\n") ;
+            return (1) ;
+        }
+        Long *Ap = (Long *) A [k]->p, *Ai = (Long *) A [k]->i ;
+        double *Ax = (double *) A [k]->x, *Bx = (double *) B [k]->x ;
+        for (Long j = 0 ; j <= n ; j++) Ap [j] = ((Long *) A0->p) [j] ;
+        for (Long p = 0 ; p < anz ; p++)
+        {
+            Ai [p] = ((Long *) A0->i) [p] ;
+            Ax [p] = next_random (&seed) ;
+        }
+        for (Long i = 0 ; i < m*nrhs ; i++) Bx [i] = next_random (&seed) ;
+    }
+
+    // count the calls to malloc
+    system_malloc = SuiteSparse_config.malloc_func ;
+    SuiteSparse_config.malloc_func = counting_malloc ;
+
+    printf ("\n                         threads     time  mallocs/problem"
+        "     diff\n") ;
+
+    for (int trial = 0 ; trial < 5 ; trial++)
+    {
+        // trial 0: SuiteSparseQR, 1,2: batch with 1 thread, 3,4: nthreads
+        int same_pattern = (trial == 2 || trial == 4) ;
+        int nt = (trial <= 2) ? 1 : nthreads ;
+        cc->SPQR_nthreads = nt ;
+        nmalloc = 0 ;
+        double t0 = SuiteSparse_time ( ) ;
+        if (trial == 0)
+        {
+            for (Long k = 0 ; k < nbatch ; k++)
+            {
+                X0 [k] = SuiteSparseQR <double> (SPQR_ORDERING_DEFAULT,
+                    SPQR_DEFAULT_TOL, A [k], B [k], cc) ;
+            }
+        }
+        else
+        {
+            SuiteSparseQR_batch <double> (SPQR_ORDERING_DEFAULT,
+                SPQR_DEFAULT_TOL, same_pattern, nbatch, A, B, X, cc) ;
+        }
+        double t = SuiteSparse_time ( ) - t0 ;
+
+        // compare with the solutions from SuiteSparseQR
+        double err = 0 ;
+        for (Long k = 0 ; trial > 0 && k < nbatch ; k++)
+        {
+            if (X [k] == NULL || X0 [k] == NULL)
+            {
+                err = -1 ;
+                break ;
+            }
+            double *x = (double *) X [k]->x, *x0 = (double *) X0 [k]->x ;
+            double xnorm = cholmod_l_norm_dense (X0 [k], 0, cc), e = 0 ;
+            for (Long i = 0 ; i < n*nrhs ; i++)
+            {
+                e = fmax (e, fabs (x [i] - x0 [i])) ;
+            }
+            err = fmax (err, (xnorm > 0) ? (e / xnorm) : e) ;
+            cholmod_l_free_dense (&X [k], cc) ;
+        }
+        if (err < 0 || err > 1e-8) nfail++ ;
+
+        printf ("%-24s %7d %8.3f %16.1f %8.1e%s\n",
+            (trial == 0) ? "SuiteSparseQR" : (same_pattern ?
+            "batch, same_pattern" : "batch"), nt, t,
+            (double) nmalloc / (double) nbatch, err,
+            (err < 0 || err > 1e-8) ? " FAIL" : "") ;
+    }
+
+    SuiteSparse_config.malloc_func = system_malloc ;
+
+    // free everything and finish CHOLMOD
+    for (Long k = 0 ; k < nbatch ; k++)
+    {
+        cholmod_l_free_sparse (&A [k], cc) ;
+        cholmod_l_free_dense (&B [k], cc) ;
+        cholmod_l_free_dense (&X0 [k], cc) ;
+    }
+    cholmod_l_free (nbatch, sizeof (cholmod_sparse *), A, cc) ;
+    cholmod_l_free (nbatch, sizeof (cholmod_dense *), B, cc) ;
+    cholmod_l_free (nbatch, sizeof (cholmod_dense *), X, cc) ;
+    cholmod_l_free (nbatch, sizeof (cholmod_dense *), X0, cc) ;
+    cholmod_l_free_sparse (&A0, cc) ;
+    cholmod_l_finish (cc) ;
+    return (nfail > 0) ;
+}
@@ -0,0 +1,156 @@
+// =============================================================================
+// === qrbench.cpp =============================================================
+// =============================================================================
+
+// Benchmark for applying Q to a dense matrix with many columns, using both
+// forms of SuiteSparseQR_qmult (the QR object from SuiteSparseQR_factorize,
+// and the Householder vectors H from SuiteSparseQR), for all four methods:
+// Q'*X, Q*X, X*Q', and X*Q.  Each is done with one thread, and then with
+// nthreads threads (Common->SPQR_nthreads), and the results are compared.
+//
+// Usage:  qrbench nrhs nthreads < Matrix_in_MatrixMarket_format
+//
+// nrhs defaults to 500 and nthreads to 4.  The QR object is analyzed with
+// Common->SPQR_grain = 2*nthreads so that it has a task tree.
+
+#include "SuiteSparseQR.hpp"
+#include <stdlib.h>
+#include <math.h>
+
+#define Long SuiteSparse_long
+
+// =============================================================================
+// random_dense:  a dense m-by-n matrix with entries uniform in [-1,1]
+// =============================================================================
+
+cholmod_dense *random_dense (Long m, Long n, cholmod_common *cc)
+{
+    cholmod_dense *X = cholmod_l_allocate_dense (m, n, m, CHOLMOD_REAL, cc) ;
+    if (X == NULL) return (NULL) ;
+    double *Xx = (double *) X->x ;
+    unsigned long seed = 42 ;
+    for (Long k = 0 ; k < m*n ; k++)
+    {
+        seed = seed * 1103515245 + 12345 ;
+        Xx [k] = ((double) ((seed / 65536) % 32768)) / 16383.5 - 1 ;
+    }
+    return (X) ;
+}
+
+// =============================================================================
+// diff_dense:  norm (Y1-Y2,1) / norm (Y1,1)
+// =============================================================================
+
+double diff_dense (cholmod_dense *Y1, cholmod_dense *Y2, cholmod_common *cc)
+{
+    if (Y1 == NULL || Y2 == NULL) return (-1) ;
+    double *x1 = (double *) Y1->x, *x2 = (double *) Y2->x, err = 0 ;
+    for (Long k = 0 ; k < (Long) (Y1->nrow * Y1->ncol) ; k++)
+    {
+        double e = fabs (x1 [k] - x2 [k]) ;
+        if (e > err) err = e ;
+    }
+    double ynorm = cholmod_l_norm_dense (Y1, 0, cc) ;
+    return ((ynorm > 0) ? (err / ynorm) : err) ;
+}
+
+// =============================================================================
+// qrbench main program
+// =============================================================================
+
+int main (int argc, char **argv)
+{
+    cholmod_common Common, *cc ;
+    cholmod_sparse *A, *H = NULL, *R = NULL ;
+    cholmod_dense *HTau = NULL, *X [2], *Y [2] ;
+    SuiteSparseQR_factorization <double> *QR ;
+    Long *HPinv = NULL, *E = NULL ;
+    int mtype ;
+    const char *name [4] = { "Q'*X", "Q*X ", "X*Q'", "X*Q " } ;
+
+    Long nrhs = (argc > 1) ? atol (argv [1]) : 500 ;
+    int nthreads = (argc > 2) ? atoi (argv [2]) : 4 ;
+
+    // start CHOLMOD
+    cc = &Common ;
+    cholmod_l_start (cc) ;
+
+    // load A
+    A = (cholmod_sparse *) cholmod_l_read_matrix (stdin, 1, &mtype, cc) ;
+    if (A == NULL || A->xtype != CHOLMOD_REAL)
+    {
+        printf ("qrbench: A must be a real sparse matrix\n") ;
+        cholmod_l_free_sparse (&A, cc) ;
+        cholmod_l_finish (cc) ;
+        return (0) ;
+    }
+    Long m = A->nrow ;
+    printf ("qrbench: m %ld n %ld nnz %ld nrhs %ld nthreads %d\n",
+        m, (Long) A->ncol, (Long) cholmod_l_nnz (A, cc), nrhs, nthreads) ;
+
+    // QR object, with a task tree
+    cc->SPQR_grain = 2 * nthreads ;
+    cc->SPQR_nthreads = nthreads ;
+    QR = SuiteSparseQR_factorize <double> (SPQR_ORDERING_DEFAULT,
+        SPQR_DEFAULT_TOL, A, cc) ;
+    printf ("tasks in task tree: %ld\n", cc->SPQR_istat [3]) ;
+
+    // [Q,R,E] = qr (A), with Q in Householder form
+    SuiteSparseQR <double> (SPQR_ORDERING_DEFAULT, SPQR_DEFAULT_TOL, m, A,
+        &R, &E, &H, &HPinv, &HTau, cc) ;
+
+    if (QR == NULL || H == NULL)
+    {
+        printf ("qrbench: QR factorization failed\n") ;
+    }
+    else
+    {
+        // X is m-by-nrhs for methods 0 and 1, and nrhs-by-m for 2 and 3
+        X [0] = random_dense (m, nrhs, cc) ;
+        X [1] = random_dense (nrhs, m, cc) ;
+
+        printf ("\n          ---- QR object ----------   "
+            "---- H, HTau, HPinv ------\n") ;
+        printf ("method    1 thread  %2d thread    diff   "
+            "1 thread  %2d thread    diff\n", nthreads, nthreads) ;
+
+        for (int method = 0 ; method <= 3 ; method++)
+        {
+            cholmod_dense *Xin = X [method <= SPQR_QX ? 0 : 1] ;
+            double t [2][2], err [2] ;
+            for (int form = 0 ; form <= 1 ; form++)
+            {
+                for (int k = 0 ; k <= 1 ; k++)
+                {
+                    cc->SPQR_nthreads = (k == 0) ? 1 : nthreads ;
+                    double t0 = SuiteSparse_time ( ) ;
+                    Y [k] = (form == 0) ?
+                        SuiteSparseQR_qmult <double> (method, QR, Xin, cc) :
+                        SuiteSparseQR_qmult <double> (method, H, HTau, HPinv,
+                            Xin, cc) ;
+                    t [form][k] = SuiteSparse_time ( ) - t0 ;
+                }
+                err [form] = diff_dense (Y [0], Y [1], cc) ;
+                cholmod_l_free_dense (&Y [0], cc) ;
+                cholmod_l_free_dense (&Y [1], cc) ;
+            }
+            printf ("%s   %9.3f %9.3f %9.1e  %9.3f %9.3f %9.1e\n",
+                name [method], t [0][0], t [0][1], err [0],
+                t [1][0], t [1][1], err [1]) ;
+        }
+
+        cholmod_l_free_dense (&X [0], cc) ;
+        cholmod_l_free_dense (&X [1], cc) ;
+    }
+
+    // free everything and finish CHOLMOD
+    SuiteSparseQR_free <double> (&QR, cc) ;
+    cholmod_l_free_sparse (&R, cc) ;
+    cholmod_l_free_sparse (&H, cc) ;
+    cholmod_l_free_dense (&HTau, cc) ;
+    cholmod_l_free (A->ncol, sizeof (Long), E, cc) ;
+    cholmod_l_free (m, sizeof (Long), HPinv, cc) ;
+    cholmod_l_free_sparse (&A, cc) ;
+    cholmod_l_finish (cc) ;
+    return (0) ;
+}
@@ -197,11 +197,20 @@ struct spqr_symbolic
 
     // This is NULL if the GPU is not in use.  The GPU must be enabled at
     // compile time (-DGPU_BLAS enables the GPU).  If the Householder vectors
-    // are requested, if TBB is used (Common->SPQR_grain > 1), or if rank
+    // are requested, if OpenMP tasks are used (Common->SPQR_grain > 1), or if rank
     // detection is requested, then the GPU is disabled.
 
     spqr_gpu *QRgpu ;
 
+    // -------------------------------------------------------------------------
+    // regularization
+    // -------------------------------------------------------------------------
+
+    int regularize ;    // TRUE: S = [A ; lambda*I] (P,Q), where the last n
+                        // rows of [A ; lambda*I] are implicit and lambda is
+                        // given to the numeric factorization.  m includes
+                        // these n rows, and anz includes their n entries.
+
 } ;
 
 
@@ -341,6 +350,48 @@ template <typename Entry> struct SuiteSparseQR_factorization
     int allow_tol ;     // if TRUE, do rank detection
 } ;
 
+// =============================================================================
+// === SuiteSparseQR_rowfactorization ==========================================
+// =============================================================================
+
+// A Q-less QR factorization [C,R] with R held in row form, for appending rows
+// to A and B with SuiteSparseQR_rowupdate.  Row i of R is in
+// Rowi/Rowx [Rowp [i] ... Rowp [i]+Rowlen [i]-1], in no particular order of
+// rows, and row i of C is in Cw [i*nrhs ... i*nrhs+nrhs-1].
+
+template <typename Entry> struct SuiteSparseQR_rowfactorization
+{
+    double tol ;                 // rank tolerance, or SPQR_DEFAULT_TOL
+    double norm ;                // bound on the max column 2-norm of R, for
+                                 // the default tol
+    SuiteSparse_long m ;         // rows of R on input, plus all rows appended
+    SuiteSparse_long e ;         // number of rows of R on input
+    SuiteSparse_long n ;         // number of columns of R
+    SuiteSparse_long nrhs ;      // number of columns of C; 0 if no C
+
+    SuiteSparse_long nrow ;      // number of rows of R in the pool
+    SuiteSparse_long nrowmax ;   // size of Rowp and Rowlen
+    SuiteSparse_long *Rowp ;     // size nrowmax, start of each row of R
+    SuiteSparse_long *Rowlen ;   // size nrowmax, length of each row of R
+    Entry *Cw ;                  // size nrowmax*nrhs, rows of C
+
+    SuiteSparse_long poolsize ;  // size of Rowi and Rowx
+    SuiteSparse_long pool ;      // Rowi/Rowx [0:pool-1] are in use
+    SuiteSparse_long rnz ;       // entries in the rows of R (pool - garbage)
+    SuiteSparse_long *Rowi ;     // column indices of the rows of R
+    Entry *Rowx ;                // numerical values of the rows of R
+
+    // workspace, kept clear between calls
+    SuiteSparse_long *Lead ;     // size n, Lead [j] = row of R leading in
+                                 // column j, or EMPTY
+    SuiteSparse_long *Einv ;     // size n, inverse of E
+    SuiteSparse_long *Heap ;     // size n, pattern of a new row
+    SuiteSparse_long *Flag ;     // size n, pattern of a row of R
+    SuiteSparse_long stamp ;     // mark for Flag
+    Entry *W ;                   // size n, all zero
+    char *Mark ;                 // size n, all zero
+} ;
+
 
 // =============================================================================
 // === Simple user-callable SuiteSparseQR functions ============================
@@ -460,6 +511,65 @@ template <typename Entry> SuiteSparse_long SuiteSparseQR
     cholmod_common *cc      // workspace and parameters
 ) ;
 
+// [C,R] = qr([R ; A2*E], [C ; B2]): update [C,R,E] = qr(A,B) from above when
+// rows A2 and B2 are appended to A and B, discarding Q.  C may be NULL.
+template <typename Entry> int SuiteSparseQR_rowupdate
+    // returns TRUE if successful, FALSE otherwise
+(
+    // inputs, not modified
+    double tol,             // rank tolerance for new rows of R
+    cholmod_sparse *A2,     // k-by-n sparse matrix of new rows of A
+    cholmod_dense  *B2,     // k-by-nrhs dense matrix of new rows of B
+    SuiteSparse_long *E,    // permutation of 0:n-1, NULL if identity
+    // input/output
+    cholmod_sparse **R,     // e-by-n sparse matrix, replaced with updated R
+    cholmod_dense  **C,     // e-by-nrhs dense matrix, replaced with updated C
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+// The same update, with R and C held in row form between calls, so that the
+// time for each update depends on the fill of the new rows, not on nnz(R).
+// SuiteSparseQR_rowupdate_start copies R and C (or R alone if C is NULL) into
+// a new object, SuiteSparseQR_rowupdate appends rows to it, and
+// SuiteSparseQR_rowupdate_get returns the current R and C.
+template <typename Entry>
+SuiteSparseQR_rowfactorization <Entry> *SuiteSparseQR_rowupdate_start
+(
+    // inputs, not modified
+    double tol,             // rank tolerance for new rows of R
+    cholmod_sparse *R,      // e-by-n sparse matrix R
+    cholmod_dense  *C,      // e-by-nrhs dense matrix C, or NULL
+    SuiteSparse_long *E,    // permutation of 0:n-1, NULL if identity
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+template <typename Entry> int SuiteSparseQR_rowupdate
+    // returns TRUE if successful, FALSE otherwise
+(
+    // inputs, not modified
+    cholmod_sparse *A2,     // k-by-n sparse matrix of new rows of A
+    cholmod_dense  *B2,     // k-by-nrhs dense matrix of new rows of B
+    // input/output
+    SuiteSparseQR_rowfactorization <Entry> *RF,
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+template <typename Entry> int SuiteSparseQR_rowupdate_get
+(
+    // input, not modified
+    SuiteSparseQR_rowfactorization <Entry> *RF,
+    // outputs
+    cholmod_sparse **R,     // the e-by-n sparse matrix R
+    cholmod_dense  **C,     // the e-by-nrhs dense matrix C, or NULL
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+template <typename Entry> int SuiteSparseQR_rowupdate_free
+(
+    SuiteSparseQR_rowfactorization <Entry> **RF,
+    cholmod_common *cc
+) ;
+
 // [C,R,E] = qr(A,B), where C and B are sparse
 template <typename Entry> SuiteSparse_long SuiteSparseQR
 (
@@ -548,6 +658,20 @@ SuiteSparseQR_factorization <Entry> *SuiteSparseQR_factorize
     cholmod_common *cc
 ) ;
 
+// QR factorization of [A ; lambda*I] without forming it; no singletons.
+// Q is (m+n)-by-(m+n), so Q'*[B ; zeros(n,nrhs)] is needed for a solve.
+template <typename Entry>
+SuiteSparseQR_factorization <Entry> *SuiteSparseQR_factorize
+(
+    // inputs, not modified:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // treat columns with 2-norm <= tol as zero
+    double lambda,          // regularization parameter
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
 template <typename Entry> cholmod_dense *SuiteSparseQR_solve    // returns X
 (
     // inputs, not modified:
@@ -639,6 +763,54 @@ template <typename Entry> int SuiteSparseQR_numeric
     cholmod_common *cc      // workspace and parameters
 ) ;
 
+// symbolic QR factorization of [A ; lambda*I] (if regularize is TRUE), for
+// any lambda given later to SuiteSparseQR_numeric; no singletons exploited
+template <typename Entry>
+SuiteSparseQR_factorization <Entry> *SuiteSparseQR_symbolic
+(
+    // inputs:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    int allow_tol,          // if FALSE, tol is ignored by the numeric
+                            // factorization, and no rank detection is performed
+    int regularize,         // if TRUE, analyze [A ; lambda*I] instead of A
+    cholmod_sparse *A,      // sparse matrix to factorize (A->x ignored)
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+// numeric QR factorization of [A ; lambda*I]; lambda must be zero unless
+// the QR object was analyzed with regularize TRUE
+template <typename Entry> int SuiteSparseQR_numeric
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    double lambda,          // regularization parameter
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <Entry> *QR,
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+// X [k] = A [k] \ B [k] for k = 0:nbatch-1, for many small independent
+// problems, solved in parallel.  If same_pattern is TRUE, the pattern of A [0]
+// is analyzed just once, and the analysis is shared by all the threads for all
+// A [k] with that pattern.  Each thread reuses its workspace from one problem
+// to the next.
+template <typename Entry> int SuiteSparseQR_batch
+    // returns TRUE if all problems solved, FALSE otherwise
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol treated as zero
+    int same_pattern,       // if TRUE, the problems share the pattern of A [0]
+    SuiteSparse_long nbatch,    // number of problems
+    cholmod_sparse **A,     // size nbatch; A [k] is m(k)-by-n(k)
+    cholmod_dense **B,      // size nbatch; B [k] is m(k)-by-nrhs(k)
+    // output
+    cholmod_dense **X,      // size nbatch; X [k] is n(k)-by-nrhs(k), or NULL
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
 #endif
 
 #endif
@@ -210,6 +210,34 @@ cholmod_dense *SuiteSparseQR_C_qmult /* returns Y, or NULL on failure */
     cholmod_common *cc          /* workspace and parameters */
 ) ;
 
+/* ========================================================================== */
+/* === SuiteSparseQR_C_backslash_batch ====================================== */
+/* ========================================================================== */
+
+/*
+    X [k] = A [k] \ B [k] for k = 0 to nbatch-1, for many small independent
+    least-squares problems, solved in parallel with cc->SPQR_nthreads threads.
+    All A [k] and B [k] must have the same xtype.  If same_pattern is nonzero,
+    the problems are assumed to share the nonzero pattern of A [0], which is
+    then ordered and analyzed just once.  X [k] is NULL if the kth problem
+    could not be solved.
+*/
+
+int SuiteSparseQR_C_backslash_batch /* returns TRUE (1) if all problems solved,
+                                       FALSE (0) otherwise */
+(
+    /* inputs: */
+    int ordering,               /* all, except 3:given treated as 0:fixed */
+    double tol,                 /* columns with 2-norm <= tol treated as 0 */
+    int same_pattern,           /* if TRUE, all A [k] have the pattern of A [0]*/
+    SuiteSparse_long nbatch,    /* number of problems */
+    cholmod_sparse **A,         /* size nbatch; A [k] is m(k)-by-n(k) */
+    cholmod_dense **B,          /* size nbatch; B [k] is m(k)-by-nrhs(k) */
+    /* output: */
+    cholmod_dense **X,          /* size nbatch; X [k] is n(k)-by-nrhs(k) */
+    cholmod_common *cc          /* workspace and parameters */
+) ;
+
 #endif
 
 /* ========================================================================== */
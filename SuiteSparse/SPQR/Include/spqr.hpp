@@ -199,7 +199,7 @@ typedef std::complex<double> Complex ;
 #endif
 
 // -----------------------------------------------------------------------------
-// For counting flops; disabled if TBB is used
+// For counting flops; disabled if OpenMP tasks are used
 // -----------------------------------------------------------------------------
 
 #define FLOP_COUNT(f) { if (cc->SPQR_grain <= 1) cc->SPQR_flopcount += (f) ; }
@@ -225,6 +225,10 @@ template <typename Entry> struct spqr_work
     // for computing the 2-norm of w, the vector of the dead column norms
     double wscale ;         // scale factor for norm (w (of this stack))
     double wssq ;           // sum-of-squares for norm (w (of this stack))
+
+    double flopcount ;      // "pure" flop count for this stack
+
+    Long stackpeak ;        // peak usage of this stack, in # of entries
 } ;
 
 
@@ -249,6 +253,28 @@ template <typename Entry> struct spqr_blob
 } ;
 
 
+// =============================================================================
+// === spqr_fwork ==============================================================
+// =============================================================================
+
+// The workspace of spqr_factorize, kept by the caller of spqr_refactorize for
+// repeated numeric factorizations with the same symbolic analysis.
+
+template <typename Entry> struct spqr_fwork
+{
+    Long ns ;               // number of stacks (QRnum->ns)
+    Long n ;                // number of columns of A
+    Long nf ;               // number of fronts
+    Long maxfn ;            // largest number of columns in any front
+    Long anz ;              // nnz (A)
+    Long fchunk ;           // Householder block size
+    Long wtsize ;           // size of WTwork for each stack
+    spqr_work <Entry> *Work ;   // size ns
+    Entry **Cblock ;        // size nf+1
+    Entry *Sx ;             // size anz, numerical values of S
+} ;
+
+
 // =============================================================================
 // === SuiteSparseQR non-user-callable functions ===============================
 // =============================================================================
@@ -267,6 +293,7 @@ spqr_symbolic *spqr_analyze
     // detection is performed.
 
     int keepH,                      // if nonzero, H is kept
+    int regularize,                 // if nonzero, analyze [A ; lambda*I]
 
     // workspace and parameters
     cholmod_common *cc
@@ -281,8 +308,42 @@ template <typename Entry> spqr_numeric <Entry> *spqr_factorize
     Long freeA,                     // if TRUE, free A on output
     double tol,                     // for rank detection
     Long ntol,                      // apply tol only to first ntol columns
+    double lambda,                  // if QRsym->regularize, factorize
+                                    // [A ; lambda*I] instead of A
+    spqr_symbolic *QRsym,
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
+template <typename Entry> spqr_fwork <Entry> *spqr_get_fwork
+(
+    spqr_symbolic *QRsym,
+    spqr_numeric <Entry> *QRnum,
+    cholmod_common *cc
+) ;
+
+template <typename Entry> void spqr_free_fwork
+(
+    spqr_fwork <Entry> **Fwork_handle,
+    cholmod_common *cc
+) ;
+
+// refactorize A, with the same pattern, reusing QRnum and Fwork
+template <typename Entry> int spqr_refactorize
+(
+    // inputs, not modified
+    cholmod_sparse *A,
+    double tol,                     // for rank detection
+    Long ntol,                      // apply tol only to first ntol columns
+    double lambda,                  // if QRsym->regularize, factorize
+                                    // [A ; lambda*I] instead of A
     spqr_symbolic *QRsym,
 
+    // input/output
+    spqr_numeric <Entry> *QRnum,    // from spqr_factorize, overwritten
+    spqr_fwork <Entry> *Fwork,      // from spqr_get_fwork (QRsym, QRnum)
+
     // workspace and parameters
     cholmod_common *cc
 ) ;
@@ -351,6 +412,7 @@ void spqr_stranspose1
                         // Qfill [k] = j if the kth column of S is the jth
                         // column of A.  Identity permutation is used if
                         // Qfill is NULL.
+    int regularize,     // if TRUE, S = [A ; I] (P,Qfill), and S has m+n rows
 
     // output, contents not defined on input
     Long *Sp,           // size m+1, row pointers of S
@@ -364,7 +426,10 @@ void spqr_stranspose1
                         // Sleft [n+1]-1 gives the empty rows of S.
 
     // workspace, not defined on input or output
-    Long *W             // size m
+    Long *W,            // size m
+
+    // workspace and parameters
+    cholmod_common *cc
 ) ;
 
 
@@ -379,12 +444,17 @@ template <typename Entry> void spqr_stranspose2
 
     Long *Sp,           // size m+1, row pointers of S
     Long *PLinv,        // size m, inverse row permutation, PLinv [i] = k
+    int regularize,     // if TRUE, S = [A ; lambda*I] (p,q) has m+n rows
+    double lambda,      // the diagonal of the regularization rows
 
     // output, contents not defined on input
     Entry *Sx,          // size nz, numerical values of S
 
     // workspace, not defined on input or output
-    Long *W             // size m
+    Long *W,            // size m
+
+    // workspace and parameters
+    cholmod_common *cc
 ) ;
 
 
@@ -698,6 +768,23 @@ template <typename Entry> SuiteSparseQR_factorization <Entry> *spqr_1factor
     cholmod_common *cc
 ) ;
 
+Long spqr_stackorder        // returns the new peak stack size, or EMPTY
+(
+    // inputs, not modified
+    Long nf,                // number of fronts
+    Long *Fsize,            // size nf, Fsize [f] = size of front F
+    Long *Csize,            // size nf, Csize [f] = size of the C block of F
+    Long *Rsize,            // size nf, Rsize [f] = size of R (or RH) of F
+    Long *Post,             // size nf+1, postordering of the front tree
+    Long *Childp,           // size nf+2, from QRsym
+
+    // input/output
+    Long *Child,            // size nf+1; each list of children is reordered
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
 Long spqr_cumsum            // returns total sum
 (
     // input, not modified
@@ -707,6 +794,16 @@ Long spqr_cumsum            // returns total sum
     Long *X                 // size n+1. X = cumsum ([0 X])
 ) ;
 
+Long spqr_pcumsum           // returns total sum
+(
+    // input, not modified
+    Long n,
+    int nthreads,           // # of OpenMP threads to use
+
+    // input/output
+    Long *X                 // size n. X = cumsum ([0 X(1:end-1)])
+) ;
+
 void spqr_shift
 (
     // input, not modified
@@ -739,6 +836,44 @@ template <typename Entry> void spqr_larftb
     cholmod_common *cc
 ) ;
 
+template <typename Entry> void spqr_larft
+(
+    // inputs, not modified (V is modified and then restored on output)
+    Long v,         // V is v-by-k
+    Long k,
+    Long ldv,       // leading dimension of V
+    Entry *V,       // V is v-by-k, unit lower triangular (diag not stored)
+    Entry *Tau,     // size k, the k Householder coefficients
+
+    // output
+    Entry *T,       // size k*k, triangular k-by-k matrix for block reflector
+
+    cholmod_common *cc
+) ;
+
+template <typename Entry> void spqr_larfb
+(
+    // inputs, not modified
+    int method,     // 0,1,2,3, as in spqr_larftb
+    Long m,         // C is m-by-n
+    Long n,
+    Long k,         // V is v-by-k
+                    // for methods 0 and 1, v = m,
+                    // for methods 2 and 3, v = n
+    Long ldc,       // leading dimension of C
+    Long ldv,       // leading dimension of V
+    Entry *V,       // V is v-by-k, unit lower triangular (diag not stored)
+    Entry *T,       // k-by-k matrix from spqr_larft
+
+    // input/output
+    Entry *C,       // C is m-by-n, with leading dimension ldc
+
+    // workspace, not defined on input or output
+    Entry *Work,    // for methods 0,1: size n*k
+                    // for methods 2,3: size m*k
+    cholmod_common *cc
+) ;
+
 int spqr_happly_work
 (
     // input
@@ -879,6 +1014,50 @@ template <typename Entry> void spqr_rsolve
     cholmod_common *cc
 ) ;
 
+// returns TRUE if the fronts were solved, FALSE if not done
+template <typename Entry> int spqr_rsolve_fronts
+(
+    // inputs
+    SuiteSparseQR_factorization <Entry> *QR,
+    int transpose,          // FALSE: solve R\B, TRUE: solve R'\B
+    Long *Q1fill,           // for R\B only; NULL if the identity
+
+    Long nrhs,              // number of columns of B and X
+    Long ldb,               // leading dimension of B
+    Entry *B,               // for R\B only: size m-by-nrhs
+
+    // input/output
+    Long ldx,               // leading dimension of X
+    Entry *X,               // n-by-nrhs for R\B, m-by-nrhs for R'\B
+
+    cholmod_common *cc
+) ;
+
+// apply the Householder vectors of QR to a dense matrix X, with workspace from
+// the caller (see SuiteSparseQR_qmult)
+template <typename Entry> void spqr_private_Happly
+(
+    // inputs
+    int method,             // 0,1,2,3
+    SuiteSparseQR_factorization <Entry> *QR,
+    Long hchunk,            // apply hchunk Householder vectors at a time
+    int nthreads,           // number of threads to use
+
+    // input/output
+    Long m,
+    Long n,
+    Entry *X,               // size m-by-n with leading dimension m
+
+    // workspace, not defined on input or output.  nthreads copies of each:
+    Entry *H_Tau,           // size QRsym->maxfn
+    Long *H_start,          // size QRsym->maxfn
+    Long *H_end,            // size QRsym->maxfn
+    Entry *V,               // size v-by-hchunk, where v = QRnum->maxfm
+    Entry *C,               // size: method 0,1: v*n,     method 2,3: m*v
+    Entry *W,               // size: method 0,1: h*h+n*h, method 2,3: h*h+m*h
+    cholmod_common *cc
+) ;
+
 // returns rank of F, or 0 on error
 template <typename Entry> Long spqr_front
 (
@@ -907,6 +1086,7 @@ template <typename Entry> Long spqr_front
     // input/output
     double *wscale,
     double *wssq,
+    double *flops,      // "pure" flop count of this stack
 
     cholmod_common *cc
 ) ;
@@ -1011,6 +1191,26 @@ inline Long spqr_mult (Long a, Long b, int *ok)
 }
 
 
+// =============================================================================
+// === spqr_colsearch ==========================================================
+// =============================================================================
+
+// Returns the position of the first entry in Ai [pstart ... pend-1] with a
+// row index >= i, or pend if there is none, where Ai [pstart ... pend-1] is a
+// column of a matrix with sorted columns.  This allows each thread to work on
+// its own range of rows of the matrix.
+
+inline Long spqr_colsearch (Long *Ai, Long pstart, Long pend, Long i)
+{
+    while (pstart < pend)
+    {
+        Long mid = (pstart + pend) / 2 ;
+        if (Ai [mid] < i) pstart = mid + 1 ; else pend = mid ;
+    }
+    return (pstart) ;
+}
+
+
 // =============================================================================
 // === BLAS interface ==========================================================
 // =============================================================================
@@ -357,6 +357,7 @@ spqr_cpp_src = {
     '../Source/spqr_cpack', ...
     '../Source/spqr_csize', ...
     '../Source/spqr_cumsum', ...
+    '../Source/spqr_stackorder', ...
     '../Source/spqr_debug', ...
     '../Source/spqr_factorize', ...
     '../Source/spqr_fcsize', ...
@@ -384,8 +385,10 @@ spqr_cpp_src = {
     '../Source/spqr_tol', ...
     '../Source/spqr_maxcolnorm', ...
     '../Source/SuiteSparseQR_qmult', ...
+    '../Source/SuiteSparseQR_rowupdate', ...
     '../Source/SuiteSparseQR', ...
     '../Source/SuiteSparseQR_expert', ...
+    '../Source/SuiteSparseQR_batch', ...
     '../MATLAB/spqr_mx' } ;
 
 % SuiteSparse C source code, for MATLAB error handling
@@ -47,7 +47,7 @@ int spqr_mx_config (Long spumoni, cholmod_common *cc)
     cc->SPQR_grain = 1 ;    // opts.grain
     cc->SPQR_small = 1e6 ;  // opts.small
     cc->SPQR_shrink = 1 ;   // controls SPQR shrink realloc
-    cc->SPQR_nthreads = 0 ; // number of TBB threads (0 = default)
+    cc->SPQR_nthreads = 0 ; // number of OpenMP threads (0 = default)
 
     return (TRUE) ;
 }
@@ -88,8 +88,8 @@ void spqr_mx_spumoni
             "    size of int:      %d bytes\n"
             "    size of BLAS int: %d bytes\n",
             sizeof (mwIndex), sizeof (int), sizeof (BLAS_INT)) ;
-#ifdef HAVE_TBB
-        mexPrintf ("    compiled with Intel Threading Building Blocks (TBB)\n");
+#ifdef _OPENMP
+        mexPrintf ("    compiled with OpenMP\n");
 #endif
 #ifndef NEXPERT
         mexPrintf ("    compiled with opts.solution='min2norm' option\n") ;
@@ -171,21 +171,20 @@ void spqr_mx_spumoni
         mexPrintf ("'basic'\n") ;
     }
 
-#ifdef HAVE_TBB
+#ifdef _OPENMP
     mexPrintf (
     "    opts.grain = %g, opts.small = %g, opts.nthreads = %d\n"
-    "        The analysis for TBB parallelism constructs a task graph by\n"
+    "        The analysis for task parallelism constructs a task graph by\n"
     "        merging nodes in the frontal elimination tree, which is itself\n"
     "        a coalescing of the column elimination tree with one node per\n"
     "        column in the matrix.  The goal of the merging heuristic is to\n"
     "        create a task graph whose leaf nodes have flop counts >=\n"
     "        max ((total flops)/opts.grain, opts.small).  If opts.grain <= 1,\n"
-    "        then no TBB parallelism is exploited.  The current default is\n"
-    "        opts.grain=1 because in the current version of TBB and OpenMP,\n"
-    "        TBB parallelism conflicts with BLAS OpenMP-based parallelism.\n"
-    "        This will be resolved in a future version.\n"
-    "        opts.nthreads is the number of threads that TBB should use.\n"
-    "        If zero, the TBB default is used, which is normally the total\n"
+    "        then no task parallelism is exploited.  The current default is\n"
+    "        opts.grain=1 because task parallelism can conflict with\n"
+    "        BLAS OpenMP-based parallelism.\n"
+    "        opts.nthreads is the number of OpenMP threads to use.\n"
+    "        If zero, the OpenMP default is used, which is normally the total\n"
     "        number of cores your computer has.\n",
         cc->SPQR_grain, cc->SPQR_small, cc->SPQR_nthreads) ;
 #endif
@@ -198,7 +197,7 @@ void spqr_mx_spumoni
     mexPrintf ("    upper bound on nnz(R): %ld\n",        cc->SPQR_istat [0]) ;
     mexPrintf ("    upper bound on nnz(H): %ld\n",        cc->SPQR_istat [1]) ;
     mexPrintf ("    number of frontal matrices: %ld\n",   cc->SPQR_istat [2]) ;
-    mexPrintf ("    # tasks in TBB task tree: %ld\n",     cc->SPQR_istat [3]) ;
+    mexPrintf ("    # tasks in task tree: %ld\n",     cc->SPQR_istat [3]) ;
     mexPrintf ("    rank(A) estimate: %ld\n",             cc->SPQR_istat [4]) ;
     mexPrintf ("    # of column singletons: %ld\n",       cc->SPQR_istat [5]) ;
     mexPrintf ("    # of singleton rows: %ld\n",          cc->SPQR_istat [6]) ;
@@ -354,14 +353,14 @@ int spqr_mx_get_options
     opts->tol = x_present ? x : SPQR_DEFAULT_TOL ;
 
     // -------------------------------------------------------------------------
-    // cc->SPQR_grain: defaults to 1 (no TBB parallelism)
+    // cc->SPQR_grain: defaults to 1 (no task parallelism)
     // -------------------------------------------------------------------------
 
     get_option (mxopts, "grain", &x, &x_present, NULL, cc) ;
     cc->SPQR_grain = x_present ? x : 1 ;
 
     // -------------------------------------------------------------------------
-    // cc->SPQR_small: defaults to 1e6 (min flop count in a TBB task)
+    // cc->SPQR_small: defaults to 1e6 (min flop count in a task)
     // -------------------------------------------------------------------------
 
     get_option (mxopts, "small", &x, &x_present, NULL, cc) ;
@@ -379,7 +378,7 @@ int spqr_mx_get_options
     // cc->SPQR_nthreads: defaults to 0; # of threads to use
     // -------------------------------------------------------------------------
 
-    // nthreads = 0 means to use the TBB default
+    // nthreads = 0 means to use the OpenMP default
     get_option (mxopts, "nthreads", &x, &x_present, NULL, cc) ;
     cc->SPQR_nthreads = x_present ? ((int) x) : 0 ;
     cc->SPQR_nthreads = MAX (0, cc->SPQR_nthreads) ;
@@ -1073,7 +1072,7 @@ mxArray *spqr_mx_info       // return a struct with info statistics
 
     mxSetFieldByNumber (s, 0, 12, mxCreateDoubleScalar (cc->SPQR_norm_E_fro)) ;
 
-#ifdef HAVE_TBB
+#ifdef _OPENMP
     mxSetFieldByNumber (s, 0, 13, mxCreateString ("yes")) ;
 #else
     mxSetFieldByNumber (s, 0, 13, mxCreateString ("no")) ;
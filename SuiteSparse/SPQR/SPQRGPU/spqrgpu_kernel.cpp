@@ -115,7 +115,7 @@ void spqrgpu_kernel
     // get the stack for this task and the head/top pointers
     // -------------------------------------------------------------------------
 
-    Long stack = 0 ;                    // no mixing of GPU and TBB parallelism
+    Long stack = 0 ;                    // no mixing of GPU and OpenMP task parallelism
     ASSERT (QRnum->ntasks == 1) ;
 
     double * Stack_top = Work [stack].Stack_top ;
@@ -361,6 +361,42 @@ cholmod_dense *SuiteSparseQR_C_qmult
             (SuiteSparseQR_factorization <Complex> *) QR->factors, X, cc)) ;
 }
 
+// =============================================================================
+// === SuiteSparseQR_C_backslash_batch =========================================
+// =============================================================================
+
+// X [k] = A [k] \ B [k] for k = 0 to nbatch-1, for many small problems.  The
+// xtype of A [0] determines the xtype of all the problems.
+
+int SuiteSparseQR_C_backslash_batch // returns TRUE if all problems solved
+(
+    // inputs:
+    int ordering,               // all, except 3:given treated as 0:fixed
+    double tol,                 // columns with 2-norm <= tol treated as 0
+    int same_pattern,           // if TRUE, all A [k] have the pattern of A [0]
+    Long nbatch,                // number of problems
+    cholmod_sparse **A,         // size nbatch; A [k] is m(k)-by-n(k)
+    cholmod_dense **B,          // size nbatch; B [k] is m(k)-by-nrhs(k)
+    // output:
+    cholmod_dense **X,          // size nbatch; X [k] is n(k)-by-nrhs(k)
+    cholmod_common *cc          // workspace and parameters
+)
+{
+    RETURN_IF_NULL_COMMON (FALSE) ;
+    if (nbatch > 0)
+    {
+        RETURN_IF_NULL (A, FALSE) ;
+        RETURN_IF_NULL (A [0], FALSE) ;
+    }
+    cc->status = CHOLMOD_OK ;
+
+    return ((nbatch <= 0 || A [0]->xtype == CHOLMOD_REAL) ?
+        SuiteSparseQR_batch <double>  (ordering, tol, same_pattern, nbatch,
+            A, B, X, cc) :
+        SuiteSparseQR_batch <Complex> (ordering, tol, same_pattern, nbatch,
+            A, B, X, cc)) ;
+}
+
 #endif
 
 // =============================================================================
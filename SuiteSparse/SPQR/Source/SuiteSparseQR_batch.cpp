@@ -0,0 +1,719 @@
+// =============================================================================
+// === SuiteSparseQR_batch =====================================================
+// =============================================================================
+
+// Solves a batch of independent sparse least-squares problems,
+//
+//      X [k] = A [k] \ B [k]       for k = 0 to nbatch-1,
+//
+// where each A [k] is sparse and each B [k] is dense.  Each X [k] is the
+// solution computed by SuiteSparseQR (ordering, tol, A [k], B [k], cc), up to
+// roundoff.  This function is meant for a large number of small problems, where
+// the cost of solving each one with its own call to SuiteSparseQR is dominated
+// by the fixed costs of the ordering, the symbolic analysis, and the
+// allocation of workspace, rather than by the numeric factorization.
+//
+// The problems are split among cc->SPQR_nthreads OpenMP threads (or the
+// OpenMP default number of threads if cc->SPQR_nthreads is <= 0).  Each
+// thread uses its own private copy of the cholmod_common object, so its
+// CHOLMOD workspace (Flag, Head, Iwork, and Xwork) is allocated once and then
+// reused for all the problems it solves.  Each problem is factorized
+// sequentially, by a single thread.
+//
+// If same_pattern is TRUE, the problems are assumed to share the nonzero
+// pattern of A [0].  A [0] is then ordered and analyzed just once, by
+// SuiteSparseQR_symbolic, before the problems are split among the threads,
+// and this analysis is shared, read-only, by all of them.  Each A [k] with
+// the same pattern as A [0] is factorized with that analysis, with X [k] =
+// E*(R\(Q'*B [k])).  Each thread allocates its numeric factorization (with
+// its Stacks at full size) and all of its workspace for the first such
+// problem it solves, and reuses them for the rest (see spqr_refactorize), so
+// that only X [k] is allocated for each problem.  The pattern of each A [k]
+// is checked first, in O(nnz) time; a problem whose pattern differs is solved
+// on its own, as if same_pattern were FALSE.  No singletons are exploited in
+// the shared analysis.
+//
+// The inputs are all checked before any problem is solved: if any A [k] or
+// B [k] is NULL or of the wrong type, or if B [k] does not have the same
+// number of rows as A [k], an error is returned and X is not modified.
+//
+// On output, X [k] is the solution of the kth problem, or NULL if it could not
+// be computed (in which case cc->status holds the error of the first problem
+// that failed).  cc->SPQR_flopcount is the total flop count of all the
+// factorizations.  The other statistics in cc are not modified.
+//
+// Returns TRUE if all the problems were solved, FALSE otherwise.
+
+#ifndef NEXPERT
+#include "spqr.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// =============================================================================
+// === spqr_private_same_pattern ===============================================
+// =============================================================================
+
+// Returns TRUE if A and A0 have the same dimensions and the same nonzero
+// pattern, both in packed form.
+
+static int spqr_private_same_pattern
+(
+    cholmod_sparse *A,
+    cholmod_sparse *A0
+)
+{
+    Long *Ap, *Ai, *A0p, *A0i, n, j, p, anz ;
+
+    if (A == A0)
+    {
+        return (TRUE) ;
+    }
+    if (A->nrow != A0->nrow || A->ncol != A0->ncol || A->stype != A0->stype
+        || !(A->packed) || !(A0->packed))
+    {
+        return (FALSE) ;
+    }
+
+    n = A->ncol ;
+    Ap = (Long *) A->p ;
+    Ai = (Long *) A->i ;
+    A0p = (Long *) A0->p ;
+    A0i = (Long *) A0->i ;
+    if (Ap == A0p && Ai == A0i)
+    {
+        // A and A0 share their pattern arrays
+        return (TRUE) ;
+    }
+
+    for (j = 0 ; j <= n ; j++)
+    {
+        if (Ap [j] != A0p [j]) return (FALSE) ;
+    }
+    anz = Ap [n] ;
+    for (p = 0 ; p < anz ; p++)
+    {
+        if (Ai [p] != A0i [p]) return (FALSE) ;
+    }
+    return (TRUE) ;
+}
+
+// =============================================================================
+// === spqr_private_batch_common ===============================================
+// =============================================================================
+
+// Cm is a private copy of cc, with its own workspace and memory statistics.
+
+static void spqr_private_batch_common
+(
+    cholmod_common *cc,
+    Long nthreads,
+    cholmod_common *Cm
+)
+{
+    *Cm = *cc ;
+    Cm->status = CHOLMOD_OK ;
+    Cm->Flag = NULL ;
+    Cm->Head = NULL ;
+    Cm->Xwork = NULL ;
+    Cm->Iwork = NULL ;
+    Cm->nrow = 0 ;
+    Cm->iworksize = 0 ;
+    Cm->xworksize = 0 ;
+    Cm->malloc_count = 0 ;
+    Cm->memory_inuse = 0 ;
+    Cm->memory_usage = 0 ;
+    if (nthreads > 1)
+    {
+        // each problem is factorized by a single thread, without the GPU
+        Cm->SPQR_nthreads = 1 ;
+        Cm->SPQR_grain = 1 ;
+        Cm->useGPU = 0 ;
+    }
+}
+
+
+// =============================================================================
+// === spqr_private_bwork ======================================================
+// =============================================================================
+
+// The workspace of one thread, for the problems that share the analysis of
+// A [0].  It is allocated when the thread factorizes its first such problem,
+// and then reused, without any further malloc or free, for the rest.
+
+#define HCHUNK 32       // as in SuiteSparseQR_qmult
+
+// spqr_rsolve is given at most RSOLVE_NCOLS columns at a time.  With fewer
+// than RSOLVE_BLOCK (in spqr_rsolve.cpp) columns it uses the workspace of the
+// caller, rather than allocating its own for the blocked method.
+#define RSOLVE_NCOLS 3
+
+template <typename Entry> struct spqr_private_bwork
+{
+    // a shallow copy of the shared QR object: QRsym and Q1fill are shared by
+    // all threads, and not modified.  QRnum, Rmap and RmapInv are this
+    // thread's own.
+    SuiteSparseQR_factorization <Entry> QR ;
+
+    spqr_fwork <Entry> *Fwork ; // workspace for spqr_refactorize
+    Long *Rmap ;            // size n, for QR.Rmap if A [k] is rank deficient
+    Long *RmapInv ;         // size n, for QR.RmapInv
+
+    Long m ;                // A [k] is m-by-n
+    Long n ;
+    Long maxfn ;            // QRsym->maxfn
+    Long vmax ;             // max # of rows in any front; QRnum->maxfm <= vmax
+    Long nrhs ;             // largest number of columns of any B [k]
+
+    Entry *Y ;              // size m*nrhs, for Q'*B [k]
+    Entry *H_Tau ;          // size maxfn, for spqr_private_Happly
+    Long *H_start ;         // size maxfn
+    Long *H_end ;           // size maxfn
+    Entry *V ;              // size vmax*HCHUNK
+    Entry *C ;              // size vmax*nrhs
+    Entry *W ;              // size HCHUNK*(HCHUNK+nrhs)
+    Entry **Rcolp ;         // size maxfn, for spqr_rsolve
+    Long *Rlive ;           // size maxfn
+    Entry *Rw ;             // size maxfn*nrhs
+} ;
+
+
+// =============================================================================
+// === spqr_private_batch_init =================================================
+// =============================================================================
+
+// Bw.QR is a shallow copy of QR0 (if not NULL), with no numeric factorization
+// yet, and no workspace.
+
+template <typename Entry> void spqr_private_batch_init
+(
+    SuiteSparseQR_factorization <Entry> *QR0,
+    Long nrhs,
+    spqr_private_bwork <Entry> *Bw
+)
+{
+    if (QR0 != NULL)
+    {
+        Bw->QR = *QR0 ;
+    }
+    Bw->QR.QRnum = NULL ;
+    Bw->QR.Rmap = NULL ;
+    Bw->QR.RmapInv = NULL ;
+    Bw->Fwork = NULL ;
+    Bw->Rmap = NULL ;
+    Bw->RmapInv = NULL ;
+    Bw->m = 0 ;
+    Bw->n = 0 ;
+    Bw->maxfn = 0 ;
+    Bw->vmax = 0 ;
+    Bw->nrhs = nrhs ;
+    Bw->Y = NULL ;
+    Bw->H_Tau = NULL ;
+    Bw->H_start = NULL ;
+    Bw->H_end = NULL ;
+    Bw->V = NULL ;
+    Bw->C = NULL ;
+    Bw->W = NULL ;
+    Bw->Rcolp = NULL ;
+    Bw->Rlive = NULL ;
+    Bw->Rw = NULL ;
+}
+
+
+// =============================================================================
+// === spqr_private_batch_free =================================================
+// =============================================================================
+
+// Free the numeric factorization and workspace of one thread.  The shared
+// QRsym and Q1fill are not freed.
+
+template <typename Entry> void spqr_private_batch_free
+(
+    spqr_private_bwork <Entry> *Bw,
+    cholmod_common *cc
+)
+{
+    Long m = Bw->m, n = Bw->n, maxfn = Bw->maxfn, vmax = Bw->vmax,
+        nrhs = Bw->nrhs ;
+    spqr_freenum (&(Bw->QR.QRnum), cc) ;
+    spqr_free_fwork (&(Bw->Fwork), cc) ;
+    cholmod_l_free (n, sizeof (Long), Bw->Rmap, cc) ;
+    cholmod_l_free (n, sizeof (Long), Bw->RmapInv, cc) ;
+    cholmod_l_free (m*nrhs, sizeof (Entry), Bw->Y, cc) ;
+    cholmod_l_free (maxfn, sizeof (Entry), Bw->H_Tau, cc) ;
+    cholmod_l_free (maxfn, sizeof (Long), Bw->H_start, cc) ;
+    cholmod_l_free (maxfn, sizeof (Long), Bw->H_end, cc) ;
+    cholmod_l_free (vmax*HCHUNK, sizeof (Entry), Bw->V, cc) ;
+    cholmod_l_free (vmax*nrhs, sizeof (Entry), Bw->C, cc) ;
+    cholmod_l_free (HCHUNK*(HCHUNK+nrhs), sizeof (Entry), Bw->W, cc) ;
+    cholmod_l_free (maxfn, sizeof (Entry *), Bw->Rcolp, cc) ;
+    cholmod_l_free (maxfn, sizeof (Long), Bw->Rlive, cc) ;
+    cholmod_l_free (maxfn*nrhs, sizeof (Entry), Bw->Rw, cc) ;
+    Bw->Fwork = NULL ;
+    Bw->Rmap = NULL ;
+    Bw->RmapInv = NULL ;
+    Bw->Y = NULL ;
+    Bw->H_Tau = NULL ;
+    Bw->H_start = NULL ;
+    Bw->H_end = NULL ;
+    Bw->V = NULL ;
+    Bw->C = NULL ;
+    Bw->W = NULL ;
+    Bw->Rcolp = NULL ;
+    Bw->Rlive = NULL ;
+    Bw->Rw = NULL ;
+    Bw->QR.Rmap = NULL ;
+    Bw->QR.RmapInv = NULL ;
+}
+
+
+// =============================================================================
+// === spqr_private_batch_factorize ============================================
+// =============================================================================
+
+// QR factorization of A, with the shared analysis in Bw->QR.  The first
+// factorization of a thread is done by spqr_factorize, with its Stacks left
+// at full size, and the workspace of the thread is then allocated.  Each
+// subsequent one reuses all of it, with spqr_refactorize.  Returns TRUE if
+// successful, FALSE otherwise (in which case Bw has been freed).
+
+template <typename Entry> int spqr_private_batch_factorize
+(
+    cholmod_sparse *A,
+    double tol,
+    spqr_private_bwork <Entry> *Bw,
+    cholmod_common *cc
+)
+{
+    SuiteSparseQR_factorization <Entry> *QR = &(Bw->QR) ;
+    spqr_symbolic *QRsym = QR->QRsym ;
+    Long *Hip, n, f ;
+    int shrink, ok ;
+
+    // -------------------------------------------------------------------------
+    // get the column 2-norm tolerance, as SuiteSparseQR_numeric does
+    // -------------------------------------------------------------------------
+
+    n = A->ncol ;
+    if (QR->allow_tol)
+    {
+        if (tol <= SPQR_DEFAULT_TOL)
+        {
+            tol = spqr_tol <Entry> (A, cc) ;
+        }
+    }
+    else
+    {
+        tol = EMPTY ;
+    }
+    QR->tol = tol ;
+
+    if (QR->QRnum == NULL)
+    {
+
+        // ---------------------------------------------------------------------
+        // first factorization, with the Stacks kept at full size
+        // ---------------------------------------------------------------------
+
+        shrink = cc->SPQR_shrink ;
+        cc->SPQR_shrink = 0 ;
+        QR->QRnum = spqr_factorize <Entry> (&A, FALSE, tol, n, 0, QRsym, cc) ;
+        cc->SPQR_shrink = shrink ;
+        if (cc->status < CHOLMOD_OK)
+        {
+            return (FALSE) ;
+        }
+
+        // ---------------------------------------------------------------------
+        // allocate the workspace of this thread
+        // ---------------------------------------------------------------------
+
+        ok = TRUE ;
+        Hip = QRsym->Hip ;
+        Bw->vmax = 0 ;
+        for (f = 0 ; f < QRsym->nf ; f++)
+        {
+            Bw->vmax = MAX (Bw->vmax, Hip [f+1] - Hip [f]) ;
+        }
+        Bw->m = QR->narows ;
+        Bw->n = n ;
+        Bw->maxfn = QRsym->maxfn ;
+        spqr_mult (Bw->m, Bw->nrhs, &ok) ;
+        spqr_mult (Bw->vmax, MAX (HCHUNK, Bw->nrhs), &ok) ;
+        spqr_mult (Bw->maxfn, Bw->nrhs, &ok) ;
+        if (!ok)
+        {
+            // the workspace would be too large (integer overflow)
+            ERROR (CHOLMOD_TOO_LARGE, "problem too large") ;
+            spqr_private_batch_free (Bw, cc) ;
+            return (FALSE) ;
+        }
+
+        Long m = Bw->m, maxfn = Bw->maxfn, vmax = Bw->vmax, nrhs = Bw->nrhs ;
+        Bw->Fwork = spqr_get_fwork <Entry> (QRsym, QR->QRnum, cc) ;
+        Bw->Rmap    = (Long *)   cholmod_l_malloc (n, sizeof (Long), cc) ;
+        Bw->RmapInv = (Long *)   cholmod_l_malloc (n, sizeof (Long), cc) ;
+        Bw->Y       = (Entry *)  cholmod_l_malloc (m*nrhs, sizeof (Entry), cc) ;
+        Bw->H_Tau   = (Entry *)  cholmod_l_malloc (maxfn, sizeof (Entry), cc) ;
+        Bw->H_start = (Long *)   cholmod_l_malloc (maxfn, sizeof (Long), cc) ;
+        Bw->H_end   = (Long *)   cholmod_l_malloc (maxfn, sizeof (Long), cc) ;
+        Bw->V       = (Entry *)  cholmod_l_malloc (vmax*HCHUNK, sizeof (Entry),
+            cc) ;
+        Bw->C       = (Entry *)  cholmod_l_malloc (vmax*nrhs, sizeof (Entry),
+            cc) ;
+        Bw->W       = (Entry *)  cholmod_l_malloc (HCHUNK*(HCHUNK+nrhs),
+            sizeof (Entry), cc) ;
+        Bw->Rcolp   = (Entry **) cholmod_l_malloc (maxfn, sizeof (Entry *), cc);
+        Bw->Rlive   = (Long *)   cholmod_l_malloc (maxfn, sizeof (Long), cc) ;
+        Bw->Rw      = (Entry *)  cholmod_l_malloc (maxfn*nrhs, sizeof (Entry),
+            cc) ;
+        if (cc->status < CHOLMOD_OK)
+        {
+            // out of memory
+            spqr_private_batch_free (Bw, cc) ;
+            return (FALSE) ;
+        }
+
+    }
+    else
+    {
+
+        // ---------------------------------------------------------------------
+        // refactorize, reusing QRnum and the workspace
+        // ---------------------------------------------------------------------
+
+        if (!spqr_refactorize <Entry> (A, tol, n, 0, QRsym, QR->QRnum,
+            Bw->Fwork, cc))
+        {
+            spqr_private_batch_free (Bw, cc) ;
+            return (FALSE) ;
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // find the mapping for the squeezed R, if A is rank deficient
+    // -------------------------------------------------------------------------
+
+    QR->rank = QR->QRnum->rank1 ;
+    ASSERT (QR->QRnum->maxfm <= Bw->vmax) ;
+    ASSERT (QR->QRnum->maxfrank <= Bw->maxfn) ;
+    if (QR->rank < n)
+    {
+        // spqr_rmap uses the arrays of Bw, and does not allocate them
+        QR->Rmap = Bw->Rmap ;
+        QR->RmapInv = Bw->RmapInv ;
+        spqr_rmap (QR, cc) ;
+    }
+    else
+    {
+        QR->Rmap = NULL ;
+        QR->RmapInv = NULL ;
+    }
+    return (TRUE) ;
+}
+
+
+// =============================================================================
+// === spqr_private_batch_solve ================================================
+// =============================================================================
+
+// X = E*(R\(Q'*B)), with the factorization and workspace in Bw.  Only X is
+// allocated.  Q'*B is computed by a single thread.
+
+template <typename Entry> cholmod_dense *spqr_private_batch_solve
+(
+    cholmod_dense *B,
+    spqr_private_bwork <Entry> *Bw,
+    cholmod_common *cc
+)
+{
+    SuiteSparseQR_factorization <Entry> *QR = &(Bw->QR) ;
+    cholmod_dense *X ;
+    Entry *Bx, *Y, *B1, *Y1 ;
+    Long *HPinv, m, n, nrhs, ldb, i, k, k1 ;
+
+    m = QR->narows ;
+    n = QR->nacols ;
+    nrhs = B->ncol ;
+    ldb = B->d ;
+    ASSERT (nrhs <= Bw->nrhs) ;
+
+    X = cholmod_l_allocate_dense (n, nrhs, n, spqr_type <Entry> ( ), cc) ;
+    if (X == NULL || m == 0 || n == 0 || nrhs == 0)
+    {
+        // out of memory, or nothing to do (X is zero if m is zero)
+        if (X != NULL)
+        {
+            Entry *Xx = (Entry *) X->x ;
+            for (i = 0 ; i < n*nrhs ; i++)
+            {
+                Xx [i] = 0 ;
+            }
+        }
+        return (X) ;
+    }
+
+    // Y (HPinv,:) = B, with leading dimension m
+    HPinv = QR->QRnum->HPinv ;
+    Bx = (Entry *) B->x ;
+    Y = Bw->Y ;
+    B1 = Bx ;
+    Y1 = Y ;
+    for (k = 0 ; k < nrhs ; k++)
+    {
+        for (i = 0 ; i < m ; i++)
+        {
+            Y1 [HPinv [i]] = B1 [i] ;
+        }
+        B1 += ldb ;
+        Y1 += m ;
+    }
+
+    // Y = Q'*Y
+    spqr_private_Happly (SPQR_QTX, QR, HCHUNK, 1, m, nrhs, Y, Bw->H_Tau,
+        Bw->H_start, Bw->H_end, Bw->V, Bw->C, Bw->W, cc) ;
+
+    // X = E*(R\Y), a few columns at a time
+    Entry *Xx = (Entry *) X->x ;
+    for (k1 = 0 ; k1 < nrhs ; k1 += RSOLVE_NCOLS)
+    {
+        spqr_rsolve (QR, TRUE, MIN (RSOLVE_NCOLS, nrhs-k1), m, Y + k1*m,
+            Xx + k1*n, Bw->Rcolp, Bw->Rlive, Bw->Rw, cc) ;
+    }
+    return (X) ;
+}
+
+
+// =============================================================================
+// === SuiteSparseQR_batch =====================================================
+// =============================================================================
+
+template <typename Entry> int SuiteSparseQR_batch
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol treated as zero
+    int same_pattern,       // if TRUE, the problems share the pattern of A [0]
+    Long nbatch,            // number of problems
+    cholmod_sparse **A,     // size nbatch; A [k] is m(k)-by-n(k)
+    cholmod_dense **B,      // size nbatch; B [k] is m(k)-by-nrhs(k)
+    // output
+    cholmod_dense **X,      // size nbatch; X [k] is n(k)-by-nrhs(k), or NULL
+    // workspace and parameters
+    cholmod_common *cc
+)
+{
+    SuiteSparseQR_factorization <Entry> *QR0 ;
+    cholmod_common Cm0 ;
+    Long k, xtype, nthreads, maxnrhs ;
+    int status ;
+    double flops ;
+    size_t malloc_count, memory_inuse, memory_usage, shared ;
+
+    // -------------------------------------------------------------------------
+    // check inputs
+    // -------------------------------------------------------------------------
+
+    RETURN_IF_NULL_COMMON (FALSE) ;
+    if (nbatch < 0)
+    {
+        ERROR (CHOLMOD_INVALID, "nbatch must be >= 0") ;
+        return (FALSE) ;
+    }
+    if (nbatch == 0)
+    {
+        cc->status = CHOLMOD_OK ;
+        return (TRUE) ;
+    }
+    RETURN_IF_NULL (A, FALSE) ;
+    RETURN_IF_NULL (B, FALSE) ;
+    RETURN_IF_NULL (X, FALSE) ;
+    xtype = spqr_type <Entry> ( ) ;
+    for (k = 0 ; k < nbatch ; k++)
+    {
+        RETURN_IF_NULL (A [k], FALSE) ;
+        RETURN_IF_NULL (B [k], FALSE) ;
+        RETURN_IF_XTYPE_INVALID (A [k], FALSE) ;
+        RETURN_IF_XTYPE_INVALID (B [k], FALSE) ;
+        if (B [k]->nrow != A [k]->nrow)
+        {
+            ERROR (CHOLMOD_INVALID, "mismatched dimensions") ;
+            return (FALSE) ;
+        }
+    }
+    cc->status = CHOLMOD_OK ;
+
+    for (k = 0 ; k < nbatch ; k++)
+    {
+        X [k] = NULL ;
+    }
+
+    // -------------------------------------------------------------------------
+    // determine the number of threads
+    // -------------------------------------------------------------------------
+
+    nthreads = 1 ;
+#ifdef _OPENMP
+    nthreads = (cc->SPQR_nthreads > 0) ? cc->SPQR_nthreads :
+        omp_get_max_threads ( ) ;
+    nthreads = MAX (1, MIN (nthreads, nbatch)) ;
+#endif
+
+    // -------------------------------------------------------------------------
+    // analyze the shared pattern, once for all the threads
+    // -------------------------------------------------------------------------
+
+    QR0 = NULL ;
+    shared = 0 ;
+    spqr_private_batch_common (cc, nthreads, &Cm0) ;
+    if (same_pattern)
+    {
+        QR0 = SuiteSparseQR_symbolic <Entry> (ordering,
+            (tol >= 0 || tol <= SPQR_DEFAULT_TOL), A [0], &Cm0) ;
+        // if this fails, each problem is solved on its own instead
+        cholmod_l_free_work (&Cm0) ;
+        shared = Cm0.memory_inuse ;
+    }
+
+    maxnrhs = 0 ;
+    for (k = 0 ; k < nbatch ; k++)
+    {
+        maxnrhs = MAX (maxnrhs, (Long) B [k]->ncol) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // solve the problems
+    // -------------------------------------------------------------------------
+
+    status = CHOLMOD_OK ;
+    flops = 0 ;
+    malloc_count = 0 ;
+    memory_inuse = 0 ;
+    memory_usage = 0 ;
+
+    #pragma omp parallel num_threads(nthreads)
+    {
+        cholmod_common Cm ;
+        spqr_private_bwork <Entry> Bw ;
+        double tflops = 0 ;
+
+        // a private copy of cc, with its own workspace
+        spqr_private_batch_common (cc, nthreads, &Cm) ;
+
+        // the numeric factorization and workspace of this thread, for the
+        // problems that share the analysis QR0
+        spqr_private_batch_init <Entry> (QR0, maxnrhs, &Bw) ;
+
+        // ---------------------------------------------------------------------
+        // solve this thread's share of the problems
+        // ---------------------------------------------------------------------
+
+        #pragma omp for schedule(dynamic,1)
+        for (Long kk = 0 ; kk < nbatch ; kk++)
+        {
+            Cm.status = CHOLMOD_OK ;
+            if (QR0 != NULL && spqr_private_same_pattern (A [kk], A [0]))
+            {
+                // X = E*(R\(Q'*B)), using the shared analysis
+                if (spqr_private_batch_factorize <Entry> (A [kk], tol, &Bw,
+                    &Cm))
+                {
+                    X [kk] = spqr_private_batch_solve <Entry> (B [kk], &Bw,
+                        &Cm) ;
+                }
+            }
+            else
+            {
+                // X = A\B, with its own ordering and analysis
+                X [kk] = SuiteSparseQR <Entry> (ordering, tol, A [kk], B [kk],
+                    &Cm) ;
+            }
+            tflops += Cm.SPQR_flopcount ;
+            if (X [kk] == NULL)
+            {
+                #pragma omp critical (spqr_batch)
+                {
+                    if (status == CHOLMOD_OK)
+                    {
+                        status = (Cm.status < CHOLMOD_OK) ? Cm.status :
+                            CHOLMOD_INVALID ;
+                    }
+                }
+            }
+        }
+
+        // ---------------------------------------------------------------------
+        // free the numeric factorization and workspace of this thread
+        // ---------------------------------------------------------------------
+
+        spqr_private_batch_free <Entry> (&Bw, &Cm) ;
+        cholmod_l_free_work (&Cm) ;
+
+        // The solutions X [k] were allocated with Cm, so the memory usage of
+        // this thread is added to cc, with which they will later be freed.
+        // The peak usage of the threads is bounded by the sum of their peaks.
+        #pragma omp critical (spqr_batch)
+        {
+            flops += tflops ;
+            malloc_count += Cm.malloc_count ;
+            memory_inuse += Cm.memory_inuse ;
+            memory_usage += Cm.memory_usage ;
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // free the shared analysis, and return the status and statistics
+    // -------------------------------------------------------------------------
+
+    spqr_freefac (&QR0, &Cm0) ;
+
+    // The peak usage is that of the analysis itself, or of the analysis
+    // together with all the threads.
+    cc->memory_usage = MAX (cc->memory_usage, cc->memory_inuse +
+        MAX (Cm0.memory_usage, shared + memory_usage)) ;
+    cc->malloc_count += malloc_count ;
+    cc->memory_inuse += memory_inuse ;
+    cc->SPQR_flopcount = flops ;
+
+    if (status < CHOLMOD_OK)
+    {
+        // the error has already been reported, by the thread that found it
+        cc->status = status ;
+        return (FALSE) ;
+    }
+    return (TRUE) ;
+}
+
+// =============================================================================
+
+template int SuiteSparseQR_batch <double>
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol treated as zero
+    int same_pattern,       // if TRUE, the problems share the pattern of A [0]
+    Long nbatch,            // number of problems
+    cholmod_sparse **A,     // size nbatch; A [k] is m(k)-by-n(k)
+    cholmod_dense **B,      // size nbatch; B [k] is m(k)-by-nrhs(k)
+    // output
+    cholmod_dense **X,      // size nbatch; X [k] is n(k)-by-nrhs(k), or NULL
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
+template int SuiteSparseQR_batch <Complex>
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol treated as zero
+    int same_pattern,       // if TRUE, the problems share the pattern of A [0]
+    Long nbatch,            // number of problems
+    cholmod_sparse **A,     // size nbatch; A [k] is m(k)-by-n(k)
+    cholmod_dense **B,      // size nbatch; B [k] is m(k)-by-nrhs(k)
+    // output
+    cholmod_dense **X,      // size nbatch; X [k] is n(k)-by-nrhs(k), or NULL
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
+#endif
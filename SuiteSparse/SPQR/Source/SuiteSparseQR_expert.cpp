@@ -36,6 +36,9 @@
 
 #ifndef NEXPERT
 #include "spqr.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 // =============================================================================
 // === SuiteSparseQR_symbolic ==================================================
@@ -43,6 +46,14 @@
 
 // This returns a QR factorization object with a NULL numeric part.  It must
 // be followed by a numeric factorization, by SuiteSparseQR_numeric.
+//
+// If regularize is TRUE, the pattern of [A ; lambda*I] is analyzed, where
+// lambda is any scalar given later to SuiteSparseQR_numeric.  The n rows of
+// lambda*I are never formed; they are added to the frontal matrices as the
+// rows of A are assembled.  The QR object then factorizes the (m+n)-by-n
+// matrix [A ; lambda*I], so Q is (m+n)-by-(m+n).  The numeric factorization
+// can be repeated for many values of lambda (a sweep of the Tikhonov or ridge
+// regularization parameter) with just this one symbolic analysis.
 
 template <typename Entry> 
 SuiteSparseQR_factorization <Entry> *SuiteSparseQR_symbolic
@@ -51,6 +62,7 @@ SuiteSparseQR_factorization <Entry> *SuiteSparseQR_symbolic
     int ordering,           // all, except 3:given treated as 0:fixed
     int allow_tol,          // if FALSE, tol is ignored by the numeric
                             // factorization, and no rank detection is performed
+    int regularize,         // if TRUE, analyze [A ; lambda*I] instead of A
     cholmod_sparse *A,      // sparse matrix to factorize (A->x ignored)
     cholmod_common *cc      // workspace and parameters
 )
@@ -86,7 +98,8 @@ SuiteSparseQR_factorization <Entry> *SuiteSparseQR_symbolic
     // Using SuiteSparseQR_symbolic followed by SuiteSparseQR_numeric requires
     // that the Householder vectors be kept, and thus the GPU will not be used.
     int keepH = TRUE ;
-    QR->QRsym = QRsym = spqr_analyze (A, ordering, NULL, allow_tol, keepH, cc) ;
+    QR->QRsym = QRsym = spqr_analyze (A, ordering, NULL, allow_tol, keepH,
+        regularize, cc) ;
 
     QR->QRnum = NULL ;          // allocated later, by numeric factorization
 
@@ -107,7 +120,7 @@ SuiteSparseQR_factorization <Entry> *SuiteSparseQR_symbolic
     QR->Rmap = NULL ;           // may be allocated by numeric factorization
     QR->RmapInv = NULL ;
 
-    QR->narows = A->nrow ;
+    QR->narows = A->nrow + (regularize ? A->ncol : 0) ;
     QR->nacols = A->ncol ;
     QR->bncols = 0 ;            // [A B] is not factorized
 
@@ -150,6 +163,46 @@ SuiteSparseQR_factorization <Entry> *SuiteSparseQR_symbolic
     return (QR) ;
 }
 
+// symbolic analysis of A alone
+template <typename Entry> 
+SuiteSparseQR_factorization <Entry> *SuiteSparseQR_symbolic
+(
+    // inputs:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    int allow_tol,          // if FALSE, tol is ignored by the numeric
+                            // factorization, and no rank detection is performed
+    cholmod_sparse *A,      // sparse matrix to factorize (A->x ignored)
+    cholmod_common *cc      // workspace and parameters
+)
+{
+    return (SuiteSparseQR_symbolic <Entry> (ordering, allow_tol, FALSE, A,
+        cc)) ;
+}
+
+template
+SuiteSparseQR_factorization <double> *SuiteSparseQR_symbolic <double>
+(
+    // inputs:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    int allow_tol,          // if FALSE, tol is ignored by the numeric
+                            // factorization, and no rank detection is performed
+    int regularize,         // if TRUE, analyze [A ; lambda*I] instead of A
+    cholmod_sparse *A,      // sparse matrix to factorize (A->x ignored)
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+template
+SuiteSparseQR_factorization <Complex> *SuiteSparseQR_symbolic <Complex>
+(
+    // inputs:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    int allow_tol,          // if FALSE, tol is ignored by the numeric
+                            // factorization, and no rank detection is performed
+    int regularize,         // if TRUE, analyze [A ; lambda*I] instead of A
+    cholmod_sparse *A,      // sparse matrix to factorize (A->x ignored)
+    cholmod_common *cc      // workspace and parameters
+) ;
+
 template
 SuiteSparseQR_factorization <double> *SuiteSparseQR_symbolic <double>
 (
@@ -185,11 +238,16 @@ SuiteSparseQR_factorization <Complex> *SuiteSparseQR_symbolic <Complex>
 //
 // The GPU is not used by this function, since it requires the Householder
 // vectors to be kept.
+//
+// If the QR object was analyzed with regularize TRUE, [A ; lambda*I] is
+// factorized, and the default tol is the one spqr_tol would compute for
+// [A ; lambda*I] (it depends on lambda).  Otherwise, lambda must be zero.
 
 template <typename Entry> int SuiteSparseQR_numeric
 (
     // inputs:
     double tol,             // treat columns with 2-norm <= tol as zero
+    double lambda,          // regularization parameter
     cholmod_sparse *A,      // sparse matrix to factorize
     // input/output
     SuiteSparseQR_factorization <Entry> *QR,
@@ -213,6 +271,13 @@ template <typename Entry> int SuiteSparseQR_numeric
         return (FALSE) ;
     }
 
+    if (lambda != 0 && (QR->QRsym == NULL || !(QR->QRsym->regularize)))
+    {
+        // the rows of lambda*I were not included in the symbolic analysis
+        ERROR (CHOLMOD_INVALID, "QR not analyzed for regularization") ;
+        return (FALSE) ;
+    }
+
     Long n = A->ncol ;
 
     // -------------------------------------------------------------------------
@@ -222,7 +287,17 @@ template <typename Entry> int SuiteSparseQR_numeric
     if (QR->allow_tol)
     {
         // compute default tol, if requested
-        if (tol <= SPQR_DEFAULT_TOL)
+        if (tol <= SPQR_DEFAULT_TOL && QR->QRsym != NULL
+            && QR->QRsym->regularize)
+        {
+            // the default tol of [A ; lambda*I], which is (m+n)-by-n and
+            // whose jth column has 2-norm hypot (norm (A (:,j)), lambda)
+            double anorm = spqr_maxcolnorm <Entry> (A, cc) ;
+            tol = 20 * ((double) A->nrow + 2 * (double) n) * DBL_EPSILON *
+                SuiteSparse_config.hypot_func (anorm, lambda) ;
+            tol = MIN (tol, DBL_MAX) ;
+        }
+        else if (tol <= SPQR_DEFAULT_TOL)
         {
             tol = spqr_tol <Entry> (A, cc) ;
         }
@@ -242,7 +317,8 @@ template <typename Entry> int SuiteSparseQR_numeric
     spqr_freenum (&(QR->QRnum), cc) ;
 
     // compute the new factorization
-    QR->QRnum = spqr_factorize <Entry> (&A, FALSE, tol, n, QR->QRsym, cc) ;
+    QR->QRnum = spqr_factorize <Entry> (&A, FALSE, tol, n, lambda, QR->QRsym,
+        cc) ;
 
     if (cc->status < CHOLMOD_OK)
     {
@@ -277,6 +353,42 @@ template <typename Entry> int SuiteSparseQR_numeric
     return (TRUE) ;
 }
 
+template int SuiteSparseQR_numeric <double>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    double lambda,          // regularization parameter
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <double> *QR,
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+template int SuiteSparseQR_numeric <Complex>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    double lambda,          // regularization parameter
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <Complex> *QR,
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+// numeric QR factorization of A, with no regularization
+template <typename Entry> int SuiteSparseQR_numeric
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <Entry> *QR,
+    cholmod_common *cc      // workspace and parameters
+)
+{
+    return (SuiteSparseQR_numeric <Entry> (tol, 0, A, QR, cc)) ;
+}
+
 template int SuiteSparseQR_numeric <double>
 (
     // inputs:
@@ -362,6 +474,80 @@ template SuiteSparseQR_factorization <Complex> *SuiteSparseQR_factorize<Complex>
     cholmod_common *cc
 ) ;
 
+// =============================================================================
+// === SuiteSparseQR_factorize (regularized) ===================================
+// =============================================================================
+
+// QR factorization of [A ; lambda*I], for the Tikhonov (ridge) regularized
+// least-squares problem min norm(A*x-b)^2 + lambda^2 * norm(x)^2, without
+// forming [A ; lambda*I].  Singletons are not exploited, so this is the same
+// as SuiteSparseQR_symbolic with regularize TRUE, followed by
+// SuiteSparseQR_numeric with the given lambda.  The resulting QR object can be
+// refactorized with other values of lambda by SuiteSparseQR_numeric.
+//
+// Q is (m+n)-by-(m+n).  The solution of the regularized problem is thus
+// x = E*(R\(Q'*[b ; zeros(n,1)])), where the first n rows of Q'*[b;0] are
+// kept (see SuiteSparseQR_qmult and SuiteSparseQR_solve).
+
+template <typename Entry>
+SuiteSparseQR_factorization <Entry> *SuiteSparseQR_factorize
+(
+    // inputs, not modified:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // treat columns with 2-norm <= tol as zero
+    double lambda,          // regularization parameter
+    cholmod_sparse *A,      // sparse matrix to factorize
+    cholmod_common *cc      // workspace and parameters
+)
+{
+    RETURN_IF_NULL_COMMON (NULL) ;
+    RETURN_IF_NULL (A, NULL) ;
+    Long xtype = spqr_type <Entry> ( ) ;
+    RETURN_IF_XTYPE_INVALID (A, NULL) ;
+    cc->status = CHOLMOD_OK ;
+
+    // same rank detection rule as spqr_1factor: tol in the open interval
+    // (SPQR_DEFAULT_TOL,0) disables it
+    int allow_tol = (tol >= 0 || tol <= SPQR_DEFAULT_TOL) ;
+
+    SuiteSparseQR_factorization <Entry> *QR ;
+    QR = SuiteSparseQR_symbolic <Entry> (ordering, allow_tol, TRUE, A, cc) ;
+    if (QR == NULL)
+    {
+        // out of memory
+        return (NULL) ;
+    }
+    if (!SuiteSparseQR_numeric <Entry> (tol, lambda, A, QR, cc))
+    {
+        // out of memory
+        spqr_freefac (&QR, cc) ;
+        return (NULL) ;
+    }
+    return (QR) ;
+}
+
+template SuiteSparseQR_factorization <double> *SuiteSparseQR_factorize <double>
+(
+    // inputs, not modified:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // treat columns with 2-norm <= tol as zero
+    double lambda,          // regularization parameter
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
+template SuiteSparseQR_factorization <Complex> *SuiteSparseQR_factorize<Complex>
+(
+    // inputs, not modified:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // treat columns with 2-norm <= tol as zero
+    double lambda,          // regularization parameter
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
 
 // =============================================================================
 // === spqr_private_rtsolve ====================================================
@@ -519,6 +705,12 @@ template <typename Entry> void spqr_private_rtsolve
     // === solve with the multifrontal rows of R ===============================
     // =========================================================================
 
+    if (spqr_rsolve_fronts (QR, TRUE, NULL, nrhs, 0, (Entry *) NULL, m, X, cc))
+    {
+        // the fronts have been solved with the blocked method
+        return ;
+    }
+
     Stair = NULL ;
     fm = 0 ;
     h = 0 ;
@@ -1001,12 +1193,169 @@ template <typename Entry> Long spqr_private_load_H_vectors
 }
 
 
+// =============================================================================
+// === spqr_private_Hwork ======================================================
+// =============================================================================
+
+// Everything needed to apply the Householder vectors of a set of fronts.  The
+// workspace holds nwork copies, one for each thread.
+
+template <typename Entry> struct spqr_private_Hwork
+{
+    int method ;            // 0,1,2,3
+    SuiteSparseQR_factorization <Entry> *QR ;
+    Long hchunk ;           // apply hchunk Householder vectors at a time
+    Long m ;                // leading dimension of X
+    Long m2 ;               // X2 is m2-by-n2 with leading dimension m
+    Long n2 ;
+    Entry *X2 ;
+
+    // workspace for thread t: H_Tau + t*maxfn, H_start + t*maxfn,
+    // H_end + t*maxfn, V + t*vsize, C + t*csize, and W + t*wsize
+    Long maxfn, vsize, csize, wsize ;
+    Entry *H_Tau ;
+    Long *H_start ;
+    Long *H_end ;
+    Entry *V ;
+    Entry *C ;
+    Entry *W ;
+} ;
+
+
+// =============================================================================
+// === spqr_private_Happly_front ===============================================
+// =============================================================================
+
+// Apply the Householder vectors of front f, using the workspace of thread t.
+
+template <typename Entry> void spqr_private_Happly_front
+(
+    Long f,
+    int t,
+    spqr_private_Hwork <Entry> *Hwork,
+    cholmod_common *cc
+)
+{
+    SuiteSparseQR_factorization <Entry> *QR = Hwork->QR ;
+    int method = Hwork->method ;
+    Long hchunk = Hwork->hchunk ;
+    Long *H_start = Hwork->H_start + t * Hwork->maxfn ;
+    Long *H_end   = Hwork->H_end   + t * Hwork->maxfn ;
+    Entry *H_Tau  = Hwork->H_Tau   + t * Hwork->maxfn ;
+    Entry *V      = Hwork->V       + t * Hwork->vsize ;
+    Entry *C      = Hwork->C       + t * Hwork->csize ;
+    Entry *W      = Hwork->W       + t * Hwork->wsize ;
+    Long h1, h2, v ;
+
+    // get the Householder vectors for front F
+    Long nh = spqr_private_get_H_vectors (f, QR, H_Tau, H_start, H_end, cc) ;
+    Entry *R = QR->QRnum->Rblock [f] ;
+    Long *Hi = &(QR->QRnum->Hii [QR->QRsym->Hip [f]]) ;   // row indices of H
+
+    if (method == SPQR_QTX || method == SPQR_XQ)
+    {
+        // apply the Householder vectors, one panel at a time, forwards
+        for (h1 = 0 ; h1 < nh ; h1 = h2)
+        {
+            // load vectors h1:h2-1 from R into the panel V and apply them
+            h2 = MIN (h1 + hchunk, nh) ;
+            v = spqr_private_load_H_vectors (h1, h2, H_start, H_end, R, V,
+                cc) ;
+            ASSERT (v+h1 <= QR->QRnum->Hm [f]) ;
+            spqr_panel (method, Hwork->m2, Hwork->n2, v, h2-h1, Hi+h1, V,
+                H_Tau+h1, Hwork->m, Hwork->X2, C, W, cc) ;
+        }
+    }
+    else
+    {
+        // apply the Householder vectors, one panel at a time, backwards
+        for (h2 = nh ; h2 > 0 ; h2 = h1)
+        {
+            // load vectors h1:h2-1 from R into the panel V and apply them
+            h1 = MAX (h2 - hchunk, 0) ;
+            v = spqr_private_load_H_vectors (h1, h2, H_start, H_end, R, V,
+                cc) ;
+            ASSERT (v+h1 <= QR->QRnum->Hm [f]) ;
+            spqr_panel (method, Hwork->m2, Hwork->n2, v, h2-h1, Hi+h1, V,
+                H_Tau+h1, Hwork->m, Hwork->X2, C, W, cc) ;
+        }
+    }
+}
+
+
+// =============================================================================
+// === spqr_private_Happly_task ================================================
+// =============================================================================
+
+// Apply the Householder vectors of all the fronts in a subtree of the task
+// tree.  Fronts in different subtrees have disjoint sets of rows of H, so the
+// subtrees of a task are done in parallel, as OpenMP tasks.  For Q'*X and X*Q
+// the subtrees are done first; for Q*X and X*Q' they are done last.  The
+// workspace of a thread is not in use at any task scheduling point.
+
+#ifdef _OPENMP
+template <typename Entry> void spqr_private_Happly_task
+(
+    Long task,
+    int do_fronts,          // if FALSE, do just the subtrees of this task
+    spqr_private_Hwork <Entry> *Hwork,
+    cholmod_common *cc
+)
+{
+    spqr_symbolic *QRsym = Hwork->QR->QRsym ;
+    Long *TaskChildp = QRsym->TaskChildp ;
+    Long *TaskChild  = QRsym->TaskChild ;
+    Long *TaskFrontp = QRsym->TaskFrontp ;
+    Long *TaskFront  = QRsym->TaskFront ;
+    int method = Hwork->method ;
+    int forward = (method == SPQR_QTX || method == SPQR_XQ) ;
+
+    if (!forward && do_fronts)
+    {
+        // apply the fronts of this task, in reverse postorder
+        int t = omp_get_thread_num ( ) ;
+        for (Long kf = TaskFrontp [task+1] - 1 ; kf >= TaskFrontp [task] ; kf--)
+        {
+            spqr_private_Happly_front (TaskFront [kf], t, Hwork, cc) ;
+        }
+    }
+
+    // do each subtree of this task in parallel
+    for (Long p = TaskChildp [task] ; p < TaskChildp [task+1] ; p++)
+    {
+        Long child = TaskChild [p] ;
+        #pragma omp task firstprivate (child)
+        spqr_private_Happly_task (child, TRUE, Hwork, cc) ;
+    }
+
+    if (forward)
+    {
+        // the subtrees must be done before the fronts of this task
+        #pragma omp taskwait
+        if (do_fronts)
+        {
+            // apply the fronts of this task, in postorder
+            int t = omp_get_thread_num ( ) ;
+            for (Long kf = TaskFrontp [task] ; kf < TaskFrontp [task+1] ; kf++)
+            {
+                spqr_private_Happly_front (TaskFront [kf], t, Hwork, cc) ;
+            }
+        }
+    }
+}
+#endif
+
+
 // =============================================================================
 // === spqr_private_Happly =====================================================
 // =============================================================================
 
 // Given a QR factorization from spqr_1factor, apply the Householder vectors
-// to a dense matrix X.
+// to a dense matrix X.  If nthreads > 1 and the QR object has a task tree
+// (Common->SPQR_grain > 1 when it was analyzed), the subtrees of the task
+// tree are done in parallel.  The fronts in the root task are done by all
+// the threads together, each panel split across the columns (or rows) of X
+// by spqr_panel.
 
 template <typename Entry> void spqr_private_Happly
 (
@@ -1014,6 +1363,7 @@ template <typename Entry> void spqr_private_Happly
     int method,             // 0,1,2,3
     SuiteSparseQR_factorization <Entry> *QR,
     Long hchunk,            // apply hchunk Householder vectors at a time
+    int nthreads,           // number of threads to use
 
     // input/output
     Long m,
@@ -1021,7 +1371,7 @@ template <typename Entry> void spqr_private_Happly
     Entry *X,               // size m-by-n with leading dimension m; only
                             // X (n1rows:m-1,:) or X (:,n1rows:n-1) is modified
 
-    // workspace, not defined on input or output
+    // workspace, not defined on input or output.  nthreads copies of each:
     Entry *H_Tau,           // size QRsym->maxfn
     Long *H_start,          // size QRsym->maxfn
     Long *H_end,            // size QRsym->maxfn
@@ -1034,24 +1384,19 @@ template <typename Entry> void spqr_private_Happly
 {
 
     spqr_symbolic *QRsym ;
-    spqr_numeric <Entry> *QRnum ;
-    Entry **Rblock, *R, *X2 ;
-    Long *Hii, *Hip, *Hi ;
-    Long nf, f, nh, h1, h2, v, n1rows, m2, n2 ;
+    spqr_private_Hwork <Entry> Hwork ;
+    Long nf, f, n1rows, v ;
 
     // -------------------------------------------------------------------------
     // get the contents of the QR factorization
     // -------------------------------------------------------------------------
 
     QRsym = QR->QRsym ;
-    QRnum = QR->QRnum ;
-    ASSERT (QRnum->keepH) ;
+    ASSERT (QR->QRnum->keepH) ;
     nf = QRsym->nf ;
-    Rblock = QRnum->Rblock ;
-    Hii = QRnum->Hii ;
-    Hip = QRsym->Hip ;
     ASSERT (QR->narows == ((method <= SPQR_QX) ? m : n)) ;
     n1rows = QR->n1rows ;
+    v = QR->QRnum->maxfm ;
 
     // -------------------------------------------------------------------------
     // operate on X (n1rows:m-1,:) or X (:,n1rows:n-1)
@@ -1061,82 +1406,139 @@ template <typename Entry> void spqr_private_Happly
     // singleton rows which are not part of the multifrontal part of the
     // QR factorization.
 
+    Hwork.method = method ;
+    Hwork.QR = QR ;
+    Hwork.hchunk = hchunk ;
+    Hwork.m = m ;
     if (method == SPQR_QTX || method == SPQR_QX)
     {
         // Q*X or Q'*X
-        X2 = X + n1rows ;
-        n2 = n ;
-        m2 = m - n1rows ;
+        Hwork.X2 = X + n1rows ;
+        Hwork.n2 = n ;
+        Hwork.m2 = m - n1rows ;
     }
     else
     {
-        X2 = X + n1rows * m ;
-        n2 = n - n1rows ; 
-        m2 = m ;
+        Hwork.X2 = X + n1rows * m ;
+        Hwork.n2 = n - n1rows ; 
+        Hwork.m2 = m ;
     }
 
+    Hwork.maxfn = QRsym->maxfn ;
+    Hwork.vsize = v * hchunk ;
+    Hwork.csize = v * ((method <= SPQR_QX) ? n : m) ;
+    Hwork.wsize = hchunk * (hchunk + ((method <= SPQR_QX) ? n : m)) ;
+    Hwork.H_Tau = H_Tau ;
+    Hwork.H_start = H_start ;
+    Hwork.H_end = H_end ;
+    Hwork.V = V ;
+    Hwork.C = C ;
+    Hwork.W = W ;
+
     // -------------------------------------------------------------------------
     // apply the Householder vectors
     // -------------------------------------------------------------------------
 
-    if (method == SPQR_QTX || method == SPQR_XQ)
+#ifdef _OPENMP
+    Long ntasks = QRsym->ntasks ;
+    if (nthreads > 1 && ntasks > 1 && QRsym->TaskFront != NULL)
     {
-
-        // ---------------------------------------------------------------------
-        // apply in forward direction
-        // ---------------------------------------------------------------------
-
-        for (f = 0 ; f < nf ; f++)
+        // the root task ntasks-1 is done outside the parallel region, so
+        // that spqr_panel can use all the threads for its large fronts
+        Long root = ntasks-1 ;
+        if (method == SPQR_QX || method == SPQR_XQT)
         {
-            // get the Householder vectors for front F
-            nh = spqr_private_get_H_vectors (f, QR, H_Tau, H_start, H_end, cc) ;
-            R = Rblock [f] ;
-            Hi = &Hii [Hip [f]] ;               // list of row indices of H
-
-            // apply the Householder vectors, one panel at a time
-            for (h1 = 0 ; h1 < nh ; h1 = h2)
+            for (Long kf = QRsym->TaskFrontp [root+1] - 1 ;
+                kf >= QRsym->TaskFrontp [root] ; kf--)
             {
-                // load vectors h1:h2-1 from R into the panel V and apply them
-                h2 = MIN (h1 + hchunk, nh) ;
-                v = spqr_private_load_H_vectors (h1, h2, H_start, H_end, R, V,
+                spqr_private_Happly_front (QRsym->TaskFront [kf], 0, &Hwork,
                     cc) ;
-                ASSERT (v+h1 <= QR->QRnum->Hm [f]) ;
-                spqr_panel (method, m2, n2, v, h2-h1, Hi+h1, V, H_Tau+h1,
-                    m, X2, C, W, cc) ;
             }
         }
+        #pragma omp parallel num_threads (nthreads)
+        #pragma omp single
+        spqr_private_Happly_task (root, FALSE, &Hwork, cc) ;
+        if (method == SPQR_QTX || method == SPQR_XQ)
+        {
+            for (Long kf = QRsym->TaskFrontp [root] ;
+                kf < QRsym->TaskFrontp [root+1] ; kf++)
+            {
+                spqr_private_Happly_front (QRsym->TaskFront [kf], 0, &Hwork,
+                    cc) ;
+            }
+        }
+        return ;
+    }
+#endif
+
+    if (method == SPQR_QTX || method == SPQR_XQ)
+    {
+        // apply in forward direction
+        for (f = 0 ; f < nf ; f++)
+        {
+            spqr_private_Happly_front (f, 0, &Hwork, cc) ;
+        }
     }
     else
     {
-
-        // ---------------------------------------------------------------------
         // apply in backward direction
-        // ---------------------------------------------------------------------
-
         for (f = nf-1 ; f >= 0 ; f--)
         {
-
-            // get the Householder vectors for front F
-            nh = spqr_private_get_H_vectors (f, QR, H_Tau, H_start, H_end, cc) ;
-            R = Rblock [f] ;
-            Hi = &Hii [Hip [f]] ;               // list of row indices of H
-
-            // apply the Householder vectors, one panel at a time
-            for (h2 = nh ; h2 > 0 ; h2 = h1)
-            {
-                // load vectors h1:h2-1 from R into the panel V and apply them
-                h1 = MAX (h2 - hchunk, 0) ;
-                v = spqr_private_load_H_vectors (h1, h2, H_start, H_end, R, V,
-                    cc) ;
-                ASSERT (v+h1 <= QR->QRnum->Hm [f]) ;
-                spqr_panel (method, m2, n2, v, h2-h1, Hi+h1, V, H_Tau+h1,
-                    m, X2, C, W, cc) ;
-            }
+            spqr_private_Happly_front (f, 0, &Hwork, cc) ;
         }
     }
 }
 
 
+// =============================================================================
+
+template void spqr_private_Happly <double>
+(
+    // inputs
+    int method,             // 0,1,2,3
+    SuiteSparseQR_factorization <double> *QR,
+    Long hchunk,            // apply hchunk Householder vectors at a time
+    int nthreads,           // number of threads to use
+
+    // input/output
+    Long m,
+    Long n,
+    double *X,              // size m-by-n with leading dimension m
+
+    // workspace, not defined on input or output.  nthreads copies of each:
+    double *H_Tau,          // size QRsym->maxfn
+    Long *H_start,          // size QRsym->maxfn
+    Long *H_end,            // size QRsym->maxfn
+    double *V,              // size v-by-hchunk, where v = QRnum->maxfm
+    double *C,              // size: method 0,1: v*n,     method 2,3: m*v
+    double *W,              // size: method 0,1: h*h+n*h, method 2,3: h*h+m*h
+    cholmod_common *cc
+) ;
+
+template void spqr_private_Happly <Complex>
+(
+    // inputs
+    int method,             // 0,1,2,3
+    SuiteSparseQR_factorization <Complex> *QR,
+    Long hchunk,            // apply hchunk Householder vectors at a time
+    int nthreads,           // number of threads to use
+
+    // input/output
+    Long m,
+    Long n,
+    Complex *X,             // size m-by-n with leading dimension m
+
+    // workspace, not defined on input or output.  nthreads copies of each:
+    Complex *H_Tau,         // size QRsym->maxfn
+    Long *H_start,          // size QRsym->maxfn
+    Long *H_end,            // size QRsym->maxfn
+    Complex *V,             // size v-by-hchunk, where v = QRnum->maxfm
+    Complex *C,             // size: method 0,1: v*n,     method 2,3: m*v
+    Complex *W,             // size: method 0,1: h*h+n*h, method 2,3: h*h+m*h
+    cholmod_common *cc
+) ;
+
+
 // =============================================================================
 // === SuiteSparseQR_qmult (dense case) ========================================
 // =============================================================================
@@ -1157,9 +1559,9 @@ template <typename Entry> void spqr_private_Happly
     cholmod_l_free_dense (&Vdense, cc) ; \
     cholmod_l_free_dense (&Wdense, cc) ; \
     cholmod_l_free_dense (&Cdense, cc) ; \
-    cholmod_l_free (maxfn, sizeof (Entry), H_Tau,   cc) ; \
-    cholmod_l_free (maxfn, sizeof (Long),  H_start, cc) ; \
-    cholmod_l_free (maxfn, sizeof (Long),  H_end,   cc) ; \
+    cholmod_l_free (hsize, sizeof (Entry), H_Tau,   cc) ; \
+    cholmod_l_free (hsize, sizeof (Long),  H_start, cc) ; \
+    cholmod_l_free (hsize, sizeof (Long),  H_end,   cc) ; \
 }
 
 // returns Y of size m-by-n, or NULL on failure
@@ -1177,7 +1579,8 @@ template <typename Entry> cholmod_dense *SuiteSparseQR_qmult
     cholmod_dense *Ydense, *Cdense, *Vdense, *Wdense, *Zdense ;
     Entry *X, *Y, *X1, *Y1, *Z1, *C, *V, *Z, *W, *H_Tau ;
     Long *HPinv, *H_start, *H_end ;
-    Long i, k, mh, v, hchunk, ldx, m, n, maxfn, ok ;
+    Long i, k, mh, v, hchunk, ldx, m, n, maxfn, hsize, ncols, ok ;
+    int nthreads ;
 
     // -------------------------------------------------------------------------
     // get inputs
@@ -1263,16 +1666,43 @@ template <typename Entry> cholmod_dense *SuiteSparseQR_qmult
 
     hchunk = HCHUNK ;
     ASSERT (v <= mh) ;
+    ncols = (method <= SPQR_QX) ? n : m ;
 
-    // C is workspace of size v-by-n or m-by-v
-    Cdense = cholmod_l_allocate_dense (v, (method <= SPQR_QX) ? n : m,
-        v, xtype, cc) ;
+    // each thread needs its own workspace if the subtrees of the task tree
+    // are done in parallel (see spqr_private_Happly)
+    nthreads = 1 ;
+#ifdef _OPENMP
+    if (cc->SPQR_nthreads > 1 && QR->QRsym->ntasks > 1)
+    {
+        nthreads = cc->SPQR_nthreads ;
+    }
+#endif
+
+    // C is workspace of size v-by-n or m-by-v, for each thread
+    Cdense = cholmod_l_allocate_dense (v, ncols * nthreads, v, xtype, cc) ;
     Vdense = NULL ;
     Wdense = NULL ;
 
-    H_Tau   = (Entry *) cholmod_l_malloc (maxfn, sizeof (Entry), cc) ;
-    H_start = (Long *)  cholmod_l_malloc (maxfn, sizeof (Long),  cc) ;
-    H_end   = (Long *)  cholmod_l_malloc (maxfn, sizeof (Long),  cc) ;
+    hsize = maxfn * nthreads ;
+    H_Tau   = (Entry *) cholmod_l_malloc (hsize, sizeof (Entry), cc) ;
+    H_start = (Long *)  cholmod_l_malloc (hsize, sizeof (Long),  cc) ;
+    H_end   = (Long *)  cholmod_l_malloc (hsize, sizeof (Long),  cc) ;
+
+    if (nthreads > 1 && cc->status < CHOLMOD_OK)
+    {
+        // out of memory; try again with a single thread
+        cholmod_l_free_dense (&Cdense, cc) ;
+        cholmod_l_free (hsize, sizeof (Entry), H_Tau,   cc) ;
+        cholmod_l_free (hsize, sizeof (Long),  H_start, cc) ;
+        cholmod_l_free (hsize, sizeof (Long),  H_end,   cc) ;
+        cc->status = CHOLMOD_OK ;
+        nthreads = 1 ;
+        hsize = maxfn ;
+        Cdense = cholmod_l_allocate_dense (v, ncols, v, xtype, cc) ;
+        H_Tau   = (Entry *) cholmod_l_malloc (hsize, sizeof (Entry), cc) ;
+        H_start = (Long *)  cholmod_l_malloc (hsize, sizeof (Long),  cc) ;
+        H_end   = (Long *)  cholmod_l_malloc (hsize, sizeof (Long),  cc) ;
+    }
 
     if (!ok || Cdense == NULL || cc->status < CHOLMOD_OK)
     {
@@ -1308,12 +1738,13 @@ template <typename Entry> cholmod_dense *SuiteSparseQR_qmult
     // allocate O(hchunk) workspace
     // -------------------------------------------------------------------------
 
-    // V is workspace of size v-by-hchunk
-    Vdense = cholmod_l_allocate_dense (v, hchunk, v, xtype, cc) ;
+    // V is workspace of size v-by-hchunk, for each thread
+    Vdense = cholmod_l_allocate_dense (v, hchunk * nthreads, v, xtype, cc) ;
 
-    // W is workspace of size h*h+n*h or h*h+m*h where h = hchunk
-    Wdense = cholmod_l_allocate_dense (hchunk,
-        hchunk + ((method <= SPQR_QX) ? n : m), hchunk, xtype, cc) ;
+    // W is workspace of size h*h+n*h or h*h+m*h where h = hchunk, for each
+    // thread
+    Wdense = cholmod_l_allocate_dense (hchunk, (hchunk + ncols) * nthreads,
+        hchunk, xtype, cc) ;
 
     // -------------------------------------------------------------------------
     // punt if out of memory
@@ -1321,16 +1752,17 @@ template <typename Entry> cholmod_dense *SuiteSparseQR_qmult
 
     if (Vdense == NULL || Wdense == NULL)
     {
-        // PUNT: out of memory; try again with hchunk = 1
+        // PUNT: out of memory; try again with hchunk = 1 and one thread
         cc->status = CHOLMOD_OK ;
         hchunk = 1 ;
+        nthreads = 1 ;
 
         cholmod_l_free_dense (&Vdense, cc) ;
         cholmod_l_free_dense (&Wdense, cc) ;
 
         Vdense = cholmod_l_allocate_dense (v, hchunk, v, xtype, cc) ;
-        Wdense = cholmod_l_allocate_dense (hchunk,
-            hchunk + ((method <= SPQR_QX) ? n : m), hchunk, xtype, cc) ;
+        Wdense = cholmod_l_allocate_dense (hchunk, hchunk + ncols, hchunk,
+            xtype, cc) ;
 
         if (Vdense == NULL || Wdense == NULL)
         {
@@ -1375,8 +1807,8 @@ template <typename Entry> cholmod_dense *SuiteSparseQR_qmult
         }
 
         // apply H to Y
-        spqr_private_Happly (method, QR, hchunk, m, n, Y, H_Tau, H_start, H_end,
-            V, C, W, cc) ;
+        spqr_private_Happly (method, QR, hchunk, nthreads, m, n, Y, H_Tau,
+            H_start, H_end, V, C, W, cc) ;
 
     }
     else if (method == SPQR_QX)
@@ -1387,8 +1819,8 @@ template <typename Entry> cholmod_dense *SuiteSparseQR_qmult
         // ---------------------------------------------------------------------
 
         // apply H to Z
-        spqr_private_Happly (method, QR, hchunk, m, n, Z, H_Tau, H_start, H_end,
-            V, C, W, cc) ;
+        spqr_private_Happly (method, QR, hchunk, nthreads, m, n, Z, H_Tau,
+            H_start, H_end, V, C, W, cc) ;
 
         // Y = Z (P,:)
         Z1 = Z ;
@@ -1412,8 +1844,8 @@ template <typename Entry> cholmod_dense *SuiteSparseQR_qmult
         // ---------------------------------------------------------------------
 
         // apply H to Z
-        spqr_private_Happly (method, QR, hchunk, m, n, Z, H_Tau, H_start, H_end,
-            V, C, W, cc) ;
+        spqr_private_Happly (method, QR, hchunk, nthreads, m, n, Z, H_Tau,
+            H_start, H_end, V, C, W, cc) ;
 
         // Y = Z (:,P)
         Y1 = Y ;
@@ -1448,8 +1880,8 @@ template <typename Entry> cholmod_dense *SuiteSparseQR_qmult
         }
 
         // apply H to Y
-        spqr_private_Happly (method, QR, hchunk, m, n, Y, H_Tau, H_start, H_end,
-            V, C, W, cc) ;
+        spqr_private_Happly (method, QR, hchunk, nthreads, m, n, Y, H_Tau,
+            H_start, H_end, V, C, W, cc) ;
 
     }
 
@@ -0,0 +1,1034 @@
+// =============================================================================
+// === SuiteSparseQR_rowupdate =================================================
+// =============================================================================
+
+// Updates the Q-less QR factorization [C,R,E] = qr(A,B) computed by
+// SuiteSparseQR when new rows A2 and B2 are appended to A and B.  In MATLAB
+// notation, with A*E = Q*R and C = Q'*B:
+//
+//      [C,R] = qr ([R ; A2*E], [C ; B2])
+//
+// This is the least-squares solution of [A;A2]*x = [B;B2], without refactorizing
+// [A;A2] and without Q: the solution is x = E*(R\C) with the updated R and C.
+// C is optional; if C is NULL, only R is updated (B2 is then ignored).
+//
+// Each new row is merged into R by a sequence of sparse Givens rotations, one
+// for each leading nonzero of the row, in increasing column order.  Rotating
+// the row with row i of R (the row of R whose leading entry is in the same
+// column) zeros the leading entry of the new row and gives both rows the union
+// of their patterns.  If no row of R leads in that column, the remaining new
+// row becomes a new row of R.
+//
+// R and C are held in a SuiteSparseQR_rowfactorization object, which keeps R
+// in row form, in a pool of rows.  A rotated row is written to the end of the
+// pool, and its old copy becomes garbage; the pool is compacted when it runs
+// out of space, which costs no more than the entries written since the last
+// compaction.  The work to append k rows of A2 to the object is thus the fill
+// they cause in the rows of R they are rotated with, plus O(nnz(A2)+n+k) to
+// transpose A2; it does not depend on nnz(R).  The functions are:
+//
+//      SuiteSparseQR_rowupdate_start   copy R and C into a new object,
+//                                      O(nnz(R)) time, done once
+//      SuiteSparseQR_rowupdate         append A2 and B2 to the object
+//      SuiteSparseQR_rowupdate_get     return R and C from the object,
+//                                      O(nnz(R)+n) time, as often as needed
+//      SuiteSparseQR_rowupdate_free    free the object
+//
+// SuiteSparseQR_rowupdate can also be given R and C themselves, in which case
+// it does all four steps, so it takes O(nnz(R)) time for each call.
+//
+// tol is a rank tolerance, as in SuiteSparseQR: when the rest of a new row
+// would become a new row of R, its leading entry is treated as zero (and is
+// discarded) if its magnitude is <= tol.  This keeps roundoff in a new row
+// that is linearly dependent on R from increasing the rank of R.  If tol <=
+// SPQR_DEFAULT_TOL, the default is 20*(e+k+n)*eps*(max column 2-norm of
+// [R;A2]), where e and k are the number of rows of R and A2.  This is the
+// tolerance spqr_tol would compute for [A;A2], except that the number of rows
+// of A (not known here) is replaced with e, the number of rows of R; the
+// column norms of R are those of A*E.  For an object, e includes the rows
+// appended so far, and the max column norm of R is bounded by that of the
+// input R and all of the rows appended to it.  If -2 < tol < 0, only exact
+// zeros are discarded.  For a rank-deficient R, use the same tol as the
+// SuiteSparseQR call that computed R (or the default for both).
+//
+// R must be upper trapezoidal (no two rows can have their leading entry in the
+// same column), as returned by SuiteSparseQR.  The R returned is kept in order
+// of the leading columns of its rows, so it remains upper trapezoidal.  R may
+// gain rows, up to one for each new row of A2 if the rank of R increases.
+// Rows of R and C with no leading entry (rows beyond the rank of R, if econ >
+// rank) are kept at the bottom.  The permutation E is not modified.
+//
+// Returns TRUE if successful, FALSE otherwise.  If SuiteSparseQR_rowupdate
+// fails for an object (out of memory), the object is no longer valid and can
+// only be freed.  If it fails when given R and C, they are not modified.
+
+#include "spqr.hpp"
+
+// =============================================================================
+// === spqr_private_heap_push/pop ==============================================
+// =============================================================================
+
+// A binary min-heap of column indices, for the pattern of the new row.
+
+inline void spqr_private_heap_push (Long *Heap, Long *nheap, Long k)
+{
+    Long i = (*nheap)++ ;
+    while (i > 0)
+    {
+        Long parent = (i-1) / 2 ;
+        if (Heap [parent] <= k) break ;
+        Heap [i] = Heap [parent] ;
+        i = parent ;
+    }
+    Heap [i] = k ;
+}
+
+inline Long spqr_private_heap_pop (Long *Heap, Long *nheap)
+{
+    Long kmin = Heap [0] ;
+    Long k = Heap [--(*nheap)] ;
+    Long n = *nheap, i = 0 ;
+    while (TRUE)
+    {
+        Long child = 2*i + 1 ;
+        if (child >= n) break ;
+        if (child + 1 < n && Heap [child+1] < Heap [child]) child++ ;
+        if (k <= Heap [child]) break ;
+        Heap [i] = Heap [child] ;
+        i = child ;
+    }
+    if (n > 0) Heap [i] = k ;
+    return (kmin) ;
+}
+
+// =============================================================================
+// === spqr_private_rowpool_compact ============================================
+// =============================================================================
+
+// Copy the rows of R into a new pool with room for at least plen more entries,
+// leaving the garbage behind.  The new pool has twice the space that the live
+// rows need, so the next compaction is paid for by the entries written before
+// it.  Returns FALSE if out of memory, in which case the old pool is kept.
+
+template <typename Entry> int spqr_private_rowpool_compact
+(
+    Long plen,
+    SuiteSparseQR_rowfactorization <Entry> *RF,
+    cholmod_common *cc
+)
+{
+    Long *Rowi, *Rowp = RF->Rowp, *Rowlen = RF->Rowlen ;
+    Entry *Rowx ;
+    Long poolsize, pool, i, p ;
+    int ok = TRUE ;
+
+    poolsize = spqr_add (spqr_mult (2, spqr_add (RF->rnz, plen, &ok), &ok),
+        RF->n, &ok) ;
+    if (!ok)
+    {
+        ERROR (CHOLMOD_TOO_LARGE, "problem too large") ;
+        return (FALSE) ;
+    }
+    Rowi = (Long  *) cholmod_l_malloc (poolsize, sizeof (Long),  cc) ;
+    Rowx = (Entry *) cholmod_l_malloc (poolsize, sizeof (Entry), cc) ;
+    if (cc->status < CHOLMOD_OK)
+    {
+        // out of memory
+        cholmod_l_free (poolsize, sizeof (Long),  Rowi, cc) ;
+        cholmod_l_free (poolsize, sizeof (Entry), Rowx, cc) ;
+        return (FALSE) ;
+    }
+
+    pool = 0 ;
+    for (i = 0 ; i < RF->nrow ; i++)
+    {
+        Long pstart = Rowp [i] ;
+        Rowp [i] = pool ;
+        for (p = pstart ; p < pstart + Rowlen [i] ; p++)
+        {
+            Rowi [pool] = RF->Rowi [p] ;
+            Rowx [pool] = RF->Rowx [p] ;
+            pool++ ;
+        }
+    }
+    ASSERT (pool == RF->rnz) ;
+
+    cholmod_l_free (RF->poolsize, sizeof (Long),  RF->Rowi, cc) ;
+    cholmod_l_free (RF->poolsize, sizeof (Entry), RF->Rowx, cc) ;
+    RF->Rowi = Rowi ;
+    RF->Rowx = Rowx ;
+    RF->poolsize = poolsize ;
+    RF->pool = pool ;
+    return (TRUE) ;
+}
+
+// =============================================================================
+// === SuiteSparseQR_rowupdate_free ============================================
+// =============================================================================
+
+template <typename Entry> int SuiteSparseQR_rowupdate_free
+(
+    SuiteSparseQR_rowfactorization <Entry> **RFhandle,
+    cholmod_common *cc
+)
+{
+    SuiteSparseQR_rowfactorization <Entry> *RF ;
+
+    RETURN_IF_NULL_COMMON (FALSE) ;
+    if (RFhandle == NULL || *RFhandle == NULL)
+    {
+        // nothing to do
+        return (TRUE) ;
+    }
+    RF = *RFhandle ;
+    Long n = RF->n ;
+
+    cholmod_l_free (RF->nrowmax, sizeof (Long), RF->Rowp,   cc) ;
+    cholmod_l_free (RF->nrowmax, sizeof (Long), RF->Rowlen, cc) ;
+    cholmod_l_free (RF->nrowmax * RF->nrhs, sizeof (Entry), RF->Cw, cc) ;
+    cholmod_l_free (RF->poolsize, sizeof (Long),  RF->Rowi, cc) ;
+    cholmod_l_free (RF->poolsize, sizeof (Entry), RF->Rowx, cc) ;
+    cholmod_l_free (4*n, sizeof (Long), RF->Lead, cc) ;
+    cholmod_l_free (n, sizeof (Entry), RF->W, cc) ;
+    cholmod_l_free (n, sizeof (char), RF->Mark, cc) ;
+
+    cholmod_l_free (1, sizeof (SuiteSparseQR_rowfactorization <Entry>), RF,
+        cc) ;
+    *RFhandle = NULL ;
+    return (TRUE) ;
+}
+
+// =============================================================================
+// === SuiteSparseQR_rowupdate_start ===========================================
+// =============================================================================
+
+// Copy R and C into a new object, in row form.  R and C are not modified.
+
+template <typename Entry>
+SuiteSparseQR_rowfactorization <Entry> *SuiteSparseQR_rowupdate_start
+(
+    // inputs, not modified
+    double tol,             // treat new leading entries <= tol as zero
+    cholmod_sparse *R,      // e-by-n sparse matrix R
+    cholmod_dense *C,       // e-by-nrhs dense matrix C; NULL if only R is
+                            // to be updated
+    Long *E,                // size n, permutation from SuiteSparseQR;
+                            // NULL if identity
+    cholmod_common *cc      // workspace and parameters
+)
+{
+    SuiteSparseQR_rowfactorization <Entry> *RF ;
+    cholmod_sparse *Rt ;
+    Entry *Rtx, *Cx ;
+    Long *Rtp, *Rti, *Lead, e, n, nrhs, nz, i, j, p, kk, pool ;
+    int ok = TRUE ;
+
+    // -------------------------------------------------------------------------
+    // get inputs
+    // -------------------------------------------------------------------------
+
+    RETURN_IF_NULL_COMMON (NULL) ;
+    RETURN_IF_NULL (R, NULL) ;
+    Long xtype = spqr_type <Entry> ( ) ;
+    RETURN_IF_XTYPE_INVALID (R, NULL) ;
+    if (C != NULL)
+    {
+        RETURN_IF_XTYPE_INVALID (C, NULL) ;
+    }
+    cc->status = CHOLMOD_OK ;
+
+    e = R->nrow ;
+    n = R->ncol ;
+    nrhs = (C == NULL) ? 0 : C->ncol ;
+    if (R->stype != 0 || (C != NULL && (Long) C->nrow != e))
+    {
+        ERROR (CHOLMOD_INVALID, "mismatched dimensions") ;
+        return (NULL) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // allocate the object
+    // -------------------------------------------------------------------------
+
+    RF = (SuiteSparseQR_rowfactorization <Entry> *)
+        cholmod_l_malloc (1, sizeof (SuiteSparseQR_rowfactorization <Entry>),
+        cc) ;
+    if (cc->status < CHOLMOD_OK)
+    {
+        // out of memory
+        return (NULL) ;
+    }
+
+    Rt = cholmod_l_transpose (R, 1, cc) ;
+    nz = (Rt == NULL) ? 0 : cholmod_l_nnz (Rt, cc) ;
+
+    RF->tol = tol ;
+    RF->norm = (tol <= SPQR_DEFAULT_TOL) ? spqr_maxcolnorm <Entry> (R, cc) : 0;
+    RF->m = e ;
+    RF->e = e ;
+    RF->n = n ;
+    RF->nrhs = nrhs ;
+    RF->nrow = e ;
+    RF->nrowmax = MAX (e, 1) ;
+    RF->poolsize = spqr_add (spqr_mult (2, nz, &ok), n, &ok) ;
+    RF->poolsize = MAX (RF->poolsize, 1) ;
+    RF->pool = 0 ;
+    RF->rnz = 0 ;
+    RF->stamp = 0 ;
+    RF->Rowp = NULL ;
+    RF->Rowlen = NULL ;
+    RF->Cw = NULL ;
+    RF->Rowi = NULL ;
+    RF->Rowx = NULL ;
+    RF->Lead = NULL ;
+    RF->W = NULL ;
+    RF->Mark = NULL ;
+
+    if (ok && Rt != NULL)
+    {
+        RF->Rowp   = (Long  *) cholmod_l_malloc (RF->nrowmax, sizeof (Long),
+            cc) ;
+        RF->Rowlen = (Long  *) cholmod_l_malloc (RF->nrowmax, sizeof (Long),
+            cc) ;
+        RF->Cw     = (nrhs == 0) ? NULL :
+                     (Entry *) cholmod_l_malloc (RF->nrowmax * nrhs,
+                     sizeof (Entry), cc) ;
+        RF->Rowi   = (Long  *) cholmod_l_malloc (RF->poolsize, sizeof (Long),
+            cc) ;
+        RF->Rowx   = (Entry *) cholmod_l_malloc (RF->poolsize, sizeof (Entry),
+            cc) ;
+        RF->Lead   = (Long  *) cholmod_l_malloc (4*n, sizeof (Long), cc) ;
+        RF->W      = (Entry *) cholmod_l_malloc (n, sizeof (Entry), cc) ;
+        RF->Mark   = (char  *) cholmod_l_calloc (n, sizeof (char), cc) ;
+    }
+    else if (!ok)
+    {
+        ERROR (CHOLMOD_TOO_LARGE, "problem too large") ;
+    }
+
+    if (cc->status < CHOLMOD_OK)
+    {
+        // out of memory, or problem too large
+        cholmod_l_free_sparse (&Rt, cc) ;
+        SuiteSparseQR_rowupdate_free <Entry> (&RF, cc) ;
+        return (NULL) ;
+    }
+
+    Lead     = RF->Lead ;           // size n, Lead [j] = row leading in col j
+    RF->Einv = Lead + n ;           // size n, inverse of E
+    RF->Heap = RF->Einv + n ;       // size n, pattern of the new row
+    RF->Flag = RF->Heap + n ;       // size n, pattern of a row of R
+
+    for (j = 0 ; j < n ; j++)
+    {
+        Lead [j] = EMPTY ;
+        RF->Flag [j] = EMPTY ;
+        RF->W [j] = 0 ;
+    }
+    for (j = 0 ; j < n ; j++)
+    {
+        RF->Einv [E ? E [j] : j] = j ;
+    }
+
+    // -------------------------------------------------------------------------
+    // copy R into the pool of rows, and find the leading column of each row
+    // -------------------------------------------------------------------------
+
+    Rtp = (Long *) Rt->p ;
+    Rti = (Long *) Rt->i ;
+    Rtx = (Entry *) Rt->x ;
+    pool = 0 ;
+    for (i = 0 ; i < e ; i++)
+    {
+        RF->Rowp [i] = pool ;
+        for (p = Rtp [i] ; p < Rtp [i+1] ; p++)
+        {
+            RF->Rowi [pool] = Rti [p] ;
+            RF->Rowx [pool] = Rtx [p] ;
+            pool++ ;
+        }
+        RF->Rowlen [i] = pool - RF->Rowp [i] ;
+        if (RF->Rowlen [i] > 0)
+        {
+            // the row indices of Rt are sorted, so the first entry leads
+            j = RF->Rowi [RF->Rowp [i]] ;
+            if (Lead [j] != EMPTY)
+            {
+                ok = FALSE ;
+            }
+            Lead [j] = i ;
+        }
+    }
+    RF->pool = pool ;
+    RF->rnz = pool ;
+    cholmod_l_free_sparse (&Rt, cc) ;
+
+    if (!ok)
+    {
+        ERROR (CHOLMOD_INVALID, "R is not upper trapezoidal") ;
+        SuiteSparseQR_rowupdate_free <Entry> (&RF, cc) ;
+        return (NULL) ;
+    }
+
+    if (C != NULL)
+    {
+        // Cw = C, held by rows
+        Cx = (Entry *) C->x ;
+        for (kk = 0 ; kk < nrhs ; kk++)
+        {
+            for (i = 0 ; i < e ; i++)
+            {
+                RF->Cw [i*nrhs + kk] = Cx [i + kk*C->d] ;
+            }
+        }
+    }
+
+    return (RF) ;
+}
+
+// =============================================================================
+// === SuiteSparseQR_rowupdate (object) ========================================
+// =============================================================================
+
+// Append the rows A2 and B2 to the factorization held in RF.
+
+template <typename Entry> int SuiteSparseQR_rowupdate
+(
+    // inputs, not modified
+    cholmod_sparse *A2,     // k-by-n sparse matrix of new rows of A
+    cholmod_dense *B2,      // k-by-nrhs dense matrix of new rows of B;
+                            // ignored if RF has no C
+    // input/output
+    SuiteSparseQR_rowfactorization <Entry> *RF,
+    cholmod_common *cc      // workspace and parameters
+)
+{
+    cholmod_sparse *A2t ;
+    Entry *W, *B2x, *Ax, *Cnew ;
+    Long *Rowp, *Rowlen, *Lead, *Einv, *Heap, *Flag, *Ap, *Ai ;
+    char *Mark ;
+    Long n, k, nrhs, nheap, r, p, i, j, jj, kk, pi, plen, pnew, need ;
+    double tol ;
+    int ok = TRUE ;
+
+    // -------------------------------------------------------------------------
+    // get inputs
+    // -------------------------------------------------------------------------
+
+    RETURN_IF_NULL_COMMON (FALSE) ;
+    RETURN_IF_NULL (A2, FALSE) ;
+    RETURN_IF_NULL (RF, FALSE) ;
+    Long xtype = spqr_type <Entry> ( ) ;
+    RETURN_IF_XTYPE_INVALID (A2, FALSE) ;
+    nrhs = RF->nrhs ;
+    if (nrhs > 0)
+    {
+        RETURN_IF_NULL (B2, FALSE) ;
+        RETURN_IF_XTYPE_INVALID (B2, FALSE) ;
+    }
+    cc->status = CHOLMOD_OK ;
+
+    n = RF->n ;
+    k = A2->nrow ;
+    if ((Long) A2->ncol != n || A2->stype != 0 ||
+        (nrhs > 0 && ((Long) B2->nrow != k || (Long) B2->ncol != nrhs)))
+    {
+        ERROR (CHOLMOD_INVALID, "mismatched dimensions") ;
+        return (FALSE) ;
+    }
+
+    if (k == 0)
+    {
+        // nothing to do
+        return (TRUE) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // get the rank tolerance
+    // -------------------------------------------------------------------------
+
+    tol = RF->tol ;
+    RF->m = spqr_add (RF->m, k, &ok) ;
+    if (tol <= SPQR_DEFAULT_TOL)
+    {
+        // the max column 2-norm of [R;A2] is at most the hypot of the two
+        double anorm = spqr_maxcolnorm <Entry> (A2, cc) ;
+        RF->norm = SuiteSparse_config.hypot_func (RF->norm, anorm) ;
+        tol = 20 * ((double) RF->m + (double) n) * DBL_EPSILON * RF->norm ;
+        tol = MIN (tol, DBL_MAX) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // make room for up to k more rows of R and C
+    // -------------------------------------------------------------------------
+
+    need = spqr_add (RF->nrow, k, &ok) ;
+    if (ok && need > RF->nrowmax)
+    {
+        Long nrowmax = MAX (need, spqr_mult (2, RF->nrowmax, &ok)) ;
+        Long csize = spqr_mult (nrowmax, nrhs, &ok) ;
+        if (!ok)
+        {
+            ERROR (CHOLMOD_TOO_LARGE, "problem too large") ;
+            return (FALSE) ;
+        }
+        Long  *Rowp2   = (Long  *) cholmod_l_malloc (nrowmax, sizeof (Long),
+            cc) ;
+        Long  *Rowlen2 = (Long  *) cholmod_l_malloc (nrowmax, sizeof (Long),
+            cc) ;
+        Entry *Cw2 = (nrhs == 0) ? NULL :
+            (Entry *) cholmod_l_malloc (csize, sizeof (Entry), cc) ;
+        if (cc->status < CHOLMOD_OK)
+        {
+            // out of memory; the object is unchanged
+            cholmod_l_free (nrowmax, sizeof (Long), Rowp2,   cc) ;
+            cholmod_l_free (nrowmax, sizeof (Long), Rowlen2, cc) ;
+            cholmod_l_free (csize, sizeof (Entry), Cw2, cc) ;
+            return (FALSE) ;
+        }
+        for (i = 0 ; i < RF->nrow ; i++)
+        {
+            Rowp2 [i] = RF->Rowp [i] ;
+            Rowlen2 [i] = RF->Rowlen [i] ;
+        }
+        for (p = 0 ; p < RF->nrow * nrhs ; p++)
+        {
+            Cw2 [p] = RF->Cw [p] ;
+        }
+        cholmod_l_free (RF->nrowmax, sizeof (Long), RF->Rowp,   cc) ;
+        cholmod_l_free (RF->nrowmax, sizeof (Long), RF->Rowlen, cc) ;
+        cholmod_l_free (RF->nrowmax * nrhs, sizeof (Entry), RF->Cw, cc) ;
+        RF->Rowp = Rowp2 ;
+        RF->Rowlen = Rowlen2 ;
+        RF->Cw = Cw2 ;
+        RF->nrowmax = nrowmax ;
+    }
+    else if (!ok)
+    {
+        ERROR (CHOLMOD_TOO_LARGE, "problem too large") ;
+        return (FALSE) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // get the rows of A2
+    // -------------------------------------------------------------------------
+
+    A2t = cholmod_l_transpose (A2, 1, cc) ;
+    if (cc->status < CHOLMOD_OK)
+    {
+        // out of memory
+        return (FALSE) ;
+    }
+
+    Rowp   = RF->Rowp ;
+    Rowlen = RF->Rowlen ;
+    Lead   = RF->Lead ;
+    Einv   = RF->Einv ;
+    Heap   = RF->Heap ;
+    Flag   = RF->Flag ;
+    W      = RF->W ;
+    Mark   = RF->Mark ;
+
+    // -------------------------------------------------------------------------
+    // merge each new row into R
+    // -------------------------------------------------------------------------
+
+    Ap = (Long *) A2t->p ;
+    Ai = (Long *) A2t->i ;
+    Ax = (Entry *) A2t->x ;
+    B2x = (nrhs == 0) ? NULL : ((Entry *) B2->x) ;
+
+    for (r = 0 ; ok && r < k ; r++)
+    {
+
+        // ---------------------------------------------------------------------
+        // scatter the rth new row into W, in the permuted column order of R
+        // ---------------------------------------------------------------------
+
+        nheap = 0 ;
+        for (p = Ap [r] ; p < Ap [r+1] ; p++)
+        {
+            j = Einv [Ai [p]] ;
+            if (!Mark [j])
+            {
+                Mark [j] = TRUE ;
+                spqr_private_heap_push (Heap, &nheap, j) ;
+            }
+            W [j] += Ax [p] ;
+        }
+
+        // the new row of C is held in Cw (nrow,:), where nrow < nrowmax
+        Long nrow = RF->nrow ;
+        Cnew = RF->Cw + nrow*nrhs ;
+        for (kk = 0 ; kk < nrhs ; kk++)
+        {
+            Cnew [kk] = B2x [r + kk*B2->d] ;
+        }
+
+        while (nheap > 0)
+        {
+
+            // -----------------------------------------------------------------
+            // get the leading entry of the new row
+            // -----------------------------------------------------------------
+
+            j = spqr_private_heap_pop (Heap, &nheap) ;
+            Entry wj = W [j] ;
+            W [j] = 0 ;
+            Mark [j] = FALSE ;
+            i = Lead [j] ;
+            if (wj == (Entry) 0 || (i == EMPTY && spqr_abs (wj, cc) <= tol))
+            {
+                // the entry is zero, or it would lead a new row of R but is
+                // below the rank tolerance; it is discarded
+                continue ;
+            }
+
+            // -----------------------------------------------------------------
+            // make sure the pool has space for one more row
+            // -----------------------------------------------------------------
+
+            plen = 1 + nheap + ((i == EMPTY) ? 0 : Rowlen [i]) ;
+            if (RF->pool + plen > RF->poolsize)
+            {
+                if (!spqr_private_rowpool_compact (plen, RF, cc))
+                {
+                    // out of memory, or problem too large
+                    ok = FALSE ;
+                    break ;
+                }
+            }
+            Long *Rowi = RF->Rowi ;
+            Entry *Rowx = RF->Rowx ;
+            Long pool = RF->pool ;
+            pnew = pool ;
+
+            if (i == EMPTY)
+            {
+
+                // -------------------------------------------------------------
+                // no row of R leads in column j; the new row joins R
+                // -------------------------------------------------------------
+
+                Rowi [pool] = j ;
+                Rowx [pool] = wj ;
+                pool++ ;
+                while (nheap > 0)
+                {
+                    jj = Heap [--nheap] ;
+                    Rowi [pool] = jj ;
+                    Rowx [pool] = W [jj] ;
+                    pool++ ;
+                    W [jj] = 0 ;
+                    Mark [jj] = FALSE ;
+                }
+                Rowp [nrow] = pnew ;
+                Rowlen [nrow] = pool - pnew ;
+                RF->rnz += Rowlen [nrow] ;
+                RF->pool = pool ;
+                Lead [j] = nrow ;
+                RF->nrow++ ;
+                break ;
+            }
+
+            // -----------------------------------------------------------------
+            // rotate row i of R and the new row to zero the new row in col j
+            // -----------------------------------------------------------------
+
+            pi = Rowp [i] ;
+            Entry a = Rowx [pi] ;
+            double anorm = spqr_abs (a, cc) ;
+            double bnorm = spqr_abs (wj, cc) ;
+            double rnorm = SuiteSparse_config.hypot_func (anorm, bnorm) ;
+            double c ;
+            Entry s ;
+            if (anorm == 0)
+            {
+                c = 0 ;
+                s = 1 ;
+                Rowx [pnew] = wj ;
+            }
+            else
+            {
+                c = anorm / rnorm ;
+                s = (a / anorm) * spqr_conj (wj) / rnorm ;
+                Rowx [pnew] = (a / anorm) * rnorm ;
+            }
+            Rowi [pnew] = j ;
+            pool++ ;
+            FLOP_COUNT (6 * (Rowlen [i] + nheap + nrhs)) ;
+
+            // entries in the pattern of row i of R (and maybe the new row)
+            Long stamp = ++(RF->stamp) ;
+            for (p = pi + 1 ; p < pi + Rowlen [i] ; p++)
+            {
+                jj = Rowi [p] ;
+                Flag [jj] = stamp ;
+                if (!Mark [jj])
+                {
+                    // fill-in in the new row
+                    Mark [jj] = TRUE ;
+                    spqr_private_heap_push (Heap, &nheap, jj) ;
+                }
+                Entry x = Rowx [p] ;
+                Entry y = W [jj] ;
+                Rowi [pool] = jj ;
+                Rowx [pool] = c * x + s * y ;
+                pool++ ;
+                W [jj] = c * y - spqr_conj (s) * x ;
+            }
+
+            // entries only in the pattern of the new row (fill-in in row i)
+            for (p = 0 ; p < nheap ; p++)
+            {
+                jj = Heap [p] ;
+                if (Flag [jj] != stamp)
+                {
+                    Entry y = W [jj] ;
+                    Rowi [pool] = jj ;
+                    Rowx [pool] = s * y ;
+                    pool++ ;
+                    W [jj] = c * y ;
+                }
+            }
+
+            // the old row i is left in the pool as garbage
+            RF->rnz += (pool - pnew) - Rowlen [i] ;
+            Rowp [i] = pnew ;
+            Rowlen [i] = pool - pnew ;
+            RF->pool = pool ;
+
+            // apply the same rotation to C (i,:) and the new row of C
+            Entry *Ci = RF->Cw + i*nrhs ;
+            for (kk = 0 ; kk < nrhs ; kk++)
+            {
+                Entry x = Ci [kk] ;
+                Entry y = Cnew [kk] ;
+                Ci   [kk] = c * x + s * y ;
+                Cnew [kk] = c * y - spqr_conj (s) * x ;
+            }
+        }
+
+        // if the new row was annihilated, what is left in Cw (nrow,:) is part
+        // of the residual, and is discarded
+    }
+
+    cholmod_l_free_sparse (&A2t, cc) ;
+    return (ok) ;
+}
+
+// =============================================================================
+// === SuiteSparseQR_rowupdate_get =============================================
+// =============================================================================
+
+// Return R and C from the object, which is not modified.  C is not returned
+// if Chandle is NULL, or if the object has no C.
+
+template <typename Entry> int SuiteSparseQR_rowupdate_get
+(
+    // input, not modified
+    SuiteSparseQR_rowfactorization <Entry> *RF,
+    // outputs
+    cholmod_sparse **Rhandle,   // the e-by-n sparse matrix R
+    cholmod_dense **Chandle,    // the e-by-nrhs dense matrix C
+    cholmod_common *cc      // workspace and parameters
+)
+{
+    cholmod_sparse *Rnew ;
+    cholmod_dense *Cnew ;
+    Entry *Rx, *Cx, *Rowx ;
+    Long *Rp, *Ri, *Rowi, *Rowp, *Rowlen, *Lead, *Order, *Cp ;
+    Long n, nrow, nrhs, nlive, enew, nz, i, j, kk, p ;
+
+    RETURN_IF_NULL_COMMON (FALSE) ;
+    RETURN_IF_NULL (RF, FALSE) ;
+    RETURN_IF_NULL (Rhandle, FALSE) ;
+    Long xtype = spqr_type <Entry> ( ) ;
+    cc->status = CHOLMOD_OK ;
+
+    n = RF->n ;
+    nrow = RF->nrow ;
+    nrhs = (Chandle == NULL) ? 0 : RF->nrhs ;
+    Rowi = RF->Rowi ;
+    Rowx = RF->Rowx ;
+    Rowp = RF->Rowp ;
+    Rowlen = RF->Rowlen ;
+    Lead = RF->Lead ;
+    Cp = RF->Heap ;             // column pointers of R, size n
+
+    Order = (Long *) cholmod_l_malloc (nrow+1, sizeof (Long), cc) ;
+    if (cc->status < CHOLMOD_OK)
+    {
+        // out of memory
+        return (FALSE) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // sort the rows of R by their leading column
+    // -------------------------------------------------------------------------
+
+    nlive = 0 ;
+    for (j = 0 ; j < n ; j++)
+    {
+        if (Lead [j] != EMPTY)
+        {
+            Order [nlive++] = Lead [j] ;
+        }
+    }
+    enew = MAX (RF->e, nlive) ;
+    kk = nlive ;
+    for (i = 0 ; i < nrow && kk < enew ; i++)
+    {
+        if (Rowlen [i] == 0)
+        {
+            // row i of R is empty
+            Order [kk++] = i ;
+        }
+    }
+    ASSERT (kk == enew) ;
+
+    // -------------------------------------------------------------------------
+    // construct the new R and C
+    // -------------------------------------------------------------------------
+
+    nz = RF->rnz ;
+    Rnew = cholmod_l_allocate_sparse (enew, n, nz, TRUE, TRUE, 0, xtype, cc) ;
+    Cnew = (nrhs == 0) ? NULL :
+        cholmod_l_allocate_dense (enew, nrhs, enew, xtype, cc) ;
+
+    if (cc->status < CHOLMOD_OK)
+    {
+        // out of memory
+        cholmod_l_free_sparse (&Rnew, cc) ;
+        cholmod_l_free_dense (&Cnew, cc) ;
+        cholmod_l_free (nrow+1, sizeof (Long), Order, cc) ;
+        return (FALSE) ;
+    }
+
+    // count the entries in each column of R
+    Rp = (Long *) Rnew->p ;
+    Ri = (Long *) Rnew->i ;
+    Rx = (Entry *) Rnew->x ;
+    for (j = 0 ; j <= n ; j++)
+    {
+        Rp [j] = 0 ;
+    }
+    for (kk = 0 ; kk < nlive ; kk++)
+    {
+        i = Order [kk] ;
+        for (p = Rowp [i] ; p < Rowp [i] + Rowlen [i] ; p++)
+        {
+            Rp [Rowi [p]]++ ;
+        }
+    }
+    spqr_cumsum (n, Rp) ;
+    for (j = 0 ; j < n ; j++)
+    {
+        Cp [j] = Rp [j] ;
+    }
+
+    // place the rows in order, so each column of R is sorted
+    for (kk = 0 ; kk < nlive ; kk++)
+    {
+        i = Order [kk] ;
+        for (p = Rowp [i] ; p < Rowp [i] + Rowlen [i] ; p++)
+        {
+            Long q = Cp [Rowi [p]]++ ;
+            Ri [q] = kk ;
+            Rx [q] = Rowx [p] ;
+        }
+    }
+
+    if (Cnew != NULL)
+    {
+        Cx = (Entry *) Cnew->x ;
+        for (kk = 0 ; kk < nrhs ; kk++)
+        {
+            for (i = 0 ; i < enew ; i++)
+            {
+                Cx [i + kk*enew] = RF->Cw [Order [i]*nrhs + kk] ;
+            }
+        }
+    }
+
+    cholmod_l_free (nrow+1, sizeof (Long), Order, cc) ;
+    *Rhandle = Rnew ;
+    if (Chandle != NULL)
+    {
+        *Chandle = Cnew ;
+    }
+    return (TRUE) ;
+}
+
+// =============================================================================
+// === SuiteSparseQR_rowupdate =================================================
+// =============================================================================
+
+// Update R and C themselves; see SuiteSparseQR_rowupdate_start for the
+// arguments.  On output, R and C are replaced with the updated matrices.
+
+template <typename Entry> int SuiteSparseQR_rowupdate
+(
+    // inputs, not modified
+    double tol,             // treat new leading entries <= tol as zero
+    cholmod_sparse *A2,     // k-by-n sparse matrix of new rows of A
+    cholmod_dense *B2,      // k-by-nrhs dense matrix of new rows of B
+    Long *E,                // size n, permutation from SuiteSparseQR;
+                            // NULL if identity
+    // input/output
+    cholmod_sparse **Rhandle,   // e-by-n sparse matrix R, replaced on output
+    cholmod_dense **Chandle,    // e-by-nrhs dense matrix C, replaced on output;
+                                // NULL if only R is to be updated
+    cholmod_common *cc      // workspace and parameters
+)
+{
+    SuiteSparseQR_rowfactorization <Entry> *RF ;
+    cholmod_sparse *R, *Rnew ;
+    cholmod_dense *C, *Cnew = NULL ;
+    int ok ;
+
+    RETURN_IF_NULL_COMMON (FALSE) ;
+    RETURN_IF_NULL (A2, FALSE) ;
+    RETURN_IF_NULL (Rhandle, FALSE) ;
+    R = *Rhandle ;
+    RETURN_IF_NULL (R, FALSE) ;
+    C = (Chandle == NULL) ? NULL : (*Chandle) ;
+    if (C != NULL)
+    {
+        RETURN_IF_NULL (B2, FALSE) ;
+    }
+    if ((Long) A2->ncol != (Long) R->ncol)
+    {
+        ERROR (CHOLMOD_INVALID, "mismatched dimensions") ;
+        return (FALSE) ;
+    }
+
+    if (A2->nrow == 0)
+    {
+        // nothing to do
+        return (TRUE) ;
+    }
+
+    RF = SuiteSparseQR_rowupdate_start <Entry> (tol, R, C, E, cc) ;
+    ok = (RF != NULL) && SuiteSparseQR_rowupdate <Entry> (A2, B2, RF, cc) &&
+        SuiteSparseQR_rowupdate_get <Entry> (RF, &Rnew,
+        (C == NULL) ? NULL : &Cnew, cc) ;
+    SuiteSparseQR_rowupdate_free <Entry> (&RF, cc) ;
+    if (!ok)
+    {
+        if (cc->status == CHOLMOD_OK)
+        {
+            ERROR (CHOLMOD_INVALID, "invalid input") ;
+        }
+        return (FALSE) ;
+    }
+
+    cholmod_l_free_sparse (Rhandle, cc) ;
+    *Rhandle = Rnew ;
+    if (C != NULL)
+    {
+        cholmod_l_free_dense (Chandle, cc) ;
+        *Chandle = Cnew ;
+    }
+    return (TRUE) ;
+}
+
+// =============================================================================
+
+template SuiteSparseQR_rowfactorization <double> *SuiteSparseQR_rowupdate_start
+(
+    // inputs, not modified
+    double tol,             // treat new leading entries <= tol as zero
+    cholmod_sparse *R,      // e-by-n sparse matrix R
+    cholmod_dense *C,       // e-by-nrhs dense matrix C, or NULL
+    Long *E,                // size n, permutation from SuiteSparseQR
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+template SuiteSparseQR_rowfactorization <Complex> *SuiteSparseQR_rowupdate_start
+(
+    // inputs, not modified
+    double tol,             // treat new leading entries <= tol as zero
+    cholmod_sparse *R,      // e-by-n sparse matrix R
+    cholmod_dense *C,       // e-by-nrhs dense matrix C, or NULL
+    Long *E,                // size n, permutation from SuiteSparseQR
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+template int SuiteSparseQR_rowupdate <double>
+(
+    // inputs, not modified
+    cholmod_sparse *A2,     // k-by-n sparse matrix of new rows of A
+    cholmod_dense *B2,      // k-by-nrhs dense matrix of new rows of B
+    // input/output
+    SuiteSparseQR_rowfactorization <double> *RF,
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+template int SuiteSparseQR_rowupdate <Complex>
+(
+    // inputs, not modified
+    cholmod_sparse *A2,     // k-by-n sparse matrix of new rows of A
+    cholmod_dense *B2,      // k-by-nrhs dense matrix of new rows of B
+    // input/output
+    SuiteSparseQR_rowfactorization <Complex> *RF,
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+template int SuiteSparseQR_rowupdate_get <double>
+(
+    // input, not modified
+    SuiteSparseQR_rowfactorization <double> *RF,
+    // outputs
+    cholmod_sparse **R,     // the e-by-n sparse matrix R
+    cholmod_dense **C,      // the e-by-nrhs dense matrix C, or NULL
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+template int SuiteSparseQR_rowupdate_get <Complex>
+(
+    // input, not modified
+    SuiteSparseQR_rowfactorization <Complex> *RF,
+    // outputs
+    cholmod_sparse **R,     // the e-by-n sparse matrix R
+    cholmod_dense **C,      // the e-by-nrhs dense matrix C, or NULL
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+template int SuiteSparseQR_rowupdate_free <double>
+(
+    SuiteSparseQR_rowfactorization <double> **RF,
+    cholmod_common *cc
+) ;
+
+template int SuiteSparseQR_rowupdate_free <Complex>
+(
+    SuiteSparseQR_rowfactorization <Complex> **RF,
+    cholmod_common *cc
+) ;
+
+template int SuiteSparseQR_rowupdate <double>
+(
+    // inputs, not modified
+    double tol,             // treat new leading entries <= tol as zero
+    cholmod_sparse *A2,     // k-by-n sparse matrix of new rows of A
+    cholmod_dense *B2,      // k-by-nrhs dense matrix of new rows of B
+    Long *E,                // size n, permutation from SuiteSparseQR
+    // input/output
+    cholmod_sparse **R,     // e-by-n sparse matrix R
+    cholmod_dense **C,      // e-by-nrhs dense matrix C, or NULL
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+template int SuiteSparseQR_rowupdate <Complex>
+(
+    // inputs, not modified
+    double tol,             // treat new leading entries <= tol as zero
+    cholmod_sparse *A2,     // k-by-n sparse matrix of new rows of A
+    cholmod_dense *B2,      // k-by-nrhs dense matrix of new rows of B
+    Long *E,                // size n, permutation from SuiteSparseQR
+    // input/output
+    cholmod_sparse **R,     // e-by-n sparse matrix R
+    cholmod_dense **C,      // e-by-nrhs dense matrix C, or NULL
+    cholmod_common *cc      // workspace and parameters
+) ;
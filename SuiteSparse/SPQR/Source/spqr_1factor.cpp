@@ -627,17 +627,17 @@ template <typename Entry> SuiteSparseQR_factorization <Entry> *spqr_1factor
     {
         // factorize A, with fill-reducing ordering already given in Q1fill
         QRsym = spqr_analyze (A, SPQR_ORDERING_GIVEN, Q1fill,
-            tol >= 0, keepH, cc) ;
+            tol >= 0, keepH, FALSE, cc) ;
         t1 = SuiteSparse_time ( ) ;
-        QRnum = spqr_factorize <Entry> (&A, FALSE, tol, n, QRsym, cc) ;
+        QRnum = spqr_factorize <Entry> (&A, FALSE, tol, n, 0, QRsym, cc) ;
     }
     else
     {
         // fill-reducing ordering is already applied to Y; free Y when loaded
         QRsym = spqr_analyze (Y, SPQR_ORDERING_FIXED, NULL,
-            tol >= 0, keepH, cc) ;
+            tol >= 0, keepH, FALSE, cc) ;
         t1 = SuiteSparse_time ( ) ;
-        QRnum = spqr_factorize <Entry> (&Y, TRUE, tol, n2, QRsym, cc) ;
+        QRnum = spqr_factorize <Entry> (&Y, TRUE, tol, n2, 0, QRsym, cc) ;
         // Y has been freed
         ASSERT (Y == NULL) ;
     }
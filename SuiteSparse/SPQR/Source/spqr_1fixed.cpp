@@ -9,8 +9,19 @@
 //  Returns a sparse matrix Y with column pointers allocated and initialized,
 //  but no values (nzmax(Y) is zero).  Y has n-n1cols+bncols columns, and
 //  m-n1rows rows.  B is empty and no singletons are found, Y is NULL.
+//
+//  The search for singletons is sequential, since each singleton depends on
+//  the rows taken by the ones before it, and it stops at the first column that
+//  is not a singleton.  If cc->SPQR_nthreads > 1 and A is large enough, the
+//  O(m) row permutation and the O(nnz(A)) row and column counts that follow
+//  it are done in parallel, with the same result as the sequential method.
 
 #include "spqr.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define FIXED_CHUNK 16384   // min # of rows or entries of A for each thread
 
 template <typename Entry> int spqr_1fixed
 (
@@ -43,7 +54,8 @@ template <typename Entry> int spqr_1fixed
     Long *P1inv, *R1p, *Yp, *Qrows, *Ap, *Ai ;
     char *Mark ;
     Entry *Ax ;
-    Long i, j, k, p, d, row, n1rows, n1cols, ynz, iold, inew, kk, m, n, xtype ;
+    Long i, j, k, p, d, row, n1rows, n1cols, iold, inew, kk, m, n, xtype ;
+    int nthreads ;
 
     // -------------------------------------------------------------------------
     // get inputs
@@ -57,6 +69,15 @@ template <typename Entry> int spqr_1fixed
     Ai = (Long *) A->i ;
     Ax = (Entry *) A->x ;
 
+    nthreads = 1 ;
+#ifdef _OPENMP
+    if (cc->SPQR_nthreads > 1 && !omp_in_parallel ( ))
+    {
+        nthreads = (int) MIN (cc->SPQR_nthreads, MAX (m, Ap [n]) / FIXED_CHUNK);
+        nthreads = MAX (nthreads, 1) ;
+    }
+#endif
+
     // set outputs to NULL in case of early return
     *p_R1p    = NULL ;
     *p_P1inv  = NULL ;
@@ -171,7 +192,6 @@ template <typename Entry> int spqr_1fixed
         // copy the column pointers of A for the first part of Y = [A B]
         // ---------------------------------------------------------------------
 
-        ynz = Ap [n] ;
         for (k = 0 ; k <= n ; k++)
         {
             Yp [k] = Ap [k] ;
@@ -204,9 +224,22 @@ template <typename Entry> int spqr_1fixed
 
         Yp = (Long *) Y->p ;
 
-#ifndef NDEBUG
-        for (i = 0 ; i < m ; i++) P1inv [i] = EMPTY ;
-#endif
+        // the rows that are not singleton rows are placed last, in order:
+        // P1inv [i] = n1rows + (# of non-singleton rows before row i)
+        #pragma omp parallel for num_threads(nthreads) schedule(static) \
+            if (nthreads > 1)
+        for (Long i2 = 0 ; i2 < m ; i2++)
+        {
+            P1inv [i2] = !Mark [i2] ;
+        }
+        kk = spqr_pcumsum (m, nthreads, P1inv) ;
+        ASSERT (kk == m - n1rows) ;
+        #pragma omp parallel for num_threads(nthreads) schedule(static) \
+            if (nthreads > 1)
+        for (Long i2 = 0 ; i2 < m ; i2++)
+        {
+            P1inv [i2] += n1rows ;
+        }
 
         kk = 0 ;
         for (k = 0 ; k < n1cols ; k++)
@@ -216,22 +249,11 @@ template <typename Entry> int spqr_1fixed
             {
                 // row i is the kk-th singleton row
                 ASSERT (Mark [i]) ;
-                ASSERT (P1inv [i] == EMPTY) ;
                 P1inv [i] = kk ;
                 kk++ ;
             }
         }
-        for (i = 0 ; i < m ; i++)
-        {
-            if (!Mark [i])
-            {
-                // row i is not a singleton row
-                ASSERT (P1inv [i] == EMPTY) ;
-                P1inv [i] = kk ;
-                kk++ ;
-            }
-        }
-        ASSERT (kk == m) ;
+        ASSERT (kk == n1rows) ;
 
         // ---------------------------------------------------------------------
         // find row counts for R11
@@ -252,25 +274,27 @@ template <typename Entry> int spqr_1fixed
         // find row counts for R12 and column pointers for A2 part of Y
         // ---------------------------------------------------------------------
 
-        ynz = 0 ;
-        for ( ; k < n ; k++)
+        #pragma omp parallel for num_threads(nthreads) schedule(dynamic,16) \
+            if (nthreads > 1)
+        for (Long k2 = n1cols ; k2 < n ; k2++)
         {
-            Yp [k-n1cols] = ynz ;
-            for (p = Ap [k] ; p < Ap [k+1] ; p++)
+            Long ycount = 0 ;
+            for (Long p2 = Ap [k2] ; p2 < Ap [k2+1] ; p2++)
             {
-                iold = Ai [p] ;
-                inew = P1inv [iold] ;
-                if (inew < n1rows)
+                Long inew2 = P1inv [Ai [p2]] ;
+                if (inew2 < n1rows)
                 {
-                    R1p [inew]++ ;          // a singleton row; in R1
+                    #pragma omp atomic
+                    R1p [inew2]++ ;         // a singleton row; in R1
                 }
                 else
                 {
-                    ynz++ ;                 // not a singleton row; in A2
+                    ycount++ ;              // not a singleton row; in A2
                 }
             }
+            Yp [k2-n1cols] = ycount ;
         }
-        Yp [n-n1cols] = ynz ;
+        spqr_cumsum (n-n1cols, Yp) ;
 
 #ifndef NDEBUG
         PR (("n1cols: %ld\n", n1cols)) ;
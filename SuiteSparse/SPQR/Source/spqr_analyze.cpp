@@ -5,6 +5,12 @@
 // Given the nonzero pattern of a sparse m-by-n matrix A, analyze it for
 // subsequent numerical factorization.  This function operates on the pattern
 // of A only; it does not need to be templatized.
+//
+// If regularize is TRUE, the pattern of [A ; lambda*I] is analyzed instead,
+// for any lambda, without forming it.  The n diagonal rows are added to S by
+// spqr_stranspose1, and their values are given to spqr_factorize.  They do
+// not change the fill-reducing ordering or the pattern of R, since the
+// diagonal of A'A is always taken as nonzero.
 
 #include "spqr.hpp"
 
@@ -19,6 +25,7 @@
     cholmod_l_free (2*(nf+1), sizeof (double), Flops,         cc) ; \
     cholmod_l_free (ns+2,     sizeof (Long),    Stack_stack,   cc) ; \
     cholmod_l_free (nf,       sizeof (Long),    Rh,            cc) ; \
+    cholmod_l_free (3*nf,     sizeof (Long),    Fsize,         cc) ; \
     cholmod_l_free (ntasks,   sizeof (Long),    TaskParent,    cc) ;
 
 // =============================================================================
@@ -40,6 +47,7 @@ spqr_symbolic *spqr_analyze
     // (no rank detection is performed in that case).
 
     int keepH,              // if TRUE, keep the Householder vectors
+    int regularize,         // if TRUE, analyze [A ; lambda*I] instead of A
 
     // workspace and parameters
     cholmod_common *cc
@@ -50,7 +58,7 @@ spqr_symbolic *spqr_analyze
         *Post, *Ap, *Weight, *On_stack, *Task, *TaskParent,
         *TaskChildp, *TaskChild, *Fm, *Cm, *TaskFront, *TaskFrontp, *Rh,
         *Stack_stack, *Stack_maxstack, *Hip,
-        *TaskStack, *InvPost ;
+        *TaskStack, *InvPost, *Fsize, *Csize, *Rsize ;
     Long nf, f, j, col1, col2, p, p1, p2, t, parent, anz, fp, csize_max,
         fmc, fnc, fpc, cm, cn, ci, fm, fn, cm_min, cm_max, csize_min, kf,
         rm, rn, col, c, pc, rsize, maxfn, csize, m, n, klast,
@@ -87,10 +95,16 @@ spqr_symbolic *spqr_analyze
     Ap = (Long *) A->p ;
     // Ai = (Long *) A->i ;
     anz = Ap [n] ;
+    if (regularize)
+    {
+        // S has n more rows, each with a single entry on the diagonal
+        m += n ;
+        anz += n ;
+    }
 
     do_parallel_analysis = (cc->SPQR_grain > 1) ;
 
-    // The analysis for TBB parallelism attempts to construct a task graph with
+    // The analysis for task parallelism attempts to construct a task graph with
     // leaf nodes with flop counts >= max ((total flops) / cc->SPQR_grain,
     // cc->SPQR_small).  If cc->SPQR_grain <= 1, or if the total flop
     // count is less than cc->SPQR_small, then no parallelism will be
@@ -118,7 +132,7 @@ spqr_symbolic *spqr_analyze
     }
 
     // Disable the GPU if the Householder vectors are requested, if we're
-    // using TBB, if rank detection is requested, or if A is not real
+    // using OpenMP tasks, if rank detection is requested, or if A is not real
     if (keepH || do_parallel_analysis || do_rank_detection ||
         A->xtype != CHOLMOD_REAL)
     {
@@ -155,6 +169,9 @@ spqr_symbolic *spqr_analyze
 
     // workspace allocated later:
     Rh = NULL ;
+    Fsize = NULL ;
+    Csize = NULL ;
+    Rsize = NULL ;
     Flops = NULL ;
     Flops_subtree = NULL ;
     Sc = NULL ;
@@ -345,6 +362,7 @@ spqr_symbolic *spqr_analyze
     QRsym->m = m ;
     QRsym->n = n ;
     QRsym->do_rank_detection = do_rank_detection ;
+    QRsym->regularize = regularize ;
     QRsym->anz = anz ;
     QRsym->nf = nf = Sc->nsuper ;       // number of supernodes / fronts
     QRsym->rjsize = Sc->ssize ;         // size of int part of supernodal R
@@ -465,9 +483,17 @@ spqr_symbolic *spqr_analyze
 #endif
 
     // -------------------------------------------------------------------------
-    // allocate workspace needed for parallel analysis
+    // allocate workspace needed for parallel analysis and stack ordering
     // -------------------------------------------------------------------------
 
+    if (cc->SPQR_memory)
+    {
+        // Fsize, Csize, and Rsize, each of size nf, for spqr_stackorder
+        Fsize = (Long *) cholmod_l_malloc (3*nf, sizeof (Long), cc) ;
+        Csize = Fsize + nf ;
+        Rsize = Csize + nf ;
+    }
+
     if (do_parallel_analysis)
     {
         // allocate Flops and Flops_subtree, each of size nf+1
@@ -617,8 +643,8 @@ spqr_symbolic *spqr_analyze
     // -------------------------------------------------------------------------
 
     // use W [0:m-1] workspace in spqr_stranspose1:
-    spqr_stranspose1 (A, QRsym->Qfill, QRsym->Sp, QRsym->Sj, QRsym->PLinv,
-        Sleft, W) ;
+    spqr_stranspose1 (A, QRsym->Qfill, regularize, QRsym->Sp, QRsym->Sj, QRsym->PLinv,
+        Sleft, W, cc) ;
 
     // -------------------------------------------------------------------------
     // determine flop counts, front sizes, and sequential memory usage
@@ -909,6 +935,14 @@ spqr_symbolic *spqr_analyze
             Rh [f] = rhsize ;
         }
 
+        if (Fsize != NULL)
+        {
+            // keep the sizes of F, C, and R or RH for spqr_stackorder
+            Fsize [f] = fsize ;
+            Csize [f] = csize ;
+            Rsize [f] = keepH ? rhsize : rsize ;
+        }
+
         rhxsize += rhsize ;
 
         PR (("\n --- front f %ld fsize %ld csize %ld\n",
@@ -978,6 +1012,47 @@ spqr_symbolic *spqr_analyze
     }
 #endif
 
+    // -------------------------------------------------------------------------
+    // reorder the children of each front to reduce the peak stack size
+    // -------------------------------------------------------------------------
+
+    // The front tree was postordered above before the sizes of the fronts
+    // were known.  If cc->SPQR_memory is true, the children of each front
+    // are now sorted by Liu's rule, and the tree is postordered again.  This
+    // does not change the fronts, only the order in which they are factorized.
+    // The parallel analysis below groups small subtrees into tasks in this
+    // new postorder, so the task partition can change (a matrix that gave a
+    // single task can give several), and the total size of the stacks of a
+    // parallel factorization can then be larger than without reordering.
+
+    if (ok && Fsize != NULL)
+    {
+        Long peak = spqr_stackorder (nf, Fsize, Csize, Rsize, Post, Childp,
+            Child, cc) ;
+        PR (("stack order: maxstack %ld new peak %ld\n", maxstack, peak)) ;
+        if (peak >= 0)
+        {
+            ASSERT (peak <= maxstack) ;
+
+            // use W (2*(nf+1):3*(nf+1)-1) for node weights [
+            Weight = W + 2*(nf+1) ;
+            for (p = 0 ; p < nf ; p++)
+            {
+                // Weight [c] is the position of c in its list of siblings
+                Weight [Child [p]] = p ;
+            }
+            Weight [nf] = 0 ;
+            cc->no_workspace_reallocate = TRUE ;
+            cholmod_l_postorder ((SuiteSparse_long *) Parent, nf+1,
+                (SuiteSparse_long *) Weight, (SuiteSparse_long *) Post, cc) ;
+            cc->no_workspace_reallocate = FALSE ;
+            ASSERT (Post [nf] == nf) ;
+            // done using W (2*(nf+1):3*(nf+1)-1) for node weights ]
+
+            maxstack = peak ;
+        }
+    }
+
     // -------------------------------------------------------------------------
     // compute Hip
     // -------------------------------------------------------------------------
@@ -1058,6 +1133,7 @@ spqr_symbolic *spqr_analyze
     cc->SPQR_istat [1] = rhxsize - rxsize ;    // nnz (H)
     cc->SPQR_istat [2] = nf ;                  // number of frontal matrices
     cc->SPQR_istat [3] = 1 ;                   // ntasks, for now
+    cc->SPQR_istat [8] = maxstack ;            // bound on stack usage
 
     DEBUG (spqrDebug_dump_Parent (nf+1, Parent, "pfile")) ;
     DEBUG (spqrDebug_dump_Parent (1, NULL, "tfile")) ;
@@ -1792,6 +1868,14 @@ spqr_symbolic *spqr_analyze
 
     // Cm no longer needed in Iwork ]
 
+    // bound on the total usage of all the stacks
+    Long stacktot = 0 ;
+    for (Long s = 0 ; s < ns ; s++)
+    {
+        stacktot += Stack_maxstack [s] ;
+    }
+    cc->SPQR_istat [8] = stacktot ;
+
     // -------------------------------------------------------------------------
     // free workspace and return result
     // -------------------------------------------------------------------------
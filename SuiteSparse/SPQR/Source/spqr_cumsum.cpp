@@ -40,3 +40,98 @@ Long spqr_cumsum
 
     return (itot) ;
 }
+
+// =============================================================================
+// === spqr_pcumsum ============================================================
+// =============================================================================
+
+//  Parallel version of spqr_cumsum, except that X has size n, not n+1: X [k]
+//  is replaced with the sum of the input counts X [0:k-1], and the total sum
+//  is returned but not stored in X.  X is split into up to nthreads blocks,
+//  each of at least PCUMSUM_CHUNK entries.  The sum of each block is found in
+//  parallel, then the sums of the blocks are summed, and then the cumulative
+//  sum of each block is found in parallel.  The result does not depend on the
+//  number of threads.
+
+#define PCUMSUM_CHUNK 16384     // min # of entries of X for each thread
+#define PCUMSUM_MAXBLOCKS 256   // max # of blocks
+
+Long spqr_pcumsum           // returns total sum
+(
+    // input, not modified
+    Long n,
+    int nthreads,           // # of OpenMP threads to use
+
+    // input/output
+    Long *X                 // size n. X = cumsum ([0 X(1:end-1)])
+)
+{
+    Long Bsum [PCUMSUM_MAXBLOCKS+1], itot, t, k, nblocks ;
+
+    if (X == NULL || n <= 0)
+    {
+        return (0) ;
+    }
+
+    nblocks = 1 ;
+#ifdef _OPENMP
+    if (nthreads > 1)
+    {
+        nblocks = MIN (nthreads, PCUMSUM_MAXBLOCKS) ;
+        nblocks = MIN (nblocks, n / PCUMSUM_CHUNK) ;
+    }
+#endif
+
+    if (nblocks <= 1)
+    {
+        // X = cumsum ([0 X(1:end-1)]), sequentially
+        itot = 0 ;
+        for (k = 0 ; k < n ; k++)
+        {
+            t = itot ;
+            itot += X [k] ;
+            X [k] = t ;
+        }
+        return (itot) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // find the sum of each block
+    // -------------------------------------------------------------------------
+
+    #pragma omp parallel for num_threads(nblocks) schedule(static,1)
+    for (Long b = 0 ; b < nblocks ; b++)
+    {
+        Long k1 = (b * n) / nblocks ;
+        Long k2 = ((b+1) * n) / nblocks ;
+        Long s = 0 ;
+        for (Long kk = k1 ; kk < k2 ; kk++)
+        {
+            s += X [kk] ;
+        }
+        Bsum [b] = s ;
+    }
+
+    itot = spqr_cumsum (nblocks, Bsum) ;
+
+    // -------------------------------------------------------------------------
+    // find the cumulative sum of each block, starting at the sum of the
+    // blocks before it
+    // -------------------------------------------------------------------------
+
+    #pragma omp parallel for num_threads(nblocks) schedule(static,1)
+    for (Long b = 0 ; b < nblocks ; b++)
+    {
+        Long k1 = (b * n) / nblocks ;
+        Long k2 = ((b+1) * n) / nblocks ;
+        Long s = Bsum [b] ;
+        for (Long kk = k1 ; kk < k2 ; kk++)
+        {
+            Long x = X [kk] ;
+            X [kk] = s ;
+            s += x ;
+        }
+    }
+
+    return (itot) ;
+}
@@ -19,12 +19,10 @@
 // hardware-in-the-loop solution, for control applications (for example).
 // However, the Stacks must not be shrunk when the factorization is done.
 //
-// FUTURE: split this function into three parts:
-//     (a) allocate workspace and resulting QR factors
-//     (b) factorize (no malloc/free)
-//     (c) free workspace and optionally shrink the Stacks
-// Then part (b) could be called many times with different values but same
-// nonzero pattern.
+// spqr_refactorize does just the factorization itself, with no malloc or
+// free, for a matrix with the same nonzero pattern as the one factorized by
+// spqr_factorize.  It reuses the numeric object from spqr_factorize (whose
+// Stacks must not have been shrunk) and workspace from spqr_get_fwork.
 
 // =============================================================================
 // === macros ==================================================================
@@ -116,9 +114,11 @@ template <typename Entry> spqr_work <Entry> *get_Work
             (Entry *) cholmod_l_malloc (wtsize, sizeof (Entry), cc) ;
         Work [stack].sumfrank = 0 ;
         Work [stack].maxfrank = 0 ;
+        Work [stack].stackpeak = 0 ;
 
         Work [stack].wscale = 0 ;
         Work [stack].wssq   = 0 ;
+        Work [stack].flopcount = 0 ;
     }
 
     *p_wtsize = wtsize ;
@@ -159,6 +159,154 @@ template <typename Entry> void free_Work
 }
 
 
+// =============================================================================
+// === spqr_private_kernel =====================================================
+// =============================================================================
+
+// Factorize all the fronts, with the workspace and numeric object in Blob.
+
+template <typename Entry> void spqr_private_kernel
+(
+    Long ntasks,
+    spqr_blob <Entry> *Blob,
+    cholmod_common *cc
+)
+{
+    PR (("[ calling the kernel\n")) ;
+
+    if (ntasks == 1)
+    {
+        // Just one task, with or without OpenMP: don't create any tasks
+        spqr_kernel (0, Blob) ;         // sequential case
+    }
+    else
+    {
+#ifdef _OPENMP
+        // parallel case: OpenMP is enabled, and there is more than one task
+        int nthreads = MAX (0, cc->SPQR_nthreads) ;
+        spqr_parallel (ntasks, nthreads, Blob) ;
+#else
+        // no OpenMP, but the work is still split into multiple tasks.
+        // do tasks 0 to ntasks-2 (skip the placeholder root task id = ntasks-1)
+        for (Long id = 0 ; id < ntasks-1 ; id++)
+        {
+            spqr_kernel (id, Blob) ;
+        }
+#endif
+    }
+
+    PR (("] did the kernel\n")) ;
+}
+
+
+// =============================================================================
+// === spqr_private_finalize ===================================================
+// =============================================================================
+
+// Each stack keeps its own rank, flop count, and peak usage, so that the
+// tasks on different stacks can run in parallel; they are summed up here.
+// The stack usage is compared with the bound from the analysis, in
+// cc->SPQR_istat [8].  The GPU does not use these stacks.
+
+template <typename Entry> void spqr_private_finalize
+(
+    spqr_numeric <Entry> *QRnum,
+    spqr_work <Entry> *Work,
+    Long ns,
+    cholmod_common *cc
+)
+{
+    Long rank, maxfrank, stack ;
+
+    // -------------------------------------------------------------------------
+    // finalize the rank, the flop count, and the stack usage
+    // -------------------------------------------------------------------------
+
+    PR (("finalize the rank\n")) ;
+    rank = 0 ;
+    maxfrank = 1 ;
+    cc->SPQR_istat [9] = 0 ;
+    for (stack = 0 ; stack < ns ; stack++)
+    {
+        cc->SPQR_istat [9] += Work [stack].stackpeak ;
+        PR (("stack: %ld Work [stack].sumfrank: %ld\n", stack, Work [stack].sumfrank)) ;
+        rank += Work [stack].sumfrank ;
+        maxfrank = MAX (maxfrank, Work [stack].maxfrank) ;
+        cc->SPQR_flopcount += Work [stack].flopcount ;
+    }
+    QRnum->rank = rank ;                    // required by spqr_hpinv
+    QRnum->maxfrank = maxfrank ;
+    PR (("m %ld n %ld my QR rank %ld\n", QRnum->m, QRnum->n, rank)) ;
+
+    // -------------------------------------------------------------------------
+    // finalize norm(w) for the dead column 2-norms
+    // -------------------------------------------------------------------------
+
+    double wscale = 0 ;
+    double wssq = 1 ;
+    for (stack = 0 ; stack < ns ; stack++)
+    {
+        // norm_E_fro = norm (s.*sqrt(q)) ; see also LAPACK's dnrm2
+        double ws = Work [stack].wscale ;
+        double wq = Work [stack].wssq ;
+        if (wq != 0)
+        {
+            double wk = ws * sqrt (wq) ;
+            if (wscale < wk)
+            {
+                double rr = wscale / wk ;
+                wssq = 1 + wssq * rr * rr ;
+                wscale = wk ;
+            }
+            else
+            {
+                double rr = wk / wscale ;
+                wssq += rr * rr ;
+            }
+        }
+    }
+    QRnum->norm_E_fro = wscale * sqrt (wssq) ;
+    cc->SPQR_norm_E_fro = QRnum->norm_E_fro ;
+}
+
+
+// =============================================================================
+// === spqr_private_rank1 ======================================================
+// =============================================================================
+
+// Find the rank of the first ntol columns of A.
+
+template <typename Entry> Long spqr_private_rank1
+(
+    spqr_numeric <Entry> *QRnum,
+    Long ntol
+)
+{
+    Long rank1, j ;
+    PR (("find rank of first ntol cols of A: ntol %ld n %ld\n", ntol,
+        QRnum->n)) ;
+    if (ntol >= QRnum->n)
+    {
+        rank1 = QRnum->rank ;
+        PR (("rank1 is rank: %ld\n", rank1)) ;
+    }
+    else
+    {
+        rank1 = 0 ;
+        for (j = 0 ; j < ntol ; j++)
+        {
+            PR (("column %ld Rdead: %d\n", j, (int) QRnum->Rdead [j])) ;
+            if (!QRnum->Rdead [j])
+            {
+                rank1++ ;
+            }
+        }
+        PR (("rank1 is sum of non-Rdead: %ld\n", rank1)) ;
+    }
+    return (rank1) ;
+}
+
+
 // =============================================================================
 // === spqr_factorize ==========================================================
 // =============================================================================
@@ -172,6 +320,8 @@ template <typename Entry> spqr_numeric <Entry> *spqr_factorize
     Long freeA,                     // if TRUE, free A on output
     double tol,                     // for rank detection
     Long ntol,                      // apply tol only to first ntol columns
+    double lambda,                  // if QRsym->regularize, factorize
+                                    // [A ; lambda*I] instead of A
     spqr_symbolic *QRsym,
 
     // workspace and parameters
@@ -182,8 +332,8 @@ template <typename Entry> spqr_numeric <Entry> *spqr_factorize
         *TaskFront, *TaskFrontp, *TaskStack, *Stack_maxstack ;
     Entry *Sx, **Rblock, **Cblock, **Stacks ;
     spqr_numeric <Entry> *QRnum ;
-    Long nf, m, n, anz, fchunk, maxfn, rank, maxfrank, rjsize, rank1,
-        maxstack,j, wtsize, stack, ns, ntasks, keepH, hisize ;
+    Long nf, m, n, anz, fchunk, maxfn, rjsize, maxstack, wtsize, stack, ns,
+        ntasks, keepH, hisize ;
     char *Rdead ;
     cholmod_sparse *A ;
     spqr_work <Entry> *Work ;
@@ -206,7 +356,7 @@ template <typename Entry> spqr_numeric <Entry> *spqr_factorize
     A = *Ahandle ;
 
     nf = QRsym->nf ;                // number of frontal matrices
-    m = QRsym->m ;                  // A is m-by-n
+    m = QRsym->m ;                  // A (or [A ; lambda*I]) is m-by-n
     n = QRsym->n ;
     anz = QRsym->anz ;              // nnz (A)
 
@@ -274,7 +424,8 @@ template <typename Entry> spqr_numeric <Entry> *spqr_factorize
     if (cc->status == CHOLMOD_OK)
     {
         // use Wi as workspace (Iwork (0:m-1)) [
-        spqr_stranspose2 (A, Qfill, Sp, PLinv, Sx, Wi) ;
+        spqr_stranspose2 (A, Qfill, Sp, PLinv, QRsym->regularize, lambda,
+            Sx, Wi, cc) ;
         // Wi no longer needed ]
     }
 
@@ -487,30 +638,7 @@ template <typename Entry> spqr_numeric <Entry> *spqr_factorize
     // numeric QR factorization
     // -------------------------------------------------------------------------
 
-    PR (("[ calling the kernel\n")) ;
-
-    if (ntasks == 1)
-    {
-        // Just one task, with or without TBB installed: don't use TBB
-        spqr_kernel (0, &Blob) ;        // sequential case
-    }
-    else
-    {
-#ifdef HAVE_TBB
-        // parallel case: TBB is installed, and there is more than one task
-        int nthreads = MAX (0, cc->SPQR_nthreads) ;
-        spqr_parallel (ntasks, nthreads, &Blob) ;
-#else
-        // TBB not installed, but the work is still split into multiple tasks.
-        // do tasks 0 to ntasks-2 (skip the placeholder root task id = ntasks-1)
-        for (Long id = 0 ; id < ntasks-1 ; id++)
-        {
-            spqr_kernel (id, &Blob) ;
-        }
-#endif
-    }
-
-    PR (("] did the kernel\n")) ;
+    spqr_private_kernel (ntasks, &Blob, cc) ;
 
     // -------------------------------------------------------------------------
     // check for BLAS Long overflow on the CPU, or GPU failure
@@ -530,51 +658,10 @@ template <typename Entry> spqr_numeric <Entry> *spqr_factorize
     }
 
     // -------------------------------------------------------------------------
-    // finalize the rank
+    // finalize the rank, the flop count, the stack usage, and norm(w)
     // -------------------------------------------------------------------------
 
-    PR (("finalize the rank\n")) ;
-    rank = 0 ;
-    maxfrank = 1 ;
-    for (stack = 0 ; stack < ns ; stack++)
-    {
-        PR (("stack: %ld Work [stack].sumfrank: %ld\n", stack, Work [stack].sumfrank)) ;
-        rank += Work [stack].sumfrank ;
-        maxfrank = MAX (maxfrank, Work [stack].maxfrank) ;
-    }
-    QRnum->rank = rank ;                    // required by spqr_hpinv
-    QRnum->maxfrank = maxfrank ;
-    PR (("m %ld n %ld my QR rank %ld\n", m, n, rank)) ;
-
-    // -------------------------------------------------------------------------
-    // finalize norm(w) for the dead column 2-norms
-    // -------------------------------------------------------------------------
-
-    double wscale = 0 ;
-    double wssq = 1 ;
-    for (stack = 0 ; stack < ns ; stack++)
-    {
-        // norm_E_fro = norm (s.*sqrt(q)) ; see also LAPACK's dnrm2
-        double ws = Work [stack].wscale ;
-        double wq = Work [stack].wssq ;
-        if (wq != 0)
-        {
-            double wk = ws * sqrt (wq) ;
-            if (wscale < wk)
-            {
-                double rr = wscale / wk ;
-                wssq = 1 + wssq * rr * rr ;
-                wscale = wk ;
-            }
-            else
-            {
-                double rr = wk / wscale ;
-                wssq += rr * rr ;
-            }
-        }
-    }
-    QRnum->norm_E_fro = wscale * sqrt (wssq) ;
-    cc->SPQR_norm_E_fro = QRnum->norm_E_fro ;
+    spqr_private_finalize (QRnum, Work, ns, cc) ;
 
     // -------------------------------------------------------------------------
     // free all workspace, except Cblock and Work
@@ -718,28 +805,213 @@ template <typename Entry> spqr_numeric <Entry> *spqr_factorize
     // find the rank and return the result
     // -------------------------------------------------------------------------
 
-    // find the rank of the first ntol columns of A
-    PR (("find rank of first ntol cols of A: ntol %ld n %ld\n", ntol, n)) ;
-    if (ntol >= n)
+    QRnum->rank1 = spqr_private_rank1 (QRnum, ntol) ;
+    return (QRnum) ;
+}
+
+
+// =============================================================================
+// === spqr_get_fwork ==========================================================
+// =============================================================================
+
+// Allocate the workspace for spqr_refactorize, for the numeric object QRnum
+// computed by spqr_factorize from the analysis QRsym.  Returns NULL if out of
+// memory.
+
+template <typename Entry> spqr_fwork <Entry> *spqr_get_fwork
+(
+    spqr_symbolic *QRsym,
+    spqr_numeric <Entry> *QRnum,
+    cholmod_common *cc
+)
+{
+    spqr_fwork <Entry> *Fwork ;
+
+    Fwork = (spqr_fwork <Entry> *)
+        cholmod_l_malloc (1, sizeof (spqr_fwork <Entry>), cc) ;
+    if (cc->status < CHOLMOD_OK)
     {
-        rank1 = rank ;
-        PR (("rank1 is rank: %ld\n", rank1)) ;
+        // out of memory
+        return (NULL) ;
     }
-    else
+
+    Fwork->ns = QRnum->ns ;
+    Fwork->n = QRsym->n ;
+    Fwork->nf = QRsym->nf ;
+    Fwork->maxfn = QRsym->maxfn ;
+    Fwork->anz = QRsym->anz ;
+    Fwork->fchunk = MIN (QRsym->m, FCHUNK) ;
+    Fwork->Work = get_Work <Entry> (Fwork->ns, Fwork->n, Fwork->maxfn,
+        QRsym->keepH, Fwork->fchunk, &(Fwork->wtsize), cc) ;
+    Fwork->Cblock = (Entry **) cholmod_l_malloc (Fwork->nf+1, sizeof (Entry *),
+        cc) ;
+    Fwork->Sx = (Entry *) cholmod_l_malloc (Fwork->anz, sizeof (Entry), cc) ;
+
+    if (cc->status < CHOLMOD_OK)
     {
-        rank1 = 0 ;
-        for (j = 0 ; j < ntol ; j++)
+        // out of memory
+        spqr_free_fwork (&Fwork, cc) ;
+        return (NULL) ;
+    }
+    return (Fwork) ;
+}
+
+
+// =============================================================================
+// === spqr_free_fwork =========================================================
+// =============================================================================
+
+template <typename Entry> void spqr_free_fwork
+(
+    spqr_fwork <Entry> **Fwork_handle,
+    cholmod_common *cc
+)
+{
+    spqr_fwork <Entry> *Fwork ;
+    if (Fwork_handle == NULL || *Fwork_handle == NULL)
+    {
+        // nothing to do
+        return ;
+    }
+    Fwork = *Fwork_handle ;
+    free_Work <Entry> (Fwork->Work, Fwork->ns, Fwork->n, Fwork->maxfn,
+        Fwork->wtsize, cc) ;
+    cholmod_l_free (Fwork->ns, sizeof (spqr_work <Entry>), Fwork->Work, cc) ;
+    cholmod_l_free (Fwork->nf+1, sizeof (Entry *), Fwork->Cblock, cc) ;
+    cholmod_l_free (Fwork->anz, sizeof (Entry), Fwork->Sx, cc) ;
+    cholmod_l_free (1, sizeof (spqr_fwork <Entry>), Fwork, cc) ;
+    *Fwork_handle = NULL ;
+}
+
+
+// =============================================================================
+// === spqr_refactorize ========================================================
+// =============================================================================
+
+// Numeric QR factorization of a matrix A with the same nonzero pattern as the
+// matrix whose factorization QRnum was computed by spqr_factorize, with
+// cc->SPQR_shrink <= 0 so that its Stacks were left at their full size.
+// QRnum is overwritten with the factorization of A.  No memory is allocated
+// or freed, except for cc->Iwork if it is too small.  Returns TRUE if
+// successful, FALSE otherwise (in which case QRnum must not be used).
+
+template <typename Entry> int spqr_refactorize
+(
+    // inputs, not modified
+    cholmod_sparse *A,
+    double tol,                     // for rank detection
+    Long ntol,                      // apply tol only to first ntol columns
+    double lambda,                  // if QRsym->regularize, factorize
+                                    // [A ; lambda*I] instead of A
+    spqr_symbolic *QRsym,
+
+    // input/output
+    spqr_numeric <Entry> *QRnum,    // from spqr_factorize, overwritten
+    spqr_fwork <Entry> *Fwork,      // from spqr_get_fwork (QRsym, QRnum)
+
+    // workspace and parameters
+    cholmod_common *cc
+)
+{
+    Long *Wi, stack, ns, ntasks, n, m, j ;
+    spqr_work <Entry> *Work ;
+
+    ns = QRnum->ns ;
+    ntasks = QRnum->ntasks ;
+    n = QRsym->n ;
+    m = QRsym->m ;
+
+    // the Stacks must be at the size they were allocated with
+    for (stack = 0 ; stack < ns ; stack++)
+    {
+        Long stacksize = (ntasks == 1) ?
+            QRsym->maxstack : QRsym->Stack_maxstack [stack] ;
+        if (QRnum->Stack_size [stack] != stacksize || Fwork->ns != ns)
         {
-            PR (("column %ld Rdead: %d\n", j, (int) Rdead [j])) ;
-            if (!Rdead [j])
-            {
-                rank1++ ;
-            }
+            ERROR (CHOLMOD_INVALID, "QR Stacks have been shrunk") ;
+            return (FALSE) ;
         }
-        PR (("rank1 is sum of non-Rdead: %ld\n", rank1)) ;
     }
-    QRnum->rank1 = rank1 ;
-    return (QRnum) ;
+
+    if (!(QRsym->do_rank_detection))
+    {
+        // disable rank detection if not accounted for in analysis
+        tol = -1 ;
+    }
+
+    cholmod_l_allocate_work (0, MAX (m, QRsym->nf), 0, cc) ;
+    if (cc->status < CHOLMOD_OK)
+    {
+        // out of memory
+        return (FALSE) ;
+    }
+    Wi = (Long *) cc->Iwork ;   // size m, aliased with the rest of Iwork
+
+    // -------------------------------------------------------------------------
+    // clear the numeric object and the workspace
+    // -------------------------------------------------------------------------
+
+    Work = Fwork->Work ;
+    for (stack = 0 ; stack < ns ; stack++)
+    {
+        Entry *Stack = QRnum->Stacks [stack] ;
+        Work [stack].Stack_head = Stack ;
+        Work [stack].Stack_top  = Stack + QRnum->Stack_size [stack] ;
+        Work [stack].sumfrank = 0 ;
+        Work [stack].maxfrank = 0 ;
+        Work [stack].stackpeak = 0 ;
+        Work [stack].wscale = 0 ;
+        Work [stack].wssq   = 0 ;
+        Work [stack].flopcount = 0 ;
+    }
+    for (j = 0 ; j < n ; j++)
+    {
+        QRnum->Rdead [j] = 0 ;
+    }
+    QRnum->maxfm = EMPTY ;
+
+    // -------------------------------------------------------------------------
+    // create S and factorize it
+    // -------------------------------------------------------------------------
+
+    // use Wi as workspace (Iwork (0:m-1)) [
+    spqr_stranspose2 (A, QRsym->Qfill, QRsym->Sp, QRsym->PLinv,
+        QRsym->regularize, lambda, Fwork->Sx, Wi, cc) ;
+    // Wi no longer needed ]
+
+    spqr_blob <Entry> Blob ;
+    Blob.QRsym = QRsym ;
+    Blob.QRnum = QRnum ;
+    Blob.tol = tol ;
+    Blob.Work = Work ;
+    Blob.Cm = Wi ;
+    Blob.Cblock = Fwork->Cblock ;
+    Blob.Sx = Fwork->Sx ;
+    Blob.ntol = ntol ;
+    Blob.fchunk = Fwork->fchunk ;
+    Blob.cc = cc ;
+
+    cc->SPQR_flopcount = 0 ;
+    spqr_private_kernel (ntasks, &Blob, cc) ;
+    if (cc->status < CHOLMOD_OK)
+    {
+        // the problem is too large for the BLAS
+        return (FALSE) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // finalize the factorization
+    // -------------------------------------------------------------------------
+
+    spqr_private_finalize (QRnum, Work, ns, cc) ;
+    if (QRnum->keepH)
+    {
+        // use Wi as workspace (Iwork (0:m-1)) [
+        spqr_hpinv (QRsym, QRnum, Wi) ;
+        // Wi no longer needed ]
+    }
+    QRnum->rank1 = spqr_private_rank1 (QRnum, ntol) ;
+    return (TRUE) ;
 }
 
 
@@ -754,6 +1026,8 @@ template spqr_numeric <double> *spqr_factorize <double>
     Long freeA,                     // if TRUE, free A on output
     double tol,                     // for rank detection
     Long ntol,                      // apply tol only to first ntol columns
+    double lambda,                  // if QRsym->regularize, factorize
+                                    // [A ; lambda*I] instead of A
     spqr_symbolic *QRsym,
 
     // workspace and parameters
@@ -771,8 +1045,74 @@ template spqr_numeric <Complex> *spqr_factorize <Complex>
     Long freeA,                     // if TRUE, free A on output
     double tol,                     // for rank detection
     Long ntol,                      // apply tol only to first ntol columns
+    double lambda,                  // if QRsym->regularize, factorize
+                                    // [A ; lambda*I] instead of A
+    spqr_symbolic *QRsym,
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
+// =============================================================================
+
+template spqr_fwork <double> *spqr_get_fwork <double>
+(
+    spqr_symbolic *QRsym,
+    spqr_numeric <double> *QRnum,
+    cholmod_common *cc
+) ;
+
+template spqr_fwork <Complex> *spqr_get_fwork <Complex>
+(
+    spqr_symbolic *QRsym,
+    spqr_numeric <Complex> *QRnum,
+    cholmod_common *cc
+) ;
+
+template void spqr_free_fwork <double>
+(
+    spqr_fwork <double> **Fwork_handle,
+    cholmod_common *cc
+) ;
+
+template void spqr_free_fwork <Complex>
+(
+    spqr_fwork <Complex> **Fwork_handle,
+    cholmod_common *cc
+) ;
+
+template int spqr_refactorize <double>
+(
+    // inputs, not modified
+    cholmod_sparse *A,
+    double tol,                     // for rank detection
+    Long ntol,                      // apply tol only to first ntol columns
+    double lambda,                  // if QRsym->regularize, factorize
+                                    // [A ; lambda*I] instead of A
+    spqr_symbolic *QRsym,
+
+    // input/output
+    spqr_numeric <double> *QRnum,   // from spqr_factorize, overwritten
+    spqr_fwork <double> *Fwork,     // from spqr_get_fwork (QRsym, QRnum)
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
+template int spqr_refactorize <Complex>
+(
+    // inputs, not modified
+    cholmod_sparse *A,
+    double tol,                     // for rank detection
+    Long ntol,                      // apply tol only to first ntol columns
+    double lambda,                  // if QRsym->regularize, factorize
+                                    // [A ; lambda*I] instead of A
     spqr_symbolic *QRsym,
 
+    // input/output
+    spqr_numeric <Complex> *QRnum,  // from spqr_factorize, overwritten
+    spqr_fwork <Complex> *Fwork,    // from spqr_get_fwork (QRsym, QRnum)
+
     // workspace and parameters
     cholmod_common *cc
 ) ;
@@ -100,15 +100,31 @@
     of a front is small) the block size is increased to include the entire
     front.  "Small" is defined, below, as fronts with fewer than 5000 entries.
 
+    If cc->SPQR_nthreads > 1 and OpenMP is enabled, large fronts are
+    factorized with a tile-based task graph, like the one used by the
+    GPUQREngine on the GPU: the columns of F are split into tiles, the
+    Householder vectors of each panel are found by one thread as usual, and
+    applying a block of Householder reflections to the columns to its right
+    becomes one OpenMP task for each tile.  The tasks on a tile are done in
+    order, but different tiles are updated at the same time, and a panel can
+    be factorized as soon as the updates to its own tile are done, while the
+    updates from prior panels continue on the tiles to its right.  The
+    result is the same as the sequential method, except for roundoff.
+
     NOTE: this function does not check its inputs.  If the caller runs out of
     memory and passes NULL pointers, this function will segfault.
 */
 
 #include "spqr.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #define SMALL 5000
 #define MINCHUNK 4
 #define MINCHUNK_RATIO 4
+#define TILE_MIN 1000000    // fronts with fewer entries are not tiled
+#define TILE_RATIO 4        // about TILE_RATIO tiles per thread
 
 // =============================================================================
 // === spqr_private_house ======================================================
@@ -268,7 +284,121 @@ template <typename Entry> void spqr_private_apply1
 
 
 // =============================================================================
-// === spqr_front ==============================================================
+// === spqr_private_tiles ======================================================
+// =============================================================================
+
+// The state of a tile-based factorization of a front.  Tile j is the set of
+// columns j*tw to (j+1)*tw-1 of F.  The pending updates of tile j are the
+// OpenMP tasks that depend on F (0,j*tw).
+
+template <typename Entry> struct spqr_private_tiles
+{
+    Long tw ;           // tile width
+    Long fchunk ;       // panel size
+    Long ready ;        // columns 0:ready-1 have no pending updates
+    Entry *T ;          // size n*fchunk.  The T matrix for the block of
+                        // Householder vectors that starts at column k1 is
+                        // in T + k1*fchunk.
+    Entry *Work ;       // size ntiles*tw*fchunk, workspace for each tile
+} ;
+
+
+// =============================================================================
+// === spqr_private_tile_wait ==================================================
+// =============================================================================
+
+// Wait until all pending updates to columns 0:c-1 are done.
+
+template <typename Entry> void spqr_private_tile_wait
+(
+    Long c,
+    Long m,
+    Entry *F,
+    spqr_private_tiles <Entry> *Tiles
+)
+{
+    if (Tiles == NULL)
+    {
+        return ;        // sequential case: nothing is pending
+    }
+    Long tw = Tiles->tw ;
+    for (Long j = Tiles->ready / tw ; j * tw < c ; j++)
+    {
+        Entry *Tile = &F [INDEX (0,j*tw,m)] ;
+        // an undeferred task that waits for all updates to tile j
+        #pragma omp task if (0) depend (inout: Tile [0])
+        { }
+        Tiles->ready = (j+1) * tw ;
+    }
+}
+
+
+// =============================================================================
+// === spqr_private_apply_block ================================================
+// =============================================================================
+
+// Apply the pending block of nv Householder reflections, V = F (g1:g1+mv-1,
+// k1:k1+nv-1), to F (g1:g1+mv-1, k2:n-1).  In the tiled case, T is
+// constructed here, and the update becomes one task for each tile.
+
+template <typename Entry> void spqr_private_apply_block
+(
+    Long mv,            // number of rows of V
+    Long nv,            // number of Householder vectors in the block
+    Long g1,            // V starts at F (g1,k1)
+    Long k1,
+    Long k2,            // update F (g1:g1+mv-1, k2:n-1)
+    Long m,             // F is m-by-n
+    Long n,
+    Entry *Tau,         // size nv, Tau (k1:k1+nv-1)
+    Entry *F,
+    Entry *W,           // workspace of size nv*nv + nv*(n-k2), if not tiled
+    spqr_private_tiles <Entry> *Tiles,
+    cholmod_common *cc
+)
+{
+    Entry *V = &F [INDEX (g1,k1,m)] ;
+
+    if (Tiles == NULL)
+    {
+        spqr_larftb (
+            0,                          // method 0: Left, Transpose
+            mv, n-k2, nv, m, m,
+            V,                          // F (g1:g1+mv-1, k1:k1+nv-1)
+            Tau,                        // Tau (k1:k1+nv-1)
+            &F [INDEX (g1,k2,m)],       // F (g1:g1+mv-1, k2:n-1)
+            W, cc) ;                    // size nv*nv + nv*(n-k2)
+        return ;
+    }
+
+    if (mv <= 0 || nv <= 0 || k2 >= n)
+    {
+        return ;        // nothing to do
+    }
+
+    // construct T for this block; it stays in place until the front is done
+    ASSERT (nv <= Tiles->fchunk) ;
+    Entry *T = Tiles->T + k1 * Tiles->fchunk ;
+    spqr_larft (mv, nv, m, V, Tau, T, cc) ;
+
+    // create one task to update each tile in columns k2:n-1
+    Long tw = Tiles->tw ;
+    for (Long j = k2 / tw ; j * tw < n ; j++)
+    {
+        Long c1 = MAX (k2, j*tw) ;
+        Long c2 = MIN (n, (j+1)*tw) ;
+        Entry *C = &F [INDEX (g1,c1,m)] ;
+        Entry *Work = Tiles->Work + j * tw * Tiles->fchunk ;
+        Entry *Tile = &F [INDEX (0,j*tw,m)] ;
+        #pragma omp task firstprivate (C, Work, c1, c2) depend (inout: Tile [0])
+        spqr_larfb (0, mv, c2-c1, nv, m, m, V, T, C, Work, cc) ;
+    }
+    Tiles->ready = MIN (Tiles->ready, k2) ;
+}
+
+
+// =============================================================================
+// === spqr_private_front ======================================================
 // =============================================================================
 
 // Factorize a front F into a sequence of Householder vectors H, and an upper
@@ -277,7 +407,7 @@ template <typename Entry> void spqr_private_apply1
 // rank that indicates the first entry in C, which is F (rank,npiv), or 0
 // on error.
 
-template <typename Entry> Long spqr_front
+template <typename Entry> Long spqr_private_front
 (
     // input, not modified
     Long m,             // F is m-by-n with leading dimension m
@@ -304,13 +434,16 @@ template <typename Entry> Long spqr_front
     // input/output
     double *wscale,
     double *wssq,
+    double *flops,      // "pure" flop count of this stack
+
+    // tiles for the parallel case, or NULL if sequential
+    spqr_private_tiles <Entry> *Tiles,
 
     cholmod_common *cc
 )
 {
     Entry tau ;
     double wk ;
-    Entry *V ;
     Long k, t, g, g1, nv, k1, k2, i, t0, vzeros, mleft, nleft, vsize, minchunk,
         rank ;
 
@@ -329,7 +462,6 @@ template <typename Entry> Long spqr_front
     g1 = 0 ;                // row index of first queued-up Householder
     k1 = 0 ;                // pending Householders are in F (g1:t, k1:k2-1)
     k2 = 0 ;
-    V = F ;                 // Householder vectors start here
     g = 0 ;                 // number of good Householders found
     nv = 0 ;                // number of Householder reflections queued up
     vzeros = 0 ;            // number of explicit zeros in queued-up H's
@@ -374,6 +506,7 @@ template <typename Entry> Long spqr_front
                 Tau [k] = 0 ;
             }
             ASSERT (nv == 0) ;          // there can be no pending updates
+            spqr_private_tile_wait (n, m, F, Tiles) ;
             return (rank) ;
         }
 
@@ -399,13 +532,8 @@ template <typename Entry> Long spqr_front
             {
                 // apply pending block of Householder reflections
                 PR (("(1) apply k1 %ld k2 %ld\n", k1, k2)) ;
-                spqr_larftb (
-                    0,                          // method 0: Left, Transpose
-                    t0-g1, n-k2, nv, m, m,
-                    V,                          // F (g1:t-1, k1:k1+nv-1)
-                    &Tau [k1],                  // Tau (k1:k-1)
-                    &F [INDEX (g1,k2,m)],       // F (g1:t-1, k2:n-1)
-                    W, cc) ;                    // size nv*nv + nv*(n-k2)
+                spqr_private_apply_block (t0-g1, nv, g1, k1, k2, m, n,
+                    &Tau [k1], F, W, Tiles, cc) ;
                 nv = 0 ;        // clear queued-up Householder reflections
                 vzeros = 0 ;
             }
@@ -415,6 +543,7 @@ template <typename Entry> Long spqr_front
         // find a Householder reflection that reduces column k
         // ---------------------------------------------------------------------
 
+        spqr_private_tile_wait (k+1, m, F, Tiles) ;
         tau = spqr_private_house (t-g, &F [INDEX (g,k,m)], cc) ;
 
         // ---------------------------------------------------------------------
@@ -465,13 +594,8 @@ template <typename Entry> Long spqr_front
             {
                 // apply pending block of Householder reflections
                 PR (("(2) apply k1 %ld k2 %ld\n", k1, k2)) ;
-                spqr_larftb (
-                    0,                          // method 0: Left, Transpose
-                    t0-g1, n-k2, nv, m, m,
-                    V,                          // F (g1:t-1, k1:k1+nv-1)
-                    &Tau [k1],                  // Tau (k1:k-1)
-                    &F [INDEX (g1,k2,m)],       // F (g1:t-1, k2:n-1)
-                    W, cc) ;                    // size nv*nv + nv*(n-k2)
+                spqr_private_apply_block (t0-g1, nv, g1, k1, k2, m, n,
+                    &Tau [k1], F, W, Tiles, cc) ;
                 nv = 0 ;        // clear queued-up Householder reflections
                 vzeros = 0 ;
             }
@@ -492,7 +616,6 @@ template <typename Entry> Long spqr_front
                 g1 = g ;                        // first row of V
                 k1 = k ;                        // first column of V
                 k2 = MIN (n, k+fchunk) ;        // k2-1 is last col in panel
-                V = &F [INDEX (g1,k1,m)] ;      // pending V starts here
 
                 // check for switch to unblocked code
                 mleft = m-g1 ;                  // number of rows left
@@ -505,6 +628,9 @@ template <typename Entry> Long spqr_front
                     // use unblocked code if fchunk <= 1.
                     k2 = n ;
                 }
+
+                // the panel must be up to date before it is factorized
+                spqr_private_tile_wait (k2, m, F, Tiles) ;
             }
             nv++ ;  // one more pending update; V is F (g1:t-1, k1:k1+nv-1)
 
@@ -518,13 +644,11 @@ template <typename Entry> Long spqr_front
             // that this single Householder vector is computed and then applied
             // just by itself to the rest of the frontal matrix (columns
             // k+1:n-1, or n-k-1 columns).  Applying the Householder reflection
-            // to just one column takes 4*(t-g) flops.  This computation only
-            // works if TBB is disabled, merely because it uses a global
-            // variable to keep track of the flop count.  If TBB is used, this
-            // computation may result in a race condition; it is disabled in
-            // that case.
+            // to just one column takes 4*(t-g) flops.  The count is kept for
+            // the stack that this front is on, so that tasks on different
+            // stacks do not race; spqr_factorize sums them up at the end.
 
-            FLOP_COUNT ((t-g) * (3 + 4 * (n-k-1))) ;
+            (*flops) += (t-g) * (3 + 4 * (n-k-1)) ;
 
             // -----------------------------------------------------------------
             // apply the kth Householder reflection to the current panel
@@ -547,13 +671,8 @@ template <typename Entry> Long spqr_front
             {
                 // apply pending block of Householder reflections
                 PR (("(3) apply k1 %ld k2 %ld\n", k1, k2)) ;
-                spqr_larftb (
-                    0,                          // method 0: Left, Transpose
-                    t-g1, n-k2, nv, m, m,
-                    V,                          // F (g1:t-1, k1:k1+nv-1)
-                    &Tau [k1],                  // Tau (k1:k2-1)
-                    &F [INDEX (g1,k2,m)],       // F (g1:t-1, k2:n-1)
-                    W, cc) ;                    // size nv*nv + nv*(n-k2)
+                spqr_private_apply_block (t-g1, nv, g1, k1, k2, m, n,
+                    &Tau [k1], F, W, Tiles, cc) ;
                 nv = 0 ;        // clear queued-up Householder reflections
                 vzeros = 0 ;
             }
@@ -573,6 +692,9 @@ template <typename Entry> Long spqr_front
         }
     }
 
+    // wait for all updates to finish
+    spqr_private_tile_wait (n, m, F, Tiles) ;
+
     if (CHECK_BLAS_INT && !cc->blas_ok)
     {
         // This cannot occur if the BLAS_INT and the Long are the same integer.
@@ -586,6 +708,100 @@ template <typename Entry> Long spqr_front
 }
 
 
+// =============================================================================
+// === spqr_front ==============================================================
+// =============================================================================
+
+// Factorize a front F, using tiles if the front is large and more than one
+// thread is requested.  See spqr_private_front for details.
+
+template <typename Entry> Long spqr_front
+(
+    // input, not modified
+    Long m,             // F is m-by-n with leading dimension m
+    Long n,
+    Long npiv,          // number of pivot columns
+    double tol,         // a column is flagged as dead if its norm is <= tol
+    Long ntol,          // apply tol only to first ntol pivot columns
+    Long fchunk,        // block size for compact WY Householder reflections,
+                        // treated as 1 if fchunk <= 1
+
+    // input/output
+    Entry *F,           // frontal matrix F of size m-by-n
+    Long *Stair,        // size n, entries F (Stair[k]:m-1, k) are all zero,
+                        // for each k = 0:n-1, and remain zero on output.
+    char *Rdead,        // size npiv; all zero on input.  If k is dead,
+                        // Rdead [k] is set to 1
+
+    // output, not defined on input
+    Entry *Tau,         // size n, Householder coefficients
+
+    // workspace, undefined on input and output
+    Entry *W,           // size b*n, where b = min (fchunk,n,m)
+
+    // input/output
+    double *wscale,
+    double *wssq,
+    double *flops,      // "pure" flop count of this stack
+
+    cholmod_common *cc
+)
+{
+#ifdef _OPENMP
+    int nthreads = cc->SPQR_nthreads ;
+    if (nthreads > 1 && fchunk > 1 && n > 2*fchunk
+        && ((double) m) * ((double) n) >= TILE_MIN)
+    {
+        // ---------------------------------------------------------------------
+        // get the workspace for the tiles
+        // ---------------------------------------------------------------------
+
+        spqr_private_tiles <Entry> Tiles ;
+        Long tw = MAX (fchunk, (n + TILE_RATIO*nthreads - 1) /
+            (TILE_RATIO*nthreads)) ;
+        Long ntiles = (n + tw - 1) / tw ;
+        Tiles.T = (Entry *) SuiteSparse_malloc (n*fchunk + ntiles*tw*fchunk,
+            sizeof (Entry)) ;
+
+        if (Tiles.T != NULL)
+        {
+            Long rank ;
+            Tiles.tw = tw ;
+            Tiles.fchunk = fchunk ;
+            Tiles.ready = n ;
+            Tiles.Work = Tiles.T + n*fchunk ;
+
+            // -----------------------------------------------------------------
+            // factorize the front with tile tasks
+            // -----------------------------------------------------------------
+
+            if (omp_in_parallel ( ))
+            {
+                // already inside spqr_parallel; the tile tasks are done by
+                // the same threads as the tasks of the task tree
+                rank = spqr_private_front (m, n, npiv, tol, ntol, fchunk, F,
+                    Stair, Rdead, Tau, W, wscale, wssq, flops, &Tiles, cc) ;
+            }
+            else
+            {
+                #pragma omp parallel num_threads (nthreads)
+                #pragma omp single
+                rank = spqr_private_front (m, n, npiv, tol, ntol, fchunk, F,
+                    Stair, Rdead, Tau, W, wscale, wssq, flops, &Tiles, cc) ;
+            }
+
+            SuiteSparse_free (Tiles.T) ;
+            return (rank) ;
+        }
+        // out of memory; use the sequential method instead
+    }
+#endif
+
+    return (spqr_private_front (m, n, npiv, tol, ntol, fchunk, F, Stair, Rdead,
+        Tau, W, wscale, wssq, flops, (spqr_private_tiles <Entry> *) NULL, cc)) ;
+}
+
+
 // =============================================================================
 
 template Long spqr_front <double>
@@ -616,6 +832,7 @@ template Long spqr_front <double>
     // input/output
     double *wscale,
     double *wssq,
+    double *flops,      // "pure" flop count of this stack
 
     cholmod_common *cc
 ) ;
@@ -650,6 +867,7 @@ template Long spqr_front <Complex>
     // input/output
     double *wscale,
     double *wssq,
+    double *flops,      // "pure" flop count of this stack
 
     cholmod_common *cc
 ) ;
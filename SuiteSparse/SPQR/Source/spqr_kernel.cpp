@@ -104,13 +104,11 @@ template <typename Entry> void spqr_kernel // _worker
     Entry * Stack_head = Work [stack].Stack_head ;
     Entry * Stack_top = Work [stack].Stack_top ;
 
-#ifndef NDEBUG
-    Entry **Stacks = QRnum->Stacks ;
-    Entry *Stack = Stacks [stack] ;    // stack being used
-    Long stacksize = (ntasks == 1) ?
-            QRsym->maxstack :
-            QRsym->Stack_maxstack [stack] ;
-#endif
+    // the stack being used, and its peak usage so far.  The front F and the
+    // R blocks grow from the head, and the C blocks from the top.
+    Entry *Stack = QRnum->Stacks [stack] ;
+    Long stacksize = QRnum->Stack_size [stack] ;
+    Long stackpeak = Work [stack].stackpeak ;
 
     // if H kept, Tau and Stair will point to permanent space in QRnum
     Entry * Tau = keepH ? NULL : Work [stack].WTwork ;
@@ -127,6 +125,9 @@ template <typename Entry> void spqr_kernel // _worker
     double wscale = Work [stack].wscale ;
     double wssq   = Work [stack].wssq   ;
 
+    // "pure" flop count for this stack (for performance testing only)
+    double flops = Work [stack].flopcount ;
+
     // -------------------------------------------------------------------------
     // factorize all the fronts in this task
     // -------------------------------------------------------------------------
@@ -180,6 +181,8 @@ template <typename Entry> void spqr_kernel // _worker
         Entry *F = Stack_head ;
         Rblock [f] = F ;
         Stack_head += fsize ;
+        stackpeak = MAX (stackpeak,
+            (Stack_head - Stack) + stacksize - (Stack_top - Stack)) ;
 
 #ifndef NDEBUG
         PR (("Stack head %ld top %ld total %ld stacksize %ld\n",
@@ -237,7 +240,7 @@ template <typename Entry> void spqr_kernel // _worker
 
         Long frank = spqr_front (fm, fn, fp, tol, ntol - col1,
             fchunk, F, Stair, Rdead + col1, Tau, W,
-            &wscale, &wssq, cc) ;
+            &wscale, &wssq, &flops, cc) ;
 
 #ifndef NDEBUG
 #ifndef NPRINT
@@ -262,6 +265,8 @@ template <typename Entry> void spqr_kernel // _worker
 
         Long csize = spqr_fcsize (fm, fn, fp, frank) ;
         Stack_top -= csize ;
+        stackpeak = MAX (stackpeak,
+            (Stack_head - Stack) + stacksize - (Stack_top - Stack)) ;
 
 #ifndef NDEBUG
         PR (("Front f %ld csize %ld piv rank %ld\n", f, csize, frank)) ;
@@ -332,6 +337,8 @@ template <typename Entry> void spqr_kernel // _worker
     // for keeping track of norm(w) for dead column 2-norms
     Work [stack].wscale = wscale ;
     Work [stack].wssq   = wssq   ;
+    Work [stack].flopcount = flops ;
+    Work [stack].stackpeak = stackpeak ;
 }
 
 // =============================================================================
@@ -186,6 +186,94 @@ template <typename Entry> void spqr_larftb
     }
 }
 
+// =============================================================================
+// === spqr_larft and spqr_larfb ===============================================
+// =============================================================================
+
+// spqr_larftb split into its two parts, so that T can be constructed once
+// and then applied to several matrices C, possibly at the same time by
+// different threads.  spqr_larft constructs the k-by-k matrix T from V and
+// Tau (V is modified and then restored on output, by some versions of
+// LAPACK, so it must not be used by another thread at the same time).
+// spqr_larfb applies the block reflector; it does not modify V or T.
+
+template <typename Entry> void spqr_larft
+(
+    // inputs, not modified (V is modified and then restored on output)
+    Long v,         // V is v-by-k
+    Long k,
+    Long ldv,       // leading dimension of V
+    Entry *V,       // V is v-by-k, unit lower triangular (diag not stored)
+    Entry *Tau,     // size k, the k Householder coefficients
+
+    // output
+    Entry *T,       // size k*k, triangular k-by-k matrix for block reflector
+
+    cholmod_common *cc
+)
+{
+    if (v <= 0 || k <= 0)
+    {
+        return ; // nothing to do
+    }
+    ASSERT (v >= k) ;
+    spqr_private_larft ('F', 'C', v, k, V, ldv, Tau, T, k, cc) ;
+}
+
+
+template <typename Entry> void spqr_larfb
+(
+    // inputs, not modified
+    int method,     // 0,1,2,3, as in spqr_larftb
+    Long m,         // C is m-by-n
+    Long n,
+    Long k,         // V is v-by-k
+                    // for methods 0 and 1, v = m,
+                    // for methods 2 and 3, v = n
+    Long ldc,       // leading dimension of C
+    Long ldv,       // leading dimension of V
+    Entry *V,       // V is v-by-k, unit lower triangular (diag not stored)
+    Entry *T,       // k-by-k matrix from spqr_larft
+
+    // input/output
+    Entry *C,       // C is m-by-n, with leading dimension ldc
+
+    // workspace, not defined on input or output
+    Entry *Work,    // for methods 0,1: size n*k
+                    // for methods 2,3: size m*k
+    cholmod_common *cc
+)
+{
+    if (m <= 0 || n <= 0 || k <= 0)
+    {
+        return ; // nothing to do
+    }
+    if (method == SPQR_QTX)
+    {
+        // Left, Transpose, Forward, Columwise:
+        spqr_private_larfb ('L', 'T', 'F', 'C', m, n, k, V, ldv, T, k, C, ldc,
+            Work, n, cc) ;
+    }
+    else if (method == SPQR_QX)
+    {
+        // Left, No Transpose, Forward, Columwise:
+        spqr_private_larfb ('L', 'N', 'F', 'C', m, n, k, V, ldv, T, k, C, ldc,
+            Work, n, cc) ;
+    }
+    else if (method == SPQR_XQT)
+    {
+        // Right, Transpose, Forward, Columwise:
+        spqr_private_larfb ('R', 'T', 'F', 'C', m, n, k, V, ldv, T, k, C, ldc,
+            Work, m, cc) ;
+    }
+    else if (method == SPQR_XQ)
+    {
+        // Right, No Transpose, Forward, Columwise:
+        spqr_private_larfb ('R', 'N', 'F', 'C', m, n, k, V, ldv, T, k, C, ldc,
+            Work, m, cc) ;
+    }
+}
+
 // =============================================================================
 
 template void spqr_larftb <double>
@@ -235,3 +323,77 @@ template void spqr_larftb <Complex>
                     // for methods 2,3: size k*k + m*k
     cholmod_common *cc
 ) ;
+
+// =============================================================================
+
+template void spqr_larft <double>
+(
+    // inputs, not modified (V is modified and then restored on output)
+    Long v,         // V is v-by-k
+    Long k,
+    Long ldv,       // leading dimension of V
+    double *V,      // V is v-by-k, unit lower triangular (diag not stored)
+    double *Tau,    // size k, the k Householder coefficients
+
+    // output
+    double *T,      // size k*k, triangular k-by-k matrix for block reflector
+
+    cholmod_common *cc
+) ;
+
+template void spqr_larft <Complex>
+(
+    // inputs, not modified (V is modified and then restored on output)
+    Long v,         // V is v-by-k
+    Long k,
+    Long ldv,       // leading dimension of V
+    Complex *V,     // V is v-by-k, unit lower triangular (diag not stored)
+    Complex *Tau,   // size k, the k Householder coefficients
+
+    // output
+    Complex *T,     // size k*k, triangular k-by-k matrix for block reflector
+
+    cholmod_common *cc
+) ;
+
+// =============================================================================
+
+template void spqr_larfb <double>
+(
+    // inputs, not modified
+    int method,     // 0,1,2,3, as in spqr_larftb
+    Long m,         // C is m-by-n
+    Long n,
+    Long k,         // V is v-by-k
+    Long ldc,       // leading dimension of C
+    Long ldv,       // leading dimension of V
+    double *V,      // V is v-by-k, unit lower triangular (diag not stored)
+    double *T,      // k-by-k matrix from spqr_larft
+
+    // input/output
+    double *C,      // C is m-by-n, with leading dimension ldc
+
+    // workspace, not defined on input or output
+    double *Work,   // size n*k (methods 0,1) or m*k (methods 2,3)
+    cholmod_common *cc
+) ;
+
+template void spqr_larfb <Complex>
+(
+    // inputs, not modified
+    int method,     // 0,1,2,3, as in spqr_larftb
+    Long m,         // C is m-by-n
+    Long n,
+    Long k,         // V is v-by-k
+    Long ldc,       // leading dimension of C
+    Long ldv,       // leading dimension of V
+    Complex *V,     // V is v-by-k, unit lower triangular (diag not stored)
+    Complex *T,     // k-by-k matrix from spqr_larft
+
+    // input/output
+    Complex *C,     // C is m-by-n, with leading dimension ldc
+
+    // workspace, not defined on input or output
+    Complex *Work,  // size n*k (methods 0,1) or m*k (methods 2,3)
+    cholmod_common *cc
+) ;
@@ -28,42 +28,45 @@
 //  triangular with implicit unit diagonal (the unit need not be actually
 //  present).
 
+//  If X is wide (method 0,1) or tall (method 2,3), cc->SPQR_nthreads > 1, and
+//  this function is not already called from a parallel region, the columns
+//  (method 0,1) or rows (method 2,3) of X are split into one slab per thread.
+//  The T matrix of the block reflector is constructed just once, and each
+//  thread applies it to its own slab.
+
 #include "spqr.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
-template <typename Entry> void spqr_panel
+#define PANEL_SLAB 64   // min # of columns (or rows) of X for each thread
+
+// =============================================================================
+// === spqr_private_panel_gather ===============================================
+// =============================================================================
+
+// Gather the rows Vi (method 0,1) or columns Vi (method 2,3) of X into C
+
+template <typename Entry> void spqr_private_panel_gather
 (
-    // input
-    int method,         // 0,1,2,3
+    int method,
     Long m,
     Long n,
-    Long v,             // length of the first vector in V
-    Long h,             // number of Householder vectors in the panel
-    Long *Vi,           // Vi [0:v-1] defines the pattern of the panel
-    Entry *V,           // v-by-h, panel of Householder vectors
-    Entry *Tau,         // size h, Householder coefficients for the panel
+    Long v,
+    Long *Vi,
     Long ldx,
-
-    // input/output
     Entry *X,           // m-by-n with leading dimension ldx
-
-    // workspace
-    Entry *C,           // method 0,1: v-by-n;  method 2,3: m-by-v
-    Entry *W,           // method 0,1: h*h+n*h; method 2,3: h*h+m*h
-
-    cholmod_common *cc
+    Long ldc,
+    Entry *C            // method 0,1: v-by-n;  method 2,3: m-by-v
 )
 {
     Entry *C1, *X1 ;
     Long k, p, i ;
 
-    // -------------------------------------------------------------------------
-    // gather X into workspace C
-    // -------------------------------------------------------------------------
-
     if (method == SPQR_QTX || method == SPQR_QX)
     {
         // X is m-by-n with leading dimension ldx
-        // C is v-by-n with leading dimension v
+        // C is v-by-n with leading dimension ldc
         C1 = C ;
         X1 = X ;
         for (k = 0 ; k < n ; k++)
@@ -73,14 +76,14 @@ template <typename Entry> void spqr_panel
                 i = Vi [p] ;
                 C1 [p] = X1 [i] ;
             }
-            C1 += v ;
+            C1 += ldc ;
             X1 += ldx ;
         }
     }
     else // if (method == SPQR_XQT || method == SPQR_XQ)
     {
         // X is m-by-n with leading dimension ldx
-        // C is m-by-v with leading dimension m
+        // C is m-by-v with leading dimension ldc
         C1 = C ;
         for (p = 0 ; p < v ; p++)
         {
@@ -90,26 +93,33 @@ template <typename Entry> void spqr_panel
             {
                 C1 [k] = X1 [k] ;
             }
-            C1 += m ;
+            C1 += ldc ;
         }
     }
+}
 
-    // -------------------------------------------------------------------------
-    // apply the Householder panel to C
-    // -------------------------------------------------------------------------
 
-    if (method == SPQR_QTX || method == SPQR_QX)
-    {
-        spqr_larftb (method, v, n, h, v, v, V, Tau, C, W, cc) ;
-    }
-    else // if (method == SPQR_XQT || method == SPQR_XQ)
-    {
-        spqr_larftb (method, m, v, h, m, v, V, Tau, C, W, cc) ;
-    }
+// =============================================================================
+// === spqr_private_panel_scatter ==============================================
+// =============================================================================
 
-    // -------------------------------------------------------------------------
-    // scatter C back into X
-    // -------------------------------------------------------------------------
+// Scatter C back into the rows Vi (method 0,1) or columns Vi (method 2,3) of X
+
+template <typename Entry> void spqr_private_panel_scatter
+(
+    int method,
+    Long m,
+    Long n,
+    Long v,
+    Long *Vi,
+    Long ldx,
+    Entry *X,           // m-by-n with leading dimension ldx
+    Long ldc,
+    Entry *C            // method 0,1: v-by-n;  method 2,3: m-by-v
+)
+{
+    Entry *C1, *X1 ;
+    Long k, p, i ;
 
     if (method == SPQR_QTX || method == SPQR_QX)
     {
@@ -122,7 +132,7 @@ template <typename Entry> void spqr_panel
                 i = Vi [p] ;
                 X1 [i] = C1 [p] ;
             }
-            C1 += v ;
+            C1 += ldc ;
             X1 += ldx ;
         }
     }
@@ -137,7 +147,114 @@ template <typename Entry> void spqr_panel
             {
                 X1 [k] = C1 [k] ;
             }
-            C1 += m ;
+            C1 += ldc ;
+        }
+    }
+}
+
+
+// =============================================================================
+// === spqr_panel ==============================================================
+// =============================================================================
+
+template <typename Entry> void spqr_panel
+(
+    // input
+    int method,         // 0,1,2,3
+    Long m,
+    Long n,
+    Long v,             // length of the first vector in V
+    Long h,             // number of Householder vectors in the panel
+    Long *Vi,           // Vi [0:v-1] defines the pattern of the panel
+    Entry *V,           // v-by-h, panel of Householder vectors
+    Entry *Tau,         // size h, Householder coefficients for the panel
+    Long ldx,
+
+    // input/output
+    Entry *X,           // m-by-n with leading dimension ldx
+
+    // workspace
+    Entry *C,           // method 0,1: v-by-n;  method 2,3: m-by-v
+    Entry *W,           // method 0,1: h*h+n*h; method 2,3: h*h+m*h
+
+    cholmod_common *cc
+)
+{
+    Long nx, nslabs ;
+
+    // -------------------------------------------------------------------------
+    // determine the number of slabs
+    // -------------------------------------------------------------------------
+
+    // X has nx independent columns (method 0,1) or rows (method 2,3)
+    nx = (method == SPQR_QTX || method == SPQR_QX) ? n : m ;
+    nslabs = 1 ;
+#ifdef _OPENMP
+    if (cc->SPQR_nthreads > 1 && !omp_in_parallel ( ))
+    {
+        nslabs = MIN (cc->SPQR_nthreads, nx / PANEL_SLAB) ;
+    }
+#endif
+
+    if (nslabs <= 1)
+    {
+
+        // ---------------------------------------------------------------------
+        // gather X into workspace C, apply the panel, and scatter C into X
+        // ---------------------------------------------------------------------
+
+        if (method == SPQR_QTX || method == SPQR_QX)
+        {
+            spqr_private_panel_gather (method, m, n, v, Vi, ldx, X, v, C) ;
+            spqr_larftb (method, v, n, h, v, v, V, Tau, C, W, cc) ;
+            spqr_private_panel_scatter (method, m, n, v, Vi, ldx, X, v, C) ;
+        }
+        else // if (method == SPQR_XQT || method == SPQR_XQ)
+        {
+            spqr_private_panel_gather (method, m, n, v, Vi, ldx, X, m, C) ;
+            spqr_larftb (method, m, v, h, m, v, V, Tau, C, W, cc) ;
+            spqr_private_panel_scatter (method, m, n, v, Vi, ldx, X, m, C) ;
+        }
+
+    }
+    else
+    {
+
+        // ---------------------------------------------------------------------
+        // construct T once, and apply the panel to each slab in parallel
+        // ---------------------------------------------------------------------
+
+        // W is split into T (h-by-h) and the workspace for the slabs; slab s
+        // uses columns (or rows) k1:k2-1 of C and of the workspace.
+        Entry *T = W ;
+        Entry *Work = W + h*h ;
+        spqr_larft (v, h, v, V, Tau, T, cc) ;
+
+        #pragma omp parallel for num_threads(nslabs) schedule(static,1)
+        for (Long s = 0 ; s < nslabs ; s++)
+        {
+            Long k1 = (s * nx) / nslabs ;
+            Long k2 = ((s+1) * nx) / nslabs ;
+            if (method == SPQR_QTX || method == SPQR_QX)
+            {
+                // apply the panel to X (:,k1:k2-1)
+                spqr_private_panel_gather (method, m, k2-k1, v, Vi, ldx,
+                    X + k1*ldx, v, C + k1*v) ;
+                spqr_larfb (method, v, k2-k1, h, v, v, V, T, C + k1*v,
+                    Work + k1*h, cc) ;
+                spqr_private_panel_scatter (method, m, k2-k1, v, Vi, ldx,
+                    X + k1*ldx, v, C + k1*v) ;
+            }
+            else // if (method == SPQR_XQT || method == SPQR_XQ)
+            {
+                // apply the panel to X (k1:k2-1,:)
+                spqr_private_panel_gather (method, k2-k1, n, v, Vi, ldx,
+                    X + k1, m, C + k1) ;
+                spqr_larfb (method, k2-k1, v, h, m, v, V, T, C + k1,
+                    Work + k1*h, cc) ;
+                spqr_private_panel_scatter (method, k2-k1, n, v, Vi, ldx,
+                    X + k1, m, C + k1) ;
+            }
         }
     }
 }
@@ -2,78 +2,58 @@
 // === spqr_parallel ===========================================================
 // =============================================================================
 
-// Factorize all the tasks in parallel with TBB.
+// Factorize all the tasks in parallel with OpenMP tasks.
 // The GPU is not used.
 
-#ifdef HAVE_TBB
-#include "spqr.hpp"
-#include <tbb/task_scheduler_init.h>
-#include <tbb/task.h>
+// The task tree is given by QRsym->TaskChildp and QRsym->TaskChild, as found
+// by spqr_analyze (controlled by cc->SPQR_grain and cc->SPQR_small).  Each
+// node of the tree creates one OpenMP task for each of its children, waits for
+// them, and then does its own work with spqr_kernel.  Idle threads steal the
+// pending tasks from the others, so a subtree that is larger than its siblings
+// does not leave the other threads idle.
 
-using namespace tbb ;
+#ifdef _OPENMP
+#include "spqr.hpp"
+#include <omp.h>
 
 // =============================================================================
 // === spqr_zippy ==============================================================
 // =============================================================================
 
-template <typename Entry> class spqr_zippy: public task
+template <typename Entry> static void spqr_zippy
+(
+    Long id,
+    spqr_blob <Entry> *Blob
+)
 {
-  public:
-
-    // -------------------------------------------------------------------------
-    // spqr_zippy state
-    // -------------------------------------------------------------------------
-
-    const Long id ;
-    spqr_blob <Entry> *Blob ;
 
     // -------------------------------------------------------------------------
-    // spqr_zippy constructor
+    // spawn my children
     // -------------------------------------------------------------------------
 
-    spqr_zippy (Long id_, spqr_blob <Entry> *Blob_) : id (id_), Blob (Blob_) { }
-
-    // -------------------------------------------------------------------------
-    // spqr_zippy task
-    // -------------------------------------------------------------------------
+    Long *TaskChildp = Blob->QRsym->TaskChildp ;
+    Long *TaskChild  = Blob->QRsym->TaskChild ;
+    Long pfirst = TaskChildp [id] ;
+    Long plast  = TaskChildp [id+1] ;
 
-    task* execute ( )
+    if (plast > pfirst)
     {
-
-        // ---------------------------------------------------------------------
-        // spawn my children
-        // ---------------------------------------------------------------------
-
-        Long *TaskChildp = Blob->QRsym->TaskChildp ;
-        Long *TaskChild  = Blob->QRsym->TaskChild ;
-        Long pfirst = TaskChildp [id] ;
-        Long plast  = TaskChildp [id+1] ;
-        Long nchildren = plast - pfirst ;
-
-        if (nchildren > 0)
+        // create one task for each child, and wait for all of them to finish
+        for (Long p = pfirst ; p < plast ; p++)
         {
-            // create a list of TBB tasks, one for each child
-            task_list TasksToDo ;
-            for (Long i = 0 ; i < nchildren ; i++)
-            {
-                Long child = TaskChild [pfirst+i] ;
-                TasksToDo.push_back (*new (allocate_child ( ))
-                    spqr_zippy (child, Blob)) ;
-            }
-            // spawn all children and wait for all of them to finish
-            set_ref_count (nchildren + 1) ;
-            spawn_and_wait_for_all (TasksToDo) ;
+            Long child = TaskChild [p] ;
+            #pragma omp task firstprivate (child) shared (Blob)
+            spqr_zippy (child, Blob) ;
         }
+        #pragma omp taskwait
+    }
 
-        // ---------------------------------------------------------------------
-        // chilren are done, do my own task
-        // ---------------------------------------------------------------------
-
-        spqr_kernel (id, Blob) ;
+    // -------------------------------------------------------------------------
+    // children are done, do my own task
+    // -------------------------------------------------------------------------
 
-        return (NULL) ;
-    }
-} ;
+    spqr_kernel (id, Blob) ;
+}
 
 
 // =============================================================================
@@ -87,12 +67,15 @@ template <typename Entry> void spqr_parallel
     spqr_blob <Entry> *Blob
 )
 {
-    // fire up TBB on the task tree, starting at the root id = ntasks-1
-    task_scheduler_init
-        init (nthreads <= 0 ? (task_scheduler_init::automatic) : nthreads) ;
-    spqr_zippy <Entry> & a = *new (task::allocate_root ( ))
-        spqr_zippy <Entry> (ntasks-1, Blob) ;
-    task::spawn_root_and_wait (a) ;
+    // start the task tree at the root id = ntasks-1, using the OpenMP default
+    // number of threads if nthreads <= 0
+    if (nthreads <= 0)
+    {
+        nthreads = omp_get_max_threads ( ) ;
+    }
+    #pragma omp parallel num_threads (nthreads)
+    #pragma omp single
+    spqr_zippy (ntasks-1, Blob) ;
 }
 
 // =============================================================================
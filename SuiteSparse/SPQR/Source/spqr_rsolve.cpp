@@ -55,6 +55,618 @@
 */
 
 #include "spqr.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// The blocked method (spqr_rsolve_fronts) is used instead of the column-by-
+// column loops below and in spqr_private_rtsolve when there are at least
+// RSOLVE_BLOCK right-hand sides, or when the task tree from spqr_analyze can
+// be used to solve with the fronts in parallel.
+#define RSOLVE_BLOCK 4
+
+// =============================================================================
+// === BLAS wrappers for the blocked method ====================================
+// =============================================================================
+
+inline void spqr_private_gemm (char transa, Long m, Long n, Long k,
+    double alpha, double *A, Long lda, double *B, Long ldb, double beta,
+    double *C, Long ldc, cholmod_common *cc)
+{
+    char transb = 'N' ;
+    BLAS_INT M = m, N = n, K = k, LDA = lda, LDB = ldb, LDC = ldc ;
+    if (CHECK_BLAS_INT &&
+        !(EQ (M,m) && EQ (N,n) && EQ (K,k) && EQ (LDA,lda) && EQ (LDB,ldb)
+          && EQ (LDC,ldc)))
+    {
+        cc->blas_ok = FALSE ;
+    }
+    if (!CHECK_BLAS_INT || cc->blas_ok)
+    {
+        BLAS_DGEMM (&transa, &transb, &M, &N, &K, &alpha, A, &LDA, B, &LDB,
+            &beta, C, &LDC) ;
+    }
+}
+
+inline void spqr_private_gemm (char transa, Long m, Long n, Long k,
+    double alpha, Complex *A, Long lda, Complex *B, Long ldb, double beta,
+    Complex *C, Long ldc, cholmod_common *cc)
+{
+    char transb = 'N' ;
+    double Alpha [2] = { alpha, 0 }, Beta [2] = { beta, 0 } ;
+    BLAS_INT M = m, N = n, K = k, LDA = lda, LDB = ldb, LDC = ldc ;
+    if (CHECK_BLAS_INT &&
+        !(EQ (M,m) && EQ (N,n) && EQ (K,k) && EQ (LDA,lda) && EQ (LDB,ldb)
+          && EQ (LDC,ldc)))
+    {
+        cc->blas_ok = FALSE ;
+    }
+    if (!CHECK_BLAS_INT || cc->blas_ok)
+    {
+        BLAS_ZGEMM (&transa, &transb, &M, &N, &K, Alpha, (double *) A, &LDA,
+            (double *) B, &LDB, Beta, (double *) C, &LDC) ;
+    }
+}
+
+inline void spqr_private_trsm (char transa, Long m, Long n, double *A,
+    Long lda, double *B, Long ldb, cholmod_common *cc)
+{
+    char side = 'L', uplo = 'U', diag = 'N' ;
+    double one = 1 ;
+    BLAS_INT M = m, N = n, LDA = lda, LDB = ldb ;
+    if (CHECK_BLAS_INT &&
+        !(EQ (M,m) && EQ (N,n) && EQ (LDA,lda) && EQ (LDB,ldb)))
+    {
+        cc->blas_ok = FALSE ;
+    }
+    if (!CHECK_BLAS_INT || cc->blas_ok)
+    {
+        BLAS_DTRSM (&side, &uplo, &transa, &diag, &M, &N, &one, A, &LDA,
+            B, &LDB) ;
+    }
+}
+
+inline void spqr_private_trsm (char transa, Long m, Long n, Complex *A,
+    Long lda, Complex *B, Long ldb, cholmod_common *cc)
+{
+    char side = 'L', uplo = 'U', diag = 'N' ;
+    double one [2] = { 1, 0 } ;
+    BLAS_INT M = m, N = n, LDA = lda, LDB = ldb ;
+    if (CHECK_BLAS_INT &&
+        !(EQ (M,m) && EQ (N,n) && EQ (LDA,lda) && EQ (LDB,ldb)))
+    {
+        cc->blas_ok = FALSE ;
+    }
+    if (!CHECK_BLAS_INT || cc->blas_ok)
+    {
+        BLAS_ZTRSM (&side, &uplo, &transa, &diag, &M, &N, one, (double *) A,
+            &LDA, (double *) B, &LDB) ;
+    }
+}
+
+// X(i) -= y, where other threads may be updating X(i) at the same time
+inline void spqr_private_atomic_sub (double *x, double y)
+{
+    #pragma omp atomic
+    (*x) -= y ;
+}
+
+inline void spqr_private_atomic_sub (Complex *x, Complex y)
+{
+    double *xz = (double *) x ;
+    #pragma omp atomic
+    xz [0] -= y.real ( ) ;
+    #pragma omp atomic
+    xz [1] -= y.imag ( ) ;
+}
+
+// =============================================================================
+// === spqr_private_rblock =====================================================
+// =============================================================================
+
+// Find the columns of the R block of front f, in the same way as the loops in
+// spqr_rsolve and spqr_private_rtsolve.  On output, Rcol [k] points to the
+// first entry of the kth column of the R block, for k = 0:fn-1, and Live [k]
+// is TRUE if the kth pivot column is live (k = 0:fp-1).  Returns rm, the
+// number of rows in the R block.
+
+template <typename Entry> Long spqr_private_rblock
+(
+    Long f,
+    SuiteSparseQR_factorization <Entry> *QR,
+    Entry **Rcol,               // size fn
+    Long *Live                  // size fp
+)
+{
+    spqr_symbolic *QRsym = QR->QRsym ;
+    spqr_numeric <Entry> *QRnum = QR->QRnum ;
+    Long *Stair = NULL ;
+    Long keepH = QRnum->keepH ;
+    Long fm = 0, h = 0, t = 0 ;
+
+    Entry *R = QRnum->Rblock [f] ;
+    Long col1 = QRsym->Super [f] ;          // first pivot column in front F
+    Long fp = QRsym->Super [f+1] - col1 ;   // number of pivots in front F
+    Long pr = QRsym->Rp [f] ;               // pointer to row indices for F
+    Long fn = QRsym->Rp [f+1] - pr ;        // # of columns in front F
+
+    if (keepH)
+    {
+        Stair = QRnum->HStair + pr ;        // staircase of front F
+        fm = QRnum->Hm [f] ;                // # of rows in front F
+    }
+
+    Long rm = 0, k ;
+    for (k = 0 ; k < fp ; k++)
+    {
+        Long live ;
+        if (keepH)
+        {
+            t = Stair [k] ;                 // length of R+H vector
+            if (t == 0)
+            {
+                live = FALSE ;              // column k is dead
+                t = rm ;                    // dead col, R only, no H
+                h = rm ;
+            }
+            else
+            {
+                live = (rm < fm) ;          // k is live, unless we hit the wall
+                h = rm + 1 ;                // H vector starts in row h
+            }
+        }
+        else
+        {
+            live = (!QRnum->Rdead [col1 + k]) ;
+        }
+        Rcol [k] = R ;
+        Live [k] = live ;
+        if (live) rm++ ;
+        R += rm + (keepH ? (t-h) : 0) ;
+    }
+    for ( ; k < fn ; k++)
+    {
+        Rcol [k] = R ;
+        R += rm ;
+        if (keepH)
+        {
+            t = Stair [k] ;
+            h = MIN (h+1, fm) ;
+            R += (t-h) ;
+        }
+    }
+    return (rm) ;
+}
+
+// =============================================================================
+// === spqr_private_rwork ======================================================
+// =============================================================================
+
+// Everything the blocked method needs to solve with one front, so that one
+// pointer can be passed to the OpenMP tasks.
+
+template <typename Entry> struct spqr_private_rwork
+{
+    SuiteSparseQR_factorization <Entry> *QR ;
+    int transpose ;         // FALSE: R\B, TRUE: R'\B
+    int parallel ;          // TRUE if other fronts are being done in parallel
+    Long *Q1fill ;          // for R\B only; NULL if the identity
+    Long nrhs ;
+    Long ldb ;
+    Entry *B ;              // for R\B only
+    Long ldx ;
+    Entry *X ;
+    Long *Rrow ;            // R block of front f is in rows Rrow [f:f+1]-1
+
+    // workspace for each thread, of size maxfn, 2*maxfn, and wsize
+    Long maxfn ;
+    Long wsize ;
+    Entry **Rcol ;
+    Long *Iwork ;
+    Entry *Work ;
+
+    // flop count of each task, summed when all the tasks are done
+    double *Flops ;
+} ;
+
+// =============================================================================
+// === spqr_private_rsolve_front ===============================================
+// =============================================================================
+
+// Solve with the R block of front f, with dense BLAS-3 kernels, using the
+// workspace of thread tid.  Let R11 be the upper triangular part of the R
+// block, in its live pivot columns (excluding any columns of Binput), and let
+// R2 be its live rectangular part.  For R\B, X1 = R11 \ (B1 - R2*X2), where
+// X2 is already known (it is held in the fronts of the ancestors of f).  For
+// R'\B, X1 = R11' \ X1, and then X2 = X2 - R2'*X1 is pushed to the ancestors.
+// Returns the flop count.
+
+template <typename Entry> double spqr_private_rsolve_front
+(
+    Long f,
+    int tid,
+    spqr_private_rwork <Entry> *Rwork,
+    cholmod_common *cc
+)
+{
+    SuiteSparseQR_factorization <Entry> *QR = Rwork->QR ;
+    spqr_symbolic *QRsym = QR->QRsym ;
+    Long *Q1fill = Rwork->Q1fill ;
+    Long *Rmap = QR->Rmap ;
+    char *Rdead = QR->QRnum->Rdead ;
+    Long n1cols = QR->n1cols ;
+    Long n = QR->nacols ;
+    Long rank = QR->rank ;
+    Long nrhs = Rwork->nrhs ;
+    Long ldx = Rwork->ldx ;
+    Entry *X = Rwork->X ;
+    Long i, k, kk ;
+
+    Long col1 = QRsym->Super [f] ;
+    Long fp = QRsym->Super [f+1] - col1 ;
+    Long pr = QRsym->Rp [f] ;
+    Long fn = QRsym->Rp [f+1] - pr ;
+    Long row1 = Rwork->Rrow [f] ;
+
+    // get the workspace of this thread
+    Entry **Rcol = Rwork->Rcol + tid * Rwork->maxfn ;
+    Long *Live = Rwork->Iwork + tid * 2 * Rwork->maxfn ;
+    Long *Cols = Live + Rwork->maxfn ;
+    Entry *R1 = Rwork->Work + tid * Rwork->wsize ;
+
+    Long rm = spqr_private_rblock (f, QR, Rcol, Live) ;
+    ASSERT (rm == Rwork->Rrow [f+1] - row1) ;
+
+    // -------------------------------------------------------------------------
+    // R1 = R11, the live pivot columns in [A Binput] that are in A
+    // -------------------------------------------------------------------------
+
+    // The columns of A come first, so the na rows of R11 are the leading na
+    // live pivot columns of the front.  Cols [0:na-1] are their rows of X.
+    Long na = 0 ;
+    for (k = 0 ; k < fp && na < rm ; k++)
+    {
+        if (!Live [k]) continue ;
+        Long jj = col1 + k + n1cols ;
+        if (jj >= n) break ;                // in case [A Binput] was factorized
+        Entry *R = Rcol [k] ;
+        Entry *R11 = R1 + na * rm ;
+        for (i = 0 ; i <= na ; i++)
+        {
+            R11 [i] = R [i] ;
+        }
+        Cols [na++] = Rwork->transpose ? 0 : (Q1fill ? Q1fill [jj] : jj) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // R2 = the live rectangular part of the R block, in rows 0:na-1
+    // -------------------------------------------------------------------------
+
+    Entry *R2 = R1 + rm * rm ;
+    Long *Cols2 = Cols + na ;
+    Long nc = 0 ;
+    if (na > 0)
+    {
+        for (k = fp ; k < fn ; k++)
+        {
+            Long j = QRsym->Rj [pr + k] ;
+            Long jj = j + n1cols ;
+            if (jj >= n) break ;            // in case [A Binput] was factorized
+            Long ii ;
+            if (Rwork->transpose)
+            {
+                // X (ii,:) is updated if the jth column of R is live
+                ii = Rmap ? Rmap [jj] : jj ;
+                if (ii >= rank) continue ;
+            }
+            else
+            {
+                // X (ii,:) is needed if the jth column of R is live
+                if (Rdead [j]) continue ;
+                ii = Q1fill ? Q1fill [jj] : jj ;
+            }
+            Entry *R = Rcol [k] ;
+            for (i = 0 ; i < na ; i++)
+            {
+                R2 [i] = R [i] ;
+            }
+            R2 += na ;
+            Cols2 [nc++] = ii ;
+        }
+        R2 = R1 + rm * rm ;
+    }
+    Entry *W = R2 + rm * nc ;               // size MAX (na,nc) by nrhs
+
+    if (!Rwork->transpose)
+    {
+
+        // ---------------------------------------------------------------------
+        // X1 = R11 \ (B1 - R2*X2)
+        // ---------------------------------------------------------------------
+
+        // W = B (row1:row1+na-1,:), and X2 = X (Cols2,:)
+        Entry *B = Rwork->B ;
+        Long ldb = Rwork->ldb ;
+        Entry *X2 = W + na * nrhs ;
+        for (kk = 0 ; kk < nrhs ; kk++)
+        {
+            for (i = 0 ; i < na ; i++)
+            {
+                Long ii = row1 + i ;
+                W [i + kk*na] = (ii < rank) ? B [INDEX (ii,kk,ldb)] : 0 ;
+            }
+            for (i = 0 ; i < nc ; i++)
+            {
+                X2 [i + kk*nc] = X [INDEX (Cols2 [i],kk,ldx)] ;
+            }
+        }
+        if (na > 0 && nc > 0)
+        {
+            spqr_private_gemm ('N', na, nrhs, nc, -1, R2, na, X2, nc, 1,
+                W, na, cc) ;
+        }
+        if (na > 0)
+        {
+            spqr_private_trsm ('N', na, nrhs, R1, rm, W, na, cc) ;
+        }
+        for (kk = 0 ; kk < nrhs ; kk++)
+        {
+            for (i = 0 ; i < na ; i++)
+            {
+                X [INDEX (Cols [i],kk,ldx)] = W [i + kk*na] ;
+            }
+        }
+    }
+    else if (na > 0)
+    {
+
+        // ---------------------------------------------------------------------
+        // X1 = R11' \ X1, and then X (Cols2,:) -= R2' * X1
+        // ---------------------------------------------------------------------
+
+        char trans = (spqr_type <Entry> ( ) == CHOLMOD_REAL) ? 'T' : 'C' ;
+        Entry *X1 = X + row1 ;
+        spqr_private_trsm (trans, na, nrhs, R1, rm, X1, ldx, cc) ;
+        if (nc > 0)
+        {
+            spqr_private_gemm (trans, nc, nrhs, na, 1, R2, na, X1, ldx, 0,
+                W, nc, cc) ;
+            for (kk = 0 ; kk < nrhs ; kk++)
+            {
+                for (i = 0 ; i < nc ; i++)
+                {
+                    Entry *xi = X + INDEX (Cols2 [i],kk,ldx) ;
+                    if (Rwork->parallel)
+                    {
+                        spqr_private_atomic_sub (xi, W [i + kk*nc]) ;
+                    }
+                    else
+                    {
+                        (*xi) -= W [i + kk*nc] ;
+                    }
+                }
+            }
+        }
+    }
+    return ((double) nrhs * na * (na + 2*nc)) ;
+}
+
+// =============================================================================
+// === spqr_private_rsolve_task ================================================
+// =============================================================================
+
+// Solve with the fronts of a task and all its descendants in the task tree.
+// For R\B the ancestors must be solved before their descendants, so the fronts
+// of the task are done first, in reverse order, and then its children.  For
+// R'\B the children are done first, and then the fronts of the task.  The
+// flop count of the task is kept in Rwork->Flops [task], since several tasks
+// cannot update cc->SPQR_flopcount at the same time.
+
+template <typename Entry> void spqr_private_rsolve_task
+(
+    Long task,
+    spqr_private_rwork <Entry> *Rwork,
+    cholmod_common *cc
+)
+{
+    spqr_symbolic *QRsym = Rwork->QR->QRsym ;
+    Long *TaskChildp = QRsym->TaskChildp ;
+    Long *TaskChild = QRsym->TaskChild ;
+    Long *TaskFront = QRsym->TaskFront ;
+    Long *TaskFrontp = QRsym->TaskFrontp ;
+    double flops = 0 ;
+    int tid = 0 ;
+
+    if (!Rwork->transpose)
+    {
+#ifdef _OPENMP
+        tid = omp_get_thread_num ( ) ;
+#endif
+        for (Long p = TaskFrontp [task+1] - 1 ; p >= TaskFrontp [task] ; p--)
+        {
+            Long f = TaskFront [p] ;
+            flops += spqr_private_rsolve_front (f, tid, Rwork, cc) ;
+        }
+    }
+
+    for (Long p = TaskChildp [task] ; p < TaskChildp [task+1] ; p++)
+    {
+        Long child = TaskChild [p] ;
+        #pragma omp task firstprivate (child) shared (Rwork, cc)
+        spqr_private_rsolve_task (child, Rwork, cc) ;
+    }
+
+    if (Rwork->transpose)
+    {
+        #pragma omp taskwait
+#ifdef _OPENMP
+        tid = omp_get_thread_num ( ) ;
+#endif
+        for (Long p = TaskFrontp [task] ; p < TaskFrontp [task+1] ; p++)
+        {
+            Long f = TaskFront [p] ;
+            flops += spqr_private_rsolve_front (f, tid, Rwork, cc) ;
+        }
+    }
+    Rwork->Flops [task] = flops ;
+}
+
+// =============================================================================
+// === spqr_rsolve_fronts ======================================================
+// =============================================================================
+
+// Solve with the multifrontal rows of R, one front at a time with dense BLAS-3
+// kernels, and with independent subtrees of the task tree in parallel if
+// cc->SPQR_nthreads > 1.  For R\B (transpose FALSE), B is m-by-nrhs and X is
+// n-by-nrhs; X must be zero on input.  For R'\B (transpose TRUE), X is m-by-
+// nrhs and is solved in place; B and Q1fill are not used.  Returns TRUE if
+// the fronts were solved, or FALSE if the caller should use its own
+// column-by-column method instead (for few right-hand sides, or if out of
+// memory).  The results agree with the column-by-column method to within
+// roundoff.
+
+template <typename Entry> int spqr_rsolve_fronts
+(
+    // inputs
+    SuiteSparseQR_factorization <Entry> *QR,
+    int transpose,          // FALSE: solve R\B, TRUE: solve R'\B
+    Long *Q1fill,           // for R\B only; NULL if the identity
+
+    Long nrhs,              // number of columns of B and X
+    Long ldb,               // leading dimension of B
+    Entry *B,               // for R\B only: size m-by-nrhs
+
+    // input/output
+    Long ldx,               // leading dimension of X
+    Entry *X,
+
+    cholmod_common *cc
+)
+{
+    spqr_symbolic *QRsym = QR->QRsym ;
+    Long nf = QRsym->nf ;
+    Long maxfn = QRsym->maxfn ;
+    Long maxfrank = QR->QRnum->maxfrank ;
+    int nthreads = 1 ;
+    int ok = TRUE ;
+
+#ifdef _OPENMP
+    if (cc->SPQR_nthreads > 1 && QRsym->ntasks > 1 &&
+        QRsym->TaskFront != NULL && !omp_in_parallel ( ))
+    {
+        nthreads = cc->SPQR_nthreads ;
+    }
+#endif
+    if (nf <= 0 || (nthreads <= 1 && nrhs < RSOLVE_BLOCK))
+    {
+        return (FALSE) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // allocate workspace
+    // -------------------------------------------------------------------------
+
+    // R11 (maxfrank-by-maxfrank), R2 (maxfrank-by-maxfn), and W and X2 (each
+    // maxfn-by-nrhs) for each thread
+    Long wsize = spqr_add (spqr_mult (maxfrank, maxfrank + maxfn, &ok),
+        spqr_mult (2*maxfn, nrhs, &ok), &ok) ;
+    Long isize = spqr_add (nf+1, spqr_mult (2*maxfn, nthreads, &ok), &ok) ;
+    Long rsize = spqr_mult (maxfn, nthreads, &ok) ;
+    Long xsize = spqr_mult (wsize, nthreads, &ok) ;
+
+    Long ntasks = (nthreads > 1) ? QRsym->ntasks : 1 ;
+
+    Long *Iwork = NULL ;
+    Entry **Rcol = NULL ;
+    Entry *Work = NULL ;
+    double *Flops = NULL ;
+    if (ok)
+    {
+        Iwork = (Long *) SuiteSparse_malloc (isize, sizeof (Long)) ;
+        Rcol = (Entry **) SuiteSparse_malloc (rsize, sizeof (Entry *)) ;
+        Work = (Entry *) SuiteSparse_malloc (xsize, sizeof (Entry)) ;
+        Flops = (double *) SuiteSparse_malloc (ntasks, sizeof (double)) ;
+    }
+    if (Iwork == NULL || Rcol == NULL || Work == NULL || Flops == NULL)
+    {
+        // out of memory; use the column-by-column method instead
+        SuiteSparse_free (Iwork) ;
+        SuiteSparse_free (Rcol) ;
+        SuiteSparse_free (Work) ;
+        SuiteSparse_free (Flops) ;
+        return (FALSE) ;
+    }
+
+    spqr_private_rwork <Entry> Rwork ;
+    Rwork.QR = QR ;
+    Rwork.transpose = transpose ;
+    Rwork.parallel = (nthreads > 1) ;
+    Rwork.Q1fill = Q1fill ;
+    Rwork.nrhs = nrhs ;
+    Rwork.ldb = ldb ;
+    Rwork.B = B ;
+    Rwork.ldx = ldx ;
+    Rwork.X = X ;
+    Rwork.Rrow = Iwork ;
+    Rwork.maxfn = maxfn ;
+    Rwork.wsize = wsize ;
+    Rwork.Rcol = Rcol ;
+    Rwork.Iwork = Iwork + nf + 1 ;
+    Rwork.Work = Work ;
+    Rwork.Flops = Flops ;
+
+    // -------------------------------------------------------------------------
+    // find the rows of R held in each front
+    // -------------------------------------------------------------------------
+
+    Long *Rrow = Rwork.Rrow ;
+    Rrow [0] = QR->n1rows ;
+    for (Long f = 0 ; f < nf ; f++)
+    {
+        Rrow [f+1] = Rrow [f] + spqr_private_rblock (f, QR, Rcol, Rwork.Iwork) ;
+    }
+    ASSERT (Rrow [nf] == QR->QRnum->rank + QR->n1rows) ;
+
+    // -------------------------------------------------------------------------
+    // solve with each front
+    // -------------------------------------------------------------------------
+
+    double flops = 0 ;
+    if (nthreads > 1)
+    {
+        #pragma omp parallel num_threads(nthreads)
+        #pragma omp single
+        spqr_private_rsolve_task (QRsym->ntasks - 1, &Rwork, cc) ;
+
+        // all tasks are done; sum up their flop counts
+        for (Long task = 0 ; task < ntasks ; task++)
+        {
+            flops += Flops [task] ;
+        }
+    }
+    else if (transpose)
+    {
+        for (Long f = 0 ; f < nf ; f++)
+        {
+            flops += spqr_private_rsolve_front (f, 0, &Rwork, cc) ;
+        }
+    }
+    else
+    {
+        for (Long f = nf-1 ; f >= 0 ; f--)
+        {
+            flops += spqr_private_rsolve_front (f, 0, &Rwork, cc) ;
+        }
+    }
+    FLOP_COUNT (flops) ;
+
+    SuiteSparse_free (Iwork) ;
+    SuiteSparse_free (Rcol) ;
+    SuiteSparse_free (Work) ;
+    SuiteSparse_free (Flops) ;
+    return (TRUE) ;
+}
+
 
 template <typename Entry> void spqr_rsolve
 (
@@ -146,6 +758,12 @@ template <typename Entry> void spqr_rsolve
     // factor of [A Binput]
 
     row2 = QRnum->rank + n1rows ;
+    if (spqr_rsolve_fronts (QR, FALSE, Q1fill, nrhs, ldb, B, n, X, cc))
+    {
+        // the fronts have been solved with the blocked method
+        nf = 0 ;
+        row2 = n1rows ;
+    }
     for (f = nf-1 ; f >= 0 ; f--)
     {
 
@@ -418,3 +1036,39 @@ template void spqr_rsolve <Complex>
     cholmod_common *cc
 ) ;
 
+
+template int spqr_rsolve_fronts <double>
+(
+    // inputs
+    SuiteSparseQR_factorization <double> *QR,
+    int transpose,
+    Long *Q1fill,
+
+    Long nrhs,
+    Long ldb,
+    double *B,
+
+    // input/output
+    Long ldx,
+    double *X,
+
+    cholmod_common *cc
+) ;
+
+template int spqr_rsolve_fronts <Complex>
+(
+    // inputs
+    SuiteSparseQR_factorization <Complex> *QR,
+    int transpose,
+    Long *Q1fill,
+
+    Long nrhs,
+    Long ldb,
+    Complex *B,
+
+    // input/output
+    Long ldx,
+    Complex *X,
+
+    cholmod_common *cc
+) ;
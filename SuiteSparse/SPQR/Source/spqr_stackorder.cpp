@@ -0,0 +1,154 @@
+// =============================================================================
+// === spqr_stackorder =========================================================
+// =============================================================================
+
+// Reorder the children of each front so that the peak size of the stack, for
+// the sequential factorization, is as small as possible (Liu's ordering of the
+// front tree: J. W. H. Liu, "On the storage requirement in the out-of-core
+// multifrontal method for sparse factorization", ACM Trans. Math. Software,
+// 12(3), 1986).
+//
+// The stack model is the same as in spqr_analyze.  To factorize front F, F
+// is allocated on the stack, the C blocks of its children are assembled into
+// F and deleted, the C block of F is created, and F is then replaced by its R
+// block (or R and H), which remains on the stack.  Once the subtree rooted at
+// front c is factorized, it leaves Resid [c] entries on the stack (its R or RH
+// blocks and the C block of c), and it needed Peak [c] entries at its peak.
+// Visiting the children of each front in decreasing order of Peak [c] -
+// Resid [c] minimizes the peak stack size for the subtree of the parent.
+//
+// On input, Post is a postordering of the front tree and Child [Childp [f] ...
+// Childp [f+1]-1] are the children of front f.  On output, each list of
+// children is sorted in the order the children should be visited.  Post is
+// not modified; a new postordering can be found by cholmod_l_postorder, with
+// Weight [c] equal to the position of c in Child.
+//
+// Only the stack is modeled, and only the stack is reduced: its peak size, in
+// entries, is what cc->SPQR_istat [8] (the bound from the analysis) and
+// cc->SPQR_istat [9] (the peak of the numeric factorization) report.  The
+// rest of the memory used (the symbolic object, S, and the workspace) does not
+// depend on the order of the children.  The total peak, in bytes, is
+// cc->memory_usage.
+//
+// Returns the peak stack size with the new order, or EMPTY if out of memory
+// (in which case Child is not modified).
+
+#include "spqr.hpp"
+
+struct spqr_private_child
+{
+    Long key ;          // Peak [c] - Resid [c]
+    Long c ;            // the child c
+} ;
+
+// sort by decreasing key, with ties broken by increasing child
+static int spqr_private_child_cmp (const void *p1, const void *p2)
+{
+    const spqr_private_child *a = (const spqr_private_child *) p1 ;
+    const spqr_private_child *b = (const spqr_private_child *) p2 ;
+    if (a->key != b->key) return ((a->key > b->key) ? -1 : 1) ;
+    return ((a->c < b->c) ? -1 : ((a->c > b->c) ? 1 : 0)) ;
+}
+
+Long spqr_stackorder        // returns the new peak stack size, or EMPTY
+(
+    // inputs, not modified
+    Long nf,                // number of fronts
+    Long *Fsize,            // size nf, Fsize [f] = size of front F
+    Long *Csize,            // size nf, Csize [f] = size of the C block of F
+    Long *Rsize,            // size nf, Rsize [f] = size of R (or RH) of F
+    Long *Post,             // size nf+1, postordering of the front tree
+    Long *Childp,           // size nf+2, from QRsym
+
+    // input/output
+    Long *Child,            // size nf+1; each list of children is reordered
+
+    // workspace and parameters
+    cholmod_common *cc
+)
+{
+    spqr_private_child *Pair ;
+    Long *Peak, *Resid, kf, f, p1, nc, k, c, stack, peak, ctot ;
+
+    // -------------------------------------------------------------------------
+    // allocate workspace
+    // -------------------------------------------------------------------------
+
+    Peak  = (Long *) cholmod_l_malloc (nf+1, sizeof (Long), cc) ;
+    Resid = (Long *) cholmod_l_malloc (nf+1, sizeof (Long), cc) ;
+    Pair  = (spqr_private_child *)
+        cholmod_l_malloc (nf+1, sizeof (spqr_private_child), cc) ;
+
+    if (cc->status < CHOLMOD_OK)
+    {
+        // out of memory; the order of the children is not modified
+        cholmod_l_free (nf+1, sizeof (Long), Peak, cc) ;
+        cholmod_l_free (nf+1, sizeof (Long), Resid, cc) ;
+        cholmod_l_free (nf+1, sizeof (spqr_private_child), Pair, cc) ;
+        cc->status = CHOLMOD_OK ;
+        return (EMPTY) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // sort the children of each front, from the bottom of the tree up
+    // -------------------------------------------------------------------------
+
+    peak = 0 ;
+    for (kf = 0 ; kf <= nf ; kf++)
+    {
+        // Post [nf] is nf, the placeholder root of the whole tree
+        f = Post [kf] ;
+        ASSERT (f >= 0 && f <= nf) ;
+
+        // sort the children of f in decreasing order of Peak - Resid
+        p1 = Childp [f] ;
+        nc = Childp [f+1] - p1 ;
+        for (k = 0 ; k < nc ; k++)
+        {
+            c = Child [p1 + k] ;
+            Pair [k].key = Peak [c] - Resid [c] ;
+            Pair [k].c = c ;
+        }
+        qsort (Pair, nc, sizeof (spqr_private_child), spqr_private_child_cmp) ;
+
+        // factorize the subtrees of the children, in that order
+        stack = 0 ;
+        peak = 0 ;
+        ctot = 0 ;
+        for (k = 0 ; k < nc ; k++)
+        {
+            c = Pair [k].c ;
+            Child [p1 + k] = c ;
+            peak = MAX (peak, stack + Peak [c]) ;
+            stack += Resid [c] ;
+            ctot += Csize [c] ;
+        }
+
+        if (f < nf)
+        {
+            // allocate F, assemble and delete the children, and factor F
+            stack += Fsize [f] ;
+            peak = MAX (peak, stack) ;
+            stack -= ctot ;
+            ASSERT (stack >= 0) ;
+
+            // create the C block of F, then replace F with R or RH
+            stack += Csize [f] ;
+            peak = MAX (peak, stack) ;
+            stack += Rsize [f] - Fsize [f] ;
+            ASSERT (stack >= 0) ;
+        }
+
+        Peak [f] = peak ;
+        Resid [f] = stack ;
+    }
+
+    // -------------------------------------------------------------------------
+    // free workspace and return the peak stack size of the whole tree
+    // -------------------------------------------------------------------------
+
+    cholmod_l_free (nf+1, sizeof (Long), Peak, cc) ;
+    cholmod_l_free (nf+1, sizeof (Long), Resid, cc) ;
+    cholmod_l_free (nf+1, sizeof (spqr_private_child), Pair, cc) ;
+    return (peak) ;
+}
@@ -10,10 +10,239 @@
 // not have sorted columns, but it cannot have duplicate entries.  Note that P
 // itself is not returned; its inverse PLinv is returned instead.
 //
+// If regularize is TRUE, S is the pattern of [A ; I] (P,Qfill) instead, where
+// the n diagonal rows are not formed.  Row m+j of [A ; I] has a single entry
+// in column j of A, so it is placed with the rows whose leftmost column is j.
+// Its numerical value (lambda) is supplied later, by spqr_stranspose2.
+//
 // The time taken by this function is O(nnz(A)+m+n).  In practice, it takes
 // slightly more time than computing the transpose, S=A'.
+//
+// If cc->SPQR_nthreads > 1, A has sorted columns, and A is large enough, S is
+// constructed in parallel by spqr_private_pstranspose1, below.  The result is
+// the same as the sequential construction of S, for any number of threads.
 
 #include "spqr.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define STRANSPOSE_CHUNK 16384  // min # of entries of A for each thread
+
+#ifdef _OPENMP
+
+// =============================================================================
+// === spqr_private_pstranspose1 ===============================================
+// =============================================================================
+
+// Constructs S in parallel, with the same result as the sequential algorithm
+// in spqr_stranspose1.  Thread t owns the rows i1:i2-1 of A, where i1 = t*m/T
+// and i2 = (t+1)*m/T for T threads, and it finds the entries in those rows of
+// each column of A by a binary search, since the columns of A are sorted.
+// Each thread thus sees the entries of its own rows in the same order as the
+// sequential algorithm (column by column of A(:,Qfill)), so no atomic updates
+// are needed, and very tall matrices with few columns are also done in
+// parallel.  A row i of A becomes a row of S when it is first seen, in its
+// leftmost column col.  Within the list of rows whose leftmost column is col,
+// the rows of thread t come after those of threads 0 to t-1, since the
+// columns are sorted.  The size of each list is found in a first pass, and
+// the rows are numbered in a second pass.  Cnt is workspace of size T*n.
+
+static void spqr_private_pstranspose1
+(
+    cholmod_sparse *A,
+    Long *Qfill,
+    int regularize,
+    Long *Sp,
+    Long *Sj,
+    Long *PLinv,
+    Long *Sleft,
+    Long *W,
+    Long *Cnt,          // size nthreads*n
+    int nthreads
+)
+{
+    Long m, n, ms, nonempty, *Ap, *Ai ;
+
+    m = A->nrow ;
+    n = A->ncol ;
+    Ap = (Long *) A->p ;
+    Ai = (Long *) A->i ;
+    ms = regularize ? (m+n) : m ;
+
+    // -------------------------------------------------------------------------
+    // count the entries in each row of A, and the new rows in each column
+    // -------------------------------------------------------------------------
+
+    // On output, PLinv [i] = FLIP (col) if col is the leftmost column of row i
+    // of A(:,Qfill), or FLIP (n) if row i is empty.  Cnt [t*n+col] is the
+    // number of rows of thread t whose leftmost column is col, and W [i] is
+    // the number of entries in row i of A.
+
+    #pragma omp parallel for num_threads(nthreads) schedule(static,1)
+    for (Long t = 0 ; t < nthreads ; t++)
+    {
+        Long i1 = (t * m) / nthreads ;
+        Long i2 = ((t+1) * m) / nthreads ;
+        Long *Tcnt = Cnt + t*n ;
+        for (Long i = i1 ; i < i2 ; i++)
+        {
+            PLinv [i] = FLIP (n) ;
+            W [i] = 0 ;
+        }
+        for (Long col = 0 ; col < n ; col++)
+        {
+            Long j = Qfill ? Qfill [col] : col ;
+            Long pend = Ap [j+1] ;
+            Tcnt [col] = 0 ;
+            for (Long p = spqr_colsearch (Ai, Ap [j], pend, i1) ;
+                p < pend && Ai [p] < i2 ; p++)
+            {
+                Long i = Ai [p] ;
+                if (PLinv [i] == FLIP (n))
+                {
+                    // column col is the leftmost column of row i
+                    PLinv [i] = FLIP (col) ;
+                    Tcnt [col]++ ;
+                }
+                W [i]++ ;
+            }
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // compute Sleft, and the first row of S for each thread in each list
+    // -------------------------------------------------------------------------
+
+    nonempty = 0 ;
+    for (Long col = 0 ; col < n ; col++)
+    {
+        Sleft [col] = nonempty ;
+        for (Long t = 0 ; t < nthreads ; t++)
+        {
+            Long c = Cnt [t*n+col] ;
+            Cnt [t*n+col] = nonempty ;      // first row of S for thread t
+            nonempty += c ;
+        }
+        if (regularize)
+        {
+            // the diagonal row m+j of [A ; I] is the last row of the list
+            Long j = Qfill ? Qfill [col] : col ;
+            PLinv [m+j] = nonempty++ ;
+        }
+    }
+    Sleft [n] = nonempty ;
+    Sleft [n+1] = ms ;
+
+    // -------------------------------------------------------------------------
+    // find PLinv for the non-empty rows of A, and the row counts of S
+    // -------------------------------------------------------------------------
+
+    // The row counts of S are placed in Sp [row], since W [i] is the count
+    // for row i of A.
+
+    #pragma omp parallel for num_threads(nthreads) schedule(static,1)
+    for (Long t = 0 ; t < nthreads ; t++)
+    {
+        Long i1 = (t * m) / nthreads ;
+        Long i2 = ((t+1) * m) / nthreads ;
+        Long *Tcnt = Cnt + t*n ;
+        for (Long col = 0 ; col < n ; col++)
+        {
+            Long j = Qfill ? Qfill [col] : col ;
+            Long pend = Ap [j+1] ;
+            for (Long p = spqr_colsearch (Ai, Ap [j], pend, i1) ;
+                p < pend && Ai [p] < i2 ; p++)
+            {
+                Long i = Ai [p] ;
+                if (PLinv [i] == FLIP (col))
+                {
+                    // row i becomes the next row of S in the list for col
+                    Long row = Tcnt [col]++ ;
+                    PLinv [i] = row ;
+                    Sp [row] = W [i] ;
+                }
+            }
+        }
+    }
+
+    if (regularize)
+    {
+        for (Long j = 0 ; j < n ; j++)
+        {
+            Sp [PLinv [m+j]] = 1 ;
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // place the empty rows of A last, in increasing order
+    // -------------------------------------------------------------------------
+
+    if (nonempty < ms)
+    {
+        #pragma omp parallel for num_threads(nthreads) schedule(static)
+        for (Long i = 0 ; i < m ; i++)
+        {
+            W [i] = (PLinv [i] == FLIP (n)) ;
+        }
+        DEBUG (Long nempty =) spqr_pcumsum (m, nthreads, W) ;
+        ASSERT (nonempty + nempty == ms) ;
+        #pragma omp parallel for num_threads(nthreads) schedule(static)
+        for (Long i = 0 ; i < m ; i++)
+        {
+            if (PLinv [i] == FLIP (n))
+            {
+                Long row = nonempty + W [i] ;
+                PLinv [i] = row ;
+                Sp [row] = 0 ;
+            }
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // compute the row pointers of S (and a copy in W)
+    // -------------------------------------------------------------------------
+
+    Sp [ms] = spqr_pcumsum (ms, nthreads, Sp) ;
+
+    #pragma omp parallel for num_threads(nthreads) schedule(static)
+    for (Long row = 0 ; row < ms ; row++)
+    {
+        W [row] = Sp [row] ;
+    }
+
+    // -------------------------------------------------------------------------
+    // create S = A (p,q)', or S=A(p,q) if S is considered to be in row-form
+    // -------------------------------------------------------------------------
+
+    #pragma omp parallel for num_threads(nthreads) schedule(static,1)
+    for (Long t = 0 ; t < nthreads ; t++)
+    {
+        Long i1 = (t * m) / nthreads ;
+        Long i2 = ((t+1) * m) / nthreads ;
+        for (Long col = 0 ; col < n ; col++)
+        {
+            Long j = Qfill ? Qfill [col] : col ;
+            Long pend = Ap [j+1] ;
+            for (Long p = spqr_colsearch (Ai, Ap [j], pend, i1) ;
+                p < pend && Ai [p] < i2 ; p++)
+            {
+                Sj [W [PLinv [Ai [p]]]++] = col ;
+            }
+        }
+    }
+
+    if (regularize)
+    {
+        for (Long col = 0 ; col < n ; col++)
+        {
+            Long j = Qfill ? Qfill [col] : col ;
+            Sj [Sp [PLinv [m+j]]] = col ;   // the diagonal entry of row m+j
+        }
+    }
+}
+
+#endif
 
 void spqr_stranspose1
 (
@@ -23,12 +252,15 @@ void spqr_stranspose1
                         // Qfill [k] = j
                         // if the kth column of S is the jth column of A.
                         // Identity permutation is used if Qfill is NULL.
+    int regularize,     // if TRUE, S = [A ; I] (P,Qfill), and S has m+n rows
 
     // output, contents not defined on input
     // FUTURE : make S cholmod_sparse
     Long *Sp,           // size m+1, row pointers of S
     Long *Sj,           // size nz, column indices of S
-    Long *PLinv,        // size m, inverse row permutation, PLinv [i] = k
+    Long *PLinv,        // size m, inverse row permutation, PLinv [i] = k.
+                        // If regularize is TRUE, m is A->nrow + A->ncol
+                        // in all of these sizes, and nz is nnz(A) + A->ncol.
     Long *Sleft,        // size n+2, Sleft [j] ... Sleft [j+1]-1 is the list of
                         // rows of S whose leftmost column index is j.  The list
                         // can be empty (that is, Sleft [j] == Sleft [j+1]).
@@ -37,10 +269,13 @@ void spqr_stranspose1
                         // Sleft [n+1]-1 gives the empty rows of S.
 
     // workspace, not defined on input or output
-    Long *W              // size m
+    Long *W,             // size m
+
+    // workspace and parameters
+    cholmod_common *cc
 )
 {
-    Long i, j, p, pend, t, k, row, col, kstart, s, m, n, *Ap, *Ai ;
+    Long i, j, p, pend, t, k, row, col, kstart, s, m, n, ms, *Ap, *Ai ;
 
     // -------------------------------------------------------------------------
     // get inputs
@@ -50,12 +285,38 @@ void spqr_stranspose1
     n = A->ncol ;
     Ap = (Long *) A->p ;
     Ai = (Long *) A->i ;
+    ms = regularize ? (m+n) : m ;   // number of rows of S
+
+    // -------------------------------------------------------------------------
+    // construct S in parallel, if requested and if A is large enough
+    // -------------------------------------------------------------------------
+
+#ifdef _OPENMP
+    int nthreads = 1 ;
+    if (cc->SPQR_nthreads > 1 && A->sorted && !omp_in_parallel ( ))
+    {
+        nthreads = (int) MIN (cc->SPQR_nthreads, Ap [n] / STRANSPOSE_CHUNK) ;
+    }
+    if (nthreads > 1)
+    {
+        Long *Cnt = (Long *) cholmod_l_malloc (nthreads*n, sizeof (Long), cc) ;
+        if (Cnt != NULL)
+        {
+            spqr_private_pstranspose1 (A, Qfill, regularize, Sp, Sj, PLinv,
+                Sleft, W, Cnt, nthreads) ;
+            cholmod_l_free (nthreads*n, sizeof (Long), Cnt, cc) ;
+            return ;
+        }
+        // out of memory; construct S sequentially instead
+        cc->status = CHOLMOD_OK ;
+    }
+#endif
 
     // -------------------------------------------------------------------------
     // clear the inverse permutation
     // -------------------------------------------------------------------------
 
-    for (i = 0 ; i < m ; i++)
+    for (i = 0 ; i < ms ; i++)
     {
         PLinv [i] = EMPTY ;             // position of A(i,:) undefined in S
         DEBUG (W [i] = EMPTY) ;
@@ -90,6 +351,13 @@ void spqr_stranspose1
                 W [row]++ ;             // one more entry S(row,col)
             }
         }
+        if (regularize)
+        {
+            // the diagonal row m+j of [A ; I] becomes the next row of S
+            row = k++ ;
+            PLinv [m+j] = row ;
+            W [row] = 1 ;
+        }
         Sleft [col] = k - kstart ;      // number of rows of S with leftmost
                                         // column in col
     }
@@ -106,13 +374,13 @@ void spqr_stranspose1
         Sleft [col] = t ;
     }
     Sleft [n] = k ;
-    Sleft [n+1] = m ;
+    Sleft [n+1] = ms ;
 
     // -------------------------------------------------------------------------
     // finish up the row permutation, in case A has empty rows
     // -------------------------------------------------------------------------
 
-    if (k < m)
+    if (k < ms)
     {
         for (i = 0 ; i < m ; i++)
         {
@@ -124,22 +392,22 @@ void spqr_stranspose1
             }
         }
     }
-    ASSERT (k == m) ;
-    DEBUG (for (i = 0 ; i < m ; i++) ASSERT (W [i] >= 0)) ;
+    ASSERT (k == ms) ;
+    DEBUG (for (i = 0 ; i < ms ; i++) ASSERT (W [i] >= 0)) ;
 
     // -------------------------------------------------------------------------
     // compute the row pointers of S (and a copy in W)
     // -------------------------------------------------------------------------
 
     p = 0 ;
-    for (row = 0 ; row < m ; row++)
+    for (row = 0 ; row < ms ; row++)
     {
         t = p ;
         p += W [row] ;
         W [row] = t ;                   // replace W with cumsum ([0 W])
         Sp [row] = t ;                  // and copy into Sp as well
     }
-    Sp [m] = p ;
+    Sp [ms] = p ;
 
     // -------------------------------------------------------------------------
     // create S = A (p,q)', or S=A(p,q) if S is considered to be in row-form
@@ -156,5 +424,10 @@ void spqr_stranspose1
             s = W [row]++ ;             // place S(row,col) in position
             Sj [s] = col ;
         }
+        if (regularize)
+        {
+            s = W [PLinv [m+j]]++ ;     // the diagonal entry of row m+j
+            Sj [s] = col ;
+        }
     }
 }
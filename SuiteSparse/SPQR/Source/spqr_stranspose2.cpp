@@ -2,9 +2,22 @@
 // === spqr_stranspose2 ========================================================
 // =============================================================================
 
-// Construct the numerical values of S = A (p,q) in compressed-row form
+// Construct the numerical values of S = A (p,q) in compressed-row form.
+// If regularize is TRUE, S = [A ; lambda*I] (p,q), where the pattern of the
+// n diagonal rows was found by spqr_stranspose1.
+//
+// If cc->SPQR_nthreads > 1, A has sorted columns, and A is large enough, S is
+// created in parallel.  As in spqr_stranspose1, thread t owns a contiguous
+// range of the rows of A, and it finds the entries in those rows of each
+// column of A by a binary search.  It thus places the entries of its own rows
+// of S in the same order as the sequential algorithm, without atomic updates.
 
 #include "spqr.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define STRANSPOSE_CHUNK 16384  // min # of entries of A for each thread
 
 template <typename Entry> void spqr_stranspose2
 (
@@ -17,15 +30,20 @@ template <typename Entry> void spqr_stranspose2
 
     Long *Sp,           // size m+1, row pointers of S
     Long *PLinv,        // size m, inverse row permutation, PLinv [i] = k
+    int regularize,     // if TRUE, S = [A ; lambda*I] (p,q) has m+n rows
+    double lambda,      // the diagonal of the regularization rows
 
     // output, contents not defined on input
     Entry *Sx,          // size nz, numerical values of S
 
     // workspace, not defined on input or output
-    Long *W             // size m
+    Long *W,            // size m
+
+    // workspace and parameters
+    cholmod_common *cc
 )
 {
-    Long i, j, p, pend, row, col, s, m, n, *Ap, *Ai ;
+    Long i, j, p, pend, row, col, s, m, n, ms, *Ap, *Ai ;
     Entry *Ax ;
 
     // -------------------------------------------------------------------------
@@ -37,12 +55,57 @@ template <typename Entry> void spqr_stranspose2
     Ap = (Long *) A->p ;
     Ai = (Long *) A->i ;
     Ax = (Entry *) A->x ;
+    ms = regularize ? (m+n) : m ;   // number of rows of S
+
+    // -------------------------------------------------------------------------
+    // create S in parallel, if requested and if A is large enough
+    // -------------------------------------------------------------------------
+
+#ifdef _OPENMP
+    int nthreads = 1 ;
+    if (cc->SPQR_nthreads > 1 && A->sorted && !omp_in_parallel ( ))
+    {
+        nthreads = (int) MIN (cc->SPQR_nthreads, Ap [n] / STRANSPOSE_CHUNK) ;
+    }
+    if (nthreads > 1)
+    {
+        #pragma omp parallel for num_threads(nthreads) schedule(static,1)
+        for (Long t = 0 ; t < nthreads ; t++)
+        {
+            Long i1 = (t * m) / nthreads ;
+            Long i2 = ((t+1) * m) / nthreads ;
+            for (Long ii = i1 ; ii < i2 ; ii++)
+            {
+                W [PLinv [ii]] = Sp [PLinv [ii]] ;
+            }
+            for (Long kk = 0 ; kk < n ; kk++)
+            {
+                Long jj = Qfill ? Qfill [kk] : kk ;
+                Long ppend = Ap [jj+1] ;
+                for (Long pp = spqr_colsearch (Ai, Ap [jj], ppend, i1) ;
+                    pp < ppend && Ai [pp] < i2 ; pp++)
+                {
+                    Sx [W [PLinv [Ai [pp]]]++] = Ax [pp] ;
+                }
+            }
+        }
+        if (regularize)
+        {
+            // each diagonal row has just one entry
+            for (j = 0 ; j < n ; j++)
+            {
+                Sx [Sp [PLinv [m+j]]] = lambda ;
+            }
+        }
+        return ;
+    }
+#endif
 
     // -------------------------------------------------------------------------
     // create S = A (p,q)', or S=A(p,q) if S is considered to be in row-form
     // -------------------------------------------------------------------------
 
-    for (row = 0 ; row < m ; row++)
+    for (row = 0 ; row < ms ; row++)
     {
         W [row] = Sp [row] ;
     }
@@ -58,6 +121,11 @@ template <typename Entry> void spqr_stranspose2
             s = W [row]++ ;             // place S(row,col) in position
             Sx [s] = Ax [p] ;
         }
+        if (regularize)
+        {
+            s = W [PLinv [m+j]]++ ;     // the diagonal entry of row m+j
+            Sx [s] = lambda ;
+        }
     }
 }
 
@@ -75,12 +143,17 @@ template void spqr_stranspose2 <double>
 
     Long *Sp,           // size m+1, row pointers of S
     Long *PLinv,        // size m, inverse row permutation, PLinv [i] = k
+    int regularize,     // if TRUE, S = [A ; lambda*I] (p,q) has m+n rows
+    double lambda,      // the diagonal of the regularization rows
 
     // output, contents not defined on input
     double *Sx,         // size nz, numerical values of S
 
     // workspace, not defined on input or output
-    Long *W             // size m
+    Long *W,            // size m
+
+    // workspace and parameters
+    cholmod_common *cc
 ) ;
 
 // =============================================================================
@@ -96,11 +169,16 @@ template void spqr_stranspose2 <Complex>
 
     Long *Sp,           // size m+1, row pointers of S
     Long *PLinv,        // size m, inverse row permutation, PLinv [i] = k
+    int regularize,     // if TRUE, S = [A ; lambda*I] (p,q) has m+n rows
+    double lambda,      // the diagonal of the regularization rows
 
     // output, contents not defined on input
     Complex *Sx,        // size nz, numerical values of S
 
     // workspace, not defined on input or output
-    Long *W             // size m
+    Long *W,            // size m
+
+    // workspace and parameters
+    cholmod_common *cc
 ) ;
 
@@ -2644,7 +2644,7 @@ int do_matrix (int kind, FILE *file, cholmod_common *cc)
     fprintf (stderr, " CPU ") ;
     nfail0 = do_matrix2 (kind, A, cc) ;
 
-    // non-defaults to test TBB, if installed (will not use the GPU)
+    // non-defaults to test OpenMP tasks, if enabled (will not use the GPU)
     cc->SPQR_grain = 4 ;         // grain size relative to total work
     nfail2 = do_matrix2 (kind, A, cc) ;
     cc->SPQR_grain = 1 ;         // no parallel analysis
@@ -2762,6 +2762,1217 @@ int do_matrix2 (int kind, cholmod_sparse *A, cholmod_common *cc)
 }
 
 
+// =============================================================================
+// === tile_test ===============================================================
+// =============================================================================
+
+// Factorize a matrix with nblocks diagonal blocks, each a dense 1010-by-1000
+// block, so that each front is large enough to be factorized with tile tasks
+// when cc->SPQR_nthreads > 1.  With more than one block and SPQR_grain > 1,
+// the fronts are factorized inside spqr_parallel.  If deficient is true, the
+// last column of each block is a copy of its first column.  R is computed
+// with one and four threads, and the two results are compared.
+
+template <typename Entry> int tile_test
+(
+    Long nblocks,
+    Long deficient,
+    cholmod_common *cc
+)
+{
+    cholmod_sparse *A, *R1, *R4, *D ;
+    Long *E1, *E4, *Ap, *Ai, bm = 1010, bn = 1000, m, n, b, i, j, k, p,
+        rank1, rank4 ;
+    Entry *Ax ;
+    int nfail = 0, save_nthreads = cc->SPQR_nthreads ;
+    double save_grain = cc->SPQR_grain ;
+
+    // create the matrix
+    m = nblocks * bm ;
+    n = nblocks * bn ;
+    A = cholmod_l_allocate_sparse (m, n, n*bm, TRUE, TRUE, 0,
+        spqr_type <Entry> ( ), cc) ;
+    if (A == NULL) return (1) ;
+    Ap = (Long *) A->p ;
+    Ai = (Long *) A->i ;
+    Ax = (Entry *) A->x ;
+    my_srand (42) ;
+    p = 0 ;
+    for (b = 0 ; b < nblocks ; b++)
+    {
+        for (j = 0 ; j < bn ; j++)
+        {
+            Ap [b*bn + j] = p ;
+            for (i = 0 ; i < bm ; i++)
+            {
+                Ai [p] = b*bm + i ;
+                Ax [p] = (deficient && j == bn-1) ? Ax [Ap [b*bn] + i] :
+                    erand ((Entry) 1) ;
+                p++ ;
+            }
+        }
+    }
+    Ap [n] = p ;
+
+    // [R1,E1] = qr (A) with one thread, [R4,E4] = qr (A) with four threads
+    cc->SPQR_grain = (nblocks > 1) ? 4 : 1 ;
+    cc->SPQR_nthreads = 1 ;
+    rank1 = SuiteSparseQR <Entry> (SPQR_ORDERING_DEFAULT, SPQR_DEFAULT_TOL, m,
+        A, &R1, &E1, cc) ;
+    double flops1 = cc->SPQR_flopcount ;
+    cc->SPQR_nthreads = 4 ;
+    rank4 = SuiteSparseQR <Entry> (SPQR_ORDERING_DEFAULT, SPQR_DEFAULT_TOL, m,
+        A, &R4, &E4, cc) ;
+    double flops4 = cc->SPQR_flopcount ;
+    cc->SPQR_nthreads = save_nthreads ;
+    cc->SPQR_grain = save_grain ;
+
+    // the ranks, orderings, and R factors must be the same
+    double err = 1, rerr = 1 ;
+    if (R1 != NULL && R4 != NULL)
+    {
+        err = check_r_factor <Entry> (R4, A, E4, cc) ;
+        D = sparse_diff <Entry> (R1, R4, cc) ;
+        rerr = cholmod_l_norm_sparse (D, 1, cc) /
+            cholmod_l_norm_sparse (R1, 1, cc) ;
+        cholmod_l_free_sparse (&D, cc) ;
+    }
+    for (k = 0 ; k < n ; k++)
+    {
+        if ((E1 == NULL ? k : E1 [k]) != (E4 == NULL ? k : E4 [k]))
+        {
+            rerr = 1 ;
+        }
+    }
+    printf ("tile test: %ld blocks, rank %ld %ld (expected %ld),"
+        " err %8.1e %8.1e, flops %g %g", nblocks, rank1, rank4,
+        nblocks * (deficient ? bn-1 : bn), err, rerr, flops1, flops4) ;
+    if (rank1 != rank4 || rank1 != nblocks * (deficient ? bn-1 : bn)
+        || err > 1e-10 || rerr > 1e-10 || flops1 <= 0 || flops1 != flops4)
+    {
+        printf (" : FAIL\n") ;
+        fprintf (stderr, "tile test FAIL\n") ;
+        nfail++ ;
+    }
+    else
+    {
+        printf (" : OK.\n") ;
+    }
+
+    cholmod_l_free_sparse (&R1, cc) ;
+    cholmod_l_free_sparse (&R4, cc) ;
+    cholmod_l_free (n, sizeof (Long), E1, cc) ;
+    cholmod_l_free (n, sizeof (Long), E4, cc) ;
+    cholmod_l_free_sparse (&A, cc) ;
+    return (nfail) ;
+}
+
+
+// =============================================================================
+// === update_test =============================================================
+// =============================================================================
+
+// Return rows i1 to i2-1 of the m-by-n dense matrix X as a sparse matrix.
+
+template <typename Entry> cholmod_sparse *dense_rows
+(
+    Entry *Xx,
+    Long m,
+    Long n,
+    Long i1,
+    Long i2,
+    cholmod_common *cc
+)
+{
+    cholmod_sparse *S ;
+    cholmod_dense *Y = cholmod_l_zeros (i2-i1, n, spqr_type <Entry> ( ), cc) ;
+    Entry *Yx = (Entry *) Y->x ;
+    for (Long j = 0 ; j < n ; j++)
+    {
+        for (Long i = i1 ; i < i2 ; i++)
+        {
+            Yx [(i-i1) + j*(i2-i1)] = Xx [i + j*m] ;
+        }
+    }
+    S = cholmod_l_dense_to_sparse (Y, TRUE, cc) ;
+    cholmod_l_free_dense (&Y, cc) ;
+    return (S) ;
+}
+
+// Factorize the first m1 rows of a random sparse m-by-n matrix A with
+// SuiteSparseQR, append the remaining rows with SuiteSparseQR_rowupdate, and
+// compare the result with the factorization of all of A.  If deficient is
+// true, the last column of A is a copy of its first column, and the rank
+// tolerance must keep the update from increasing the rank of R.  If m1 < n,
+// the rank of R is at most m1 before the update, and the appended rows must
+// raise it.  If batch is zero, R and C are updated by a single call.
+// Otherwise, they are copied into a SuiteSparseQR_rowfactorization object,
+// the rows are appended to it batch rows at a time, and the object's
+// workspace must be clear after each call.
+
+template <typename Entry> int update_test
+(
+    Long deficient,
+    Long m1,
+    Long batch,
+    cholmod_common *cc
+)
+{
+    cholmod_sparse *A, *A1, *A2, *R, *R2 ;
+    cholmod_dense *X, *B1, *B2, *C, *X2 ;
+    Long *E, *E2, m = 80, n = 40, i, j, rank, rank1, rank2 ;
+    Entry *Xx, *B1x, *B2x ;
+    double err = 1, xerr = 1 ;
+    int nfail = 0, ok ;
+
+    // create A as a dense matrix, with a diagonal and 3 more entries per row
+    my_srand (7) ;
+    X = cholmod_l_zeros (m, n, spqr_type <Entry> ( ), cc) ;
+    Xx = (Entry *) X->x ;
+    for (i = 0 ; i < m ; i++)
+    {
+        Xx [i + (i % n) * m] = erand ((Entry) 1) ;
+        for (Long k = 0 ; k < 3 ; k++)
+        {
+            Xx [i + nrand (n) * m] = erand ((Entry) 1) ;
+        }
+        if (deficient)
+        {
+            Xx [i + (n-1) * m] = Xx [i] ;
+        }
+    }
+    A = cholmod_l_dense_to_sparse (X, TRUE, cc) ;
+
+    // A1 and A2 are the first m1 and the last m-m1 rows of A
+    A1 = dense_rows <Entry> (Xx, m, n, 0, m1, cc) ;
+    A2 = dense_rows <Entry> (Xx, m, n, m1, m, cc) ;
+
+    // B1 and B2 are the first m1 and the last m-m1 rows of a random B
+    B1 = cholmod_l_zeros (m1, 1, spqr_type <Entry> ( ), cc) ;
+    B2 = cholmod_l_zeros (m - m1, 1, spqr_type <Entry> ( ), cc) ;
+    B1x = (Entry *) B1->x ;
+    B2x = (Entry *) B2->x ;
+    for (i = 0 ; i < m ; i++)
+    {
+        if (i < m1) B1x [i] = erand ((Entry) 1) ;
+        else B2x [i-m1] = erand ((Entry) 1) ;
+    }
+
+    // [C,R,E] = qr (A1,B1), then [C,R] = qr ([R ; A2*E], [C ; B2])
+    SuiteSparseQR <Entry> (SPQR_ORDERING_DEFAULT, SPQR_DEFAULT_TOL, 0, A1, B1,
+        &C, &R, &E, cc) ;
+    rank1 = R->nrow ;
+    if (batch == 0)
+    {
+        ok = SuiteSparseQR_rowupdate <Entry> (SPQR_DEFAULT_TOL, A2, B2, E, &R,
+            &C, cc) ;
+    }
+    else
+    {
+        SuiteSparseQR_rowfactorization <Entry> *RF ;
+        RF = SuiteSparseQR_rowupdate_start <Entry> (SPQR_DEFAULT_TOL, R, C, E,
+            cc) ;
+        ok = (RF != NULL) ;
+        for (Long i1 = m1 ; ok && i1 < m ; i1 += batch)
+        {
+            Long i2 = MIN (i1 + batch, m) ;
+            cholmod_sparse *A3 = dense_rows <Entry> (Xx, m, n, i1, i2, cc) ;
+            cholmod_dense *B3 = cholmod_l_zeros (i2-i1, 1,
+                spqr_type <Entry> ( ), cc) ;
+            for (i = i1 ; i < i2 ; i++)
+            {
+                ((Entry *) B3->x) [i-i1] = B2x [i-m1] ;
+            }
+            ok = SuiteSparseQR_rowupdate <Entry> (A3, B3, RF, cc) ;
+            for (j = 0 ; ok && j < n ; j++)
+            {
+                // the workspace is clear between calls
+                ok = (RF->W [j] == (Entry) 0 && !RF->Mark [j]) ;
+            }
+            cholmod_l_free_sparse (&A3, cc) ;
+            cholmod_l_free_dense (&B3, cc) ;
+        }
+        cholmod_l_free_sparse (&R, cc) ;
+        cholmod_l_free_dense (&C, cc) ;
+        ok = ok && SuiteSparseQR_rowupdate_get <Entry> (RF, &R, &C, cc) ;
+        SuiteSparseQR_rowupdate_free <Entry> (&RF, cc) ;
+    }
+    rank = ok ? (Long) R->nrow : EMPTY ;
+
+    // refactorize all of A, to get the rank and the solution
+    rank2 = SuiteSparseQR <Entry> (SPQR_ORDERING_DEFAULT, SPQR_DEFAULT_TOL, 0,
+        A, &R2, &E2, cc) ;
+
+    if (ok)
+    {
+        err = check_r_factor <Entry> (R, A, E, cc) ;
+    }
+    if (ok && !deficient)
+    {
+        // x = E*(R\C) from the update, and x2 = A\[B1;B2] by refactorizing
+        cholmod_dense *B = cholmod_l_zeros (m, 1, spqr_type <Entry> ( ), cc) ;
+        Entry *Bx = (Entry *) B->x ;
+        for (i = 0 ; i < m ; i++)
+        {
+            Bx [i] = (i < m1) ? B1x [i] : B2x [i-m1] ;
+        }
+        X2 = SuiteSparseQR <Entry> (SPQR_ORDERING_DEFAULT, SPQR_DEFAULT_TOL,
+            A, B, cc) ;
+        Entry *Cx = (Entry *) C->x ;
+        Entry *X2x = (Entry *) X2->x ;
+        double xnorm = cholmod_l_norm_dense (X2, 0, cc) ;
+        if (Rsolve (n, R, Cx, 1, cc))
+        {
+            xerr = 0 ;
+            for (j = 0 ; j < n ; j++)
+            {
+                double d = spqr_abs (Cx [j] - X2x [E ? E [j] : j], cc) ;
+                xerr = MAX (xerr, d) ;
+            }
+            xerr /= (xnorm == 0 ? 1 : xnorm) ;
+        }
+        cholmod_l_free_dense (&X2, cc) ;
+        cholmod_l_free_dense (&B, cc) ;
+    }
+    else
+    {
+        xerr = 0 ;
+    }
+
+    printf ("update test: m1 %ld batch %ld, rank %ld (before: %ld,"
+        " refactorized: %ld), err %8.1e %8.1e", m1, batch, rank, rank1, rank2,
+        err, xerr) ;
+    if (!ok || rank != rank2 || rank != (deficient ? n-1 : n)
+        || (m1 < n && rank1 > m1) || err > 1e-10 || xerr > 1e-10)
+    {
+        printf (" : FAIL\n") ;
+        fprintf (stderr, "update test FAIL\n") ;
+        nfail++ ;
+    }
+    else
+    {
+        printf (" : OK.\n") ;
+    }
+
+    cholmod_l_free_sparse (&R, cc) ;
+    cholmod_l_free_sparse (&R2, cc) ;
+    cholmod_l_free_dense (&C, cc) ;
+    cholmod_l_free (n+1, sizeof (Long), E, cc) ;     // E has size n+nrhs
+    cholmod_l_free (n, sizeof (Long), E2, cc) ;
+    cholmod_l_free_dense (&B1, cc) ;
+    cholmod_l_free_dense (&B2, cc) ;
+    cholmod_l_free_sparse (&A1, cc) ;
+    cholmod_l_free_sparse (&A2, cc) ;
+    cholmod_l_free_sparse (&A, cc) ;
+    cholmod_l_free_dense (&X, cc) ;
+    return (nfail) ;
+}
+
+
+// =============================================================================
+// === regularize_test =========================================================
+// =============================================================================
+
+// Solve the regularized problem min norm(A*x-b)^2 + lambda^2*norm(x)^2 for an
+// underdetermined m-by-n A with SuiteSparseQR_factorize (lambda) and
+// SuiteSparseQR_numeric (for a second lambda), and compare with the
+// least-squares solution of [A ; lambda*I]*x = [b ; 0] with the augmented
+// matrix formed explicitly.  The default tol must be that of [A ; lambda*I].
+
+template <typename Entry> int regularize_test
+(
+    cholmod_common *cc
+)
+{
+    cholmod_sparse *A, *Aug ;
+    cholmod_dense *X, *B, *Y, *X1, *X2 ;
+    SuiteSparseQR_factorization <Entry> *QR ;
+    Long m = 30, n = 40, i, j, k, t ;
+    Entry *Xx, *Bx ;
+    double lambda [2] = {0.5, 2}, err, tolerr ;
+    int nfail = 0, ok ;
+
+    // create A, with a diagonal and 3 more entries per row
+    my_srand (11) ;
+    X = cholmod_l_zeros (m, n, spqr_type <Entry> ( ), cc) ;
+    Xx = (Entry *) X->x ;
+    for (i = 0 ; i < m ; i++)
+    {
+        Xx [i + i * m] = erand ((Entry) 1) ;
+        for (k = 0 ; k < 3 ; k++)
+        {
+            Xx [i + nrand (n) * m] = erand ((Entry) 1) ;
+        }
+    }
+    A = cholmod_l_dense_to_sparse (X, TRUE, cc) ;
+    cholmod_l_free_dense (&X, cc) ;
+
+    // B = [b ; 0]
+    B = cholmod_l_zeros (m+n, 1, spqr_type <Entry> ( ), cc) ;
+    Bx = (Entry *) B->x ;
+    for (i = 0 ; i < m ; i++)
+    {
+        Bx [i] = erand ((Entry) 1) ;
+    }
+
+    QR = NULL ;
+    for (t = 0 ; t < 2 ; t++)
+    {
+        // factorize [A ; lambda*I], or refactorize it with a new lambda
+        if (t == 0)
+        {
+            QR = SuiteSparseQR_factorize <Entry> (SPQR_ORDERING_DEFAULT,
+                SPQR_DEFAULT_TOL, lambda [t], A, cc) ;
+            ok = (QR != NULL) ;
+        }
+        else
+        {
+            ok = SuiteSparseQR_numeric <Entry> (SPQR_DEFAULT_TOL, lambda [t],
+                A, QR, cc) ;
+        }
+
+        // Aug = [A ; lambda*I], formed explicitly
+        X = cholmod_l_zeros (m+n, n, spqr_type <Entry> ( ), cc) ;
+        Xx = (Entry *) X->x ;
+        Long *Ap = (Long *) A->p ;
+        Long *Ai = (Long *) A->i ;
+        Entry *Ax = (Entry *) A->x ;
+        for (j = 0 ; j < n ; j++)
+        {
+            for (Long p = Ap [j] ; p < Ap [j+1] ; p++)
+            {
+                Xx [Ai [p] + j*(m+n)] = Ax [p] ;
+            }
+            Xx [m + j + j*(m+n)] = lambda [t] ;
+        }
+        Aug = cholmod_l_dense_to_sparse (X, TRUE, cc) ;
+        cholmod_l_free_dense (&X, cc) ;
+
+        // X1 = E*(R\(Q'*[b ; 0])) and X2 = Aug\[b ; 0]
+        err = 1 ;
+        tolerr = 1 ;
+        if (ok)
+        {
+            double tol = spqr_tol <Entry> (Aug, cc) ;
+            tolerr = fabs (QR->tol - tol) / tol ;
+            Y = SuiteSparseQR_qmult <Entry> (SPQR_QTX, QR, B, cc) ;
+            X1 = SuiteSparseQR_solve <Entry> (SPQR_RETX_EQUALS_B, QR, Y, cc) ;
+            X2 = SuiteSparseQR <Entry> (SPQR_ORDERING_DEFAULT,
+                SPQR_DEFAULT_TOL, Aug, B, cc) ;
+            if (X1 != NULL && X2 != NULL)
+            {
+                Entry *X1x = (Entry *) X1->x ;
+                Entry *X2x = (Entry *) X2->x ;
+                err = 0 ;
+                for (j = 0 ; j < n ; j++)
+                {
+                    err = MAX (err, spqr_abs (X1x [j] - X2x [j], cc)) ;
+                }
+                double xnorm = cholmod_l_norm_dense (X2, 0, cc) ;
+                err /= (xnorm == 0 ? 1 : xnorm) ;
+            }
+            cholmod_l_free_dense (&Y, cc) ;
+            cholmod_l_free_dense (&X1, cc) ;
+            cholmod_l_free_dense (&X2, cc) ;
+        }
+        cholmod_l_free_sparse (&Aug, cc) ;
+
+        printf ("regularize test: lambda %g rank %ld, err %8.1e tol %8.1e",
+            lambda [t], ok ? QR->rank : EMPTY, err, tolerr) ;
+        if (!ok || QR->rank != n || err > 1e-10 || tolerr > 1e-12)
+        {
+            printf (" : FAIL\n") ;
+            fprintf (stderr, "regularize test FAIL\n") ;
+            nfail++ ;
+        }
+        else
+        {
+            printf (" : OK.\n") ;
+        }
+    }
+    SuiteSparseQR_free (&QR, cc) ;
+
+    // lambda must be zero if A was analyzed without regularization
+    QR = SuiteSparseQR_symbolic <Entry> (SPQR_ORDERING_DEFAULT, TRUE, FALSE, A,
+        cc) ;
+    ok = SuiteSparseQR_numeric <Entry> (SPQR_DEFAULT_TOL, 1, A, QR, cc) ;
+    if (ok || cc->status != CHOLMOD_INVALID)
+    {
+        fprintf (stderr, "regularize test: lambda not rejected FAIL\n") ;
+        nfail++ ;
+    }
+    SuiteSparseQR_free (&QR, cc) ;
+    cc->status = CHOLMOD_OK ;
+
+    cholmod_l_free_dense (&B, cc) ;
+    cholmod_l_free_sparse (&A, cc) ;
+    return (nfail) ;
+}
+
+
+// =============================================================================
+// === batch_test ==============================================================
+// =============================================================================
+
+// Solve a batch of small least-squares problems with SuiteSparseQR_batch, with
+// and without a shared pattern and with 1 and 4 threads, and compare with
+// SuiteSparseQR.  Problems 0 to 9 share one pattern (4 and 7 are rank
+// deficient), and the rest have their own.  A batch with a B [k] of the wrong
+// size must be rejected.
+
+#define NBATCH 16
+
+template <typename Entry> int batch_test
+(
+    cholmod_common *cc
+)
+{
+    cholmod_sparse *A [NBATCH] ;
+    cholmod_dense *B [NBATCH], *X [NBATCH], *X2, *D ;
+    Long m, n, i, j, k, t ;
+    int nfail = 0, ok, save_nthreads = cc->SPQR_nthreads ;
+    double err, maxerr = 0 ;
+
+    my_srand (13) ;
+    for (k = 0 ; k < NBATCH ; k++)
+    {
+        // A [k] is m-by-n, with a diagonal and 2 more entries per row
+        Long seed = (k < 10) ? 0 : k ;
+        m = 20 + seed ;
+        n = 10 + seed / 2 ;
+        unsigned long save_seed = my_seed ( ) ;
+        my_srand (seed + 1) ;
+        D = cholmod_l_zeros (m, n, spqr_type <Entry> ( ), cc) ;
+        Entry *Dx = (Entry *) D->x ;
+        for (i = 0 ; i < m ; i++)
+        {
+            Dx [i + (i % n) * m] = 1 ;
+            Dx [i + nrand (n) * m] = 1 ;
+            Dx [i + nrand (n) * m] = 1 ;
+        }
+        // the values differ from one problem to the next
+        my_srand (save_seed) ;
+        for (j = 0 ; j < m*n ; j++)
+        {
+            if (Dx [j] != (Entry) 0) Dx [j] = erand ((Entry) 1) ;
+        }
+        A [k] = cholmod_l_dense_to_sparse (D, TRUE, cc) ;
+        cholmod_l_free_dense (&D, cc) ;
+        if (k == 4 || k == 7)
+        {
+            // a zero column, but with the same pattern: A [k] is rank
+            // deficient, and the problems after it are not
+            Long *Ap = (Long *) A [k]->p ;
+            Entry *Ax = (Entry *) A [k]->x ;
+            for (Long p = Ap [2] ; p < Ap [3] ; p++)
+            {
+                Ax [p] = 0 ;
+            }
+        }
+        // 1 to 5 right-hand sides
+        Long nrhs = 1 + k % 5 ;
+        B [k] = cholmod_l_zeros (m, nrhs, spqr_type <Entry> ( ), cc) ;
+        Entry *Bx = (Entry *) B [k]->x ;
+        for (i = 0 ; i < nrhs*m ; i++)
+        {
+            Bx [i] = erand ((Entry) 1) ;
+        }
+    }
+
+    for (t = 0 ; t < 4 ; t++)
+    {
+        // X = A\B for each problem
+        int same_pattern = t % 2 ;
+        cc->SPQR_nthreads = (t < 2) ? 1 : 4 ;
+        ok = SuiteSparseQR_batch <Entry> (SPQR_ORDERING_DEFAULT,
+            SPQR_DEFAULT_TOL, same_pattern, NBATCH, A, B, X, cc) ;
+        cc->SPQR_nthreads = save_nthreads ;
+        if (!ok)
+        {
+            printf ("batch test: SuiteSparseQR_batch failed\n") ;
+            nfail++ ;
+            continue ;
+        }
+
+        // compare with X2 = A\B from SuiteSparseQR
+        for (k = 0 ; k < NBATCH ; k++)
+        {
+            X2 = SuiteSparseQR <Entry> (SPQR_ORDERING_DEFAULT,
+                SPQR_DEFAULT_TOL, A [k], B [k], cc) ;
+            Entry *Xx = (Entry *) X [k]->x ;
+            Entry *X2x = (Entry *) X2->x ;
+            err = 0 ;
+            for (j = 0 ; j < (Long) (X2->nrow * X2->ncol) ; j++)
+            {
+                err = MAX (err, spqr_abs (Xx [j] - X2x [j], cc)) ;
+            }
+            double xnorm = cholmod_l_norm_dense (X2, 0, cc) ;
+            err /= (xnorm == 0 ? 1 : xnorm) ;
+            maxerr = MAX (maxerr, err) ;
+            cholmod_l_free_dense (&X2, cc) ;
+            cholmod_l_free_dense (&X [k], cc) ;
+        }
+    }
+    printf ("batch test: err %8.1e", maxerr) ;
+    if (maxerr > 1e-10)
+    {
+        printf (" : FAIL\n") ;
+        fprintf (stderr, "batch test FAIL\n") ;
+        nfail++ ;
+    }
+    else
+    {
+        printf (" : OK.\n") ;
+    }
+
+    // B [3] with the wrong number of rows is rejected before any is solved
+    for (k = 0 ; k < NBATCH ; k++)
+    {
+        X [k] = NULL ;
+    }
+    B [3]->nrow-- ;
+    ok = SuiteSparseQR_batch <Entry> (SPQR_ORDERING_DEFAULT, SPQR_DEFAULT_TOL,
+        FALSE, NBATCH, A, B, X, cc) ;
+    B [3]->nrow++ ;
+    for (k = 0 ; k < NBATCH ; k++)
+    {
+        if (X [k] != NULL) ok = TRUE ;
+    }
+    if (ok || cc->status != CHOLMOD_INVALID)
+    {
+        fprintf (stderr, "batch test: mismatched B not rejected FAIL\n") ;
+        nfail++ ;
+    }
+    cc->status = CHOLMOD_OK ;
+
+    for (k = 0 ; k < NBATCH ; k++)
+    {
+        cholmod_l_free_sparse (&A [k], cc) ;
+        cholmod_l_free_dense (&B [k], cc) ;
+    }
+    return (nfail) ;
+}
+
+
+// =============================================================================
+// === mesh_matrix =============================================================
+// =============================================================================
+
+// Return a random (k*k+extra)-by-(k*k) sparse matrix with the pattern of the
+// 5-point stencil on a k-by-k mesh, followed by extra rows with 3 entries
+// each.  Its fronts are small enough that the task tree of spqr_analyze has
+// many tasks if cc->SPQR_grain > 1 and cc->SPQR_small is small.
+
+template <typename Entry> cholmod_sparse *mesh_matrix
+(
+    Long k,
+    Long extra,
+    Long seed,
+    cholmod_common *cc
+)
+{
+    Long n = k*k, m = n + extra, i, j, t, nz = 0 ;
+    cholmod_triplet *T = cholmod_l_allocate_triplet (m, n, 5*n + 3*extra, 0,
+        spqr_type <Entry> ( ), cc) ;
+    if (T == NULL) return (NULL) ;
+    Long *Ti = (Long *) T->i ;
+    Long *Tj = (Long *) T->j ;
+    Entry *Tx = (Entry *) T->x ;
+    my_srand (seed) ;
+    for (j = 0 ; j < n ; j++)
+    {
+        Long nbr [5] = { j, j-1, j+1, j-k, j+k } ;
+        for (t = 0 ; t < 5 ; t++)
+        {
+            i = nbr [t] ;
+            if (i < 0 || i >= n) continue ;
+            if ((t == 1 && j % k == 0) || (t == 2 && i % k == 0)) continue ;
+            Ti [nz] = i ;
+            Tj [nz] = j ;
+            Tx [nz] = (t == 0) ? erand ((Entry) 1) + (Entry) 4 :
+                erand ((Entry) 1) ;
+            nz++ ;
+        }
+    }
+    for (i = n ; i < m ; i++)
+    {
+        for (t = 0 ; t < 3 ; t++)
+        {
+            Ti [nz] = i ;
+            Tj [nz] = nrand (n) ;
+            Tx [nz] = erand ((Entry) 1) ;
+            nz++ ;
+        }
+    }
+    T->nnz = nz ;
+    cholmod_sparse *A = cholmod_l_triplet_to_sparse (T, nz, cc) ;
+    cholmod_l_free_triplet (&T, cc) ;
+    return (A) ;
+}
+
+
+// =============================================================================
+// === rsolve_test =============================================================
+// =============================================================================
+
+// Factorize a mesh matrix with a task tree, and solve R\B, E*(R\B), R'\B and
+// R'\(E'*B) with one and four threads, for one and for five right-hand sides.
+// With four threads the fronts are solved in parallel by the tasks; with one
+// thread they are solved one at a time (five right-hand sides) or column by
+// column (one right-hand side).  The results must agree.  The flop counts of
+// the blocked solves must be the same for any number of threads.
+
+template <typename Entry> int rsolve_test
+(
+    cholmod_common *cc
+)
+{
+    cholmod_sparse *A ;
+    cholmod_dense *B, *X1, *X4 ;
+    SuiteSparseQR_factorization <Entry> *QR ;
+    Long k = 40, n = k*k, nrhs, i, system ;
+    int nfail = 0, save_nthreads = cc->SPQR_nthreads ;
+    double save_grain = cc->SPQR_grain, save_small = cc->SPQR_small,
+        maxerr = 0, flops [2] ;
+
+    A = mesh_matrix <Entry> (k, 0, 17, cc) ;
+    cc->SPQR_grain = 16 ;
+    cc->SPQR_small = 1000 ;
+    cc->SPQR_nthreads = 4 ;
+    QR = SuiteSparseQR_factorize <Entry> (SPQR_ORDERING_DEFAULT,
+        SPQR_DEFAULT_TOL, A, cc) ;
+    cc->SPQR_grain = 1 ;        // so that the solves count their flops
+    if (QR == NULL || QR->QRsym->ntasks <= 1 || QR->rank != n)
+    {
+        printf ("rsolve test: no task tree : FAIL\n") ;
+        fprintf (stderr, "rsolve test FAIL\n") ;
+        nfail++ ;
+    }
+
+    for (nrhs = 1 ; nfail == 0 && nrhs <= 5 ; nrhs += 4)
+    {
+        B = cholmod_l_zeros (n, nrhs, spqr_type <Entry> ( ), cc) ;
+        Entry *Bx = (Entry *) B->x ;
+        for (i = 0 ; i < n*nrhs ; i++)
+        {
+            Bx [i] = erand ((Entry) 1) ;
+        }
+        for (system = SPQR_RX_EQUALS_B ; system <= SPQR_RTX_EQUALS_ETB ;
+            system++)
+        {
+            // X1 = R\B with one thread, X4 = R\B with four threads, etc
+            cc->SPQR_nthreads = 1 ;
+            cc->SPQR_flopcount = 0 ;
+            X1 = SuiteSparseQR_solve <Entry> (system, QR, B, cc) ;
+            flops [0] = cc->SPQR_flopcount ;
+            cc->SPQR_nthreads = 4 ;
+            cc->SPQR_flopcount = 0 ;
+            X4 = SuiteSparseQR_solve <Entry> (system, QR, B, cc) ;
+            flops [1] = cc->SPQR_flopcount ;
+            double err = 1 ;
+            if (X1 != NULL && X4 != NULL)
+            {
+                Entry *X1x = (Entry *) X1->x ;
+                Entry *X4x = (Entry *) X4->x ;
+                err = 0 ;
+                for (i = 0 ; i < n*nrhs ; i++)
+                {
+                    err = MAX (err, spqr_abs (X1x [i] - X4x [i], cc)) ;
+                }
+                double xnorm = cholmod_l_norm_dense (X1, 0, cc) ;
+                err /= (xnorm == 0 ? 1 : xnorm) ;
+            }
+            maxerr = MAX (maxerr, err) ;
+            if (err > 1e-12 || (nrhs > 1 && flops [0] != flops [1]))
+            {
+                printf ("rsolve test: system %ld nrhs %ld err %8.1e"
+                    " flops %g %g : FAIL\n", system, nrhs, err, flops [0],
+                    flops [1]) ;
+                fprintf (stderr, "rsolve test FAIL\n") ;
+                nfail++ ;
+            }
+            cholmod_l_free_dense (&X1, cc) ;
+            cholmod_l_free_dense (&X4, cc) ;
+        }
+        cholmod_l_free_dense (&B, cc) ;
+    }
+    printf ("rsolve test: %ld tasks, err %8.1e : %s\n",
+        QR ? QR->QRsym->ntasks : EMPTY, maxerr, nfail ? "FAIL" : "OK.") ;
+
+    cc->SPQR_nthreads = save_nthreads ;
+    cc->SPQR_grain = save_grain ;
+    cc->SPQR_small = save_small ;
+    SuiteSparseQR_free (&QR, cc) ;
+    cholmod_l_free_sparse (&A, cc) ;
+    return (nfail) ;
+}
+
+
+// =============================================================================
+// === flops_test ==============================================================
+// =============================================================================
+
+// Factorize a mesh matrix sequentially (cc->SPQR_grain = 1) and then with a
+// task tree, with one, two and four threads.  The flop count of the
+// factorization is kept for each stack and summed at the end, so it must be
+// the same in all four cases.  If deficient is true, two columns of A are
+// zero, and are dropped by rank detection.
+
+template <typename Entry> int flops_test
+(
+    Long deficient,
+    cholmod_common *cc
+)
+{
+    cholmod_sparse *A ;
+    SuiteSparseQR_factorization <Entry> *QR ;
+    Long k = 40, t, ntasks = 0, rank [4] ;
+    int nfail = 0, save_nthreads = cc->SPQR_nthreads ;
+    double save_grain = cc->SPQR_grain, save_small = cc->SPQR_small,
+        flops [4] ;
+    int nthreads [4] = { 1, 1, 2, 4 } ;
+
+    A = mesh_matrix <Entry> (k, 100, 23, cc) ;
+    if (deficient)
+    {
+        // zero the values of columns 7 and 500, but not their pattern
+        Long *Ap = (Long *) A->p ;
+        Entry *Ax = (Entry *) A->x ;
+        for (Long p = Ap [7] ; p < Ap [8] ; p++) Ax [p] = 0 ;
+        for (Long p = Ap [500] ; p < Ap [501] ; p++) Ax [p] = 0 ;
+    }
+    cc->SPQR_small = 1000 ;
+    for (t = 0 ; t < 4 ; t++)
+    {
+        cc->SPQR_grain = (t == 0) ? 1 : 16 ;
+        cc->SPQR_nthreads = nthreads [t] ;
+        QR = SuiteSparseQR_factorize <Entry> (SPQR_ORDERING_DEFAULT,
+            SPQR_DEFAULT_TOL, A, cc) ;
+        flops [t] = cc->SPQR_flopcount ;
+        rank [t] = (QR == NULL) ? EMPTY : QR->rank ;
+        if (t > 0 && QR != NULL) ntasks = QR->QRsym->ntasks ;
+        SuiteSparseQR_free (&QR, cc) ;
+    }
+    printf ("flops test: deficient %ld, %ld tasks, rank %ld, flops %g %g %g"
+        " %g", deficient, ntasks, rank [0], flops [0], flops [1], flops [2],
+        flops [3]) ;
+    if (ntasks <= 1 || flops [0] <= 0
+        || rank [0] != (Long) A->ncol - (deficient ? 2 : 0))
+    {
+        nfail++ ;
+    }
+    for (t = 1 ; t < 4 ; t++)
+    {
+        if (flops [t] != flops [0] || rank [t] != rank [0]) nfail++ ;
+    }
+    if (nfail > 0)
+    {
+        printf (" : FAIL\n") ;
+        fprintf (stderr, "flops test FAIL\n") ;
+    }
+    else
+    {
+        printf (" : OK.\n") ;
+    }
+
+    cc->SPQR_nthreads = save_nthreads ;
+    cc->SPQR_grain = save_grain ;
+    cc->SPQR_small = save_small ;
+    cholmod_l_free_sparse (&A, cc) ;
+    return (nfail) ;
+}
+
+
+// =============================================================================
+// === stranspose_test =========================================================
+// =============================================================================
+
+// Construct S = A(P,Qfill)' with spqr_stranspose1 sequentially, and with two,
+// three, and four threads, with and without a column permutation and with and
+// without regularization.  A has about 100,000 entries, and every 20th row of
+// A is empty, so with more than one thread S is constructed in parallel by
+// spqr_private_pstranspose1.  The results must be identical.
+
+int stranspose_test
+(
+    cholmod_common *cc
+)
+{
+    cholmod_sparse *A0, *A ;
+    Long k = 130, m, n, ms, nz, i, p, t, *Qfill, *Ap, *Ai,
+        *Sp [2], *Sj [2], *PLinv [2], *Sleft [2], *W ;
+    int nfail = 0, save_nthreads = cc->SPQR_nthreads ;
+
+    // A is the pattern of a mesh matrix, with an empty row after every 19th
+    A0 = mesh_matrix <double> (k, 4000, 29, cc) ;
+    if (A0 == NULL) return (1) ;
+    n = A0->ncol ;
+    nz = cholmod_l_nnz (A0, cc) ;
+    m = A0->nrow + A0->nrow / 19 + 1 ;
+    A = cholmod_l_allocate_sparse (m, n, nz, TRUE, TRUE, 0, CHOLMOD_PATTERN,
+        cc) ;
+    Ap = (Long *) A->p ;
+    Ai = (Long *) A->i ;
+    for (Long j = 0 ; j <= n ; j++) Ap [j] = ((Long *) A0->p) [j] ;
+    for (p = 0 ; p < nz ; p++)
+    {
+        i = ((Long *) A0->i) [p] ;
+        Ai [p] = i + i / 19 ;
+    }
+    cholmod_l_free_sparse (&A0, cc) ;
+
+    // Qfill is a random permutation
+    Qfill = (Long *) cholmod_l_malloc (n, sizeof (Long), cc) ;
+    for (Long j = 0 ; j < n ; j++) Qfill [j] = j ;
+    my_srand (31) ;
+    for (Long j = n-1 ; j > 0 ; j--)
+    {
+        Long j2 = nrand (j+1), tmp = Qfill [j] ;
+        Qfill [j] = Qfill [j2] ;
+        Qfill [j2] = tmp ;
+    }
+
+    for (t = 0 ; t < 2 ; t++)
+    {
+        Sp [t] = (Long *) cholmod_l_malloc (m+n+1, sizeof (Long), cc) ;
+        Sj [t] = (Long *) cholmod_l_malloc (nz+n, sizeof (Long), cc) ;
+        PLinv [t] = (Long *) cholmod_l_malloc (m+n, sizeof (Long), cc) ;
+        Sleft [t] = (Long *) cholmod_l_malloc (n+2, sizeof (Long), cc) ;
+    }
+    W = (Long *) cholmod_l_malloc (m+n, sizeof (Long), cc) ;
+    if (cc->status < CHOLMOD_OK)
+    {
+        nfail++ ;
+    }
+
+    for (Long trial = 0 ; nfail == 0 && trial < 4 ; trial++)
+    {
+        int regularize = (trial % 2 == 1) ;
+        Long *Q = (trial >= 2) ? Qfill : NULL ;
+        ms = regularize ? (m+n) : m ;
+        for (int nthreads = 1 ; nthreads <= 4 ; nthreads++)
+        {
+            t = (nthreads == 1) ? 0 : 1 ;
+            cc->SPQR_nthreads = nthreads ;
+            cc->memory_usage = cc->memory_inuse ;
+            spqr_stranspose1 (A, Q, regularize, Sp [t], Sj [t], PLinv [t],
+                Sleft [t], W, cc) ;
+            // the parallel construction allocates nthreads*n workspace
+            Long work = (Long) (cc->memory_usage - cc->memory_inuse) ;
+            int ok = (Sp [t][ms] == nz + (regularize ? n : 0)
+                && Sleft [t][n] < ms) ;
+            for (i = 0 ; ok && i <= ms ; i++)
+            {
+                ok = (Sp [t][i] == Sp [0][i]) ;
+            }
+            for (i = 0 ; ok && i < ms ; i++)
+            {
+                ok = (PLinv [t][i] == PLinv [0][i]) ;
+            }
+            for (p = 0 ; ok && p < Sp [0][ms] ; p++)
+            {
+                ok = (Sj [t][p] == Sj [0][p]) ;
+            }
+            for (i = 0 ; ok && i < n+2 ; i++)
+            {
+                ok = (Sleft [t][i] == Sleft [0][i]) ;
+            }
+#ifdef _OPENMP
+            if (nthreads > 1 && work < nthreads * n * ((Long) sizeof (Long)))
+            {
+                ok = FALSE ;
+            }
+#endif
+            printf ("stranspose test: regularize %d, Qfill %d, nthreads %d,"
+                " nz %ld, work %ld", regularize, Q != NULL, nthreads,
+                Sp [t][ms], work) ;
+            if (!ok)
+            {
+                nfail++ ;
+                printf (" : FAIL\n") ;
+                fprintf (stderr, "stranspose test FAIL\n") ;
+            }
+            else
+            {
+                printf (" : OK.\n") ;
+            }
+        }
+    }
+
+    cc->SPQR_nthreads = save_nthreads ;
+    for (t = 0 ; t < 2 ; t++)
+    {
+        cholmod_l_free (m+n+1, sizeof (Long), Sp [t], cc) ;
+        cholmod_l_free (nz+n, sizeof (Long), Sj [t], cc) ;
+        cholmod_l_free (m+n, sizeof (Long), PLinv [t], cc) ;
+        cholmod_l_free (n+2, sizeof (Long), Sleft [t], cc) ;
+    }
+    cholmod_l_free (m+n, sizeof (Long), W, cc) ;
+    cholmod_l_free (n, sizeof (Long), Qfill, cc) ;
+    cholmod_l_free_sparse (&A, cc) ;
+    return (nfail) ;
+}
+
+
+// =============================================================================
+// === qmult_test ==============================================================
+// =============================================================================
+
+// Factorize a mesh matrix with a task tree, and compute Q'*X, Q*X, X*Q' and
+// X*Q with SuiteSparseQR_qmult, with one and with four threads, for one and
+// for seven columns (or rows) of X.  With four threads the Householder
+// vectors of independent subtrees are applied in parallel.  The results must
+// agree, and Q*(Q'*X) with four threads must be X.
+
+template <typename Entry> int qmult_test
+(
+    cholmod_common *cc
+)
+{
+    cholmod_sparse *A ;
+    cholmod_dense *X, *Y1, *Y4, *Z ;
+    SuiteSparseQR_factorization <Entry> *QR ;
+    Long k = 40, m, nrhs, i, method ;
+    int nfail = 0, save_nthreads = cc->SPQR_nthreads ;
+    double save_grain = cc->SPQR_grain, save_small = cc->SPQR_small,
+        maxerr = 0, err ;
+
+    A = mesh_matrix <Entry> (k, 100, 19, cc) ;
+    m = A->nrow ;
+    cc->SPQR_grain = 16 ;
+    cc->SPQR_small = 1000 ;
+    cc->SPQR_nthreads = 4 ;
+    QR = SuiteSparseQR_factorize <Entry> (SPQR_ORDERING_DEFAULT,
+        SPQR_DEFAULT_TOL, A, cc) ;
+    if (QR == NULL || QR->QRsym->ntasks <= 1)
+    {
+        printf ("qmult test: no task tree : FAIL\n") ;
+        fprintf (stderr, "qmult test FAIL\n") ;
+        nfail++ ;
+    }
+
+    for (nrhs = 1 ; nfail == 0 && nrhs <= 7 ; nrhs += 6)
+    {
+        for (method = SPQR_QTX ; method <= SPQR_XQ ; method++)
+        {
+            // X is m-by-nrhs for Q'*X and Q*X, nrhs-by-m for X*Q' and X*Q
+            Long xrow = (method <= SPQR_QX) ? m : nrhs ;
+            Long xcol = (method <= SPQR_QX) ? nrhs : m ;
+            X = cholmod_l_zeros (xrow, xcol, spqr_type <Entry> ( ), cc) ;
+            Entry *Xx = (Entry *) X->x ;
+            for (i = 0 ; i < m*nrhs ; i++)
+            {
+                Xx [i] = erand ((Entry) 1) ;
+            }
+
+            // Y1 = Q'*X with one thread, Y4 = Q'*X with four threads, etc
+            cc->SPQR_nthreads = 1 ;
+            Y1 = SuiteSparseQR_qmult <Entry> (method, QR, X, cc) ;
+            cc->SPQR_nthreads = 4 ;
+            Y4 = SuiteSparseQR_qmult <Entry> (method, QR, X, cc) ;
+            err = 1 ;
+            if (Y1 != NULL && Y4 != NULL)
+            {
+                Entry *Y1x = (Entry *) Y1->x ;
+                Entry *Y4x = (Entry *) Y4->x ;
+                err = 0 ;
+                for (i = 0 ; i < m*nrhs ; i++)
+                {
+                    err = MAX (err, spqr_abs (Y1x [i] - Y4x [i], cc)) ;
+                }
+                double ynorm = cholmod_l_norm_dense (Y1, 0, cc) ;
+                err /= (ynorm == 0 ? 1 : ynorm) ;
+            }
+
+            // Z = Q*(Q'*X) or (X*Q')*Q with four threads, which must be X
+            if (method == SPQR_QTX || method == SPQR_XQT)
+            {
+                Z = SuiteSparseQR_qmult <Entry> (
+                    (method == SPQR_QTX) ? SPQR_QX : SPQR_XQ, QR, Y4, cc) ;
+                double zerr = 1 ;
+                if (Z != NULL)
+                {
+                    Entry *Zx = (Entry *) Z->x ;
+                    zerr = 0 ;
+                    for (i = 0 ; i < m*nrhs ; i++)
+                    {
+                        zerr = MAX (zerr, spqr_abs (Zx [i] - Xx [i], cc)) ;
+                    }
+                    double xnorm = cholmod_l_norm_dense (X, 0, cc) ;
+                    zerr /= (xnorm == 0 ? 1 : xnorm) ;
+                }
+                err = MAX (err, zerr) ;
+                cholmod_l_free_dense (&Z, cc) ;
+            }
+
+            maxerr = MAX (maxerr, err) ;
+            if (err > 1e-12)
+            {
+                printf ("qmult test: method %ld nrhs %ld err %8.1e : FAIL\n",
+                    method, nrhs, err) ;
+                fprintf (stderr, "qmult test FAIL\n") ;
+                nfail++ ;
+            }
+            cholmod_l_free_dense (&X, cc) ;
+            cholmod_l_free_dense (&Y1, cc) ;
+            cholmod_l_free_dense (&Y4, cc) ;
+        }
+    }
+    printf ("qmult test: %ld tasks, err %8.1e : %s\n",
+        QR ? QR->QRsym->ntasks : EMPTY, maxerr, nfail ? "FAIL" : "OK.") ;
+
+    cc->SPQR_nthreads = save_nthreads ;
+    cc->SPQR_grain = save_grain ;
+    cc->SPQR_small = save_small ;
+    SuiteSparseQR_free (&QR, cc) ;
+    cholmod_l_free_sparse (&A, cc) ;
+    return (nfail) ;
+}
+
+
+// =============================================================================
+// === two_child_matrix ========================================================
+// =============================================================================
+
+// A matrix whose front tree (with the fixed ordering) is a root front with two
+// children.  The first child is an a-by-a dense block and the second is a
+// tall r-by-b dense block, and each of their rows has one entry in the last
+// column.  The root front is a p-by-p dense block in the last p columns.  The
+// second child has the largest transient stack usage, so it should be
+// factorized first.
+
+template <typename Entry> cholmod_sparse *two_child_matrix
+(
+    Long a,
+    Long b,
+    Long r,
+    Long p,
+    cholmod_common *cc
+)
+{
+    Long m = a + r + p, n = a + b + p, i, j, nz = 0 ;
+    cholmod_triplet *T = cholmod_l_allocate_triplet (m, n,
+        a*(a+1) + r*(b+1) + p*p, 0, spqr_type <Entry> ( ), cc) ;
+    if (T == NULL) return (NULL) ;
+    Long *Ti = (Long *) T->i ;
+    Long *Tj = (Long *) T->j ;
+    Entry *Tx = (Entry *) T->x ;
+    for (i = 0 ; i < m ; i++)
+    {
+        // the columns of row i, in [j1,j2), and the last column
+        Long j1 = (i < a) ? 0 : ((i < a+r) ? a : a+b) ;
+        Long j2 = (i < a) ? a : ((i < a+r) ? a+b : n) ;
+        for (j = j1 ; j < j2 ; j++)
+        {
+            Ti [nz] = i ;
+            Tj [nz] = j ;
+            Tx [nz] = erand ((Entry) 1) ;
+            nz++ ;
+        }
+        if (i < a+r)
+        {
+            Ti [nz] = i ;
+            Tj [nz] = n-1 ;
+            Tx [nz] = erand ((Entry) 1) ;
+            nz++ ;
+        }
+    }
+    T->nnz = nz ;
+    cholmod_sparse *A = cholmod_l_triplet_to_sparse (T, nz, cc) ;
+    cholmod_l_free_triplet (&T, cc) ;
+    return (A) ;
+}
+
+
+// =============================================================================
+// === memory_test =============================================================
+// =============================================================================
+
+// Solve X = A\B with the sequential factorization, with and without
+// cc->SPQR_memory, for two mesh matrices (with the default ordering) and for
+// the two_child_matrix (with the fixed ordering).  The solutions and the rank
+// must agree, and neither the bound on the stack size (cc->SPQR_istat [8])
+// nor the actual peak stack size (cc->SPQR_istat [9]) may increase with
+// cc->SPQR_memory.  For the two_child_matrix, both must decrease.
+
+template <typename Entry> int memory_test
+(
+    cholmod_common *cc
+)
+{
+    cholmod_sparse *A ;
+    cholmod_dense *B, *X [2] ;
+    Long n, i, t, rank [2], bound [2], peak [2] ;
+    int nfail = 0, save_memory = cc->SPQR_memory, ordering, trial ;
+    double save_grain = cc->SPQR_grain, maxerr = 0 ;
+
+    cc->SPQR_grain = 1 ;
+    for (trial = 0 ; trial <= 2 ; trial++)
+    {
+        if (trial < 2)
+        {
+            A = mesh_matrix <Entry> (25, 200 * trial, 3 + trial, cc) ;
+            ordering = SPQR_ORDERING_DEFAULT ;
+        }
+        else
+        {
+            A = two_child_matrix <Entry> (40, 10, 300, 30, cc) ;
+            ordering = SPQR_ORDERING_FIXED ;
+        }
+        n = A->ncol ;
+        B = cholmod_l_zeros (A->nrow, 2, spqr_type <Entry> ( ), cc) ;
+        Entry *Bx = (Entry *) B->x ;
+        for (i = 0 ; i < (Long) (2 * A->nrow) ; i++)
+        {
+            Bx [i] = erand ((Entry) 1) ;
+        }
+        for (t = 0 ; t <= 1 ; t++)
+        {
+            cc->SPQR_memory = t ;
+            X [t] = SuiteSparseQR <Entry> (ordering, SPQR_DEFAULT_TOL, A, B,
+                cc) ;
+            rank [t] = cc->SPQR_istat [4] ;
+            bound [t] = cc->SPQR_istat [8] ;
+            peak [t] = cc->SPQR_istat [9] ;
+        }
+        double err = 1 ;
+        if (X [0] != NULL && X [1] != NULL)
+        {
+            Entry *X0x = (Entry *) X [0]->x ;
+            Entry *X1x = (Entry *) X [1]->x ;
+            err = 0 ;
+            for (i = 0 ; i < 2*n ; i++)
+            {
+                err = MAX (err, spqr_abs (X0x [i] - X1x [i], cc)) ;
+            }
+            double xnorm = cholmod_l_norm_dense (X [0], 0, cc) ;
+            err /= (xnorm == 0 ? 1 : xnorm) ;
+        }
+        maxerr = MAX (maxerr, err) ;
+        printf ("memory test: stack bound %ld -> %ld, peak %ld -> %ld\n",
+            bound [0], bound [1], peak [0], peak [1]) ;
+        if (err > 1e-10 || rank [0] != rank [1] || bound [1] > bound [0]
+            || peak [1] > peak [0]
+            || (trial == 2 && (bound [1] == bound [0] || peak [1] == peak [0])))
+        {
+            printf ("memory test: err %8.1e rank %ld %ld : FAIL\n", err,
+                rank [0], rank [1]) ;
+            fprintf (stderr, "memory test FAIL\n") ;
+            nfail++ ;
+        }
+        cholmod_l_free_dense (&X [0], cc) ;
+        cholmod_l_free_dense (&X [1], cc) ;
+        cholmod_l_free_dense (&B, cc) ;
+        cholmod_l_free_sparse (&A, cc) ;
+    }
+    printf ("memory test: err %8.1e : %s\n", maxerr, nfail ? "FAIL" : "OK.") ;
+
+    cc->SPQR_memory = save_memory ;
+    cc->SPQR_grain = save_grain ;
+    return (nfail) ;
+}
+
+
 // =============================================================================
 // === qrtest main =============================================================
 // =============================================================================
@@ -2827,6 +4038,79 @@ int main (int argc, char **argv)
             fclose (matrix) ;
         }
         fclose (file) ;
+
+        // ---------------------------------------------------------------------
+        // test the tiled factorization of large fronts
+        // ---------------------------------------------------------------------
+
+        nfail += tile_test <double>  (1, FALSE, cc) ;
+        nfail += tile_test <double>  (1, TRUE,  cc) ;
+        nfail += tile_test <double>  (2, FALSE, cc) ;
+        nfail += tile_test <Complex> (1, TRUE,  cc) ;
+
+        // ---------------------------------------------------------------------
+        // test SuiteSparseQR_rowupdate against refactorization
+        // ---------------------------------------------------------------------
+
+        nfail += update_test <double>  (FALSE, 50, 0, cc) ;
+        nfail += update_test <double>  (TRUE,  50, 0, cc) ;
+        nfail += update_test <Complex> (FALSE, 50, 0, cc) ;
+        nfail += update_test <Complex> (TRUE,  50, 0, cc) ;
+        nfail += update_test <double>  (FALSE, 50, 7, cc) ;
+        nfail += update_test <double>  (FALSE, 25, 0, cc) ;
+        nfail += update_test <double>  (FALSE, 25, 1, cc) ;
+        nfail += update_test <double>  (TRUE,  25, 3, cc) ;
+        nfail += update_test <Complex> (FALSE, 25, 4, cc) ;
+        nfail += update_test <Complex> (TRUE,  25, 1, cc) ;
+
+        // ---------------------------------------------------------------------
+        // test the regularized factorization of [A ; lambda*I]
+        // ---------------------------------------------------------------------
+
+        nfail += regularize_test <double>  (cc) ;
+        nfail += regularize_test <Complex> (cc) ;
+
+        // ---------------------------------------------------------------------
+        // test the batch solver
+        // ---------------------------------------------------------------------
+
+        nfail += batch_test <double>  (cc) ;
+        nfail += batch_test <Complex> (cc) ;
+
+        // ---------------------------------------------------------------------
+        // test the parallel solve with the fronts of R
+        // ---------------------------------------------------------------------
+
+        nfail += rsolve_test <double>  (cc) ;
+        nfail += rsolve_test <Complex> (cc) ;
+
+        // ---------------------------------------------------------------------
+        // test the parallel application of Q
+        // ---------------------------------------------------------------------
+
+        nfail += qmult_test <double>  (cc) ;
+        nfail += qmult_test <Complex> (cc) ;
+
+        // ---------------------------------------------------------------------
+        // test the flop count of the factorization, with and without tasks
+        // ---------------------------------------------------------------------
+
+        nfail += flops_test <double>  (FALSE, cc) ;
+        nfail += flops_test <double>  (TRUE,  cc) ;
+        nfail += flops_test <Complex> (TRUE,  cc) ;
+
+        // ---------------------------------------------------------------------
+        // test the parallel construction of S = A(P,Q)'
+        // ---------------------------------------------------------------------
+
+        nfail += stranspose_test (cc) ;
+
+        // ---------------------------------------------------------------------
+        // test the ordering of the fronts to reduce the stack (SPQR_memory)
+        // ---------------------------------------------------------------------
+
+        nfail += memory_test <double>  (cc) ;
+        nfail += memory_test <Complex> (cc) ;
     }
 
     // -------------------------------------------------------------------------
@@ -0,0 +1,635 @@
+/* ========================================================================== */
+/* === SuiteSparse_bin ====================================================== */
+/* ========================================================================== */
+
+/* Write and load a sparse matrix in the SuiteSparse binary container.  See
+ * SuiteSparse_bin.h for a description.
+ *
+ * The file consists of a 128-byte header followed by up to five arrays, each
+ * starting at a multiple of 64 bytes from the start of the file: the pointers,
+ * the indices, the values (x), the imaginary values (z), and the block
+ * checksums.  The header holds the offset of each array (zero if absent).
+ * Each array is checksummed separately, in blocks of SSB_BLOCK bytes, so the
+ * checksums of a large matrix are computed and checked in parallel.
+ *
+ * Copyright (c) 2026, the SuiteSparse contributors.  No licensing
+ * restrictions apply to this file or to the SuiteSparse_config directory.
+ */
+
+#include "SuiteSparse_bin.h"
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdint.h>
+
+/* mmap is used if available; compile with -DNMMAP to read the file instead */
+#if !defined (NMMAP) && (defined (__unix__) || defined (__APPLE__))
+#define SSB_MMAP
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
+
+#define SSB_MAGIC "SSBIN\r\n\032"   /* 8 bytes, \r\n detects text-mode I/O */
+#define SSB_VERSION 1
+#define SSB_ENDIAN 0x01020304
+#define SSB_HEADER 128              /* size of the header, in bytes */
+#define SSB_ALIGN 64                /* alignment of each array, in bytes */
+#define SSB_BLOCK (1 << 20)         /* checksum block size, in bytes */
+#define SSB_NARRAYS 4               /* p, i, x, and z */
+
+#define SSB_ROUNDUP(s) ((((s) + SSB_ALIGN - 1) / SSB_ALIGN) * SSB_ALIGN)
+#define SSB_NBLOCKS(s) (((s) + SSB_BLOCK - 1) / SSB_BLOCK)
+#define SSB_INDEX(a,isize,k) (((isize) == 4) ? \
+    ((int64_t) ((const int32_t *) (a)) [k]) : ((const int64_t *) (a)) [k])
+
+/* an empty array of a loaded matrix (i, x, or z when nnz is zero), which has
+   no space in the file */
+static union { double x [2] ; int64_t i [2] ; } ssb_empty ;
+
+/* the header, as held in the first SSB_HEADER bytes of the file */
+typedef struct
+{
+    char magic [8] ;            /* SSB_MAGIC */
+    uint32_t version ;          /* SSB_VERSION */
+    uint32_t endian ;           /* SSB_ENDIAN, in the writer's byte order */
+    int64_t nrow ;
+    int64_t ncol ;
+    int64_t nnz ;
+    int32_t orient ;
+    int32_t isize ;
+    int32_t xtype ;
+    int32_t stype ;
+    int32_t sorted ;
+    int32_t checksum ;
+    uint64_t offset [SSB_NARRAYS+1] ;   /* p, i, x, z, and checksums */
+    uint64_t size ;             /* size of the file, in bytes */
+    uint64_t hsum ;             /* checksum of the header, with hsum = 0 */
+} ssb_header ;
+
+
+/* -------------------------------------------------------------------------- */
+/* ssb_sum: checksum of a block of bytes */
+/* -------------------------------------------------------------------------- */
+
+/* A Fletcher-style sum of 64-bit words, which runs at memory bandwidth. */
+
+static uint64_t ssb_sum (const unsigned char *s, size_t len)
+{
+    uint64_t a = 1, b = 0, w ;
+    size_t k ;
+    for (k = 0 ; k + 8 <= len ; k += 8)
+    {
+        memcpy (&w, s + k, 8) ;
+        a += w ;
+        b += a ;
+    }
+    if (k < len)
+    {
+        w = 0 ;
+        memcpy (&w, s + k, len - k) ;
+        a += w ;
+        b += a ;
+    }
+    return (a ^ (b << 32) ^ (b >> 32)) ;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* ssb_sizes: size of each array, in bytes */
+/* -------------------------------------------------------------------------- */
+
+static void ssb_sizes (const ssb_header *h, uint64_t len [SSB_NARRAYS])
+{
+    uint64_t nvec = (uint64_t) ((h->orient == SUITESPARSE_BIN_CSC) ?
+        h->ncol : h->nrow) ;
+    len [0] = (nvec + 1) * h->isize ;
+    len [1] = (uint64_t) h->nnz * h->isize ;
+    len [2] = (h->xtype == SUITESPARSE_BIN_PATTERN) ? 0 :
+        (uint64_t) h->nnz * sizeof (double) *
+        ((h->xtype == SUITESPARSE_BIN_COMPLEX) ? 2 : 1) ;
+    len [3] = (h->xtype == SUITESPARSE_BIN_ZOMPLEX) ?
+        (uint64_t) h->nnz * sizeof (double) : 0 ;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* ssb_checksums: compute the checksums of each block of each array */
+/* -------------------------------------------------------------------------- */
+
+/* sums has size SSB_NBLOCKS (len [0]) + ... + SSB_NBLOCKS (len [3]) */
+
+static void ssb_checksums
+(
+    const void *X [SSB_NARRAYS],
+    const uint64_t len [SSB_NARRAYS],
+    uint64_t *sums
+)
+{
+    int64_t b, nblocks, start [SSB_NARRAYS+1] ;
+    int k ;
+
+    start [0] = 0 ;
+    for (k = 0 ; k < SSB_NARRAYS ; k++)
+    {
+        start [k+1] = start [k] + SSB_NBLOCKS (len [k]) ;
+    }
+    nblocks = start [SSB_NARRAYS] ;
+
+    #pragma omp parallel for private (k) schedule (dynamic, 4)
+    for (b = 0 ; b < nblocks ; b++)
+    {
+        uint64_t first, blen ;
+        for (k = 0 ; b >= start [k+1] ; k++) ;
+        first = (uint64_t) (b - start [k]) * SSB_BLOCK ;
+        blen = len [k] - first ;
+        if (blen > SSB_BLOCK) blen = SSB_BLOCK ;
+        sums [b] = ssb_sum ((const unsigned char *) X [k] + first,
+            (size_t) blen) ;
+    }
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* ssb_pad: write zeros to bring the file to the given offset */
+/* -------------------------------------------------------------------------- */
+
+static int ssb_pad (FILE *f, uint64_t *pos, uint64_t offset)
+{
+    static const char zeros [SSB_ALIGN] = { 0 } ;
+    size_t n = (size_t) (offset - *pos) ;
+    *pos = offset ;
+    return (n == 0 || fwrite (zeros, 1, n, f) == n) ;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* SuiteSparse_bin_write */
+/* -------------------------------------------------------------------------- */
+
+int SuiteSparse_bin_write
+(
+    const char *filename,
+    int orient,
+    SuiteSparse_long nrow,
+    SuiteSparse_long ncol,
+    int isize,
+    const void *Ap,
+    const void *Ai,
+    int xtype,
+    const double *Ax,
+    const double *Az,
+    int stype,
+    int sorted,
+    int checksum
+)
+{
+    unsigned char buf [SSB_HEADER] ;
+    const void *X [SSB_NARRAYS] ;
+    uint64_t len [SSB_NARRAYS], pos, nblocks ;
+    uint64_t *sums = NULL ;
+    ssb_header h ;
+    FILE *f ;
+    int k, ok ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    if (filename == NULL || Ap == NULL || nrow < 0 || ncol < 0
+        || (orient != SUITESPARSE_BIN_CSC && orient != SUITESPARSE_BIN_CSR)
+        || (isize != sizeof (int32_t) && isize != sizeof (int64_t))
+        || xtype < SUITESPARSE_BIN_PATTERN || xtype > SUITESPARSE_BIN_ZOMPLEX
+        || (xtype != SUITESPARSE_BIN_PATTERN && Ax == NULL)
+        || (xtype == SUITESPARSE_BIN_ZOMPLEX && Az == NULL))
+    {
+        return (SUITESPARSE_BIN_ARG_ERROR) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* construct the header */
+    /* ---------------------------------------------------------------------- */
+
+    memset (&h, 0, sizeof (ssb_header)) ;
+    memcpy (h.magic, SSB_MAGIC, 8) ;
+    h.version = SSB_VERSION ;
+    h.endian = SSB_ENDIAN ;
+    h.nrow = nrow ;
+    h.ncol = ncol ;
+    h.orient = orient ;
+    h.isize = isize ;
+    h.nnz = SSB_INDEX (Ap, isize, (orient == SUITESPARSE_BIN_CSC) ? ncol:nrow) ;
+    h.xtype = xtype ;
+    h.stype = (stype > 0) ? 1 : ((stype < 0) ? -1 : 0) ;
+    h.sorted = (sorted != 0) ;
+    h.checksum = (checksum != 0) ;
+    if (SSB_INDEX (Ap, isize, 0) != 0 || h.nnz < 0 || (h.nnz > 0 && !Ai))
+    {
+        return (SUITESPARSE_BIN_ARG_ERROR) ;
+    }
+
+    X [0] = Ap ;
+    X [1] = Ai ;
+    X [2] = Ax ;
+    X [3] = Az ;
+    ssb_sizes (&h, len) ;
+
+    pos = SSB_HEADER ;
+    nblocks = 0 ;
+    for (k = 0 ; k < SSB_NARRAYS ; k++)
+    {
+        if (len [k] > 0)
+        {
+            h.offset [k] = SSB_ROUNDUP (pos) ;
+            pos = h.offset [k] + len [k] ;
+        }
+        nblocks += SSB_NBLOCKS (len [k]) ;
+    }
+    if (h.checksum)
+    {
+        h.offset [SSB_NARRAYS] = SSB_ROUNDUP (pos) ;
+        pos = h.offset [SSB_NARRAYS] + nblocks * sizeof (uint64_t) ;
+    }
+    h.size = pos ;
+
+    memset (buf, 0, SSB_HEADER) ;
+    memcpy (buf, &h, sizeof (ssb_header)) ;
+    h.hsum = ssb_sum (buf, SSB_HEADER) ;
+    memcpy (buf, &h, sizeof (ssb_header)) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* compute the block checksums */
+    /* ---------------------------------------------------------------------- */
+
+    if (h.checksum)
+    {
+        sums = (uint64_t *) SuiteSparse_malloc ((size_t) nblocks,
+            sizeof (uint64_t)) ;
+        if (sums == NULL)
+        {
+            return (SUITESPARSE_BIN_OUT_OF_MEMORY) ;
+        }
+        ssb_checksums (X, len, sums) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* write the file */
+    /* ---------------------------------------------------------------------- */
+
+    f = fopen (filename, "wb") ;
+    if (f == NULL)
+    {
+        SuiteSparse_free (sums) ;
+        return (SUITESPARSE_BIN_FILE_IOERROR) ;
+    }
+    ok = (fwrite (buf, 1, SSB_HEADER, f) == SSB_HEADER) ;
+    pos = SSB_HEADER ;
+    for (k = 0 ; ok && k < SSB_NARRAYS ; k++)
+    {
+        if (len [k] == 0) continue ;
+        ok = ssb_pad (f, &pos, h.offset [k])
+            && fwrite (X [k], 1, (size_t) len [k], f) == (size_t) len [k] ;
+        pos += len [k] ;
+    }
+    if (ok && h.checksum)
+    {
+        ok = ssb_pad (f, &pos, h.offset [SSB_NARRAYS])
+            && fwrite (sums, sizeof (uint64_t), (size_t) nblocks, f)
+            == (size_t) nblocks ;
+    }
+    ok = (fclose (f) == 0) && ok ;
+    SuiteSparse_free (sums) ;
+    return (ok ? SUITESPARSE_BIN_OK : SUITESPARSE_BIN_FILE_IOERROR) ;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* SuiteSparse_bin_load */
+/* -------------------------------------------------------------------------- */
+
+int SuiteSparse_bin_load
+(
+    const char *filename,
+    int verify,
+    SuiteSparse_bin *B
+)
+{
+    unsigned char buf [SSB_HEADER] ;
+    uint64_t len [SSB_NARRAYS], hsum, nvec ;
+    ssb_header h ;
+    char *base ;
+    int k, ok, status ;
+
+    if (B == NULL)
+    {
+        return (SUITESPARSE_BIN_ARG_ERROR) ;
+    }
+    memset (B, 0, sizeof (SuiteSparse_bin)) ;
+    if (filename == NULL)
+    {
+        return (SUITESPARSE_BIN_ARG_ERROR) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* map (or read) the file */
+    /* ---------------------------------------------------------------------- */
+
+#ifdef SSB_MMAP
+    {
+        struct stat st ;
+        int fd = open (filename, O_RDONLY) ;
+        if (fd < 0)
+        {
+            return (SUITESPARSE_BIN_FILE_IOERROR) ;
+        }
+        if (fstat (fd, &st) != 0 || !S_ISREG (st.st_mode))
+        {
+            close (fd) ;
+            return (SUITESPARSE_BIN_FILE_IOERROR) ;
+        }
+        if (st.st_size < SSB_HEADER)
+        {
+            close (fd) ;
+            return (SUITESPARSE_BIN_INVALID) ;
+        }
+        /* private and writable: pages are copied only if they are modified */
+        base = mmap (NULL, (size_t) st.st_size, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE, fd, 0) ;
+        close (fd) ;
+        if (base == MAP_FAILED)
+        {
+            return (SUITESPARSE_BIN_FILE_IOERROR) ;
+        }
+        B->base = base ;
+        B->size = (size_t) st.st_size ;
+        B->mapped = 1 ;
+    }
+#else
+    {
+        FILE *f = fopen (filename, "rb") ;
+        if (f == NULL)
+        {
+            return (SUITESPARSE_BIN_FILE_IOERROR) ;
+        }
+        /* read the header to find the size of the file */
+        if (fread (&h, sizeof (ssb_header), 1, f) != 1
+            || h.size < SSB_HEADER || h.size != (size_t) h.size)
+        {
+            fclose (f) ;
+            return (SUITESPARSE_BIN_INVALID) ;
+        }
+        base = SuiteSparse_malloc ((size_t) h.size, 1) ;
+        if (base == NULL)
+        {
+            fclose (f) ;
+            return (SUITESPARSE_BIN_OUT_OF_MEMORY) ;
+        }
+        rewind (f) ;
+        ok = (fread (base, 1, (size_t) h.size, f) == (size_t) h.size) ;
+        fclose (f) ;
+        B->base = base ;
+        B->size = (size_t) h.size ;
+        if (!ok)
+        {
+            SuiteSparse_bin_free (B) ;
+            return (SUITESPARSE_BIN_INVALID) ;
+        }
+    }
+#endif
+
+    /* ---------------------------------------------------------------------- */
+    /* check the header */
+    /* ---------------------------------------------------------------------- */
+
+    memcpy (&h, base, sizeof (ssb_header)) ;
+    memcpy (buf, base, SSB_HEADER) ;
+    memset (buf + offsetof (ssb_header, hsum), 0, sizeof (uint64_t)) ;
+    hsum = ssb_sum (buf, SSB_HEADER) ;
+
+    ok = (memcmp (h.magic, SSB_MAGIC, 8) == 0)
+        && h.version == SSB_VERSION
+        && h.endian == SSB_ENDIAN
+        && h.hsum == hsum
+        && h.size == B->size
+        && h.nrow >= 0 && h.ncol >= 0 && h.nnz >= 0
+        && (h.orient == SUITESPARSE_BIN_CSC || h.orient == SUITESPARSE_BIN_CSR)
+        && (h.isize == sizeof (int32_t) || h.isize == sizeof (int64_t))
+        && (h.isize == sizeof (int64_t) || (h.nrow <= INT_MAX &&
+            h.ncol <= INT_MAX && h.nnz <= INT_MAX))
+        && h.xtype >= SUITESPARSE_BIN_PATTERN
+        && h.xtype <= SUITESPARSE_BIN_ZOMPLEX ;
+
+    if (ok)
+    {
+        /* each array must fit in the file, which also ensures the sizes
+           computed by ssb_sizes do not overflow */
+        nvec = (uint64_t) ((h.orient == SUITESPARSE_BIN_CSC) ? h.ncol:h.nrow);
+        ok = (nvec + 1 <= h.size / h.isize)
+            && ((uint64_t) h.nnz <= h.size / h.isize)
+            && (h.xtype == SUITESPARSE_BIN_PATTERN || (uint64_t) h.nnz <=
+                h.size / (sizeof (double) *
+                ((h.xtype == SUITESPARSE_BIN_COMPLEX) ? 2 : 1))) ;
+    }
+
+    if (ok)
+    {
+        /* each array must lie within the file, on an aligned boundary */
+        ssb_sizes (&h, len) ;
+        for (k = 0 ; ok && k < SSB_NARRAYS ; k++)
+        {
+            ok = (len [k] == 0 && h.offset [k] == 0)
+                || (len [k] > 0 && h.offset [k] % SSB_ALIGN == 0
+                && h.offset [k] >= SSB_HEADER && h.offset [k] <= h.size
+                && len [k] <= h.size - h.offset [k]) ;
+        }
+        ok = ok && (h.checksum ? (h.offset [SSB_NARRAYS] % SSB_ALIGN == 0
+            && h.offset [SSB_NARRAYS] >= SSB_HEADER
+            && h.offset [SSB_NARRAYS] <= h.size) :
+            (h.offset [SSB_NARRAYS] == 0)) ;
+    }
+
+    if (ok)
+    {
+        /* check the first and last pointers (two pages of the file) */
+        nvec = (uint64_t) ((h.orient == SUITESPARSE_BIN_CSC) ? h.ncol:h.nrow);
+        ok = SSB_INDEX (base + h.offset [0], h.isize, 0) == 0
+            && SSB_INDEX (base + h.offset [0], h.isize, nvec) == h.nnz ;
+    }
+
+    if (!ok)
+    {
+        SuiteSparse_bin_free (B) ;
+        return (SUITESPARSE_BIN_INVALID) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* return the matrix, with its arrays in place */
+    /* ---------------------------------------------------------------------- */
+
+#if defined (SSB_MMAP) && defined (MADV_WILLNEED)
+    /* start reading the file now, if it is not already in the page cache */
+    madvise (base, B->size, MADV_WILLNEED) ;
+#endif
+
+    B->nrow = (SuiteSparse_long) h.nrow ;
+    B->ncol = (SuiteSparse_long) h.ncol ;
+    B->nnz = (SuiteSparse_long) h.nnz ;
+    B->orient = h.orient ;
+    B->isize = h.isize ;
+    B->xtype = h.xtype ;
+    B->stype = h.stype ;
+    B->sorted = h.sorted ;
+    B->checksum = h.checksum ;
+    B->p = base + h.offset [0] ;
+    B->i = h.offset [1] ? (void *) (base + h.offset [1]) :
+        (void *) ssb_empty.i ;
+    B->x = (h.xtype == SUITESPARSE_BIN_PATTERN) ? NULL :
+        (h.offset [2] ? (double *) (base + h.offset [2]) : ssb_empty.x) ;
+    B->z = (h.xtype != SUITESPARSE_BIN_ZOMPLEX) ? NULL :
+        (h.offset [3] ? (double *) (base + h.offset [3]) : ssb_empty.x) ;
+
+    if (verify)
+    {
+        status = SuiteSparse_bin_verify (B) ;
+        if (status != SUITESPARSE_BIN_OK)
+        {
+            SuiteSparse_bin_free (B) ;
+            return (status) ;
+        }
+    }
+    return (SUITESPARSE_BIN_OK) ;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* SuiteSparse_bin_verify */
+/* -------------------------------------------------------------------------- */
+
+/* Checks the block checksums (if present in the file), and the pointers and
+   indices of the matrix.  Unlike SuiteSparse_bin_load, this touches every
+   page of the file.  The blocks and vectors are checked in parallel. */
+
+int SuiteSparse_bin_verify
+(
+    const SuiteSparse_bin *B
+)
+{
+    const void *X [SSB_NARRAYS] ;
+    uint64_t len [SSB_NARRAYS], nblocks, *sums ;
+    const uint64_t *stored ;
+    ssb_header h ;
+    int64_t j, nvec, nidx, bad ;
+    int k, isize, sorted ;
+    const void *Bp, *Bi ;
+
+    if (B == NULL || B->base == NULL)
+    {
+        return (SUITESPARSE_BIN_ARG_ERROR) ;
+    }
+    memcpy (&h, B->base, sizeof (ssb_header)) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check the block checksums */
+    /* ---------------------------------------------------------------------- */
+
+    if (h.checksum)
+    {
+        X [0] = B->p ;
+        X [1] = B->i ;
+        X [2] = B->x ;
+        X [3] = B->z ;
+        ssb_sizes (&h, len) ;
+        nblocks = 0 ;
+        for (k = 0 ; k < SSB_NARRAYS ; k++)
+        {
+            nblocks += SSB_NBLOCKS (len [k]) ;
+        }
+        if (nblocks * sizeof (uint64_t) > h.size - h.offset [SSB_NARRAYS])
+        {
+            return (SUITESPARSE_BIN_INVALID) ;
+        }
+        sums = (uint64_t *) SuiteSparse_malloc ((size_t) nblocks,
+            sizeof (uint64_t)) ;
+        if (sums == NULL)
+        {
+            return (SUITESPARSE_BIN_OUT_OF_MEMORY) ;
+        }
+        ssb_checksums (X, len, sums) ;
+        stored = (const uint64_t *)
+            ((const char *) B->base + h.offset [SSB_NARRAYS]) ;
+        k = (memcmp (sums, stored, (size_t) nblocks * sizeof (uint64_t)) == 0);
+        SuiteSparse_free (sums) ;
+        if (!k)
+        {
+            return (SUITESPARSE_BIN_CHECKSUM) ;
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* check the pointers and indices */
+    /* ---------------------------------------------------------------------- */
+
+    nvec = (B->orient == SUITESPARSE_BIN_CSC) ? B->ncol : B->nrow ;
+    nidx = (B->orient == SUITESPARSE_BIN_CSC) ? B->nrow : B->ncol ;
+    isize = B->isize ;
+    sorted = B->sorted ;
+    Bp = B->p ;
+    Bi = B->i ;
+    if (SSB_INDEX (Bp, isize, 0) != 0 || SSB_INDEX (Bp, isize, nvec) != B->nnz)
+    {
+        return (SUITESPARSE_BIN_INVALID) ;
+    }
+
+    bad = 0 ;
+    #pragma omp parallel for reduction (+:bad) schedule (dynamic, 1024)
+    for (j = 0 ; j < nvec ; j++)
+    {
+        int64_t p, i, ilast = -1 ;
+        int64_t p1 = SSB_INDEX (Bp, isize, j) ;
+        int64_t p2 = SSB_INDEX (Bp, isize, j+1) ;
+        if (p1 > p2 || p2 > B->nnz)
+        {
+            bad++ ;
+            continue ;
+        }
+        for (p = p1 ; p < p2 ; p++)
+        {
+            i = SSB_INDEX (Bi, isize, p) ;
+            if (i < 0 || i >= nidx || (sorted && i <= ilast))
+            {
+                bad++ ;
+                break ;
+            }
+            ilast = i ;
+        }
+    }
+    return ((bad == 0) ? SUITESPARSE_BIN_OK : SUITESPARSE_BIN_INVALID) ;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* SuiteSparse_bin_free */
+/* -------------------------------------------------------------------------- */
+
+void SuiteSparse_bin_free
+(
+    SuiteSparse_bin *B
+)
+{
+    if (B == NULL) return ;
+    if (B->base != NULL)
+    {
+#ifdef SSB_MMAP
+        if (B->mapped)
+        {
+            munmap (B->base, B->size) ;
+        }
+        else
+#endif
+        {
+            SuiteSparse_free (B->base) ;
+        }
+    }
+    memset (B, 0, sizeof (SuiteSparse_bin)) ;
+}
@@ -0,0 +1,151 @@
+/* ========================================================================== */
+/* === SuiteSparse_bin ====================================================== */
+/* ========================================================================== */
+
+/* A binary container for a sparse matrix in compressed-column (CSC) or
+ * compressed-row (CSR) form, shared by all SuiteSparse packages.
+ *
+ * The text formats used elsewhere in SuiteSparse (Matrix Market in CHOLMOD,
+ * Rutherford/Boeing in RBio, triplet files in the demos) must be parsed, which
+ * for a large matrix takes far longer than solving with it.  A SuiteSparse_bin
+ * file holds the arrays exactly as they appear in memory: the column (or row)
+ * pointers, the indices, and the numerical values, each starting on a 64-byte
+ * boundary.  SuiteSparse_bin_load maps the file into memory, so that the
+ * arrays are used in place.  Loading a matrix that is already in the page cache
+ * costs a few system calls, no matter how large it is.
+ *
+ * Indices are 32-bit (int) or 64-bit (SuiteSparse_long) integers.  Values are
+ * absent (pattern), real, complex (real and imaginary parts interleaved, as in
+ * CXSparse, KLU, and CHOLMOD_COMPLEX), or zomplex (real and imaginary parts in
+ * two arrays, as in UMFPACK and CHOLMOD_ZOMPLEX).  The file can optionally
+ * hold a checksum for each block of each array, which SuiteSparse_bin_verify
+ * checks in parallel.  The file is written in the byte order of the machine
+ * that writes it; SuiteSparse_bin_load rejects a file with the wrong byte
+ * order.
+ *
+ * The loaded arrays can be used directly by any package:
+ *
+ *  cholmod_bin_sparse      a cholmod_sparse view (CHOLMOD Check module)
+ *  cs_bin                  a cs view (CXSparse)
+ *  UMFPACK, KLU            use B.p, B.i, B.x (and B.z) as Ap, Ai, Ax (and Az),
+ *                          with the _di/_zi routines if B.isize is
+ *                          sizeof (int), or _dl/_zl otherwise.  For example:
+ *
+ *      SuiteSparse_bin B ;
+ *      if (SuiteSparse_bin_load ("A.ssb", 0, &B) == SUITESPARSE_BIN_OK &&
+ *          B.orient == SUITESPARSE_BIN_CSC && B.isize == sizeof (int) &&
+ *          B.xtype == SUITESPARSE_BIN_REAL)
+ *      {
+ *          umfpack_di_symbolic (B.nrow, B.ncol, B.p, B.i, B.x, &Symbolic,
+ *              Control, Info) ;
+ *          ...
+ *      }
+ *      SuiteSparse_bin_free (&B) ;
+ *
+ * The mapped file is private to the process: if a package modifies the arrays
+ * (CHOLMOD, for example, may sort them in place), the modified pages are
+ * copied, and the file is not changed.
+ *
+ * Copyright (c) 2026, the SuiteSparse contributors.  No licensing
+ * restrictions apply to this file or to the SuiteSparse_config directory.
+ */
+
+#ifndef SUITESPARSE_BIN_H
+#define SUITESPARSE_BIN_H
+
+#include "SuiteSparse_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* orientation of the matrix */
+#define SUITESPARSE_BIN_CSC 0       /* p has size ncol+1, i holds row indices */
+#define SUITESPARSE_BIN_CSR 1       /* p has size nrow+1, i holds col indices */
+
+/* kind of numerical values */
+#define SUITESPARSE_BIN_PATTERN 0   /* no values: x and z are NULL */
+#define SUITESPARSE_BIN_REAL 1      /* x has size nnz */
+#define SUITESPARSE_BIN_COMPLEX 2   /* x has size 2*nnz, interleaved */
+#define SUITESPARSE_BIN_ZOMPLEX 3   /* x and z each have size nnz */
+
+/* status codes */
+#define SUITESPARSE_BIN_OK (0)
+#define SUITESPARSE_BIN_ARG_ERROR (-1)      /* input arguments invalid */
+#define SUITESPARSE_BIN_FILE_IOERROR (-2)   /* cannot read/write the file */
+#define SUITESPARSE_BIN_INVALID (-3)        /* not a valid file, or wrong
+                                               byte order or version */
+#define SUITESPARSE_BIN_CHECKSUM (-4)       /* checksum does not match */
+#define SUITESPARSE_BIN_OUT_OF_MEMORY (-5)  /* out of memory */
+
+typedef struct SuiteSparse_bin_struct
+{
+    /* the matrix, as held in the file */
+    SuiteSparse_long nrow ;     /* the matrix is nrow-by-ncol */
+    SuiteSparse_long ncol ;
+    SuiteSparse_long nnz ;      /* number of entries */
+    int orient ;                /* SUITESPARSE_BIN_CSC or _CSR */
+    int isize ;                 /* sizeof an index: 4 or 8 */
+    int xtype ;                 /* SUITESPARSE_BIN_PATTERN, _REAL, etc */
+    int stype ;                 /* 0: unsymmetric, or symmetric with both
+                                   parts present.  > 0: only the upper
+                                   triangular part is present.  < 0: only
+                                   the lower triangular part is present. */
+    int sorted ;                /* TRUE if indices are sorted in each vector */
+    int checksum ;              /* TRUE if the file holds block checksums */
+    void *p ;                   /* pointers, of size (ncol or nrow) + 1 */
+    void *i ;                   /* indices, of size nnz (never NULL) */
+    double *x ;                 /* values, NULL if pattern */
+    double *z ;                 /* imaginary values if zomplex, else NULL */
+
+    /* private: for use by SuiteSparse_bin_* only */
+    void *base ;                /* start of the mapped (or read) file */
+    size_t size ;               /* size of the file, in bytes */
+    int mapped ;                /* TRUE if base was mapped with mmap */
+
+} SuiteSparse_bin ;
+
+int SuiteSparse_bin_write   /* returns SUITESPARSE_BIN_OK, or an error code */
+(
+    /* input, not modified */
+    const char *filename,   /* file to write */
+    int orient,             /* SUITESPARSE_BIN_CSC or _CSR */
+    SuiteSparse_long nrow,  /* the matrix is nrow-by-ncol */
+    SuiteSparse_long ncol,
+    int isize,              /* sizeof an index in Ap and Ai: 4 or 8 */
+    const void *Ap,         /* pointers, size (ncol or nrow)+1, Ap [0] = 0 */
+    const void *Ai,         /* indices, size nnz = Ap [ncol or nrow] */
+    int xtype,              /* SUITESPARSE_BIN_PATTERN, _REAL, etc */
+    const double *Ax,       /* values, NULL if pattern */
+    const double *Az,       /* imaginary values if zomplex, else NULL */
+    int stype,              /* 0, > 0 (upper), or < 0 (lower) */
+    int sorted,             /* TRUE if indices are sorted in each vector */
+    int checksum            /* if TRUE, add block checksums to the file */
+) ;
+
+int SuiteSparse_bin_load    /* returns SUITESPARSE_BIN_OK, or an error code */
+(
+    /* input, not modified */
+    const char *filename,   /* file to load */
+    int verify,             /* if TRUE, call SuiteSparse_bin_verify */
+    /* output */
+    SuiteSparse_bin *B      /* the loaded matrix; free with SuiteSparse_bin_free
+                               when done.  Cleared on error. */
+) ;
+
+int SuiteSparse_bin_verify  /* returns SUITESPARSE_BIN_OK, or an error code */
+(
+    /* input, not modified */
+    const SuiteSparse_bin *B    /* matrix to check */
+) ;
+
+void SuiteSparse_bin_free
+(
+    /* input/output */
+    SuiteSparse_bin *B      /* unmap (or free) the matrix, and clear B */
+) ;
+
+#ifdef __cplusplus
+}
+#endif
+#endif
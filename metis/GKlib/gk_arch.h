@@ -58,6 +58,19 @@ typedef ptrdiff_t ssize_t;
 #define PTRDIFF_MAX  INT64_MAX
 #endif
 
+/* Storage class of thread-local variables.  GKlibSystem.cmake checks for
+   thread-local storage (conf/check_thread_storage.c), and defines __thread as
+   nothing if there is none, so GK_THREAD_STORAGE follows the same check.
+   MSVC has no __thread, and uses __declspec(thread) instead. */
+#ifndef GK_THREAD_STORAGE
+#ifdef _MSC_VER
+#define GK_THREAD_STORAGE __declspec(thread)
+#else
+#define GK_THREAD_STORAGE __thread
+#endif
+#endif
+
+
 #ifdef __MSC__
 /* MSC does not have rint() function */
 #define rint(x) ((int)((x)+0.5))  